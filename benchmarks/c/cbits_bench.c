@@ -0,0 +1,583 @@
+/**
+ * @file benchmarks/c/cbits_bench.c
+ * @brief Native benchmark harness for the cbits core library.
+ *
+ * Measures every core BitVector operation for vector sizes from 64 bits up
+ * to @c --max-bits in steps of 64x, and reports throughput as JSON:
+ * - single-bit access (@ref bv_get, @ref bv_set, @ref bv_flip) and
+ *   @ref bv_rank with random and sequential positions
+ * - bulk operations (@ref bv_copy, @ref bv_equal, @ref bv_compare,
+ *   @ref bv_is_subset, @ref bv_hash, range ops, reductions,
+ *   @ref bv_contains_subvector, @ref bv_to_bytes, @ref bv_from_bytes)
+ * - @ref bv_count, @ref bv_count_range, @ref bv_build_rank, the batched
+ *   Hamming kernel and the bool conversions @ref bv_to_bools and
+ *   @ref bv_from_bools once per kernel the CPU supports, switching
+ *   between them with @ref cbits_set_kernel
+ *
+ * The header names the kernel the dispatcher picked for this CPU, after
+ * any @c CBITS_FORCE_KERNEL override. Every
+ * result records ``ns_per_op`` (per call, or per access for the
+ * access benchmarks) and ``gb_per_s`` (bytes of BitVector data read per
+ * second, ``null`` for the access benchmarks), so runs on two versions can
+ * be compared entry by entry. Progress goes to stderr.
+ *
+ * Usage: ``cbits_bench [--min-bits N] [--max-bits N] [--min-time SEC]
+ * [--filter TEXT] [--output FILE]``
+ *
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitvector.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+/** @brief Version of the JSON layout, bumped on incompatible changes. */
+#define BENCH_SCHEMA 1
+/** @brief Number of positions per call of the access benchmarks. */
+#define BENCH_ACCESSES ((size_t) 1 << 16)
+/** @brief Inputs of the n-ary reduction benchmarks. */
+#define BENCH_REDUCE_INPUTS 8
+
+/**
+ * @brief Monotonic wall clock.
+ * @return Seconds since an arbitrary origin.
+ */
+static double
+bench_now(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double) now.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * @brief State shared by all benchmarks of one vector size.
+ */
+typedef struct {
+    size_t n_bits;       /**< Bits per operand. */
+    BitVector *a;        /**< Random operand. */
+    BitVector *b;        /**< Copy of @c a. */
+    BitVector *needle;   /**< Absent 64-bit pattern. */
+    const BitVector *inputs[BENCH_REDUCE_INPUTS]; /**< Reduction inputs. */
+    size_t *pos;         /**< Access positions. */
+    uint32_t *dist;      /**< Hamming output rows. */
+    uint8_t *bytes;      /**< Packed bytes of @c a. */
+    uint8_t *bools;      /**< One byte per bit of @c a, or NULL. */
+    uint64_t sink;       /**< Defeats dead-code removal. */
+} bench_ctx;
+
+/**
+ * @brief Options and output state of a run.
+ */
+typedef struct {
+    size_t min_bits;    /**< Smallest vector size. */
+    size_t max_bits;    /**< Largest vector size. */
+    double min_time;    /**< Minimum measured time per result, seconds. */
+    const char *filter; /**< Only run benchmarks containing this text. */
+    FILE *out;          /**< JSON destination. */
+    size_t n_results;   /**< Results written so far. */
+} bench_run;
+
+/** @brief Signature of one benchmark body. */
+typedef void (*bench_fn)(bench_ctx *ctx);
+
+/**
+ * @brief Time a benchmark body and append its JSON result.
+ *
+ * The iteration count doubles until a batch takes at least
+ * @c run->min_time seconds, after one untimed warm-up call.
+ *
+ * @param run Run options.
+ * @param ctx Benchmark state.
+ * @param name Operation name.
+ * @param access ``"random"``, ``"sequential"`` or ``"bulk"``.
+ * @param kernel Popcount kernel name, or NULL if the kernel is irrelevant.
+ * @param fn Benchmark body.
+ * @param ops Operations per call of @p fn.
+ * @param bytes Bytes of vector data read per call, 0 if not meaningful.
+ */
+static void
+bench_measure(bench_run *run, bench_ctx *ctx, const char *name,
+              const char *access, const char *kernel, bench_fn fn,
+              size_t ops, double bytes)
+{
+    if (run->filter && !strstr(name, run->filter)) {
+        return;
+    }
+    fn(ctx);
+    size_t iters = 1;
+    double elapsed;
+    for (;;) {
+        const double start = bench_now();
+        for (size_t i = 0; i < iters; ++i) {
+            fn(ctx);
+        }
+        elapsed = bench_now() - start;
+        if (elapsed >= run->min_time || iters >= ((size_t) 1 << 40)) {
+            break;
+        }
+        iters *= 2;
+    }
+    const double ns = elapsed * 1e9 / ((double) iters * (double) ops);
+    fprintf(stderr, "%-22s %-10s %-8s %12zu bits %14.2f ns/op\n", name,
+            access, kernel ? kernel : "-", ctx->n_bits, ns);
+    fprintf(run->out,
+            "%s\n    {\"name\": \"%s\", \"n_bits\": %zu, "
+            "\"access\": \"%s\", \"kernel\": ",
+            run->n_results ? "," : "", name, ctx->n_bits, access);
+    if (kernel) {
+        fprintf(run->out, "\"%s\"", kernel);
+    }
+    else {
+        fputs("null", run->out);
+    }
+    fprintf(run->out, ", \"iterations\": %zu, \"ns_per_op\": %.3f, "
+                      "\"gb_per_s\": ",
+            iters, ns);
+    if (bytes > 0) {
+        fprintf(run->out, "%.3f}", bytes * (double) iters / elapsed / 1e9);
+    }
+    else {
+        fputs("null}", run->out);
+    }
+    run->n_results++;
+}
+
+/* Benchmark bodies */
+
+static void
+bench_get(bench_ctx *ctx)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < BENCH_ACCESSES; ++i) {
+        sum += (uint64_t) bv_get(ctx->a, ctx->pos[i]);
+    }
+    ctx->sink += sum;
+}
+
+static void
+bench_set(bench_ctx *ctx)
+{
+    for (size_t i = 0; i < BENCH_ACCESSES; ++i) {
+        bv_set(ctx->b, ctx->pos[i]);
+    }
+}
+
+static void
+bench_flip(bench_ctx *ctx)
+{
+    for (size_t i = 0; i < BENCH_ACCESSES; ++i) {
+        bv_flip(ctx->b, ctx->pos[i]);
+    }
+}
+
+static void
+bench_rank(bench_ctx *ctx)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < BENCH_ACCESSES; ++i) {
+        sum += bv_rank(ctx->a, ctx->pos[i]);
+    }
+    ctx->sink += sum;
+}
+
+static void
+bench_new(bench_ctx *ctx)
+{
+    bv_free(bv_new(ctx->n_bits));
+}
+
+static void
+bench_copy(bench_ctx *ctx)
+{
+    bv_free(bv_copy(ctx->a));
+}
+
+static void
+bench_equal(bench_ctx *ctx)
+{
+    ctx->sink += (uint64_t) bv_equal(ctx->a, ctx->b);
+}
+
+static void
+bench_compare(bench_ctx *ctx)
+{
+    ctx->sink += (uint64_t) bv_compare(ctx->a, ctx->b, BV_ORDER_LEX);
+}
+
+static void
+bench_is_subset(bench_ctx *ctx)
+{
+    ctx->sink += (uint64_t) bv_is_subset(ctx->a, ctx->b);
+}
+
+static void
+bench_hash(bench_ctx *ctx)
+{
+    ctx->sink += bv_hash(ctx->a, 0);
+}
+
+static void
+bench_to_bytes(bench_ctx *ctx)
+{
+    bv_to_bytes(ctx->a, ctx->bytes, BV_BITORDER_BIG);
+    ctx->sink += ctx->bytes[0];
+}
+
+static void
+bench_from_bytes(bench_ctx *ctx)
+{
+    bv_free(bv_from_bytes(ctx->bytes, ctx->n_bits, BV_BITORDER_BIG));
+}
+
+static void
+bench_to_bools(bench_ctx *ctx)
+{
+    bv_to_bools(ctx->a, ctx->bools);
+    ctx->sink += ctx->bools[0];
+}
+
+static void
+bench_from_bools(bench_ctx *ctx)
+{
+    bv_free(bv_from_bools(ctx->bools, ctx->n_bits));
+}
+
+static void
+bench_set_range(bench_ctx *ctx)
+{
+    bv_set_range(ctx->b, 1, ctx->n_bits - 1);
+}
+
+static void
+bench_flip_range(bench_ctx *ctx)
+{
+    bv_flip_range(ctx->b, 1, ctx->n_bits - 1);
+}
+
+static void
+bench_contains(bench_ctx *ctx)
+{
+    ctx->sink += (uint64_t) bv_contains_subvector(ctx->a, ctx->needle);
+}
+
+static void
+bench_and(bench_ctx *ctx)
+{
+    bv_free(bv_and_all(ctx->inputs, 2));
+}
+
+static void
+bench_or(bench_ctx *ctx)
+{
+    bv_free(bv_or_all(ctx->inputs, 2));
+}
+
+static void
+bench_xor(bench_ctx *ctx)
+{
+    bv_free(bv_xor_all(ctx->inputs, 2));
+}
+
+static void
+bench_or_all(bench_ctx *ctx)
+{
+    bv_free(bv_or_all(ctx->inputs, BENCH_REDUCE_INPUTS));
+}
+
+static void
+bench_threshold(bench_ctx *ctx)
+{
+    bv_free(bv_threshold(ctx->inputs, BENCH_REDUCE_INPUTS,
+                         BENCH_REDUCE_INPUTS / 2 + 1));
+}
+
+static void
+bench_count(bench_ctx *ctx)
+{
+    ctx->sink += bv_count(ctx->a);
+}
+
+static void
+bench_count_range(bench_ctx *ctx)
+{
+    ctx->sink += bv_count_range(ctx->a, 1, ctx->n_bits - 1);
+}
+
+static void
+bench_build_rank(bench_ctx *ctx)
+{
+    bv_build_rank(ctx->b);
+}
+
+static void
+bench_hamming(bench_ctx *ctx)
+{
+    /* Rows of 16 words against the first row. */
+    cbits_hamming_batch(ctx->a->data, ctx->a->data, 16, 16,
+                        ctx->a->n_words / 16, ctx->dist);
+    ctx->sink += ctx->dist[0];
+}
+
+/**
+ * @brief xorshift64 step.
+ * @param state Generator state, never zero.
+ * @return Next pseudo-random value.
+ */
+static uint64_t
+bench_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Fill the access positions.
+ * @param ctx Benchmark state.
+ * @param random Random positions if nonzero, else consecutive ones.
+ */
+static void
+bench_positions(bench_ctx *ctx, int random)
+{
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (size_t i = 0; i < BENCH_ACCESSES; ++i) {
+        ctx->pos[i] = random ? (size_t) (bench_random(&state) % ctx->n_bits)
+                             : i % ctx->n_bits;
+    }
+}
+
+/**
+ * @brief Run every benchmark for one vector size.
+ * @param run Run options.
+ * @param n_bits Bits per operand.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+bench_size(bench_run *run, size_t n_bits)
+{
+    bench_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.n_bits = n_bits;
+    ctx.a = bv_new(n_bits);
+    ctx.needle = bv_new(64);
+    ctx.pos = malloc(BENCH_ACCESSES * sizeof(size_t));
+    ctx.dist = malloc((n_bits / 1024 + 1) * sizeof(uint32_t));
+    ctx.bytes = malloc(n_bits / 8 + 1);
+    /* Eight times the operand size; the bool benchmarks are skipped if
+     * this does not fit. */
+    ctx.bools = malloc(n_bits);
+    int rc = -1;
+    if (!ctx.a || !ctx.needle || !ctx.pos || !ctx.dist || !ctx.bytes) {
+        goto done;
+    }
+    uint64_t state = n_bits | 1;
+    for (size_t w = 0; w < ctx.a->n_words; ++w) {
+        ctx.a->data[w] = bench_random(&state);
+    }
+    if (n_bits & 63) {
+        ctx.a->data[ctx.a->n_words - 1] &= (1ULL << (n_bits & 63)) - 1;
+    }
+    ctx.b = bv_copy(ctx.a);
+    if (!ctx.b) {
+        goto done;
+    }
+    /* Runs of 64 ones never occur in random data of this size. */
+    bv_set_range(ctx.needle, 0, 64);
+    for (size_t i = 0; i < BENCH_REDUCE_INPUTS; ++i) {
+        ctx.inputs[i] = (i & 1) ? ctx.b : ctx.a;
+    }
+    bv_build_rank(ctx.a);
+    bv_to_bytes(ctx.a, ctx.bytes, BV_BITORDER_BIG);
+    if (ctx.bools) {
+        bv_to_bools(ctx.a, ctx.bools);
+    }
+
+    const double bytes = (double) ctx.a->n_words * sizeof(uint64_t);
+    const size_t n = BENCH_ACCESSES;
+    for (int random = 1; random >= 0; --random) {
+        const char *access = random ? "random" : "sequential";
+        bench_positions(&ctx, random);
+        bench_measure(run, &ctx, "bv_get", access, NULL, bench_get, n, 0);
+        bench_measure(run, &ctx, "bv_set", access, NULL, bench_set, n, 0);
+        bench_measure(run, &ctx, "bv_flip", access, NULL, bench_flip, n, 0);
+        bench_measure(run, &ctx, "bv_rank", access, NULL, bench_rank, n, 0);
+    }
+    /* Undo the access benchmarks so bv_equal compares every word. */
+    memcpy(ctx.b->data, ctx.a->data, ctx.a->n_words * sizeof(uint64_t));
+    bench_measure(run, &ctx, "bv_new", "bulk", NULL, bench_new, 1, bytes);
+    bench_measure(run, &ctx, "bv_copy", "bulk", NULL, bench_copy, 1, bytes);
+    bench_measure(run, &ctx, "bv_equal", "bulk", NULL, bench_equal, 1,
+                  2 * bytes);
+    bench_measure(run, &ctx, "bv_compare", "bulk", NULL, bench_compare, 1,
+                  2 * bytes);
+    bench_measure(run, &ctx, "bv_is_subset", "bulk", NULL, bench_is_subset,
+                  1, 2 * bytes);
+    bench_measure(run, &ctx, "bv_hash", "bulk", NULL, bench_hash, 1, bytes);
+    bench_measure(run, &ctx, "bv_to_bytes", "bulk", NULL, bench_to_bytes, 1,
+                  bytes);
+    bench_measure(run, &ctx, "bv_from_bytes", "bulk", NULL, bench_from_bytes,
+                  1, bytes);
+    bench_measure(run, &ctx, "bv_set_range", "bulk", NULL, bench_set_range,
+                  1, bytes);
+    bench_measure(run, &ctx, "bv_flip_range", "bulk", NULL,
+                  bench_flip_range, 1, bytes);
+    bench_measure(run, &ctx, "bv_contains_subvector", "bulk", NULL,
+                  bench_contains, 1, bytes);
+    bench_measure(run, &ctx, "and", "bulk", NULL, bench_and, 1, 2 * bytes);
+    bench_measure(run, &ctx, "or", "bulk", NULL, bench_or, 1, 2 * bytes);
+    bench_measure(run, &ctx, "xor", "bulk", NULL, bench_xor, 1, 2 * bytes);
+    bench_measure(run, &ctx, "bv_or_all", "bulk", NULL, bench_or_all, 1,
+                  BENCH_REDUCE_INPUTS * bytes);
+    bench_measure(run, &ctx, "bv_threshold", "bulk", NULL, bench_threshold,
+                  1, BENCH_REDUCE_INPUTS * bytes);
+
+    /* Popcount-bound operations, once per supported kernel. */
+    cbits_kernel active[CBITS_OP_COUNT];
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        active[o] = cbits_active_kernel((cbits_dispatch_op) o);
+    }
+    for (int k = 0; k < CBITS_KERNEL_COUNT; ++k) {
+        if (cbits_set_kernel(CBITS_OP_COUNT, (cbits_kernel) k) < 0) {
+            continue;
+        }
+        const char *kernel = cbits_kernel_name((cbits_kernel) k);
+        bench_measure(run, &ctx, "bv_count", "bulk", kernel, bench_count, 1,
+                      bytes);
+        bench_measure(run, &ctx, "bv_count_range", "bulk", kernel,
+                      bench_count_range, 1, bytes);
+        bench_measure(run, &ctx, "bv_build_rank", "bulk", kernel,
+                      bench_build_rank, 1, bytes);
+        if (ctx.a->n_words >= 16) {
+            bench_measure(run, &ctx, "hamming_batch", "bulk", kernel,
+                          bench_hamming, 1, 2 * bytes);
+        }
+        if (ctx.bools) {
+            bench_measure(run, &ctx, "bv_to_bools", "bulk", kernel,
+                          bench_to_bools, 1, bytes);
+            bench_measure(run, &ctx, "bv_from_bools", "bulk", kernel,
+                          bench_from_bools, 1, n_bits);
+        }
+    }
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        cbits_set_kernel((cbits_dispatch_op) o, active[o]);
+    }
+    rc = 0;
+
+done:
+    if (rc < 0) {
+        fprintf(stderr, "cbits_bench: out of memory at %zu bits\n", n_bits);
+    }
+    bv_free(ctx.a);
+    bv_free(ctx.b);
+    bv_free(ctx.needle);
+    free(ctx.pos);
+    free(ctx.dist);
+    free(ctx.bytes);
+    free(ctx.bools);
+    return rc;
+}
+
+/**
+ * @brief Print the command line help.
+ * @param prog Program name.
+ */
+static void
+bench_usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--min-bits N] [--max-bits N] [--min-time SEC]\n"
+            "          [--filter TEXT] [--output FILE]\n"
+            "\n"
+            "Sizes run from --min-bits (default 64) to --max-bits (default\n"
+            "2^30, i.e. 128 MiB per operand) in steps of 64x. Results are\n"
+            "written as JSON to --output (default stdout).\n",
+            prog);
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_run run = {64, (size_t) 1 << 30, 0.05, NULL, stdout, 0};
+    const char *output = NULL;
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "--help") || !strcmp(arg, "-h")) {
+            bench_usage(argv[0]);
+            return 0;
+        }
+        if (!value) {
+            bench_usage(argv[0]);
+            return 2;
+        }
+        if (!strcmp(arg, "--min-bits")) {
+            run.min_bits = (size_t) strtoull(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--max-bits")) {
+            run.max_bits = (size_t) strtoull(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--min-time")) {
+            run.min_time = strtod(value, NULL);
+        }
+        else if (!strcmp(arg, "--filter")) {
+            run.filter = value;
+        }
+        else if (!strcmp(arg, "--output")) {
+            output = value;
+        }
+        else {
+            bench_usage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+    if (run.min_bits == 0 || run.min_bits > run.max_bits) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+    if (output && !(run.out = fopen(output, "w"))) {
+        perror(output);
+        return 1;
+    }
+
+    fprintf(run.out, "{\n  \"schema\": %d,\n  \"library\": \"cbits\",\n",
+            BENCH_SCHEMA);
+    const char *dispatch =
+        cbits_kernel_name(cbits_active_kernel(CBITS_OP_POPCOUNT_WORDS));
+    fprintf(run.out, "  \"dispatch\": \"%s\",\n", dispatch);
+    fprintf(run.out, "  \"min_time\": %.3f,\n  \"results\": [", run.min_time);
+    int rc = 0;
+    for (size_t n_bits = run.min_bits; n_bits <= run.max_bits;) {
+        if (bench_size(&run, n_bits) < 0) {
+            rc = 1;
+            break;
+        }
+        if (n_bits > run.max_bits / 64) {
+            break;
+        }
+        n_bits *= 64;
+    }
+    fputs("\n  ]\n}\n", run.out);
+    if (output) {
+        fclose(run.out);
+    }
+    return rc;
+}
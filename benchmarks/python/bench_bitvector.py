@@ -0,0 +1,465 @@
+"""Python-level benchmarks of cbits.BitVector against common alternatives.
+
+Times the same operations on a ``BitVector`` and on the usual pure-Python
+representations of a bit array, so both the case for cbits and regressions
+in the bindings (``bitvector_methods_*.c``) show up in one table:
+
+- ``cbits``: ``cbits.BitVector``
+- ``list``: a ``list`` of ``bool``
+- ``bytearray``: one byte per bit
+- ``int``: a Python ``int`` used as a bit set
+- ``numpy``: a ``numpy.packbits`` array (skipped if NumPy is missing)
+
+Operations: construction, random and sequential get/set, slicing with
+several steps, iteration, hashing, ``&``/``|``/``^``, rank (prefix count)
+and ``in`` (subsequence search). Operations a representation cannot express
+reasonably are left out for it.
+
+Runs offline with the standard library only::
+
+    python benchmarks/python/bench_bitvector.py --json new.json
+    python benchmarks/python/bench_bitvector.py --compare old.json
+
+Results are keyed by (operation, backend, bits), so JSON files from two
+cbits versions can be compared with ``--compare``.
+
+Author lambdaphoenix
+
+Version 0.4.0
+
+Copyright (c) 2026 lambdaphoenix
+"""
+import argparse
+import fnmatch
+import json
+import operator
+import platform
+import random
+import sys
+import time
+
+import cbits
+from cbits import BitVector
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+## @brief Version of the JSON layout, bumped on incompatible changes.
+SCHEMA = 1
+## @brief Positions per call of the single-bit benchmarks.
+ACCESSES = 1000
+## @brief Slice steps benchmarked.
+STEPS = (1, 2, 7, -1)
+
+
+class Backend:
+    """One bit-array representation; subclasses build the benchmark bodies.
+
+    Every ``op_*`` method receives the benchmark data and returns a
+    zero-argument callable, or ``None`` if the representation has no
+    reasonable way to perform the operation.
+    """
+
+    name = ""
+
+    def build(self, bits):
+        """Convert a list of bools into this representation."""
+        raise NotImplementedError
+
+
+class CbitsBackend(Backend):
+    name = "cbits"
+
+    def build(self, bits):
+        bv = BitVector(len(bits))
+        bv[:] = bits
+        return bv
+
+    def op_construct(self, d):
+        n = d.n
+        return lambda: BitVector(n)
+
+    def op_get(self, d):
+        a, idx = d.a, d.idx
+        return lambda: [a[i] for i in idx]
+
+    def op_set(self, d):
+        a, idx = d.a, d.idx
+        def run():
+            for i in idx:
+                a[i] = True
+        return run
+
+    def op_slice(self, d, step):
+        a, lo, hi = d.a, d.lo, d.hi
+        return lambda: a[lo:hi:step]
+
+    def op_iterate(self, d):
+        a = d.a
+        return lambda: sum(a)
+
+    def op_hash(self, d):
+        # Copies defeat the cached hash of the original.
+        a = d.a
+        return lambda: hash(a.copy())
+
+    def op_binary(self, d, op):
+        a, b = d.a, d.b
+        return lambda: op(a, b)
+
+    def op_rank(self, d):
+        a, k = d.a, d.k
+        return lambda: a.rank(k - 1)
+
+    def op_contains(self, d):
+        a, p = d.a, d.pattern
+        return lambda: p in a
+
+
+class ListBackend(Backend):
+    name = "list"
+
+    def build(self, bits):
+        return list(bits)
+
+    def op_construct(self, d):
+        n = d.n
+        return lambda: [False] * n
+
+    def op_get(self, d):
+        a, idx = d.a, d.idx
+        return lambda: [a[i] for i in idx]
+
+    def op_set(self, d):
+        a, idx = d.a, d.idx
+        def run():
+            for i in idx:
+                a[i] = True
+        return run
+
+    def op_slice(self, d, step):
+        a, lo, hi = d.a, d.lo, d.hi
+        return lambda: a[lo:hi:step]
+
+    def op_iterate(self, d):
+        a = d.a
+        return lambda: sum(a)
+
+    def op_hash(self, d):
+        a = d.a
+        return lambda: hash(tuple(a))
+
+    def op_binary(self, d, op):
+        a, b = d.a, d.b
+        return lambda: list(map(op, a, b))
+
+    def op_rank(self, d):
+        a, k = d.a, d.k
+        return lambda: sum(a[:k])
+
+    def op_contains(self, d):
+        a, p = d.a, bytes(d.pattern)
+        return lambda: p in bytes(a)
+
+
+class BytearrayBackend(Backend):
+    name = "bytearray"
+
+    def build(self, bits):
+        return bytearray(bits)
+
+    def op_construct(self, d):
+        n = d.n
+        return lambda: bytearray(n)
+
+    def op_get(self, d):
+        a, idx = d.a, d.idx
+        return lambda: [a[i] for i in idx]
+
+    def op_set(self, d):
+        a, idx = d.a, d.idx
+        def run():
+            for i in idx:
+                a[i] = 1
+        return run
+
+    def op_slice(self, d, step):
+        a, lo, hi = d.a, d.lo, d.hi
+        return lambda: a[lo:hi:step]
+
+    def op_iterate(self, d):
+        a = d.a
+        return lambda: sum(a)
+
+    def op_hash(self, d):
+        a = d.a
+        return lambda: hash(bytes(a))
+
+    def op_binary(self, d, op):
+        a, b = d.a, d.b
+        return lambda: bytearray(map(op, a, b))
+
+    def op_rank(self, d):
+        a, k = d.a, d.k
+        return lambda: a.count(1, 0, k)
+
+    def op_contains(self, d):
+        a, p = d.a, bytes(d.pattern)
+        return lambda: p in a
+
+
+class IntBackend(Backend):
+    name = "int"
+
+    def build(self, bits):
+        return int("".join("1" if b else "0" for b in reversed(bits)) or "0",
+                   2)
+
+    def op_construct(self, d):
+        return None
+
+    def op_get(self, d):
+        a, idx = d.a, d.idx
+        return lambda: [(a >> i) & 1 for i in idx]
+
+    def op_set(self, d):
+        # Every update copies the whole immutable int.
+        if d.n > 1 << 16:
+            return None
+        idx = d.idx
+        def run():
+            a = d.a
+            for i in idx:
+                a |= 1 << i
+            return a
+        return run
+
+    def op_slice(self, d, step):
+        if step != 1:
+            return None
+        a, lo, mask = d.a, d.lo, (1 << (d.hi - d.lo)) - 1
+        return lambda: (a >> lo) & mask
+
+    def op_iterate(self, d):
+        a, n = d.a, d.n
+        return lambda: sum(c == "1" for c in format(a, "0%db" % n))
+
+    def op_hash(self, d):
+        a = d.a
+        return lambda: hash(a)
+
+    def op_binary(self, d, op):
+        a, b = d.a, d.b
+        return lambda: op(a, b)
+
+    def op_rank(self, d):
+        a, mask = d.a, (1 << d.k) - 1
+        return lambda: (a & mask).bit_count()
+
+    def op_contains(self, d):
+        a, n = d.a, d.n
+        p = "".join("1" if b else "0" for b in reversed(d.pattern))
+        return lambda: p in format(a, "0%db" % n)
+
+
+class NumpyBackend(Backend):
+    name = "numpy"
+
+    def build(self, bits):
+        return numpy.packbits(numpy.array(bits, dtype=numpy.uint8),
+                              bitorder="little")
+
+    def op_construct(self, d):
+        n = d.n
+        return lambda: numpy.zeros((n + 7) // 8, dtype=numpy.uint8)
+
+    def op_get(self, d):
+        a, idx = d.a, d.idx
+        return lambda: [(int(a[i >> 3]) >> (i & 7)) & 1 for i in idx]
+
+    def op_set(self, d):
+        a, idx = d.a, d.idx
+        def run():
+            for i in idx:
+                a[i >> 3] |= 1 << (i & 7)
+        return run
+
+    def op_slice(self, d, step):
+        a, lo, hi, n = d.a, d.lo, d.hi, d.n
+        return lambda: numpy.packbits(
+            numpy.unpackbits(a, count=n, bitorder="little")[lo:hi:step],
+            bitorder="little")
+
+    def op_iterate(self, d):
+        a, n = d.a, d.n
+        return lambda: sum(numpy.unpackbits(a, count=n,
+                                            bitorder="little").tolist())
+
+    def op_hash(self, d):
+        a = d.a
+        return lambda: hash(a.tobytes())
+
+    def op_binary(self, d, op):
+        a, b = d.a, d.b
+        return lambda: op(a, b)
+
+    def op_rank(self, d):
+        a, k = d.a, d.k
+        return lambda: int(numpy.unpackbits(a, count=k,
+                                            bitorder="little").sum())
+
+    def op_contains(self, d):
+        a, n, p = d.a, d.n, bytes(d.pattern)
+        return lambda: p in numpy.unpackbits(
+            a, count=n, bitorder="little").tobytes()
+
+
+class Data:
+    """Operands of one backend at one size."""
+
+    def __init__(self, backend, n, bits_a, bits_b, pattern, seed):
+        rng = random.Random(seed)
+        self.n = n
+        self.a = backend.build(bits_a)
+        self.b = backend.build(bits_b)
+        self.pattern = (backend.build(pattern)
+                        if isinstance(backend, CbitsBackend) else pattern)
+        self.idx = [rng.randrange(n) for _ in range(ACCESSES)]
+        self.lo, self.hi = n // 4, n - n // 4
+        self.k = n // 2 or 1
+
+
+def benchmarks(backend, data, sequential):
+    """Yield (operation, ops per call, callable) for one backend."""
+    yield "construct", 1, backend.op_construct(data)
+    for access in ("random", "sequential"):
+        if access == "sequential":
+            data.idx = sequential
+        ops = len(data.idx)
+        yield "get_" + access, ops, backend.op_get(data)
+        yield "set_" + access, ops, backend.op_set(data)
+    for step in STEPS:
+        yield "slice_step%+d" % step, 1, backend.op_slice(data, step)
+    yield "iterate", data.n, backend.op_iterate(data)
+    yield "hash", 1, backend.op_hash(data)
+    for name, op in (("and", operator.and_), ("or", operator.or_),
+                     ("xor", operator.xor)):
+        yield name, 1, backend.op_binary(data, op)
+    yield "rank", 1, backend.op_rank(data)
+    yield "contains", 1, backend.op_contains(data)
+
+
+def measure(fn, min_time, repeat):
+    """Best time of one call, in seconds, over ``repeat`` batches."""
+    loops = 1
+    while True:
+        start = time.perf_counter()
+        for _ in range(loops):
+            fn()
+        elapsed = time.perf_counter() - start
+        if elapsed >= min_time:
+            break
+        loops *= 2
+    best = elapsed / loops
+    for _ in range(repeat - 1):
+        start = time.perf_counter()
+        for _ in range(loops):
+            fn()
+        best = min(best, (time.perf_counter() - start) / loops)
+    return best
+
+
+def run(sizes, backends, min_time, repeat, only):
+    rng = random.Random(42)
+    results = []
+    for n in sizes:
+        bits_a = [rng.random() < 0.5 for _ in range(n)]
+        bits_b = [rng.random() < 0.5 for _ in range(n)]
+        # 64 ones in a row: absent from random data, so 'in' scans it all.
+        pattern = [True] * min(64, n)
+        sequential = list(range(min(ACCESSES, n)))
+        for backend in backends:
+            data = Data(backend, n, bits_a, bits_b, pattern, n)
+            for op, ops, fn in benchmarks(backend, data, sequential):
+                if fn is None or (only and not fnmatch.fnmatch(op, only)):
+                    continue
+                seconds = measure(fn, min_time, repeat)
+                results.append({
+                    "op": op, "backend": backend.name, "n_bits": n,
+                    "ns_per_op": round(seconds * 1e9 / ops, 3),
+                })
+                print("%-18s %-10s %10d bits %14.1f ns/op"
+                      % (op, backend.name, n, seconds * 1e9 / ops),
+                      file=sys.stderr)
+    return results
+
+
+def compare(old, new):
+    """Print new/old time ratios of the entries present in both runs."""
+    key = lambda r: (r["op"], r["backend"], r["n_bits"])
+    before = {key(r): r["ns_per_op"] for r in old["results"]}
+    print("%-18s %-10s %10s %12s %12s %7s"
+          % ("op", "backend", "bits", "old ns/op", "new ns/op", "ratio"))
+    for r in new["results"]:
+        if key(r) in before and before[key(r)] > 0:
+            print("%-18s %-10s %10d %12.1f %12.1f %7.2f"
+                  % (r["op"], r["backend"], r["n_bits"], before[key(r)],
+                     r["ns_per_op"], r["ns_per_op"] / before[key(r)]))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--sizes", type=int, nargs="+",
+                        default=[1 << 10, 1 << 16, 1 << 20],
+                        help="vector sizes in bits")
+    parser.add_argument("--backends", nargs="+",
+                        default=["cbits", "list", "bytearray", "int",
+                                 "numpy"],
+                        help="representations to benchmark")
+    parser.add_argument("--filter", default=None,
+                        help="only run operations matching this glob, "
+                             "e.g. 'slice*'")
+    parser.add_argument("--min-time", type=float, default=0.05,
+                        help="minimum seconds per measured batch")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="batches per result, the best is kept")
+    parser.add_argument("--quick", action="store_true",
+                        help="small sizes and short batches (smoke test)")
+    parser.add_argument("--json", metavar="FILE",
+                        help="write the results as JSON")
+    parser.add_argument("--compare", metavar="FILE",
+                        help="print ratios against an earlier JSON run")
+    args = parser.parse_args(argv)
+    if args.quick:
+        args.sizes, args.min_time, args.repeat = [1 << 10], 0.001, 1
+
+    available = {b.name: b for b in (CbitsBackend(), ListBackend(),
+                                      BytearrayBackend(), IntBackend())}
+    if numpy is not None:
+        available["numpy"] = NumpyBackend()
+    backends = [available[name] for name in args.backends
+                if name in available]
+
+    report = {
+        "schema": SCHEMA,
+        "cbits": cbits.__version__,
+        "python": platform.python_version(),
+        "implementation": platform.python_implementation(),
+        "machine": platform.machine(),
+        "numpy": numpy.__version__ if numpy is not None else None,
+        "results": run(args.sizes, backends, args.min_time, args.repeat,
+                       args.filter),
+    }
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+    if args.compare:
+        with open(args.compare) as f:
+            compare(json.load(f), report)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,168 @@
+/**
+ * @file bit_sliced_index.h
+ * @brief Public C API for the bit-sliced index over an integer column.
+ *
+ * A BitSlicedIndex stores a column of signed 64-bit integers, some of which
+ * may be missing, as one BitVector per bit of the value (a slice) plus an
+ * existence vector. Values are stored relative to the column minimum, so
+ * the slice count is the bit width of <tt>max - min</tt>. Predicates are
+ * answered with O'Neil's bit-sliced algorithms: a comparison walks the
+ * slices from the most significant bit down, one result word at a time,
+ * so every slice word is read once and no intermediate vector is written.
+ *
+ * Declares:
+ * - construction and destruction (@ref bsi_new, @ref bsi_free)
+ * - element access (@ref bsi_get)
+ * - predicates (@ref bsi_compare, @ref bsi_between)
+ * - aggregates (@ref bsi_slice_counts, @ref bsi_top_k)
+ *
+ * Results and filters are BitVectors with one bit per row. Missing rows
+ * never match a predicate.
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_BIT_SLICED_INDEX_H
+#define CBITS_BIT_SLICED_INDEX_H
+
+#include "bitvector.h"
+
+/**
+ * @def BSI_MAX_SLICES
+ * @brief Maximum number of slices (bits per stored value).
+ */
+#define BSI_MAX_SLICES 64
+
+/**
+ * @brief Comparison applied by @ref bsi_compare.
+ */
+typedef enum {
+    BSI_EQ, /**< Equal to the constant. */
+    BSI_NE, /**< Not equal to the constant. */
+    BSI_LT, /**< Less than the constant. */
+    BSI_LE, /**< Less than or equal to the constant. */
+    BSI_GT, /**< Greater than the constant. */
+    BSI_GE, /**< Greater than or equal to the constant. */
+} BSIOp;
+
+/**
+ * @brief Bit-sliced index over a column of signed 64-bit integers.
+ *
+ * Row @c r holds <tt>base + sum(slice_b[r] << b)</tt> if bit @c r of
+ * @c exists is set. Slice bits of missing rows are zero.
+ */
+typedef struct {
+    size_t n_rows;                     /**< Number of rows. */
+    unsigned n_slices;                 /**< Bits per stored value. */
+    int64_t base;                      /**< Value stored as zero. */
+    BitVector *exists;                 /**< Bit @c r set if row @c r has a
+                                            value. */
+    BitVector *slices[BSI_MAX_SLICES]; /**< One bit plane per value bit. */
+} BitSlicedIndex;
+
+/**
+ * @brief Build an index from a buffer of integers.
+ *
+ * The column is sliced 64 rows at a time with @ref bm_transpose64.
+ * @param values Row values (may be NULL if @p n_rows is 0); entries of
+ *        missing rows are ignored.
+ * @param exists Rows that have a value, @p n_rows bits wide, or NULL if
+ *        every row has one.
+ * @param n_rows Number of rows.
+ * @retval BitSlicedIndex* Newly allocated index.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitSlicedIndex *
+bsi_new(const int64_t *values, const BitVector *exists, size_t n_rows);
+/**
+ * @brief Free an index.
+ * @param bsi Index to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+bsi_free(BitSlicedIndex *bsi);
+
+/**
+ * @brief Read the value of one row.
+ * @param bsi Pointer to the index.
+ * @param row Row index, less than @c n_rows.
+ * @param value Receives the value if the row has one.
+ * @return @c true if the row has a value.
+ * @since 0.4.0
+ */
+bool
+bsi_get(const BitSlicedIndex *bsi, size_t row, int64_t *value);
+
+/**
+ * @brief Rows whose value compares to a constant.
+ * @param bsi Pointer to the index.
+ * @param op Comparison.
+ * @param value Constant on the right-hand side.
+ * @retval BitVector* New vector of @c n_rows bits.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bsi_compare(const BitSlicedIndex *bsi, BSIOp op, int64_t value);
+/**
+ * @brief Rows whose value lies in <tt>[lo, hi]</tt>.
+ *
+ * Both bounds are evaluated in the same pass over the slices.
+ * @param bsi Pointer to the index.
+ * @param lo Smallest matching value.
+ * @param hi Largest matching value.
+ * @retval BitVector* New vector of @c n_rows bits; empty if
+ *         <tt>lo > hi</tt>.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bsi_between(const BitSlicedIndex *bsi, int64_t lo, int64_t hi);
+
+/**
+ * @brief Per-slice set bit counts over a found set.
+ *
+ * The found set is the existing rows, restricted to @p filter if given.
+ * The sum of its values is <tt>base * found + sum(counts[b] << b)</tt>,
+ * which may need more than 64 bits.
+ * @param bsi Pointer to the index.
+ * @param filter Rows to aggregate, @c n_rows bits wide, or NULL.
+ * @param counts Receives @c n_slices counts.
+ * @return Number of rows in the found set.
+ * @since 0.4.0
+ */
+size_t
+bsi_slice_counts(const BitSlicedIndex *bsi, const BitVector *filter,
+                 size_t *counts);
+/**
+ * @brief Rows holding the @p k largest or smallest values.
+ *
+ * Narrows the candidates one slice at a time from the most significant
+ * bit. Ties at the boundary value are broken in favour of lower rows, so
+ * exactly <tt>min(k, found)</tt> rows are returned.
+ * @param bsi Pointer to the index.
+ * @param k Number of rows to return.
+ * @param filter Candidate rows, @c n_rows bits wide, or NULL for every
+ *        existing row.
+ * @param largest @c true for the largest values, @c false for the smallest.
+ * @retval BitVector* New vector of @c n_rows bits.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bsi_top_k(const BitSlicedIndex *bsi, size_t k, const BitVector *filter,
+          bool largest);
+
+/**
+ * @brief Number of heap bytes held by the index.
+ * @param bsi Pointer to the index.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+bsi_memory_usage(const BitSlicedIndex *bsi);
+
+#endif /* CBITS_BIT_SLICED_INDEX_H */
@@ -0,0 +1,168 @@
+/**
+ * @file bitmap_index.h
+ * @brief Public C API for the bitmap index and its boolean query planner.
+ *
+ * A BitmapIndex owns many BitVectors of one length, typically one per
+ * attribute value, together with their popcounts and a summary with one
+ * bit per chunk of @ref BMI_CHUNK_WORDS words that is set if the chunk has
+ * a set bit. A query is a tree of @ref BMIQuery nodes over vector indexes.
+ *
+ * Queries are planned once and then evaluated chunk by chunk, so the
+ * operands and intermediates of one chunk stay in cache:
+ * - nested AND and OR nodes are flattened, NOT and ANDNOT become negated
+ *   operands of an AND, and double negations cancel
+ * - AND operands are ordered by increasing estimated cardinality (from the
+ *   cached popcounts) and negated operands by decreasing cardinality, so
+ *   the running result empties as early as possible
+ * - an operand whose chunk is empty according to the summary is never
+ *   read, and an AND stops at the first empty intermediate
+ *
+ * Declares:
+ * - construction and destruction (@ref bmi_new, @ref bmi_free)
+ * - vector management (@ref bmi_add, @ref bmi_set, @ref bmi_remove)
+ * - queries (@ref bmi_query, @ref bmi_query_count)
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_BITMAP_INDEX_H
+#define CBITS_BITMAP_INDEX_H
+
+#include "bitvector.h"
+
+/**
+ * @def BMI_CHUNK_WORDS
+ * @brief Words of every operand combined per evaluation step (2 KiB).
+ */
+#define BMI_CHUNK_WORDS 256
+
+/**
+ * @brief Node type of a query tree.
+ */
+typedef enum {
+    BMI_KEY,    /**< Leaf: the vector at index @c vector. */
+    BMI_AND,    /**< Intersection of one or more children. */
+    BMI_OR,     /**< Union of one or more children. */
+    BMI_NOT,    /**< Complement of exactly one child. */
+    BMI_ANDNOT, /**< First child minus all following children. */
+} BMIOp;
+
+/**
+ * @brief Node of a query tree.
+ */
+typedef struct BMIQuery {
+    BMIOp op;                        /**< Node type. */
+    size_t vector;                   /**< Vector index for @ref BMI_KEY. */
+    size_t n_children;               /**< Number of children. */
+    const struct BMIQuery *children; /**< Array of @c n_children nodes. */
+} BMIQuery;
+
+/**
+ * @brief One stored vector with its cached statistics.
+ */
+typedef struct {
+    BitVector *bv;      /**< Owned copy of the vector. */
+    size_t count;       /**< Number of set bits. */
+    uint64_t *nonempty; /**< Bit @c c set if chunk @c c has a set bit. */
+} BMIEntry;
+
+/**
+ * @brief Growable set of equally long BitVectors addressed by index.
+ */
+typedef struct {
+    size_t n_bits;     /**< Bits per vector. */
+    size_t n_chunks;   /**< Chunks of @ref BMI_CHUNK_WORDS words. */
+    size_t size;       /**< Number of stored vectors. */
+    size_t capacity;   /**< Number of allocated entries. */
+    BMIEntry *entries; /**< @c size entries. */
+} BitmapIndex;
+
+/**
+ * @brief Allocate an empty index.
+ * @param n_bits Length of every vector.
+ * @retval BitmapIndex* Newly allocated index.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitmapIndex *
+bmi_new(size_t n_bits);
+/**
+ * @brief Free an index and all its vectors.
+ * @param bmi Index to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+bmi_free(BitmapIndex *bmi);
+
+/**
+ * @brief Append a copy of a vector.
+ * @param bmi Pointer to the index.
+ * @param bv Vector of @c n_bits bits.
+ * @return Index of the new vector, or @c SIZE_MAX if the length differs or
+ *         on allocation failure.
+ * @since 0.4.0
+ */
+size_t
+bmi_add(BitmapIndex *bmi, const BitVector *bv);
+/**
+ * @brief Replace the vector at an index with a copy of another.
+ * @param bmi Pointer to the index.
+ * @param index Vector index, below @c size.
+ * @param bv Vector of @c n_bits bits.
+ * @retval 0 Success.
+ * @retval -1 Index out of range, length mismatch or allocation failure;
+ *         the index is unchanged.
+ * @since 0.4.0
+ */
+int
+bmi_set(BitmapIndex *bmi, size_t index, const BitVector *bv);
+/**
+ * @brief Remove the vector at an index.
+ *
+ * The last vector moves into the freed position.
+ * @param bmi Pointer to the index.
+ * @param index Vector index, below @c size.
+ * @since 0.4.0
+ */
+void
+bmi_remove(BitmapIndex *bmi, size_t index);
+
+/**
+ * @brief Evaluate a query tree.
+ * @param bmi Pointer to the index.
+ * @param query Root of the query.
+ * @retval BitVector* New vector of @c n_bits bits.
+ * @retval NULL Malformed query (unknown vector, wrong number of children)
+ *         or allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bmi_query(const BitmapIndex *bmi, const BMIQuery *query);
+/**
+ * @brief Number of set bits in the result of a query.
+ *
+ * Evaluates like @ref bmi_query but counts every chunk instead of storing
+ * it.
+ * @param bmi Pointer to the index.
+ * @param query Root of the query.
+ * @param count Receives the number of matching bits.
+ * @retval 0 Success.
+ * @retval -1 Malformed query or allocation failure.
+ * @since 0.4.0
+ */
+int
+bmi_query_count(const BitmapIndex *bmi, const BMIQuery *query,
+                size_t *count);
+
+/**
+ * @brief Number of heap bytes held by the index.
+ * @param bmi Pointer to the index.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+bmi_memory_usage(const BitmapIndex *bmi);
+
+#endif /* CBITS_BITMAP_INDEX_H */
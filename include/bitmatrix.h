@@ -0,0 +1,260 @@
+/**
+ * @file bitmatrix.h
+ * @brief Public C API for the row-major BitMatrix.
+ *
+ * A BitMatrix stores @c n_rows rows of @c n_cols bits in one contiguous
+ * allocation. Every row starts on a @ref BV_ALIGN boundary (the row stride
+ * is rounded up to whole cache lines), so a row has exactly the layout of a
+ * BitVector word array and can be handed out as one without copying.
+ *
+ * Declares:
+ * - construction and destruction (@ref bm_new, @ref bm_copy, @ref bm_free)
+ * - element access (@ref bm_get, @ref bm_set, @ref bm_clear)
+ * - rows (@ref bm_row_view, @ref bm_set_row, @ref bm_row_op)
+ * - columns (@ref bm_column) and @ref bm_transpose
+ * - counts and reductions (@ref bm_row_popcount, @ref bm_col_popcount,
+ *   @ref bm_reduce_rows, @ref bm_reduce_cols)
+ *
+ * Bits past @c n_cols in every row, including the stride padding, are kept
+ * zero.
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_BITMATRIX_H
+#define CBITS_BITMATRIX_H
+
+#include "bitvector.h"
+
+/**
+ * @def BM_STRIDE_WORDS
+ * @brief Row stride granularity in 64-bit words (one @ref BV_ALIGN line).
+ */
+#define BM_STRIDE_WORDS (BV_ALIGN / sizeof(uint64_t))
+
+/**
+ * @brief Bitwise operator applied by row operations and reductions.
+ */
+typedef enum {
+    BM_AND, /**< Intersection. */
+    BM_OR,  /**< Union. */
+    BM_XOR, /**< Symmetric difference (parity for reductions). */
+} BMOp;
+
+/**
+ * @brief Row-major two-dimensional bit array.
+ *
+ * @c rows holds one BitVector header per row whose @c data points into
+ * @c data. Headers get their rank tables on the first @ref bm_row_view
+ * call; matrix mutators mark the affected headers' rank tables dirty.
+ */
+typedef struct {
+    size_t n_rows;    /**< Number of rows. */
+    size_t n_cols;    /**< Bits per row. */
+    size_t row_words; /**< Words holding the bits of one row. */
+    size_t stride;    /**< Words between two row starts. */
+    uint64_t *data;   /**< Row-major words, @ref BV_ALIGN aligned. */
+    BitVector *rows;  /**< Per-row BitVector headers. */
+} BitMatrix;
+
+/**
+ * @brief Allocate a zeroed BitMatrix.
+ * @param n_rows Number of rows.
+ * @param n_cols Number of columns (bits per row).
+ * @retval BitMatrix* Newly allocated matrix.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitMatrix *
+bm_new(size_t n_rows, size_t n_cols);
+/**
+ * @brief Deep-copy a BitMatrix.
+ * @param src Source matrix.
+ * @retval BitMatrix* Newly allocated copy.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitMatrix *
+bm_copy(const BitMatrix *src);
+/**
+ * @brief Free a BitMatrix and all row headers.
+ * @param m Matrix to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+bm_free(BitMatrix *m);
+
+/**
+ * @brief Pointer to the first word of a row.
+ * @param m Pointer to the BitMatrix.
+ * @param r Row index (unchecked).
+ * @return Row words; @c stride words are valid.
+ * @since 0.4.0
+ */
+static inline uint64_t *
+bm_row(const BitMatrix *m, size_t r)
+{
+    return m->data + r * m->stride;
+}
+
+/**
+ * @brief Get the bit at a row and column.
+ * @param m Pointer to the BitMatrix.
+ * @param r Row index.
+ * @param c Column index.
+ * @return @c 0 or @c 1, or @c -1 if out of range.
+ * @since 0.4.0
+ */
+int
+bm_get(const BitMatrix *m, size_t r, size_t c);
+/**
+ * @brief Set the bit at a row and column (no-op if out of range).
+ * @param m Pointer to the BitMatrix.
+ * @param r Row index.
+ * @param c Column index.
+ * @since 0.4.0
+ */
+void
+bm_set(BitMatrix *m, size_t r, size_t c);
+/**
+ * @brief Clear the bit at a row and column (no-op if out of range).
+ * @param m Pointer to the BitMatrix.
+ * @param r Row index.
+ * @param c Column index.
+ * @since 0.4.0
+ */
+void
+bm_clear(BitMatrix *m, size_t r, size_t c);
+
+/**
+ * @brief Borrow a row as a BitVector that shares the matrix memory.
+ *
+ * The returned header is owned by the matrix and stays valid until
+ * @ref bm_free; it must not be passed to @ref bv_free. Writes through it
+ * change the matrix.
+ * @param m Pointer to the BitMatrix.
+ * @param r Row index.
+ * @retval BitVector* Row view.
+ * @retval NULL @p r out of range, or allocation failure of the rank tables.
+ * @since 0.4.0
+ */
+BitVector *
+bm_row_view(BitMatrix *m, size_t r);
+/**
+ * @brief Overwrite a row with the contents of a BitVector.
+ * @param m Pointer to the BitMatrix.
+ * @param r Row index.
+ * @param bv Source of @c n_cols bits.
+ * @retval 0 Success.
+ * @retval -1 @p r out of range or length mismatch.
+ * @since 0.4.0
+ */
+int
+bm_set_row(BitMatrix *m, size_t r, const BitVector *bv);
+/**
+ * @brief Combine row @p src into row @p dst in place.
+ * @param m Pointer to the BitMatrix.
+ * @param dst Destination row.
+ * @param src Source row.
+ * @param op Operator.
+ * @retval 0 Success.
+ * @retval -1 Row index out of range.
+ * @since 0.4.0
+ */
+int
+bm_row_op(BitMatrix *m, size_t dst, size_t src, BMOp op);
+
+/**
+ * @brief Gather one column into a new BitVector.
+ * @param m Pointer to the BitMatrix.
+ * @param c Column index.
+ * @retval BitVector* New vector of @c n_rows bits.
+ * @retval NULL @p c out of range or allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bm_column(const BitMatrix *m, size_t c);
+/**
+ * @brief Transpose a matrix.
+ *
+ * Works on 64x64 tiles: each tile is loaded as 64 words, transposed in
+ * registers with six rounds of masked swaps, and stored as 64 words of the
+ * result.
+ * @param m Pointer to the BitMatrix.
+ * @retval BitMatrix* New @c n_cols x @c n_rows matrix.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitMatrix *
+bm_transpose(const BitMatrix *m);
+/**
+ * @brief Transpose a 64x64 bit tile in place.
+ *
+ * Bit @c j of @c tile[i] moves to bit @c i of @c tile[j].
+ * @param tile Sixty-four words.
+ * @since 0.4.0
+ */
+void
+bm_transpose64(uint64_t tile[64]);
+
+/**
+ * @brief Count the set bits of every row.
+ * @param m Pointer to the BitMatrix.
+ * @param out Array of @c n_rows counts.
+ * @since 0.4.0
+ */
+void
+bm_row_popcount(const BitMatrix *m, size_t *out);
+/**
+ * @brief Count the set bits of every column.
+ * @param m Pointer to the BitMatrix.
+ * @param out Array of @c n_cols counts.
+ * @since 0.4.0
+ */
+void
+bm_col_popcount(const BitMatrix *m, size_t *out);
+/**
+ * @brief Fold all rows into one row with @p op.
+ * @param m Pointer to the BitMatrix.
+ * @param op Operator.
+ * @retval BitVector* New vector of @c n_cols bits (all ones for an AND
+ *         over zero rows).
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bm_reduce_rows(const BitMatrix *m, BMOp op);
+/**
+ * @brief Fold every row into a single bit with @p op.
+ *
+ * Bit @c r of the result is whether row @c r has any set bit (OR), only
+ * set bits (AND), or an odd number of set bits (XOR).
+ * @param m Pointer to the BitMatrix.
+ * @param op Operator.
+ * @retval BitVector* New vector of @c n_rows bits.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bm_reduce_cols(const BitMatrix *m, BMOp op);
+/**
+ * @brief Compare two matrices for equality.
+ * @param a First matrix.
+ * @param b Second matrix.
+ * @return @c true if both have the same shape and bits.
+ * @since 0.4.0
+ */
+bool
+bm_equal(const BitMatrix *a, const BitMatrix *b);
+/**
+ * @brief Number of heap bytes held by the matrix.
+ * @param m Pointer to the BitMatrix.
+ * @return Footprint in bytes, including row headers and rank tables.
+ * @since 0.4.0
+ */
+size_t
+bm_memory_usage(const BitMatrix *m);
+
+#endif /* CBITS_BITMATRIX_H */
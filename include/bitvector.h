@@ -4,13 +4,20 @@
  *
  * Declares the stable, external-facing API for working with BitVectors:
  * - construction and destruction (@ref bv_new, @ref bv_copy, @ref bv_free)
+ * - memory accounting (@ref bv_memory_usage)
  * - single-bit operations (@ref bv_get, @ref bv_set, @ref bv_clear, @ref
  * bv_flip)
  * - range operations (@ref bv_set_range, @ref bv_clear_range, @ref
  * bv_flip_range)
+ * - population counts (@ref bv_count, @ref bv_count_range)
  * - rank queries (@ref bv_build_rank, @ref bv_rank)
- * - comparison and subvector search (@ref bv_equal, @ref
+ * - comparison, hashing and subvector search (@ref bv_equal, @ref bv_compare,
+ * @ref bv_is_subset, @ref bv_is_disjoint, @ref bv_hash, @ref
  * bv_contains_subvector)
+ * - n-ary reductions (@ref bv_and_all, @ref bv_or_all, @ref bv_xor_all,
+ * @ref bv_threshold)
+ * - byte conversion (@ref bv_to_bytes, @ref bv_from_bytes, @ref bv_to_bools,
+ * @ref bv_from_bools)
  *
  * The public API is intentionally minimal. Internal helpers, inline
  * fast‑paths, and low‑level utilities are defined separately in @ref
@@ -92,6 +99,31 @@ bv_copy(const BitVector *src);
 void
 bv_free(BitVector *bv);
 
+/**
+ * @brief Heap bytes behind one BitVector, split by allocation.
+ * @since 0.4.0
+ */
+typedef struct {
+    size_t header;      /**< The BitVector struct. */
+    size_t data;        /**< Words holding the bits. */
+    size_t padding;     /**< Zeroed guard word after the data. */
+    size_t rank_tables; /**< Superblock and block rank tables. */
+} bv_memory;
+
+/**
+ * @brief Memory held by a BitVector.
+ *
+ * Counts the allocations @ref bv_new makes; for headers that borrow their
+ * words, such as BitMatrix rows, it describes the borrowed layout.
+ *
+ * @param bv BitVector, may be NULL.
+ * @param parts Receives the breakdown if not NULL.
+ * @return Sum of the parts in bytes, 0 for NULL.
+ * @since 0.4.0
+ */
+size_t
+bv_memory_usage(const BitVector *bv, bv_memory *parts);
+
 /**
  * @brief Set all bits in the half-open range [start, start+len).
  *
@@ -125,6 +157,30 @@ bv_clear_range(BitVector *bv, size_t start, size_t len);
  */
 void
 bv_flip_range(BitVector *bv, size_t start, size_t len);
+/**
+ * @brief Count all set bits.
+ *
+ * Streams the words through the bulk popcount kernel; unlike
+ * @ref bv_rank it neither needs nor builds the rank tables.
+ * @param bv Pointer to the BitVector
+ * @return Number of set bits
+ * @since 0.4.0
+ */
+size_t
+bv_count(const BitVector *bv);
+/**
+ * @brief Count the set bits in the half-open range [start, start+len).
+ *
+ * The range is clamped to the vector like in @ref bv_set_range. Does not
+ * build the rank tables.
+ * @param bv Pointer to the BitVector
+ * @param start Start bit index
+ * @param len Number of bits to count
+ * @return Number of set bits in the range
+ * @since 0.4.0
+ */
+size_t
+bv_count_range(const BitVector *bv, size_t start, size_t len);
 
 /**
  * @brief Build or rebuild the rank tables for a BitVector.
@@ -156,6 +212,72 @@ bv_rank(BitVector *bv, const size_t pos);
  */
 bool
 bv_equal(const BitVector *a, const BitVector *b);
+/**
+ * @brief Orders of @ref bv_compare.
+ * @since 0.4.0
+ */
+typedef enum {
+    BV_ORDER_LEX,     /**< Bit by bit from index 0, like tuples of bools. */
+    BV_ORDER_NUMERIC, /**< As unsigned integers, bit i weighing 2^i. */
+} BVOrder;
+
+/**
+ * @brief Three-way comparison of two BitVectors.
+ *
+ * With @ref BV_ORDER_LEX the lowest index where the bits differ decides,
+ * and a vector that is a prefix of the other is smaller. With
+ * @ref BV_ORDER_NUMERIC the highest differing bit decides, bits missing
+ * from the shorter vector count as zero, and equal values are ordered by
+ * length. Both are total orders in which only equal vectors compare 0.
+ * @param a First BitVector
+ * @param b Second BitVector
+ * @param order Order to compare in
+ * @return Negative, zero or positive as @p a is below, equal to or above
+ *         @p b
+ * @since 0.4.0
+ */
+int
+bv_compare(const BitVector *a, const BitVector *b, BVOrder order);
+/**
+ * @brief Check whether every bit set in @p a is also set in @p b.
+ *
+ * Stops at the first chunk of words with a counterexample and allocates
+ * nothing.
+ * @param a Candidate subset
+ * @param b Candidate superset
+ * @return @c true if a is a subset of b, @c false otherwise or if the
+ *         lengths differ
+ * @since 0.4.0
+ */
+bool
+bv_is_subset(const BitVector *a, const BitVector *b);
+/**
+ * @brief Check whether @p a and @p b have no set bit in common.
+ *
+ * Stops at the first chunk of words with a common bit and allocates
+ * nothing.
+ * @param a First BitVector
+ * @param b Second BitVector
+ * @return @c true if the vectors are disjoint, @c false otherwise or if the
+ *         lengths differ
+ * @since 0.4.0
+ */
+bool
+bv_is_disjoint(const BitVector *a, const BitVector *b);
+/**
+ * @brief 64-bit fingerprint of the length and bits of a BitVector.
+ *
+ * XXH64 over the data words, streamed in place without a copy, with the
+ * bit length mixed into the seed. Equal vectors hash equally for the same
+ * seed; the value is stable across runs on machines of the same byte
+ * order.
+ * @param bv Pointer to the BitVector
+ * @param seed Hash seed
+ * @return 64-bit hash, 0 for NULL
+ * @since 0.4.0
+ */
+uint64_t
+bv_hash(const BitVector *bv, uint64_t seed);
 /**
  * @brief Check weather B appears as a contiguous sub-bitvector of A.
  *
@@ -232,4 +354,119 @@ bv_concat(const BitVector *a, const BitVector *b);
 BitVector *
 bv_repeat(const BitVector *bv, const size_t count);
 
+/**
+ * @brief Intersect many BitVectors into one new BitVector.
+ *
+ * Streams over all inputs one cache-sized block of the output at a time,
+ * so no intermediate vectors are allocated.
+ * @param vs Array of @p n BitVectors of equal length.
+ * @param n Number of inputs, at least one.
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL If @p n is zero, the lengths differ or allocation fails.
+ * @since 0.4.0
+ */
+BitVector *
+bv_and_all(const BitVector *const *vs, size_t n);
+/**
+ * @brief Unite many BitVectors into one new BitVector.
+ *
+ * Like @ref bv_and_all with OR.
+ * @param vs Array of @p n BitVectors of equal length.
+ * @param n Number of inputs, at least one.
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL If @p n is zero, the lengths differ or allocation fails.
+ * @since 0.4.0
+ */
+BitVector *
+bv_or_all(const BitVector *const *vs, size_t n);
+/**
+ * @brief XOR many BitVectors into one new BitVector.
+ *
+ * Like @ref bv_and_all with XOR; a bit is set if it is set in an odd
+ * number of inputs.
+ * @param vs Array of @p n BitVectors of equal length.
+ * @param n Number of inputs, at least one.
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL If @p n is zero, the lengths differ or allocation fails.
+ * @since 0.4.0
+ */
+BitVector *
+bv_xor_all(const BitVector *const *vs, size_t n);
+/**
+ * @brief Bits set in at least @p k of many BitVectors.
+ *
+ * Counts every bit position with bit-sliced vertical counters of
+ * ``bit_length(k)`` words plus a saturation word per output word, one
+ * cache-sized block at a time. ``k == n / 2 + 1`` gives the majority.
+ * @param vs Array of @p n BitVectors of equal length.
+ * @param n Number of inputs, at least one.
+ * @param k Threshold; 0 sets every bit, values above @p n set none.
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL If @p n is zero, the lengths differ or allocation fails.
+ * @since 0.4.0
+ */
+BitVector *
+bv_threshold(const BitVector *const *vs, size_t n, size_t k);
+
+/**
+ * @brief Bit orders of @ref bv_to_bytes and @ref bv_from_bytes.
+ * @since 0.4.0
+ */
+typedef enum {
+    BV_BITORDER_LITTLE, /**< Bit i is bit i % 8 of byte i / 8. */
+    BV_BITORDER_BIG,    /**< Bit i is bit 7 - i % 8 of byte i / 8. */
+} BVBitOrder;
+
+/**
+ * @brief Pack the bits of a BitVector into bytes.
+ *
+ * Writes ``(n_bits + 7) / 8`` bytes; padding bits of the last byte are
+ * zero. Little bit order on a little-endian host is a plain copy of the
+ * words, big bit order reverses the bits of each byte a word at a time.
+ * @param bv Pointer to the BitVector
+ * @param out Destination of at least ``(n_bits + 7) / 8`` bytes
+ * @param order Bit order within each byte
+ * @since 0.4.0
+ */
+void
+bv_to_bytes(const BitVector *bv, uint8_t *out, BVBitOrder order);
+/**
+ * @brief Build a BitVector from packed bytes.
+ *
+ * Inverse of @ref bv_to_bytes; bits of @p in beyond @p n_bits are
+ * ignored.
+ * @param in Source of at least ``(n_bits + 7) / 8`` bytes
+ * @param n_bits Number of bits
+ * @param order Bit order within each byte
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL On allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bv_from_bytes(const uint8_t *in, size_t n_bits, BVBitOrder order);
+/**
+ * @brief Unpack a BitVector into one byte per bit.
+ *
+ * Writes ``n_bits`` bytes, 1 for set and 0 for clear bits, through the
+ * dispatched @ref cbits_unpack_bools kernel.
+ * @param bv Pointer to the BitVector
+ * @param out Destination of at least ``n_bits`` bytes
+ * @since 0.4.0
+ */
+void
+bv_to_bools(const BitVector *bv, uint8_t *out);
+/**
+ * @brief Build a BitVector from one byte per bit.
+ *
+ * Bit i is set if byte i of @p in is non-zero; packed by the dispatched
+ * @ref cbits_pack_bools kernel.
+ * @param in Source of @p n_bits bytes, e.g. a NumPy @c bool array
+ * @param n_bits Number of bits
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL On allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bv_from_bools(const uint8_t *in, size_t n_bits);
+
 #endif /* CBITS_BITVECTOR_H */
@@ -0,0 +1,187 @@
+/**
+ * @file bitvector_collection.h
+ * @brief Public C API for packed collections of equally long BitVectors.
+ *
+ * A BitVectorCollection stores many fixed-width bit vectors back to back in
+ * one cache-line aligned block, one slot of @c stride words per vector, so a
+ * similarity search streams through memory without touching per-vector
+ * headers or allocating intermediates. Distances are Hamming distances
+ * computed by @ref cbits_hamming_batch, which XORs the query into every row
+ * and counts the result with the best popcount kernel of the CPU.
+ *
+ * Declares:
+ * - construction and growth (@ref bvc_new, @ref bvc_free, @ref bvc_append)
+ * - element access (@ref bvc_row, @ref bvc_get)
+ * - searches (@ref bvc_distances, @ref bvc_knn, @ref bvc_within_radius)
+ * - all-pairs distances (@ref bvc_pairwise)
+ *
+ * Searches split the collection into contiguous parts that run on up to
+ * @c n_threads threads through @ref cbits_parallel_for; results do not
+ * depend on the thread count.
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_BITVECTOR_COLLECTION_H
+#define CBITS_BITVECTOR_COLLECTION_H
+
+#include "bitvector.h"
+
+/**
+ * @def BVC_BATCH
+ * @brief Rows whose distances are computed by one kernel call.
+ */
+#define BVC_BATCH 256
+/**
+ * @def BVC_PARALLEL_MIN_ROWS
+ * @brief Minimum number of rows given to each thread of a search.
+ */
+#define BVC_PARALLEL_MIN_ROWS (1u << 14)
+
+/**
+ * @brief One search hit.
+ */
+typedef struct {
+    size_t index;    /**< Position of the vector in the collection. */
+    size_t distance; /**< Hamming distance to the query. */
+} BVCMatch;
+
+/**
+ * @brief Growable array of fixed-width bit vectors in one aligned block.
+ */
+typedef struct {
+    size_t n_bits;   /**< Bits per vector. */
+    size_t n_words;  /**< Used 64-bit words per vector. */
+    size_t stride;   /**< Words per slot: a power of two up to 8, then a
+                          multiple of 8, so no slot straddles a cache
+                          line. */
+    size_t size;     /**< Number of stored vectors. */
+    size_t capacity; /**< Number of allocated slots. */
+    uint64_t *data;  /**< @c capacity slots of @c stride words. */
+} BitVectorCollection;
+
+/**
+ * @brief Pointer to the words of one stored vector.
+ * @param c Pointer to the collection.
+ * @param i Vector index; must be below @c size.
+ * @return First of @c n_words words; bits past @c n_bits are zero.
+ * @since 0.4.0
+ */
+static inline const uint64_t *
+bvc_row(const BitVectorCollection *c, size_t i)
+{
+    return c->data + i * c->stride;
+}
+
+/**
+ * @brief Allocate an empty collection.
+ * @param n_bits Width of every vector, at most @c UINT32_MAX bits.
+ * @retval BitVectorCollection* Newly allocated collection.
+ * @retval NULL Allocation failure or width too large.
+ * @since 0.4.0
+ */
+BitVectorCollection *
+bvc_new(size_t n_bits);
+/**
+ * @brief Free a collection.
+ * @param c Collection to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+bvc_free(BitVectorCollection *c);
+/**
+ * @brief Make room for at least @p capacity vectors.
+ * @param c Pointer to the collection.
+ * @param capacity Requested number of slots.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure (the collection is unchanged).
+ * @since 0.4.0
+ */
+int
+bvc_reserve(BitVectorCollection *c, size_t capacity);
+/**
+ * @brief Append a copy of a vector.
+ * @param c Pointer to the collection.
+ * @param bv Vector of exactly @c n_bits bits.
+ * @retval 0 Success.
+ * @retval -1 Width mismatch or allocation failure.
+ * @since 0.4.0
+ */
+int
+bvc_append(BitVectorCollection *c, const BitVector *bv);
+/**
+ * @brief Copy one stored vector into a new BitVector.
+ * @param c Pointer to the collection.
+ * @param i Vector index; must be below @c size.
+ * @retval BitVector* New vector.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+bvc_get(const BitVectorCollection *c, size_t i);
+/**
+ * @brief Hamming distance from a query to every stored vector.
+ * @param c Pointer to the collection.
+ * @param query Vector of @c n_bits bits.
+ * @param out Output of @c size distances.
+ * @param n_threads Thread count; @c 0 picks one per processor.
+ * @since 0.4.0
+ */
+void
+bvc_distances(const BitVectorCollection *c, const BitVector *query,
+              uint32_t *out, unsigned n_threads);
+/**
+ * @brief The @p k stored vectors closest to a query.
+ *
+ * Ties are broken by the smaller index, so the result is deterministic.
+ * @param c Pointer to the collection.
+ * @param query Vector of @c n_bits bits.
+ * @param k Number of neighbours requested.
+ * @param out Output of @c min(k, size) matches, nearest first.
+ * @param n_threads Thread count; @c 0 picks one per processor.
+ * @return Number of matches written, or @c SIZE_MAX on allocation failure.
+ * @since 0.4.0
+ */
+size_t
+bvc_knn(const BitVectorCollection *c, const BitVector *query, size_t k,
+        BVCMatch *out, unsigned n_threads);
+/**
+ * @brief All stored vectors within a Hamming radius of a query.
+ * @param c Pointer to the collection.
+ * @param query Vector of @c n_bits bits.
+ * @param radius Largest accepted distance (inclusive).
+ * @param n_out Receives the number of matches.
+ * @param n_threads Thread count; @c 0 picks one per processor.
+ * @retval BVCMatch* Matches in increasing index order; release with
+ *         @c free. Never NULL on success, even without matches.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BVCMatch *
+bvc_within_radius(const BitVectorCollection *c, const BitVector *query,
+                  size_t radius, size_t *n_out, unsigned n_threads);
+/**
+ * @brief Distance matrix between two collections.
+ * @param a Row collection.
+ * @param b Column collection of the same width (may be @p a).
+ * @param out Output of <tt>a->size * b->size</tt> distances, row-major.
+ * @param n_threads Thread count; @c 0 picks one per processor.
+ * @retval 0 Success.
+ * @retval -1 Width mismatch.
+ * @since 0.4.0
+ */
+int
+bvc_pairwise(const BitVectorCollection *a, const BitVectorCollection *b,
+             uint32_t *out, unsigned n_threads);
+/**
+ * @brief Native memory held by a collection.
+ * @param c Pointer to the collection.
+ * @return Bytes of the header and all slots.
+ * @since 0.4.0
+ */
+size_t
+bvc_memory_usage(const BitVectorCollection *c);
+
+#endif /* CBITS_BITVECTOR_COLLECTION_H */
@@ -5,6 +5,7 @@
  * Provides inline functions used by the C backend and Python bindings:
  * - inline bit operations (\ref bv__get_inline, \ref bv__set_inline, \ref
  * bv__clear_inline, \ref bv__flip_inline)
+ * - in-word select (\ref bv__select_in_word)
  * - tail masking (\ref bv_apply_tail_mask)
  *
  * @see bitvector.h
@@ -90,6 +91,39 @@ bv__flip_inline(BitVector *bv, const size_t pos)
     bv->rank_dirty = true;
 }
 
+/**
+ * @brief Locate the k-th set bit inside a single 64-bit word.
+ *
+ * Locates the target byte without branches from the prefix sums of the
+ * byte popcounts, kept side by side in one word, and then clears the
+ * remaining lower set bits of that byte.
+ * @param w Word to search.
+ * @param k Zero-based index of the set bit to find; must be less than
+ * ``popcount(w)``.
+ * @return Bit offset in [0...63] of the k-th set bit.
+ * @since 0.4.0
+ */
+static inline unsigned
+bv__select_in_word(uint64_t w, unsigned k)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    uint64_t s = w - ((w >> 1) & 0x5555555555555555ULL);
+    s = (s & 0x3333333333333333ULL) + ((s >> 2) & 0x3333333333333333ULL);
+    s = (s + (s >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    /* Byte i of sums counts the set bits of bytes 0..i. */
+    const uint64_t sums = s * ones;
+    /* High bit of byte i is set where sums[i] <= k. */
+    const uint64_t le = (((uint64_t) k * ones | highs) - sums) & highs;
+    const unsigned shift = (unsigned) ((((le >> 7) * ones) >> 56) << 3);
+    k -= (unsigned) (((sums << 8) >> shift) & 0xFF);
+    uint64_t b = (w >> shift) & 0xFF;
+    while (k--) {
+        b &= b - 1;
+    }
+    return shift + cbits_ctz64(b);
+}
+
 /**
  * @brief Mask off any excess bits in the last word of a BitVector.
  * @param bv Pointer to an allocated BitVector.
@@ -0,0 +1,283 @@
+/**
+ * @file bloom_filter.h
+ * @brief Public C API for classic and cache-line blocked Bloom filters.
+ *
+ * A BloomFilter stores its bits in a BitVector and sets @c n_hashes bits per
+ * key. All bit positions of a key are derived from one 64-bit key hash:
+ * - the classic layout spreads them over the whole vector with enhanced
+ *   double hashing, so a lookup touches up to @c n_hashes cache lines
+ * - the blocked layout first picks one 512-bit block (one @ref BV_ALIGN
+ *   cache line) and sets all bits of the key inside it, so every lookup
+ *   touches exactly one line at the price of a slightly higher false
+ *   positive rate for the same size
+ *
+ * Declares:
+ * - sizing and construction (@ref bloom_params, @ref bloom_new,
+ *   @ref bloom_copy, @ref bloom_free)
+ * - key hashing (@ref bloom_hash, @ref bloom_hash_u64 and the batched
+ *   @ref bloom_hash_u64_many, @ref bloom_hash_fixed_many)
+ * - insertion and lookup by hash (@ref bloom_add_hashes,
+ *   @ref bloom_contains_hashes)
+ * - set operations (@ref bloom_union, @ref bloom_intersect)
+ * - serialization (@ref bloom_serialize, @ref bloom_deserialize)
+ *
+ * The batched functions compute the target lines of a whole batch first and
+ * prefetch them, so the cache misses of consecutive keys overlap.
+ *
+ * @see bitvector.h
+ * @see key_hash.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_BLOOM_FILTER_H
+#define CBITS_BLOOM_FILTER_H
+
+#include "bitvector.h"
+#include "key_hash.h"
+
+/**
+ * @def BLOOM_BLOCK_BITS
+ * @brief Bits per block of the blocked layout (one cache line).
+ */
+#define BLOOM_BLOCK_BITS (BV_ALIGN * 8)
+/**
+ * @def BLOOM_MAX_HASHES
+ * @brief Largest supported number of bits per key.
+ */
+#define BLOOM_MAX_HASHES 32
+/**
+ * @def BLOOM_HEADER_BYTES
+ * @brief Size of the header written by @ref bloom_serialize.
+ */
+#define BLOOM_HEADER_BYTES 24
+
+/**
+ * @brief Placement of the bits of one key.
+ */
+typedef enum {
+    BLOOM_CLASSIC = 0, /**< Bits spread over the whole vector. */
+    BLOOM_BLOCKED = 1, /**< All bits inside one 512-bit block. */
+} BloomLayout;
+
+/**
+ * @brief Bloom filter over a BitVector.
+ */
+typedef struct {
+    BitVector *bits;    /**< Filter bits. */
+    BloomLayout layout; /**< Bit placement. */
+    KeyHash hash;       /**< Key hash function. */
+    unsigned n_hashes;  /**< Bits set per key. */
+    uint64_t seed;      /**< Seed of the key hash. */
+} BloomFilter;
+
+/**
+ * @brief Optimal size for an expected number of keys and error rate.
+ *
+ * Uses <tt>m = -n ln(p) / ln(2)^2</tt> and <tt>k = m / n ln(2)</tt>; the
+ * blocked layout rounds @c m up to whole blocks.
+ * @param layout Bit placement.
+ * @param capacity Expected number of keys (at least 1 is assumed).
+ * @param error_rate Target false positive rate in <tt>(0, 1)</tt>.
+ * @param n_bits Receives the number of bits.
+ * @param n_hashes Receives the number of bits per key.
+ * @retval 0 Success.
+ * @retval -1 @p error_rate out of range or the size overflows.
+ * @since 0.4.0
+ */
+int
+bloom_params(BloomLayout layout, size_t capacity, double error_rate,
+             size_t *n_bits, unsigned *n_hashes);
+/**
+ * @brief Allocate an empty filter.
+ * @param layout Bit placement.
+ * @param n_bits Number of bits (at least 1); rounded up to whole blocks
+ *        for the blocked layout.
+ * @param n_hashes Bits per key, from 1 to @ref BLOOM_MAX_HASHES.
+ * @param hash Key hash function.
+ * @param seed Seed of the key hash.
+ * @retval BloomFilter* Newly allocated filter.
+ * @retval NULL Invalid parameters or allocation failure.
+ * @since 0.4.0
+ */
+BloomFilter *
+bloom_new(BloomLayout layout, size_t n_bits, unsigned n_hashes,
+          KeyHash hash, uint64_t seed);
+/**
+ * @brief Deep copy of a filter.
+ * @param f Filter to copy.
+ * @retval BloomFilter* New filter.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BloomFilter *
+bloom_copy(const BloomFilter *f);
+/**
+ * @brief Free a filter.
+ * @param f Filter to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+bloom_free(BloomFilter *f);
+
+/**
+ * @brief Hash a byte string with the filter's hash function and seed.
+ * @param f Pointer to the filter.
+ * @param key Key bytes (may be NULL if @p len is 0).
+ * @param len Key length in bytes.
+ * @return 64-bit key hash.
+ * @since 0.4.0
+ */
+uint64_t
+bloom_hash(const BloomFilter *f, const void *key, size_t len);
+/**
+ * @brief Hash an integer key, taken as its 8 little-endian bytes.
+ * @param f Pointer to the filter.
+ * @param key Key.
+ * @return 64-bit key hash, equal to @ref bloom_hash of those 8 bytes.
+ * @since 0.4.0
+ */
+uint64_t
+bloom_hash_u64(const BloomFilter *f, uint64_t key);
+/**
+ * @brief Hash an array of integer keys.
+ * @param f Pointer to the filter.
+ * @param keys Keys.
+ * @param n Number of keys.
+ * @param out Output of @p n hashes.
+ * @since 0.4.0
+ */
+void
+bloom_hash_u64_many(const BloomFilter *f, const uint64_t *keys, size_t n,
+                    uint64_t *out);
+/**
+ * @brief Hash packed fixed-width byte keys.
+ * @param f Pointer to the filter.
+ * @param data @p n keys of @p width bytes, back to back.
+ * @param width Bytes per key.
+ * @param n Number of keys.
+ * @param out Output of @p n hashes.
+ * @since 0.4.0
+ */
+void
+bloom_hash_fixed_many(const BloomFilter *f, const void *data, size_t width,
+                      size_t n, uint64_t *out);
+
+/**
+ * @brief Insert keys given by their hashes.
+ * @param f Pointer to the filter.
+ * @param hashes Key hashes.
+ * @param n Number of keys.
+ * @since 0.4.0
+ */
+void
+bloom_add_hashes(BloomFilter *f, const uint64_t *hashes, size_t n);
+/**
+ * @brief Look up keys given by their hashes.
+ *
+ * Bit @c i of @p out is set if key @c i may be in the filter; bits that
+ * stay clear are definitely absent. Other bits of @p out are untouched.
+ * @param f Pointer to the filter.
+ * @param hashes Key hashes.
+ * @param n Number of keys.
+ * @param out Result words; the caller clears the first @p n bits.
+ * @since 0.4.0
+ */
+void
+bloom_contains_hashes(const BloomFilter *f, const uint64_t *hashes,
+                      size_t n, uint64_t *out);
+/**
+ * @brief Insert one key given by its hash.
+ * @param f Pointer to the filter.
+ * @param hash Key hash.
+ * @since 0.4.0
+ */
+void
+bloom_add_hash(BloomFilter *f, uint64_t hash);
+/**
+ * @brief Look up one key given by its hash.
+ * @param f Pointer to the filter.
+ * @param hash Key hash.
+ * @return @c true if the key may be present, @c false if it is absent.
+ * @since 0.4.0
+ */
+bool
+bloom_contains_hash(const BloomFilter *f, uint64_t hash);
+
+/**
+ * @brief Whether two filters have the same layout, size, hash and seed.
+ * @param a First filter.
+ * @param b Second filter.
+ * @return @c true if their bits can be combined.
+ * @since 0.4.0
+ */
+bool
+bloom_compatible(const BloomFilter *a, const BloomFilter *b);
+/**
+ * @brief OR another filter into @p dst (set union).
+ * @param dst Target filter.
+ * @param src Compatible filter.
+ * @retval 0 Success.
+ * @retval -1 Filters are not compatible.
+ * @since 0.4.0
+ */
+int
+bloom_union(BloomFilter *dst, const BloomFilter *src);
+/**
+ * @brief AND another filter into @p dst.
+ *
+ * The result answers "may be in both"; it can report more false positives
+ * than a filter built from the intersection of the key sets.
+ * @param dst Target filter.
+ * @param src Compatible filter.
+ * @retval 0 Success.
+ * @retval -1 Filters are not compatible.
+ * @since 0.4.0
+ */
+int
+bloom_intersect(BloomFilter *dst, const BloomFilter *src);
+/**
+ * @brief Estimate the number of distinct keys inserted.
+ *
+ * Uses <tt>-m / k * ln(1 - X / m)</tt> with @c X set bits.
+ * @param f Pointer to the filter.
+ * @return Estimated key count; @c INFINITY if every bit is set.
+ * @since 0.4.0
+ */
+double
+bloom_estimate_count(const BloomFilter *f);
+
+/**
+ * @brief Serialize a filter into a portable little-endian byte string.
+ *
+ * The layout is a @ref BLOOM_HEADER_BYTES header (magic @c "CBBF",
+ * version, layout, hash, hash count, seed and bit count) followed by the
+ * filter words.
+ * @param f Pointer to the filter.
+ * @param n_bytes Receives the length of the result.
+ * @retval uint8_t* Serialized filter; release with @c free.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+uint8_t *
+bloom_serialize(const BloomFilter *f, size_t *n_bytes);
+/**
+ * @brief Rebuild a filter from @ref bloom_serialize output.
+ * @param data Serialized filter.
+ * @param n_bytes Length of @p data.
+ * @retval BloomFilter* New filter.
+ * @retval NULL Malformed input or allocation failure.
+ * @since 0.4.0
+ */
+BloomFilter *
+bloom_deserialize(const void *data, size_t n_bytes);
+/**
+ * @brief Number of heap bytes held by the filter.
+ * @param f Pointer to the filter.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+bloom_memory_usage(const BloomFilter *f);
+
+#endif /* CBITS_BLOOM_FILTER_H */
@@ -0,0 +1,157 @@
+/**
+ * @file bp_tree.h
+ * @brief Public C API for balanced-parentheses tree navigation.
+ *
+ * A BPTree indexes an ordinal tree encoded as a balanced-parentheses
+ * BitVector: a set bit is an opening parenthesis, a clear bit a closing one,
+ * and every node is identified by the position of its opening parenthesis.
+ *
+ * Navigation reduces to searches on the excess function
+ * <tt>E(k) = opens - closes</tt> over the first @c k bits. The index is a
+ * range min-max tree: the bits are cut into blocks of one rank superblock
+ * (@ref BP_BLOCK_BITS bits), so @c super_rank gives the excess at every
+ * block start for free, and a complete binary tree stores the minimum and
+ * maximum excess reached inside each block and each group of blocks. A
+ * search scans its own block bytewise, climbs the tree to the first block
+ * whose [min, max] range contains the target, and scans that block.
+ *
+ * Declares:
+ * - construction and destruction (@ref bp_new, @ref bp_free)
+ * - primitives (@ref bp_excess, @ref bp_find_close, @ref bp_find_open,
+ *   @ref bp_enclose)
+ * - tree operations (@ref bp_parent, @ref bp_first_child,
+ *   @ref bp_next_sibling, @ref bp_subtree_size)
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_BP_TREE_H
+#define CBITS_BP_TREE_H
+
+#include "bitvector.h"
+
+/**
+ * @def BP_BLOCK_BITS
+ * @brief Bits per range min-max tree leaf: one rank superblock.
+ */
+#define BP_BLOCK_BITS ((size_t) BV_WORDS_SUPER * 64)
+
+/**
+ * @brief Range min-max tree over a balanced-parentheses sequence.
+ */
+typedef struct {
+    BitVector *bv;     /**< Private copy of the parentheses. */
+    size_t n_blocks;   /**< Number of blocks (leaves in use). */
+    size_t n_leaves;   /**< Leaf count, a power of two. */
+    int64_t *node_min; /**< Minimum excess per node, 1-based heap order. */
+    int64_t *node_max; /**< Maximum excess per node, 1-based heap order. */
+} BPTree;
+
+/**
+ * @brief Build the navigation index for a parentheses sequence.
+ *
+ * The sequence is copied, so later changes to @p bv are not reflected.
+ * It need not be balanced; searches without an answer return @c SIZE_MAX.
+ * @param bv Parentheses, set bit = '(' and clear bit = ')'.
+ * @retval BPTree* Newly allocated index.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BPTree *
+bp_new(const BitVector *bv);
+/**
+ * @brief Free a BPTree.
+ * @param bp Index to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+bp_free(BPTree *bp);
+
+/**
+ * @brief Excess up to and including a position.
+ *
+ * Positions past the end are clamped to the last bit, like @ref bv_rank.
+ * @param bp Pointer to the BPTree.
+ * @param i Bit index.
+ * @return Opening minus closing parentheses in @c [0...i].
+ * @since 0.4.0
+ */
+int64_t
+bp_excess(const BPTree *bp, size_t i);
+/**
+ * @brief Matching closing parenthesis.
+ * @param bp Pointer to the BPTree.
+ * @param i Position of an opening parenthesis.
+ * @return Its match, or @c SIZE_MAX if @p i is not '(' or is unmatched.
+ * @since 0.4.0
+ */
+size_t
+bp_find_close(const BPTree *bp, size_t i);
+/**
+ * @brief Matching opening parenthesis.
+ * @param bp Pointer to the BPTree.
+ * @param i Position of a closing parenthesis.
+ * @return Its match, or @c SIZE_MAX if @p i is not ')' or is unmatched.
+ * @since 0.4.0
+ */
+size_t
+bp_find_open(const BPTree *bp, size_t i);
+/**
+ * @brief Tightest pair of parentheses strictly enclosing a position.
+ * @param bp Pointer to the BPTree.
+ * @param i Position of an opening parenthesis.
+ * @return Opening position of the enclosing pair, or @c SIZE_MAX if @p i is
+ *         not '(' or lies at the top level.
+ * @since 0.4.0
+ */
+size_t
+bp_enclose(const BPTree *bp, size_t i);
+
+/**
+ * @brief Parent of a node.
+ * @param bp Pointer to the BPTree.
+ * @param v Node (position of its '(').
+ * @return Parent node, or @c SIZE_MAX for a root or an invalid node.
+ * @since 0.4.0
+ */
+size_t
+bp_parent(const BPTree *bp, size_t v);
+/**
+ * @brief First child of a node.
+ * @param bp Pointer to the BPTree.
+ * @param v Node (position of its '(').
+ * @return First child, or @c SIZE_MAX for a leaf or an invalid node.
+ * @since 0.4.0
+ */
+size_t
+bp_first_child(const BPTree *bp, size_t v);
+/**
+ * @brief Next sibling of a node.
+ * @param bp Pointer to the BPTree.
+ * @param v Node (position of its '(').
+ * @return Next sibling, or @c SIZE_MAX for a last child or an invalid node.
+ * @since 0.4.0
+ */
+size_t
+bp_next_sibling(const BPTree *bp, size_t v);
+/**
+ * @brief Number of nodes in the subtree rooted at a node.
+ * @param bp Pointer to the BPTree.
+ * @param v Node (position of its '(').
+ * @return Subtree size including @p v, or @c 0 for an invalid node.
+ * @since 0.4.0
+ */
+size_t
+bp_subtree_size(const BPTree *bp, size_t v);
+/**
+ * @brief Number of heap bytes held by the index.
+ * @param bp Pointer to the BPTree.
+ * @return Footprint in bytes, including the private BitVector copy.
+ * @since 0.4.0
+ */
+size_t
+bp_memory_usage(const BPTree *bp);
+
+#endif /* CBITS_BP_TREE_H */
@@ -0,0 +1,213 @@
+/**
+ * @file include/cbits_stats.h
+ * @brief Process-wide counters for the hot paths of the core library.
+ *
+ * Provides:
+ * - @ref cbits_stat identifiers and their names
+ * - @ref cbits_stat_add to bump a counter from a hot path
+ * - the relaxed atomic helpers it is built on
+ * - @ref cbits_stats_read and @ref cbits_stats_reset
+ * - @ref cbits_account_alloc, @ref cbits_account_free and
+ *   @ref cbits_live_bytes, the byte count of all native allocations
+ *
+ * Counters are updated with relaxed atomic additions, once per bulk
+ * operation rather than per word, so they are cheap enough to stay enabled.
+ * @c CBITS_STAT_BITWISE_BYTES counts the operand bytes of the BitVector
+ * AND/OR/XOR/NOT operators and of the @c bv_and_all family of reductions;
+ * the bitwise kernel calls made inside matrices, filters and indexes are
+ * not counted.
+ * Building with @c CBITS_STATS=0 (CMake option @c CBITS_STATS) turns
+ * @ref cbits_stat_add into a no-op.
+ *
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_STATS_H
+#define CBITS_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#ifndef CBITS_STATS
+    /** @brief Whether the counters are compiled in. */
+    #define CBITS_STATS 1
+#endif
+
+/**
+ * @brief Counter identifiers.
+ * @since 0.4.0
+ */
+typedef enum {
+    CBITS_STAT_RANK_BUILDS,    /**< Calls of @c bv_build_rank. */
+    CBITS_STAT_RANK_WORDS,     /**< Words scanned by those calls. */
+    CBITS_STAT_ALLOCS,         /**< Native allocations, a BitVector once. */
+    CBITS_STAT_ALLOC_BYTES,    /**< Bytes allocated by them. */
+    CBITS_STAT_FREES,          /**< Native allocations released. */
+    CBITS_STAT_FREE_BYTES,     /**< Bytes released by them. */
+    CBITS_STAT_BITWISE_BYTES,  /**< Operand bytes of BitVector operators. */
+    CBITS_STAT_SEARCH_CALLS,   /**< Subvector searches. */
+    CBITS_STAT_SEARCH_WINDOWS, /**< Bit offsets compared by them. */
+    CBITS_STAT_SEARCH_VERIFY,  /**< Offsets needing a multi-word check. */
+    CBITS_STAT_HASH_BYTES,     /**< Bytes hashed, cached hashes excluded. */
+    CBITS_STAT_SLICE_COPIES,   /**< Slices copied into a new BitVector. */
+    CBITS_STAT_SLICE_BITS,     /**< Bits copied by those slices. */
+    CBITS_STAT_COUNT,          /**< Number of counters. */
+} cbits_stat;
+
+/**
+ * @brief Counter storage, indexed by @ref cbits_stat.
+ *
+ * Only accessed through @ref cbits_stat_add and the functions below.
+ * @since 0.4.0
+ */
+extern uint64_t cbits_stats_counters[CBITS_STAT_COUNT];
+
+/**
+ * @brief Add @p n to @p *target with a relaxed atomic addition.
+ *
+ * Adding @c (uint64_t) 0 - n subtracts @p n.
+ *
+ * @param target Value to update.
+ * @param n Amount to add.
+ * @since 0.4.0
+ */
+static inline void
+cbits_atomic_add_u64(uint64_t *target, uint64_t n)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchangeAdd64((volatile __int64 *) target, (__int64) n);
+#else
+    __atomic_fetch_add(target, n, __ATOMIC_RELAXED);
+#endif
+}
+
+/**
+ * @brief Read @p *target with a relaxed atomic load.
+ * @param target Value to read.
+ * @return Current value.
+ * @since 0.4.0
+ */
+static inline uint64_t
+cbits_atomic_load_u64(const uint64_t *target)
+{
+#if defined(_MSC_VER)
+    return (uint64_t) _InterlockedCompareExchange64(
+        (volatile __int64 *) target, 0, 0);
+#else
+    return __atomic_load_n(target, __ATOMIC_RELAXED);
+#endif
+}
+
+/**
+ * @brief Add @p n to a counter.
+ *
+ * @param stat Counter.
+ * @param n Amount to add.
+ * @since 0.4.0
+ */
+static inline void
+cbits_stat_add(cbits_stat stat, uint64_t n)
+{
+#if CBITS_STATS
+    cbits_atomic_add_u64(&cbits_stats_counters[stat], n);
+#else
+    (void) stat;
+    (void) n;
+#endif
+}
+
+/**
+ * @brief Bytes currently allocated by the core library.
+ *
+ * Only accessed through @ref cbits_account_alloc, @ref cbits_account_free
+ * and @ref cbits_live_bytes.
+ * @since 0.4.0
+ */
+extern uint64_t cbits_live_total;
+
+/**
+ * @brief Account a new native allocation of @p bytes.
+ *
+ * Called by every allocator of compat.h. The live byte count is kept
+ * even without @c CBITS_STATS; the @c ALLOCS and @c ALLOC_BYTES counters
+ * follow @ref cbits_stat_add.
+ *
+ * @param bytes Size of the allocation.
+ * @since 0.4.0
+ */
+static inline void
+cbits_account_alloc(size_t bytes)
+{
+    cbits_atomic_add_u64(&cbits_live_total, bytes);
+    cbits_stat_add(CBITS_STAT_ALLOCS, 1);
+    cbits_stat_add(CBITS_STAT_ALLOC_BYTES, bytes);
+}
+
+/**
+ * @brief Account the release of a native allocation of @p bytes.
+ * @param bytes Size passed to @ref cbits_account_alloc for it.
+ * @since 0.4.0
+ */
+static inline void
+cbits_account_free(size_t bytes)
+{
+    cbits_atomic_add_u64(&cbits_live_total, (uint64_t) 0 - bytes);
+    cbits_stat_add(CBITS_STAT_FREES, 1);
+    cbits_stat_add(CBITS_STAT_FREE_BYTES, bytes);
+}
+
+/**
+ * @brief Bytes held by all live allocations of the core library.
+ *
+ * Covers every structure (BitVectors, matrices, collections, compressed
+ * and succinct vectors, filters and indexes) and their temporary buffers,
+ * but not the allocator's own overhead nor buffers handed to the caller
+ * for release with @c free.
+ * @return Sum of the sizes of all live allocations.
+ * @since 0.4.0
+ */
+size_t
+cbits_live_bytes(void);
+
+/**
+ * @brief Name of a counter, e.g. @c "rank_builds".
+ * @param stat Counter.
+ * @return Static string, or NULL if @p stat is out of range.
+ * @since 0.4.0
+ */
+const char *
+cbits_stat_name(cbits_stat stat);
+
+/**
+ * @brief Whether the counters were compiled in.
+ * @retval 1 Built with @c CBITS_STATS.
+ * @retval 0 Counters are always zero.
+ * @since 0.4.0
+ */
+int
+cbits_stats_enabled(void);
+
+/**
+ * @brief Current value of a counter.
+ *
+ * @param stat Counter.
+ * @param reset Non-zero to atomically replace the value with zero.
+ * @return Value before the optional reset, 0 if @p stat is out of range.
+ * @since 0.4.0
+ */
+uint64_t
+cbits_stats_read(cbits_stat stat, int reset);
+
+/**
+ * @brief Set every counter to zero.
+ * @since 0.4.0
+ */
+void
+cbits_stats_reset(void);
+
+#endif /* CBITS_STATS_H */
@@ -3,9 +3,13 @@
  * @brief Cross-platform aligned allocators, popcount, prefetch.
  *
  * Provides wrappers for:
- * - posix_memalign or _aligned_malloc/free
+ * - malloc/free and posix_memalign or _aligned_malloc/free, counted by
+ *   cbits_live_bytes
  * - cache prefetch instructions
  * - optimized 64-bit popcount and block-level popcount
+ * - trailing-zero count and 64x64->128 bit high multiply
+ * - host byte order and byte swapping
+ * - runtime kernel dispatch, its introspection and override
  *
  * @author lambdaphoenix
  * @version 0.3.0
@@ -18,9 +22,12 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+#include "cbits_stats.h"
+
 #if defined(__x86_64__) || defined(_M_X64)
     #if defined(_MSC_VER)
         #include <immintrin.h>
+        #include <intrin.h>
     #else
         #include <x86intrin.h>
     #endif
@@ -35,6 +42,115 @@
     #endif
 #endif
 
+/* Tracked malloc / free */
+
+/**
+ * @brief Header in front of every block from @ref cbits_malloc, recording
+ *        its size while keeping the alignment of @c malloc.
+ */
+typedef union {
+    size_t size;       /**< Requested size of the block in bytes */
+    long double align; /**< Forces the strictest scalar alignment */
+    void *ptr;         /**< Forces pointer alignment */
+} cbits_alloc_header;
+
+/**
+ * @brief Allocate memory counted by @ref cbits_live_bytes.
+ *
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the memory, or NULL if allocation failed. Release it
+ *         with @ref cbits_free, never with @c free.
+ * @since 0.4.0
+ */
+static inline void *
+cbits_malloc(size_t size)
+{
+    if (size > SIZE_MAX - sizeof(cbits_alloc_header)) {
+        return NULL;
+    }
+    cbits_alloc_header *h = malloc(sizeof(cbits_alloc_header) + size);
+    if (!h) {
+        return NULL;
+    }
+    h->size = size;
+    cbits_account_alloc(size);
+    return h + 1;
+}
+
+/**
+ * @brief Allocate zeroed memory counted by @ref cbits_live_bytes.
+ *
+ * @param n Number of elements.
+ * @param size Size of one element in bytes.
+ * @return Pointer to the memory, or NULL if allocation failed or
+ *         @p n * @p size overflows. Release it with @ref cbits_free.
+ * @since 0.4.0
+ */
+static inline void *
+cbits_calloc(size_t n, size_t size)
+{
+    if (size && n > (SIZE_MAX - sizeof(cbits_alloc_header)) / size) {
+        return NULL;
+    }
+    cbits_alloc_header *h = calloc(1, sizeof(cbits_alloc_header) + n * size);
+    if (!h) {
+        return NULL;
+    }
+    h->size = n * size;
+    cbits_account_alloc(n * size);
+    return h + 1;
+}
+
+/**
+ * @brief Resize memory from @ref cbits_malloc, like @c realloc.
+ *
+ * Counted as releasing the old block and allocating the new one.
+ *
+ * @param ptr Block to resize, or NULL to allocate a new one.
+ * @param size New size in bytes.
+ * @return Pointer to the resized memory, or NULL if allocation failed, in
+ *         which case @p ptr is left untouched.
+ * @since 0.4.0
+ */
+static inline void *
+cbits_realloc(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return cbits_malloc(size);
+    }
+    if (size > SIZE_MAX - sizeof(cbits_alloc_header)) {
+        return NULL;
+    }
+    cbits_alloc_header *h = (cbits_alloc_header *) ptr - 1;
+    const size_t old = h->size;
+    h = realloc(h, sizeof(cbits_alloc_header) + size);
+    if (!h) {
+        return NULL;
+    }
+    h->size = size;
+    cbits_account_free(old);
+    cbits_account_alloc(size);
+    return h + 1;
+}
+
+/**
+ * @brief Release memory from @ref cbits_malloc, @ref cbits_calloc or
+ *        @ref cbits_realloc.
+ *
+ * @param ptr Block to release; NULL is ignored.
+ * @since 0.4.0
+ */
+static inline void
+cbits_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    cbits_alloc_header *h = (cbits_alloc_header *) ptr - 1;
+    cbits_account_free(h->size);
+    free(h);
+}
+
 /* Aligned malloc / free */
 #if defined(_MSC_VER)
     #include <malloc.h>
@@ -50,37 +166,50 @@ posix_memalign(void **memptr, size_t alignment, size_t size)
     *memptr = p;
     return 0;
 }
+#endif
 
 /**
- * @brief Free aligned memory.
+ * @brief Allocate aligned memory without accounting it.
  *
- * On MSVC uses _aligned_free, otherwise standard free.
+ * For callers that allocate several blocks of one object and account them
+ * together with a single @ref cbits_account_alloc; everything else uses
+ * @ref cbits_malloc_aligned.
  *
- * @param ptr Pointer returned by cbits_malloc_aligned.
+ * @param size  Number of bytes to allocate.
+ * @param align Desired alignment in bytes (must be power of two).
+ * @return Pointer to aligned memory, or NULL if allocation failed.
+ * @since 0.4.0
  */
-static inline void
-cbits_free_aligned(void *ptr)
+static inline void *
+cbits_aligned_alloc_raw(size_t size, size_t align)
 {
-    _aligned_free(ptr);
+    void *p = NULL;
+    if (posix_memalign(&p, align, size) != 0) {
+        return NULL;
+    }
+    return p;
 }
-#else
 
 /**
- * @brief Free aligned memory.
+ * @brief Free memory from @ref cbits_aligned_alloc_raw without accounting.
  *
  * On MSVC uses _aligned_free, otherwise standard free.
  *
- * @param ptr Pointer returned by cbits_malloc_aligned.
+ * @param ptr Pointer to release; NULL is ignored.
+ * @since 0.4.0
  */
 static inline void
-cbits_free_aligned(void *ptr)
+cbits_aligned_free_raw(void *ptr)
 {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
     free(ptr);
-}
 #endif
+}
 
 /**
- * @brief Allocate aligned memory.
+ * @brief Allocate aligned memory counted by @ref cbits_live_bytes.
  *
  * Uses posix_memalign on POSIX, or _aligned_malloc on MSVC.
  *
@@ -91,13 +220,31 @@ cbits_free_aligned(void *ptr)
 static inline void *
 cbits_malloc_aligned(size_t size, size_t align)
 {
-    void *p = NULL;
-    if (posix_memalign(&p, align, size) != 0) {
-        return NULL;
+    void *p = cbits_aligned_alloc_raw(size, align);
+    if (p) {
+        cbits_account_alloc(size);
     }
     return p;
 }
 
+/**
+ * @brief Free aligned memory.
+ *
+ * Aligned blocks carry no header, so the caller passes back the size it
+ * allocated.
+ *
+ * @param ptr Pointer returned by cbits_malloc_aligned; NULL is ignored.
+ * @param size The @p size passed to cbits_malloc_aligned.
+ */
+static inline void
+cbits_free_aligned(void *ptr, size_t size)
+{
+    if (ptr) {
+        cbits_account_free(size);
+        cbits_aligned_free_raw(ptr);
+    }
+}
+
 /* Prefetch */
 
 /**
@@ -141,6 +288,147 @@ cbits_popcount64(uint64_t x)
 #endif
 }
 
+/**
+ * @def CBITS_POPCNT_CLONES
+ * @brief Build a function twice, with and without the @c popcnt
+ *        instruction, and let the loader pick the clone for this CPU.
+ *
+ * The baseline x86-64 ISA has no @c popcnt, so @ref cbits_popcount64
+ * compiles to a library call there. Hot functions dominated by it carry
+ * this attribute; it expands to nothing where the target already has
+ * @c popcnt or the platform lacks ifunc support (macOS, musl, Windows).
+ * @since 0.4.0
+ */
+#if defined(__x86_64__) && !defined(__POPCNT__) && defined(__GLIBC__) && \
+    defined(__has_attribute)
+    #if __has_attribute(target_clones)
+        #define CBITS_POPCNT_CLONES \
+            __attribute__((target_clones("popcnt", "default")))
+    #endif
+#endif
+#ifndef CBITS_POPCNT_CLONES
+    #define CBITS_POPCNT_CLONES
+#endif
+
+/**
+ * @brief Count trailing zero bits in a 64-bit word.
+ *
+ * @param x Word to inspect; must be non-zero.
+ * @return Index of the least significant set bit.
+ */
+static inline unsigned
+cbits_ctz64(uint64_t x)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (unsigned) idx;
+#elif defined(_MSC_VER)
+    unsigned long idx;
+    if (_BitScanForward(&idx, (unsigned long) x)) {
+        return (unsigned) idx;
+    }
+    _BitScanForward(&idx, (unsigned long) (x >> 32));
+    return (unsigned) idx + 32;
+#else
+    return (unsigned) __builtin_ctzll(x);
+#endif
+}
+
+/* Byte order */
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && \
+                          __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    /** @brief 1 if words are stored least significant byte first. */
+    #define CBITS_LITTLE_ENDIAN 1
+#else
+    #define CBITS_LITTLE_ENDIAN 0
+#endif
+
+/**
+ * @brief Reverse the byte order of a 64-bit word.
+ *
+ * @param x Word to swap.
+ * @return @p x with byte 0 and byte 7, byte 1 and byte 6, ... exchanged.
+ * @since 0.4.0
+ */
+static inline uint64_t
+cbits_bswap64(uint64_t x)
+{
+#if defined(_MSC_VER)
+    return _byteswap_uint64(x);
+#else
+    return __builtin_bswap64(x);
+#endif
+}
+
+/**
+ * @brief High 64 bits of the 128-bit product of two words.
+ *
+ * <tt>cbits_mulhi64(h, n)</tt> maps a uniform 64-bit hash @p h onto
+ * <tt>[0, n)</tt> without a division.
+ *
+ * @param a First factor.
+ * @param b Second factor.
+ * @return <tt>(a * b) >> 64</tt>.
+ * @since 0.4.0
+ */
+static inline uint64_t
+cbits_mulhi64(uint64_t a, uint64_t b)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    return __umulh(a, b);
+#elif defined(__SIZEOF_INT128__)
+    return (uint64_t) (((unsigned __int128) a * b) >> 64);
+#else
+    uint64_t a_lo = (uint32_t) a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t) b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t) hi_lo + lo_hi;
+    return hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/* Dispatch pointers */
+
+/**
+ * @def CBITS_DISPATCH_LOAD(type, var)
+ * @brief Read dispatch pointer @p var of function pointer type @p type
+ *        with a relaxed atomic load.
+ *
+ * Kernels run without the GIL while @ref cbits_set_kernel may rewrite the
+ * pointers, so every access goes through this macro and
+ * @ref CBITS_DISPATCH_STORE.
+ * @since 0.4.0
+ */
+/**
+ * @def CBITS_DISPATCH_STORE(type, var, fn)
+ * @brief Point dispatch pointer @p var at @p fn with a relaxed atomic
+ *        store.
+ * @since 0.4.0
+ */
+#if defined(_MSC_VER)
+    #define CBITS_DISPATCH_LOAD(type, var)                                  \
+        ((type) _InterlockedCompareExchangePointer(                         \
+            (void *volatile *) &(var), NULL, NULL))
+    #define CBITS_DISPATCH_STORE(type, var, fn)                             \
+        ((void) _InterlockedExchangePointer((void *volatile *) &(var),      \
+                                            (void *) (type) (fn)))
+#else
+    #define CBITS_DISPATCH_LOAD(type, var)                                  \
+        ((type) __atomic_load_n(&(var), __ATOMIC_RELAXED))
+    #define CBITS_DISPATCH_STORE(type, var, fn)                             \
+        __atomic_store_n(&(var), (type) (fn), __ATOMIC_RELAXED)
+#endif
+
+/**
+ * @brief Signature of the block popcount kernels.
+ * @param ptr Pointer to at least 8 uint64_t words.
+ * @return Total popcount of the 8 words.
+ * @since 0.4.0
+ */
+typedef uint64_t (*cbits_popcount_block_fn)(const uint64_t *ptr);
+
 /**
  * @brief Dispatch pointer for block popcount.
  *
@@ -148,7 +436,7 @@ cbits_popcount64(uint64_t x)
  * during module initialization by @ref init_cpu_dispatch to point to
  * the best available implementation.
  */
-extern uint64_t (*cbits_popcount_block_ptr)(const uint64_t *ptr);
+extern cbits_popcount_block_fn cbits_popcount_block_ptr;
 
 /**
  * @brief Fallback popcount block implementation.
@@ -166,8 +454,9 @@ cbits_popcount_block_fallback(const uint64_t *ptr);
 /**
  * @brief AVX2 popcount block implementation (256-bit).
  *
- * Loads two 256-bit vectors, stores to temporary array, and sums
- * popcounts of each 64-bit element.
+ * Loads two 256-bit vectors, counts every byte with the nibble lookup
+ * (@c vpshufb) method and sums the lanes without leaving the vector
+ * registers.
  *
  * Only used when targeting AVX2.
  *
@@ -201,14 +490,512 @@ cbits_popcount_block_avx512(const uint64_t *ptr);
 static inline uint64_t
 cbits_popcount_block(const uint64_t *ptr)
 {
-    return cbits_popcount_block_ptr(ptr);
+    return CBITS_DISPATCH_LOAD(cbits_popcount_block_fn,
+                               cbits_popcount_block_ptr)(ptr);
 }
+
+/**
+ * @brief Signature of the batched Hamming distance kernels.
+ *
+ * Writes <tt>popcount(query ^ row)</tt> over @p n_words words for each of
+ * @p n_rows rows that start @p stride words apart.
+ *
+ * @param query Query words.
+ * @param rows First row.
+ * @param stride Distance between two rows, in words.
+ * @param n_words Words per row.
+ * @param n_rows Number of rows.
+ * @param out Output of @p n_rows distances.
+ * @since 0.4.0
+ */
+typedef void (*cbits_hamming_fn)(const uint64_t *query, const uint64_t *rows,
+                                 size_t stride, size_t n_words,
+                                 size_t n_rows, uint32_t *out);
+
+/**
+ * @brief Dispatch pointer for batched Hamming distances.
+ *
+ * Initially @ref cbits_hamming_batch_fallback; replaced at start-up like
+ * @ref cbits_popcount_block_ptr.
+ * @since 0.4.0
+ */
+extern cbits_hamming_fn cbits_hamming_batch_ptr;
+
+/**
+ * @brief Portable Hamming kernel, one @ref cbits_popcount64 per word.
+ * @since 0.4.0
+ */
+void
+cbits_hamming_batch_fallback(const uint64_t *query, const uint64_t *rows,
+                             size_t stride, size_t n_words, size_t n_rows,
+                             uint32_t *out);
+
+#if defined(__x86_64__) || defined(_M_X64)
+/**
+ * @brief AVX2 Hamming kernel.
+ *
+ * Rows of at least 64 words go through a Harley-Seal carry-save adder tree
+ * over 16 vectors of 256 bits, counting only one vector per 16 with the
+ * nibble lookup (@c vpshufb) popcount. Shorter rows use the scalar
+ * @c popcnt instruction, which is faster below that size.
+ * @since 0.4.0
+ */
+void
+cbits_hamming_batch_avx2(const uint64_t *query, const uint64_t *rows,
+                         size_t stride, size_t n_words, size_t n_rows,
+                         uint32_t *out);
+/**
+ * @brief AVX-512VPOPCNTDQ Hamming kernel, eight words per instruction with
+ *        a masked load for the last partial vector.
+ * @since 0.4.0
+ */
+void
+cbits_hamming_batch_avx512(const uint64_t *query, const uint64_t *rows,
+                           size_t stride, size_t n_words, size_t n_rows,
+                           uint32_t *out);
+#endif
+
+/**
+ * @brief Inline wrapper that calls the current Hamming kernel.
+ * @see cbits_hamming_fn
+ * @since 0.4.0
+ */
+static inline void
+cbits_hamming_batch(const uint64_t *query, const uint64_t *rows,
+                    size_t stride, size_t n_words, size_t n_rows,
+                    uint32_t *out)
+{
+    CBITS_DISPATCH_LOAD(cbits_hamming_fn, cbits_hamming_batch_ptr)(
+        query, rows, stride, n_words, n_rows, out);
+}
+
+/**
+ * @brief Signature of the bulk popcount kernels.
+ *
+ * @param ptr Word array (no alignment required).
+ * @param n_words Number of words.
+ * @return Number of set bits in the @p n_words words.
+ * @since 0.4.0
+ */
+typedef uint64_t (*cbits_popcount_words_fn)(const uint64_t *ptr,
+                                            size_t n_words);
+
+/**
+ * @brief Dispatch pointer for bulk popcount.
+ *
+ * Initially @ref cbits_popcount_words_fallback; replaced at start-up like
+ * @ref cbits_popcount_block_ptr.
+ * @since 0.4.0
+ */
+extern cbits_popcount_words_fn cbits_popcount_words_ptr;
+
+/**
+ * @brief Portable bulk popcount with four independent accumulators.
+ * @since 0.4.0
+ */
+uint64_t
+cbits_popcount_words_fallback(const uint64_t *ptr, size_t n_words);
+
+#if defined(__x86_64__) || defined(_M_X64)
+/**
+ * @brief AVX2 bulk popcount.
+ *
+ * Every 64 words go through the same Harley-Seal carry-save adder tree as
+ * @ref cbits_hamming_batch_avx2; the remaining words use the scalar
+ * @c popcnt instruction.
+ * @since 0.4.0
+ */
+uint64_t
+cbits_popcount_words_avx2(const uint64_t *ptr, size_t n_words);
+/**
+ * @brief AVX-512VPOPCNTDQ bulk popcount with two vector accumulators and a
+ *        masked load for the last partial vector.
+ * @since 0.4.0
+ */
+uint64_t
+cbits_popcount_words_avx512(const uint64_t *ptr, size_t n_words);
+#endif
+
+/**
+ * @brief Inline wrapper that calls the current bulk popcount kernel.
+ * @see cbits_popcount_words_fn
+ * @since 0.4.0
+ */
+static inline uint64_t
+cbits_popcount_words(const uint64_t *ptr, size_t n_words)
+{
+    return CBITS_DISPATCH_LOAD(cbits_popcount_words_fn,
+                               cbits_popcount_words_ptr)(ptr, n_words);
+}
+
+/**
+ * @brief Word-wise operators of the bitwise kernels.
+ * @since 0.4.0
+ */
+typedef enum {
+    CBITS_BITWISE_AND, /**< <tt>dst = a & b</tt> */
+    CBITS_BITWISE_OR,  /**< <tt>dst = a | b</tt> */
+    CBITS_BITWISE_XOR, /**< <tt>dst = a ^ b</tt> */
+    CBITS_BITWISE_NOT, /**< <tt>dst = ~a</tt>; @c b is ignored. */
+} cbits_bitwise_op;
+
+/**
+ * @brief Signature of the bitwise kernels.
+ *
+ * Combines @p n_words words of @p a and @p b into @p dst. @p dst may be
+ * @p a or @p b for in-place updates but must not otherwise overlap the
+ * inputs.
+ * Tail bits are not masked.
+ *
+ * @param dst Output words.
+ * @param a First operand.
+ * @param b Second operand; may be NULL for @c CBITS_BITWISE_NOT.
+ * @param n_words Number of words.
+ * @param op Operator.
+ * @since 0.4.0
+ */
+typedef void (*cbits_bitwise_fn)(uint64_t *dst, const uint64_t *a,
+                                 const uint64_t *b, size_t n_words,
+                                 cbits_bitwise_op op);
+
+/**
+ * @brief Dispatch pointer for the bitwise kernels.
+ *
+ * Initially @ref cbits_bitwise_words_fallback; replaced at start-up like
+ * @ref cbits_popcount_block_ptr.
+ * @since 0.4.0
+ */
+extern cbits_bitwise_fn cbits_bitwise_words_ptr;
+
+/**
+ * @brief Portable bitwise kernel, vectorised for the baseline ISA.
+ * @since 0.4.0
+ */
+void
+cbits_bitwise_words_fallback(uint64_t *dst, const uint64_t *a,
+                             const uint64_t *b, size_t n_words,
+                             cbits_bitwise_op op);
+
+#if defined(__x86_64__) || defined(_M_X64)
+/**
+ * @brief AVX2 bitwise kernel, four words per instruction.
+ * @since 0.4.0
+ */
+void
+cbits_bitwise_words_avx2(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                         size_t n_words, cbits_bitwise_op op);
+/**
+ * @brief AVX-512F bitwise kernel, eight words per instruction with a
+ *        masked load and store for the last partial vector.
+ * @since 0.4.0
+ */
+void
+cbits_bitwise_words_avx512(uint64_t *dst, const uint64_t *a,
+                           const uint64_t *b, size_t n_words,
+                           cbits_bitwise_op op);
+#endif
+
+/**
+ * @brief Inline wrapper that calls the current bitwise kernel.
+ *
+ * Not counted in @c CBITS_STAT_BITWISE_BYTES: structures call it per row,
+ * chunk or slice, so the counter is bumped by the BitVector operators and
+ * reductions that own the whole operation instead.
+ * @see cbits_bitwise_fn
+ * @since 0.4.0
+ */
+static inline void
+cbits_bitwise_words(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                    size_t n_words, cbits_bitwise_op op)
+{
+    CBITS_DISPATCH_LOAD(cbits_bitwise_fn, cbits_bitwise_words_ptr)(
+        dst, a, b, n_words, op);
+}
+
+/**
+ * @brief Signature of the bool packing kernels.
+ *
+ * Sets bit @c i of @p dst if byte @c i of @p src is non-zero, writing
+ * <tt>(n + 63) / 64</tt> words whose bits beyond @p n are zero.
+ *
+ * @param dst Output words.
+ * @param src One byte per bit, e.g. a NumPy @c bool array.
+ * @param n Number of bytes.
+ * @since 0.4.0
+ */
+typedef void (*cbits_pack_bools_fn)(uint64_t *dst, const uint8_t *src,
+                                    size_t n);
+/**
+ * @brief Signature of the bool unpacking kernels.
+ *
+ * Writes byte @c i of @p dst as bit @c i of @p src, 0 or 1.
+ *
+ * @param dst Output bytes.
+ * @param src Input words.
+ * @param n Number of bytes to write.
+ * @since 0.4.0
+ */
+typedef void (*cbits_unpack_bools_fn)(uint8_t *dst, const uint64_t *src,
+                                      size_t n);
+
+/**
+ * @brief Dispatch pointer for the bool packing kernels.
+ * @since 0.4.0
+ */
+extern cbits_pack_bools_fn cbits_pack_bools_ptr;
+/**
+ * @brief Dispatch pointer for the bool unpacking kernels.
+ * @since 0.4.0
+ */
+extern cbits_unpack_bools_fn cbits_unpack_bools_ptr;
+
+/**
+ * @brief Portable packing kernel, eight bytes per multiplication.
+ * @since 0.4.0
+ */
+void
+cbits_pack_bools_fallback(uint64_t *dst, const uint8_t *src, size_t n);
+/**
+ * @brief Portable unpacking kernel, eight bytes per multiplication.
+ * @since 0.4.0
+ */
+void
+cbits_unpack_bools_fallback(uint8_t *dst, const uint64_t *src, size_t n);
+
+#if defined(__x86_64__) || defined(_M_X64)
+/**
+ * @brief AVX2 packing kernel; @c vpmovmskb packs 32 bytes at a time.
+ * @since 0.4.0
+ */
+void
+cbits_pack_bools_avx2(uint64_t *dst, const uint8_t *src, size_t n);
+/**
+ * @brief AVX2 unpacking kernel; @c vpshufb spreads 32 bits over 32 bytes.
+ * @since 0.4.0
+ */
+void
+cbits_unpack_bools_avx2(uint8_t *dst, const uint64_t *src, size_t n);
+/**
+ * @brief AVX-512BW packing kernel; @c vptestmb packs 64 bytes into a mask.
+ * @since 0.4.0
+ */
+void
+cbits_pack_bools_avx512(uint64_t *dst, const uint8_t *src, size_t n);
+/**
+ * @brief AVX-512BW unpacking kernel; a masked move expands a word into 64
+ *        bytes.
+ * @since 0.4.0
+ */
+void
+cbits_unpack_bools_avx512(uint8_t *dst, const uint64_t *src, size_t n);
+#endif
+
+/**
+ * @brief Inline wrapper that calls the current packing kernel.
+ * @see cbits_pack_bools_fn
+ * @since 0.4.0
+ */
+static inline void
+cbits_pack_bools(uint64_t *dst, const uint8_t *src, size_t n)
+{
+    CBITS_DISPATCH_LOAD(cbits_pack_bools_fn, cbits_pack_bools_ptr)(
+        dst, src, n);
+}
+/**
+ * @brief Inline wrapper that calls the current unpacking kernel.
+ * @see cbits_unpack_bools_fn
+ * @since 0.4.0
+ */
+static inline void
+cbits_unpack_bools(uint8_t *dst, const uint64_t *src, size_t n)
+{
+    CBITS_DISPATCH_LOAD(cbits_unpack_bools_fn, cbits_unpack_bools_ptr)(
+        dst, src, n);
+}
+
+/* Dispatch introspection */
+
+/**
+ * @defgroup cbits_cpu CPU feature bits
+ * @brief Bits of @ref cbits_cpu_features.
+ * @since 0.4.0
+ * @{
+ */
+#define CBITS_CPU_POPCNT (1u << 0)          /**< @c popcnt instruction. */
+#define CBITS_CPU_AVX2 (1u << 1)            /**< AVX2 with OS support. */
+#define CBITS_CPU_AVX512F (1u << 2)         /**< AVX-512 Foundation. */
+#define CBITS_CPU_AVX512VPOPCNTDQ (1u << 3) /**< AVX-512 VPOPCNTDQ. */
+#define CBITS_CPU_AVX512BW (1u << 4)        /**< AVX-512 Byte and Word. */
+/** @} */
+
+/**
+ * @brief Operations whose implementation is chosen at run time.
+ * @since 0.4.0
+ */
+typedef enum {
+    CBITS_OP_POPCOUNT_BLOCK, /**< @ref cbits_popcount_block_ptr */
+    CBITS_OP_POPCOUNT_WORDS, /**< @ref cbits_popcount_words_ptr */
+    CBITS_OP_HAMMING_BATCH,  /**< @ref cbits_hamming_batch_ptr */
+    CBITS_OP_BITWISE_WORDS,  /**< @ref cbits_bitwise_words_ptr */
+    CBITS_OP_PACK_BOOLS,     /**< @ref cbits_pack_bools_ptr */
+    CBITS_OP_UNPACK_BOOLS,   /**< @ref cbits_unpack_bools_ptr */
+    CBITS_OP_COUNT,          /**< Number of dispatched operations. */
+} cbits_dispatch_op;
+
+/**
+ * @brief Kernel families every dispatched operation is implemented in.
+ *
+ * @c CBITS_KERNEL_AUTO is not a kernel of its own: passed to
+ * @ref cbits_set_kernel it selects the best kernel the CPU supports.
+ * @since 0.4.0
+ */
+typedef enum {
+    CBITS_KERNEL_FALLBACK, /**< Portable C. */
+    CBITS_KERNEL_AVX2,     /**< AVX2 (x86-64 only). */
+    CBITS_KERNEL_AVX512,   /**< AVX-512 (x86-64 only), per operation. */
+    CBITS_KERNEL_COUNT,    /**< Number of kernel families. */
+    CBITS_KERNEL_AUTO = CBITS_KERNEL_COUNT,
+} cbits_kernel;
+
+/**
+ * @brief Instruction set extensions detected on this CPU.
+ *
+ * Detected once at start-up; AVX2 and AVX-512 are only reported when the
+ * operating system also saves their register state.
+ * @return Bitwise OR of the @ref cbits_cpu bits.
+ * @since 0.4.0
+ */
+unsigned
+cbits_cpu_features(void);
+
+/**
+ * @brief Name of a dispatched operation, e.g. @c "popcount_words".
+ * @param op Operation.
+ * @return Static string, or NULL if @p op is out of range.
+ * @since 0.4.0
+ */
+const char *
+cbits_dispatch_op_name(cbits_dispatch_op op);
+
+/**
+ * @brief Name of a kernel family, e.g. @c "avx2", or @c "auto".
+ * @param kernel Kernel family.
+ * @return Static string, or NULL if @p kernel is out of range.
+ * @since 0.4.0
+ */
+const char *
+cbits_kernel_name(cbits_kernel kernel);
+
+/**
+ * @brief Look up a dispatched operation by name.
+ * @param name Name as returned by @ref cbits_dispatch_op_name.
+ * @retval cbits_dispatch_op The operation.
+ * @retval CBITS_OP_COUNT If the name is unknown.
+ * @since 0.4.0
+ */
+cbits_dispatch_op
+cbits_dispatch_op_from_name(const char *name);
+
+/**
+ * @brief Look up a kernel family by name, accepting @c "auto".
+ * @param name Name as returned by @ref cbits_kernel_name.
+ * @retval cbits_kernel The kernel family or @c CBITS_KERNEL_AUTO.
+ * @retval -1 If the name is unknown.
+ * @since 0.4.0
+ */
+int
+cbits_kernel_from_name(const char *name);
+
+/**
+ * @brief Whether this build and CPU can run a kernel family for every
+ *        dispatched operation.
+ * @param kernel Kernel family; @c CBITS_KERNEL_AUTO is always supported.
+ * @retval 1 The kernel can be selected for all operations.
+ * @retval 0 Otherwise.
+ * @since 0.4.0
+ */
+int
+cbits_kernel_supported(cbits_kernel kernel);
+
+/**
+ * @brief Whether this build and CPU can run a kernel family for one
+ *        operation.
+ *
+ * The AVX-512 popcount and Hamming kernels need AVX-512F and VPOPCNTDQ,
+ * the bitwise kernel AVX-512F alone and the bool conversions AVX-512F and
+ * BW, so on CPUs with only some of these extensions the family is
+ * available for some operations.
+ * @param op Operation, or @c CBITS_OP_COUNT for all of them.
+ * @param kernel Kernel family; @c CBITS_KERNEL_AUTO is always supported.
+ * @retval 1 The kernel can be selected for @p op.
+ * @retval 0 Otherwise, or if @p op or @p kernel is out of range.
+ * @since 0.4.0
+ */
+int
+cbits_op_kernel_supported(cbits_dispatch_op op, cbits_kernel kernel);
+
+/**
+ * @brief Kernel family an operation currently dispatches to.
+ * @param op Operation.
+ * @return Kernel family, never @c CBITS_KERNEL_AUTO.
+ * @since 0.4.0
+ */
+cbits_kernel
+cbits_active_kernel(cbits_dispatch_op op);
+
+/**
+ * @brief Point one or all dispatched operations at a kernel family.
+ *
+ * Every kernel computes the same results, so switching never invalidates
+ * rank tables or other cached data. The dispatch pointers are read and
+ * written with relaxed atomics, so switching while other threads run
+ * cbits operations is safe: each call uses either the old or the new
+ * kernel.
+ *
+ * @param op Operation, or @c CBITS_OP_COUNT for all of them.
+ * @param kernel Kernel family, or @c CBITS_KERNEL_AUTO for the best one of
+ *        each operation.
+ * @retval 0 On success.
+ * @retval -1 If @p op or @p kernel is out of range or not supported for
+ *         every operation selected (see @ref cbits_op_kernel_supported);
+ *         nothing is changed.
+ * @since 0.4.0
+ */
+int
+cbits_set_kernel(cbits_dispatch_op op, cbits_kernel kernel);
+
+/**
+ * @brief Apply a @c CBITS_FORCE_KERNEL specification.
+ *
+ * The specification is either a single kernel name applied to every
+ * operation, or a comma separated list of @c op=kernel pairs such as
+ * @c "popcount_words=avx2,hamming_batch=fallback". Operations it does not
+ * name keep their kernel.
+ *
+ * @param spec Specification string.
+ * @retval 0 On success.
+ * @retval -1 If any entry is malformed, unknown or unsupported; nothing is
+ *         changed.
+ * @since 0.4.0
+ */
+int
+cbits_force_kernel(const char *spec);
+
+/**
+ * @brief Outcome of applying @c CBITS_FORCE_KERNEL at start-up.
+ * @retval 0 The variable was unset or applied.
+ * @retval -1 The variable was set but rejected by @ref cbits_force_kernel.
+ * @since 0.4.0
+ */
+int
+cbits_force_kernel_env_status(void);
+
 /**
- * @brief Constructor to initialize popcount dispatch pointer.
+ * @brief Constructor to initialize the dispatch pointers.
  *
- * At program start, this function checks CPU support for AVX-512VPOPCNTDQ
- * and AVX2 via __builtin_cpu_supports, then updates
- * cbits_popcount_block_ptr accordingly.
+ * At program start, this function detects the CPU features, points every
+ * dispatch pointer at the best supported kernel and then applies the
+ * @c CBITS_FORCE_KERNEL environment variable, if set.
  */
 void
 init_cpu_dispatch(void);
@@ -0,0 +1,60 @@
+/**
+ * @file include/compat_thread.h
+ * @brief Minimal cross-platform fork/join helper.
+ *
+ * Provides:
+ * - @ref cbits_cpu_count to query the number of online processors
+ * - @ref cbits_parallel_for to run independent tasks on a few threads
+ *
+ * Uses POSIX threads, or Win32 threads when built with MSVC. Tasks are
+ * distributed round-robin and the call returns once every task has run, so
+ * callers never see a thread handle.
+ *
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_COMPAT_THREAD_H
+#define CBITS_COMPAT_THREAD_H
+
+#include <stddef.h>
+
+/**
+ * @def CBITS_MAX_THREADS
+ * @brief Upper bound on the number of threads used by one parallel call.
+ */
+#define CBITS_MAX_THREADS 64
+
+/**
+ * @brief Task callback for @ref cbits_parallel_for.
+ * @param ctx Caller context, shared by every task.
+ * @param index Task index in @c [0, n_tasks).
+ */
+typedef void (*cbits_task_fn)(void *ctx, size_t index);
+
+/**
+ * @brief Number of online processors.
+ * @return Processor count, at least @c 1.
+ * @since 0.4.0
+ */
+unsigned
+cbits_cpu_count(void);
+
+/**
+ * @brief Run @p n_tasks independent tasks on up to @p n_threads threads.
+ *
+ * The calling thread takes part in the work. If a worker cannot be started,
+ * its share runs on the calling thread instead, so every task always runs
+ * exactly once.
+ *
+ * @param n_tasks Number of tasks.
+ * @param fn Task callback.
+ * @param ctx Context passed to every call of @p fn.
+ * @param n_threads Thread count; @c 0 selects @ref cbits_cpu_count.
+ * @since 0.4.0
+ */
+void
+cbits_parallel_for(size_t n_tasks, cbits_task_fn fn, void *ctx,
+                   unsigned n_threads);
+
+#endif /* CBITS_COMPAT_THREAD_H */
@@ -0,0 +1,288 @@
+/**
+ * @file compressed_bitvector.h
+ * @brief Public C API for the CompressedBitVector (Roaring-style) container.
+ *
+ * A CompressedBitVector covers the same index space as a BitVector of equal
+ * length, but partitions it into chunks of 2^16 bits. Each non-empty chunk is
+ * stored in whichever container is smallest for its contents:
+ * - a sorted array of 16-bit offsets (sparse chunks)
+ * - a 65536-bit bitmap (dense chunks)
+ * - a sorted list of runs (long stretches of set bits)
+ *
+ * Empty chunks take no memory at all. Bitmap containers reuse the block
+ * popcount dispatch from @ref compat.h, so dense chunks count as fast as a
+ * plain BitVector.
+ *
+ * Declares:
+ * - construction and destruction (@ref cbv_new, @ref cbv_copy, @ref cbv_free)
+ * - single-bit operations (@ref cbv_get, @ref cbv_set, @ref cbv_clear, @ref
+ * cbv_flip)
+ * - counting, rank and select (@ref cbv_count, @ref cbv_rank, @ref cbv_select)
+ * - bitwise operations (@ref cbv_and, @ref cbv_or, @ref cbv_xor, @ref
+ * cbv_andnot)
+ * - conversion (@ref cbv_from_bitvector, @ref cbv_to_bitvector)
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_COMPRESSED_BITVECTOR_H
+#define CBITS_COMPRESSED_BITVECTOR_H
+
+#include "bitvector.h"
+
+/**
+ * @def CBV_CHUNK_SHIFT
+ * @brief Log2 of the number of bits covered by one container.
+ */
+#define CBV_CHUNK_SHIFT 16
+/**
+ * @def CBV_CHUNK_BITS
+ * @brief Number of bits covered by one container.
+ */
+#define CBV_CHUNK_BITS (UINT64_C(1) << CBV_CHUNK_SHIFT)
+/**
+ * @def CBV_BITMAP_WORDS
+ * @brief Number of 64-bit words in a bitmap container.
+ */
+#define CBV_BITMAP_WORDS (CBV_CHUNK_BITS >> 6)
+/**
+ * @def CBV_ARRAY_MAX
+ * @brief Largest cardinality stored as an array container.
+ *
+ * At 4096 entries an array occupies exactly as many bytes as a bitmap.
+ */
+#define CBV_ARRAY_MAX 4096
+
+/**
+ * @brief Storage kind of a single container.
+ */
+typedef enum {
+    CBV_CONTAINER_ARRAY = 0,  /**< Sorted array of 16-bit offsets. */
+    CBV_CONTAINER_BITMAP = 1, /**< 1024 words, one bit per offset. */
+    CBV_CONTAINER_RUN = 2,    /**< Sorted (start, length - 1) pairs. */
+} CBVContainerType;
+
+/**
+ * @brief One 2^16-bit chunk of a CompressedBitVector.
+ */
+typedef struct {
+    size_t key;           /**< Chunk index (bit position >> 16). */
+    uint32_t cardinality; /**< Number of set bits in the chunk. */
+    uint32_t size;        /**< Array entries or runs in use. */
+    uint32_t capacity;    /**< Array entries or runs allocated. */
+    uint8_t type;         /**< One of ::CBVContainerType. */
+    void *data;           /**< uint16_t[] for array/run, uint64_t[] bitmap. */
+} CBVContainer;
+
+/**
+ * @brief Chunked, compressed bit array with rank/select support.
+ *
+ * Containers are kept sorted by key. A prefix table of container
+ * cardinalities is built lazily for rank and select queries, following the
+ * same dirty-flag protocol as BitVector's rank tables.
+ */
+typedef struct {
+    size_t n_bits;            /**< Total number of bits. */
+    size_t n_containers;      /**< Number of non-empty containers. */
+    size_t capacity;          /**< Allocated slots in @c containers. */
+    CBVContainer *containers; /**< Containers sorted by key. */
+    size_t *card_prefix;      /**< Prefix cardinalities, one per slot + 1. */
+    bool rank_dirty;          /**< Indicates @c card_prefix is stale. */
+} CompressedBitVector;
+
+/**
+ * @brief Allocate a new, empty CompressedBitVector.
+ * @param n_bits Logical number of bits.
+ * @retval CompressedBitVector* Newly allocated vector.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_new(size_t n_bits);
+/**
+ * @brief Make a deep copy of a CompressedBitVector.
+ * @param src Source vector.
+ * @retval CompressedBitVector* Newly allocated copy.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_copy(const CompressedBitVector *src);
+/**
+ * @brief Free a CompressedBitVector and all of its containers.
+ * @param cbv Vector to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+cbv_free(CompressedBitVector *cbv);
+
+/**
+ * @brief Get the bit value at a given position.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @param pos Bit index.
+ * @return @c 0 or @c 1, or @c -1 if @p pos is out of range.
+ * @since 0.4.0
+ */
+int
+cbv_get(const CompressedBitVector *cbv, size_t pos);
+/**
+ * @brief Set the bit at a given position.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @param pos Bit index.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure or @p pos out of range.
+ * @since 0.4.0
+ */
+int
+cbv_set(CompressedBitVector *cbv, size_t pos);
+/**
+ * @brief Clear the bit at a given position.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @param pos Bit index.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure or @p pos out of range.
+ * @since 0.4.0
+ */
+int
+cbv_clear(CompressedBitVector *cbv, size_t pos);
+/**
+ * @brief Toggle the bit at a given position.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @param pos Bit index.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure or @p pos out of range.
+ * @since 0.4.0
+ */
+int
+cbv_flip(CompressedBitVector *cbv, size_t pos);
+
+/**
+ * @brief Count all set bits.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @return Total number of set bits.
+ * @since 0.4.0
+ */
+size_t
+cbv_count(const CompressedBitVector *cbv);
+/**
+ * @brief Count set bits up to and including a position.
+ *
+ * Matches @ref bv_rank: positions past the end are clamped to the last bit.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @param pos Bit index.
+ * @return Number of bits set in range @c [0...pos]
+ * @since 0.4.0
+ */
+size_t
+cbv_rank(CompressedBitVector *cbv, size_t pos);
+/**
+ * @brief Find the position of the k-th set bit.
+ *
+ * Inverse of @ref cbv_rank: <tt>cbv_rank(cbv, cbv_select(cbv, k)) == k +
+ * 1</tt>.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @param k Zero-based index of the set bit.
+ * @return Bit position, or @c SIZE_MAX if fewer than @p k + 1 bits are set.
+ * @since 0.4.0
+ */
+size_t
+cbv_select(CompressedBitVector *cbv, size_t k);
+
+/**
+ * @brief Test equality of two CompressedBitVectors.
+ *
+ * Compares logical contents, independent of container representation.
+ * @param a First vector.
+ * @param b Second vector.
+ * @return @c true if lengths and all set bits are identical.
+ * @since 0.4.0
+ */
+bool
+cbv_equal(const CompressedBitVector *a, const CompressedBitVector *b);
+
+/**
+ * @brief Bitwise AND of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval CompressedBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_and(const CompressedBitVector *a, const CompressedBitVector *b);
+/**
+ * @brief Bitwise OR of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval CompressedBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_or(const CompressedBitVector *a, const CompressedBitVector *b);
+/**
+ * @brief Bitwise XOR of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval CompressedBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_xor(const CompressedBitVector *a, const CompressedBitVector *b);
+/**
+ * @brief Bitwise AND-NOT (<tt>a & ~b</tt>) of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval CompressedBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_andnot(const CompressedBitVector *a, const CompressedBitVector *b);
+
+/**
+ * @brief Convert every container to its smallest representation.
+ *
+ * Mutations never create run containers on their own; call this after bulk
+ * updates to collapse long stretches of set bits into runs.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure (vector left unchanged but valid).
+ * @since 0.4.0
+ */
+int
+cbv_optimize(CompressedBitVector *cbv);
+/**
+ * @brief Number of heap bytes held by the vector and its containers.
+ * @param cbv Pointer to the CompressedBitVector.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+cbv_memory_usage(const CompressedBitVector *cbv);
+
+/**
+ * @brief Build a CompressedBitVector from a BitVector.
+ *
+ * Every chunk is stored in its smallest representation.
+ * @param bv Source BitVector.
+ * @retval CompressedBitVector* Newly allocated vector.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+CompressedBitVector *
+cbv_from_bitvector(const BitVector *bv);
+/**
+ * @brief Expand a CompressedBitVector into a flat BitVector.
+ * @param cbv Source vector.
+ * @retval BitVector* Newly allocated BitVector of the same length.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+cbv_to_bitvector(const CompressedBitVector *cbv);
+
+#endif /* CBITS_COMPRESSED_BITVECTOR_H */
@@ -0,0 +1,131 @@
+/**
+ * @file elias_fano.h
+ * @brief Public C API for Elias–Fano encoded monotone sequences.
+ *
+ * An EliasFano structure stores a non-decreasing sequence of @c n 64-bit
+ * integers in roughly <tt>n * (2 + log2(u / n))</tt> bits, where @c u is the
+ * largest value. Every value is split into:
+ * - @c low_bits low bits, packed verbatim into a word array
+ * - the remaining high bits, stored in unary in a BitVector: element @c i
+ *   sets bit <tt>(v_i >> low_bits) + i</tt>, and every high bucket is closed
+ *   by a clear bit.
+ *
+ * The high part carries its own sampled select directory (one sample every
+ * @ref EF_SELECT_SAMPLE set and clear bits), so random access is a sample
+ * lookup followed by a short word scan.
+ *
+ * Declares:
+ * - construction and destruction (@ref ef_from_sorted, @ref ef_free)
+ * - queries (@ref ef_access, @ref ef_next_geq)
+ * - forward iteration (@ref ef_iter_init, @ref ef_iter_next)
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_ELIAS_FANO_H
+#define CBITS_ELIAS_FANO_H
+
+#include "bitvector.h"
+
+/**
+ * @def EF_SELECT_SAMPLE_SHIFT
+ * @brief Log2 of the select sampling rate of the high part.
+ */
+#define EF_SELECT_SAMPLE_SHIFT 8
+/**
+ * @def EF_SELECT_SAMPLE
+ * @brief Number of set (or clear) bits between two select samples.
+ */
+#define EF_SELECT_SAMPLE (1u << EF_SELECT_SAMPLE_SHIFT)
+
+/**
+ * @brief Elias–Fano encoded non-decreasing integer sequence.
+ */
+typedef struct {
+    size_t n;                /**< Number of stored values. */
+    uint64_t max_value;      /**< Largest stored value (0 if empty). */
+    unsigned low_bits;       /**< Bits per element in @c low. */
+    uint64_t *low;           /**< Packed low parts, plus one padding word. */
+    BitVector *high;         /**< Unary-coded high parts. */
+    size_t *select1_samples; /**< Position of every sampled set bit. */
+    size_t *select0_samples; /**< Position of every sampled clear bit. */
+} EliasFano;
+
+/**
+ * @brief Forward iterator over the values of an EliasFano sequence.
+ */
+typedef struct {
+    const EliasFano *ef; /**< Sequence being iterated. */
+    size_t index;        /**< Index of the next value. */
+    size_t word_index;   /**< Word of @c high holding the next set bit. */
+    uint64_t word;       /**< Unconsumed set bits of that word. */
+} EFIterator;
+
+/**
+ * @brief Encode a sorted buffer of integers.
+ * @param values Non-decreasing values (may be NULL if @p n is 0).
+ * @param n Number of values.
+ * @retval EliasFano* Newly allocated sequence.
+ * @retval NULL Values not sorted, or allocation failure.
+ * @since 0.4.0
+ */
+EliasFano *
+ef_from_sorted(const uint64_t *values, size_t n);
+/**
+ * @brief Free an EliasFano sequence.
+ * @param ef Sequence to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+ef_free(EliasFano *ef);
+
+/**
+ * @brief Return the value at a given index.
+ * @param ef Pointer to the EliasFano sequence.
+ * @param i Zero-based index.
+ * @return The @p i-th value, or @c UINT64_MAX if @p i is out of range.
+ * @since 0.4.0
+ */
+uint64_t
+ef_access(const EliasFano *ef, size_t i);
+/**
+ * @brief Find the first value that is greater than or equal to @p x.
+ * @param ef Pointer to the EliasFano sequence.
+ * @param x Lower bound.
+ * @param value Receives the value found (may be NULL).
+ * @return Index of that value, or @c ef->n if every value is below @p x.
+ * @since 0.4.0
+ */
+size_t
+ef_next_geq(const EliasFano *ef, uint64_t x, uint64_t *value);
+/**
+ * @brief Number of heap bytes held by the sequence.
+ * @param ef Pointer to the EliasFano sequence.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+ef_memory_usage(const EliasFano *ef);
+
+/**
+ * @brief Position an iterator at a given index.
+ * @param ef Sequence to iterate.
+ * @param it Iterator to initialize.
+ * @param start Index of the first value to return.
+ * @since 0.4.0
+ */
+void
+ef_iter_init(const EliasFano *ef, EFIterator *it, size_t start);
+/**
+ * @brief Fetch the next value of an iteration.
+ * @param it Iterator.
+ * @param value Receives the next value.
+ * @return @c true if a value was produced, @c false at the end.
+ * @since 0.4.0
+ */
+bool
+ef_iter_next(EFIterator *it, uint64_t *value);
+
+#endif /* CBITS_ELIAS_FANO_H */
@@ -0,0 +1,193 @@
+/**
+ * @file ewah_bitvector.h
+ * @brief Public C API for the EWAH run-length compressed bit array.
+ *
+ * An EWAHBitVector stores the words of a BitVector using the Enhanced
+ * Word-Aligned Hybrid encoding. The compressed stream is a sequence of
+ * marker words, each followed by a number of verbatim ("literal") words:
+ * - bit 0 of a marker is the value of a run of clean words,
+ * - bits 1..32 hold the run length in words,
+ * - bits 33..63 hold the number of literal words following the marker.
+ *
+ * Words that are all zeros or all ones are always folded into runs, so every
+ * bit pattern has exactly one encoding. Bitwise operations and popcount walk
+ * the compressed streams directly and never inflate them into a BitVector.
+ *
+ * Declares:
+ * - encoding and decoding (@ref bv_compress_ewah, @ref ewah_decompress)
+ * - construction and destruction (@ref ewah_new, @ref ewah_copy, @ref
+ * ewah_free)
+ * - queries (@ref ewah_get, @ref ewah_count, @ref ewah_equal)
+ * - bitwise operations (@ref ewah_and, @ref ewah_or, @ref ewah_xor, @ref
+ * ewah_andnot)
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_EWAH_BITVECTOR_H
+#define CBITS_EWAH_BITVECTOR_H
+
+#include "bitvector.h"
+
+/**
+ * @def EWAH_RUN_LEN_BITS
+ * @brief Width of the run-length field of a marker word.
+ */
+#define EWAH_RUN_LEN_BITS 32
+/**
+ * @def EWAH_LITERAL_BITS
+ * @brief Width of the literal-count field of a marker word.
+ */
+#define EWAH_LITERAL_BITS 31
+/**
+ * @def EWAH_RUN_LEN_MAX
+ * @brief Longest run a single marker can describe, in words.
+ */
+#define EWAH_RUN_LEN_MAX ((UINT64_C(1) << EWAH_RUN_LEN_BITS) - 1)
+/**
+ * @def EWAH_LITERAL_MAX
+ * @brief Most literal words that can follow a single marker.
+ */
+#define EWAH_LITERAL_MAX ((UINT64_C(1) << EWAH_LITERAL_BITS) - 1)
+
+/**
+ * @brief Run-length compressed bit array in EWAH format.
+ *
+ * The vector is immutable once built; all operations return new vectors.
+ */
+typedef struct {
+    size_t n_bits;    /**< Total number of bits. */
+    size_t n_words;   /**< Number of uncompressed 64-bit words. */
+    size_t size;      /**< Compressed words in use in @c buffer. */
+    size_t capacity;  /**< Compressed words allocated in @c buffer. */
+    uint64_t *buffer; /**< Marker and literal words. */
+} EWAHBitVector;
+
+/**
+ * @brief Allocate a new EWAHBitVector with all bits cleared.
+ * @param n_bits Logical number of bits.
+ * @retval EWAHBitVector* Newly allocated vector.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+ewah_new(size_t n_bits);
+/**
+ * @brief Make a deep copy of an EWAHBitVector.
+ * @param src Source vector.
+ * @retval EWAHBitVector* Newly allocated copy.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+ewah_copy(const EWAHBitVector *src);
+/**
+ * @brief Free an EWAHBitVector.
+ * @param ewah Vector to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+ewah_free(EWAHBitVector *ewah);
+
+/**
+ * @brief Encode a BitVector in EWAH format.
+ * @param bv Source BitVector.
+ * @retval EWAHBitVector* Newly allocated compressed vector.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+bv_compress_ewah(const BitVector *bv);
+/**
+ * @brief Decode an EWAHBitVector into a flat BitVector.
+ * @param ewah Source vector.
+ * @retval BitVector* Newly allocated BitVector of the same length.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+ewah_decompress(const EWAHBitVector *ewah);
+
+/**
+ * @brief Get the bit value at a given position.
+ *
+ * Walks the marker words, so the cost is linear in the number of markers.
+ * @param ewah Pointer to the EWAHBitVector.
+ * @param pos Bit index.
+ * @return @c 0 or @c 1, or @c -1 if @p pos is out of range.
+ * @since 0.4.0
+ */
+int
+ewah_get(const EWAHBitVector *ewah, size_t pos);
+/**
+ * @brief Count all set bits without decompressing.
+ * @param ewah Pointer to the EWAHBitVector.
+ * @return Total number of set bits.
+ * @since 0.4.0
+ */
+size_t
+ewah_count(const EWAHBitVector *ewah);
+/**
+ * @brief Test equality of two EWAHBitVectors.
+ *
+ * Since the encoding is canonical this compares the compressed streams.
+ * @param a First vector.
+ * @param b Second vector.
+ * @return @c true if lengths and all bits are identical.
+ * @since 0.4.0
+ */
+bool
+ewah_equal(const EWAHBitVector *a, const EWAHBitVector *b);
+/**
+ * @brief Number of heap bytes held by the vector.
+ * @param ewah Pointer to the EWAHBitVector.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+ewah_memory_usage(const EWAHBitVector *ewah);
+
+/**
+ * @brief Bitwise AND of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval EWAHBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+ewah_and(const EWAHBitVector *a, const EWAHBitVector *b);
+/**
+ * @brief Bitwise OR of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval EWAHBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+ewah_or(const EWAHBitVector *a, const EWAHBitVector *b);
+/**
+ * @brief Bitwise XOR of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval EWAHBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+ewah_xor(const EWAHBitVector *a, const EWAHBitVector *b);
+/**
+ * @brief Bitwise AND-NOT (<tt>a & ~b</tt>) of two vectors of equal length.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval EWAHBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ * @since 0.4.0
+ */
+EWAHBitVector *
+ewah_andnot(const EWAHBitVector *a, const EWAHBitVector *b);
+
+#endif /* CBITS_EWAH_BITVECTOR_H */
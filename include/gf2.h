@@ -0,0 +1,88 @@
+/**
+ * @file gf2.h
+ * @brief Linear algebra over GF(2) on BitMatrix rows.
+ *
+ * Elimination and multiplication use the Method of Four Russians: columns
+ * are processed in strips of up to @ref GF2_STRIP_BITS. For every strip the
+ * pivot rows are combined into lookup tables of all 2^8 XOR combinations of
+ * eight rows, so clearing a strip from another row costs one table lookup
+ * per eight columns instead of one row XOR per pivot. Up to
+ * @ref GF2_MAX_TABLES tables are applied in a single pass over each row.
+ *
+ * Declares:
+ * - @ref gf2_echelon (in place, optionally reduced)
+ * - @ref gf2_rank, @ref gf2_nullspace
+ * - @ref gf2_mul
+ *
+ * @see bitmatrix.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_GF2_H
+#define CBITS_GF2_H
+
+#include "bitmatrix.h"
+
+/**
+ * @def GF2_TABLE_BITS
+ * @brief Rows combined by one lookup table (2^8 entries).
+ */
+#define GF2_TABLE_BITS 8
+/**
+ * @def GF2_MAX_TABLES
+ * @brief Lookup tables applied together in one pass over a row.
+ */
+#define GF2_MAX_TABLES 4
+/**
+ * @def GF2_STRIP_BITS
+ * @brief Columns handled per elimination or multiplication step.
+ */
+#define GF2_STRIP_BITS (GF2_TABLE_BITS * GF2_MAX_TABLES)
+
+/**
+ * @brief Bring a matrix into row echelon form in place.
+ *
+ * After the call, rows @c [0, rank) hold the pivots in increasing column
+ * order and all other rows are zero. With @p reduced every pivot column is
+ * zero outside its pivot row (reduced row echelon form).
+ * @param m Matrix to transform.
+ * @param reduced Also clear the entries above each pivot.
+ * @param pivots Optional output of @c min(n_rows, n_cols) entries receiving
+ *        the pivot column of every pivot row; may be NULL.
+ * @return Rank of the matrix, or @c SIZE_MAX on allocation failure (the
+ *         matrix is then unchanged).
+ * @since 0.4.0
+ */
+size_t
+gf2_echelon(BitMatrix *m, bool reduced, size_t *pivots);
+/**
+ * @brief Rank of a matrix over GF(2).
+ * @param m Pointer to the BitMatrix (not modified).
+ * @return Rank, or @c SIZE_MAX on allocation failure.
+ * @since 0.4.0
+ */
+size_t
+gf2_rank(const BitMatrix *m);
+/**
+ * @brief Basis of the right nullspace <tt>{x : m x = 0}</tt>.
+ * @param m Pointer to the BitMatrix (not modified).
+ * @retval BitMatrix* New matrix whose @c n_cols - rank rows are the basis
+ *         vectors, each of @c n_cols bits.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitMatrix *
+gf2_nullspace(const BitMatrix *m);
+/**
+ * @brief Matrix product over GF(2).
+ * @param a Left factor (@c n x @c k).
+ * @param b Right factor (@c k x @c p).
+ * @retval BitMatrix* New @c n x @c p product.
+ * @retval NULL Shape mismatch or allocation failure.
+ * @since 0.4.0
+ */
+BitMatrix *
+gf2_mul(const BitMatrix *a, const BitMatrix *b);
+
+#endif /* CBITS_GF2_H */
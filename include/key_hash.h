@@ -0,0 +1,82 @@
+/**
+ * @file key_hash.h
+ * @brief Seeded 64-bit key hashes shared by the probabilistic filters.
+ *
+ * Declares:
+ * - the built-in hash functions (::KeyHash)
+ * - hashing of byte strings (@ref key_hash) and integer keys
+ *   (@ref key_hash_u64)
+ * - batched variants (@ref key_hash_u64_many, @ref key_hash_fixed_many)
+ *
+ * Integer keys hash like their 8 little-endian bytes, so the same key gives
+ * the same hash whether it arrives as an integer or as bytes.
+ *
+ * @see bloom_filter.h
+ * @see quotient_filter.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_KEY_HASH_H
+#define CBITS_KEY_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Built-in key hash functions.
+ */
+typedef enum {
+    KEY_HASH_XXH64 = 0, /**< XXH64, the default. */
+    KEY_HASH_FNV1A = 1, /**< FNV-1a with a final avalanche step. */
+    KEY_HASH_COUNT      /**< Number of hash functions. */
+} KeyHash;
+
+/**
+ * @brief Hash a byte string.
+ * @param hash Hash function.
+ * @param seed Hash seed.
+ * @param key Key bytes (may be NULL if @p len is 0).
+ * @param len Key length in bytes.
+ * @return 64-bit key hash.
+ * @since 0.4.0
+ */
+uint64_t
+key_hash(KeyHash hash, uint64_t seed, const void *key, size_t len);
+/**
+ * @brief Hash an integer key, taken as its 8 little-endian bytes.
+ * @param hash Hash function.
+ * @param seed Hash seed.
+ * @param key Key.
+ * @return 64-bit key hash, equal to @ref key_hash of those 8 bytes.
+ * @since 0.4.0
+ */
+uint64_t
+key_hash_u64(KeyHash hash, uint64_t seed, uint64_t key);
+/**
+ * @brief Hash an array of integer keys.
+ * @param hash Hash function.
+ * @param seed Hash seed.
+ * @param keys Keys.
+ * @param n Number of keys.
+ * @param out Output of @p n hashes.
+ * @since 0.4.0
+ */
+void
+key_hash_u64_many(KeyHash hash, uint64_t seed, const uint64_t *keys,
+                  size_t n, uint64_t *out);
+/**
+ * @brief Hash packed fixed-width byte keys.
+ * @param hash Hash function.
+ * @param seed Hash seed.
+ * @param data @p n keys of @p width bytes, back to back.
+ * @param width Bytes per key.
+ * @param n Number of keys.
+ * @param out Output of @p n hashes.
+ * @since 0.4.0
+ */
+void
+key_hash_fixed_many(KeyHash hash, uint64_t seed, const void *data,
+                    size_t width, size_t n, uint64_t *out);
+
+#endif /* CBITS_KEY_HASH_H */
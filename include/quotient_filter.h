@@ -0,0 +1,210 @@
+/**
+ * @file quotient_filter.h
+ * @brief Public C API for the rank-and-select quotient filter.
+ *
+ * A QuotientFilter is an approximate multiset that supports deletion. The
+ * top @c q_bits of a key hash select a home slot (the quotient), the next
+ * @c r_bits are stored as the remainder. Remainders of one quotient form a
+ * run of consecutive slots; runs are kept in quotient order and shifted
+ * right when a home slot is already taken. Two BitVectors describe the
+ * layout:
+ * - @c occupieds has bit @c q set if quotient @c q has a run
+ * - @c runends has a bit set at the last slot of every run
+ *
+ * The run of quotient @c q ends at the @c j-th set bit of @c runends, where
+ * @c j is the number of occupied quotients up to @c q. Instead of a global
+ * rank directory, which every insertion would invalidate, each block of 64
+ * slots stores the offset of that run end for its first slot, so a lookup
+ * is one popcount within a block and one select within a few words.
+ *
+ * Declares:
+ * - sizing and construction (@ref qf_params, @ref qf_new, @ref qf_copy,
+ *   @ref qf_free)
+ * - single-key operations by hash (@ref qf_insert_hash,
+ *   @ref qf_contains_hash, @ref qf_count_hash, @ref qf_remove_hash)
+ * - batched operations that prefetch the slots of upcoming keys
+ *   (@ref qf_insert_hashes, @ref qf_contains_hashes, @ref qf_remove_hashes)
+ *
+ * Keys are hashed with key_hash.h.
+ *
+ * @see bitvector.h
+ * @see key_hash.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_QUOTIENT_FILTER_H
+#define CBITS_QUOTIENT_FILTER_H
+
+#include "bitvector.h"
+#include "key_hash.h"
+
+/**
+ * @def QF_MAX_QUOTIENT_BITS
+ * @brief Largest supported number of quotient bits.
+ */
+#define QF_MAX_QUOTIENT_BITS 40
+/**
+ * @def QF_MAX_LOAD
+ * @brief Fraction of the home slots that @ref qf_params plans to fill.
+ */
+#define QF_MAX_LOAD 0.9
+
+/**
+ * @brief Quotient filter with rank-and-select metadata.
+ */
+typedef struct {
+    BitVector *occupieds;  /**< Bit @c q set if quotient @c q is stored. */
+    BitVector *runends;    /**< Bit set at the last slot of each run. */
+    uint64_t *remainders;  /**< Packed @c r_bits wide remainders. */
+    size_t *offsets;       /**< Run end offset per block of 64 slots. */
+    size_t n_slots;        /**< Home slots plus overflow, multiple of 64. */
+    size_t n_items;        /**< Number of stored remainders. */
+    unsigned q_bits;       /**< Quotient bits; there are 2^q home slots. */
+    unsigned r_bits;       /**< Remainder bits. */
+    KeyHash hash;          /**< Key hash function. */
+    uint64_t seed;         /**< Seed of the key hash. */
+} QuotientFilter;
+
+/**
+ * @brief Quotient and remainder sizes for a capacity and error rate.
+ *
+ * Picks the smallest power of two of home slots that holds @p capacity
+ * keys at @ref QF_MAX_LOAD and <tt>r = ceil(log2(1 / error_rate))</tt>.
+ * @param capacity Expected number of keys.
+ * @param error_rate Target false positive rate in <tt>(0, 1)</tt>.
+ * @param q_bits Receives the quotient bits.
+ * @param r_bits Receives the remainder bits.
+ * @retval 0 Success.
+ * @retval -1 @p error_rate out of range or the filter would be too large.
+ * @since 0.4.0
+ */
+int
+qf_params(size_t capacity, double error_rate, unsigned *q_bits,
+          unsigned *r_bits);
+/**
+ * @brief Allocate an empty filter.
+ * @param q_bits Quotient bits, from 1 to @ref QF_MAX_QUOTIENT_BITS.
+ * @param r_bits Remainder bits, at least 1 and at most <tt>64 - q_bits</tt>.
+ * @param hash Key hash function.
+ * @param seed Seed of the key hash.
+ * @retval QuotientFilter* Newly allocated filter.
+ * @retval NULL Invalid parameters or allocation failure.
+ * @since 0.4.0
+ */
+QuotientFilter *
+qf_new(unsigned q_bits, unsigned r_bits, KeyHash hash, uint64_t seed);
+/**
+ * @brief Deep copy of a filter.
+ * @param qf Filter to copy.
+ * @retval QuotientFilter* New filter.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+QuotientFilter *
+qf_copy(const QuotientFilter *qf);
+/**
+ * @brief Free a filter.
+ * @param qf Filter to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+qf_free(QuotientFilter *qf);
+
+/**
+ * @brief Insert one key given by its hash.
+ *
+ * Inserting the same key twice stores it twice. The filter holds at most
+ * <tt>2^q</tt> keys, one per home slot.
+ * @param qf Pointer to the filter.
+ * @param hash Key hash.
+ * @retval 0 Success.
+ * @retval -1 The filter is full or no free slot is left; the filter is
+ *            unchanged.
+ * @since 0.4.0
+ */
+int
+qf_insert_hash(QuotientFilter *qf, uint64_t hash);
+/**
+ * @brief Look up one key given by its hash.
+ * @param qf Pointer to the filter.
+ * @param hash Key hash.
+ * @return @c true if the key may be present, @c false if it is absent.
+ * @since 0.4.0
+ */
+bool
+qf_contains_hash(const QuotientFilter *qf, uint64_t hash);
+/**
+ * @brief Number of stored copies of a key's fingerprint.
+ *
+ * An upper bound on the key's multiplicity: fingerprint collisions with
+ * other keys are counted too.
+ * @param qf Pointer to the filter.
+ * @param hash Key hash.
+ * @return Number of matching remainders in the key's run.
+ * @since 0.4.0
+ */
+size_t
+qf_count_hash(const QuotientFilter *qf, uint64_t hash);
+/**
+ * @brief Remove one copy of a key given by its hash.
+ *
+ * Only keys that were inserted may be removed; removing a key that was
+ * never inserted but collides with a stored one deletes that key instead.
+ * @param qf Pointer to the filter.
+ * @param hash Key hash.
+ * @return @c true if a matching remainder was removed.
+ * @since 0.4.0
+ */
+bool
+qf_remove_hash(QuotientFilter *qf, uint64_t hash);
+
+/**
+ * @brief Insert keys given by their hashes.
+ * @param qf Pointer to the filter.
+ * @param hashes Key hashes.
+ * @param n Number of keys.
+ * @return Number of keys inserted; less than @p n only when the filter
+ *         became full, in which case the remaining keys are skipped.
+ * @since 0.4.0
+ */
+size_t
+qf_insert_hashes(QuotientFilter *qf, const uint64_t *hashes, size_t n);
+/**
+ * @brief Look up keys given by their hashes.
+ *
+ * Bit @c i of @p out is set if key @c i may be in the filter. Other bits of
+ * @p out are untouched.
+ * @param qf Pointer to the filter.
+ * @param hashes Key hashes.
+ * @param n Number of keys.
+ * @param out Result words; the caller clears the first @p n bits.
+ * @since 0.4.0
+ */
+void
+qf_contains_hashes(const QuotientFilter *qf, const uint64_t *hashes,
+                   size_t n, uint64_t *out);
+/**
+ * @brief Remove one copy of each of a batch of keys.
+ * @param qf Pointer to the filter.
+ * @param hashes Key hashes.
+ * @param n Number of keys.
+ * @param out Result words receiving bit @c i if key @c i was removed
+ *        (the caller clears the first @p n bits), or NULL.
+ * @return Number of keys removed.
+ * @since 0.4.0
+ */
+size_t
+qf_remove_hashes(QuotientFilter *qf, const uint64_t *hashes, size_t n,
+                 uint64_t *out);
+
+/**
+ * @brief Number of heap bytes held by the filter.
+ * @param qf Pointer to the filter.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+qf_memory_usage(const QuotientFilter *qf);
+
+#endif /* CBITS_QUOTIENT_FILTER_H */
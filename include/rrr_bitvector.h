@@ -0,0 +1,131 @@
+/**
+ * @file rrr_bitvector.h
+ * @brief Public C API for the RRR (H0-compressed) bit array.
+ *
+ * An RRRBitVector stores a BitVector as a sequence of 64-bit blocks, each
+ * encoded as a (class, offset) pair:
+ * - the class is the popcount of the block, one byte per block
+ * - the offset is the rank of the block among all 64-bit words of that
+ *   class in the combinatorial number system, stored in exactly
+ *   <tt>ceil(log2(C(64, class)))</tt> bits
+ *
+ * All-zero and all-one blocks take no offset bits at all, so the size
+ * tracks the zero-order entropy of the input. Every @ref RRR_SAMPLE_BLOCKS
+ * blocks a sample stores the rank so far and the position in the offset
+ * stream, which bounds the work of every query by a constant.
+ *
+ * Declares:
+ * - construction and destruction (@ref bv_build_rrr, @ref rrr_free)
+ * - queries (@ref rrr_get, @ref rrr_rank, @ref rrr_select, @ref rrr_count)
+ * - conversion back to a BitVector (@ref rrr_to_bitvector)
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_RRR_BITVECTOR_H
+#define CBITS_RRR_BITVECTOR_H
+
+#include "bitvector.h"
+
+/**
+ * @def RRR_SAMPLE_SHIFT
+ * @brief Log2 of the number of blocks between two samples.
+ */
+#define RRR_SAMPLE_SHIFT 5
+/**
+ * @def RRR_SAMPLE_BLOCKS
+ * @brief Number of 64-bit blocks between two samples.
+ */
+#define RRR_SAMPLE_BLOCKS (1u << RRR_SAMPLE_SHIFT)
+
+/**
+ * @brief Read-only, entropy-compressed bit array with rank/select support.
+ */
+typedef struct {
+    size_t n_bits;          /**< Total number of bits. */
+    size_t n_blocks;        /**< Number of 64-bit blocks. */
+    size_t n_ones;          /**< Total number of set bits. */
+    uint8_t *classes;       /**< Popcount of every block. */
+    uint64_t *offsets;      /**< Packed offsets, plus one padding word. */
+    size_t *rank_samples;   /**< Set bits before each sample, plus total. */
+    size_t *offset_samples; /**< Offset stream position of each sample. */
+} RRRBitVector;
+
+/**
+ * @brief Encode a BitVector in RRR form.
+ * @param bv Source BitVector.
+ * @retval RRRBitVector* Newly allocated vector.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+RRRBitVector *
+bv_build_rrr(const BitVector *bv);
+/**
+ * @brief Free an RRRBitVector.
+ * @param rrr Vector to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+rrr_free(RRRBitVector *rrr);
+/**
+ * @brief Decode an RRRBitVector into a flat BitVector.
+ * @param rrr Source vector.
+ * @retval BitVector* Newly allocated BitVector of the same length.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+BitVector *
+rrr_to_bitvector(const RRRBitVector *rrr);
+
+/**
+ * @brief Get the bit value at a given position.
+ * @param rrr Pointer to the RRRBitVector.
+ * @param pos Bit index.
+ * @return @c 0 or @c 1, or @c -1 if @p pos is out of range.
+ * @since 0.4.0
+ */
+int
+rrr_get(const RRRBitVector *rrr, size_t pos);
+/**
+ * @brief Count set bits up to and including a position.
+ *
+ * Matches @ref bv_rank: positions past the end are clamped to the last bit.
+ * @param rrr Pointer to the RRRBitVector.
+ * @param pos Bit index.
+ * @return Number of bits set in range @c [0...pos]
+ * @since 0.4.0
+ */
+size_t
+rrr_rank(const RRRBitVector *rrr, size_t pos);
+/**
+ * @brief Find the position of the k-th set bit.
+ *
+ * Inverse of @ref rrr_rank: <tt>rrr_rank(rrr, rrr_select(rrr, k)) == k +
+ * 1</tt>.
+ * @param rrr Pointer to the RRRBitVector.
+ * @param k Zero-based index of the set bit.
+ * @return Bit position, or @c SIZE_MAX if fewer than @p k + 1 bits are set.
+ * @since 0.4.0
+ */
+size_t
+rrr_select(const RRRBitVector *rrr, size_t k);
+/**
+ * @brief Count all set bits.
+ * @param rrr Pointer to the RRRBitVector.
+ * @return Total number of set bits.
+ * @since 0.4.0
+ */
+size_t
+rrr_count(const RRRBitVector *rrr);
+/**
+ * @brief Number of heap bytes held by the vector.
+ * @param rrr Pointer to the RRRBitVector.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+rrr_memory_usage(const RRRBitVector *rrr);
+
+#endif /* CBITS_RRR_BITVECTOR_H */
@@ -0,0 +1,152 @@
+/**
+ * @file wavelet_matrix.h
+ * @brief Public C API for the wavelet matrix over integer sequences.
+ *
+ * A WaveletMatrix stores a sequence of @c n unsigned integers of at most
+ * @c n_levels bits as one BitVector per bit, most significant bit first.
+ * Level @c l holds bit <tt>n_levels - 1 - l</tt> of every value, in the
+ * order produced by stably partitioning the previous level by its bit
+ * (zeros first). Every query walks the levels using only the rank tables
+ * of each level, so access, rank, quantile and range counting cost
+ * <tt>O(n_levels)</tt> @ref bv_rank calls; select adds a binary search over
+ * the superblock counts per level.
+ *
+ * Because the order at level @c l only depends on the top @c l bits of each
+ * value, levels of small alphabets are built independently of each other by
+ * a counting sort and in parallel (see @ref WM_PARALLEL_MAX_LEVELS).
+ *
+ * Declares:
+ * - construction and destruction (@ref wm_new, @ref wm_free)
+ * - point queries (@ref wm_access, @ref wm_rank, @ref wm_select)
+ * - range queries (@ref wm_quantile, @ref wm_range_freq)
+ *
+ * All ranges are half-open, <tt>[start, stop)</tt>.
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_WAVELET_MATRIX_H
+#define CBITS_WAVELET_MATRIX_H
+
+#include "bitvector.h"
+
+/**
+ * @def WM_MAX_LEVELS
+ * @brief Maximum number of levels (bits per symbol).
+ */
+#define WM_MAX_LEVELS 64
+/**
+ * @def WM_PARALLEL_MAX_LEVELS
+ * @brief Largest level count whose levels are built independently.
+ *
+ * Building level @c l on its own needs a counting sort over @c 2^l buckets;
+ * wider alphabets fall back to the sequential level-by-level partition.
+ */
+#define WM_PARALLEL_MAX_LEVELS 16
+/**
+ * @def WM_PARALLEL_MIN_SIZE
+ * @brief Sequences shorter than this are always built on one thread.
+ */
+#define WM_PARALLEL_MIN_SIZE (1u << 16)
+
+/**
+ * @brief Wavelet matrix over a sequence of unsigned integers.
+ */
+typedef struct {
+    size_t n;                         /**< Sequence length. */
+    unsigned n_levels;                /**< Bits per symbol. */
+    BitVector *levels[WM_MAX_LEVELS]; /**< One bit plane per level. */
+    size_t zeros[WM_MAX_LEVELS];      /**< Clear bits of every level. */
+} WaveletMatrix;
+
+/**
+ * @brief Build a wavelet matrix from a buffer of integers.
+ *
+ * The level count is the bit width of the largest value (at least 1).
+ * @param values Input sequence (may be NULL if @p n is 0).
+ * @param n Number of values.
+ * @param n_threads Worker threads; @c 0 picks one per processor.
+ * @retval WaveletMatrix* Newly allocated matrix.
+ * @retval NULL Allocation failure.
+ * @since 0.4.0
+ */
+WaveletMatrix *
+wm_new(const uint64_t *values, size_t n, unsigned n_threads);
+/**
+ * @brief Free a wavelet matrix.
+ * @param wm Matrix to free (may be NULL).
+ * @since 0.4.0
+ */
+void
+wm_free(WaveletMatrix *wm);
+
+/**
+ * @brief Value at position @p i.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param i Position.
+ * @return The value, or @c UINT64_MAX if @p i is out of range.
+ * @since 0.4.0
+ */
+uint64_t
+wm_access(const WaveletMatrix *wm, size_t i);
+/**
+ * @brief Count occurrences of @p symbol in the first @p i positions.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param symbol Symbol to count.
+ * @param i Prefix length; clamped to the sequence length.
+ * @return Number of occurrences in <tt>[0, i)</tt>.
+ * @since 0.4.0
+ */
+size_t
+wm_rank(const WaveletMatrix *wm, uint64_t symbol, size_t i);
+/**
+ * @brief Find the position of the k-th occurrence of @p symbol.
+ *
+ * Inverse of @ref wm_rank: <tt>wm_rank(wm, c, wm_select(wm, c, k) + 1) ==
+ * k + 1</tt>.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param symbol Symbol to look for.
+ * @param k Zero-based occurrence index.
+ * @return Position, or @c SIZE_MAX if @p symbol occurs at most @p k times.
+ * @since 0.4.0
+ */
+size_t
+wm_select(const WaveletMatrix *wm, uint64_t symbol, size_t k);
+/**
+ * @brief k-th smallest value in a range.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param start First position of the range.
+ * @param stop One past the last position; clamped to the sequence length.
+ * @param k Zero-based rank within the sorted range (0 is the minimum).
+ * @return The value, or @c UINT64_MAX if the range holds at most @p k
+ *         values.
+ * @since 0.4.0
+ */
+uint64_t
+wm_quantile(const WaveletMatrix *wm, size_t start, size_t stop, size_t k);
+/**
+ * @brief Count the values within <tt>[lo, hi)</tt> in a range of positions.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param start First position of the range.
+ * @param stop One past the last position; clamped to the sequence length.
+ * @param lo Smallest value counted.
+ * @param hi One past the largest value counted.
+ * @return Number of positions @c p in <tt>[start, stop)</tt> with
+ *         <tt>lo <= value(p) < hi</tt>.
+ * @since 0.4.0
+ */
+size_t
+wm_range_freq(const WaveletMatrix *wm, size_t start, size_t stop,
+              uint64_t lo, uint64_t hi);
+/**
+ * @brief Number of heap bytes held by the matrix.
+ * @param wm Pointer to the WaveletMatrix.
+ * @return Footprint in bytes.
+ * @since 0.4.0
+ */
+size_t
+wm_memory_usage(const WaveletMatrix *wm);
+
+#endif /* CBITS_WAVELET_MATRIX_H */
@@ -18,7 +18,7 @@ Version 0.3.0
 
 Copyright (c) 2026 lambdaphoenix
 """
-from ._cbits import BitVector, __author__, __version__, __license__, __license_url__
+from ._cbits import BitVector, CompressedBitVector, EWAHBitVector, EliasFano, RRRBitVector, WaveletMatrix, BPTree, BitMatrix, BitVectorCollection, BloomFilter, BlockedBloomFilter, QuotientFilter, BitSlicedIndex, BitmapIndex, and_all, or_all, xor_all, threshold, cpu_features, active_kernels, set_kernel, stats, live_bytes, __author__, __version__, __license__, __license_url__
 
 ## @brief Package author name (forwarded from the C extension).
 __author__ = _cbits.__author__
@@ -40,5 +40,27 @@ __license_url__ = _cbits.__license_url__
 ## @ingroup cbits_api
 __all__ = [
     "BitVector",
+    "CompressedBitVector",
+    "EWAHBitVector",
+    "EliasFano",
+    "RRRBitVector",
+    "WaveletMatrix",
+    "BPTree",
+    "BitMatrix",
+    "BitVectorCollection",
+    "BloomFilter",
+    "BlockedBloomFilter",
+    "QuotientFilter",
+    "BitSlicedIndex",
+    "BitmapIndex",
+    "and_all",
+    "or_all",
+    "xor_all",
+    "threshold",
+    "cpu_features",
+    "active_kernels",
+    "set_kernel",
+    "stats",
+    "live_bytes",
 ]
 """cbits_api - Symbols exposed to Python users"""
\ No newline at end of file
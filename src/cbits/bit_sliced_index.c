@@ -0,0 +1,419 @@
+/**
+ * @file src/cbits/bit_sliced_index.c
+ * @brief Bit-sliced index construction, predicates and aggregates.
+ *
+ * This module implements:
+ * - \ref bsi_new, \ref bsi_free, \ref bsi_get
+ * - \ref bsi_compare and \ref bsi_between
+ * - \ref bsi_slice_counts and \ref bsi_top_k
+ *
+ * Predicates walk the rows one block of @ref BSI_BLOCK_WORDS words at a
+ * time. Within a block the slices are visited from the most significant bit
+ * down while the less-than, equal and greater-than masks of the block stay
+ * in L1 cache, so each slice word is loaded once per query and the result
+ * is written once. Every slice step runs on the dispatched bitwise kernel
+ * of compat.h.
+ *
+ * @see bit_sliced_index.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bit_sliced_index.h"
+#include "bitmatrix.h"
+#include "bitvector_internal.h"
+
+#include <string.h>
+
+/**
+ * @def BSI_BLOCK_WORDS
+ * @brief Words of every slice processed together; large enough to amortize
+ *        a kernel call, small enough for the block masks to stay in L1.
+ */
+#define BSI_BLOCK_WORDS 256
+
+/**
+ * @brief Map a value onto the stored domain.
+ * @param bsi Pointer to the index.
+ * @param value Value to map.
+ * @param stored Receives <tt>value - base</tt> if it is representable.
+ * @retval -1 @p value is below every storable value.
+ * @retval 0 @p value is storable; @p stored is set.
+ * @retval 1 @p value is above every storable value.
+ */
+static inline int
+bsi__bound(const BitSlicedIndex *bsi, int64_t value, uint64_t *stored)
+{
+    if (value < bsi->base) {
+        return -1;
+    }
+    const uint64_t d = (uint64_t) value - (uint64_t) bsi->base;
+    if (bsi->n_slices < 64 && (d >> bsi->n_slices)) {
+        return 1;
+    }
+    *stored = d;
+    return 0;
+}
+
+/**
+ * @brief Number of words in the block starting at word @p w.
+ * @param n_words Words per slice.
+ * @param w First word of the block.
+ * @return Block length, at most @ref BSI_BLOCK_WORDS.
+ */
+static inline size_t
+bsi__block_len(size_t n_words, size_t w)
+{
+    return n_words - w < BSI_BLOCK_WORDS ? n_words - w : BSI_BLOCK_WORDS;
+}
+
+/**
+ * @brief Narrow the rows of a block still equal to a constant by one slice.
+ *
+ * Rows of @p *eq whose slice bit differs from @p bit leave it, and are ORed
+ * into @p lt if @p bit is 1 or into @p gt if it is 0; either may be NULL if
+ * those rows are not needed. The narrowed rows may end up in @p *spare, in
+ * which case the two pointers are swapped.
+ * @param s Slice words of the block.
+ * @param m Words in the block.
+ * @param bit Bit of the constant in this slice.
+ * @param lt Rows below the constant, or NULL.
+ * @param eq Rows equal to the constant so far.
+ * @param spare Scratch block of @p m words.
+ * @param gt Rows above the constant, or NULL.
+ */
+static inline void
+bsi__compare_slice(const uint64_t *s, size_t m, uint64_t bit, uint64_t *lt,
+                   uint64_t **eq, uint64_t **spare, uint64_t *gt)
+{
+    uint64_t *e = *eq;
+    uint64_t *t = *spare;
+    if (bit && !lt) {
+        cbits_bitwise_words(e, e, s, m, CBITS_BITWISE_AND);
+        return;
+    }
+    /* t = eq & s, eq ^ t = eq & ~s. */
+    cbits_bitwise_words(t, e, s, m, CBITS_BITWISE_AND);
+    cbits_bitwise_words(e, e, t, m, CBITS_BITWISE_XOR);
+    if (bit) {
+        cbits_bitwise_words(lt, lt, e, m, CBITS_BITWISE_OR);
+        *eq = t;
+        *spare = e;
+    }
+    else if (gt) {
+        cbits_bitwise_words(gt, gt, t, m, CBITS_BITWISE_OR);
+    }
+}
+
+/**
+ * @brief Select the rows satisfying @p op from a three-way comparison.
+ * @param op Comparison.
+ * @param lt Rows below the constant.
+ * @param eq Rows equal to the constant.
+ * @param gt Rows above the constant.
+ * @return Matching rows.
+ */
+static inline uint64_t
+bsi__pick(BSIOp op, uint64_t lt, uint64_t eq, uint64_t gt)
+{
+    switch (op) {
+        case BSI_EQ:
+            return eq;
+        case BSI_NE:
+            return lt | gt;
+        case BSI_LT:
+            return lt;
+        case BSI_LE:
+            return lt | eq;
+        case BSI_GT:
+            return gt;
+        case BSI_GE:
+            return gt | eq;
+    }
+    return 0;
+}
+
+BitSlicedIndex *
+bsi_new(const int64_t *values, const BitVector *exists, size_t n_rows)
+{
+    BitSlicedIndex *bsi = cbits_calloc(1, sizeof(BitSlicedIndex));
+    if (!bsi) {
+        return NULL;
+    }
+    bsi->n_rows = n_rows;
+    if (exists) {
+        bsi->exists = bv_copy(exists);
+    }
+    else {
+        bsi->exists = bv_new(n_rows);
+        if (bsi->exists && n_rows) {
+            bv_set_range(bsi->exists, 0, n_rows);
+        }
+    }
+    if (!bsi->exists) {
+        bsi_free(bsi);
+        return NULL;
+    }
+
+    const uint64_t *present = bsi->exists->data;
+    bool any = false;
+    int64_t lo = 0, hi = 0;
+    for (size_t r = 0; r < n_rows; ++r) {
+        if (!((present[bv_word(r)] >> bv_bit(r)) & 1)) {
+            continue;
+        }
+        if (!any || values[r] < lo) {
+            lo = values[r];
+        }
+        if (!any || values[r] > hi) {
+            hi = values[r];
+        }
+        any = true;
+    }
+    bsi->base = lo;
+    const uint64_t span = (uint64_t) hi - (uint64_t) lo;
+    while (bsi->n_slices < 64 && (span >> bsi->n_slices)) {
+        bsi->n_slices++;
+    }
+    for (unsigned b = 0; b < bsi->n_slices; ++b) {
+        bsi->slices[b] = bv_new(n_rows);
+        if (!bsi->slices[b]) {
+            bsi_free(bsi);
+            return NULL;
+        }
+    }
+
+    /* Row i of a 64-row block becomes bit i of word b of every slice. */
+    uint64_t tile[64];
+    for (size_t rb = 0; rb < n_rows; rb += 64) {
+        const size_t n = n_rows - rb < 64 ? n_rows - rb : 64;
+        const uint64_t mask = present[rb >> 6];
+        for (size_t i = 0; i < n; ++i) {
+            tile[i] = ((mask >> i) & 1)
+                          ? (uint64_t) values[rb + i] - (uint64_t) lo
+                          : 0;
+        }
+        for (size_t i = n; i < 64; ++i) {
+            tile[i] = 0;
+        }
+        bm_transpose64(tile);
+        for (unsigned b = 0; b < bsi->n_slices; ++b) {
+            bsi->slices[b]->data[rb >> 6] = tile[b];
+        }
+    }
+    return bsi;
+}
+
+void
+bsi_free(BitSlicedIndex *bsi)
+{
+    if (!bsi) {
+        return;
+    }
+    for (unsigned b = 0; b < bsi->n_slices; ++b) {
+        bv_free(bsi->slices[b]);
+    }
+    bv_free(bsi->exists);
+    cbits_free(bsi);
+}
+
+bool
+bsi_get(const BitSlicedIndex *bsi, size_t row, int64_t *value)
+{
+    if (!bv__get_inline(bsi->exists, row)) {
+        return false;
+    }
+    uint64_t v = 0;
+    for (unsigned b = 0; b < bsi->n_slices; ++b) {
+        v |= (uint64_t) bv__get_inline(bsi->slices[b], row) << b;
+    }
+    *value = (int64_t) ((uint64_t) bsi->base + v);
+    return true;
+}
+
+BitVector *
+bsi_compare(const BitSlicedIndex *bsi, BSIOp op, int64_t value)
+{
+    BitVector *out = bv_new(bsi->n_rows);
+    if (!out) {
+        return NULL;
+    }
+    uint64_t c = 0;
+    const int rel = bsi__bound(bsi, value, &c);
+    const uint64_t *ex = bsi->exists->data;
+    const size_t n_words = bsi->exists->n_words;
+    uint64_t lt[BSI_BLOCK_WORDS], gt[BSI_BLOCK_WORDS];
+    uint64_t eq_buf[BSI_BLOCK_WORDS], spare_buf[BSI_BLOCK_WORDS];
+    for (size_t w = 0; w < n_words; w += BSI_BLOCK_WORDS) {
+        const size_t m = bsi__block_len(n_words, w);
+        uint64_t *eq = eq_buf, *spare = spare_buf;
+        for (size_t i = 0; i < m; ++i) {
+            lt[i] = rel > 0 ? ex[w + i] : 0;
+            eq[i] = rel ? 0 : ex[w + i];
+            gt[i] = rel < 0 ? ex[w + i] : 0;
+        }
+        if (!rel) {
+            for (unsigned b = bsi->n_slices; b-- > 0;) {
+                bsi__compare_slice(bsi->slices[b]->data + w, m, (c >> b) & 1,
+                                   lt, &eq, &spare, gt);
+            }
+        }
+        for (size_t i = 0; i < m; ++i) {
+            out->data[w + i] = bsi__pick(op, lt[i], eq[i], gt[i]);
+        }
+    }
+    return out;
+}
+
+BitVector *
+bsi_between(const BitSlicedIndex *bsi, int64_t lo, int64_t hi)
+{
+    BitVector *out = bv_new(bsi->n_rows);
+    if (!out || lo > hi) {
+        return out;
+    }
+    uint64_t c_lo = 0, c_hi = 0;
+    const int rel_lo = bsi__bound(bsi, lo, &c_lo);
+    const int rel_hi = bsi__bound(bsi, hi, &c_hi);
+    if (rel_lo > 0 || rel_hi < 0) {
+        return out;
+    }
+    if (rel_hi > 0) {
+        c_hi = bsi->n_slices < 64 ? (1ULL << bsi->n_slices) - 1 : ~0ULL;
+    }
+    /* rel_lo < 0 leaves c_lo at zero, which every stored value reaches. */
+
+    const uint64_t *ex = bsi->exists->data;
+    const size_t n_words = bsi->exists->n_words;
+    uint64_t gt_lo[BSI_BLOCK_WORDS], lt_hi[BSI_BLOCK_WORDS];
+    uint64_t buf[4][BSI_BLOCK_WORDS];
+    for (size_t w = 0; w < n_words; w += BSI_BLOCK_WORDS) {
+        const size_t m = bsi__block_len(n_words, w);
+        uint64_t *eq_lo = buf[0], *spare_lo = buf[1];
+        uint64_t *eq_hi = buf[2], *spare_hi = buf[3];
+        for (size_t i = 0; i < m; ++i) {
+            gt_lo[i] = lt_hi[i] = 0;
+            eq_lo[i] = eq_hi[i] = ex[w + i];
+        }
+        for (unsigned b = bsi->n_slices; b-- > 0;) {
+            const uint64_t *s = bsi->slices[b]->data + w;
+            bsi__compare_slice(s, m, (c_lo >> b) & 1, NULL, &eq_lo,
+                               &spare_lo, gt_lo);
+            bsi__compare_slice(s, m, (c_hi >> b) & 1, lt_hi, &eq_hi,
+                               &spare_hi, NULL);
+        }
+        for (size_t i = 0; i < m; ++i) {
+            out->data[w + i] = (gt_lo[i] | eq_lo[i]) & (lt_hi[i] | eq_hi[i]);
+        }
+    }
+    return out;
+}
+
+size_t
+bsi_slice_counts(const BitSlicedIndex *bsi, const BitVector *filter,
+                 size_t *counts)
+{
+    for (unsigned b = 0; b < bsi->n_slices; ++b) {
+        counts[b] = 0;
+    }
+    const uint64_t *ex = bsi->exists->data;
+    const size_t n_words = bsi->exists->n_words;
+    size_t found = 0;
+    uint64_t f[BSI_BLOCK_WORDS];
+    for (size_t w = 0; w < n_words; w += BSI_BLOCK_WORDS) {
+        const size_t m = bsi__block_len(n_words, w);
+        for (size_t i = 0; i < m; ++i) {
+            f[i] = filter ? ex[w + i] & filter->data[w + i] : ex[w + i];
+            found += cbits_popcount64(f[i]);
+        }
+        for (unsigned b = 0; b < bsi->n_slices; ++b) {
+            const uint64_t *s = bsi->slices[b]->data + w;
+            size_t count = 0;
+            for (size_t i = 0; i < m; ++i) {
+                count += cbits_popcount64(s[i] & f[i]);
+            }
+            counts[b] += count;
+        }
+    }
+    return found;
+}
+
+BitVector *
+bsi_top_k(const BitSlicedIndex *bsi, size_t k, const BitVector *filter,
+          bool largest)
+{
+    const size_t n_words = bsi->exists->n_words;
+    BitVector *g = bv_new(bsi->n_rows);
+    BitVector *e = bv_new(bsi->n_rows);
+    if (!g || !e) {
+        bv_free(g);
+        bv_free(e);
+        return NULL;
+    }
+    size_t found = 0;
+    for (size_t w = 0; w < n_words; ++w) {
+        e->data[w] = bsi->exists->data[w] & (filter ? filter->data[w] : ~0ULL);
+        found += cbits_popcount64(e->data[w]);
+    }
+    if (found <= k) {
+        bv_free(g);
+        return e;
+    }
+
+    /*
+     * Invariant: g holds rows certainly in the answer, e the rows tied with
+     * the boundary on the slices seen so far, |g| < k <= |g| + |e|.
+     */
+    size_t taken = 0;
+    const uint64_t flip = largest ? 0 : ~0ULL;
+    for (unsigned b = bsi->n_slices; b-- > 0 && k > taken;) {
+        const uint64_t *s = bsi->slices[b]->data;
+        size_t count = taken;
+        for (size_t w = 0; w < n_words; ++w) {
+            count += cbits_popcount64(e->data[w] & (s[w] ^ flip));
+        }
+        if (count > k) {
+            for (size_t w = 0; w < n_words; ++w) {
+                e->data[w] &= s[w] ^ flip;
+            }
+        }
+        else {
+            for (size_t w = 0; w < n_words; ++w) {
+                g->data[w] |= e->data[w] & (s[w] ^ flip);
+                e->data[w] &= ~(s[w] ^ flip);
+            }
+            taken = count;
+        }
+    }
+
+    /* The rows left in e share one value; keep the lowest ones. */
+    size_t need = k - taken;
+    for (size_t w = 0; w < n_words && need; ++w) {
+        uint64_t word = e->data[w];
+        const size_t c = cbits_popcount64(word);
+        if (c > need) {
+            const unsigned pos = bv__select_in_word(word, (unsigned) need);
+            word &= (1ULL << pos) - 1;
+        }
+        g->data[w] |= word;
+        need -= c < need ? c : need;
+    }
+    bv_free(e);
+    return g;
+}
+
+size_t
+bsi_memory_usage(const BitSlicedIndex *bsi)
+{
+    if (!bsi) {
+        return 0;
+    }
+    const BitVector *bv = bsi->exists;
+    const size_t n_super =
+        (bv->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+    const size_t per_vector = sizeof(BitVector) +
+                              (bv->n_words + 1) * sizeof(uint64_t) +
+                              n_super * sizeof(size_t) +
+                              bv->n_words * sizeof(uint16_t);
+    return sizeof(BitSlicedIndex) + (bsi->n_slices + 1) * per_vector;
+}
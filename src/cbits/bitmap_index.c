@@ -0,0 +1,655 @@
+/**
+ * @file src/cbits/bitmap_index.c
+ * @brief Bitmap index storage, query planning and chunked evaluation.
+ *
+ * This module implements:
+ * - \ref bmi_new, \ref bmi_free, \ref bmi_add, \ref bmi_set,
+ *   \ref bmi_remove
+ * - the planner that turns a @ref BMIQuery tree into a tree of flattened
+ *   AND/OR nodes with ordered operands
+ * - \ref bmi_query and \ref bmi_query_count
+ *
+ * The evaluator produces the result one chunk of @ref BMI_CHUNK_WORDS words
+ * at a time. Every node returns either a pointer into a stored vector (for
+ * leaves, without copying), a pointer to the scratch buffer of its depth,
+ * or NULL for an all-zero chunk, which lets the parents skip work.
+ *
+ * @see bitmap_index.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitmap_index.h"
+#include "bitvector_internal.h"
+
+#include <string.h>
+
+/**
+ * @brief Growable array of plan nodes.
+ */
+typedef struct {
+    struct bmi__node **items; /**< Node pointers. */
+    size_t n;                 /**< Number of nodes. */
+    size_t cap;               /**< Allocated entries. */
+} bmi__list;
+
+/**
+ * @brief Node of a query plan.
+ *
+ * Only @ref BMI_KEY, @ref BMI_AND and @ref BMI_OR appear in a plan. An AND
+ * intersects @c pos and removes every node of @c neg; an AND without
+ * positive operands starts from all bits set.
+ */
+typedef struct bmi__node {
+    BMIOp op;              /**< Node type. */
+    const BMIEntry *entry; /**< Stored vector of a leaf. */
+    size_t estimate;       /**< Upper bound on the result's popcount. */
+    bmi__list pos;         /**< Operands (AND, OR). */
+    bmi__list neg;         /**< Negated operands (AND only). */
+} bmi__node;
+
+/**
+ * @brief Evaluation state shared by all nodes of one query.
+ */
+typedef struct {
+    uint64_t *scratch; /**< One chunk buffer per plan depth. */
+    size_t chunk;      /**< Current chunk. */
+    size_t m;          /**< Words in the current chunk. */
+    uint64_t tail;     /**< Valid bits of the chunk's last word. */
+} bmi__ctx;
+
+/* Storage */
+
+/**
+ * @brief Test whether any of @p m words is non-zero.
+ * @param w Words.
+ * @param m Word count.
+ * @return @c true if a bit is set.
+ */
+static inline bool
+bmi__any(const uint64_t *w, size_t m)
+{
+    uint64_t any = 0;
+    for (size_t i = 0; i < m; ++i) {
+        any |= w[i];
+    }
+    return any != 0;
+}
+
+/**
+ * @brief Fill an entry with a copy of a vector and its statistics.
+ * @param bmi Pointer to the index.
+ * @param entry Entry to fill.
+ * @param bv Source vector of @c n_bits bits.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure; @p entry is untouched.
+ */
+static int
+bmi__entry_init(const BitmapIndex *bmi, BMIEntry *entry, const BitVector *bv)
+{
+    BitVector *copy = bv_copy(bv);
+    uint64_t *nonempty =
+        cbits_calloc((bmi->n_chunks + 63) / 64 + 1, sizeof(uint64_t));
+    if (!copy || !nonempty) {
+        bv_free(copy);
+        cbits_free(nonempty);
+        return -1;
+    }
+    const size_t n_words = copy->n_words;
+    for (size_t c = 0; c < bmi->n_chunks; ++c) {
+        const uint64_t *w = copy->data + c * BMI_CHUNK_WORDS;
+        const size_t m = n_words - c * BMI_CHUNK_WORDS < BMI_CHUNK_WORDS
+                             ? n_words - c * BMI_CHUNK_WORDS
+                             : BMI_CHUNK_WORDS;
+        nonempty[c >> 6] |= (uint64_t) bmi__any(w, m) << (c & 63);
+    }
+    entry->bv = copy;
+    entry->count = n_words ? cbits_popcount_words(copy->data, n_words) : 0;
+    entry->nonempty = nonempty;
+    return 0;
+}
+
+/**
+ * @brief Release the memory of an entry.
+ * @param entry Entry to clear.
+ */
+static void
+bmi__entry_clear(BMIEntry *entry)
+{
+    bv_free(entry->bv);
+    cbits_free(entry->nonempty);
+    entry->bv = NULL;
+    entry->nonempty = NULL;
+}
+
+BitmapIndex *
+bmi_new(size_t n_bits)
+{
+    BitmapIndex *bmi = cbits_calloc(1, sizeof(BitmapIndex));
+    if (!bmi) {
+        return NULL;
+    }
+    const size_t n_words = (n_bits + 63) >> 6;
+    bmi->n_bits = n_bits;
+    bmi->n_chunks = (n_words + BMI_CHUNK_WORDS - 1) / BMI_CHUNK_WORDS;
+    return bmi;
+}
+
+void
+bmi_free(BitmapIndex *bmi)
+{
+    if (!bmi) {
+        return;
+    }
+    for (size_t i = 0; i < bmi->size; ++i) {
+        bmi__entry_clear(&bmi->entries[i]);
+    }
+    cbits_free(bmi->entries);
+    cbits_free(bmi);
+}
+
+size_t
+bmi_add(BitmapIndex *bmi, const BitVector *bv)
+{
+    if (bv->n_bits != bmi->n_bits) {
+        return SIZE_MAX;
+    }
+    if (bmi->size == bmi->capacity) {
+        const size_t cap = bmi->capacity ? bmi->capacity * 2 : 8;
+        BMIEntry *entries =
+            cbits_realloc(bmi->entries, cap * sizeof(BMIEntry));
+        if (!entries) {
+            return SIZE_MAX;
+        }
+        bmi->entries = entries;
+        bmi->capacity = cap;
+    }
+    if (bmi__entry_init(bmi, &bmi->entries[bmi->size], bv) < 0) {
+        return SIZE_MAX;
+    }
+    return bmi->size++;
+}
+
+int
+bmi_set(BitmapIndex *bmi, size_t index, const BitVector *bv)
+{
+    if (index >= bmi->size || bv->n_bits != bmi->n_bits) {
+        return -1;
+    }
+    BMIEntry entry;
+    if (bmi__entry_init(bmi, &entry, bv) < 0) {
+        return -1;
+    }
+    bmi__entry_clear(&bmi->entries[index]);
+    bmi->entries[index] = entry;
+    return 0;
+}
+
+void
+bmi_remove(BitmapIndex *bmi, size_t index)
+{
+    if (index >= bmi->size) {
+        return;
+    }
+    bmi__entry_clear(&bmi->entries[index]);
+    bmi->entries[index] = bmi->entries[--bmi->size];
+}
+
+size_t
+bmi_memory_usage(const BitmapIndex *bmi)
+{
+    if (!bmi) {
+        return 0;
+    }
+    const size_t n_words = (bmi->n_bits + 63) >> 6;
+    const size_t n_super =
+        (n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+    const size_t per_vector =
+        sizeof(BitVector) + (n_words + 1) * sizeof(uint64_t) +
+        n_super * sizeof(size_t) + n_words * sizeof(uint16_t) +
+        ((bmi->n_chunks + 63) / 64 + 1) * sizeof(uint64_t);
+    return sizeof(BitmapIndex) + bmi->capacity * sizeof(BMIEntry) +
+           bmi->size * per_vector;
+}
+
+/* Planner */
+
+/**
+ * @brief Append a node to a list.
+ * @param list Destination list.
+ * @param node Node to append.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure; @p node is not owned by the list.
+ */
+static int
+bmi__push(bmi__list *list, bmi__node *node)
+{
+    if (list->n == list->cap) {
+        const size_t cap = list->cap ? list->cap * 2 : 4;
+        bmi__node **items =
+            cbits_realloc(list->items, cap * sizeof(bmi__node *));
+        if (!items) {
+            return -1;
+        }
+        list->items = items;
+        list->cap = cap;
+    }
+    list->items[list->n++] = node;
+    return 0;
+}
+
+/**
+ * @brief Allocate an empty plan node.
+ * @param op Node type.
+ * @return New node, or NULL on allocation failure.
+ */
+static bmi__node *
+bmi__node_new(BMIOp op)
+{
+    bmi__node *node = cbits_calloc(1, sizeof(bmi__node));
+    if (node) {
+        node->op = op;
+    }
+    return node;
+}
+
+/**
+ * @brief Free a node without its operands.
+ * @param node Node to free.
+ */
+static void
+bmi__node_free_shell(bmi__node *node)
+{
+    cbits_free(node->pos.items);
+    cbits_free(node->neg.items);
+    cbits_free(node);
+}
+
+/**
+ * @brief Free a plan tree.
+ * @param node Root (may be NULL).
+ */
+static void
+bmi__node_free(bmi__node *node)
+{
+    if (!node) {
+        return;
+    }
+    for (size_t i = 0; i < node->pos.n; ++i) {
+        bmi__node_free(node->pos.items[i]);
+    }
+    for (size_t i = 0; i < node->neg.n; ++i) {
+        bmi__node_free(node->neg.items[i]);
+    }
+    bmi__node_free_shell(node);
+}
+
+/**
+ * @brief Whether a node is the plain complement of a single operand.
+ * @param node Plan node.
+ * @return @c true for an AND with no positive and one negated operand.
+ */
+static inline bool
+bmi__is_complement(const bmi__node *node)
+{
+    return node->op == BMI_AND && node->pos.n == 0 && node->neg.n == 1;
+}
+
+/**
+ * @brief Add an operand to an AND node, flattening where possible.
+ *
+ * A positive AND operand is merged into @p dst; a negated complement adds
+ * its operand as a positive one. Takes ownership of @p node.
+ * @param dst AND node being built.
+ * @param node Compiled operand.
+ * @param negated Whether the operand is negated.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure; @p node has been freed.
+ */
+static int
+bmi__and_add(bmi__node *dst, bmi__node *node, bool negated)
+{
+    if (negated && bmi__is_complement(node)) {
+        bmi__node *inner = node->neg.items[0];
+        bmi__node_free_shell(node);
+        return bmi__and_add(dst, inner, false);
+    }
+    if (negated || node->op != BMI_AND) {
+        if (bmi__push(negated ? &dst->neg : &dst->pos, node) < 0) {
+            bmi__node_free(node);
+            return -1;
+        }
+        return 0;
+    }
+    /* Merge a nested AND; on failure the operands not moved are freed. */
+    int rc = 0;
+    for (size_t i = 0; i < node->pos.n; ++i) {
+        if (rc == 0 && bmi__push(&dst->pos, node->pos.items[i]) < 0) {
+            rc = -1;
+        }
+        if (rc < 0) {
+            bmi__node_free(node->pos.items[i]);
+        }
+    }
+    for (size_t i = 0; i < node->neg.n; ++i) {
+        if (rc == 0 && bmi__push(&dst->neg, node->neg.items[i]) < 0) {
+            rc = -1;
+        }
+        if (rc < 0) {
+            bmi__node_free(node->neg.items[i]);
+        }
+    }
+    bmi__node_free_shell(node);
+    return rc;
+}
+
+/**
+ * @brief Add an operand to an OR node, flattening nested ORs.
+ *
+ * Takes ownership of @p node.
+ * @param dst OR node being built.
+ * @param node Compiled operand.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure; @p node has been freed.
+ */
+static int
+bmi__or_add(bmi__node *dst, bmi__node *node)
+{
+    if (node->op != BMI_OR) {
+        if (bmi__push(&dst->pos, node) < 0) {
+            bmi__node_free(node);
+            return -1;
+        }
+        return 0;
+    }
+    int rc = 0;
+    for (size_t i = 0; i < node->pos.n; ++i) {
+        if (rc == 0 && bmi__push(&dst->pos, node->pos.items[i]) < 0) {
+            rc = -1;
+        }
+        if (rc < 0) {
+            bmi__node_free(node->pos.items[i]);
+        }
+    }
+    bmi__node_free_shell(node);
+    return rc;
+}
+
+/**
+ * @brief Compile a query tree into a plan.
+ * @param bmi Pointer to the index.
+ * @param q Query node.
+ * @return Plan root, or NULL for a malformed query or allocation failure.
+ */
+static bmi__node *
+bmi__compile(const BitmapIndex *bmi, const BMIQuery *q)
+{
+    if (q->op == BMI_KEY) {
+        if (q->vector >= bmi->size) {
+            return NULL;
+        }
+        bmi__node *leaf = bmi__node_new(BMI_KEY);
+        if (leaf) {
+            leaf->entry = &bmi->entries[q->vector];
+        }
+        return leaf;
+    }
+    if (q->n_children == 0 || (q->op == BMI_NOT && q->n_children != 1)) {
+        return NULL;
+    }
+    bmi__node *node = bmi__node_new(q->op == BMI_OR ? BMI_OR : BMI_AND);
+    if (!node) {
+        return NULL;
+    }
+    for (size_t i = 0; i < q->n_children; ++i) {
+        bmi__node *child = bmi__compile(bmi, &q->children[i]);
+        if (!child) {
+            bmi__node_free(node);
+            return NULL;
+        }
+        const bool negated =
+            q->op == BMI_NOT || (q->op == BMI_ANDNOT && i > 0);
+        const int rc = q->op == BMI_OR ? bmi__or_add(node, child)
+                                       : bmi__and_add(node, child, negated);
+        if (rc < 0) {
+            bmi__node_free(node);
+            return NULL;
+        }
+    }
+    if (node->pos.n == 1 && node->neg.n == 0) {
+        bmi__node *only = node->pos.items[0];
+        bmi__node_free_shell(node);
+        return only;
+    }
+    return node;
+}
+
+/** @brief qsort comparator: increasing estimate. */
+static int
+bmi__by_estimate(const void *a, const void *b)
+{
+    const size_t x = (*(bmi__node *const *) a)->estimate;
+    const size_t y = (*(bmi__node *const *) b)->estimate;
+    return (x > y) - (x < y);
+}
+
+/** @brief qsort comparator: decreasing estimate. */
+static int
+bmi__by_estimate_desc(const void *a, const void *b)
+{
+    return bmi__by_estimate(b, a);
+}
+
+/**
+ * @brief Estimate cardinalities bottom-up and order the operands.
+ * @param node Plan node.
+ * @param n_bits Vector length.
+ * @return Height of the subtree (0 for a leaf).
+ */
+static size_t
+bmi__plan(bmi__node *node, size_t n_bits)
+{
+    if (node->op == BMI_KEY) {
+        node->estimate = node->entry->count;
+        return 0;
+    }
+    size_t height = 0;
+    size_t pos_min = n_bits, pos_sum = 0, neg_max = 0;
+    for (size_t i = 0; i < node->pos.n; ++i) {
+        bmi__node *child = node->pos.items[i];
+        size_t h = bmi__plan(child, n_bits);
+        height = h > height ? h : height;
+        pos_min = child->estimate < pos_min ? child->estimate : pos_min;
+        pos_sum = pos_sum + child->estimate < n_bits
+                      ? pos_sum + child->estimate
+                      : n_bits;
+    }
+    for (size_t i = 0; i < node->neg.n; ++i) {
+        bmi__node *child = node->neg.items[i];
+        size_t h = bmi__plan(child, n_bits);
+        height = h > height ? h : height;
+        neg_max = child->estimate > neg_max ? child->estimate : neg_max;
+    }
+    if (node->op == BMI_OR) {
+        node->estimate = pos_sum;
+    }
+    else {
+        node->estimate = node->pos.n ? pos_min : n_bits - neg_max;
+        if (node->pos.n > 1) {
+            qsort(node->pos.items, node->pos.n, sizeof(bmi__node *),
+                  bmi__by_estimate);
+        }
+        if (node->neg.n > 1) {
+            qsort(node->neg.items, node->neg.n, sizeof(bmi__node *),
+                  bmi__by_estimate_desc);
+        }
+    }
+    return height + 1;
+}
+
+/* Evaluation */
+
+/**
+ * @brief Evaluate one chunk of a plan node.
+ * @param ctx Evaluation state.
+ * @param node Plan node.
+ * @param depth Depth of @p node; selects its scratch buffer.
+ * @return The chunk's words (a stored vector or the scratch buffer of
+ *         @p depth), or NULL if the chunk is all zero.
+ */
+static const uint64_t *
+bmi__eval(const bmi__ctx *ctx, const bmi__node *node, size_t depth)
+{
+    const size_t c = ctx->chunk;
+    if (node->op == BMI_KEY) {
+        if (!((node->entry->nonempty[c >> 6] >> (c & 63)) & 1)) {
+            return NULL;
+        }
+        return node->entry->bv->data + c * BMI_CHUNK_WORDS;
+    }
+    const size_t m = ctx->m;
+    uint64_t *buf = ctx->scratch + depth * BMI_CHUNK_WORDS;
+    uint64_t *child_buf = buf + BMI_CHUNK_WORDS;
+    const uint64_t *acc = NULL;
+
+    if (node->op == BMI_OR) {
+        for (size_t i = 0; i < node->pos.n; ++i) {
+            const uint64_t *q = bmi__eval(ctx, node->pos.items[i], depth + 1);
+            if (!q) {
+                continue;
+            }
+            if (!acc) {
+                /* The next operand reuses child_buf, so keep a copy. */
+                if (q == child_buf) {
+                    memcpy(buf, q, m * sizeof(uint64_t));
+                    q = buf;
+                }
+                acc = q;
+                continue;
+            }
+            cbits_bitwise_words(buf, acc, q, m, CBITS_BITWISE_OR);
+            acc = buf;
+        }
+        return acc;
+    }
+
+    if (node->pos.n) {
+        acc = bmi__eval(ctx, node->pos.items[0], depth + 1);
+        if (!acc) {
+            return NULL;
+        }
+        if (acc == child_buf) {
+            memcpy(buf, acc, m * sizeof(uint64_t));
+            acc = buf;
+        }
+    }
+    else {
+        for (size_t w = 0; w < m; ++w) {
+            buf[w] = ~0ULL;
+        }
+        buf[m - 1] &= ctx->tail;
+        acc = buf;
+    }
+    for (size_t i = 1; i < node->pos.n; ++i) {
+        const uint64_t *q = bmi__eval(ctx, node->pos.items[i], depth + 1);
+        if (!q) {
+            return NULL;
+        }
+        cbits_bitwise_words(buf, acc, q, m, CBITS_BITWISE_AND);
+        if (!bmi__any(buf, m)) {
+            return NULL;
+        }
+        acc = buf;
+    }
+    for (size_t i = 0; i < node->neg.n; ++i) {
+        const uint64_t *q = bmi__eval(ctx, node->neg.items[i], depth + 1);
+        if (!q) {
+            continue;
+        }
+        /* The children are done with child_buf; complement q into it. */
+        cbits_bitwise_words(child_buf, q, NULL, m, CBITS_BITWISE_NOT);
+        cbits_bitwise_words(buf, acc, child_buf, m, CBITS_BITWISE_AND);
+        if (!bmi__any(buf, m)) {
+            return NULL;
+        }
+        acc = buf;
+    }
+    return acc;
+}
+
+/**
+ * @brief Plan and evaluate a query, storing or counting the result.
+ * @param bmi Pointer to the index.
+ * @param query Root of the query.
+ * @param out Result vector of @c n_bits zero bits, or NULL to count.
+ * @param count Receives the number of matching bits if @p out is NULL.
+ * @retval 0 Success.
+ * @retval -1 Malformed query or allocation failure.
+ */
+static int
+bmi__run(const BitmapIndex *bmi, const BMIQuery *query, BitVector *out,
+         size_t *count)
+{
+    bmi__node *root = bmi__compile(bmi, query);
+    if (!root) {
+        return -1;
+    }
+    const size_t height = bmi__plan(root, bmi->n_bits);
+    bmi__ctx ctx;
+    const size_t scratch_bytes =
+        (height + 1) * BMI_CHUNK_WORDS * sizeof(uint64_t);
+    ctx.scratch = cbits_malloc_aligned(scratch_bytes, BV_ALIGN);
+    if (!ctx.scratch) {
+        bmi__node_free(root);
+        return -1;
+    }
+    const size_t n_words = (bmi->n_bits + 63) >> 6;
+    const unsigned tail_bits = (unsigned) (bmi->n_bits & 63);
+    size_t total = 0;
+    for (size_t c = 0; c < bmi->n_chunks; ++c) {
+        const size_t start = c * BMI_CHUNK_WORDS;
+        ctx.chunk = c;
+        ctx.m = n_words - start < BMI_CHUNK_WORDS ? n_words - start
+                                                  : BMI_CHUNK_WORDS;
+        ctx.tail = c + 1 == bmi->n_chunks && tail_bits
+                       ? (1ULL << tail_bits) - 1
+                       : ~0ULL;
+        const uint64_t *r = bmi__eval(&ctx, root, 0);
+        if (!r) {
+            continue;
+        }
+        if (out) {
+            memcpy(out->data + start, r, ctx.m * sizeof(uint64_t));
+        }
+        else {
+            total += cbits_popcount_words(r, ctx.m);
+        }
+    }
+    cbits_free_aligned(ctx.scratch, scratch_bytes);
+    bmi__node_free(root);
+    if (count) {
+        *count = total;
+    }
+    return 0;
+}
+
+BitVector *
+bmi_query(const BitmapIndex *bmi, const BMIQuery *query)
+{
+    BitVector *out = bv_new(bmi->n_bits);
+    if (!out) {
+        return NULL;
+    }
+    if (bmi__run(bmi, query, out, NULL) < 0) {
+        bv_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+int
+bmi_query_count(const BitmapIndex *bmi, const BMIQuery *query,
+                size_t *count)
+{
+    return bmi__run(bmi, query, NULL, count);
+}
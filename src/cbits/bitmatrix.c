@@ -0,0 +1,408 @@
+/**
+ * @file src/cbits/bitmatrix.c
+ * @brief BitMatrix storage, row views, transpose and reductions.
+ *
+ * This module implements:
+ * - \ref bm_new, \ref bm_copy, \ref bm_free
+ * - element access and row operations
+ * - the 64x64 tile transpose (\ref bm_transpose64) and \ref bm_transpose
+ * - row and column counts and reductions
+ *
+ * Rows are padded to a whole number of cache lines, so every row can be fed
+ * to @ref cbits_popcount_block and to the BitVector rank builder without a
+ * scalar tail loop, and a row header only needs its @c data pointer aimed
+ * into the matrix to behave like a standalone BitVector.
+ *
+ * @see bitmatrix.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitmatrix.h"
+#include "bitvector_internal.h"
+
+#include <string.h>
+
+/**
+ * @brief Mask of the valid bits in the last word of a row.
+ * @param n_cols Bits per row (non-zero).
+ * @return Word mask.
+ */
+static inline uint64_t
+bm_tail_mask(size_t n_cols)
+{
+    const size_t tail = bv_bit(n_cols);
+    return tail ? (1ULL << tail) - 1 : ~0ULL;
+}
+
+/**
+ * @brief Bitwise kernel operator of a matrix operator.
+ * @param op Matrix operator.
+ * @return Matching @ref cbits_bitwise_op.
+ */
+static inline cbits_bitwise_op
+bm_bitwise_op(BMOp op)
+{
+    switch (op) {
+        case BM_AND:
+            return CBITS_BITWISE_AND;
+        case BM_OR:
+            return CBITS_BITWISE_OR;
+        default:
+            return CBITS_BITWISE_XOR;
+    }
+}
+
+BitMatrix *
+bm_new(size_t n_rows, size_t n_cols)
+{
+    BitMatrix *m = cbits_calloc(1, sizeof(BitMatrix));
+    if (!m) {
+        return NULL;
+    }
+    m->n_rows = n_rows;
+    m->n_cols = n_cols;
+    m->row_words = (n_cols + 63) >> 6;
+    m->stride = (m->row_words + BM_STRIDE_WORDS - 1) & ~(BM_STRIDE_WORDS - 1);
+
+    if (m->stride && n_rows > SIZE_MAX / sizeof(uint64_t) / m->stride) {
+        cbits_free(m);
+        return NULL;
+    }
+    const size_t total = n_rows * m->stride;
+    if (total) {
+        m->data = cbits_malloc_aligned(total * sizeof(uint64_t), BV_ALIGN);
+        if (!m->data) {
+            cbits_free(m);
+            return NULL;
+        }
+        memset(m->data, 0, total * sizeof(uint64_t));
+    }
+    m->rows = cbits_calloc(n_rows ? n_rows : 1, sizeof(BitVector));
+    if (!m->rows) {
+        bm_free(m);
+        return NULL;
+    }
+    for (size_t r = 0; r < n_rows; ++r) {
+        BitVector *row = &m->rows[r];
+        row->data = m->data ? bm_row(m, r) : NULL;
+        row->n_bits = n_cols;
+        row->n_words = m->row_words;
+        row->rank_dirty = true;
+    }
+    return m;
+}
+
+BitMatrix *
+bm_copy(const BitMatrix *src)
+{
+    BitMatrix *dst = bm_new(src->n_rows, src->n_cols);
+    if (!dst) {
+        return NULL;
+    }
+    if (dst->data) {
+        memcpy(dst->data, src->data,
+               src->n_rows * src->stride * sizeof(uint64_t));
+    }
+    return dst;
+}
+
+void
+bm_free(BitMatrix *m)
+{
+    if (!m) {
+        return;
+    }
+    if (m->rows) {
+        const size_t n_super =
+            (m->row_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+        for (size_t r = 0; r < m->n_rows; ++r) {
+            cbits_free_aligned(m->rows[r].super_rank,
+                               n_super * sizeof(size_t));
+            cbits_free_aligned(m->rows[r].block_rank,
+                               m->row_words * sizeof(uint16_t));
+        }
+        cbits_free(m->rows);
+    }
+    cbits_free_aligned(m->data, m->n_rows * m->stride * sizeof(uint64_t));
+    cbits_free(m);
+}
+
+int
+bm_get(const BitMatrix *m, size_t r, size_t c)
+{
+    if (r >= m->n_rows || c >= m->n_cols) {
+        return -1;
+    }
+    return (bm_row(m, r)[bv_word(c)] >> bv_bit(c)) & 1;
+}
+
+void
+bm_set(BitMatrix *m, size_t r, size_t c)
+{
+    if (r >= m->n_rows || c >= m->n_cols) {
+        return;
+    }
+    bv__set_inline(&m->rows[r], c);
+}
+
+void
+bm_clear(BitMatrix *m, size_t r, size_t c)
+{
+    if (r >= m->n_rows || c >= m->n_cols) {
+        return;
+    }
+    bv__clear_inline(&m->rows[r], c);
+}
+
+BitVector *
+bm_row_view(BitMatrix *m, size_t r)
+{
+    if (r >= m->n_rows) {
+        return NULL;
+    }
+    BitVector *row = &m->rows[r];
+    if (row->n_words && !row->super_rank) {
+        const size_t n_super =
+            (row->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+        size_t *super_rank =
+            cbits_malloc_aligned(n_super * sizeof(size_t), BV_ALIGN);
+        uint16_t *block_rank =
+            cbits_malloc_aligned(row->n_words * sizeof(uint16_t), BV_ALIGN);
+        if (!super_rank || !block_rank) {
+            cbits_free_aligned(super_rank, n_super * sizeof(size_t));
+            cbits_free_aligned(block_rank, row->n_words * sizeof(uint16_t));
+            return NULL;
+        }
+        row->super_rank = super_rank;
+        row->block_rank = block_rank;
+        row->rank_dirty = true;
+    }
+    return row;
+}
+
+int
+bm_set_row(BitMatrix *m, size_t r, const BitVector *bv)
+{
+    if (r >= m->n_rows || bv->n_bits != m->n_cols) {
+        return -1;
+    }
+    if (m->row_words) {
+        memmove(bm_row(m, r), bv->data, m->row_words * sizeof(uint64_t));
+    }
+    m->rows[r].rank_dirty = true;
+    return 0;
+}
+
+int
+bm_row_op(BitMatrix *m, size_t dst, size_t src, BMOp op)
+{
+    if (dst >= m->n_rows || src >= m->n_rows) {
+        return -1;
+    }
+    uint64_t *d = bm_row(m, dst);
+    if (m->row_words) {
+        cbits_bitwise_words(d, d, bm_row(m, src), m->row_words,
+                            bm_bitwise_op(op));
+    }
+    m->rows[dst].rank_dirty = true;
+    return 0;
+}
+
+BitVector *
+bm_column(const BitMatrix *m, size_t c)
+{
+    if (c >= m->n_cols) {
+        return NULL;
+    }
+    BitVector *out = bv_new(m->n_rows);
+    if (!out) {
+        return NULL;
+    }
+    const size_t w = bv_word(c);
+    const unsigned b = (unsigned) bv_bit(c);
+    for (size_t base = 0; base < m->n_rows; base += 64) {
+        const size_t end = base + 64 < m->n_rows ? base + 64 : m->n_rows;
+        const uint64_t *row = bm_row(m, base) + w;
+        uint64_t word = 0;
+        for (size_t r = base; r < end; ++r, row += m->stride) {
+            word |= ((*row >> b) & 1ULL) << (r - base);
+        }
+        out->data[base >> 6] = word;
+    }
+    return out;
+}
+
+void
+bm_transpose64(uint64_t tile[64])
+{
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (unsigned j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for (unsigned k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            const uint64_t t = ((tile[k] >> j) ^ tile[k | j]) & mask;
+            tile[k] ^= t << j;
+            tile[k | j] ^= t;
+        }
+    }
+}
+
+/**
+ * @brief Load the 64x64 tile at row block @p rb and column word @p cw.
+ *
+ * Rows past the end of the matrix load as zero.
+ * @param m Source matrix.
+ * @param rb First row of the tile (multiple of 64).
+ * @param cw Column word index.
+ * @param tile Destination words.
+ */
+static inline void
+bm_load_tile(const BitMatrix *m, size_t rb, size_t cw, uint64_t tile[64])
+{
+    const size_t n = m->n_rows - rb < 64 ? m->n_rows - rb : 64;
+    const uint64_t *src = bm_row(m, rb) + cw;
+    for (size_t i = 0; i < n; ++i, src += m->stride) {
+        tile[i] = *src;
+    }
+    for (size_t i = n; i < 64; ++i) {
+        tile[i] = 0;
+    }
+}
+
+BitMatrix *
+bm_transpose(const BitMatrix *m)
+{
+    BitMatrix *t = bm_new(m->n_cols, m->n_rows);
+    if (!t) {
+        return NULL;
+    }
+    uint64_t tile[64];
+    for (size_t rb = 0; rb < m->n_rows; rb += 64) {
+        for (size_t cw = 0; cw < m->row_words; ++cw) {
+            bm_load_tile(m, rb, cw, tile);
+            bm_transpose64(tile);
+
+            const size_t c0 = cw << 6;
+            const size_t n =
+                m->n_cols - c0 < 64 ? m->n_cols - c0 : (size_t) 64;
+            uint64_t *dst = bm_row(t, c0) + (rb >> 6);
+            for (size_t j = 0; j < n; ++j, dst += t->stride) {
+                *dst = tile[j];
+            }
+        }
+    }
+    return t;
+}
+
+void
+bm_row_popcount(const BitMatrix *m, size_t *out)
+{
+    for (size_t r = 0; r < m->n_rows; ++r) {
+        const uint64_t *row = bm_row(m, r);
+        size_t count = 0;
+        for (size_t w = 0; w < m->stride; w += BM_STRIDE_WORDS) {
+            count += cbits_popcount_block(row + w);
+        }
+        out[r] = count;
+    }
+}
+
+void
+bm_col_popcount(const BitMatrix *m, size_t *out)
+{
+    memset(out, 0, m->n_cols * sizeof(size_t));
+    uint64_t tile[64];
+    for (size_t rb = 0; rb < m->n_rows; rb += 64) {
+        for (size_t cw = 0; cw < m->row_words; ++cw) {
+            bm_load_tile(m, rb, cw, tile);
+            bm_transpose64(tile);
+
+            const size_t c0 = cw << 6;
+            const size_t n =
+                m->n_cols - c0 < 64 ? m->n_cols - c0 : (size_t) 64;
+            for (size_t j = 0; j < n; ++j) {
+                out[c0 + j] += cbits_popcount64(tile[j]);
+            }
+        }
+    }
+}
+
+BitVector *
+bm_reduce_rows(const BitMatrix *m, BMOp op)
+{
+    BitVector *out = bv_new(m->n_cols);
+    if (!out || !m->n_cols) {
+        return out;
+    }
+    uint64_t *acc = out->data;
+    const size_t n = m->row_words;
+    if (op == BM_AND) {
+        memset(acc, 0xFF, n * sizeof(uint64_t));
+        acc[n - 1] = bm_tail_mask(m->n_cols);
+    }
+    const cbits_bitwise_op bop = bm_bitwise_op(op);
+    for (size_t r = 0; r < m->n_rows; ++r) {
+        cbits_bitwise_words(acc, acc, bm_row(m, r), n, bop);
+    }
+    return out;
+}
+
+BitVector *
+bm_reduce_cols(const BitMatrix *m, BMOp op)
+{
+    BitVector *out = bv_new(m->n_rows);
+    if (!out) {
+        return NULL;
+    }
+    for (size_t r = 0; r < m->n_rows; ++r) {
+        const uint64_t *row = bm_row(m, r);
+        size_t count = 0;
+        for (size_t w = 0; w < m->stride; w += BM_STRIDE_WORDS) {
+            count += cbits_popcount_block(row + w);
+        }
+        bool bit;
+        switch (op) {
+            case BM_AND:
+                bit = count == m->n_cols;
+                break;
+            case BM_OR:
+                bit = count != 0;
+                break;
+            default:
+                bit = count & 1;
+                break;
+        }
+        if (bit) {
+            bv__set_inline(out, r);
+        }
+    }
+    return out;
+}
+
+bool
+bm_equal(const BitMatrix *a, const BitMatrix *b)
+{
+    if (a->n_rows != b->n_rows || a->n_cols != b->n_cols) {
+        return false;
+    }
+    if (!a->data) {
+        return true;
+    }
+    return memcmp(a->data, b->data,
+                  a->n_rows * a->stride * sizeof(uint64_t)) == 0;
+}
+
+size_t
+bm_memory_usage(const BitMatrix *m)
+{
+    size_t total = sizeof(BitMatrix) + m->n_rows * sizeof(BitVector) +
+                   m->n_rows * m->stride * sizeof(uint64_t);
+    const size_t n_super =
+        (m->row_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+    for (size_t r = 0; r < m->n_rows; ++r) {
+        if (m->rows[r].super_rank) {
+            total += n_super * sizeof(size_t) +
+                     m->row_words * sizeof(uint16_t);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,503 @@
+/**
+ * @file src/cbits/bitvector_collection.c
+ * @brief Packed BitVector collection and Hamming similarity search.
+ *
+ * This module implements:
+ * - \ref bvc_new, \ref bvc_free, \ref bvc_reserve, \ref bvc_append
+ * - \ref bvc_get, \ref bvc_memory_usage
+ * - \ref bvc_distances, \ref bvc_knn, \ref bvc_within_radius
+ * - \ref bvc_pairwise
+ *
+ * Every search walks its part of the collection in batches of
+ * @ref BVC_BATCH rows: one \ref cbits_hamming_batch call fills a small
+ * distance buffer on the stack, which is then filtered. k-NN keeps a
+ * bounded max-heap per part and merges the parts at the end; radius search
+ * collects the hits of every part in order and concatenates them.
+ *
+ * @see bitvector_collection.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitvector_collection.h"
+#include "bitvector_internal.h"
+#include "compat_thread.h"
+#include <string.h>
+
+/**
+ * @brief Number of parts a search over @p n rows is split into.
+ * @param n Number of rows.
+ * @param n_threads Requested thread count; @c 0 picks one per processor.
+ * @return Part count in <tt>[1, CBITS_MAX_THREADS]</tt>.
+ */
+static unsigned
+bvc_parts(size_t n, unsigned n_threads)
+{
+    if (n_threads == 0) {
+        n_threads = cbits_cpu_count();
+    }
+    if (n_threads > CBITS_MAX_THREADS) {
+        n_threads = CBITS_MAX_THREADS;
+    }
+    size_t limit = n / BVC_PARALLEL_MIN_ROWS;
+    if ((size_t) n_threads > limit) {
+        n_threads = (unsigned) limit;
+    }
+    return n_threads ? n_threads : 1;
+}
+
+BitVectorCollection *
+bvc_new(size_t n_bits)
+{
+    if (n_bits > UINT32_MAX) {
+        return NULL;
+    }
+    BitVectorCollection *c = cbits_calloc(1, sizeof(BitVectorCollection));
+    if (!c) {
+        return NULL;
+    }
+    c->n_bits = n_bits;
+    c->n_words = (n_bits + 63) >> 6;
+    /* Short rows share cache lines without straddling them; longer rows
+     * each start on their own line. */
+    c->stride = 1;
+    while (c->stride < c->n_words && c->stride < BV_WORDS_SUPER) {
+        c->stride <<= 1;
+    }
+    if (c->n_words > BV_WORDS_SUPER) {
+        c->stride = (c->n_words + BV_WORDS_SUPER - 1) &
+                    ~(size_t) (BV_WORDS_SUPER - 1);
+    }
+    return c;
+}
+
+/**
+ * @brief Size in bytes of an arena of @p capacity slots.
+ * @param c Collection giving the slot stride.
+ * @param capacity Number of slots.
+ * @return Bytes allocated for them, at least one cache line.
+ */
+static size_t
+bvc_arena_bytes(const BitVectorCollection *c, size_t capacity)
+{
+    const size_t bytes = capacity * c->stride * sizeof(uint64_t);
+    return bytes ? bytes : BV_ALIGN;
+}
+
+void
+bvc_free(BitVectorCollection *c)
+{
+    if (!c) {
+        return;
+    }
+    cbits_free_aligned(c->data, bvc_arena_bytes(c, c->capacity));
+    cbits_free(c);
+}
+
+int
+bvc_reserve(BitVectorCollection *c, size_t capacity)
+{
+    if (capacity <= c->capacity) {
+        return 0;
+    }
+    if (c->stride && capacity > SIZE_MAX / sizeof(uint64_t) / c->stride) {
+        return -1;
+    }
+    uint64_t *data =
+        cbits_malloc_aligned(bvc_arena_bytes(c, capacity), BV_ALIGN);
+    if (!data) {
+        return -1;
+    }
+    if (c->size) {
+        memcpy(data, c->data, c->size * c->stride * sizeof(uint64_t));
+    }
+    cbits_free_aligned(c->data, bvc_arena_bytes(c, c->capacity));
+    c->data = data;
+    c->capacity = capacity;
+    return 0;
+}
+
+int
+bvc_append(BitVectorCollection *c, const BitVector *bv)
+{
+    if (bv->n_bits != c->n_bits) {
+        return -1;
+    }
+    if (c->size == c->capacity &&
+        bvc_reserve(c, c->capacity ? c->capacity * 2 : 16) < 0) {
+        return -1;
+    }
+    uint64_t *row = c->data + c->size * c->stride;
+    memset(row, 0, c->stride * sizeof(uint64_t));
+    if (c->n_words) {
+        memcpy(row, bv->data, c->n_words * sizeof(uint64_t));
+    }
+    if (c->n_bits & 63) {
+        row[c->n_words - 1] &= (1ULL << (c->n_bits & 63)) - 1;
+    }
+    c->size++;
+    return 0;
+}
+
+BitVector *
+bvc_get(const BitVectorCollection *c, size_t i)
+{
+    BitVector *bv = bv_new(c->n_bits);
+    if (!bv) {
+        return NULL;
+    }
+    if (c->n_words) {
+        memcpy(bv->data, bvc_row(c, i), c->n_words * sizeof(uint64_t));
+    }
+    return bv;
+}
+
+size_t
+bvc_memory_usage(const BitVectorCollection *c)
+{
+    return sizeof(BitVectorCollection) +
+           c->capacity * c->stride * sizeof(uint64_t);
+}
+
+/**
+ * @brief Shared state of one parallel search.
+ */
+typedef struct {
+    const BitVectorCollection *c; /**< Searched collection. */
+    const uint64_t *query;        /**< Query words. */
+    size_t n_parts;               /**< Number of parts. */
+    size_t limit;                 /**< k for k-NN, radius otherwise. */
+    uint32_t *distances;          /**< Output of @ref bvc_distances. */
+    BVCMatch **hits;              /**< Per-part result buffers. */
+    size_t *n_hits;               /**< Per-part result counts. */
+    bool *failed;                 /**< Per-part allocation failures. */
+} bvc_search_ctx;
+
+/**
+ * @brief First row of a part.
+ * @param ctx Search state.
+ * @param part Part index, up to @c n_parts inclusive.
+ * @return Row index.
+ */
+static inline size_t
+bvc_part_start(const bvc_search_ctx *ctx, size_t part)
+{
+    return (size_t) ((unsigned long long) ctx->c->size * part /
+                     ctx->n_parts);
+}
+
+/**
+ * @brief Order two matches by distance, then by index.
+ * @param a First match.
+ * @param b Second match.
+ * @return @c true if @p a ranks before @p b.
+ */
+static inline bool
+bvc_before(const BVCMatch *a, const BVCMatch *b)
+{
+    return a->distance < b->distance ||
+           (a->distance == b->distance && a->index < b->index);
+}
+
+/**
+ * @brief @c qsort comparator for @ref bvc_before.
+ */
+static int
+bvc_match_cmp(const void *pa, const void *pb)
+{
+    const BVCMatch *a = pa, *b = pb;
+    return bvc_before(a, b) ? -1 : bvc_before(b, a);
+}
+
+/**
+ * @brief Restore the max-heap order below @p i.
+ * @param heap Heap whose root ranks last.
+ * @param n Heap size.
+ * @param i Index of the entry to sift down.
+ */
+static void
+bvc_sift_down(BVCMatch *heap, size_t n, size_t i)
+{
+    for (;;) {
+        size_t worst = i, l = 2 * i + 1, r = l + 1;
+        if (l < n && bvc_before(&heap[worst], &heap[l])) {
+            worst = l;
+        }
+        if (r < n && bvc_before(&heap[worst], &heap[r])) {
+            worst = r;
+        }
+        if (worst == i) {
+            return;
+        }
+        BVCMatch tmp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = tmp;
+        i = worst;
+    }
+}
+
+/**
+ * @brief Push a match into a bounded max-heap, dropping the worst entry.
+ * @param heap Heap of capacity @p k.
+ * @param n Current heap size, updated.
+ * @param k Heap capacity (at least 1).
+ * @param m Candidate match.
+ */
+static void
+bvc_heap_offer(BVCMatch *heap, size_t *n, size_t k, BVCMatch m)
+{
+    if (*n < k) {
+        size_t i = (*n)++;
+        heap[i] = m;
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!bvc_before(&heap[parent], &heap[i])) {
+                break;
+            }
+            BVCMatch tmp = heap[i];
+            heap[i] = heap[parent];
+            heap[parent] = tmp;
+            i = parent;
+        }
+        return;
+    }
+    if (bvc_before(&m, &heap[0])) {
+        heap[0] = m;
+        bvc_sift_down(heap, k, 0);
+    }
+}
+
+/**
+ * @brief Task: distances of one part.
+ * @param arg Pointer to a ::bvc_search_ctx.
+ * @param part Part index.
+ */
+static void
+bvc_distances_task(void *arg, size_t part)
+{
+    const bvc_search_ctx *ctx = arg;
+    const BitVectorCollection *c = ctx->c;
+    const size_t start = bvc_part_start(ctx, part);
+    const size_t stop = bvc_part_start(ctx, part + 1);
+    cbits_hamming_batch(ctx->query, bvc_row(c, start), c->stride, c->n_words,
+                        stop - start, ctx->distances + start);
+}
+
+void
+bvc_distances(const BitVectorCollection *c, const BitVector *query,
+              uint32_t *out, unsigned n_threads)
+{
+    if (c->size == 0) {
+        return;
+    }
+    bvc_search_ctx ctx = {c, query->data, bvc_parts(c->size, n_threads)};
+    ctx.distances = out;
+    cbits_parallel_for(ctx.n_parts, bvc_distances_task, &ctx,
+                       (unsigned) ctx.n_parts);
+}
+
+/**
+ * @brief Task: k nearest rows of one part.
+ * @param arg Pointer to a ::bvc_search_ctx.
+ * @param part Part index.
+ */
+static void
+bvc_knn_task(void *arg, size_t part)
+{
+    bvc_search_ctx *ctx = arg;
+    const BitVectorCollection *c = ctx->c;
+    const size_t k = ctx->limit;
+    BVCMatch *heap = ctx->hits[part];
+    size_t n = 0;
+    uint32_t dist[BVC_BATCH];
+
+    const size_t stop = bvc_part_start(ctx, part + 1);
+    for (size_t i = bvc_part_start(ctx, part); i < stop; i += BVC_BATCH) {
+        const size_t len = stop - i < BVC_BATCH ? stop - i : BVC_BATCH;
+        cbits_hamming_batch(ctx->query, bvc_row(c, i), c->stride, c->n_words,
+                            len, dist);
+        for (size_t j = 0; j < len; ++j) {
+            if (n == k && dist[j] > heap[0].distance) {
+                continue;
+            }
+            bvc_heap_offer(heap, &n, k, (BVCMatch) {i + j, dist[j]});
+        }
+    }
+    ctx->n_hits[part] = n;
+}
+
+size_t
+bvc_knn(const BitVectorCollection *c, const BitVector *query, size_t k,
+        BVCMatch *out, unsigned n_threads)
+{
+    if (k > c->size) {
+        k = c->size;
+    }
+    if (k == 0) {
+        return 0;
+    }
+    bvc_search_ctx ctx = {c, query->data, bvc_parts(c->size, n_threads), k};
+    BVCMatch *all = cbits_malloc(ctx.n_parts * k * sizeof(BVCMatch));
+    BVCMatch *hits[CBITS_MAX_THREADS];
+    size_t n_hits[CBITS_MAX_THREADS];
+    if (!all) {
+        return SIZE_MAX;
+    }
+    for (size_t p = 0; p < ctx.n_parts; ++p) {
+        hits[p] = all + p * k;
+    }
+    ctx.hits = hits;
+    ctx.n_hits = n_hits;
+    cbits_parallel_for(ctx.n_parts, bvc_knn_task, &ctx,
+                       (unsigned) ctx.n_parts);
+
+    /* Compact the part heaps, then sort the survivors. */
+    size_t total = 0;
+    for (size_t p = 0; p < ctx.n_parts; ++p) {
+        memmove(all + total, hits[p], n_hits[p] * sizeof(BVCMatch));
+        total += n_hits[p];
+    }
+    qsort(all, total, sizeof(BVCMatch), bvc_match_cmp);
+    memcpy(out, all, k * sizeof(BVCMatch));
+    cbits_free(all);
+    return k;
+}
+
+/**
+ * @brief Task: rows of one part within the radius, in index order.
+ * @param arg Pointer to a ::bvc_search_ctx.
+ * @param part Part index.
+ */
+static void
+bvc_radius_task(void *arg, size_t part)
+{
+    bvc_search_ctx *ctx = arg;
+    const BitVectorCollection *c = ctx->c;
+    const size_t radius = ctx->limit;
+    BVCMatch *hits = NULL;
+    size_t n = 0, cap = 0;
+    uint32_t dist[BVC_BATCH];
+
+    const size_t stop = bvc_part_start(ctx, part + 1);
+    for (size_t i = bvc_part_start(ctx, part); i < stop; i += BVC_BATCH) {
+        const size_t len = stop - i < BVC_BATCH ? stop - i : BVC_BATCH;
+        cbits_hamming_batch(ctx->query, bvc_row(c, i), c->stride, c->n_words,
+                            len, dist);
+        for (size_t j = 0; j < len; ++j) {
+            if (dist[j] > radius) {
+                continue;
+            }
+            if (n == cap) {
+                size_t new_cap = cap ? cap * 2 : 64;
+                BVCMatch *tmp =
+                    cbits_realloc(hits, new_cap * sizeof(BVCMatch));
+                if (!tmp) {
+                    ctx->failed[part] = true;
+                    ctx->hits[part] = hits;
+                    ctx->n_hits[part] = n;
+                    return;
+                }
+                hits = tmp;
+                cap = new_cap;
+            }
+            hits[n++] = (BVCMatch) {i + j, dist[j]};
+        }
+    }
+    ctx->hits[part] = hits;
+    ctx->n_hits[part] = n;
+}
+
+BVCMatch *
+bvc_within_radius(const BitVectorCollection *c, const BitVector *query,
+                  size_t radius, size_t *n_out, unsigned n_threads)
+{
+    bvc_search_ctx ctx = {c, query->data, bvc_parts(c->size, n_threads),
+                          radius};
+    BVCMatch *hits[CBITS_MAX_THREADS];
+    size_t n_hits[CBITS_MAX_THREADS];
+    bool failed[CBITS_MAX_THREADS] = {false};
+    ctx.hits = hits;
+    ctx.n_hits = n_hits;
+    ctx.failed = failed;
+    cbits_parallel_for(ctx.n_parts, bvc_radius_task, &ctx,
+                       (unsigned) ctx.n_parts);
+
+    size_t total = 0;
+    bool ok = true;
+    for (size_t p = 0; p < ctx.n_parts; ++p) {
+        total += n_hits[p];
+        ok = ok && !failed[p];
+    }
+    /* Owned by the caller, who releases it with free(). */
+    BVCMatch *out = ok ? malloc((total ? total : 1) * sizeof(BVCMatch))
+                       : NULL;
+    size_t pos = 0;
+    for (size_t p = 0; p < ctx.n_parts; ++p) {
+        if (out && n_hits[p]) {
+            memcpy(out + pos, hits[p], n_hits[p] * sizeof(BVCMatch));
+            pos += n_hits[p];
+        }
+        cbits_free(hits[p]);
+    }
+    *n_out = out ? total : 0;
+    return out;
+}
+
+/**
+ * @def BVC_PAIR_ROWS
+ * @brief Rows of the left collection handled by one pairwise task.
+ */
+#define BVC_PAIR_ROWS 64
+
+/**
+ * @brief Shared state of @ref bvc_pairwise.
+ */
+typedef struct {
+    const BitVectorCollection *a; /**< Row collection. */
+    const BitVectorCollection *b; /**< Column collection. */
+    uint32_t *out;                /**< Row-major distance matrix. */
+} bvc_pairwise_ctx;
+
+/**
+ * @brief Task: distance rows of one block of @ref BVC_PAIR_ROWS left rows.
+ *
+ * The right collection is walked in tiles of @ref BVC_BATCH rows, and every
+ * left row of the block is compared against a tile while it is in cache.
+ * @param arg Pointer to a ::bvc_pairwise_ctx.
+ * @param block Block index.
+ */
+static void
+bvc_pairwise_task(void *arg, size_t block)
+{
+    const bvc_pairwise_ctx *ctx = arg;
+    const BitVectorCollection *a = ctx->a, *b = ctx->b;
+    const size_t first = block * BVC_PAIR_ROWS;
+    const size_t last =
+        a->size - first < BVC_PAIR_ROWS ? a->size : first + BVC_PAIR_ROWS;
+    for (size_t j = 0; j < b->size; j += BVC_BATCH) {
+        const size_t len = b->size - j < BVC_BATCH ? b->size - j : BVC_BATCH;
+        for (size_t i = first; i < last; ++i) {
+            cbits_hamming_batch(bvc_row(a, i), bvc_row(b, j), b->stride,
+                                b->n_words, len, ctx->out + i * b->size + j);
+        }
+    }
+}
+
+int
+bvc_pairwise(const BitVectorCollection *a, const BitVectorCollection *b,
+             uint32_t *out, unsigned n_threads)
+{
+    if (a->n_bits != b->n_bits) {
+        return -1;
+    }
+    if (a->size == 0 || b->size == 0) {
+        return 0;
+    }
+    bvc_pairwise_ctx ctx = {a, b, out};
+    const size_t n_blocks = (a->size + BVC_PAIR_ROWS - 1) / BVC_PAIR_ROWS;
+    if ((unsigned long long) a->size * b->size < BVC_PARALLEL_MIN_ROWS) {
+        n_threads = 1;
+    }
+    cbits_parallel_for(n_blocks, bvc_pairwise_task, &ctx, n_threads);
+    return 0;
+}
@@ -1,9 +1,11 @@
 /**
  * @file src/cbits/bitvector_compare.c
- * @brief BitVector comparison and subvector search.
+ * @brief BitVector comparison, hashing and subvector search.
  *
  * This module implements:
- * - \ref bv_equal
+ * - \ref bv_equal, \ref bv_compare
+ * - \ref bv_is_subset, \ref bv_is_disjoint
+ * - \ref bv_hash
  * - \ref bv_contains_subvector
  *
  * @see bitvector_internal.h
@@ -12,8 +14,110 @@
  * @copyright Copyright (c) 2026 lambdaphoenix
  */
 #include "bitvector_internal.h"
+#include "key_hash.h"
 #include <string.h>
 
+/**
+ * @brief The 64 bits of the word pair @p hi:@p lo starting at bit @p off.
+ *
+ * @param lo Lower word.
+ * @param hi Upper word.
+ * @param off Bit offset into @p lo, 0 to 63.
+ * @return Extracted word; @p lo itself when @p off is zero, where shifting
+ *         @p hi by 64 would be undefined.
+ */
+static inline uint64_t
+bv_funnel_shift(uint64_t lo, uint64_t hi, unsigned off)
+{
+    return off ? (lo >> off) | (hi << (64 - off)) : lo;
+}
+
+/**
+ * @brief Words per step of the chunked scans below.
+ *
+ * Each step folds a whole chunk into one word before branching, a
+ * reduction the compiler vectorizes, so equal prefixes are skipped at
+ * close to memory speed.
+ */
+#define BV_SCAN_CHUNK 32
+
+/**
+ * @brief Index of the first word where @p a and @p b differ.
+ *
+ * @param a First word array.
+ * @param b Second word array.
+ * @param n Number of words to compare.
+ * @return Lowest differing index, or @p n if all are equal.
+ */
+static size_t
+bv_first_diff_word(const uint64_t *a, const uint64_t *b, size_t n)
+{
+    size_t i = 0;
+    for (; i + BV_SCAN_CHUNK <= n; i += BV_SCAN_CHUNK) {
+        uint64_t diff = 0;
+        for (size_t k = 0; k < BV_SCAN_CHUNK; ++k) {
+            diff |= a[i + k] ^ b[i + k];
+        }
+        if (diff) {
+            break;
+        }
+    }
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief One past the index of the last word where @p a and @p b differ.
+ *
+ * @param a First word array, or NULL to compare @p b against zero.
+ * @param b Second word array.
+ * @param n Number of words to compare.
+ * @return Highest differing index plus one, or 0 if all are equal.
+ */
+static size_t
+bv_last_diff_word(const uint64_t *a, const uint64_t *b, size_t n)
+{
+    size_t i = n;
+    for (; i >= BV_SCAN_CHUNK; i -= BV_SCAN_CHUNK) {
+        uint64_t diff = 0;
+        for (size_t k = 1; k <= BV_SCAN_CHUNK; ++k) {
+            diff |= (a ? a[i - k] : 0) ^ b[i - k];
+        }
+        if (diff) {
+            break;
+        }
+    }
+    for (; i > 0; --i) {
+        if ((a ? a[i - 1] : 0) != b[i - 1]) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Order of two words by their lowest differing bit.
+ *
+ * @param a Word of the first vector.
+ * @param b Word of the second vector.
+ * @retval 1 The lowest differing bit is set in @p a.
+ * @retval -1 It is set in @p b.
+ * @retval 0 The words are equal.
+ */
+static inline int
+bv_word_lex_order(uint64_t a, uint64_t b)
+{
+    const uint64_t x = a ^ b;
+    if (!x) {
+        return 0;
+    }
+    return (a & x & (0 - x)) ? 1 : -1;
+}
+
 bool
 bv_equal(const BitVector *a, const BitVector *b)
 {
@@ -32,6 +136,110 @@ bv_equal(const BitVector *a, const BitVector *b)
     return memcmp(a->data, b->data, a->n_words * sizeof(uint64_t)) == 0;
 }
 
+int
+bv_compare(const BitVector *a, const BitVector *b, BVOrder order)
+{
+    if (a == b) {
+        return 0;
+    }
+    const int by_length = (a->n_bits > b->n_bits) - (a->n_bits < b->n_bits);
+    if (order == BV_ORDER_NUMERIC) {
+        const BitVector *longer = by_length > 0 ? a : b;
+        const size_t common = by_length > 0 ? b->n_words : a->n_words;
+        if (longer->n_words > common &&
+            bv_last_diff_word(NULL, longer->data + common,
+                              longer->n_words - common)) {
+            return by_length;
+        }
+        const size_t i = bv_last_diff_word(a->data, b->data, common);
+        if (i) {
+            return a->data[i - 1] > b->data[i - 1] ? 1 : -1;
+        }
+        return by_length;
+    }
+
+    const size_t min_bits = by_length > 0 ? b->n_bits : a->n_bits;
+    const size_t full = min_bits >> 6;
+    const size_t i = bv_first_diff_word(a->data, b->data, full);
+    if (i < full) {
+        return bv_word_lex_order(a->data[i], b->data[i]);
+    }
+    const unsigned tail = (unsigned) (min_bits & 63);
+    if (tail) {
+        const uint64_t mask = (1ULL << tail) - 1;
+        const int c =
+            bv_word_lex_order(a->data[full] & mask, b->data[full] & mask);
+        if (c) {
+            return c;
+        }
+    }
+    return by_length;
+}
+
+bool
+bv_is_subset(const BitVector *a, const BitVector *b)
+{
+    if (a->n_bits != b->n_bits) {
+        return false;
+    }
+    const size_t n = a->n_words;
+    size_t i = 0;
+    for (; i + BV_SCAN_CHUNK <= n; i += BV_SCAN_CHUNK) {
+        uint64_t extra = 0;
+        for (size_t k = 0; k < BV_SCAN_CHUNK; ++k) {
+            extra |= a->data[i + k] & ~b->data[i + k];
+        }
+        if (extra) {
+            return false;
+        }
+    }
+    for (; i < n; ++i) {
+        if (a->data[i] & ~b->data[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+bv_is_disjoint(const BitVector *a, const BitVector *b)
+{
+    if (a->n_bits != b->n_bits) {
+        return false;
+    }
+    const size_t n = a->n_words;
+    size_t i = 0;
+    for (; i + BV_SCAN_CHUNK <= n; i += BV_SCAN_CHUNK) {
+        uint64_t common = 0;
+        for (size_t k = 0; k < BV_SCAN_CHUNK; ++k) {
+            common |= a->data[i + k] & b->data[i + k];
+        }
+        if (common) {
+            return false;
+        }
+    }
+    for (; i < n; ++i) {
+        if (a->data[i] & b->data[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t
+bv_hash(const BitVector *bv, uint64_t seed)
+{
+    if (!bv) {
+        return 0;
+    }
+    const size_t n_bytes = bv->n_words * sizeof(uint64_t);
+    cbits_stat_add(CBITS_STAT_HASH_BYTES, n_bytes);
+    /* Tail bits are zero, so whole words hash like the bits alone; the
+     * length goes into the seed to separate e.g. 60 and 64 zero bits. */
+    seed ^= (uint64_t) bv->n_bits * 0x9E3779B97F4A7C15ULL;
+    return key_hash(KEY_HASH_XXH64, seed, bv->data, n_bytes);
+}
+
 bool
 bv_contains_subvector(const BitVector *a, const BitVector *b)
 {
@@ -49,6 +257,7 @@ bv_contains_subvector(const BitVector *a, const BitVector *b)
     const unsigned b_tail = (unsigned) (b->n_bits & 63);
     const uint64_t tail_mask = b_tail ? ((1ULL << b_tail) - 1) : UINT64_MAX;
 
+    cbits_stat_add(CBITS_STAT_SEARCH_CALLS, 1);
     if (b->n_bits <= 64) {
         uint64_t needle = b->data[0] & tail_mask;
         for (size_t pos = 0; pos <= max_pos; ++pos) {
@@ -57,36 +266,42 @@ bv_contains_subvector(const BitVector *a, const BitVector *b)
 
             uint64_t lo = a->data[w_off];
             uint64_t hi = (w_off + 1 < a->n_words) ? a->data[w_off + 1] : 0ULL;
-            uint64_t window = (lo >> b_off) | (hi << (64 - b_off));
+            uint64_t window = bv_funnel_shift(lo, hi, b_off);
 
             if ((window & tail_mask) == needle) {
+                cbits_stat_add(CBITS_STAT_SEARCH_WINDOWS, pos + 1);
                 return true;
             }
         }
+        cbits_stat_add(CBITS_STAT_SEARCH_WINDOWS, max_pos + 1);
         return false;
     }
 
     const size_t b_words = b->n_words;
-    for (size_t pos = 0; pos <= max_pos; ++pos) {
+    size_t verified = 0;
+    size_t pos = 0;
+    bool found = false;
+    for (; pos <= max_pos && !found; ++pos) {
         const size_t w_off = pos >> 6;
         const unsigned b_off = pos & 63;
 
         {
             uint64_t lo = a->data[w_off];
             uint64_t hi = (w_off + 1 < a->n_words) ? a->data[w_off + 1] : 0ULL;
-            uint64_t aw0 = (lo >> b_off) | (hi << (64 - b_off));
+            uint64_t aw0 = bv_funnel_shift(lo, hi, b_off);
             uint64_t mask0 = (b_words == 1) ? tail_mask : UINT64_MAX;
             if ((aw0 & mask0) != (b->data[0] & mask0)) {
                 continue;
             }
         }
 
+        ++verified;
         bool match = true;
         for (size_t j = 1; j < b_words; ++j) {
             uint64_t lo = a->data[w_off + j];
             uint64_t hi =
                 (w_off + j + 1 < a->n_words) ? a->data[w_off + j + 1] : 0ULL;
-            uint64_t worda = (lo >> b_off) | (hi << (64 - b_off));
+            uint64_t worda = bv_funnel_shift(lo, hi, b_off);
             uint64_t mask = (b_words == j + 1) ? tail_mask : UINT64_MAX;
 
             if ((worda & mask) != (b->data[j] & mask)) {
@@ -94,9 +309,9 @@ bv_contains_subvector(const BitVector *a, const BitVector *b)
                 break;
             }
         }
-        if (match) {
-            return true;
-        }
+        found = match;
     }
-    return false;
+    cbits_stat_add(CBITS_STAT_SEARCH_WINDOWS, pos);
+    cbits_stat_add(CBITS_STAT_SEARCH_VERIFY, verified);
+    return found;
 }
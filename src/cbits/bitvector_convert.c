@@ -0,0 +1,167 @@
+/**
+ * @file src/cbits/bitvector_convert.c
+ * @brief Conversion between BitVectors and packed or one-per-bit bytes.
+ *
+ * This module implements:
+ * - \ref bv_to_bytes
+ * - \ref bv_from_bytes
+ * - \ref bv_to_bools
+ * - \ref bv_from_bools
+ *
+ * Bytes are moved a whole word at a time: little bit order on a
+ * little-endian host is the in-memory layout of the words, anything else
+ * costs one byte swap and/or one in-byte bit reversal per word. Bool
+ * bytes go through the dispatched packing kernels of compat.h.
+ *
+ * @see bitvector_internal.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitvector_internal.h"
+#include <string.h>
+
+/**
+ * @brief Reverse the order of the bits inside every byte of a word.
+ * @param w Word to transform.
+ * @return @p w with bit k of each byte moved to bit 7 - k.
+ */
+static inline uint64_t
+bv_reverse_byte_bits(uint64_t w)
+{
+    const uint64_t m1 = 0x5555555555555555ULL;
+    const uint64_t m2 = 0x3333333333333333ULL;
+    const uint64_t m4 = 0x0F0F0F0F0F0F0F0FULL;
+    w = ((w >> 1) & m1) | ((w & m1) << 1);
+    w = ((w >> 2) & m2) | ((w & m2) << 2);
+    w = ((w >> 4) & m4) | ((w & m4) << 4);
+    return w;
+}
+
+/**
+ * @brief Convert between a data word and its eight packed bytes, read as a
+ *        little-endian word.
+ *
+ * The transform is its own inverse, so it serves both directions.
+ * @param w Word to convert.
+ * @param order Bit order within each byte.
+ * @return Converted word.
+ */
+static inline uint64_t
+bv_pack_word(uint64_t w, BVBitOrder order)
+{
+    if (order == BV_BITORDER_BIG) {
+        w = bv_reverse_byte_bits(w);
+    }
+#if !CBITS_LITTLE_ENDIAN
+    w = cbits_bswap64(w);
+#endif
+    return w;
+}
+
+/**
+ * @brief Pack @p n whole words into @p 8n bytes.
+ *
+ * Separate from @ref bv_to_bytes so that @c restrict tells the compiler
+ * the buffers do not overlap, which lets it vectorize the loop.
+ * @param src Source words.
+ * @param dst Destination bytes.
+ * @param n Number of words.
+ * @param order Bit order within each byte.
+ */
+static void
+bv_pack_words(const uint64_t *restrict src, uint8_t *restrict dst, size_t n,
+              BVBitOrder order)
+{
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t w = bv_pack_word(src[i], order);
+        memcpy(dst + (i << 3), &w, sizeof w);
+    }
+}
+
+/**
+ * @brief Unpack @p 8n bytes into @p n whole words; inverse of
+ *        @ref bv_pack_words.
+ * @param src Source bytes.
+ * @param dst Destination words.
+ * @param n Number of words.
+ * @param order Bit order within each byte.
+ */
+static void
+bv_unpack_words(const uint8_t *restrict src, uint64_t *restrict dst,
+                size_t n, BVBitOrder order)
+{
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t w;
+        memcpy(&w, src + (i << 3), sizeof w);
+        dst[i] = bv_pack_word(w, order);
+    }
+}
+
+void
+bv_to_bytes(const BitVector *bv, uint8_t *out, BVBitOrder order)
+{
+    const size_t n_bytes = (bv->n_bits + 7) >> 3;
+    if (!n_bytes) {
+        return;
+    }
+#if CBITS_LITTLE_ENDIAN
+    if (order == BV_BITORDER_LITTLE) {
+        memcpy(out, bv->data, n_bytes);
+        return;
+    }
+#endif
+    const size_t full = n_bytes >> 3;
+    bv_pack_words(bv->data, out, full, order);
+    const size_t rem = n_bytes & 7;
+    if (rem) {
+        const uint64_t w = bv_pack_word(bv->data[full], order);
+        memcpy(out + (full << 3), &w, rem);
+    }
+}
+
+BitVector *
+bv_from_bytes(const uint8_t *in, size_t n_bits, BVBitOrder order)
+{
+    BitVector *bv = bv_new(n_bits);
+    if (!bv || n_bits == 0) {
+        return bv;
+    }
+    const size_t n_bytes = (n_bits + 7) >> 3;
+#if CBITS_LITTLE_ENDIAN
+    if (order == BV_BITORDER_LITTLE) {
+        memcpy(bv->data, in, n_bytes);
+        bv_apply_tail_mask(bv);
+        return bv;
+    }
+#endif
+    const size_t full = n_bytes >> 3;
+    bv_unpack_words(in, bv->data, full, order);
+    const size_t rem = n_bytes & 7;
+    if (rem) {
+        uint64_t w = 0;
+        memcpy(&w, in + (full << 3), rem);
+        bv->data[full] = bv_pack_word(w, order);
+    }
+    bv_apply_tail_mask(bv);
+    return bv;
+}
+
+void
+bv_to_bools(const BitVector *bv, uint8_t *out)
+{
+    if (bv->n_bits) {
+        cbits_unpack_bools(out, bv->data, bv->n_bits);
+    }
+}
+
+BitVector *
+bv_from_bools(const uint8_t *in, size_t n_bits)
+{
+    BitVector *bv = bv_new(n_bits);
+    if (bv && n_bits) {
+        /* The kernel zeroes the bits past n_bits in the last word. */
+        cbits_pack_bools(bv->data, in, n_bits);
+    }
+    return bv;
+}
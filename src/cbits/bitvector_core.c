@@ -4,6 +4,7 @@
  *
  * This module implements the fundamental BitVector API:
  * - \ref bv_new, \ref bv_copy, \ref bv_free
+ * - memory accounting (\ref bv_memory_usage)
  * - single bit operations (\ref bv_get, \ref bv_set, \ref bv_clear, \ref
  * bv_flip)
  *
@@ -30,10 +31,23 @@ words_for_bits(const size_t n_bits)
     return (n_bits + 63) >> 6;
 }
 
+/**
+ * @brief Account a BitVector allocated by @ref bv_new.
+ *
+ * Its header, data and rank tables are allocated unaccounted and counted
+ * here as one allocation.
+ * @param bv New vector.
+ */
+static void
+bv_account_alloc(const BitVector *bv)
+{
+    cbits_account_alloc(bv_memory_usage(bv, NULL));
+}
+
 BitVector *
 bv_new(size_t n_bits)
 {
-    BitVector *bv = cbits_malloc_aligned(sizeof(BitVector), BV_ALIGN);
+    BitVector *bv = cbits_aligned_alloc_raw(sizeof(BitVector), BV_ALIGN);
     if (!bv) {
         return NULL;
     }
@@ -45,33 +59,37 @@ bv_new(size_t n_bits)
         bv->data = NULL;
         bv->super_rank = NULL;
         bv->block_rank = NULL;
+        bv_account_alloc(bv);
         return bv;
     }
 
     const size_t alloc_words = bv->n_words + 1;
-    bv->data = cbits_malloc_aligned(alloc_words * sizeof(uint64_t), BV_ALIGN);
+    bv->data =
+        cbits_aligned_alloc_raw(alloc_words * sizeof(uint64_t), BV_ALIGN);
     if (!bv->data) {
-        cbits_free_aligned(bv);
+        cbits_aligned_free_raw(bv);
         return NULL;
     }
     memset(bv->data, 0, alloc_words * sizeof(uint64_t));
 
     size_t n_super =
         (bv->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
-    bv->super_rank = cbits_malloc_aligned(n_super * sizeof(size_t), BV_ALIGN);
+    bv->super_rank =
+        cbits_aligned_alloc_raw(n_super * sizeof(size_t), BV_ALIGN);
     if (!bv->super_rank) {
-        cbits_free_aligned(bv->data);
-        cbits_free_aligned(bv);
+        cbits_aligned_free_raw(bv->data);
+        cbits_aligned_free_raw(bv);
         return NULL;
     }
     bv->block_rank =
-        cbits_malloc_aligned(bv->n_words * sizeof(uint16_t), BV_ALIGN);
+        cbits_aligned_alloc_raw(bv->n_words * sizeof(uint16_t), BV_ALIGN);
     if (!bv->block_rank) {
-        cbits_free_aligned(bv->super_rank);
-        cbits_free_aligned(bv->data);
-        cbits_free_aligned(bv);
+        cbits_aligned_free_raw(bv->super_rank);
+        cbits_aligned_free_raw(bv->data);
+        cbits_aligned_free_raw(bv);
         return NULL;
     }
+    bv_account_alloc(bv);
     return bv;
 }
 
@@ -103,10 +121,31 @@ bv_free(BitVector *bv)
     if (!bv) {
         return;
     }
-    cbits_free_aligned(bv->block_rank);
-    cbits_free_aligned(bv->super_rank);
-    cbits_free_aligned(bv->data);
-    cbits_free_aligned(bv);
+    cbits_account_free(bv_memory_usage(bv, NULL));
+    cbits_aligned_free_raw(bv->block_rank);
+    cbits_aligned_free_raw(bv->super_rank);
+    cbits_aligned_free_raw(bv->data);
+    cbits_aligned_free_raw(bv);
+}
+
+size_t
+bv_memory_usage(const BitVector *bv, bv_memory *parts)
+{
+    bv_memory m = {0, 0, 0, 0};
+    if (bv) {
+        const size_t n_super =
+            (bv->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+        m.header = sizeof(BitVector);
+        m.data = bv->n_words * sizeof(uint64_t);
+        m.padding = bv->data ? sizeof(uint64_t) : 0;
+        m.rank_tables =
+            (bv->super_rank ? n_super * sizeof(size_t) : 0) +
+            (bv->block_rank ? bv->n_words * sizeof(uint16_t) : 0);
+    }
+    if (parts) {
+        *parts = m;
+    }
+    return m.header + m.data + m.padding + m.rank_tables;
 }
 
 int
@@ -6,8 +6,9 @@
  * - \ref bv_set_range
  * - \ref bv_clear_range
  * - \ref bv_flip_range
+ * - \ref bv_count and \ref bv_count_range
  *
- * These operations manipulate contiguous bit ranges.
+ * These operations manipulate or count contiguous bit ranges.
  *
  * @see bitvector_internal.h
  * @author lambdaphoenix
@@ -34,7 +35,7 @@
  * @since 0.2.0
  */
 static inline void
-bv__normalize_range(BitVector *bv, size_t *start, size_t *len)
+bv__normalize_range(const BitVector *bv, size_t *start, size_t *len)
 {
     if (!bv || bv->n_bits == 0 || *len == 0) {
         *len = 0;
@@ -155,3 +156,41 @@ bv_flip_range(BitVector *bv, size_t start, size_t len)
     bv_apply_tail_mask(bv);
     bv->rank_dirty = true;
 }
+
+size_t
+bv_count(const BitVector *bv)
+{
+    if (!bv || !bv->n_words) {
+        return 0;
+    }
+    return (size_t) cbits_popcount_words(bv->data, bv->n_words);
+}
+
+size_t
+bv_count_range(const BitVector *bv, size_t start, size_t len)
+{
+    bv__normalize_range(bv, &start, &len);
+    if (!len) {
+        return 0;
+    }
+    size_t end = start + len;
+    size_t w_start = start >> 6;
+    size_t w_end = (end - 1) >> 6;
+    unsigned off_start = start & 63;
+    unsigned off_end = end & 63;
+    uint64_t first = bv->data[w_start] & (~0ULL << off_start);
+
+    if (w_start == w_end) {
+        if (off_end) {
+            first &= (UINT64_C(1) << off_end) - 1;
+        }
+        return cbits_popcount64(first);
+    }
+    uint64_t last = bv->data[w_end];
+    if (off_end) {
+        last &= (UINT64_C(1) << off_end) - 1;
+    }
+    return cbits_popcount64(first) + cbits_popcount64(last) +
+           (size_t) cbits_popcount_words(bv->data + w_start + 1,
+                                         w_end - w_start - 1);
+}
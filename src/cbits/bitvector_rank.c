@@ -17,7 +17,7 @@
  */
 #include "bitvector_internal.h"
 
-void
+CBITS_POPCNT_CLONES void
 bv_build_rank(BitVector *bv)
 {
     if (!bv) {
@@ -30,6 +30,8 @@ bv_build_rank(BitVector *bv)
 
     size_t super_total = 0;
     const size_t n_words = bv->n_words;
+    cbits_stat_add(CBITS_STAT_RANK_BUILDS, 1);
+    cbits_stat_add(CBITS_STAT_RANK_WORDS, n_words);
     const size_t n_super =
         (n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
 
@@ -77,7 +79,7 @@ bv_build_rank(BitVector *bv)
     bv->rank_dirty = false;
 }
 
-size_t
+CBITS_POPCNT_CLONES size_t
 bv_rank(BitVector *bv, const size_t pos)
 {
     if (!bv || bv->n_bits == 0) {
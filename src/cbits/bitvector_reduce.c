@@ -0,0 +1,327 @@
+/**
+ * @file src/cbits/bitvector_reduce.c
+ * @brief N-ary reductions over many BitVectors.
+ *
+ * This module implements:
+ * - \ref bv_and_all
+ * - \ref bv_or_all
+ * - \ref bv_xor_all
+ * - \ref bv_threshold
+ *
+ * All reductions allocate only the result and walk it in blocks small
+ * enough to stay in L1 while every input streams through once, instead of
+ * materialising an intermediate vector per input.
+ *
+ * @see bitvector_internal.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitvector_internal.h"
+#include <string.h>
+
+/**
+ * @def BV_REDUCE_BLOCK_WORDS
+ * @brief Output words combined per pass of AND/OR/XOR (4 KiB).
+ */
+#define BV_REDUCE_BLOCK_WORDS 512
+/**
+ * @def BV_THRESHOLD_BLOCK_WORDS
+ * @brief Output words per pass of @ref bv_threshold.
+ *
+ * Each output word needs up to 68 counter and scratch words, so the block
+ * is smaller than @ref BV_REDUCE_BLOCK_WORDS to keep them in L1.
+ */
+#define BV_THRESHOLD_BLOCK_WORDS 64
+
+/**
+ * @brief Binary operator folded by @ref bv_reduce.
+ */
+typedef enum {
+    BV_REDUCE_AND,
+    BV_REDUCE_OR,
+    BV_REDUCE_XOR,
+} bv_reduce_op;
+
+/**
+ * @brief Allocate the result of a reduction after validating the inputs.
+ *
+ * @param vs Input vectors.
+ * @param n Number of inputs.
+ * @retval BitVector* Zeroed vector of the common length.
+ * @retval NULL If @p n is zero, the lengths differ or allocation fails.
+ */
+static BitVector *
+bv_reduce_result(const BitVector *const *vs, size_t n)
+{
+    if (n == 0) {
+        return NULL;
+    }
+    const size_t n_bits = vs[0]->n_bits;
+    for (size_t i = 1; i < n; ++i) {
+        if (vs[i]->n_bits != n_bits) {
+            return NULL;
+        }
+    }
+    return bv_new(n_bits);
+}
+
+/**
+ * @brief Fold @p m inputs of one block into @p dst.
+ *
+ * Up to four inputs are combined per store so @p dst is loaded and written
+ * once per four inputs rather than once per input.
+ *
+ * @param dst Output block.
+ * @param src Input blocks.
+ * @param m Number of inputs, 1 to 4.
+ * @param len Words per block.
+ * @param op Operator to fold with.
+ * @return Bitwise OR of the updated block, zero if it is empty.
+ */
+static inline uint64_t
+bv_reduce_block(uint64_t *restrict dst, const uint64_t *const *src,
+                size_t m, size_t len, bv_reduce_op op)
+{
+    const uint64_t *a = src[0];
+    const uint64_t *b = src[m > 1 ? 1 : 0];
+    const uint64_t *c = src[m > 2 ? 2 : 0];
+    const uint64_t *d = src[m > 3 ? 3 : 0];
+    uint64_t any = 0;
+    if (op == BV_REDUCE_AND) {
+        /* Repeating an input is harmless for AND and OR. */
+        for (size_t j = 0; j < len; ++j) {
+            dst[j] &= a[j] & b[j] & c[j] & d[j];
+            any |= dst[j];
+        }
+    }
+    else if (op == BV_REDUCE_OR) {
+        for (size_t j = 0; j < len; ++j) {
+            dst[j] |= a[j] | b[j] | c[j] | d[j];
+        }
+        any = 1;
+    }
+    else if (m == 4) {
+        for (size_t j = 0; j < len; ++j) {
+            dst[j] ^= a[j] ^ b[j] ^ c[j] ^ d[j];
+        }
+        any = 1;
+    }
+    else {
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < len; ++j) {
+                dst[j] ^= src[i][j];
+            }
+        }
+        any = 1;
+    }
+    return any;
+}
+
+/**
+ * @brief Fold @p n vectors with one operator, block by block.
+ *
+ * Tail bits stay zero because they are zero in every input. An AND block
+ * stops reading further inputs once it is empty.
+ *
+ * @param vs Input vectors.
+ * @param n Number of inputs.
+ * @param op Operator to fold with.
+ * @retval BitVector* New BitVector on success.
+ * @retval NULL On invalid input or allocation failure.
+ */
+static BitVector *
+bv_reduce(const BitVector *const *vs, size_t n, bv_reduce_op op)
+{
+    BitVector *res = bv_reduce_result(vs, n);
+    if (!res) {
+        return NULL;
+    }
+    const size_t n_words = res->n_words;
+    for (size_t start = 0; start < n_words; start += BV_REDUCE_BLOCK_WORDS) {
+        const size_t len = n_words - start < BV_REDUCE_BLOCK_WORDS
+                               ? n_words - start
+                               : BV_REDUCE_BLOCK_WORDS;
+        uint64_t *dst = res->data + start;
+        memcpy(dst, vs[0]->data + start, len * sizeof(uint64_t));
+        for (size_t i = 1; i < n; i += 4) {
+            const size_t m = n - i < 4 ? n - i : 4;
+            const uint64_t *src[4];
+            for (size_t s = 0; s < m; ++s) {
+                src[s] = vs[i + s]->data + start;
+            }
+            if (!bv_reduce_block(dst, src, m, len, op)) {
+                break;
+            }
+        }
+    }
+    cbits_stat_add(CBITS_STAT_BITWISE_BYTES,
+                   (uint64_t) (n * n_words * sizeof(uint64_t)));
+    return res;
+}
+
+BitVector *
+bv_and_all(const BitVector *const *vs, size_t n)
+{
+    return bv_reduce(vs, n, BV_REDUCE_AND);
+}
+
+BitVector *
+bv_or_all(const BitVector *const *vs, size_t n)
+{
+    return bv_reduce(vs, n, BV_REDUCE_OR);
+}
+
+BitVector *
+bv_xor_all(const BitVector *const *vs, size_t n)
+{
+    return bv_reduce(vs, n, BV_REDUCE_XOR);
+}
+
+/** @brief All-zero block standing in for missing inputs of a group. */
+static const uint64_t bv_threshold_zero[BV_THRESHOLD_BLOCK_WORDS];
+
+/**
+ * @brief Add one block of four inputs to the vertical counters.
+ *
+ * Counter level @c l of output word @c j is @c cnt[l * B + j] with
+ * @c B = @ref BV_THRESHOLD_BLOCK_WORDS. A carry-save adder first reduces
+ * the four inputs to a three-bit sum per position, which is then added
+ * level by level, one whole block per level so that every pass is a
+ * vectorisable loop. Above the sum the carry ripples on until no carry is
+ * left; carries out of the top level are collected in @p sat.
+ *
+ * @param cnt Counter levels, at least two.
+ * @param sat Saturation words.
+ * @param tmp Scratch of three blocks.
+ * @param levels Number of counter levels.
+ * @param src Four input blocks.
+ * @param len Number of words in the block.
+ */
+static inline void
+bv_threshold_add4(uint64_t *restrict cnt, uint64_t *restrict sat,
+                  uint64_t *restrict tmp, unsigned levels,
+                  const uint64_t *const *src, size_t len)
+{
+    uint64_t *carry = tmp;
+    uint64_t *s1 = tmp + BV_THRESHOLD_BLOCK_WORDS;
+    uint64_t *s2 = tmp + 2 * BV_THRESHOLD_BLOCK_WORDS;
+    const uint64_t *a = src[0], *b = src[1], *c = src[2], *d = src[3];
+    for (size_t j = 0; j < len; ++j) {
+        const uint64_t u = a[j] ^ b[j], v = c[j] ^ d[j];
+        const uint64_t ab = a[j] & b[j], cd = c[j] & d[j], uv = u & v;
+        const uint64_t s0 = u ^ v;
+        s1[j] = ab ^ cd ^ uv;
+        s2[j] = (ab & cd) | ((ab ^ cd) & uv);
+        carry[j] = cnt[j] & s0;
+        cnt[j] ^= s0;
+    }
+    for (unsigned l = 1; l < levels; ++l) {
+        uint64_t *cl = cnt + (size_t) l * BV_THRESHOLD_BLOCK_WORDS;
+        if (l <= 2) {
+            const uint64_t *x = l == 1 ? s1 : s2;
+            for (size_t j = 0; j < len; ++j) {
+                const uint64_t t = cl[j] ^ x[j];
+                const uint64_t next = (cl[j] & x[j]) | (t & carry[j]);
+                cl[j] = t ^ carry[j];
+                carry[j] = next;
+            }
+            continue;
+        }
+        uint64_t any = 0;
+        for (size_t j = 0; j < len; ++j) {
+            const uint64_t next = cl[j] & carry[j];
+            cl[j] ^= carry[j];
+            carry[j] = next;
+            any |= next;
+        }
+        if (!any) {
+            return;
+        }
+    }
+    /* With two levels the weight-4 digit alone already saturates. */
+    const uint64_t *over = levels == 2 ? s2 : bv_threshold_zero;
+    for (size_t j = 0; j < len; ++j) {
+        sat[j] |= carry[j] | over[j];
+    }
+}
+
+BitVector *
+bv_threshold(const BitVector *const *vs, size_t n, size_t k)
+{
+    if (k == 1) {
+        return bv_or_all(vs, n);
+    }
+    if (k == n) {
+        return bv_and_all(vs, n);
+    }
+    BitVector *res = bv_reduce_result(vs, n);
+    if (!res || k > n) {
+        return res;
+    }
+    if (k == 0) {
+        bv_set_range(res, 0, res->n_bits);
+        return res;
+    }
+
+    /* Counters of bit_length(k) levels saturate at 2^levels > k. */
+    unsigned levels = 0;
+    while (levels < 64 && (k >> levels)) {
+        ++levels;
+    }
+    const size_t block_counters = (size_t) (levels + 1) *
+                                  BV_THRESHOLD_BLOCK_WORDS;
+    const size_t cnt_bytes =
+        (block_counters + 3 * BV_THRESHOLD_BLOCK_WORDS) * sizeof(uint64_t);
+    uint64_t *cnt = cbits_malloc_aligned(cnt_bytes, BV_ALIGN);
+    if (!cnt) {
+        bv_free(res);
+        return NULL;
+    }
+    uint64_t *sat = cnt + (size_t) levels * BV_THRESHOLD_BLOCK_WORDS;
+    uint64_t *tmp = cnt + block_counters;
+
+    const size_t n_words = res->n_words;
+    for (size_t start = 0; start < n_words;
+         start += BV_THRESHOLD_BLOCK_WORDS) {
+        const size_t len = n_words - start < BV_THRESHOLD_BLOCK_WORDS
+                               ? n_words - start
+                               : BV_THRESHOLD_BLOCK_WORDS;
+        memset(cnt, 0, block_counters * sizeof(uint64_t));
+        for (size_t i = 0; i < n; i += 4) {
+            const uint64_t *src[4];
+            for (size_t g = 0; g < 4; ++g) {
+                src[g] = i + g < n ? vs[i + g]->data + start
+                                   : bv_threshold_zero;
+            }
+            bv_threshold_add4(cnt, sat, tmp, levels, src, len);
+        }
+        /* Bit-sliced comparison of every counter against k, MSB first;
+         * saturated counters count as greater. */
+        uint64_t *eq = tmp;
+        uint64_t *gt = tmp + BV_THRESHOLD_BLOCK_WORDS;
+        for (size_t j = 0; j < len; ++j) {
+            eq[j] = ~0ULL;
+            gt[j] = sat[j];
+        }
+        for (unsigned l = levels; l-- > 0;) {
+            const uint64_t *c = cnt + (size_t) l * BV_THRESHOLD_BLOCK_WORDS;
+            if ((k >> l) & 1) {
+                for (size_t j = 0; j < len; ++j) {
+                    eq[j] &= c[j];
+                }
+            }
+            else {
+                for (size_t j = 0; j < len; ++j) {
+                    gt[j] |= eq[j] & c[j];
+                    eq[j] &= ~c[j];
+                }
+            }
+        }
+        for (size_t j = 0; j < len; ++j) {
+            res->data[start + j] = gt[j] | eq[j];
+        }
+    }
+    cbits_free_aligned(cnt, cnt_bytes);
+    return res;
+}
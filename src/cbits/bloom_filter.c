@@ -0,0 +1,442 @@
+/**
+ * @file src/cbits/bloom_filter.c
+ * @brief Classic and cache-line blocked Bloom filters over a BitVector.
+ *
+ * This module implements:
+ * - key hashing through key_hash.h (\ref bloom_hash)
+ * - sizing and construction (\ref bloom_params, \ref bloom_new)
+ * - batched insertion and lookup (\ref bloom_add_hashes,
+ *   \ref bloom_contains_hashes)
+ * - set operations, count estimation and serialization
+ *
+ * The classic layout derives its positions with enhanced double hashing
+ * and maps them onto the vector with a multiply-high instead of a modulo.
+ * The blocked layout picks one 512-bit block the same way, then draws the
+ * 9-bit positions inside it from a small LCG seeded with the key hash and
+ * builds the whole block mask before touching memory.
+ *
+ * @see bloom_filter.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bloom_filter.h"
+#include "bitvector_internal.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @def BLOOM_PREFETCH_DISTANCE
+ * @brief How many keys ahead the batched functions prefetch.
+ */
+#define BLOOM_PREFETCH_DISTANCE 8
+/** @brief Words per block of the blocked layout. */
+#define BLOOM_BLOCK_WORDS (BLOOM_BLOCK_BITS / 64)
+/** @brief Version byte of the serialized format. */
+#define BLOOM_FORMAT_VERSION 1
+
+/* Hashing */
+
+/**
+ * @brief Load a little-endian 64-bit word from unaligned memory.
+ */
+static inline uint64_t
+bloom__load64(const uint8_t *p)
+{
+    return (uint64_t) p[0] | (uint64_t) p[1] << 8 | (uint64_t) p[2] << 16 |
+           (uint64_t) p[3] << 24 | (uint64_t) p[4] << 32 |
+           (uint64_t) p[5] << 40 | (uint64_t) p[6] << 48 |
+           (uint64_t) p[7] << 56;
+}
+
+/**
+ * @brief Store a 64-bit word in little-endian order.
+ */
+static inline void
+bloom__store64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        p[i] = (uint8_t) (v >> (8 * i));
+    }
+}
+
+uint64_t
+bloom_hash(const BloomFilter *f, const void *key, size_t len)
+{
+    return key_hash(f->hash, f->seed, key, len);
+}
+
+uint64_t
+bloom_hash_u64(const BloomFilter *f, uint64_t key)
+{
+    return key_hash_u64(f->hash, f->seed, key);
+}
+
+void
+bloom_hash_u64_many(const BloomFilter *f, const uint64_t *keys, size_t n,
+                    uint64_t *out)
+{
+    key_hash_u64_many(f->hash, f->seed, keys, n, out);
+}
+
+void
+bloom_hash_fixed_many(const BloomFilter *f, const void *data, size_t width,
+                      size_t n, uint64_t *out)
+{
+    key_hash_fixed_many(f->hash, f->seed, data, width, n, out);
+}
+
+/* Bit positions */
+
+/**
+ * @brief Positions of a key in the classic layout.
+ *
+ * Enhanced double hashing: <tt>a += b; b += i</tt> between probes, with the
+ * two halves of the hash swapped and scrambled for @c b.
+ * @param f Filter.
+ * @param hash Key hash.
+ * @param pos Output of @c n_hashes bit positions.
+ */
+static inline void
+bloom__classic_positions(const BloomFilter *f, uint64_t hash, size_t *pos)
+{
+    const uint64_t m = f->bits->n_bits;
+    uint64_t a = hash;
+    uint64_t b = (((hash >> 32) | (hash << 32)) * 0x9E3779B97F4A7C15ULL) | 1;
+    for (unsigned i = 0; i < f->n_hashes; ++i) {
+        pos[i] = (size_t) cbits_mulhi64(a, m);
+        a += b;
+        b += i;
+    }
+}
+
+/**
+ * @brief Block and in-block mask of a key in the blocked layout.
+ * @param f Filter.
+ * @param hash Key hash.
+ * @param mask Output of the @ref BLOOM_BLOCK_WORDS mask words.
+ * @return First word of the key's block.
+ */
+static inline size_t
+bloom__blocked_mask(const BloomFilter *f, uint64_t hash, uint64_t *mask)
+{
+    const uint64_t n_blocks = f->bits->n_words / BLOOM_BLOCK_WORDS;
+    uint64_t g = hash;
+    memset(mask, 0, BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+    for (unsigned i = 0; i < f->n_hashes; ++i) {
+        g = g * 0x5851F42D4C957F2DULL + 0x14057B7EF767814FULL;
+        const unsigned bit = (unsigned) (g >> 55);
+        mask[bit >> 6] |= UINT64_C(1) << (bit & 63);
+    }
+    return (size_t) cbits_mulhi64(hash, n_blocks) * BLOOM_BLOCK_WORDS;
+}
+
+/**
+ * @brief Prefetch every cache line a key touches.
+ * @param f Filter.
+ * @param hash Key hash.
+ */
+static inline void
+bloom__prefetch(const BloomFilter *f, uint64_t hash)
+{
+    if (f->layout == BLOOM_BLOCKED) {
+        const uint64_t n_blocks = f->bits->n_words / BLOOM_BLOCK_WORDS;
+        cbits_prefetch(f->bits->data + cbits_mulhi64(hash, n_blocks) *
+                                           BLOOM_BLOCK_WORDS);
+        return;
+    }
+    size_t pos[BLOOM_MAX_HASHES];
+    bloom__classic_positions(f, hash, pos);
+    for (unsigned i = 0; i < f->n_hashes; ++i) {
+        cbits_prefetch(f->bits->data + (pos[i] >> 6));
+    }
+}
+
+void
+bloom_add_hash(BloomFilter *f, uint64_t hash)
+{
+    uint64_t *data = f->bits->data;
+    if (f->layout == BLOOM_BLOCKED) {
+        uint64_t mask[BLOOM_BLOCK_WORDS];
+        uint64_t *block = data + bloom__blocked_mask(f, hash, mask);
+        for (size_t w = 0; w < BLOOM_BLOCK_WORDS; ++w) {
+            block[w] |= mask[w];
+        }
+    }
+    else {
+        size_t pos[BLOOM_MAX_HASHES];
+        bloom__classic_positions(f, hash, pos);
+        for (unsigned i = 0; i < f->n_hashes; ++i) {
+            data[pos[i] >> 6] |= UINT64_C(1) << (pos[i] & 63);
+        }
+    }
+    f->bits->rank_dirty = true;
+}
+
+bool
+bloom_contains_hash(const BloomFilter *f, uint64_t hash)
+{
+    const uint64_t *data = f->bits->data;
+    if (f->layout == BLOOM_BLOCKED) {
+        uint64_t mask[BLOOM_BLOCK_WORDS];
+        const uint64_t *block = data + bloom__blocked_mask(f, hash, mask);
+        uint64_t missing = 0;
+        for (size_t w = 0; w < BLOOM_BLOCK_WORDS; ++w) {
+            missing |= mask[w] & ~block[w];
+        }
+        return missing == 0;
+    }
+    size_t pos[BLOOM_MAX_HASHES];
+    bloom__classic_positions(f, hash, pos);
+    for (unsigned i = 0; i < f->n_hashes; ++i) {
+        if (!((data[pos[i] >> 6] >> (pos[i] & 63)) & 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+bloom_add_hashes(BloomFilter *f, const uint64_t *hashes, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (i + BLOOM_PREFETCH_DISTANCE < n) {
+            bloom__prefetch(f, hashes[i + BLOOM_PREFETCH_DISTANCE]);
+        }
+        bloom_add_hash(f, hashes[i]);
+    }
+}
+
+void
+bloom_contains_hashes(const BloomFilter *f, const uint64_t *hashes,
+                      size_t n, uint64_t *out)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (i + BLOOM_PREFETCH_DISTANCE < n) {
+            bloom__prefetch(f, hashes[i + BLOOM_PREFETCH_DISTANCE]);
+        }
+        out[i >> 6] |= (uint64_t) bloom_contains_hash(f, hashes[i])
+                       << (i & 63);
+    }
+}
+
+/* Construction */
+
+int
+bloom_params(BloomLayout layout, size_t capacity, double error_rate,
+             size_t *n_bits, unsigned *n_hashes)
+{
+    if (!(error_rate > 0.0 && error_rate < 1.0)) {
+        return -1;
+    }
+    const double n = capacity ? (double) capacity : 1.0;
+    const double ln2 = 0.69314718055994530942;
+    double m = ceil(-n * log(error_rate) / (ln2 * ln2));
+    if (m < 1.0) {
+        m = 1.0;
+    }
+    if (m > (double) (SIZE_MAX / 2 - BLOOM_BLOCK_BITS)) {
+        return -1;
+    }
+    double k = floor(m / n * ln2 + 0.5);
+    k = k < 1.0 ? 1.0 : (k > BLOOM_MAX_HASHES ? BLOOM_MAX_HASHES : k);
+    *n_bits = (size_t) m;
+    if (layout == BLOOM_BLOCKED) {
+        *n_bits = (*n_bits + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS *
+                  BLOOM_BLOCK_BITS;
+    }
+    *n_hashes = (unsigned) k;
+    return 0;
+}
+
+BloomFilter *
+bloom_new(BloomLayout layout, size_t n_bits, unsigned n_hashes,
+          KeyHash hash, uint64_t seed)
+{
+    if (n_bits == 0 || n_hashes == 0 || n_hashes > BLOOM_MAX_HASHES ||
+        (unsigned) hash >= KEY_HASH_COUNT ||
+        (layout != BLOOM_CLASSIC && layout != BLOOM_BLOCKED)) {
+        return NULL;
+    }
+    if (layout == BLOOM_BLOCKED) {
+        if (n_bits > SIZE_MAX - BLOOM_BLOCK_BITS) {
+            return NULL;
+        }
+        n_bits = (n_bits + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS *
+                 BLOOM_BLOCK_BITS;
+    }
+    BloomFilter *f = cbits_malloc(sizeof(BloomFilter));
+    if (!f) {
+        return NULL;
+    }
+    f->bits = bv_new(n_bits);
+    if (!f->bits) {
+        cbits_free(f);
+        return NULL;
+    }
+    f->layout = layout;
+    f->hash = hash;
+    f->n_hashes = n_hashes;
+    f->seed = seed;
+    return f;
+}
+
+BloomFilter *
+bloom_copy(const BloomFilter *f)
+{
+    BloomFilter *copy = cbits_malloc(sizeof(BloomFilter));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *f;
+    copy->bits = bv_copy(f->bits);
+    if (!copy->bits) {
+        cbits_free(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+void
+bloom_free(BloomFilter *f)
+{
+    if (!f) {
+        return;
+    }
+    bv_free(f->bits);
+    cbits_free(f);
+}
+
+/* Set operations */
+
+bool
+bloom_compatible(const BloomFilter *a, const BloomFilter *b)
+{
+    return a->layout == b->layout && a->hash == b->hash &&
+           a->n_hashes == b->n_hashes && a->seed == b->seed &&
+           a->bits->n_bits == b->bits->n_bits;
+}
+
+int
+bloom_union(BloomFilter *dst, const BloomFilter *src)
+{
+    if (!bloom_compatible(dst, src)) {
+        return -1;
+    }
+    uint64_t *a = dst->bits->data;
+    if (a == src->bits->data) {
+        return 0;
+    }
+    cbits_bitwise_words(a, a, src->bits->data, dst->bits->n_words,
+                        CBITS_BITWISE_OR);
+    dst->bits->rank_dirty = true;
+    return 0;
+}
+
+int
+bloom_intersect(BloomFilter *dst, const BloomFilter *src)
+{
+    if (!bloom_compatible(dst, src)) {
+        return -1;
+    }
+    uint64_t *a = dst->bits->data;
+    if (a == src->bits->data) {
+        return 0;
+    }
+    cbits_bitwise_words(a, a, src->bits->data, dst->bits->n_words,
+                        CBITS_BITWISE_AND);
+    dst->bits->rank_dirty = true;
+    return 0;
+}
+
+double
+bloom_estimate_count(const BloomFilter *f)
+{
+    const double m = (double) f->bits->n_bits;
+    const double x = (double) bv_count(f->bits);
+    if (x >= m) {
+        return INFINITY;
+    }
+    return -m / f->n_hashes * log1p(-x / m);
+}
+
+/* Serialization */
+
+uint8_t *
+bloom_serialize(const BloomFilter *f, size_t *n_bytes)
+{
+    const size_t n_words = f->bits->n_words;
+    if (n_words > (SIZE_MAX - BLOOM_HEADER_BYTES) / sizeof(uint64_t)) {
+        return NULL;
+    }
+    const size_t total = BLOOM_HEADER_BYTES + n_words * sizeof(uint64_t);
+    /* Owned by the caller, who releases it with free(). */
+    uint8_t *out = malloc(total);
+    if (!out) {
+        return NULL;
+    }
+    memcpy(out, "CBBF", 4);
+    out[4] = BLOOM_FORMAT_VERSION;
+    out[5] = (uint8_t) f->layout;
+    out[6] = (uint8_t) f->hash;
+    out[7] = (uint8_t) f->n_hashes;
+    bloom__store64(out + 8, f->seed);
+    bloom__store64(out + 16, (uint64_t) f->bits->n_bits);
+    for (size_t w = 0; w < n_words; ++w) {
+        bloom__store64(out + BLOOM_HEADER_BYTES + w * sizeof(uint64_t),
+                       f->bits->data[w]);
+    }
+    *n_bytes = total;
+    return out;
+}
+
+BloomFilter *
+bloom_deserialize(const void *data, size_t n_bytes)
+{
+    const uint8_t *in = (const uint8_t *) data;
+    if (n_bytes < BLOOM_HEADER_BYTES || memcmp(in, "CBBF", 4) != 0 ||
+        in[4] != BLOOM_FORMAT_VERSION) {
+        return NULL;
+    }
+    const uint64_t n_bits = bloom__load64(in + 16);
+    if (n_bits == 0 || n_bits > SIZE_MAX - 63 ||
+        (in[5] == BLOOM_BLOCKED && n_bits % BLOOM_BLOCK_BITS)) {
+        return NULL;
+    }
+    const size_t n_words = ((size_t) n_bits + 63) >> 6;
+    if (n_words > (n_bytes - BLOOM_HEADER_BYTES) / sizeof(uint64_t) ||
+        n_bytes - BLOOM_HEADER_BYTES != n_words * sizeof(uint64_t)) {
+        return NULL;
+    }
+    BloomFilter *f = bloom_new((BloomLayout) in[5], (size_t) n_bits, in[7],
+                               (KeyHash) in[6], bloom__load64(in + 8));
+    if (!f) {
+        return NULL;
+    }
+    for (size_t w = 0; w < n_words; ++w) {
+        f->bits->data[w] =
+            bloom__load64(in + BLOOM_HEADER_BYTES + w * sizeof(uint64_t));
+    }
+    /* Bits past n_bits are never set by a valid filter. */
+    const uint64_t last = f->bits->data[n_words - 1];
+    bv_apply_tail_mask(f->bits);
+    if (f->bits->data[n_words - 1] != last) {
+        bloom_free(f);
+        return NULL;
+    }
+    return f;
+}
+
+size_t
+bloom_memory_usage(const BloomFilter *f)
+{
+    if (!f) {
+        return 0;
+    }
+    const BitVector *bits = f->bits;
+    size_t n_super = (bits->n_words + BV_WORDS_SUPER - 1) >>
+                     BV_WORDS_SUPER_SHIFT;
+    return sizeof(BloomFilter) + sizeof(BitVector) +
+           (bits->n_words + 1) * sizeof(uint64_t) +
+           n_super * sizeof(size_t) + bits->n_words * sizeof(uint16_t);
+}
@@ -0,0 +1,496 @@
+/**
+ * @file src/cbits/bp_tree.c
+ * @brief Range min-max tree construction and parentheses searches.
+ *
+ * This module implements:
+ * - \ref bp_new, \ref bp_free
+ * - forward and backward excess searches (block scan + tree climb)
+ * - \ref bp_find_close, \ref bp_find_open, \ref bp_enclose
+ * - the derived tree operations
+ *
+ * Inside a block, bits are consumed a byte at a time: per byte value the
+ * tables below hold its total excess and the minimum and maximum prefix
+ * excess. Because the excess moves by exactly one per bit, a target lies in
+ * a byte (or block) exactly when it lies between that byte's minimum and
+ * maximum, so only the hit byte is scanned bit by bit.
+ *
+ * @see bp_tree.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bp_tree.h"
+#include "bitvector_internal.h"
+
+/** @brief Total excess of every byte value (bit 0 first). */
+static const int8_t bp_byte_excess[256] = {
+    -8, -6, -6, -4, -6, -4, -4, -2, -6, -4, -4, -2, -4, -2, -2, 0, -6, -4, -4,
+    -2, -4, -2, -2, 0, -4, -2, -2, 0, -2, 0, 0, 2, -6, -4, -4, -2, -4, -2, -2,
+    0, -4, -2, -2, 0, -2, 0, 0, 2, -4, -2, -2, 0, -2, 0, 0, 2, -2, 0, 0, 2, 0,
+    2, 2, 4, -6, -4, -4, -2, -4, -2, -2, 0, -4, -2, -2, 0, -2, 0, 0, 2, -4, -2,
+    -2, 0, -2, 0, 0, 2, -2, 0, 0, 2, 0, 2, 2, 4, -4, -2, -2, 0, -2, 0, 0, 2,
+    -2, 0, 0, 2, 0, 2, 2, 4, -2, 0, 0, 2, 0, 2, 2, 4, 0, 2, 2, 4, 2, 4, 4, 6,
+    -6, -4, -4, -2, -4, -2, -2, 0, -4, -2, -2, 0, -2, 0, 0, 2, -4, -2, -2, 0,
+    -2, 0, 0, 2, -2, 0, 0, 2, 0, 2, 2, 4, -4, -2, -2, 0, -2, 0, 0, 2, -2, 0, 0,
+    2, 0, 2, 2, 4, -2, 0, 0, 2, 0, 2, 2, 4, 0, 2, 2, 4, 2, 4, 4, 6, -4, -2, -2,
+    0, -2, 0, 0, 2, -2, 0, 0, 2, 0, 2, 2, 4, -2, 0, 0, 2, 0, 2, 2, 4, 0, 2, 2,
+    4, 2, 4, 4, 6, -2, 0, 0, 2, 0, 2, 2, 4, 0, 2, 2, 4, 2, 4, 4, 6, 0, 2, 2, 4,
+    2, 4, 4, 6, 2, 4, 4, 6, 4, 6, 6, 8
+};
+
+/** @brief Minimum prefix excess of every byte value. */
+static const int8_t bp_byte_min[256] = {
+    -8, -6, -6, -4, -6, -4, -4, -2, -6, -4, -4, -2, -4, -2, -2, 0, -6, -4, -4,
+    -2, -4, -2, -2, 0, -4, -2, -2, 0, -2, 0, -1, 1, -6, -4, -4, -2, -4, -2, -2,
+    0, -4, -2, -2, 0, -2, 0, -1, 1, -4, -2, -2, 0, -2, 0, -1, 1, -3, -1, -1, 1,
+    -2, 0, -1, 1, -6, -4, -4, -2, -4, -2, -2, 0, -4, -2, -2, 0, -2, 0, -1, 1,
+    -4, -2, -2, 0, -2, 0, -1, 1, -3, -1, -1, 1, -2, 0, -1, 1, -5, -3, -3, -1,
+    -3, -1, -1, 1, -3, -1, -1, 1, -2, 0, -1, 1, -4, -2, -2, 0, -2, 0, -1, 1,
+    -3, -1, -1, 1, -2, 0, -1, 1, -7, -5, -5, -3, -5, -3, -3, -1, -5, -3, -3,
+    -1, -3, -1, -1, 1, -5, -3, -3, -1, -3, -1, -1, 1, -3, -1, -1, 1, -2, 0, -1,
+    1, -5, -3, -3, -1, -3, -1, -1, 1, -3, -1, -1, 1, -2, 0, -1, 1, -4, -2, -2,
+    0, -2, 0, -1, 1, -3, -1, -1, 1, -2, 0, -1, 1, -6, -4, -4, -2, -4, -2, -2,
+    0, -4, -2, -2, 0, -2, 0, -1, 1, -4, -2, -2, 0, -2, 0, -1, 1, -3, -1, -1, 1,
+    -2, 0, -1, 1, -5, -3, -3, -1, -3, -1, -1, 1, -3, -1, -1, 1, -2, 0, -1, 1,
+    -4, -2, -2, 0, -2, 0, -1, 1, -3, -1, -1, 1, -2, 0, -1, 1
+};
+
+/** @brief Maximum prefix excess of every byte value. */
+static const int8_t bp_byte_max[256] = {
+    -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 0, 2, 0, 2, 2, 4, -1, 1, 0, 2, -1, 1, 1,
+    3, -1, 1, 1, 3, 1, 3, 3, 5, -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 0, 2, 0, 2, 2,
+    4, -1, 1, 0, 2, 0, 2, 2, 4, 0, 2, 2, 4, 2, 4, 4, 6, -1, 1, 0, 2, -1, 1, 1,
+    3, -1, 1, 0, 2, 0, 2, 2, 4, -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 1, 3, 1, 3, 3,
+    5, -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 1, 3, 1, 3, 3, 5, -1, 1, 1, 3, 1, 3, 3,
+    5, 1, 3, 3, 5, 3, 5, 5, 7, -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 0, 2, 0, 2, 2,
+    4, -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 1, 3, 1, 3, 3, 5, -1, 1, 0, 2, -1, 1,
+    1, 3, -1, 1, 0, 2, 0, 2, 2, 4, -1, 1, 0, 2, 0, 2, 2, 4, 0, 2, 2, 4, 2, 4,
+    4, 6, -1, 1, 0, 2, -1, 1, 1, 3, -1, 1, 0, 2, 0, 2, 2, 4, -1, 1, 0, 2, 0, 2,
+    2, 4, 0, 2, 2, 4, 2, 4, 4, 6, -1, 1, 0, 2, 0, 2, 2, 4, 0, 2, 2, 4, 2, 4, 4,
+    6, 0, 2, 2, 4, 2, 4, 4, 6, 2, 4, 4, 6, 4, 6, 6, 8
+};
+
+/**
+ * @brief Excess change of the bit at @p pos.
+ * @param data Word array.
+ * @param pos Bit index.
+ * @return @c +1 for '(' and @c -1 for ')'.
+ */
+static inline int64_t
+bp_step(const uint64_t *data, size_t pos)
+{
+    return ((data[bv_word(pos)] >> bv_bit(pos)) & 1) ? 1 : -1;
+}
+
+/**
+ * @brief Byte of the sequence starting at a byte-aligned position.
+ * @param data Word array.
+ * @param pos Bit index, a multiple of 8.
+ * @return The eight bits at @c [pos, pos + 8).
+ */
+static inline unsigned
+bp_byte(const uint64_t *data, size_t pos)
+{
+    return (unsigned) (data[bv_word(pos)] >> bv_bit(pos)) & 0xFF;
+}
+
+/**
+ * @brief Excess of the first @p k bits, <tt>E(k)</tt>.
+ * @param bp Pointer to the BPTree.
+ * @param k Prefix length (at most the sequence length).
+ * @return Opening minus closing parentheses in @c [0, k).
+ */
+static inline int64_t
+bp_prefix_excess(const BPTree *bp, size_t k)
+{
+    if (k == 0) {
+        return 0;
+    }
+    size_t ones = bv_rank(bp->bv, k - 1);
+    return 2 * (int64_t) ones - (int64_t) k;
+}
+
+/**
+ * @brief Excess at the start of a block, read from @c super_rank.
+ * @param bp Pointer to the BPTree.
+ * @param b Block index.
+ * @return <tt>E(b * BP_BLOCK_BITS)</tt>.
+ */
+static inline int64_t
+bp_block_excess(const BPTree *bp, size_t b)
+{
+    return 2 * (int64_t) bp->bv->super_rank[b] -
+           (int64_t) (b * BP_BLOCK_BITS);
+}
+
+/**
+ * @brief Whether a tree node's excess range contains @p t.
+ * @param bp Pointer to the BPTree.
+ * @param node Node index (1-based heap order).
+ * @param t Target excess.
+ * @return @c true if some position below @p node reaches @p t.
+ */
+static inline bool
+bp_node_contains(const BPTree *bp, size_t node, int64_t t)
+{
+    return bp->node_min[node] <= t && t <= bp->node_max[node];
+}
+
+/**
+ * @brief First position in @c [q, end) after which the excess equals @p t.
+ * @param data Word array.
+ * @param q First position.
+ * @param end One past the last position.
+ * @param e Excess before @p q, <tt>E(q)</tt>.
+ * @param t Target excess.
+ * @return Smallest @c p with <tt>E(p + 1) == t</tt>, or @c SIZE_MAX.
+ */
+static size_t
+bp_scan_fwd(const uint64_t *data, size_t q, size_t end, int64_t e,
+            int64_t t)
+{
+    while (q < end && (q & 7)) {
+        e += bp_step(data, q);
+        if (e == t) {
+            return q;
+        }
+        ++q;
+    }
+    while (q + 8 <= end) {
+        unsigned byte = bp_byte(data, q);
+        if (e + bp_byte_min[byte] <= t && t <= e + bp_byte_max[byte]) {
+            break;
+        }
+        e += bp_byte_excess[byte];
+        q += 8;
+    }
+    for (; q < end; ++q) {
+        e += bp_step(data, q);
+        if (e == t) {
+            return q;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Last position in @c [lo, q) after which the excess equals @p t.
+ * @param data Word array.
+ * @param lo First position, a multiple of 8.
+ * @param q One past the last position.
+ * @param e Excess before @p q, <tt>E(q)</tt>.
+ * @param t Target excess.
+ * @return Largest @c p with <tt>E(p + 1) == t</tt>, or @c SIZE_MAX.
+ */
+static size_t
+bp_scan_bwd(const uint64_t *data, size_t lo, size_t q, int64_t e,
+            int64_t t)
+{
+    while (q > lo && (q & 7)) {
+        if (e == t) {
+            return q - 1;
+        }
+        e -= bp_step(data, q - 1);
+        --q;
+    }
+    while (q >= lo + 8) {
+        unsigned byte = bp_byte(data, q - 8);
+        int64_t base = e - bp_byte_excess[byte];
+        if (base + bp_byte_min[byte] <= t && t <= base + bp_byte_max[byte]) {
+            break;
+        }
+        e = base;
+        q -= 8;
+    }
+    for (; q > lo; --q) {
+        if (e == t) {
+            return q - 1;
+        }
+        e -= bp_step(data, q - 1);
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Forward search: first position @c p >= @p q with
+ *        <tt>E(p + 1) == t</tt>.
+ * @param bp Pointer to the BPTree.
+ * @param q First position.
+ * @param t Target excess.
+ * @return Position, or @c SIZE_MAX if the excess never reaches @p t.
+ */
+static size_t
+bp_fwd_search(const BPTree *bp, size_t q, int64_t t)
+{
+    const size_t n = bp->bv->n_bits;
+    const uint64_t *data = bp->bv->data;
+    if (q >= n) {
+        return SIZE_MAX;
+    }
+    size_t b = q / BP_BLOCK_BITS;
+    size_t end = (b + 1) * BP_BLOCK_BITS;
+    size_t p = bp_scan_fwd(data, q, end < n ? end : n,
+                           bp_prefix_excess(bp, q), t);
+    if (p != SIZE_MAX) {
+        return p;
+    }
+
+    /* Climb to the nearest right subtree reaching t, then descend. */
+    size_t node = bp->n_leaves + b;
+    for (;;) {
+        if (node == 1) {
+            return SIZE_MAX;
+        }
+        if (!(node & 1) && bp_node_contains(bp, node + 1, t)) {
+            node++;
+            break;
+        }
+        node >>= 1;
+    }
+    while (node < bp->n_leaves) {
+        node = bp_node_contains(bp, 2 * node, t) ? 2 * node : 2 * node + 1;
+    }
+    b = node - bp->n_leaves;
+    size_t start = b * BP_BLOCK_BITS;
+    end = start + BP_BLOCK_BITS;
+    return bp_scan_fwd(data, start, end < n ? end : n,
+                       bp_block_excess(bp, b), t);
+}
+
+/**
+ * @brief Backward search: last position @c p < @p q with
+ *        <tt>E(p + 1) == t</tt>.
+ * @param bp Pointer to the BPTree.
+ * @param q One past the last position considered.
+ * @param t Target excess.
+ * @return Position, or @c SIZE_MAX if no such position exists.
+ */
+static size_t
+bp_bwd_search(const BPTree *bp, size_t q, int64_t t)
+{
+    const size_t n = bp->bv->n_bits;
+    const uint64_t *data = bp->bv->data;
+    if (q == 0) {
+        return SIZE_MAX;
+    }
+    size_t b = (q - 1) / BP_BLOCK_BITS;
+    size_t p = bp_scan_bwd(data, b * BP_BLOCK_BITS, q,
+                           bp_prefix_excess(bp, q), t);
+    if (p != SIZE_MAX) {
+        return p;
+    }
+
+    /* Climb to the nearest left subtree reaching t, then descend. */
+    size_t node = bp->n_leaves + b;
+    for (;;) {
+        if (node == 1) {
+            return SIZE_MAX;
+        }
+        if ((node & 1) && bp_node_contains(bp, node - 1, t)) {
+            node--;
+            break;
+        }
+        node >>= 1;
+    }
+    while (node < bp->n_leaves) {
+        node = bp_node_contains(bp, 2 * node + 1, t) ? 2 * node + 1
+                                                      : 2 * node;
+    }
+    b = node - bp->n_leaves;
+    size_t start = b * BP_BLOCK_BITS;
+    size_t end = start + BP_BLOCK_BITS < n ? start + BP_BLOCK_BITS : n;
+    return bp_scan_bwd(data, start, end, bp_prefix_excess(bp, end), t);
+}
+
+/**
+ * @brief Fill the leaves and inner nodes of the min-max tree.
+ * @param bp Index whose BitVector copy has fresh rank tables.
+ */
+static void
+bp_build_tree(BPTree *bp)
+{
+    const size_t n = bp->bv->n_bits;
+    const uint64_t *data = bp->bv->data;
+
+    for (size_t b = 0; b < bp->n_leaves; ++b) {
+        int64_t lo = INT64_MAX, hi = INT64_MIN;
+        if (b < bp->n_blocks) {
+            size_t q = b * BP_BLOCK_BITS;
+            size_t end = q + BP_BLOCK_BITS < n ? q + BP_BLOCK_BITS : n;
+            int64_t e = bp_block_excess(bp, b);
+            for (; q + 8 <= end; q += 8) {
+                unsigned byte = bp_byte(data, q);
+                if (e + bp_byte_min[byte] < lo) {
+                    lo = e + bp_byte_min[byte];
+                }
+                if (e + bp_byte_max[byte] > hi) {
+                    hi = e + bp_byte_max[byte];
+                }
+                e += bp_byte_excess[byte];
+            }
+            for (; q < end; ++q) {
+                e += bp_step(data, q);
+                lo = e < lo ? e : lo;
+                hi = e > hi ? e : hi;
+            }
+        }
+        bp->node_min[bp->n_leaves + b] = lo;
+        bp->node_max[bp->n_leaves + b] = hi;
+    }
+    for (size_t node = bp->n_leaves - 1; node >= 1; --node) {
+        int64_t l_min = bp->node_min[2 * node];
+        int64_t r_min = bp->node_min[2 * node + 1];
+        int64_t l_max = bp->node_max[2 * node];
+        int64_t r_max = bp->node_max[2 * node + 1];
+        bp->node_min[node] = l_min < r_min ? l_min : r_min;
+        bp->node_max[node] = l_max > r_max ? l_max : r_max;
+    }
+}
+
+BPTree *
+bp_new(const BitVector *bv)
+{
+    BPTree *bp = cbits_calloc(1, sizeof(BPTree));
+    if (!bp) {
+        return NULL;
+    }
+    bp->bv = bv_copy(bv);
+    if (!bp->bv) {
+        bp_free(bp);
+        return NULL;
+    }
+    bv_build_rank(bp->bv);
+
+    bp->n_blocks = (bv->n_bits + BP_BLOCK_BITS - 1) / BP_BLOCK_BITS;
+    bp->n_leaves = 1;
+    while (bp->n_leaves < bp->n_blocks) {
+        bp->n_leaves <<= 1;
+    }
+    bp->node_min = cbits_malloc(2 * bp->n_leaves * sizeof(int64_t));
+    bp->node_max = cbits_malloc(2 * bp->n_leaves * sizeof(int64_t));
+    if (!bp->node_min || !bp->node_max) {
+        bp_free(bp);
+        return NULL;
+    }
+    bp_build_tree(bp);
+    return bp;
+}
+
+void
+bp_free(BPTree *bp)
+{
+    if (!bp) {
+        return;
+    }
+    cbits_free(bp->node_min);
+    cbits_free(bp->node_max);
+    bv_free(bp->bv);
+    cbits_free(bp);
+}
+
+/**
+ * @brief Whether position @p i holds an opening parenthesis.
+ * @param bp Pointer to the BPTree.
+ * @param i Bit index.
+ * @return @c true for '(' at a valid position.
+ */
+static inline bool
+bp_is_open(const BPTree *bp, size_t i)
+{
+    return bv_get(bp->bv, i) == 1;
+}
+
+int64_t
+bp_excess(const BPTree *bp, size_t i)
+{
+    const size_t n = bp->bv->n_bits;
+    return bp_prefix_excess(bp, i < n ? i + 1 : n);
+}
+
+size_t
+bp_find_close(const BPTree *bp, size_t i)
+{
+    if (!bp_is_open(bp, i)) {
+        return SIZE_MAX;
+    }
+    return bp_fwd_search(bp, i + 1, bp_prefix_excess(bp, i));
+}
+
+size_t
+bp_find_open(const BPTree *bp, size_t i)
+{
+    if (bv_get(bp->bv, i) != 0) {
+        return SIZE_MAX;
+    }
+    /* The match j is the last prefix length j <= i with E(j) == E(i + 1). */
+    int64_t t = bp_prefix_excess(bp, i + 1);
+    size_t p = bp_bwd_search(bp, i, t);
+    if (p != SIZE_MAX) {
+        return p + 1;
+    }
+    return t == 0 ? 0 : SIZE_MAX;
+}
+
+size_t
+bp_enclose(const BPTree *bp, size_t i)
+{
+    if (!bp_is_open(bp, i)) {
+        return SIZE_MAX;
+    }
+    int64_t t = bp_prefix_excess(bp, i) - 1;
+    size_t p = bp_bwd_search(bp, i, t);
+    if (p != SIZE_MAX) {
+        return p + 1;
+    }
+    return t == 0 && i > 0 ? 0 : SIZE_MAX;
+}
+
+size_t
+bp_parent(const BPTree *bp, size_t v)
+{
+    return bp_enclose(bp, v);
+}
+
+size_t
+bp_first_child(const BPTree *bp, size_t v)
+{
+    if (!bp_is_open(bp, v)) {
+        return SIZE_MAX;
+    }
+    return bp_is_open(bp, v + 1) ? v + 1 : SIZE_MAX;
+}
+
+size_t
+bp_next_sibling(const BPTree *bp, size_t v)
+{
+    size_t close = bp_find_close(bp, v);
+    if (close == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return bp_is_open(bp, close + 1) ? close + 1 : SIZE_MAX;
+}
+
+size_t
+bp_subtree_size(const BPTree *bp, size_t v)
+{
+    size_t close = bp_find_close(bp, v);
+    if (close == SIZE_MAX) {
+        return 0;
+    }
+    return (close - v + 1) / 2;
+}
+
+size_t
+bp_memory_usage(const BPTree *bp)
+{
+    if (!bp) {
+        return 0;
+    }
+    const BitVector *bv = bp->bv;
+    size_t n_super =
+        (bv->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+    return sizeof(BPTree) + sizeof(BitVector) +
+           (bv->n_words + 1) * sizeof(uint64_t) + n_super * sizeof(size_t) +
+           bv->n_words * sizeof(uint16_t) +
+           4 * bp->n_leaves * sizeof(int64_t);
+}
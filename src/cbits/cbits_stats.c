@@ -0,0 +1,85 @@
+/**
+ * @file src/cbits/cbits_stats.c
+ * @brief Storage, names and readout of the hot-path counters.
+ *
+ * This module implements:
+ * - \ref cbits_stat_name
+ * - \ref cbits_stats_enabled
+ * - \ref cbits_stats_read
+ * - \ref cbits_stats_reset
+ * - \ref cbits_live_bytes
+ *
+ * @see cbits_stats.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "cbits_stats.h"
+
+#include <stddef.h>
+
+uint64_t cbits_stats_counters[CBITS_STAT_COUNT];
+uint64_t cbits_live_total;
+
+/** @brief Names indexed by @ref cbits_stat. */
+static const char *const cbits_stat_names[CBITS_STAT_COUNT] = {
+    "rank_builds",
+    "rank_words",
+    "allocs",
+    "alloc_bytes",
+    "frees",
+    "free_bytes",
+    "bitwise_bytes",
+    "search_calls",
+    "search_windows",
+    "search_verify",
+    "hash_bytes",
+    "slice_copies",
+    "slice_bits",
+};
+
+const char *
+cbits_stat_name(cbits_stat stat)
+{
+    if ((int) stat < 0 || stat >= CBITS_STAT_COUNT) {
+        return NULL;
+    }
+    return cbits_stat_names[stat];
+}
+
+int
+cbits_stats_enabled(void)
+{
+    return CBITS_STATS;
+}
+
+uint64_t
+cbits_stats_read(cbits_stat stat, int reset)
+{
+    if ((int) stat < 0 || stat >= CBITS_STAT_COUNT) {
+        return 0;
+    }
+    uint64_t *counter = &cbits_stats_counters[stat];
+    if (!reset) {
+        return cbits_atomic_load_u64(counter);
+    }
+#if defined(_MSC_VER)
+    return (uint64_t) _InterlockedExchange64((volatile __int64 *) counter, 0);
+#else
+    return __atomic_exchange_n(counter, 0, __ATOMIC_RELAXED);
+#endif
+}
+
+void
+cbits_stats_reset(void)
+{
+    for (int s = 0; s < CBITS_STAT_COUNT; ++s) {
+        cbits_stats_read((cbits_stat) s, 1);
+    }
+}
+
+size_t
+cbits_live_bytes(void)
+{
+    return (size_t) cbits_atomic_load_u64(&cbits_live_total);
+}
@@ -0,0 +1,1484 @@
+/**
+ * @file src/cbits/compressed_bitvector.c
+ * @brief Roaring-style compressed bitmap containers.
+ *
+ * This module implements:
+ * - container management (array, bitmap and run containers)
+ * - \ref cbv_new, \ref cbv_copy, \ref cbv_free
+ * - single bit operations (\ref cbv_get, \ref cbv_set, \ref cbv_clear, \ref
+ * cbv_flip)
+ * - \ref cbv_rank, \ref cbv_select and \ref cbv_count
+ * - bitwise operations between vectors
+ * - conversion from and to \ref BitVector
+ *
+ * Mutations keep array containers at or below @ref CBV_ARRAY_MAX entries and
+ * bitmaps above it. Run containers are only produced by conversion and
+ * @ref cbv_optimize; mutating a run container first turns it back into an
+ * array or bitmap.
+ *
+ * @see compressed_bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "compressed_bitvector.h"
+#include "bitvector_internal.h"
+#include <string.h>
+
+/** @brief Size in bytes of a bitmap container. */
+#define CBV_BITMAP_BYTES (CBV_BITMAP_WORDS * sizeof(uint64_t))
+
+/**
+ * @brief Binary operation selector for \ref cbv_binary_op.
+ */
+typedef enum {
+    CBV_OP_AND,
+    CBV_OP_OR,
+    CBV_OP_XOR,
+    CBV_OP_ANDNOT,
+} cbv_op;
+
+/* -------------------------------------------------------------------------
+ * Raw word helpers
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Allocate an uninitialized, cache-line aligned bitmap.
+ * @return Pointer to @ref CBV_BITMAP_WORDS words, or NULL.
+ */
+static inline uint64_t *
+bitmap_alloc(void)
+{
+    return cbits_malloc_aligned(CBV_BITMAP_BYTES, BV_ALIGN);
+}
+
+/**
+ * @brief Release a bitmap from @ref bitmap_alloc.
+ * @param w Bitmap to free (may be NULL).
+ */
+static inline void
+bitmap_free(uint64_t *w)
+{
+    cbits_free_aligned(w, CBV_BITMAP_BYTES);
+}
+
+/**
+ * @brief Count the set bits of a full bitmap using the block dispatch.
+ * @param w Aligned bitmap of @ref CBV_BITMAP_WORDS words.
+ * @return Number of set bits.
+ */
+static inline uint32_t
+bitmap_cardinality(const uint64_t *w)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < CBV_BITMAP_WORDS; i += 8) {
+        sum += cbits_popcount_block(&w[i]);
+    }
+    return (uint32_t) sum;
+}
+
+/**
+ * @brief Count the maximal runs of set bits in a bitmap.
+ * @param w Bitmap of @ref CBV_BITMAP_WORDS words.
+ * @return Number of runs.
+ */
+static uint32_t
+bitmap_count_runs(const uint64_t *w)
+{
+    uint64_t runs = 0;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < CBV_BITMAP_WORDS; ++i) {
+        uint64_t word = w[i];
+        runs += cbits_popcount64(word & ~((word << 1) | carry));
+        carry = word >> 63;
+    }
+    return (uint32_t) runs;
+}
+
+/**
+ * @brief Set all bits in the half-open range [start, end) of a word array.
+ * @param w Word array.
+ * @param start First bit to set.
+ * @param end One past the last bit to set.
+ */
+static void
+words_set_range(uint64_t *w, size_t start, size_t end)
+{
+    if (start >= end) {
+        return;
+    }
+    size_t w_start = start >> 6;
+    size_t w_end = (end - 1) >> 6;
+    uint64_t first = ~0ULL << (start & 63);
+    uint64_t last = ~0ULL >> (63 - ((end - 1) & 63));
+    if (w_start == w_end) {
+        w[w_start] |= first & last;
+        return;
+    }
+    w[w_start] |= first;
+    for (size_t i = w_start + 1; i < w_end; ++i) {
+        w[i] = ~0ULL;
+    }
+    w[w_end] |= last;
+}
+
+/* -------------------------------------------------------------------------
+ * Array and run search helpers
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Index of the first array entry that is not less than @p x.
+ * @param a Sorted array.
+ * @param n Number of entries.
+ * @param x Value to search.
+ * @return Insertion index in [0...n].
+ */
+static inline uint32_t
+array_lower_bound(const uint16_t *a, uint32_t n, uint32_t x)
+{
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) >> 1;
+        if (a[mid] < x) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Index of the last run whose start is not greater than @p x.
+ * @param r Run pairs (start, length - 1).
+ * @param n Number of runs.
+ * @param x Value to search.
+ * @return Run index, or -1 if every run starts after @p x.
+ */
+static inline int32_t
+run_find(const uint16_t *r, uint32_t n, uint16_t x)
+{
+    int32_t lo = 0, hi = (int32_t) n - 1, found = -1;
+    while (lo <= hi) {
+        int32_t mid = (lo + hi) >> 1;
+        if (r[2 * mid] <= x) {
+            found = mid;
+            lo = mid + 1;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+/* -------------------------------------------------------------------------
+ * Container primitives
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Release the payload of a container.
+ * @param c Container whose data should be freed.
+ */
+static void
+container_release(CBVContainer *c)
+{
+    if (c->type == CBV_CONTAINER_BITMAP) {
+        bitmap_free(c->data);
+    }
+    else {
+        cbits_free(c->data);
+    }
+    c->data = NULL;
+    c->size = c->capacity = c->cardinality = 0;
+    c->type = CBV_CONTAINER_ARRAY;
+}
+
+/**
+ * @brief Test whether a container holds the given low offset.
+ * @param c Container.
+ * @param low Offset within the chunk.
+ * @return @c true if the bit is set.
+ */
+static bool
+container_contains(const CBVContainer *c, uint16_t low)
+{
+    switch (c->type) {
+        case CBV_CONTAINER_BITMAP: {
+            const uint64_t *w = c->data;
+            return (w[low >> 6] >> (low & 63)) & 1;
+        }
+        case CBV_CONTAINER_RUN: {
+            const uint16_t *r = c->data;
+            int32_t i = run_find(r, c->size, low);
+            return i >= 0 &&
+                   (uint32_t) low <= (uint32_t) r[2 * i] + r[2 * i + 1];
+        }
+        default: {
+            const uint16_t *a = c->data;
+            uint32_t i = array_lower_bound(a, c->size, low);
+            return i < c->size && a[i] == low;
+        }
+    }
+}
+
+/**
+ * @brief Expand a container into a zeroed-then-filled bitmap.
+ * @param c Container.
+ * @param w Output bitmap of @ref CBV_BITMAP_WORDS words.
+ */
+static void
+container_to_bitmap(const CBVContainer *c, uint64_t *w)
+{
+    if (c->type == CBV_CONTAINER_BITMAP) {
+        memcpy(w, c->data, CBV_BITMAP_BYTES);
+        return;
+    }
+    memset(w, 0, CBV_BITMAP_BYTES);
+    const uint16_t *v = c->data;
+    if (c->type == CBV_CONTAINER_RUN) {
+        for (uint32_t i = 0; i < c->size; ++i) {
+            size_t start = v[2 * i];
+            words_set_range(w, start, start + v[2 * i + 1] + 1);
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < c->size; ++i) {
+        w[v[i] >> 6] |= UINT64_C(1) << (v[i] & 63);
+    }
+}
+
+/**
+ * @brief Fill an array container from a bitmap.
+ * @param c Container to fill (payload must be released).
+ * @param w Source bitmap.
+ * @param card Cardinality of @p w; must not exceed @ref CBV_ARRAY_MAX.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_array_from_bitmap(CBVContainer *c, const uint64_t *w, uint32_t card)
+{
+    uint16_t *a = cbits_malloc((card ? card : 1) * sizeof(uint16_t));
+    if (!a) {
+        return -1;
+    }
+    uint32_t n = 0;
+    for (size_t i = 0; i < CBV_BITMAP_WORDS && n < card; ++i) {
+        uint64_t word = w[i];
+        while (word) {
+            a[n++] = (uint16_t) ((i << 6) + cbits_ctz64(word));
+            word &= word - 1;
+        }
+    }
+    c->type = CBV_CONTAINER_ARRAY;
+    c->data = a;
+    c->size = c->capacity = c->cardinality = card;
+    return 0;
+}
+
+/**
+ * @brief Fill a run container from a bitmap.
+ * @param c Container to fill (payload must be released).
+ * @param w Source bitmap.
+ * @param card Cardinality of @p w.
+ * @param n_runs Number of runs in @p w.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_run_from_bitmap(CBVContainer *c, const uint64_t *w, uint32_t card,
+                          uint32_t n_runs)
+{
+    uint16_t *r = cbits_malloc((n_runs ? n_runs : 1) * 2 * sizeof(uint16_t));
+    if (!r) {
+        return -1;
+    }
+    uint32_t n = 0;
+    size_t i = 0;
+    uint64_t cur = w[0];
+    for (;;) {
+        while (cur == 0 && i + 1 < CBV_BITMAP_WORDS) {
+            cur = w[++i];
+        }
+        if (cur == 0) {
+            break;
+        }
+        size_t start = (i << 6) + cbits_ctz64(cur);
+        cur |= cur - 1;
+        while (cur == ~0ULL && i + 1 < CBV_BITMAP_WORDS) {
+            cur = w[++i];
+        }
+        size_t end;
+        if (cur == ~0ULL) {
+            end = CBV_CHUNK_BITS;
+        }
+        else {
+            end = (i << 6) + cbits_ctz64(~cur);
+        }
+        r[2 * n] = (uint16_t) start;
+        r[2 * n + 1] = (uint16_t) (end - start - 1);
+        ++n;
+        if (end == CBV_CHUNK_BITS) {
+            break;
+        }
+        cur &= cur + 1;
+    }
+    c->type = CBV_CONTAINER_RUN;
+    c->data = r;
+    c->size = c->capacity = n;
+    c->cardinality = card;
+    return 0;
+}
+
+/**
+ * @brief Fill a container from a bitmap using array or bitmap storage.
+ *
+ * If the result is a bitmap and @p take is non-NULL, ownership of the
+ * buffer in @p *take is transferred to the container and @p *take is set to
+ * NULL; otherwise the bitmap is copied.
+ *
+ * @param c Container to fill (payload must be released).
+ * @param w Source bitmap.
+ * @param card Cardinality of @p w.
+ * @param take Optional pointer to the owning pointer of @p w.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_from_bitmap(CBVContainer *c, const uint64_t *w, uint32_t card,
+                      uint64_t **take)
+{
+    if (card <= CBV_ARRAY_MAX) {
+        return container_array_from_bitmap(c, w, card);
+    }
+    uint64_t *bm;
+    if (take && *take == w) {
+        bm = *take;
+        *take = NULL;
+    }
+    else {
+        bm = bitmap_alloc();
+        if (!bm) {
+            return -1;
+        }
+        memcpy(bm, w, CBV_BITMAP_BYTES);
+    }
+    c->type = CBV_CONTAINER_BITMAP;
+    c->data = bm;
+    c->size = c->capacity = (uint32_t) CBV_BITMAP_WORDS;
+    c->cardinality = card;
+    return 0;
+}
+
+/**
+ * @brief Fill a container from a bitmap using its smallest representation.
+ * @param c Container to fill (payload must be released).
+ * @param w Source bitmap.
+ * @param card Cardinality of @p w.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_from_bitmap_best(CBVContainer *c, const uint64_t *w, uint32_t card)
+{
+    uint32_t n_runs = bitmap_count_runs(w);
+    size_t run_bytes = (size_t) n_runs * 2 * sizeof(uint16_t);
+    size_t other_bytes = card <= CBV_ARRAY_MAX ? card * sizeof(uint16_t)
+                                               : CBV_BITMAP_BYTES;
+    if (run_bytes < other_bytes) {
+        return container_run_from_bitmap(c, w, card, n_runs);
+    }
+    return container_from_bitmap(c, w, card, NULL);
+}
+
+/**
+ * @brief Turn a run container back into an array or bitmap container.
+ * @param c Run container.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure (container unchanged).
+ */
+static int
+container_materialize(CBVContainer *c)
+{
+    uint64_t *w = bitmap_alloc();
+    if (!w) {
+        return -1;
+    }
+    container_to_bitmap(c, w);
+    CBVContainer tmp = {.key = c->key};
+    if (container_from_bitmap(&tmp, w, c->cardinality, &w) < 0) {
+        bitmap_free(w);
+        return -1;
+    }
+    bitmap_free(w);
+    container_release(c);
+    *c = tmp;
+    return 0;
+}
+
+/**
+ * @brief Add a low offset to a container.
+ * @param c Container.
+ * @param low Offset within the chunk.
+ * @retval 1 The bit was newly set.
+ * @retval 0 The bit was already set.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_add(CBVContainer *c, uint16_t low)
+{
+    if (c->type == CBV_CONTAINER_RUN) {
+        if (container_contains(c, low)) {
+            return 0;
+        }
+        if (container_materialize(c) < 0) {
+            return -1;
+        }
+    }
+    if (c->type == CBV_CONTAINER_ARRAY) {
+        uint16_t *a = c->data;
+        uint32_t i = array_lower_bound(a, c->size, low);
+        if (i < c->size && a[i] == low) {
+            return 0;
+        }
+        if (c->size < CBV_ARRAY_MAX) {
+            if (c->size == c->capacity) {
+                uint32_t cap = c->capacity ? c->capacity * 2 : 4;
+                if (cap > CBV_ARRAY_MAX) {
+                    cap = CBV_ARRAY_MAX;
+                }
+                a = cbits_realloc(a, cap * sizeof(uint16_t));
+                if (!a) {
+                    return -1;
+                }
+                c->data = a;
+                c->capacity = cap;
+            }
+            memmove(&a[i + 1], &a[i], (c->size - i) * sizeof(uint16_t));
+            a[i] = low;
+            c->size++;
+            c->cardinality++;
+            return 1;
+        }
+        uint64_t *w = bitmap_alloc();
+        if (!w) {
+            return -1;
+        }
+        container_to_bitmap(c, w);
+        uint32_t card = c->cardinality;
+        container_release(c);
+        c->type = CBV_CONTAINER_BITMAP;
+        c->data = w;
+        c->size = c->capacity = (uint32_t) CBV_BITMAP_WORDS;
+        c->cardinality = card;
+    }
+    uint64_t *w = c->data;
+    uint64_t mask = UINT64_C(1) << (low & 63);
+    if (w[low >> 6] & mask) {
+        return 0;
+    }
+    w[low >> 6] |= mask;
+    c->cardinality++;
+    return 1;
+}
+
+/**
+ * @brief Remove a low offset from a container.
+ *
+ * Bitmaps that shrink to @ref CBV_ARRAY_MAX entries are converted back into
+ * arrays when memory permits.
+ * @param c Container.
+ * @param low Offset within the chunk.
+ * @retval 1 The bit was cleared.
+ * @retval 0 The bit was not set.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_remove(CBVContainer *c, uint16_t low)
+{
+    if (c->type == CBV_CONTAINER_RUN) {
+        if (!container_contains(c, low)) {
+            return 0;
+        }
+        if (container_materialize(c) < 0) {
+            return -1;
+        }
+    }
+    if (c->type == CBV_CONTAINER_ARRAY) {
+        uint16_t *a = c->data;
+        uint32_t i = array_lower_bound(a, c->size, low);
+        if (i >= c->size || a[i] != low) {
+            return 0;
+        }
+        memmove(&a[i], &a[i + 1], (c->size - i - 1) * sizeof(uint16_t));
+        c->size--;
+        c->cardinality--;
+        return 1;
+    }
+    uint64_t *w = c->data;
+    uint64_t mask = UINT64_C(1) << (low & 63);
+    if (!(w[low >> 6] & mask)) {
+        return 0;
+    }
+    w[low >> 6] &= ~mask;
+    c->cardinality--;
+    if (c->cardinality <= CBV_ARRAY_MAX) {
+        CBVContainer tmp = {.key = c->key};
+        if (container_array_from_bitmap(&tmp, w, c->cardinality) == 0) {
+            container_release(c);
+            *c = tmp;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Count set bits at or below a low offset.
+ * @param c Container.
+ * @param low Offset within the chunk.
+ * @return Number of set bits in [0...low].
+ */
+static uint32_t
+container_rank(const CBVContainer *c, uint16_t low)
+{
+    switch (c->type) {
+        case CBV_CONTAINER_BITMAP: {
+            const uint64_t *w = c->data;
+            const size_t word = low >> 6;
+            uint64_t sum = 0;
+            size_t i = 0;
+            for (; i + 8 <= word; i += 8) {
+                sum += cbits_popcount_block(&w[i]);
+            }
+            for (; i < word; ++i) {
+                sum += cbits_popcount64(w[i]);
+            }
+            unsigned bit = low & 63;
+            uint64_t mask = (bit == 63) ? ~0ULL : ((1ULL << (bit + 1)) - 1);
+            return (uint32_t) (sum + cbits_popcount64(w[word] & mask));
+        }
+        case CBV_CONTAINER_RUN: {
+            const uint16_t *r = c->data;
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < c->size && r[2 * i] <= low; ++i) {
+                uint32_t len = r[2 * i + 1];
+                uint32_t span = (uint32_t) low - r[2 * i];
+                sum += (span < len ? span : len) + 1;
+            }
+            return sum;
+        }
+        default:
+            return array_lower_bound(c->data, c->size, (uint32_t) low + 1);
+    }
+}
+
+/**
+ * @brief Locate the k-th set bit of a container.
+ * @param c Container.
+ * @param k Zero-based index; must be below the container's cardinality.
+ * @return Low offset of the k-th set bit.
+ */
+static uint16_t
+container_select(const CBVContainer *c, uint32_t k)
+{
+    switch (c->type) {
+        case CBV_CONTAINER_BITMAP: {
+            const uint64_t *w = c->data;
+            size_t i = 0;
+            for (; i + 8 <= CBV_BITMAP_WORDS; i += 8) {
+                uint32_t cnt = (uint32_t) cbits_popcount_block(&w[i]);
+                if (k < cnt) {
+                    break;
+                }
+                k -= cnt;
+            }
+            for (;; ++i) {
+                uint32_t cnt = (uint32_t) cbits_popcount64(w[i]);
+                if (k < cnt) {
+                    return (uint16_t) ((i << 6) + bv__select_in_word(w[i], k));
+                }
+                k -= cnt;
+            }
+        }
+        case CBV_CONTAINER_RUN: {
+            const uint16_t *r = c->data;
+            for (uint32_t i = 0;; ++i) {
+                uint32_t len = r[2 * i + 1];
+                if (k <= len) {
+                    return (uint16_t) (r[2 * i] + k);
+                }
+                k -= len + 1;
+            }
+        }
+        default:
+            return ((const uint16_t *) c->data)[k];
+    }
+}
+
+/**
+ * @brief Deep-copy a container.
+ * @param dst Destination container (overwritten).
+ * @param src Source container.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_clone(CBVContainer *dst, const CBVContainer *src)
+{
+    *dst = *src;
+    if (src->type == CBV_CONTAINER_BITMAP) {
+        dst->data = bitmap_alloc();
+        if (!dst->data) {
+            return -1;
+        }
+        memcpy(dst->data, src->data, CBV_BITMAP_BYTES);
+        return 0;
+    }
+    size_t elem = src->type == CBV_CONTAINER_RUN ? 2 * sizeof(uint16_t)
+                                                 : sizeof(uint16_t);
+    size_t n = src->size ? src->size : 1;
+    dst->data = cbits_malloc(n * elem);
+    if (!dst->data) {
+        return -1;
+    }
+    memcpy(dst->data, src->data, src->size * elem);
+    dst->capacity = src->size;
+    return 0;
+}
+
+/**
+ * @brief Test whether two containers hold the same set of offsets.
+ * @param a First container.
+ * @param b Second container.
+ * @return @c true if both contain identical bits.
+ */
+static bool
+container_equal(const CBVContainer *a, const CBVContainer *b)
+{
+    if (a->cardinality != b->cardinality) {
+        return false;
+    }
+    if (a->type == b->type) {
+        size_t bytes = a->type == CBV_CONTAINER_BITMAP ? CBV_BITMAP_BYTES
+                       : a->type == CBV_CONTAINER_RUN
+                           ? a->size * 2 * sizeof(uint16_t)
+                           : a->size * sizeof(uint16_t);
+        if (a->size != b->size) {
+            return false;
+        }
+        return memcmp(a->data, b->data, bytes) == 0;
+    }
+    if (a->type == CBV_CONTAINER_BITMAP) {
+        const CBVContainer *t = a;
+        a = b;
+        b = t;
+    }
+    /* a is now an array or run container; equal cardinality means that
+     * finding every element of a in b proves equality. */
+    const uint16_t *v = a->data;
+    if (a->type == CBV_CONTAINER_RUN) {
+        for (uint32_t i = 0; i < a->size; ++i) {
+            uint32_t end = (uint32_t) v[2 * i] + v[2 * i + 1];
+            for (uint32_t x = v[2 * i]; x <= end; ++x) {
+                if (!container_contains(b, (uint16_t) x)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    for (uint32_t i = 0; i < a->size; ++i) {
+        if (!container_contains(b, v[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* -------------------------------------------------------------------------
+ * Container directory
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Find the slot of a container by key.
+ * @param cbv Vector to search.
+ * @param key Chunk key.
+ * @param found Output: set to @c true if the key exists.
+ * @return Index of the container, or its insertion index if not found.
+ */
+static size_t
+cbv_find(const CompressedBitVector *cbv, size_t key, bool *found)
+{
+    size_t lo = 0, hi = cbv->n_containers;
+    while (lo < hi) {
+        size_t mid = (lo + hi) >> 1;
+        if (cbv->containers[mid].key < key) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    *found = lo < cbv->n_containers && cbv->containers[lo].key == key;
+    return lo;
+}
+
+/**
+ * @brief Ensure room for a given number of container slots.
+ * @param cbv Vector to grow.
+ * @param need Required number of slots.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+cbv_reserve(CompressedBitVector *cbv, size_t need)
+{
+    if (need <= cbv->capacity) {
+        return 0;
+    }
+    size_t cap = cbv->capacity ? cbv->capacity * 2 : 4;
+    if (cap < need) {
+        cap = need;
+    }
+    CBVContainer *c =
+        cbits_realloc(cbv->containers, cap * sizeof(CBVContainer));
+    if (!c) {
+        return -1;
+    }
+    cbv->containers = c;
+    cbv->capacity = cap;
+    return 0;
+}
+
+/**
+ * @brief Insert an empty array container at a given slot.
+ * @param cbv Vector to modify.
+ * @param idx Insertion index.
+ * @param key Chunk key of the new container.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+cbv_insert_at(CompressedBitVector *cbv, size_t idx, size_t key)
+{
+    if (cbv_reserve(cbv, cbv->n_containers + 1) < 0) {
+        return -1;
+    }
+    memmove(&cbv->containers[idx + 1], &cbv->containers[idx],
+            (cbv->n_containers - idx) * sizeof(CBVContainer));
+    CBVContainer *c = &cbv->containers[idx];
+    memset(c, 0, sizeof(*c));
+    c->key = key;
+    c->type = CBV_CONTAINER_ARRAY;
+    cbv->n_containers++;
+    return 0;
+}
+
+/**
+ * @brief Free and remove the container at a given slot.
+ * @param cbv Vector to modify.
+ * @param idx Index of the container.
+ */
+static void
+cbv_remove_at(CompressedBitVector *cbv, size_t idx)
+{
+    container_release(&cbv->containers[idx]);
+    memmove(&cbv->containers[idx], &cbv->containers[idx + 1],
+            (cbv->n_containers - idx - 1) * sizeof(CBVContainer));
+    cbv->n_containers--;
+}
+
+/**
+ * @brief Rebuild the container prefix-cardinality table.
+ * @param cbv Vector whose table to rebuild.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+cbv_build_rank(CompressedBitVector *cbv)
+{
+    size_t *p = cbits_realloc(cbv->card_prefix,
+                        (cbv->capacity + 1) * sizeof(size_t));
+    if (!p) {
+        return -1;
+    }
+    cbv->card_prefix = p;
+    size_t acc = 0;
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        p[i] = acc;
+        acc += cbv->containers[i].cardinality;
+    }
+    p[cbv->n_containers] = acc;
+    cbv->rank_dirty = false;
+    return 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ------------------------------------------------------------------------- */
+
+CompressedBitVector *
+cbv_new(size_t n_bits)
+{
+    CompressedBitVector *cbv = cbits_calloc(1, sizeof(CompressedBitVector));
+    if (!cbv) {
+        return NULL;
+    }
+    cbv->n_bits = n_bits;
+    cbv->rank_dirty = true;
+    return cbv;
+}
+
+CompressedBitVector *
+cbv_copy(const CompressedBitVector *src)
+{
+    if (!src) {
+        return NULL;
+    }
+    CompressedBitVector *dst = cbv_new(src->n_bits);
+    if (!dst) {
+        return NULL;
+    }
+    if (cbv_reserve(dst, src->n_containers) < 0) {
+        cbv_free(dst);
+        return NULL;
+    }
+    for (size_t i = 0; i < src->n_containers; ++i) {
+        if (container_clone(&dst->containers[i], &src->containers[i]) < 0) {
+            cbv_free(dst);
+            return NULL;
+        }
+        dst->n_containers++;
+    }
+    return dst;
+}
+
+void
+cbv_free(CompressedBitVector *cbv)
+{
+    if (!cbv) {
+        return;
+    }
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        container_release(&cbv->containers[i]);
+    }
+    cbits_free(cbv->containers);
+    cbits_free(cbv->card_prefix);
+    cbits_free(cbv);
+}
+
+int
+cbv_get(const CompressedBitVector *cbv, size_t pos)
+{
+    if (!cbv || pos >= cbv->n_bits) {
+        return -1;
+    }
+    bool found;
+    size_t idx = cbv_find(cbv, pos >> CBV_CHUNK_SHIFT, &found);
+    if (!found) {
+        return 0;
+    }
+    return container_contains(&cbv->containers[idx], (uint16_t) pos);
+}
+
+int
+cbv_set(CompressedBitVector *cbv, size_t pos)
+{
+    if (!cbv || pos >= cbv->n_bits) {
+        return -1;
+    }
+    bool found;
+    const size_t key = pos >> CBV_CHUNK_SHIFT;
+    size_t idx = cbv_find(cbv, key, &found);
+    if (!found && cbv_insert_at(cbv, idx, key) < 0) {
+        return -1;
+    }
+    int rc = container_add(&cbv->containers[idx], (uint16_t) pos);
+    if (rc < 0) {
+        if (!found) {
+            cbv_remove_at(cbv, idx);
+        }
+        return -1;
+    }
+    if (rc) {
+        cbv->rank_dirty = true;
+    }
+    return 0;
+}
+
+int
+cbv_clear(CompressedBitVector *cbv, size_t pos)
+{
+    if (!cbv || pos >= cbv->n_bits) {
+        return -1;
+    }
+    bool found;
+    size_t idx = cbv_find(cbv, pos >> CBV_CHUNK_SHIFT, &found);
+    if (!found) {
+        return 0;
+    }
+    CBVContainer *c = &cbv->containers[idx];
+    int rc = container_remove(c, (uint16_t) pos);
+    if (rc < 0) {
+        return -1;
+    }
+    if (rc) {
+        cbv->rank_dirty = true;
+        if (c->cardinality == 0) {
+            cbv_remove_at(cbv, idx);
+        }
+    }
+    return 0;
+}
+
+int
+cbv_flip(CompressedBitVector *cbv, size_t pos)
+{
+    int bit = cbv_get(cbv, pos);
+    if (bit < 0) {
+        return -1;
+    }
+    return bit ? cbv_clear(cbv, pos) : cbv_set(cbv, pos);
+}
+
+size_t
+cbv_count(const CompressedBitVector *cbv)
+{
+    if (!cbv) {
+        return 0;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        total += cbv->containers[i].cardinality;
+    }
+    return total;
+}
+
+size_t
+cbv_rank(CompressedBitVector *cbv, size_t pos)
+{
+    if (!cbv || cbv->n_bits == 0) {
+        return 0;
+    }
+    if (pos >= cbv->n_bits) {
+        pos = cbv->n_bits - 1;
+    }
+    if (cbv->rank_dirty && cbv_build_rank(cbv) < 0) {
+        /* Fall back to a linear scan over the containers. */
+        size_t sum = 0, key = pos >> CBV_CHUNK_SHIFT;
+        for (size_t i = 0; i < cbv->n_containers; ++i) {
+            const CBVContainer *c = &cbv->containers[i];
+            if (c->key > key) {
+                break;
+            }
+            sum += c->key < key ? c->cardinality
+                                : container_rank(c, (uint16_t) pos);
+        }
+        return sum;
+    }
+    bool found;
+    size_t idx = cbv_find(cbv, pos >> CBV_CHUNK_SHIFT, &found);
+    if (!found) {
+        return cbv->card_prefix[idx];
+    }
+    return cbv->card_prefix[idx] +
+           container_rank(&cbv->containers[idx], (uint16_t) pos);
+}
+
+size_t
+cbv_select(CompressedBitVector *cbv, size_t k)
+{
+    if (!cbv) {
+        return SIZE_MAX;
+    }
+    if (cbv->rank_dirty && cbv_build_rank(cbv) < 0) {
+        for (size_t i = 0; i < cbv->n_containers; ++i) {
+            const CBVContainer *c = &cbv->containers[i];
+            if (k < c->cardinality) {
+                return (c->key << CBV_CHUNK_SHIFT) +
+                       container_select(c, (uint32_t) k);
+            }
+            k -= c->cardinality;
+        }
+        return SIZE_MAX;
+    }
+    const size_t *p = cbv->card_prefix;
+    if (k >= p[cbv->n_containers]) {
+        return SIZE_MAX;
+    }
+    /* Last container whose prefix does not exceed k. */
+    size_t lo = 0, hi = cbv->n_containers - 1;
+    while (lo < hi) {
+        size_t mid = (lo + hi + 1) >> 1;
+        if (p[mid] <= k) {
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    const CBVContainer *c = &cbv->containers[lo];
+    return (c->key << CBV_CHUNK_SHIFT) +
+           container_select(c, (uint32_t) (k - p[lo]));
+}
+
+bool
+cbv_equal(const CompressedBitVector *a, const CompressedBitVector *b)
+{
+    if (a == b) {
+        return true;
+    }
+    if (!a || !b) {
+        return false;
+    }
+    if (a->n_bits != b->n_bits || a->n_containers != b->n_containers) {
+        return false;
+    }
+    for (size_t i = 0; i < a->n_containers; ++i) {
+        if (a->containers[i].key != b->containers[i].key ||
+            !container_equal(&a->containers[i], &b->containers[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Merge two sorted arrays according to a set operation.
+ * @param a First array.
+ * @param na Length of @p a.
+ * @param b Second array.
+ * @param nb Length of @p b.
+ * @param op Operation to apply.
+ * @param out Output buffer with room for @p na + @p nb entries.
+ * @return Number of values written to @p out.
+ */
+static uint32_t
+array_merge(const uint16_t *a, uint32_t na, const uint16_t *b, uint32_t nb,
+            cbv_op op, uint16_t *out)
+{
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            if (op != CBV_OP_AND) {
+                out[n++] = a[i];
+            }
+            ++i;
+        }
+        else if (a[i] > b[j]) {
+            if (op == CBV_OP_OR || op == CBV_OP_XOR) {
+                out[n++] = b[j];
+            }
+            ++j;
+        }
+        else {
+            if (op == CBV_OP_AND || op == CBV_OP_OR) {
+                out[n++] = a[i];
+            }
+            ++i;
+            ++j;
+        }
+    }
+    if (op != CBV_OP_AND) {
+        while (i < na) {
+            out[n++] = a[i++];
+        }
+    }
+    if (op == CBV_OP_OR || op == CBV_OP_XOR) {
+        while (j < nb) {
+            out[n++] = b[j++];
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Keep the entries of an array whose membership in @p other matches.
+ * @param a Source array container.
+ * @param other Container to probe.
+ * @param keep_present Keep entries found in @p other if @c true, absent ones
+ * otherwise.
+ * @param out Output container (payload must be released).
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_filter_array(const CBVContainer *a, const CBVContainer *other,
+                       bool keep_present, CBVContainer *out)
+{
+    const uint16_t *v = a->data;
+    uint16_t *dst = cbits_malloc((a->size ? a->size : 1) * sizeof(uint16_t));
+    if (!dst) {
+        return -1;
+    }
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < a->size; ++i) {
+        if (container_contains(other, v[i]) == keep_present) {
+            dst[n++] = v[i];
+        }
+    }
+    out->type = CBV_CONTAINER_ARRAY;
+    out->data = dst;
+    out->size = out->cardinality = n;
+    out->capacity = a->size;
+    return 0;
+}
+
+/**
+ * @brief Combine two containers with the same key.
+ *
+ * Array/array pairs are merged directly and AND/ANDNOT with an array on the
+ * probing side filter the array; everything else is computed word by word
+ * on expanded bitmaps.
+ *
+ * @param a Left container.
+ * @param b Right container.
+ * @param op Operation to apply.
+ * @param out Output container (zeroed on entry; cardinality 0 if empty).
+ * @param scratch Two scratch bitmaps, allocated lazily and reused.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+container_binary_op(const CBVContainer *a, const CBVContainer *b, cbv_op op,
+                    CBVContainer *out, uint64_t *scratch[2])
+{
+    if (a->type == CBV_CONTAINER_ARRAY && b->type == CBV_CONTAINER_ARRAY) {
+        uint16_t *buf =
+            cbits_malloc((a->size + b->size + 1) * sizeof(uint16_t));
+        if (!buf) {
+            return -1;
+        }
+        uint32_t n = array_merge(a->data, a->size, b->data, b->size, op, buf);
+        if (n <= CBV_ARRAY_MAX) {
+            out->type = CBV_CONTAINER_ARRAY;
+            out->data = buf;
+            out->size = out->cardinality = n;
+            out->capacity = a->size + b->size + 1;
+            return 0;
+        }
+        uint64_t *w = bitmap_alloc();
+        if (!w) {
+            cbits_free(buf);
+            return -1;
+        }
+        memset(w, 0, CBV_BITMAP_BYTES);
+        for (uint32_t i = 0; i < n; ++i) {
+            w[buf[i] >> 6] |= UINT64_C(1) << (buf[i] & 63);
+        }
+        cbits_free(buf);
+        out->type = CBV_CONTAINER_BITMAP;
+        out->data = w;
+        out->size = out->capacity = (uint32_t) CBV_BITMAP_WORDS;
+        out->cardinality = n;
+        return 0;
+    }
+    if (op == CBV_OP_AND && a->type == CBV_CONTAINER_ARRAY) {
+        return container_filter_array(a, b, true, out);
+    }
+    if (op == CBV_OP_AND && b->type == CBV_CONTAINER_ARRAY) {
+        return container_filter_array(b, a, true, out);
+    }
+    if (op == CBV_OP_ANDNOT && a->type == CBV_CONTAINER_ARRAY) {
+        return container_filter_array(a, b, false, out);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        if (!scratch[i] && !(scratch[i] = bitmap_alloc())) {
+            return -1;
+        }
+    }
+    uint64_t *restrict x = scratch[0];
+    uint64_t *restrict y = scratch[1];
+    container_to_bitmap(a, x);
+    container_to_bitmap(b, y);
+    switch (op) {
+        case CBV_OP_AND:
+            for (size_t i = 0; i < CBV_BITMAP_WORDS; ++i) {
+                x[i] &= y[i];
+            }
+            break;
+        case CBV_OP_OR:
+            for (size_t i = 0; i < CBV_BITMAP_WORDS; ++i) {
+                x[i] |= y[i];
+            }
+            break;
+        case CBV_OP_XOR:
+            for (size_t i = 0; i < CBV_BITMAP_WORDS; ++i) {
+                x[i] ^= y[i];
+            }
+            break;
+        case CBV_OP_ANDNOT:
+            for (size_t i = 0; i < CBV_BITMAP_WORDS; ++i) {
+                x[i] &= ~y[i];
+            }
+            break;
+    }
+    uint32_t card = bitmap_cardinality(x);
+    if (card == 0) {
+        return 0;
+    }
+    return container_from_bitmap(out, x, card, &scratch[0]);
+}
+
+/**
+ * @brief Shared driver for the binary operations.
+ *
+ * Walks both sorted container lists in lockstep; keys present on only one
+ * side are copied or skipped according to @p op.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @param op Operation to apply.
+ * @retval CompressedBitVector* New result vector.
+ * @retval NULL Length mismatch or allocation failure.
+ */
+static CompressedBitVector *
+cbv_binary_op(const CompressedBitVector *a, const CompressedBitVector *b,
+              cbv_op op)
+{
+    if (!a || !b || a->n_bits != b->n_bits) {
+        return NULL;
+    }
+    CompressedBitVector *res = cbv_new(a->n_bits);
+    if (!res) {
+        return NULL;
+    }
+    uint64_t *scratch[2] = {NULL, NULL};
+    size_t i = 0, j = 0;
+    const bool keep_a = op != CBV_OP_AND;
+    const bool keep_b = op == CBV_OP_OR || op == CBV_OP_XOR;
+
+    while (i < a->n_containers || j < b->n_containers) {
+        const CBVContainer *ca =
+            i < a->n_containers ? &a->containers[i] : NULL;
+        const CBVContainer *cb =
+            j < b->n_containers ? &b->containers[j] : NULL;
+        const CBVContainer *only = NULL;
+        bool keep = false;
+
+        if (ca && (!cb || ca->key < cb->key)) {
+            only = ca;
+            keep = keep_a;
+            ++i;
+        }
+        else if (cb && (!ca || cb->key < ca->key)) {
+            only = cb;
+            keep = keep_b;
+            ++j;
+        }
+        if (only) {
+            if (!keep) {
+                continue;
+            }
+            if (cbv_reserve(res, res->n_containers + 1) < 0 ||
+                container_clone(&res->containers[res->n_containers], only) <
+                    0) {
+                goto fail;
+            }
+            res->n_containers++;
+            continue;
+        }
+
+        CBVContainer out;
+        memset(&out, 0, sizeof(out));
+        out.key = ca->key;
+        if (container_binary_op(ca, cb, op, &out, scratch) < 0) {
+            goto fail;
+        }
+        ++i;
+        ++j;
+        if (out.cardinality == 0) {
+            container_release(&out);
+            continue;
+        }
+        if (cbv_reserve(res, res->n_containers + 1) < 0) {
+            container_release(&out);
+            goto fail;
+        }
+        res->containers[res->n_containers++] = out;
+    }
+    bitmap_free(scratch[0]);
+    bitmap_free(scratch[1]);
+    return res;
+
+fail:
+    bitmap_free(scratch[0]);
+    bitmap_free(scratch[1]);
+    cbv_free(res);
+    return NULL;
+}
+
+CompressedBitVector *
+cbv_and(const CompressedBitVector *a, const CompressedBitVector *b)
+{
+    return cbv_binary_op(a, b, CBV_OP_AND);
+}
+
+CompressedBitVector *
+cbv_or(const CompressedBitVector *a, const CompressedBitVector *b)
+{
+    return cbv_binary_op(a, b, CBV_OP_OR);
+}
+
+CompressedBitVector *
+cbv_xor(const CompressedBitVector *a, const CompressedBitVector *b)
+{
+    return cbv_binary_op(a, b, CBV_OP_XOR);
+}
+
+CompressedBitVector *
+cbv_andnot(const CompressedBitVector *a, const CompressedBitVector *b)
+{
+    return cbv_binary_op(a, b, CBV_OP_ANDNOT);
+}
+
+int
+cbv_optimize(CompressedBitVector *cbv)
+{
+    if (!cbv || cbv->n_containers == 0) {
+        return 0;
+    }
+    uint64_t *w = bitmap_alloc();
+    if (!w) {
+        return -1;
+    }
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        CBVContainer *c = &cbv->containers[i];
+        container_to_bitmap(c, w);
+        CBVContainer tmp = {.key = c->key};
+        if (container_from_bitmap_best(&tmp, w, c->cardinality) < 0) {
+            bitmap_free(w);
+            return -1;
+        }
+        container_release(c);
+        *c = tmp;
+    }
+    bitmap_free(w);
+    return 0;
+}
+
+size_t
+cbv_memory_usage(const CompressedBitVector *cbv)
+{
+    if (!cbv) {
+        return 0;
+    }
+    size_t total = sizeof(CompressedBitVector) +
+                   cbv->capacity * sizeof(CBVContainer);
+    if (cbv->card_prefix) {
+        total += (cbv->capacity + 1) * sizeof(size_t);
+    }
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        const CBVContainer *c = &cbv->containers[i];
+        switch (c->type) {
+            case CBV_CONTAINER_BITMAP:
+                total += CBV_BITMAP_BYTES;
+                break;
+            case CBV_CONTAINER_RUN:
+                total += (size_t) c->capacity * 2 * sizeof(uint16_t);
+                break;
+            default:
+                total += (size_t) c->capacity * sizeof(uint16_t);
+                break;
+        }
+    }
+    return total;
+}
+
+CompressedBitVector *
+cbv_from_bitvector(const BitVector *bv)
+{
+    if (!bv) {
+        return NULL;
+    }
+    CompressedBitVector *cbv = cbv_new(bv->n_bits);
+    if (!cbv || bv->n_bits == 0) {
+        return cbv;
+    }
+    uint64_t *w = bitmap_alloc();
+    if (!w) {
+        cbv_free(cbv);
+        return NULL;
+    }
+    const size_t n_chunks =
+        (bv->n_bits + CBV_CHUNK_BITS - 1) >> CBV_CHUNK_SHIFT;
+    const unsigned tail = (unsigned) (bv->n_bits & 63);
+
+    for (size_t k = 0; k < n_chunks; ++k) {
+        const size_t w0 = k * CBV_BITMAP_WORDS;
+        size_t nw = bv->n_words - w0;
+        if (nw > CBV_BITMAP_WORDS) {
+            nw = CBV_BITMAP_WORDS;
+        }
+        memcpy(w, &bv->data[w0], nw * sizeof(uint64_t));
+        memset(&w[nw], 0, (CBV_BITMAP_WORDS - nw) * sizeof(uint64_t));
+        if (k + 1 == n_chunks && tail) {
+            w[nw - 1] &= (UINT64_C(1) << tail) - 1;
+        }
+        uint32_t card = bitmap_cardinality(w);
+        if (card == 0) {
+            continue;
+        }
+        if (cbv_reserve(cbv, cbv->n_containers + 1) < 0) {
+            goto fail;
+        }
+        CBVContainer *c = &cbv->containers[cbv->n_containers];
+        memset(c, 0, sizeof(*c));
+        c->key = k;
+        if (container_from_bitmap_best(c, w, card) < 0) {
+            goto fail;
+        }
+        cbv->n_containers++;
+    }
+    bitmap_free(w);
+    return cbv;
+
+fail:
+    bitmap_free(w);
+    cbv_free(cbv);
+    return NULL;
+}
+
+BitVector *
+cbv_to_bitvector(const CompressedBitVector *cbv)
+{
+    if (!cbv) {
+        return NULL;
+    }
+    BitVector *bv = bv_new(cbv->n_bits);
+    if (!bv) {
+        return NULL;
+    }
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        const CBVContainer *c = &cbv->containers[i];
+        uint64_t *dst = &bv->data[c->key * CBV_BITMAP_WORDS];
+        const uint16_t *v = c->data;
+        switch (c->type) {
+            case CBV_CONTAINER_BITMAP: {
+                size_t nw = bv->n_words - c->key * CBV_BITMAP_WORDS;
+                if (nw > CBV_BITMAP_WORDS) {
+                    nw = CBV_BITMAP_WORDS;
+                }
+                memcpy(dst, c->data, nw * sizeof(uint64_t));
+                break;
+            }
+            case CBV_CONTAINER_RUN:
+                for (uint32_t r = 0; r < c->size; ++r) {
+                    size_t start = v[2 * r];
+                    words_set_range(dst, start, start + v[2 * r + 1] + 1);
+                }
+                break;
+            default:
+                for (uint32_t r = 0; r < c->size; ++r) {
+                    dst[v[r] >> 6] |= UINT64_C(1) << (v[r] & 63);
+                }
+                break;
+        }
+    }
+    bv_apply_tail_mask(bv);
+    bv->rank_dirty = true;
+    return bv;
+}
@@ -0,0 +1,313 @@
+/**
+ * @file src/cbits/elias_fano.c
+ * @brief Elias–Fano encoding of monotone integer sequences.
+ *
+ * This module implements:
+ * - \ref ef_from_sorted, \ref ef_free
+ * - the sampled select directory over the high-bits BitVector
+ * - \ref ef_access and \ref ef_next_geq
+ * - forward iteration (\ref ef_iter_init, \ref ef_iter_next)
+ *
+ * Select queries jump to the nearest sample and finish with a popcount scan
+ * over the following words and \ref bv__select_in_word on the last one.
+ * Iteration walks the set bits of the high part directly, so it never needs
+ * the directory after the first position.
+ *
+ * @see elias_fano.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "elias_fano.h"
+#include "bitvector_internal.h"
+#include <string.h>
+
+/**
+ * @brief Choose the number of low bits for @p n values up to @p max_value.
+ * @param n Number of values (non-zero).
+ * @param max_value Largest value.
+ * @return <tt>floor(log2(max_value / n))</tt>, or 0 for dense sequences.
+ */
+static unsigned
+ef_choose_low_bits(size_t n, uint64_t max_value)
+{
+    uint64_t ratio = max_value / n;
+    if (ratio == 0) {
+        return 0;
+    }
+    unsigned l = 0;
+    while (ratio >>= 1) {
+        ++l;
+    }
+    return l;
+}
+
+/**
+ * @brief Read the low part of element @p i.
+ * @param ef Pointer to the EliasFano sequence.
+ * @param i Element index.
+ * @return The @c low_bits low bits of the value.
+ */
+static inline uint64_t
+ef_get_low(const EliasFano *ef, size_t i)
+{
+    const unsigned l = ef->low_bits;
+    if (l == 0) {
+        return 0;
+    }
+    size_t bit = i * l;
+    size_t w = bit >> 6;
+    unsigned off = (unsigned) (bit & 63);
+    uint64_t v = ef->low[w] >> off;
+    if (off + l > 64) {
+        v |= ef->low[w + 1] << (64 - off);
+    }
+    return v & ((UINT64_C(1) << l) - 1);
+}
+
+/**
+ * @brief Store the low part of element @p i into a zeroed array.
+ * @param low Packed low array.
+ * @param l Bits per element.
+ * @param i Element index.
+ * @param v Value whose low bits are stored.
+ */
+static inline void
+ef_put_low(uint64_t *low, unsigned l, size_t i, uint64_t v)
+{
+    v &= (UINT64_C(1) << l) - 1;
+    size_t bit = i * l;
+    size_t w = bit >> 6;
+    unsigned off = (unsigned) (bit & 63);
+    low[w] |= v << off;
+    if (off + l > 64) {
+        low[w + 1] |= v >> (64 - off);
+    }
+}
+
+/**
+ * @brief Position of the k-th set (or clear) bit of the high part.
+ * @param ef Pointer to the EliasFano sequence.
+ * @param k Zero-based index of the bit; must exist.
+ * @param ones @c true to search set bits, @c false for clear bits.
+ * @return Bit position in the high BitVector.
+ */
+static size_t
+ef_select_high(const EliasFano *ef, size_t k, bool ones)
+{
+    const size_t *samples = ones ? ef->select1_samples : ef->select0_samples;
+    const uint64_t flip = ones ? 0 : ~0ULL;
+    const uint64_t *data = ef->high->data;
+
+    size_t pos = samples[k >> EF_SELECT_SAMPLE_SHIFT];
+    size_t r = k & (EF_SELECT_SAMPLE - 1);
+    size_t w = bv_word(pos);
+    uint64_t word = (data[w] ^ flip) & (~0ULL << bv_bit(pos));
+    for (;;) {
+        size_t c = cbits_popcount64(word);
+        if (r < c) {
+            return (w << 6) + bv__select_in_word(word, (unsigned) r);
+        }
+        r -= c;
+        word = data[++w] ^ flip;
+    }
+}
+
+/**
+ * @brief Record the position of every sampled set and clear bit.
+ * @param ef Sequence whose high part is fully built.
+ * @param n_zeros Number of clear bits in the high part.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+ef_build_select(EliasFano *ef, size_t n_zeros)
+{
+    size_t n1 = (ef->n + EF_SELECT_SAMPLE - 1) >> EF_SELECT_SAMPLE_SHIFT;
+    size_t n0 = (n_zeros + EF_SELECT_SAMPLE - 1) >> EF_SELECT_SAMPLE_SHIFT;
+    ef->select1_samples = cbits_malloc((n1 ? n1 : 1) * sizeof(size_t));
+    ef->select0_samples = cbits_malloc((n0 ? n0 : 1) * sizeof(size_t));
+    if (!ef->select1_samples || !ef->select0_samples) {
+        return -1;
+    }
+
+    const BitVector *high = ef->high;
+    size_t ones = 0, zeros = 0;
+    for (size_t w = 0; w < high->n_words; ++w) {
+        uint64_t word = high->data[w];
+        size_t valid = w + 1 < high->n_words ? 64 : high->n_bits - (w << 6);
+        size_t c1 = cbits_popcount64(word);
+        size_t c0 = valid - c1;
+
+        /* Next sample index that falls into this word, if any. */
+        size_t next1 = (ones + EF_SELECT_SAMPLE - 1) &
+                       ~(size_t) (EF_SELECT_SAMPLE - 1);
+        while (next1 < ones + c1) {
+            ef->select1_samples[next1 >> EF_SELECT_SAMPLE_SHIFT] =
+                (w << 6) + bv__select_in_word(word, (unsigned) (next1 - ones));
+            next1 += EF_SELECT_SAMPLE;
+        }
+        size_t next0 = (zeros + EF_SELECT_SAMPLE - 1) &
+                       ~(size_t) (EF_SELECT_SAMPLE - 1);
+        while (next0 < zeros + c0) {
+            ef->select0_samples[next0 >> EF_SELECT_SAMPLE_SHIFT] =
+                (w << 6) +
+                bv__select_in_word(~word, (unsigned) (next0 - zeros));
+            next0 += EF_SELECT_SAMPLE;
+        }
+        ones += c1;
+        zeros += c0;
+    }
+    return 0;
+}
+
+EliasFano *
+ef_from_sorted(const uint64_t *values, size_t n)
+{
+    for (size_t i = 1; i < n; ++i) {
+        if (values[i] < values[i - 1]) {
+            return NULL;
+        }
+    }
+    EliasFano *ef = cbits_calloc(1, sizeof(EliasFano));
+    if (!ef) {
+        return NULL;
+    }
+    ef->n = n;
+    ef->max_value = n ? values[n - 1] : 0;
+    ef->low_bits = n ? ef_choose_low_bits(n, ef->max_value) : 0;
+
+    const unsigned l = ef->low_bits;
+    const size_t n_buckets = n ? (size_t) (ef->max_value >> l) + 1 : 0;
+    const size_t low_words = ((n * l + 63) >> 6) + 1;
+
+    ef->low = cbits_calloc(low_words, sizeof(uint64_t));
+    ef->high = bv_new(n + n_buckets);
+    if (!ef->low || !ef->high) {
+        ef_free(ef);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (l) {
+            ef_put_low(ef->low, l, i, values[i]);
+        }
+        bv__set_inline(ef->high, (size_t) (values[i] >> l) + i);
+    }
+    if (ef_build_select(ef, n_buckets) < 0) {
+        ef_free(ef);
+        return NULL;
+    }
+    return ef;
+}
+
+void
+ef_free(EliasFano *ef)
+{
+    if (!ef) {
+        return;
+    }
+    cbits_free(ef->select0_samples);
+    cbits_free(ef->select1_samples);
+    bv_free(ef->high);
+    cbits_free(ef->low);
+    cbits_free(ef);
+}
+
+uint64_t
+ef_access(const EliasFano *ef, size_t i)
+{
+    if (!ef || i >= ef->n) {
+        return UINT64_MAX;
+    }
+    size_t pos = ef_select_high(ef, i, true);
+    return ((uint64_t) (pos - i) << ef->low_bits) | ef_get_low(ef, i);
+}
+
+/**
+ * @brief Position an iterator on a known set bit of the high part.
+ * @param ef Sequence to iterate.
+ * @param it Iterator to initialize.
+ * @param index Element index whose bit is at @p pos.
+ * @param pos Bit position to resume scanning from.
+ */
+static void
+ef_iter_seek(const EliasFano *ef, EFIterator *it, size_t index, size_t pos)
+{
+    it->ef = ef;
+    it->index = index;
+    it->word_index = bv_word(pos);
+    it->word = index < ef->n
+                   ? ef->high->data[it->word_index] & (~0ULL << bv_bit(pos))
+                   : 0;
+}
+
+void
+ef_iter_init(const EliasFano *ef, EFIterator *it, size_t start)
+{
+    if (start >= ef->n) {
+        ef_iter_seek(ef, it, ef->n, 0);
+        return;
+    }
+    ef_iter_seek(ef, it, start, ef_select_high(ef, start, true));
+}
+
+bool
+ef_iter_next(EFIterator *it, uint64_t *value)
+{
+    const EliasFano *ef = it->ef;
+    if (it->index >= ef->n) {
+        return false;
+    }
+    while (!it->word) {
+        it->word = ef->high->data[++it->word_index];
+    }
+    size_t pos = (it->word_index << 6) + cbits_ctz64(it->word);
+    it->word &= it->word - 1;
+    *value = ((uint64_t) (pos - it->index) << ef->low_bits) |
+             ef_get_low(ef, it->index);
+    it->index++;
+    return true;
+}
+
+size_t
+ef_next_geq(const EliasFano *ef, uint64_t x, uint64_t *value)
+{
+    if (!ef || ef->n == 0 || x > ef->max_value) {
+        return ef ? ef->n : 0;
+    }
+    /* Bucket h starts right after the clear bit closing bucket h - 1. */
+    size_t h = (size_t) (x >> ef->low_bits);
+    size_t start = h ? ef_select_high(ef, h - 1, false) + 1 : 0;
+
+    EFIterator it;
+    ef_iter_seek(ef, &it, start - h, start);
+    uint64_t v;
+    while (ef_iter_next(&it, &v)) {
+        if (v >= x) {
+            if (value) {
+                *value = v;
+            }
+            return it.index - 1;
+        }
+    }
+    return ef->n;
+}
+
+size_t
+ef_memory_usage(const EliasFano *ef)
+{
+    if (!ef) {
+        return 0;
+    }
+    const BitVector *high = ef->high;
+    size_t n_super = (high->n_words + BV_WORDS_SUPER - 1) >>
+                     BV_WORDS_SUPER_SHIFT;
+    size_t n1 = (ef->n + EF_SELECT_SAMPLE - 1) >> EF_SELECT_SAMPLE_SHIFT;
+    size_t n0 = (high->n_bits - ef->n + EF_SELECT_SAMPLE - 1) >>
+                EF_SELECT_SAMPLE_SHIFT;
+    return sizeof(EliasFano) + sizeof(BitVector) +
+           (((ef->n * ef->low_bits + 63) >> 6) + 1) * sizeof(uint64_t) +
+           (high->n_words + 1) * sizeof(uint64_t) +
+           n_super * sizeof(size_t) + high->n_words * sizeof(uint16_t) +
+           (n1 + n0) * sizeof(size_t);
+}
@@ -0,0 +1,647 @@
+/**
+ * @file src/cbits/ewah_bitvector.c
+ * @brief EWAH run-length compressed bit arrays.
+ *
+ * This module implements:
+ * - a stream writer that keeps the encoding canonical
+ * - a cursor that walks runs and literals of a compressed stream
+ * - \ref bv_compress_ewah and \ref ewah_decompress
+ * - \ref ewah_get, \ref ewah_count and \ref ewah_equal
+ * - streaming bitwise operations between compressed vectors
+ *
+ * Bitwise operations advance two cursors in lockstep. Whenever one side is
+ * inside a run, the run either fixes the result (e.g. AND with zeros) and a
+ * single run is emitted for the whole overlap, or the other side's literals
+ * are transformed word by word. Only literal/literal overlaps touch every
+ * word.
+ *
+ * @see ewah_bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "ewah_bitvector.h"
+#include "bitvector_internal.h"
+#include <string.h>
+
+/**
+ * @brief Binary operation selector for \ref ewah_binary_op.
+ */
+typedef enum {
+    EWAH_OP_AND,
+    EWAH_OP_OR,
+    EWAH_OP_XOR,
+    EWAH_OP_ANDNOT,
+} ewah_op;
+
+/* -------------------------------------------------------------------------
+ * Marker word layout
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Value of the clean words described by a marker.
+ * @param m Marker word.
+ * @return @c 0 or @c 1.
+ */
+static inline unsigned
+marker_run_bit(uint64_t m)
+{
+    return (unsigned) (m & 1);
+}
+
+/**
+ * @brief Number of clean words described by a marker.
+ * @param m Marker word.
+ * @return Run length in words.
+ */
+static inline size_t
+marker_run_len(uint64_t m)
+{
+    return (size_t) ((m >> 1) & EWAH_RUN_LEN_MAX);
+}
+
+/**
+ * @brief Number of literal words following a marker.
+ * @param m Marker word.
+ * @return Literal word count.
+ */
+static inline size_t
+marker_literals(uint64_t m)
+{
+    return (size_t) (m >> (1 + EWAH_RUN_LEN_BITS));
+}
+
+/**
+ * @brief Assemble a marker word.
+ * @param bit Run value.
+ * @param run_len Run length in words.
+ * @param literals Literal word count.
+ * @return Marker word.
+ */
+static inline uint64_t
+marker_make(unsigned bit, size_t run_len, size_t literals)
+{
+    return (uint64_t) bit | ((uint64_t) run_len << 1) |
+           ((uint64_t) literals << (1 + EWAH_RUN_LEN_BITS));
+}
+
+/* -------------------------------------------------------------------------
+ * Stream writer
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Append state for building a compressed stream.
+ */
+typedef struct {
+    EWAHBitVector *ewah; /**< Vector being written. */
+    size_t marker;       /**< Index of the marker currently being extended. */
+} ewah_writer;
+
+/**
+ * @brief Ensure room for @p extra more words in the buffer.
+ * @param ewah Vector to grow.
+ * @param extra Number of words about to be appended.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure (buffer unchanged).
+ */
+static int
+ewah_reserve(EWAHBitVector *ewah, size_t extra)
+{
+    size_t need = ewah->size + extra;
+    if (need <= ewah->capacity) {
+        return 0;
+    }
+    size_t cap = ewah->capacity ? ewah->capacity : 4;
+    while (cap < need) {
+        cap *= 2;
+    }
+    uint64_t *buf = cbits_realloc(ewah->buffer, cap * sizeof(uint64_t));
+    if (!buf) {
+        return -1;
+    }
+    ewah->buffer = buf;
+    ewah->capacity = cap;
+    return 0;
+}
+
+/**
+ * @brief Start a new, empty marker at the end of the stream.
+ * @param w Writer.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+writer_open_marker(ewah_writer *w)
+{
+    if (ewah_reserve(w->ewah, 1) < 0) {
+        return -1;
+    }
+    w->marker = w->ewah->size;
+    w->ewah->buffer[w->ewah->size++] = 0;
+    return 0;
+}
+
+/**
+ * @brief Append @p count clean words of value @p bit.
+ *
+ * Extends the current marker when it has no literals yet and describes the
+ * same bit (or no run at all); otherwise a new marker is started.
+ * @param w Writer.
+ * @param bit Run value.
+ * @param count Number of words.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+writer_push_run(ewah_writer *w, unsigned bit, size_t count)
+{
+    while (count) {
+        uint64_t m = w->ewah->buffer[w->marker];
+        size_t len = marker_run_len(m);
+        if (marker_literals(m) || (len && marker_run_bit(m) != bit) ||
+            len == EWAH_RUN_LEN_MAX) {
+            if (writer_open_marker(w) < 0) {
+                return -1;
+            }
+            continue;
+        }
+        size_t take = EWAH_RUN_LEN_MAX - len;
+        if (take > count) {
+            take = count;
+        }
+        w->ewah->buffer[w->marker] = marker_make(bit, len + take, 0);
+        count -= take;
+    }
+    return 0;
+}
+
+/**
+ * @brief Append one word, folding clean words into runs.
+ * @param w Writer.
+ * @param word Word to append.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+writer_push_literal(ewah_writer *w, uint64_t word)
+{
+    if (word == 0 || word == ~0ULL) {
+        return writer_push_run(w, (unsigned) (word & 1), 1);
+    }
+    uint64_t m = w->ewah->buffer[w->marker];
+    if (marker_literals(m) == EWAH_LITERAL_MAX) {
+        if (writer_open_marker(w) < 0) {
+            return -1;
+        }
+        m = 0;
+    }
+    if (ewah_reserve(w->ewah, 1) < 0) {
+        return -1;
+    }
+    w->ewah->buffer[w->ewah->size++] = word;
+    w->ewah->buffer[w->marker] = m + ((uint64_t) 1 << (1 + EWAH_RUN_LEN_BITS));
+    return 0;
+}
+
+/**
+ * @brief Allocate an empty vector together with a writer for it.
+ * @param w Writer to initialize.
+ * @param n_bits Logical number of bits.
+ * @param hint Expected number of compressed words.
+ * @retval EWAHBitVector* Newly allocated vector holding one empty marker.
+ * @retval NULL Allocation failure.
+ */
+static EWAHBitVector *
+writer_begin(ewah_writer *w, size_t n_bits, size_t hint)
+{
+    EWAHBitVector *ewah = cbits_malloc(sizeof(EWAHBitVector));
+    if (!ewah) {
+        return NULL;
+    }
+    ewah->n_bits = n_bits;
+    ewah->n_words = (n_bits + 63) >> 6;
+    ewah->size = 0;
+    ewah->capacity = 0;
+    ewah->buffer = NULL;
+    w->ewah = ewah;
+    if (ewah_reserve(ewah, hint ? hint : 1) < 0 ||
+        writer_open_marker(w) < 0) {
+        ewah_free(ewah);
+        return NULL;
+    }
+    return ewah;
+}
+
+/* -------------------------------------------------------------------------
+ * Stream cursor
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Read position inside a compressed stream.
+ */
+typedef struct {
+    const uint64_t *buf; /**< Compressed words. */
+    size_t size;         /**< Number of compressed words. */
+    size_t next;         /**< Index of the next unread marker. */
+    unsigned run_bit;    /**< Value of the current run. */
+    size_t run_left;     /**< Clean words left in the current run. */
+    size_t lit_left;     /**< Literal words left after the run. */
+    const uint64_t *lit; /**< Next literal word. */
+} ewah_cursor;
+
+/**
+ * @brief Advance past exhausted markers until words are available.
+ * @param c Cursor.
+ */
+static inline void
+cursor_load(ewah_cursor *c)
+{
+    while (!c->run_left && !c->lit_left && c->next < c->size) {
+        uint64_t m = c->buf[c->next];
+        c->run_bit = marker_run_bit(m);
+        c->run_left = marker_run_len(m);
+        c->lit_left = marker_literals(m);
+        c->lit = &c->buf[c->next + 1];
+        c->next += 1 + c->lit_left;
+    }
+}
+
+/**
+ * @brief Position a cursor at the first word of a vector.
+ * @param c Cursor to initialize.
+ * @param ewah Vector to read.
+ */
+static inline void
+cursor_init(ewah_cursor *c, const EWAHBitVector *ewah)
+{
+    c->buf = ewah->buffer;
+    c->size = ewah->size;
+    c->next = 0;
+    c->run_bit = 0;
+    c->run_left = 0;
+    c->lit_left = 0;
+    c->lit = NULL;
+    cursor_load(c);
+}
+
+/**
+ * @brief Check whether a cursor has consumed every word.
+ * @param c Cursor.
+ * @return @c true at end of stream.
+ */
+static inline bool
+cursor_done(const ewah_cursor *c)
+{
+    return !c->run_left && !c->lit_left;
+}
+
+/**
+ * @brief Number of words available before the cursor changes phase.
+ * @param c Cursor.
+ * @return Words left in the current run, or in the current literal block.
+ */
+static inline size_t
+cursor_span(const ewah_cursor *c)
+{
+    return c->run_left ? c->run_left : c->lit_left;
+}
+
+/**
+ * @brief Consume @p n words from the current phase.
+ * @param c Cursor.
+ * @param n Number of words, at most \ref cursor_span.
+ */
+static inline void
+cursor_skip(ewah_cursor *c, size_t n)
+{
+    if (c->run_left) {
+        c->run_left -= n;
+    }
+    else {
+        c->lit += n;
+        c->lit_left -= n;
+    }
+    cursor_load(c);
+}
+
+/* -------------------------------------------------------------------------
+ * Encoding and decoding
+ * ------------------------------------------------------------------------- */
+
+EWAHBitVector *
+ewah_new(size_t n_bits)
+{
+    ewah_writer w;
+    EWAHBitVector *ewah = writer_begin(&w, n_bits, 1);
+    if (!ewah) {
+        return NULL;
+    }
+    if (writer_push_run(&w, 0, ewah->n_words) < 0) {
+        ewah_free(ewah);
+        return NULL;
+    }
+    return ewah;
+}
+
+EWAHBitVector *
+ewah_copy(const EWAHBitVector *src)
+{
+    if (!src) {
+        return NULL;
+    }
+    EWAHBitVector *dst = cbits_malloc(sizeof(EWAHBitVector));
+    if (!dst) {
+        return NULL;
+    }
+    *dst = *src;
+    dst->capacity = src->size;
+    dst->buffer = cbits_malloc(src->size * sizeof(uint64_t));
+    if (!dst->buffer) {
+        cbits_free(dst);
+        return NULL;
+    }
+    memcpy(dst->buffer, src->buffer, src->size * sizeof(uint64_t));
+    return dst;
+}
+
+void
+ewah_free(EWAHBitVector *ewah)
+{
+    if (!ewah) {
+        return;
+    }
+    cbits_free(ewah->buffer);
+    cbits_free(ewah);
+}
+
+EWAHBitVector *
+bv_compress_ewah(const BitVector *bv)
+{
+    if (!bv) {
+        return NULL;
+    }
+    ewah_writer w;
+    EWAHBitVector *ewah = writer_begin(&w, bv->n_bits, 4);
+    if (!ewah) {
+        return NULL;
+    }
+    const size_t n = bv->n_words;
+    unsigned tail = (unsigned) (bv->n_bits & 63);
+    uint64_t tail_mask = tail ? (UINT64_C(1) << tail) - 1 : ~0ULL;
+    size_t i = 0;
+    while (i < n) {
+        uint64_t word = bv->data[i];
+        if (i == n - 1) {
+            word &= tail_mask;
+        }
+        if (word == 0 || word == ~0ULL) {
+            size_t j = i + 1;
+            while (j < n && bv->data[j] == word &&
+                   (j != n - 1 || tail_mask == ~0ULL)) {
+                ++j;
+            }
+            if (writer_push_run(&w, (unsigned) (word & 1), j - i) < 0) {
+                goto fail;
+            }
+            i = j;
+            continue;
+        }
+        if (writer_push_literal(&w, word) < 0) {
+            goto fail;
+        }
+        ++i;
+    }
+    return ewah;
+
+fail:
+    ewah_free(ewah);
+    return NULL;
+}
+
+BitVector *
+ewah_decompress(const EWAHBitVector *ewah)
+{
+    if (!ewah) {
+        return NULL;
+    }
+    BitVector *bv = bv_new(ewah->n_bits);
+    if (!bv) {
+        return NULL;
+    }
+    size_t word = 0;
+    ewah_cursor c;
+    cursor_init(&c, ewah);
+    while (!cursor_done(&c)) {
+        size_t n = cursor_span(&c);
+        if (c.run_left) {
+            if (c.run_bit) {
+                memset(&bv->data[word], 0xFF, n * sizeof(uint64_t));
+            }
+        }
+        else {
+            memcpy(&bv->data[word], c.lit, n * sizeof(uint64_t));
+        }
+        word += n;
+        cursor_skip(&c, n);
+    }
+    bv_apply_tail_mask(bv);
+    return bv;
+}
+
+/* -------------------------------------------------------------------------
+ * Queries
+ * ------------------------------------------------------------------------- */
+
+int
+ewah_get(const EWAHBitVector *ewah, size_t pos)
+{
+    if (!ewah || pos >= ewah->n_bits) {
+        return -1;
+    }
+    size_t target = pos >> 6;
+    size_t word = 0;
+    size_t i = 0;
+    while (i < ewah->size) {
+        uint64_t m = ewah->buffer[i];
+        size_t run = marker_run_len(m);
+        size_t lits = marker_literals(m);
+        if (target < word + run) {
+            return (int) marker_run_bit(m);
+        }
+        word += run;
+        if (target < word + lits) {
+            uint64_t w = ewah->buffer[i + 1 + (target - word)];
+            return (int) ((w >> (pos & 63)) & 1);
+        }
+        word += lits;
+        i += 1 + lits;
+    }
+    return 0;
+}
+
+size_t
+ewah_count(const EWAHBitVector *ewah)
+{
+    if (!ewah) {
+        return 0;
+    }
+    size_t total = 0;
+    size_t i = 0;
+    while (i < ewah->size) {
+        uint64_t m = ewah->buffer[i];
+        if (marker_run_bit(m)) {
+            total += marker_run_len(m) << 6;
+        }
+        size_t lits = marker_literals(m);
+        const uint64_t *lit = &ewah->buffer[i + 1];
+        for (size_t k = 0; k < lits; ++k) {
+            total += cbits_popcount64(lit[k]);
+        }
+        i += 1 + lits;
+    }
+    return total;
+}
+
+bool
+ewah_equal(const EWAHBitVector *a, const EWAHBitVector *b)
+{
+    if (a->n_bits != b->n_bits || a->size != b->size) {
+        return false;
+    }
+    return memcmp(a->buffer, b->buffer, a->size * sizeof(uint64_t)) == 0;
+}
+
+size_t
+ewah_memory_usage(const EWAHBitVector *ewah)
+{
+    if (!ewah) {
+        return 0;
+    }
+    return sizeof(EWAHBitVector) + ewah->capacity * sizeof(uint64_t);
+}
+
+/* -------------------------------------------------------------------------
+ * Streaming bitwise operations
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Apply a binary operation to two words.
+ * @param op Operation.
+ * @param a Left word.
+ * @param b Right word.
+ * @return Result word.
+ */
+static inline uint64_t
+op_word(ewah_op op, uint64_t a, uint64_t b)
+{
+    switch (op) {
+        case EWAH_OP_AND:
+            return a & b;
+        case EWAH_OP_OR:
+            return a | b;
+        case EWAH_OP_XOR:
+            return a ^ b;
+        default:
+            return a & ~b;
+    }
+}
+
+/**
+ * @brief Combine two compressed streams without decompressing them.
+ * @param a Left operand.
+ * @param b Right operand.
+ * @param op Operation.
+ * @retval EWAHBitVector* New vector holding the result.
+ * @retval NULL Length mismatch or allocation failure.
+ */
+static EWAHBitVector *
+ewah_binary_op(const EWAHBitVector *a, const EWAHBitVector *b, ewah_op op)
+{
+    if (!a || !b || a->n_bits != b->n_bits) {
+        return NULL;
+    }
+    size_t hint = a->size > b->size ? a->size : b->size;
+    ewah_writer w;
+    EWAHBitVector *res = writer_begin(&w, a->n_bits, hint);
+    if (!res) {
+        return NULL;
+    }
+    ewah_cursor ca, cb;
+    cursor_init(&ca, a);
+    cursor_init(&cb, b);
+    while (!cursor_done(&ca) && !cursor_done(&cb)) {
+        size_t na = cursor_span(&ca), nb = cursor_span(&cb);
+        size_t n = na < nb ? na : nb;
+        uint64_t wa = ca.run_bit ? ~0ULL : 0;
+        uint64_t wb = cb.run_bit ? ~0ULL : 0;
+
+        if (ca.run_left && cb.run_left) {
+            uint64_t r = op_word(op, wa, wb);
+            if (writer_push_run(&w, (unsigned) (r & 1), n) < 0) {
+                goto fail;
+            }
+        }
+        else if (ca.run_left || cb.run_left) {
+            /* A run on one side either fixes the result for the whole
+             * overlap or turns into a per-word transform of the other. */
+            bool a_run = ca.run_left != 0;
+            uint64_t r0 = a_run ? op_word(op, wa, 0) : op_word(op, 0, wb);
+            uint64_t r1 =
+                a_run ? op_word(op, wa, ~0ULL) : op_word(op, ~0ULL, wb);
+            if (r0 == r1) {
+                if (writer_push_run(&w, (unsigned) (r0 & 1), n) < 0) {
+                    goto fail;
+                }
+            }
+            else {
+                const uint64_t *lit = a_run ? cb.lit : ca.lit;
+                for (size_t k = 0; k < n; ++k) {
+                    uint64_t r = a_run ? op_word(op, wa, lit[k])
+                                       : op_word(op, lit[k], wb);
+                    if (writer_push_literal(&w, r) < 0) {
+                        goto fail;
+                    }
+                }
+            }
+        }
+        else {
+            for (size_t k = 0; k < n; ++k) {
+                uint64_t r = op_word(op, ca.lit[k], cb.lit[k]);
+                if (writer_push_literal(&w, r) < 0) {
+                    goto fail;
+                }
+            }
+        }
+        cursor_skip(&ca, n);
+        cursor_skip(&cb, n);
+    }
+    return res;
+
+fail:
+    ewah_free(res);
+    return NULL;
+}
+
+EWAHBitVector *
+ewah_and(const EWAHBitVector *a, const EWAHBitVector *b)
+{
+    return ewah_binary_op(a, b, EWAH_OP_AND);
+}
+
+EWAHBitVector *
+ewah_or(const EWAHBitVector *a, const EWAHBitVector *b)
+{
+    return ewah_binary_op(a, b, EWAH_OP_OR);
+}
+
+EWAHBitVector *
+ewah_xor(const EWAHBitVector *a, const EWAHBitVector *b)
+{
+    return ewah_binary_op(a, b, EWAH_OP_XOR);
+}
+
+EWAHBitVector *
+ewah_andnot(const EWAHBitVector *a, const EWAHBitVector *b)
+{
+    return ewah_binary_op(a, b, EWAH_OP_ANDNOT);
+}
@@ -0,0 +1,422 @@
+/**
+ * @file src/cbits/gf2.c
+ * @brief Method of Four Russians elimination and multiplication over GF(2).
+ *
+ * This module implements:
+ * - the lookup tables shared by elimination and multiplication
+ * - \ref gf2_echelon, \ref gf2_rank, \ref gf2_nullspace
+ * - \ref gf2_mul
+ *
+ * A strip of up to @ref GF2_STRIP_BITS columns is eliminated in two steps.
+ * First a plain Gaussian elimination restricted to the strip finds its
+ * pivots, reducing only the rows it has to look at and keeping the pivot
+ * rows in identity form on the pivot columns. Then the pivot rows are
+ * expanded into lookup tables, and every other row reads its bits at the
+ * pivot columns and XORs one entry per table. All rows below the current
+ * pivot are zero left of the strip, so tables and XORs start at the strip's
+ * first word.
+ * Every XOR of row words runs on the dispatched bitwise kernel of
+ * compat.h.
+ *
+ * @see gf2.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "gf2.h"
+#include "bitvector_internal.h"
+
+#include <string.h>
+
+/** @brief Entries per lookup table. */
+#define GF2_TABLE_SIZE (1u << GF2_TABLE_BITS)
+
+/**
+ * @brief Lookup tables for one strip.
+ *
+ * Table @c k holds every XOR combination of rows
+ * <tt>[k * GF2_TABLE_BITS, (k + 1) * GF2_TABLE_BITS)</tt>; entry @c mask is
+ * the XOR of the rows whose bit is set in @c mask.
+ */
+typedef struct {
+    uint64_t *buf;                /**< GF2_MAX_TABLES tables of entries. */
+    size_t buf_bytes;             /**< Size of @c buf. */
+    size_t width;                 /**< Words per entry. */
+    unsigned n_rows;              /**< Rows combined in this strip. */
+    unsigned off[GF2_STRIP_BITS]; /**< Strip column selecting each row. */
+    bool contiguous;              /**< @c off[j] == j for every row. */
+} GF2Tables;
+
+/**
+ * @brief Allocate table storage.
+ * @param t Tables to initialise.
+ * @param max_width Largest entry width in words.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+gf2_tables_init(GF2Tables *t, size_t max_width)
+{
+    const size_t words =
+        (size_t) GF2_MAX_TABLES * GF2_TABLE_SIZE * (max_width ? max_width : 1);
+    t->buf_bytes = words * sizeof(uint64_t);
+    t->buf = cbits_malloc_aligned(t->buf_bytes, BV_ALIGN);
+    return t->buf ? 0 : -1;
+}
+
+/**
+ * @brief Release table storage.
+ * @param t Tables from @ref gf2_tables_init.
+ */
+static void
+gf2_tables_free(GF2Tables *t)
+{
+    cbits_free_aligned(t->buf, t->buf_bytes);
+    t->buf = NULL;
+}
+
+/**
+ * @brief Store the XOR of @p n words of @p a and @p b in @p dst.
+ * @param dst Destination words; may be @p a, must not otherwise overlap.
+ * @param a First operand.
+ * @param b Second operand.
+ * @param n Word count.
+ */
+static inline void
+gf2_xor_words(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n)
+{
+    cbits_bitwise_words(dst, a, b, n, CBITS_BITWISE_XOR);
+}
+
+/**
+ * @brief Fill the tables from up to @ref GF2_STRIP_BITS source rows.
+ *
+ * Entry @c mask is built from the entry without its lowest bit, so each
+ * entry costs a single row XOR.
+ * @param t Tables (with @c off and @c contiguous already set).
+ * @param src Source rows, each @p width words.
+ * @param n Number of source rows.
+ * @param width Words per row.
+ */
+static void
+gf2_tables_build(GF2Tables *t, const uint64_t *const *src, unsigned n,
+                 size_t width)
+{
+    t->width = width;
+    t->n_rows = n;
+    for (unsigned base = 0; base < n; base += GF2_TABLE_BITS) {
+        const unsigned bits =
+            n - base < GF2_TABLE_BITS ? n - base : GF2_TABLE_BITS;
+        uint64_t *table =
+            t->buf + (size_t) (base / GF2_TABLE_BITS) * GF2_TABLE_SIZE * width;
+        memset(table, 0, width * sizeof(uint64_t));
+        for (unsigned mask = 1; mask < (1u << bits); ++mask) {
+            gf2_xor_words(table + (size_t) mask * width,
+                          table + (size_t) (mask & (mask - 1)) * width,
+                          src[base + cbits_ctz64(mask)], width);
+        }
+    }
+}
+
+/**
+ * @brief Read a few consecutive bits of a row.
+ * @param row Row words.
+ * @param col First column.
+ * @param n Number of bits, at most @ref GF2_STRIP_BITS.
+ * @return The bits, column @p col in bit 0.
+ */
+static inline uint64_t
+gf2_read_bits(const uint64_t *row, size_t col, unsigned n)
+{
+    const size_t w = bv_word(col);
+    const unsigned b = (unsigned) bv_bit(col);
+    uint64_t v = row[w] >> b;
+    if (b + n > 64) {
+        v |= row[w + 1] << (64 - b);
+    }
+    return v & ((1ULL << n) - 1);
+}
+
+/**
+ * @brief Table index selected by a strip window for table @p k.
+ * @param t Tables.
+ * @param window Strip bits of the row being reduced.
+ * @param k Table number.
+ * @return Entry index.
+ */
+static inline unsigned
+gf2_tables_mask(const GF2Tables *t, uint64_t window, unsigned k)
+{
+    const unsigned base = k * GF2_TABLE_BITS;
+    const unsigned bits =
+        t->n_rows - base < GF2_TABLE_BITS ? t->n_rows - base : GF2_TABLE_BITS;
+    if (t->contiguous) {
+        return (unsigned) (window >> base) & ((1u << bits) - 1);
+    }
+    unsigned mask = 0;
+    for (unsigned j = 0; j < bits; ++j) {
+        mask |= (unsigned) ((window >> t->off[base + j]) & 1) << j;
+    }
+    return mask;
+}
+
+/**
+ * @brief XOR the entries selected by @p window into a row.
+ * @param t Tables.
+ * @param dst Destination words (@c t->width of them).
+ * @param window Strip bits of the row.
+ */
+static inline void
+gf2_tables_apply(const GF2Tables *t, uint64_t *dst, uint64_t window)
+{
+    for (unsigned k = 0; k * GF2_TABLE_BITS < t->n_rows; ++k) {
+        const unsigned mask = gf2_tables_mask(t, window, k);
+        if (mask) {
+            gf2_xor_words(
+                dst, dst,
+                t->buf + ((size_t) k * GF2_TABLE_SIZE + mask) * t->width,
+                t->width);
+        }
+    }
+}
+
+/**
+ * @brief Test a bit of a row.
+ * @param row Row words.
+ * @param col Column.
+ * @return @c 0 or @c 1.
+ */
+static inline int
+gf2_bit(const uint64_t *row, size_t col)
+{
+    return (int) ((row[bv_word(col)] >> bv_bit(col)) & 1);
+}
+
+/**
+ * @brief Find the pivots of one strip with plain Gaussian elimination.
+ *
+ * Rows are reduced by the strip's earlier pivots only when they are
+ * inspected; new pivots are cleared from the earlier pivot rows so that the
+ * pivot rows stay in identity form on the pivot columns.
+ * @param m Matrix; rows @c [r, n_rows) are zero left of column @p c.
+ * @param r First row that may become a pivot.
+ * @param c First column of the strip.
+ * @param k Strip width in columns.
+ * @param off Receives the strip offset of each pivot column.
+ * @return Number of pivots; they are moved to rows @c [r, r + count).
+ */
+static unsigned
+gf2_strip_pivots(BitMatrix *m, size_t r, size_t c, unsigned k, unsigned *off)
+{
+    const size_t w0 = bv_word(c);
+    const size_t width = m->row_words - w0;
+    const size_t base = w0 << 6;
+    unsigned kk = 0;
+
+    for (unsigned j = 0; j < k && r + kk < m->n_rows; ++j) {
+        const size_t col = c + j - base;
+        for (size_t i = r + kk; i < m->n_rows; ++i) {
+            uint64_t *row = bm_row(m, i) + w0;
+            for (unsigned l = 0; l < kk; ++l) {
+                if (gf2_bit(row, c + off[l] - base)) {
+                    gf2_xor_words(row, row, bm_row(m, r + l) + w0, width);
+                }
+            }
+            if (!gf2_bit(row, col)) {
+                continue;
+            }
+            uint64_t *pivot = bm_row(m, r + kk) + w0;
+            if (pivot != row) {
+                for (size_t w = 0; w < width; ++w) {
+                    const uint64_t tmp = pivot[w];
+                    pivot[w] = row[w];
+                    row[w] = tmp;
+                }
+            }
+            for (unsigned l = 0; l < kk; ++l) {
+                uint64_t *prev = bm_row(m, r + l) + w0;
+                if (gf2_bit(prev, col)) {
+                    gf2_xor_words(prev, prev, pivot, width);
+                }
+            }
+            off[kk++] = j;
+            break;
+        }
+    }
+    return kk;
+}
+
+/**
+ * @brief Clear a strip's pivot columns from a range of rows.
+ * @param m Matrix.
+ * @param t Tables built from the strip's pivot rows.
+ * @param c First column of the strip.
+ * @param k Strip width in columns.
+ * @param from First row.
+ * @param to One past the last row.
+ */
+static void
+gf2_eliminate_rows(BitMatrix *m, const GF2Tables *t, size_t c, unsigned k,
+                   size_t from, size_t to)
+{
+    const size_t w0 = bv_word(c);
+    for (size_t i = from; i < to; ++i) {
+        uint64_t *row = bm_row(m, i);
+        const uint64_t window = gf2_read_bits(row, c, k);
+        if (window) {
+            gf2_tables_apply(t, row + w0, window);
+        }
+    }
+}
+
+size_t
+gf2_echelon(BitMatrix *m, bool reduced, size_t *pivots)
+{
+    GF2Tables t;
+    if (gf2_tables_init(&t, m->row_words) < 0) {
+        return SIZE_MAX;
+    }
+
+    size_t r = 0;
+    for (size_t c = 0; c < m->n_cols && r < m->n_rows; c += GF2_STRIP_BITS) {
+        const unsigned k = m->n_cols - c < GF2_STRIP_BITS
+                               ? (unsigned) (m->n_cols - c)
+                               : GF2_STRIP_BITS;
+        const unsigned kk = gf2_strip_pivots(m, r, c, k, t.off);
+        if (kk == 0) {
+            continue;
+        }
+
+        const size_t w0 = bv_word(c);
+        const uint64_t *src[GF2_STRIP_BITS];
+        t.contiguous = true;
+        for (unsigned j = 0; j < kk; ++j) {
+            src[j] = bm_row(m, r + j) + w0;
+            t.contiguous &= t.off[j] == j;
+            if (pivots) {
+                pivots[r + j] = c + t.off[j];
+            }
+        }
+        gf2_tables_build(&t, src, kk, m->row_words - w0);
+
+        if (reduced) {
+            gf2_eliminate_rows(m, &t, c, k, 0, r);
+        }
+        gf2_eliminate_rows(m, &t, c, k, r + kk, m->n_rows);
+        r += kk;
+    }
+
+    for (size_t i = 0; i < m->n_rows; ++i) {
+        m->rows[i].rank_dirty = true;
+    }
+    gf2_tables_free(&t);
+    return r;
+}
+
+size_t
+gf2_rank(const BitMatrix *m)
+{
+    BitMatrix *tmp = bm_copy(m);
+    if (!tmp) {
+        return SIZE_MAX;
+    }
+    const size_t rank = gf2_echelon(tmp, false, NULL);
+    bm_free(tmp);
+    return rank;
+}
+
+BitMatrix *
+gf2_nullspace(const BitMatrix *m)
+{
+    const size_t n = m->n_cols;
+    BitMatrix *rref = bm_copy(m);
+    size_t *pivots = cbits_malloc((n ? n : 1) * sizeof(size_t));
+    bool *is_pivot = cbits_calloc(n ? n : 1, sizeof(bool));
+    BitMatrix *basis = NULL;
+    if (!rref || !pivots || !is_pivot) {
+        goto done;
+    }
+    const size_t rank = gf2_echelon(rref, true, pivots);
+    if (rank == SIZE_MAX) {
+        goto done;
+    }
+    basis = bm_new(n - rank, n);
+    if (!basis) {
+        goto done;
+    }
+    for (size_t i = 0; i < rank; ++i) {
+        is_pivot[pivots[i]] = true;
+    }
+    /* Free column f contributes x_f = 1 and x_p = R[i][f] per pivot row. */
+    for (size_t f = 0, q = 0; f < n; ++f) {
+        if (is_pivot[f]) {
+            continue;
+        }
+        uint64_t *out = bm_row(basis, q++);
+        out[bv_word(f)] |= 1ULL << bv_bit(f);
+        for (size_t i = 0; i < rank; ++i) {
+            if (gf2_bit(bm_row(rref, i), f)) {
+                out[bv_word(pivots[i])] |= 1ULL << bv_bit(pivots[i]);
+            }
+        }
+    }
+
+done:
+    cbits_free(is_pivot);
+    cbits_free(pivots);
+    bm_free(rref);
+    return basis;
+}
+
+BitMatrix *
+gf2_mul(const BitMatrix *a, const BitMatrix *b)
+{
+    if (a->n_cols != b->n_rows) {
+        return NULL;
+    }
+    BitMatrix *out = bm_new(a->n_rows, b->n_cols);
+    if (!out || !b->row_words) {
+        return out;
+    }
+
+    /* Tables only pay off once they are reused by enough rows. */
+    if (a->n_rows < GF2_TABLE_SIZE / 4) {
+        for (size_t i = 0; i < a->n_rows; ++i) {
+            const uint64_t *row = bm_row(a, i);
+            for (size_t w = 0; w < a->row_words; ++w) {
+                for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                    const size_t j = (w << 6) + cbits_ctz64(bits);
+                    uint64_t *dst = bm_row(out, i);
+                    gf2_xor_words(dst, dst, bm_row(b, j), b->row_words);
+                }
+            }
+        }
+        return out;
+    }
+
+    GF2Tables t;
+    if (gf2_tables_init(&t, b->row_words) < 0) {
+        bm_free(out);
+        return NULL;
+    }
+    t.contiguous = true;
+    for (size_t c = 0; c < a->n_cols; c += GF2_STRIP_BITS) {
+        const unsigned k = a->n_cols - c < GF2_STRIP_BITS
+                               ? (unsigned) (a->n_cols - c)
+                               : GF2_STRIP_BITS;
+        const uint64_t *src[GF2_STRIP_BITS];
+        for (unsigned j = 0; j < k; ++j) {
+            src[j] = bm_row(b, c + j);
+            t.off[j] = j;
+        }
+        gf2_tables_build(&t, src, k, b->row_words);
+        for (size_t i = 0; i < a->n_rows; ++i) {
+            const uint64_t window = gf2_read_bits(bm_row(a, i), c, k);
+            if (window) {
+                gf2_tables_apply(&t, bm_row(out, i), window);
+            }
+        }
+    }
+    gf2_tables_free(&t);
+    return out;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file src/cbits/key_hash.c
+ * @brief XXH64 and FNV-1a key hashes.
+ *
+ * This module implements:
+ * - XXH64, bit-identical to the reference implementation, with a shortcut
+ *   for 8-byte integer keys
+ * - FNV-1a seeded through the offset basis and finished with the
+ *   MurmurHash3 avalanche step
+ * - the batched wrappers declared in key_hash.h
+ *
+ * @see key_hash.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "key_hash.h"
+
+/* XXH64 primes. */
+#define XXH_P1 0x9E3779B185EBCA87ULL
+#define XXH_P2 0xC2B2AE3D27D4EB4FULL
+#define XXH_P3 0x165667B19E3779F9ULL
+#define XXH_P4 0x85EBCA77C2B2AE63ULL
+#define XXH_P5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t
+key__rotl(uint64_t x, unsigned r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * @brief Load a little-endian 64-bit word from unaligned memory.
+ */
+static inline uint64_t
+key__load64(const uint8_t *p)
+{
+    return (uint64_t) p[0] | (uint64_t) p[1] << 8 | (uint64_t) p[2] << 16 |
+           (uint64_t) p[3] << 24 | (uint64_t) p[4] << 32 |
+           (uint64_t) p[5] << 40 | (uint64_t) p[6] << 48 |
+           (uint64_t) p[7] << 56;
+}
+
+/**
+ * @brief Load a little-endian 32-bit word from unaligned memory.
+ */
+static inline uint64_t
+key__load32(const uint8_t *p)
+{
+    return (uint64_t) p[0] | (uint64_t) p[1] << 8 | (uint64_t) p[2] << 16 |
+           (uint64_t) p[3] << 24;
+}
+
+/**
+ * @brief Store a 64-bit word in little-endian order.
+ */
+static inline void
+key__store64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        p[i] = (uint8_t) (v >> (8 * i));
+    }
+}
+
+static inline uint64_t
+key__xxh_round(uint64_t acc, uint64_t input)
+{
+    acc += input * XXH_P2;
+    return key__rotl(acc, 31) * XXH_P1;
+}
+
+static inline uint64_t
+key__xxh_merge(uint64_t acc, uint64_t v)
+{
+    acc ^= key__xxh_round(0, v);
+    return acc * XXH_P1 + XXH_P4;
+}
+
+static inline uint64_t
+key__xxh_avalanche(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    return h ^ (h >> 32);
+}
+
+/**
+ * @brief XXH64 of a byte string.
+ * @param p Input bytes.
+ * @param len Input length.
+ * @param seed Hash seed.
+ * @return 64-bit hash, identical to the reference implementation.
+ */
+static uint64_t
+key__xxh64(const uint8_t *p, size_t len, uint64_t seed)
+{
+    const uint8_t *end = p + len;
+    uint64_t h;
+    if (len >= 32) {
+        uint64_t v1 = seed + XXH_P1 + XXH_P2, v2 = seed + XXH_P2;
+        uint64_t v3 = seed, v4 = seed - XXH_P1;
+        for (; end - p >= 32; p += 32) {
+            v1 = key__xxh_round(v1, key__load64(p));
+            v2 = key__xxh_round(v2, key__load64(p + 8));
+            v3 = key__xxh_round(v3, key__load64(p + 16));
+            v4 = key__xxh_round(v4, key__load64(p + 24));
+        }
+        h = key__rotl(v1, 1) + key__rotl(v2, 7) + key__rotl(v3, 12) +
+            key__rotl(v4, 18);
+        h = key__xxh_merge(h, v1);
+        h = key__xxh_merge(h, v2);
+        h = key__xxh_merge(h, v3);
+        h = key__xxh_merge(h, v4);
+    }
+    else {
+        h = seed + XXH_P5;
+    }
+    h += (uint64_t) len;
+    for (; end - p >= 8; p += 8) {
+        h ^= key__xxh_round(0, key__load64(p));
+        h = key__rotl(h, 27) * XXH_P1 + XXH_P4;
+    }
+    if (end - p >= 4) {
+        h ^= key__load32(p) * XXH_P1;
+        h = key__rotl(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= (uint64_t) *p * XXH_P5;
+        h = key__rotl(h, 11) * XXH_P1;
+    }
+    return key__xxh_avalanche(h);
+}
+
+/**
+ * @brief XXH64 of the 8 little-endian bytes of @p key.
+ */
+static inline uint64_t
+key__xxh64_u64(uint64_t key, uint64_t seed)
+{
+    uint64_t h = seed + XXH_P5 + 8;
+    h ^= key__xxh_round(0, key);
+    h = key__rotl(h, 27) * XXH_P1 + XXH_P4;
+    return key__xxh_avalanche(h);
+}
+
+/**
+ * @brief FNV-1a of a byte string, seeded through the offset basis and
+ *        followed by the MurmurHash3 finalizer so that all output bits
+ *        depend on all input bytes.
+ */
+static uint64_t
+key__fnv1a(const uint8_t *p, size_t len, uint64_t seed)
+{
+    uint64_t h = 0xCBF29CE484222325ULL ^ seed;
+    for (size_t i = 0; i < len; ++i) {
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    return h ^ (h >> 33);
+}
+
+uint64_t
+key_hash(KeyHash hash, uint64_t seed, const void *key, size_t len)
+{
+    if (hash == KEY_HASH_FNV1A) {
+        return key__fnv1a((const uint8_t *) key, len, seed);
+    }
+    return key__xxh64((const uint8_t *) key, len, seed);
+}
+
+uint64_t
+key_hash_u64(KeyHash hash, uint64_t seed, uint64_t key)
+{
+    if (hash == KEY_HASH_XXH64) {
+        return key__xxh64_u64(key, seed);
+    }
+    uint8_t bytes[8];
+    key__store64(bytes, key);
+    return key_hash(hash, seed, bytes, sizeof(bytes));
+}
+
+void
+key_hash_u64_many(KeyHash hash, uint64_t seed, const uint64_t *keys,
+                  size_t n, uint64_t *out)
+{
+    if (hash == KEY_HASH_XXH64) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = key__xxh64_u64(keys[i], seed);
+        }
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = key_hash_u64(hash, seed, keys[i]);
+    }
+}
+
+void
+key_hash_fixed_many(KeyHash hash, uint64_t seed, const void *data,
+                    size_t width, size_t n, uint64_t *out)
+{
+    const uint8_t *p = (const uint8_t *) data;
+    for (size_t i = 0; i < n; ++i, p += width) {
+        out[i] = key_hash(hash, seed, p, width);
+    }
+}
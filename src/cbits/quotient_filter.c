@@ -0,0 +1,534 @@
+/**
+ * @file src/cbits/quotient_filter.c
+ * @brief Rank-and-select quotient filter over two BitVectors.
+ *
+ * This module implements:
+ * - sizing and construction (\ref qf_params, \ref qf_new)
+ * - run location from the block offsets with an in-block popcount and an
+ *   in-word select over @c runends
+ * - insertion, lookup and deletion with the shifting of the following
+ *   runs, plus their batched and prefetching variants
+ *
+ * Slots are not wrapped around: runs that are pushed past the last home
+ * slot spill into an overflow area of about <tt>10 sqrt(2^q)</tt> slots,
+ * and an insertion fails once no free slot is left behind its run. The
+ * filter also stops at one key per home slot: past that load the false
+ * positive rate grows beyond the <tt>2^-r</tt> that @ref qf_params plans.
+ *
+ * @see quotient_filter.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "quotient_filter.h"
+#include "bitvector_internal.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @def QF_PREFETCH_DISTANCE
+ * @brief How many keys ahead the batched functions prefetch.
+ */
+#define QF_PREFETCH_DISTANCE 8
+
+/* Slot access */
+
+/** @brief Quotient of a key hash. */
+static inline size_t
+qf__quotient(const QuotientFilter *qf, uint64_t hash)
+{
+    return (size_t) (hash >> (64 - qf->q_bits));
+}
+
+/** @brief Remainder of a key hash. */
+static inline uint64_t
+qf__remainder(const QuotientFilter *qf, uint64_t hash)
+{
+    const unsigned shift = 64 - qf->q_bits - qf->r_bits;
+    return (hash >> shift) & ((UINT64_C(1) << qf->r_bits) - 1);
+}
+
+/** @brief Remainder stored in @p slot. */
+static inline uint64_t
+qf__get(const QuotientFilter *qf, size_t slot)
+{
+    const size_t bit = slot * qf->r_bits;
+    const unsigned off = (unsigned) (bit & 63);
+    const uint64_t *w = qf->remainders + (bit >> 6);
+    uint64_t v = w[0] >> off;
+    if (off + qf->r_bits > 64) {
+        v |= w[1] << (64 - off);
+    }
+    return v & ((UINT64_C(1) << qf->r_bits) - 1);
+}
+
+/** @brief Store remainder @p r in @p slot. */
+static inline void
+qf__put(QuotientFilter *qf, size_t slot, uint64_t r)
+{
+    const size_t bit = slot * qf->r_bits;
+    const unsigned off = (unsigned) (bit & 63);
+    const uint64_t mask = (UINT64_C(1) << qf->r_bits) - 1;
+    uint64_t *w = qf->remainders + (bit >> 6);
+    w[0] = (w[0] & ~(mask << off)) | (r << off);
+    if (off + qf->r_bits > 64) {
+        const unsigned spill = 64 - off;
+        w[1] = (w[1] & ~(mask >> spill)) | (r >> spill);
+    }
+}
+
+/* Run location */
+
+/**
+ * @brief Number of set bits of @p data in <tt>[lo, hi)</tt>.
+ */
+static inline size_t
+qf__popcount_range(const uint64_t *data, size_t lo, size_t hi)
+{
+    if (lo >= hi) {
+        return 0;
+    }
+    const size_t lw = lo >> 6, hw = (hi - 1) >> 6;
+    const uint64_t head = ~UINT64_C(0) << (lo & 63);
+    const uint64_t tail = ~UINT64_C(0) >> (63 - ((hi - 1) & 63));
+    if (lw == hw) {
+        return cbits_popcount64(data[lw] & head & tail);
+    }
+    size_t c = cbits_popcount64(data[lw] & head);
+    for (size_t w = lw + 1; w < hw; ++w) {
+        c += cbits_popcount64(data[w]);
+    }
+    return c + cbits_popcount64(data[hw] & tail);
+}
+
+/**
+ * @brief Position of the @p d-th (1-based) run end at or after @p pos.
+ */
+static inline size_t
+qf__select_runend(const QuotientFilter *qf, size_t pos, size_t d)
+{
+    const uint64_t *data = qf->runends->data;
+    size_t w = pos >> 6;
+    uint64_t word = data[w] & (~UINT64_C(0) << (pos & 63));
+    for (;;) {
+        const size_t c = cbits_popcount64(word);
+        if (d <= c) {
+            return (w << 6) + bv__select_in_word(word, (unsigned) (d - 1));
+        }
+        d -= c;
+        word = data[++w];
+    }
+}
+
+/**
+ * @brief Advance a known run end over the quotients in <tt>[lo, x]</tt>.
+ *
+ * @param qf Filter.
+ * @param end One past the run end of the last occupied quotient before
+ *        @p lo, or a slot no later than @p lo if that run ends earlier.
+ * @param lo First quotient to account for.
+ * @param x Last quotient to account for.
+ * @return The same quantity for the last occupied quotient up to @p x.
+ */
+static inline size_t
+qf__end_from(const QuotientFilter *qf, size_t end, size_t lo, size_t x)
+{
+    const size_t d = qf__popcount_range(qf->occupieds->data, lo, x + 1);
+    return d ? qf__select_runend(qf, end, d) + 1 : end;
+}
+
+/**
+ * @brief One past the end of the run of the last occupied quotient up to
+ *        @p x.
+ *
+ * The result is exact whenever it is greater than @p x; otherwise slot
+ * @p x is not covered by any run and the result is only a lower bound for
+ * where runs after @p x may start.
+ */
+static inline size_t
+qf__run_end(const QuotientFilter *qf, size_t x)
+{
+    const size_t first = x & ~(size_t) 63;
+    return qf__end_from(qf, first + qf->offsets[x >> 6], first + 1, x);
+}
+
+/**
+ * @brief Recompute the offsets of all blocks that start in
+ *        <tt>[lo, hi]</tt>, in order, each from the previous one.
+ */
+static void
+qf__update_offsets(QuotientFilter *qf, size_t lo, size_t hi)
+{
+    const size_t n_blocks = qf->n_slots >> 6;
+    size_t last = hi >> 6;
+    if (last >= n_blocks) {
+        last = n_blocks - 1;
+    }
+    for (size_t b = (lo + 63) >> 6; b <= last; ++b) {
+        const size_t first = b << 6;
+        size_t end;
+        if (b == 0) {
+            end = qf__end_from(qf, 0, 0, 0);
+        }
+        else {
+            const size_t prev = first - 64;
+            end = qf__end_from(qf, prev + qf->offsets[b - 1], prev + 1,
+                               first);
+        }
+        qf->offsets[b] = end > first ? end - first : 0;
+    }
+}
+
+/**
+ * @brief Slot range <tt>[start, end)</tt> of the run of occupied quotient
+ *        @p q.
+ *
+ * The run starts after the previous run end, so both ends come from one
+ * select: the end of the run is the next set bit of @c runends.
+ */
+static inline void
+qf__run(const QuotientFilter *qf, size_t q, size_t *start, size_t *end)
+{
+    const size_t first = q & ~(size_t) 63;
+    const size_t base = first + qf->offsets[q >> 6];
+    const size_t d =
+        qf__popcount_range(qf->occupieds->data, first + 1, q + 1);
+    size_t prev;
+    if (d == 0) {
+        /* q is the first slot of its block and its run end is known. */
+        *end = base;
+        prev = q ? qf__run_end(qf, q - 1) : 0;
+    }
+    else {
+        prev = d > 1 ? qf__select_runend(qf, base, d - 1) + 1 : base;
+        *end = qf__select_runend(qf, prev, 1) + 1;
+    }
+    *start = prev > q ? prev : q;
+}
+
+/** @brief Prefetch the metadata and home remainder of a key. */
+static inline void
+qf__prefetch(const QuotientFilter *qf, uint64_t hash)
+{
+    const size_t q = qf__quotient(qf, hash);
+    cbits_prefetch(qf->occupieds->data + (q >> 6));
+    cbits_prefetch(qf->runends->data + (q >> 6));
+    cbits_prefetch(qf->offsets + (q >> 6));
+    cbits_prefetch(qf->remainders + ((q * qf->r_bits) >> 6));
+}
+
+/* Construction */
+
+int
+qf_params(size_t capacity, double error_rate, unsigned *q_bits,
+          unsigned *r_bits)
+{
+    if (!(error_rate > 0.0 && error_rate < 1.0)) {
+        return -1;
+    }
+    const double slots = ceil((double) capacity / QF_MAX_LOAD);
+    unsigned q = 6;
+    while (q < QF_MAX_QUOTIENT_BITS && ldexp(1.0, (int) q) < slots) {
+        ++q;
+    }
+    if (ldexp(1.0, (int) q) < slots) {
+        return -1;
+    }
+    double r = ceil(-log2(error_rate));
+    if (r < 1.0) {
+        r = 1.0;
+    }
+    if (r > 64.0 - q) {
+        return -1;
+    }
+    *q_bits = q;
+    *r_bits = (unsigned) r;
+    return 0;
+}
+
+QuotientFilter *
+qf_new(unsigned q_bits, unsigned r_bits, KeyHash hash, uint64_t seed)
+{
+    if (q_bits == 0 || q_bits > QF_MAX_QUOTIENT_BITS || r_bits == 0 ||
+        q_bits + r_bits > 64 || (unsigned) hash >= KEY_HASH_COUNT) {
+        return NULL;
+    }
+    const size_t home = (size_t) 1 << q_bits;
+    size_t overflow = (size_t) (10.0 * sqrt((double) home));
+    if (overflow < 64) {
+        overflow = 64;
+    }
+    const size_t n_slots = (home + overflow + 63) & ~(size_t) 63;
+    if (n_slots > SIZE_MAX / r_bits) {
+        return NULL;
+    }
+    QuotientFilter *qf = cbits_calloc(1, sizeof(QuotientFilter));
+    if (!qf) {
+        return NULL;
+    }
+    qf->n_slots = n_slots;
+    qf->q_bits = q_bits;
+    qf->r_bits = r_bits;
+    qf->hash = hash;
+    qf->seed = seed;
+    /* One spare word so that qf__get may always read w[1]. */
+    const size_t rem_words = (n_slots * r_bits + 63) / 64 + 1;
+    qf->occupieds = bv_new(n_slots);
+    qf->runends = bv_new(n_slots);
+    qf->remainders = cbits_calloc(rem_words, sizeof(uint64_t));
+    qf->offsets = cbits_calloc(n_slots >> 6, sizeof(size_t));
+    if (!qf->occupieds || !qf->runends || !qf->remainders || !qf->offsets) {
+        qf_free(qf);
+        return NULL;
+    }
+    return qf;
+}
+
+QuotientFilter *
+qf_copy(const QuotientFilter *qf)
+{
+    QuotientFilter *copy = qf_new(qf->q_bits, qf->r_bits, qf->hash,
+                                  qf->seed);
+    if (!copy) {
+        return NULL;
+    }
+    const size_t words = qf->occupieds->n_words;
+    memcpy(copy->occupieds->data, qf->occupieds->data,
+           words * sizeof(uint64_t));
+    memcpy(copy->runends->data, qf->runends->data, words * sizeof(uint64_t));
+    memcpy(copy->remainders, qf->remainders,
+           ((qf->n_slots * qf->r_bits + 63) / 64 + 1) * sizeof(uint64_t));
+    memcpy(copy->offsets, qf->offsets, (qf->n_slots >> 6) * sizeof(size_t));
+    copy->n_items = qf->n_items;
+    return copy;
+}
+
+void
+qf_free(QuotientFilter *qf)
+{
+    if (!qf) {
+        return;
+    }
+    bv_free(qf->occupieds);
+    bv_free(qf->runends);
+    cbits_free(qf->remainders);
+    cbits_free(qf->offsets);
+    cbits_free(qf);
+}
+
+size_t
+qf_memory_usage(const QuotientFilter *qf)
+{
+    if (!qf) {
+        return 0;
+    }
+    const size_t words = qf->occupieds->n_words + 1;
+    return sizeof(QuotientFilter) + 2 * sizeof(BitVector) +
+           2 * words * sizeof(uint64_t) +
+           ((qf->n_slots * qf->r_bits + 63) / 64 + 1) * sizeof(uint64_t) +
+           (qf->n_slots >> 6) * sizeof(size_t);
+}
+
+/* Single-key operations */
+
+int
+qf_insert_hash(QuotientFilter *qf, uint64_t hash)
+{
+    if (qf->n_items >= (size_t) 1 << qf->q_bits) {
+        return -1;
+    }
+    const size_t q = qf__quotient(qf, hash);
+    const uint64_t r = qf__remainder(qf, hash);
+    const bool occupied = bv__get_inline(qf->occupieds, q);
+    /* New remainders go to the end of their run, or start a new run. */
+    const size_t end = qf__run_end(qf, q);
+    const size_t pos = end > q ? end : q;
+
+    size_t free_slot = pos;
+    for (;;) {
+        if (free_slot >= qf->n_slots) {
+            return -1;
+        }
+        const size_t e = qf__run_end(qf, free_slot);
+        if (e <= free_slot) {
+            break;
+        }
+        free_slot = e;
+    }
+
+    BitVector *runends = qf->runends;
+    for (size_t s = free_slot; s > pos; --s) {
+        qf__put(qf, s, qf__get(qf, s - 1));
+        if (bv__get_inline(runends, s - 1)) {
+            bv__set_inline(runends, s);
+        }
+        else {
+            bv__clear_inline(runends, s);
+        }
+    }
+    qf__put(qf, pos, r);
+    if (occupied) {
+        bv__clear_inline(runends, pos - 1);
+    }
+    else {
+        bv__set_inline(qf->occupieds, q);
+    }
+    bv__set_inline(runends, pos);
+    qf__update_offsets(qf, q, free_slot);
+    qf->n_items++;
+    return 0;
+}
+
+size_t
+qf_count_hash(const QuotientFilter *qf, uint64_t hash)
+{
+    const size_t q = qf__quotient(qf, hash);
+    if (!bv__get_inline(qf->occupieds, q)) {
+        return 0;
+    }
+    const uint64_t r = qf__remainder(qf, hash);
+    size_t start, end, count = 0;
+    qf__run(qf, q, &start, &end);
+    for (size_t s = start; s < end; ++s) {
+        count += qf__get(qf, s) == r;
+    }
+    return count;
+}
+
+bool
+qf_contains_hash(const QuotientFilter *qf, uint64_t hash)
+{
+    const size_t q = qf__quotient(qf, hash);
+    if (!bv__get_inline(qf->occupieds, q)) {
+        return false;
+    }
+    const uint64_t r = qf__remainder(qf, hash);
+    size_t start, end;
+    qf__run(qf, q, &start, &end);
+    for (size_t s = start; s < end; ++s) {
+        if (qf__get(qf, s) == r) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief First occupied quotient in <tt>[from, limit]</tt>.
+ * @return The quotient, or a value greater than @p limit if there is none.
+ */
+static inline size_t
+qf__next_occupied(const QuotientFilter *qf, size_t from, size_t limit)
+{
+    const uint64_t *data = qf->occupieds->data;
+    size_t w = from >> 6;
+    uint64_t word = data[w] & (~UINT64_C(0) << (from & 63));
+    while (!word) {
+        if (((++w) << 6) > limit) {
+            return limit + 1;
+        }
+        word = data[w];
+    }
+    return (w << 6) + cbits_ctz64(word);
+}
+
+bool
+qf_remove_hash(QuotientFilter *qf, uint64_t hash)
+{
+    const size_t q = qf__quotient(qf, hash);
+    if (!bv__get_inline(qf->occupieds, q)) {
+        return false;
+    }
+    const uint64_t r = qf__remainder(qf, hash);
+    size_t start, end;
+    qf__run(qf, q, &start, &end);
+    size_t slot = start;
+    while (slot < end && qf__get(qf, slot) != r) {
+        ++slot;
+    }
+    if (slot == end) {
+        return false;
+    }
+
+    BitVector *runends = qf->runends;
+    /* Close the gap inside the run; its end moves down by one slot. */
+    for (size_t s = slot; s + 1 < end; ++s) {
+        qf__put(qf, s, qf__get(qf, s + 1));
+    }
+    bv__clear_inline(runends, end - 1);
+    if (end - start == 1) {
+        bv__clear_inline(qf->occupieds, q);
+    }
+    else {
+        bv__set_inline(runends, end - 2);
+    }
+
+    /* Pull the following runs back until one sits in its home slot. */
+    size_t hole = end - 1;
+    size_t quotient = q;
+    while (hole + 1 < qf->n_slots) {
+        const size_t s = hole + 1;
+        quotient = qf__next_occupied(qf, quotient + 1, s);
+        if (quotient >= s) {
+            break;
+        }
+        const size_t e = qf__select_runend(qf, s, 1);
+        for (size_t t = s; t <= e; ++t) {
+            qf__put(qf, t - 1, qf__get(qf, t));
+        }
+        bv__clear_inline(runends, e);
+        bv__set_inline(runends, e - 1);
+        hole = e;
+    }
+    qf__put(qf, hole, 0);
+    qf__update_offsets(qf, q, hole);
+    qf->n_items--;
+    return true;
+}
+
+/* Batched operations */
+
+size_t
+qf_insert_hashes(QuotientFilter *qf, const uint64_t *hashes, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (i + QF_PREFETCH_DISTANCE < n) {
+            qf__prefetch(qf, hashes[i + QF_PREFETCH_DISTANCE]);
+        }
+        if (qf_insert_hash(qf, hashes[i]) < 0) {
+            return i;
+        }
+    }
+    return n;
+}
+
+void
+qf_contains_hashes(const QuotientFilter *qf, const uint64_t *hashes,
+                   size_t n, uint64_t *out)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (i + QF_PREFETCH_DISTANCE < n) {
+            qf__prefetch(qf, hashes[i + QF_PREFETCH_DISTANCE]);
+        }
+        out[i >> 6] |= (uint64_t) qf_contains_hash(qf, hashes[i])
+                       << (i & 63);
+    }
+}
+
+size_t
+qf_remove_hashes(QuotientFilter *qf, const uint64_t *hashes, size_t n,
+                 uint64_t *out)
+{
+    size_t removed = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i + QF_PREFETCH_DISTANCE < n) {
+            qf__prefetch(qf, hashes[i + QF_PREFETCH_DISTANCE]);
+        }
+        const bool hit = qf_remove_hash(qf, hashes[i]);
+        removed += hit;
+        if (out) {
+            out[i >> 6] |= (uint64_t) hit << (i & 63);
+        }
+    }
+    return removed;
+}
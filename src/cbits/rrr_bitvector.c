@@ -0,0 +1,399 @@
+/**
+ * @file src/cbits/rrr_bitvector.c
+ * @brief RRR encoding of bit arrays with constant-time rank and select.
+ *
+ * This module implements:
+ * - block encoding and decoding in the combinatorial number system
+ * - \ref bv_build_rrr, \ref rrr_free and \ref rrr_to_bitvector
+ * - \ref rrr_get, \ref rrr_rank, \ref rrr_select and \ref rrr_count
+ *
+ * A block with @c c set bits at positions <tt>p_1 < ... < p_c</tt> is encoded
+ * as <tt>sum C(p_j, j)</tt>. Both directions walk the positions from 63 down
+ * and update the running binomial coefficient with exact multiply/divide
+ * steps, so only the top row <tt>C(63, k)</tt> needs a table.
+ *
+ * @see rrr_bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "rrr_bitvector.h"
+#include "bitvector_internal.h"
+#include <string.h>
+
+/**
+ * @brief Binomial coefficients <tt>C(63, k)</tt> for k in [0...63].
+ */
+static const uint64_t rrr_binom63[64] = {
+    UINT64_C(1), UINT64_C(63), UINT64_C(1953), UINT64_C(39711),
+    UINT64_C(595665), UINT64_C(7028847), UINT64_C(67945521),
+    UINT64_C(553270671), UINT64_C(3872894697), UINT64_C(23667689815),
+    UINT64_C(127805525001), UINT64_C(615790256823), UINT64_C(2668424446233),
+    UINT64_C(10468434365991), UINT64_C(37387265592825),
+    UINT64_C(122131734269895), UINT64_C(366395202809685),
+    UINT64_C(1012974972473835), UINT64_C(2588713818544245),
+    UINT64_C(6131164307078475), UINT64_C(13488561475572645),
+    UINT64_C(27619435402363035), UINT64_C(52728013040874885),
+    UINT64_C(93993414551124795), UINT64_C(156655690918541325),
+    UINT64_C(244382877832924467), UINT64_C(357174975294274221),
+    UINT64_C(489462003181042451), UINT64_C(629308289804197437),
+    UINT64_C(759510004936100355), UINT64_C(860778005594247069),
+    UINT64_C(916312070471295267), UINT64_C(916312070471295267),
+    UINT64_C(860778005594247069), UINT64_C(759510004936100355),
+    UINT64_C(629308289804197437), UINT64_C(489462003181042451),
+    UINT64_C(357174975294274221), UINT64_C(244382877832924467),
+    UINT64_C(156655690918541325), UINT64_C(93993414551124795),
+    UINT64_C(52728013040874885), UINT64_C(27619435402363035),
+    UINT64_C(13488561475572645), UINT64_C(6131164307078475),
+    UINT64_C(2588713818544245), UINT64_C(1012974972473835),
+    UINT64_C(366395202809685), UINT64_C(122131734269895),
+    UINT64_C(37387265592825), UINT64_C(10468434365991),
+    UINT64_C(2668424446233), UINT64_C(615790256823), UINT64_C(127805525001),
+    UINT64_C(23667689815), UINT64_C(3872894697), UINT64_C(553270671),
+    UINT64_C(67945521), UINT64_C(7028847), UINT64_C(595665), UINT64_C(39711),
+    UINT64_C(1953), UINT64_C(63), UINT64_C(1),
+};
+
+/**
+ * @brief Offset width in bits for each block class,
+ * <tt>ceil(log2(C(64, c)))</tt>.
+ */
+static const uint8_t rrr_offset_bits[65] = {
+    0, 6, 11, 16, 20, 23, 27, 30, 33, 35, 38, 40, 42, 44, 46, 48, 49, 51, 52,
+    53, 55, 56, 57, 58, 58, 59, 60, 60, 60, 61, 61, 61, 61, 61, 61, 61, 60, 60,
+    60, 59, 58, 58, 57, 56, 55, 53, 52, 51, 49, 48, 46, 44, 42, 40, 38, 35, 33,
+    30, 27, 23, 20, 16, 11, 6, 0,
+};
+
+/* -------------------------------------------------------------------------
+ * Block encoding
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Compute <tt>a * num / den</tt> for an exact quotient without
+ * overflowing 64 bits.
+ * @param a Binomial coefficient.
+ * @param num Multiplier (at most 64).
+ * @param den Divisor (non-zero, at most 64).
+ * @return The exact quotient.
+ */
+static inline uint64_t
+rrr_mul_div(uint64_t a, unsigned num, unsigned den)
+{
+    return (a / den) * num + (a % den) * num / den;
+}
+
+/**
+ * @brief Encode a block as its offset among blocks of the same class.
+ * @param word Block to encode.
+ * @param c Popcount of @p word, in [1...63].
+ * @return Offset in <tt>[0, C(64, c))</tt>.
+ */
+static uint64_t
+rrr_encode(uint64_t word, unsigned c)
+{
+    uint64_t off = 0;
+    uint64_t b = rrr_binom63[c]; /* C(p, j) */
+    unsigned j = c;
+    for (unsigned p = 63; p >= j; --p) {
+        if ((word >> p) & 1) {
+            off += b;
+            if (--j == 0) {
+                break;
+            }
+            b = rrr_mul_div(b, j + 1, p);
+        }
+        else {
+            b = rrr_mul_div(b, p - j, p);
+        }
+    }
+    return off;
+}
+
+/**
+ * @brief Decode a block from its class and offset.
+ * @param c Popcount of the block.
+ * @param off Offset produced by \ref rrr_encode.
+ * @return The 64-bit block.
+ */
+static uint64_t
+rrr_decode(unsigned c, uint64_t off)
+{
+    if (c == 0) {
+        return 0;
+    }
+    if (c == 64) {
+        return ~0ULL;
+    }
+    uint64_t word = 0;
+    uint64_t b = rrr_binom63[c];
+    unsigned j = c;
+    for (unsigned p = 63; j; --p) {
+        if (p < j) {
+            /* Only the lowest j positions are left; all must be set. */
+            word |= (UINT64_C(1) << j) - 1;
+            break;
+        }
+        if (b <= off) {
+            word |= UINT64_C(1) << p;
+            off -= b;
+            if (--j == 0) {
+                break;
+            }
+            b = rrr_mul_div(b, j + 1, p);
+        }
+        else {
+            b = rrr_mul_div(b, p - j, p);
+        }
+    }
+    return word;
+}
+
+/**
+ * @brief Read @p width bits starting at bit @p pos of a word stream.
+ * @param words Stream with one padding word past the last used word.
+ * @param pos First bit.
+ * @param width Number of bits, at most 63.
+ * @return The bits, right-aligned.
+ */
+static inline uint64_t
+rrr_read_bits(const uint64_t *words, size_t pos, unsigned width)
+{
+    if (width == 0) {
+        return 0;
+    }
+    size_t w = pos >> 6;
+    unsigned off = (unsigned) (pos & 63);
+    uint64_t v = words[w] >> off;
+    if (off + width > 64) {
+        v |= words[w + 1] << (64 - off);
+    }
+    return v & ((UINT64_C(1) << width) - 1);
+}
+
+/**
+ * @brief Decode block @p block, given its offset stream position.
+ * @param rrr Pointer to the RRRBitVector.
+ * @param block Block index.
+ * @param pos Bit position of the block's offset.
+ * @return The 64-bit block.
+ */
+static inline uint64_t
+rrr_block(const RRRBitVector *rrr, size_t block, size_t pos)
+{
+    unsigned c = rrr->classes[block];
+    return rrr_decode(c, rrr_read_bits(rrr->offsets, pos, rrr_offset_bits[c]));
+}
+
+/**
+ * @brief Walk from the preceding sample to a block.
+ * @param rrr Pointer to the RRRBitVector.
+ * @param block Target block index.
+ * @param rank Receives the number of set bits before @p block.
+ * @return Bit position of the block's offset.
+ */
+static inline size_t
+rrr_seek(const RRRBitVector *rrr, size_t block, size_t *rank)
+{
+    size_t s = block >> RRR_SAMPLE_SHIFT;
+    size_t r = rrr->rank_samples[s];
+    size_t pos = rrr->offset_samples[s];
+    for (size_t i = s << RRR_SAMPLE_SHIFT; i < block; ++i) {
+        unsigned c = rrr->classes[i];
+        r += c;
+        pos += rrr_offset_bits[c];
+    }
+    *rank = r;
+    return pos;
+}
+
+/* -------------------------------------------------------------------------
+ * Construction
+ * ------------------------------------------------------------------------- */
+
+RRRBitVector *
+bv_build_rrr(const BitVector *bv)
+{
+    if (!bv) {
+        return NULL;
+    }
+    RRRBitVector *rrr = cbits_calloc(1, sizeof(RRRBitVector));
+    if (!rrr) {
+        return NULL;
+    }
+    const size_t n = bv->n_words;
+    const size_t n_samples = (n + RRR_SAMPLE_BLOCKS - 1) >> RRR_SAMPLE_SHIFT;
+    unsigned tail = (unsigned) (bv->n_bits & 63);
+    uint64_t tail_mask = tail ? (UINT64_C(1) << tail) - 1 : ~0ULL;
+
+    rrr->n_bits = bv->n_bits;
+    rrr->n_blocks = n;
+    rrr->classes = cbits_malloc(n ? n : 1);
+    rrr->rank_samples = cbits_malloc((n_samples + 1) * sizeof(size_t));
+    rrr->offset_samples = cbits_malloc((n_samples + 1) * sizeof(size_t));
+    if (!rrr->classes || !rrr->rank_samples || !rrr->offset_samples) {
+        rrr_free(rrr);
+        return NULL;
+    }
+
+    size_t total_bits = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t word = bv->data[i] & (i + 1 == n ? tail_mask : ~0ULL);
+        unsigned c = (unsigned) cbits_popcount64(word);
+        rrr->classes[i] = (uint8_t) c;
+        total_bits += rrr_offset_bits[c];
+    }
+    rrr->offsets =
+        cbits_calloc(((total_bits + 63) >> 6) + 1, sizeof(uint64_t));
+    if (!rrr->offsets) {
+        rrr_free(rrr);
+        return NULL;
+    }
+
+    size_t ones = 0, pos = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if ((i & (RRR_SAMPLE_BLOCKS - 1)) == 0) {
+            rrr->rank_samples[i >> RRR_SAMPLE_SHIFT] = ones;
+            rrr->offset_samples[i >> RRR_SAMPLE_SHIFT] = pos;
+        }
+        unsigned c = rrr->classes[i];
+        unsigned width = rrr_offset_bits[c];
+        ones += c;
+        if (width) {
+            uint64_t word = bv->data[i] & (i + 1 == n ? tail_mask : ~0ULL);
+            uint64_t off = rrr_encode(word, c);
+            size_t w = pos >> 6;
+            unsigned shift = (unsigned) (pos & 63);
+            rrr->offsets[w] |= off << shift;
+            if (shift + width > 64) {
+                rrr->offsets[w + 1] |= off >> (64 - shift);
+            }
+            pos += width;
+        }
+    }
+    rrr->rank_samples[n_samples] = ones;
+    rrr->offset_samples[n_samples] = pos;
+    rrr->n_ones = ones;
+    return rrr;
+}
+
+void
+rrr_free(RRRBitVector *rrr)
+{
+    if (!rrr) {
+        return;
+    }
+    cbits_free(rrr->offset_samples);
+    cbits_free(rrr->rank_samples);
+    cbits_free(rrr->offsets);
+    cbits_free(rrr->classes);
+    cbits_free(rrr);
+}
+
+BitVector *
+rrr_to_bitvector(const RRRBitVector *rrr)
+{
+    if (!rrr) {
+        return NULL;
+    }
+    BitVector *bv = bv_new(rrr->n_bits);
+    if (!bv) {
+        return NULL;
+    }
+    size_t pos = 0;
+    for (size_t i = 0; i < rrr->n_blocks; ++i) {
+        bv->data[i] = rrr_block(rrr, i, pos);
+        pos += rrr_offset_bits[rrr->classes[i]];
+    }
+    return bv;
+}
+
+/* -------------------------------------------------------------------------
+ * Queries
+ * ------------------------------------------------------------------------- */
+
+int
+rrr_get(const RRRBitVector *rrr, size_t pos)
+{
+    if (!rrr || pos >= rrr->n_bits) {
+        return -1;
+    }
+    size_t block = bv_word(pos);
+    unsigned c = rrr->classes[block];
+    if (c == 0 || c == 64) {
+        return c != 0;
+    }
+    size_t rank;
+    size_t off_pos = rrr_seek(rrr, block, &rank);
+    return (int) ((rrr_block(rrr, block, off_pos) >> bv_bit(pos)) & 1);
+}
+
+size_t
+rrr_rank(const RRRBitVector *rrr, size_t pos)
+{
+    if (!rrr || rrr->n_bits == 0) {
+        return 0;
+    }
+    if (pos >= rrr->n_bits) {
+        pos = rrr->n_bits - 1;
+    }
+    size_t block = bv_word(pos);
+    size_t rank;
+    size_t off_pos = rrr_seek(rrr, block, &rank);
+    unsigned bit = (unsigned) bv_bit(pos);
+    uint64_t mask = bit == 63 ? ~0ULL : (UINT64_C(1) << (bit + 1)) - 1;
+    return rank + cbits_popcount64(rrr_block(rrr, block, off_pos) & mask);
+}
+
+size_t
+rrr_select(const RRRBitVector *rrr, size_t k)
+{
+    if (!rrr || k >= rrr->n_ones) {
+        return SIZE_MAX;
+    }
+    /* Last sample whose rank does not exceed k. */
+    size_t lo = 0;
+    size_t hi = (rrr->n_blocks + RRR_SAMPLE_BLOCKS - 1) >> RRR_SAMPLE_SHIFT;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) >> 1;
+        if (rrr->rank_samples[mid] <= k) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    size_t rank = rrr->rank_samples[lo];
+    size_t pos = rrr->offset_samples[lo];
+    size_t block = lo << RRR_SAMPLE_SHIFT;
+    for (;; ++block) {
+        unsigned c = rrr->classes[block];
+        if (k < rank + c) {
+            break;
+        }
+        rank += c;
+        pos += rrr_offset_bits[c];
+    }
+    uint64_t word = rrr_block(rrr, block, pos);
+    return (block << 6) + bv__select_in_word(word, (unsigned) (k - rank));
+}
+
+size_t
+rrr_count(const RRRBitVector *rrr)
+{
+    return rrr ? rrr->n_ones : 0;
+}
+
+size_t
+rrr_memory_usage(const RRRBitVector *rrr)
+{
+    if (!rrr) {
+        return 0;
+    }
+    size_t n_samples =
+        (rrr->n_blocks + RRR_SAMPLE_BLOCKS - 1) >> RRR_SAMPLE_SHIFT;
+    size_t offset_words = ((rrr->offset_samples[n_samples] + 63) >> 6) + 1;
+    return sizeof(RRRBitVector) + rrr->n_blocks +
+           offset_words * sizeof(uint64_t) +
+           2 * (n_samples + 1) * sizeof(size_t);
+}
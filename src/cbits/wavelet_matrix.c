@@ -0,0 +1,474 @@
+/**
+ * @file src/cbits/wavelet_matrix.c
+ * @brief Wavelet matrix construction and queries.
+ *
+ * This module implements:
+ * - \ref wm_new, \ref wm_free
+ * - \ref wm_access, \ref wm_rank, \ref wm_select
+ * - \ref wm_quantile, \ref wm_range_freq
+ *
+ * Construction has two strategies. Up to @ref WM_PARALLEL_MAX_LEVELS levels,
+ * every level is an independent counting sort of the sequence by its
+ * bit-reversed top bits, and the levels are spread over threads with
+ * \ref cbits_parallel_for. Wider alphabets use the classic sequential
+ * stable partition, one level after the other.
+ *
+ * @see wavelet_matrix.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "wavelet_matrix.h"
+#include "bitvector_internal.h"
+#include "compat_thread.h"
+#include <string.h>
+
+/**
+ * @brief Number of set bits in the first @p i positions of a level.
+ * @param bv Level with up-to-date rank tables.
+ * @param i Prefix length.
+ * @return Set bits in <tt>[0, i)</tt>.
+ */
+static inline size_t
+wm_rank1(BitVector *bv, size_t i)
+{
+    return i ? bv_rank(bv, i - 1) : 0;
+}
+
+/**
+ * @brief Number of clear bits in the first @p i positions of a level.
+ * @param bv Level with up-to-date rank tables.
+ * @param i Prefix length.
+ * @return Clear bits in <tt>[0, i)</tt>.
+ */
+static inline size_t
+wm_rank0(BitVector *bv, size_t i)
+{
+    return i - wm_rank1(bv, i);
+}
+
+/**
+ * @brief Position of the k-th set (or clear) bit of a level.
+ *
+ * Binary-searches the superblock counts, then scans at most
+ * @ref BV_WORDS_SUPER words.
+ * @param bv Level with up-to-date rank tables.
+ * @param k Zero-based index of the bit; must exist.
+ * @param bit @c 1 to search set bits, @c 0 for clear bits.
+ * @return Bit position.
+ */
+static size_t
+wm_select_bit(const BitVector *bv, size_t k, int bit)
+{
+    const size_t n_super =
+        (bv->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+    const size_t super_bits = (size_t) BV_WORDS_SUPER * 64;
+    const uint64_t flip = bit ? 0 : ~0ULL;
+
+    /* Last superblock with fewer than k + 1 target bits before it. */
+    size_t lo = 0, hi = n_super;
+    while (hi - lo > 1) {
+        size_t mid = lo + ((hi - lo) >> 1);
+        size_t before = bit ? bv->super_rank[mid]
+                            : mid * super_bits - bv->super_rank[mid];
+        if (before <= k) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    size_t r = k - (bit ? bv->super_rank[lo]
+                        : lo * super_bits - bv->super_rank[lo]);
+    size_t w = lo << BV_WORDS_SUPER_SHIFT;
+    for (;;) {
+        uint64_t word = bv->data[w] ^ flip;
+        size_t c = cbits_popcount64(word);
+        if (r < c) {
+            return (w << 6) + bv__select_in_word(word, (unsigned) r);
+        }
+        r -= c;
+        ++w;
+    }
+}
+
+/**
+ * @brief Bit of @p value stored at level @p l.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param value Symbol.
+ * @param l Level index.
+ * @return @c 0 or @c 1.
+ */
+static inline int
+wm_bit(const WaveletMatrix *wm, uint64_t value, unsigned l)
+{
+    return (int) ((value >> (wm->n_levels - 1 - l)) & 1);
+}
+
+/**
+ * @brief Whether @p value needs more than @c n_levels bits.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param value Symbol.
+ * @return @c true if @p value cannot occur in the sequence.
+ */
+static inline bool
+wm_out_of_alphabet(const WaveletMatrix *wm, uint64_t value)
+{
+    return wm->n_levels < 64 && (value >> wm->n_levels) != 0;
+}
+
+/**
+ * @brief Reverse the bits of a 64-bit word.
+ * @param x Input word.
+ * @return @p x with bit @c i moved to bit <tt>63 - i</tt>.
+ */
+static inline uint64_t
+wm_reverse64(uint64_t x)
+{
+    static const uint64_t masks[5] = {
+        0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+        0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL};
+    for (unsigned s = 0; s < 5; ++s) {
+        const unsigned width = 1u << s;
+        x = ((x >> width) & masks[s]) | ((x & masks[s]) << width);
+    }
+    return (x >> 32) | (x << 32);
+}
+
+/**
+ * @brief Shared input of the per-level construction tasks.
+ */
+typedef struct {
+    WaveletMatrix *wm;          /**< Matrix whose levels are allocated. */
+    const uint64_t *values;     /**< Input sequence. */
+    bool failed[WM_MAX_LEVELS]; /**< Per-level allocation failure flag. */
+} wm_build_ctx;
+
+/**
+ * @brief Fill one level independently of all others.
+ *
+ * At level @c l the sequence is ordered by its top @c l bits read from the
+ * least significant end (the last partition is the most significant key),
+ * so a counting sort over that key yields the order directly.
+ * @param arg Pointer to a ::wm_build_ctx.
+ * @param l Level index.
+ */
+static void
+wm_build_level_task(void *arg, size_t l)
+{
+    wm_build_ctx *ctx = arg;
+    WaveletMatrix *wm = ctx->wm;
+    const uint64_t *values = ctx->values;
+    const unsigned L = wm->n_levels;
+    const unsigned shift = 64 - L;
+    const size_t n_keys = (size_t) 1 << l;
+    const uint64_t key_mask = n_keys - 1;
+    BitVector *bv = wm->levels[l];
+
+    size_t *start = cbits_calloc(n_keys, sizeof(size_t));
+    if (!start) {
+        ctx->failed[l] = true;
+        return;
+    }
+    for (size_t i = 0; i < wm->n; ++i) {
+        start[(wm_reverse64(values[i]) >> shift) & key_mask]++;
+    }
+    size_t acc = 0;
+    for (size_t k = 0; k < n_keys; ++k) {
+        size_t c = start[k];
+        start[k] = acc;
+        acc += c;
+    }
+    for (size_t i = 0; i < wm->n; ++i) {
+        size_t pos = start[(wm_reverse64(values[i]) >> shift) & key_mask]++;
+        if (wm_bit(wm, values[i], (unsigned) l)) {
+            bv__set_inline(bv, pos);
+        }
+    }
+    cbits_free(start);
+
+    bv_build_rank(bv);
+    wm->zeros[l] = wm_rank0(bv, wm->n);
+}
+
+/**
+ * @brief Fill all levels with level-by-level stable partitions.
+ * @param wm Matrix whose levels are allocated.
+ * @param values Input sequence.
+ * @retval 0 Success.
+ * @retval -1 Allocation failure.
+ */
+static int
+wm_build_sequential(WaveletMatrix *wm, const uint64_t *values)
+{
+    const size_t n = wm->n;
+    uint64_t *cur = cbits_malloc((n ? n : 1) * sizeof(uint64_t));
+    uint64_t *next = cbits_malloc((n ? n : 1) * sizeof(uint64_t));
+    if (!cur || !next) {
+        cbits_free(cur);
+        cbits_free(next);
+        return -1;
+    }
+    if (n) {
+        memcpy(cur, values, n * sizeof(uint64_t));
+    }
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        BitVector *bv = wm->levels[l];
+        size_t zeros = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (wm_bit(wm, cur[i], l)) {
+                bv__set_inline(bv, i);
+            }
+            else {
+                next[zeros++] = cur[i];
+            }
+        }
+        size_t ones = zeros;
+        for (size_t i = 0; i < n; ++i) {
+            if (wm_bit(wm, cur[i], l)) {
+                next[ones++] = cur[i];
+            }
+        }
+        bv_build_rank(bv);
+        wm->zeros[l] = zeros;
+
+        uint64_t *tmp = cur;
+        cur = next;
+        next = tmp;
+    }
+    cbits_free(cur);
+    cbits_free(next);
+    return 0;
+}
+
+WaveletMatrix *
+wm_new(const uint64_t *values, size_t n, unsigned n_threads)
+{
+    WaveletMatrix *wm = cbits_calloc(1, sizeof(WaveletMatrix));
+    if (!wm) {
+        return NULL;
+    }
+    uint64_t max_value = 0;
+    for (size_t i = 0; i < n; ++i) {
+        max_value |= values[i];
+    }
+    wm->n = n;
+    wm->n_levels = 1;
+    while (wm->n_levels < 64 && (max_value >> wm->n_levels)) {
+        wm->n_levels++;
+    }
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        wm->levels[l] = bv_new(n);
+        if (!wm->levels[l]) {
+            wm_free(wm);
+            return NULL;
+        }
+    }
+
+    if (wm->n_levels <= WM_PARALLEL_MAX_LEVELS) {
+        wm_build_ctx ctx = {wm, values, {false}};
+        if (n < WM_PARALLEL_MIN_SIZE) {
+            n_threads = 1;
+        }
+        cbits_parallel_for(wm->n_levels, wm_build_level_task, &ctx,
+                           n_threads);
+        for (unsigned l = 0; l < wm->n_levels; ++l) {
+            if (ctx.failed[l]) {
+                wm_free(wm);
+                return NULL;
+            }
+        }
+    }
+    else if (wm_build_sequential(wm, values) < 0) {
+        wm_free(wm);
+        return NULL;
+    }
+    return wm;
+}
+
+void
+wm_free(WaveletMatrix *wm)
+{
+    if (!wm) {
+        return;
+    }
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        bv_free(wm->levels[l]);
+    }
+    cbits_free(wm);
+}
+
+uint64_t
+wm_access(const WaveletMatrix *wm, size_t i)
+{
+    if (!wm || i >= wm->n) {
+        return UINT64_MAX;
+    }
+    uint64_t value = 0;
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        BitVector *bv = wm->levels[l];
+        if (bv_get(bv, i)) {
+            i = wm->zeros[l] + wm_rank1(bv, i);
+            value = (value << 1) | 1;
+        }
+        else {
+            i = wm_rank0(bv, i);
+            value <<= 1;
+        }
+    }
+    return value;
+}
+
+size_t
+wm_rank(const WaveletMatrix *wm, uint64_t symbol, size_t i)
+{
+    if (!wm || wm_out_of_alphabet(wm, symbol)) {
+        return 0;
+    }
+    size_t start = 0, stop = i < wm->n ? i : wm->n;
+    for (unsigned l = 0; l < wm->n_levels && start < stop; ++l) {
+        BitVector *bv = wm->levels[l];
+        if (wm_bit(wm, symbol, l)) {
+            start = wm->zeros[l] + wm_rank1(bv, start);
+            stop = wm->zeros[l] + wm_rank1(bv, stop);
+        }
+        else {
+            start = wm_rank0(bv, start);
+            stop = wm_rank0(bv, stop);
+        }
+    }
+    return stop > start ? stop - start : 0;
+}
+
+size_t
+wm_select(const WaveletMatrix *wm, uint64_t symbol, size_t k)
+{
+    if (!wm || wm_out_of_alphabet(wm, symbol)) {
+        return SIZE_MAX;
+    }
+    /* Descend to the run of symbol at the bottom, then climb back up. */
+    size_t start = 0, stop = wm->n;
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        BitVector *bv = wm->levels[l];
+        if (wm_bit(wm, symbol, l)) {
+            start = wm->zeros[l] + wm_rank1(bv, start);
+            stop = wm->zeros[l] + wm_rank1(bv, stop);
+        }
+        else {
+            start = wm_rank0(bv, start);
+            stop = wm_rank0(bv, stop);
+        }
+    }
+    if (k >= stop - start) {
+        return SIZE_MAX;
+    }
+    size_t pos = start + k;
+    for (unsigned l = wm->n_levels; l-- > 0;) {
+        if (wm_bit(wm, symbol, l)) {
+            pos = wm_select_bit(wm->levels[l], pos - wm->zeros[l], 1);
+        }
+        else {
+            pos = wm_select_bit(wm->levels[l], pos, 0);
+        }
+    }
+    return pos;
+}
+
+uint64_t
+wm_quantile(const WaveletMatrix *wm, size_t start, size_t stop, size_t k)
+{
+    if (!wm) {
+        return UINT64_MAX;
+    }
+    if (stop > wm->n) {
+        stop = wm->n;
+    }
+    if (start >= stop || k >= stop - start) {
+        return UINT64_MAX;
+    }
+    uint64_t value = 0;
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        BitVector *bv = wm->levels[l];
+        size_t z_start = wm_rank0(bv, start);
+        size_t z_stop = wm_rank0(bv, stop);
+        size_t zeros = z_stop - z_start;
+        if (k < zeros) {
+            start = z_start;
+            stop = z_stop;
+            value <<= 1;
+        }
+        else {
+            k -= zeros;
+            start = wm->zeros[l] + (start - z_start);
+            stop = wm->zeros[l] + (stop - z_stop);
+            value = (value << 1) | 1;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Count the values below @p x in a range of positions.
+ * @param wm Pointer to the WaveletMatrix.
+ * @param start First position of the range.
+ * @param stop One past the last position (at most @c n).
+ * @param x Exclusive upper bound on the values.
+ * @return Number of values smaller than @p x in <tt>[start, stop)</tt>.
+ */
+static size_t
+wm_count_less(const WaveletMatrix *wm, size_t start, size_t stop, uint64_t x)
+{
+    if (wm_out_of_alphabet(wm, x)) {
+        return stop - start;
+    }
+    size_t count = 0;
+    for (unsigned l = 0; l < wm->n_levels && start < stop; ++l) {
+        BitVector *bv = wm->levels[l];
+        size_t z_start = wm_rank0(bv, start);
+        size_t z_stop = wm_rank0(bv, stop);
+        if (wm_bit(wm, x, l)) {
+            count += z_stop - z_start;
+            start = wm->zeros[l] + (start - z_start);
+            stop = wm->zeros[l] + (stop - z_stop);
+        }
+        else {
+            start = z_start;
+            stop = z_stop;
+        }
+    }
+    return count;
+}
+
+size_t
+wm_range_freq(const WaveletMatrix *wm, size_t start, size_t stop,
+              uint64_t lo, uint64_t hi)
+{
+    if (!wm) {
+        return 0;
+    }
+    if (stop > wm->n) {
+        stop = wm->n;
+    }
+    if (start >= stop || lo >= hi) {
+        return 0;
+    }
+    return wm_count_less(wm, start, stop, hi) -
+           wm_count_less(wm, start, stop, lo);
+}
+
+size_t
+wm_memory_usage(const WaveletMatrix *wm)
+{
+    if (!wm) {
+        return 0;
+    }
+    size_t total = sizeof(WaveletMatrix);
+    for (unsigned l = 0; l < wm->n_levels; ++l) {
+        const BitVector *bv = wm->levels[l];
+        size_t n_super =
+            (bv->n_words + BV_WORDS_SUPER - 1) >> BV_WORDS_SUPER_SHIFT;
+        total += sizeof(BitVector) + (bv->n_words + 1) * sizeof(uint64_t) +
+                 n_super * sizeof(size_t) + bv->n_words * sizeof(uint16_t);
+    }
+    return total;
+}
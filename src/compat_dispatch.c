@@ -3,7 +3,16 @@
  * @brief Runtime dispatch for fastest popcount block implementation.
  *
  * Contains fallback, AVX2, and AVX-512 versions of block-level popcount,
- * plus runtime CPU feature detection to select the best implementation.
+ * of the bulk word-array popcount, of the batched Hamming distance kernel,
+ * of the bitwise operators and of the bool packing and unpacking kernels,
+ * plus runtime CPU feature detection to
+ * select the best implementation. The vector kernels carry per-function
+ * target attributes, so the library itself is built for the baseline ISA
+ * and runs on any x86-64 CPU. The AVX2 bulk kernels share a Harley-Seal
+ * carry-save adder tree that popcounts only one in sixteen input vectors.
+ *
+ * The selection can be inspected and overridden per operation through
+ * @ref cbits_set_kernel or the @c CBITS_FORCE_KERNEL environment variable.
  *
  * @see include/compat.h
  * @author lambdaphoenix
@@ -12,6 +21,8 @@
  */
 #include "compat.h"
 
+#include <string.h>
+
 uint64_t
 cbits_popcount_block_fallback(const uint64_t *ptr)
 {
@@ -22,11 +33,332 @@ cbits_popcount_block_fallback(const uint64_t *ptr)
     return sum;
 }
 
-uint64_t (*cbits_popcount_block_ptr)(const uint64_t *ptr) =
+cbits_popcount_block_fn cbits_popcount_block_ptr =
     cbits_popcount_block_fallback;
 
+void
+cbits_hamming_batch_fallback(const uint64_t *query, const uint64_t *rows,
+                             size_t stride, size_t n_words, size_t n_rows,
+                             uint32_t *out)
+{
+    for (size_t r = 0; r < n_rows; ++r, rows += stride) {
+        uint64_t sum = 0;
+        for (size_t w = 0; w < n_words; ++w) {
+            sum += cbits_popcount64(query[w] ^ rows[w]);
+        }
+        out[r] = (uint32_t) sum;
+    }
+}
+
+cbits_hamming_fn cbits_hamming_batch_ptr = cbits_hamming_batch_fallback;
+
+uint64_t
+cbits_popcount_words_fallback(const uint64_t *ptr, size_t n_words)
+{
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t w = 0;
+    for (; w + 4 <= n_words; w += 4) {
+        s0 += cbits_popcount64(ptr[w]);
+        s1 += cbits_popcount64(ptr[w + 1]);
+        s2 += cbits_popcount64(ptr[w + 2]);
+        s3 += cbits_popcount64(ptr[w + 3]);
+    }
+    for (; w < n_words; ++w) {
+        s0 += cbits_popcount64(ptr[w]);
+    }
+    return s0 + s1 + s2 + s3;
+}
+
+cbits_popcount_words_fn cbits_popcount_words_ptr =
+    cbits_popcount_words_fallback;
+
+/**
+ * @brief One word of a bitwise kernel.
+ * @param x Word of the first operand.
+ * @param y Word of the second operand.
+ * @param op Operator.
+ * @return Combined word.
+ */
+static inline uint64_t
+cbits_bitwise_word(uint64_t x, uint64_t y, cbits_bitwise_op op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            return x & y;
+        case CBITS_BITWISE_OR:
+            return x | y;
+        case CBITS_BITWISE_XOR:
+            return x ^ y;
+        default:
+            return ~x;
+    }
+}
+
+/**
+ * @brief Scalar loop of a bitwise kernel; inlined with a constant @p op so
+ *        that every operator gets its own vectorisable loop.
+ */
+static inline void
+cbits_bitwise_loop(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                   size_t n_words, cbits_bitwise_op op)
+{
+    for (size_t i = 0; i < n_words; ++i) {
+        dst[i] = cbits_bitwise_word(a[i], b[i], op);
+    }
+}
+
+void
+cbits_bitwise_words_fallback(uint64_t *dst, const uint64_t *a,
+                             const uint64_t *b, size_t n_words,
+                             cbits_bitwise_op op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            cbits_bitwise_loop(dst, a, b, n_words, CBITS_BITWISE_AND);
+            break;
+        case CBITS_BITWISE_OR:
+            cbits_bitwise_loop(dst, a, b, n_words, CBITS_BITWISE_OR);
+            break;
+        case CBITS_BITWISE_XOR:
+            cbits_bitwise_loop(dst, a, b, n_words, CBITS_BITWISE_XOR);
+            break;
+        default:
+            cbits_bitwise_loop(dst, a, a, n_words, CBITS_BITWISE_NOT);
+            break;
+    }
+}
+
+cbits_bitwise_fn cbits_bitwise_words_ptr = cbits_bitwise_words_fallback;
+
+/**
+ * @brief Read eight bytes as a little-endian word.
+ * @param p Source, any alignment.
+ * @return Word with byte k of @p p in bits 8k..8k+7.
+ */
+static inline uint64_t
+cbits_load_le64(const uint8_t *p)
+{
+    uint64_t x;
+    memcpy(&x, p, sizeof x);
+#if !CBITS_LITTLE_ENDIAN
+    x = cbits_bswap64(x);
+#endif
+    return x;
+}
+
+/**
+ * @brief Write a word as eight little-endian bytes.
+ * @param p Destination, any alignment.
+ * @param x Word to write.
+ */
+static inline void
+cbits_store_le64(uint8_t *p, uint64_t x)
+{
+#if !CBITS_LITTLE_ENDIAN
+    x = cbits_bswap64(x);
+#endif
+    memcpy(p, &x, sizeof x);
+}
+
+/**
+ * @brief Pack eight bool bytes into eight bits.
+ *
+ * Folds each byte into its bit 0, which is set if the byte is non-zero,
+ * then gathers the eight bits with one multiplication; the partial
+ * products land on distinct bits, so no carries disturb the result.
+ * @param x Eight bytes read with @ref cbits_load_le64.
+ * @return Bit k set if byte k of @p x is non-zero.
+ */
+static inline uint64_t
+cbits_pack8(uint64_t x)
+{
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    x = ((((x & low7) + low7) | x) >> 7) & 0x0101010101010101ULL;
+    return (x * 0x0102040810204080ULL) >> 56;
+}
+
+/**
+ * @brief Unpack eight bits into eight bool bytes; inverse of
+ *        @ref cbits_pack8.
+ * @param b Bits, 0 to 255.
+ * @return Word whose byte k is bit k of @p b.
+ */
+static inline uint64_t
+cbits_unpack8(uint64_t b)
+{
+    const uint64_t x = (b * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+    return ((x + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+}
+
+void
+cbits_pack_bools_fallback(uint64_t *dst, const uint8_t *src, size_t n)
+{
+    const size_t full = n >> 6;
+    for (size_t w = 0; w < full; ++w, src += 64) {
+        uint64_t word = 0;
+        for (unsigned k = 0; k < 8; ++k) {
+            word |= cbits_pack8(cbits_load_le64(src + 8 * k)) << (8 * k);
+        }
+        dst[w] = word;
+    }
+    const size_t rem = n & 63;
+    if (rem) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < rem; ++i) {
+            word |= (uint64_t) (src[i] != 0) << i;
+        }
+        dst[full] = word;
+    }
+}
+
+cbits_pack_bools_fn cbits_pack_bools_ptr = cbits_pack_bools_fallback;
+
+void
+cbits_unpack_bools_fallback(uint8_t *dst, const uint64_t *src, size_t n)
+{
+    const size_t full = n >> 6;
+    for (size_t w = 0; w < full; ++w, dst += 64) {
+        for (unsigned k = 0; k < 8; ++k) {
+            cbits_store_le64(dst + 8 * k,
+                             cbits_unpack8((src[w] >> (8 * k)) & 0xFF));
+        }
+    }
+    const size_t rem = n & 63;
+    for (size_t i = 0; i < rem; ++i) {
+        dst[i] = (uint8_t) ((src[full] >> i) & 1);
+    }
+}
+
+cbits_unpack_bools_fn cbits_unpack_bools_ptr = cbits_unpack_bools_fallback;
+
 #if defined(__x86_64__) || defined(_M_X64)
 
+/**
+ * @brief Popcount of every 64-bit lane with the nibble lookup method.
+ *
+ * Two @c vpshufb lookups count the low and high nibble of every byte and
+ * @c vpsadbw sums the bytes of each lane.
+ * @param v Input vector.
+ * @return Four lane counts.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline __m256i
+cbits_popcount256(__m256i v)
+{
+    const __m256i lookup =
+        _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0,
+                         1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+    __m256i hi = _mm256_shuffle_epi8(
+        lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+/**
+ * @brief Sum of the four 64-bit lanes of a vector.
+ * @param v Input vector.
+ * @return Lane sum.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline uint64_t
+cbits_sum256(__m256i v)
+{
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+    return (uint64_t) _mm_cvtsi128_si64(s) +
+           (uint64_t) _mm_cvtsi128_si64(_mm_unpackhi_epi64(s, s));
+}
+
+/**
+ * @brief Carry-save adder: @p h and @p l receive the carry and sum bits of
+ *        @p a + @p b + @p c.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline void
+cbits_csa256(__m256i *h, __m256i *l, __m256i a, __m256i b, __m256i c)
+{
+    __m256i u = _mm256_xor_si256(a, b);
+    *h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    *l = _mm256_xor_si256(u, c);
+}
+
+/**
+ * @brief Harley-Seal accumulator state.
+ *
+ * Bit @c i of @c ones, @c twos, @c fours and @c eights holds one binary
+ * digit of the running count of its bit position; @c total counts the
+ * carries out of @c eights, i.e. multiples of 16.
+ */
+typedef struct {
+    __m256i total;  /**< Popcounts of the sixteens, per lane. */
+    __m256i ones;   /**< Weight-1 digits. */
+    __m256i twos;   /**< Weight-2 digits. */
+    __m256i fours;  /**< Weight-4 digits. */
+    __m256i eights; /**< Weight-8 digits. */
+} cbits_hs256;
+
+/**
+ * @brief Add 16 vectors (64 words) to a Harley-Seal accumulator.
+ *
+ * Fifteen carry-save adders reduce the inputs so that only one vector per
+ * step goes through the comparatively expensive @ref cbits_popcount256.
+ * @param s Accumulator.
+ * @param v Sixteen input vectors.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline void
+cbits_hs256_step(cbits_hs256 *s, const __m256i *v)
+{
+    __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+    cbits_csa256(&twos_a, &s->ones, s->ones, v[0], v[1]);
+    cbits_csa256(&twos_b, &s->ones, s->ones, v[2], v[3]);
+    cbits_csa256(&fours_a, &s->twos, s->twos, twos_a, twos_b);
+    cbits_csa256(&twos_a, &s->ones, s->ones, v[4], v[5]);
+    cbits_csa256(&twos_b, &s->ones, s->ones, v[6], v[7]);
+    cbits_csa256(&fours_b, &s->twos, s->twos, twos_a, twos_b);
+    cbits_csa256(&eights_a, &s->fours, s->fours, fours_a, fours_b);
+    cbits_csa256(&twos_a, &s->ones, s->ones, v[8], v[9]);
+    cbits_csa256(&twos_b, &s->ones, s->ones, v[10], v[11]);
+    cbits_csa256(&fours_a, &s->twos, s->twos, twos_a, twos_b);
+    cbits_csa256(&twos_a, &s->ones, s->ones, v[12], v[13]);
+    cbits_csa256(&twos_b, &s->ones, s->ones, v[14], v[15]);
+    cbits_csa256(&fours_b, &s->twos, s->twos, twos_a, twos_b);
+    cbits_csa256(&eights_b, &s->fours, s->fours, fours_a, fours_b);
+    cbits_csa256(&sixteens, &s->eights, s->eights, eights_a, eights_b);
+    s->total = _mm256_add_epi64(s->total, cbits_popcount256(sixteens));
+}
+
+/**
+ * @brief Total count of a Harley-Seal accumulator.
+ * @param s Accumulator.
+ * @return Number of set bits added so far.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline uint64_t
+cbits_hs256_finish(const cbits_hs256 *s)
+{
+    __m256i t = _mm256_slli_epi64(s->total, 4);
+    t = _mm256_add_epi64(t,
+                         _mm256_slli_epi64(cbits_popcount256(s->eights), 3));
+    t = _mm256_add_epi64(t,
+                         _mm256_slli_epi64(cbits_popcount256(s->fours), 2));
+    t = _mm256_add_epi64(t,
+                         _mm256_slli_epi64(cbits_popcount256(s->twos), 1));
+    t = _mm256_add_epi64(t, cbits_popcount256(s->ones));
+    return cbits_sum256(t);
+}
+
     #if defined(__GNUC__)
 __attribute__((target("avx2")))
     #endif
@@ -35,13 +367,8 @@ cbits_popcount_block_avx2(const uint64_t *ptr)
 {
     __m256i v0 = _mm256_loadu_si256((const __m256i *) ptr);
     __m256i v1 = _mm256_loadu_si256((const __m256i *) (ptr + 4));
-    uint64_t tmp[8];
-    _mm256_storeu_si256((__m256i *) tmp, v0);
-    _mm256_storeu_si256((__m256i *) (tmp + 4), v1);
-    return cbits_popcount64(tmp[0]) + cbits_popcount64(tmp[1]) +
-           cbits_popcount64(tmp[2]) + cbits_popcount64(tmp[3]) +
-           cbits_popcount64(tmp[4]) + cbits_popcount64(tmp[5]) +
-           cbits_popcount64(tmp[6]) + cbits_popcount64(tmp[7]);
+    return cbits_sum256(
+        _mm256_add_epi64(cbits_popcount256(v0), cbits_popcount256(v1)));
 }
 
     #if defined(__GNUC__)
@@ -55,45 +382,833 @@ cbits_popcount_block_avx512(const uint64_t *ptr)
     return _mm512_reduce_add_epi64(c);
 }
 
+/**
+ * @brief Popcount of a short word array with the @c popcnt instruction.
+ * @param ptr Word array.
+ * @param n_words Number of words.
+ * @return Number of set bits.
+ */
     #if defined(__GNUC__)
-__attribute__((target("avx2"))) __attribute__((target("avx512vpopcntdq")))
-__attribute__((constructor)) void
-init_cpu_dispatch_gcc(void)
+__attribute__((target("popcnt")))
+    #endif
+static inline uint64_t
+cbits_popcount_words_popcnt(const uint64_t *ptr, size_t n_words)
 {
-    if (__builtin_cpu_supports("avx512vpopcntdq")) {
-        cbits_popcount_block_ptr = cbits_popcount_block_avx512;
-        return;
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t w = 0;
+    for (; w + 4 <= n_words; w += 4) {
+        s0 += cbits_popcount64(ptr[w]);
+        s1 += cbits_popcount64(ptr[w + 1]);
+        s2 += cbits_popcount64(ptr[w + 2]);
+        s3 += cbits_popcount64(ptr[w + 3]);
     }
-    if (__builtin_cpu_supports("avx2")) {
-        cbits_popcount_block_ptr = cbits_popcount_block_avx2;
+    for (; w < n_words; ++w) {
+        s0 += cbits_popcount64(ptr[w]);
     }
+    return s0 + s1 + s2 + s3;
 }
-    #elif defined(_MSC_VER)
-        #include <intrin.h>
-void __cdecl init_cpu_dispatch(void);
-        #pragma section(".CRT$XCU", read)
-__declspec(allocate(".CRT$XCU")) void(__cdecl *_ict_ptr)(void) =
-    init_cpu_dispatch;
 
-void __cdecl init_cpu_dispatch(void)
+    #if defined(__GNUC__)
+__attribute__((target("avx2,popcnt")))
+    #endif
+uint64_t
+cbits_popcount_words_avx2(const uint64_t *ptr, size_t n_words)
 {
-    int info[4] = {0};
-    __cpuidex(info, 7, 0);
-    if (info[1] & (1ULL << 57)) {
-        cbits_popcount_block_ptr = cbits_popcount_block_avx512;
-        return;
+    cbits_hs256 s = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                     _mm256_setzero_si256(), _mm256_setzero_si256(),
+                     _mm256_setzero_si256()};
+    const size_t head = n_words & ~(size_t) 63;
+    for (size_t w = 0; w < head; w += 64) {
+        __m256i v[16];
+        for (int k = 0; k < 16; ++k) {
+            v[k] = _mm256_loadu_si256((const __m256i *) (ptr + w + 4 * k));
+        }
+        cbits_hs256_step(&s, v);
+    }
+    return (head ? cbits_hs256_finish(&s) : 0) +
+           cbits_popcount_words_popcnt(ptr + head, n_words - head);
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx512f,avx512vpopcntdq")))
+    #endif
+uint64_t
+cbits_popcount_words_avx512(const uint64_t *ptr, size_t n_words)
+{
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = acc0;
+    size_t w = 0;
+    for (; w + 16 <= n_words; w += 16) {
+        acc0 = _mm512_add_epi64(
+            acc0, _mm512_popcnt_epi64(_mm512_loadu_si512(ptr + w)));
+        acc1 = _mm512_add_epi64(
+            acc1, _mm512_popcnt_epi64(_mm512_loadu_si512(ptr + w + 8)));
+    }
+    for (; w < n_words; w += 8) {
+        const size_t left = n_words - w;
+        const __mmask8 mask =
+            left >= 8 ? (__mmask8) 0xFF : (__mmask8) ((1u << left) - 1);
+        __m512i v = _mm512_maskz_loadu_epi64(mask, ptr + w);
+        acc0 = _mm512_add_epi64(acc0, _mm512_popcnt_epi64(v));
+    }
+    return (uint64_t) _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+}
+
+/**
+ * @brief Hamming distance of one row with the @c popcnt instruction.
+ * @param a First word array.
+ * @param b Second word array.
+ * @param n_words Words to compare.
+ * @return Number of differing bits.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("popcnt")))
+    #endif
+static inline uint64_t
+cbits_hamming_row_popcnt(const uint64_t *a, const uint64_t *b, size_t n_words)
+{
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t w = 0;
+    for (; w + 4 <= n_words; w += 4) {
+        s0 += cbits_popcount64(a[w] ^ b[w]);
+        s1 += cbits_popcount64(a[w + 1] ^ b[w + 1]);
+        s2 += cbits_popcount64(a[w + 2] ^ b[w + 2]);
+        s3 += cbits_popcount64(a[w + 3] ^ b[w + 3]);
+    }
+    for (; w < n_words; ++w) {
+        s0 += cbits_popcount64(a[w] ^ b[w]);
+    }
+    return s0 + s1 + s2 + s3;
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx2,popcnt")))
+    #endif
+void
+cbits_hamming_batch_avx2(const uint64_t *query, const uint64_t *rows,
+                         size_t stride, size_t n_words, size_t n_rows,
+                         uint32_t *out)
+{
+    const size_t head = n_words & ~(size_t) 63;
+    for (size_t r = 0; r < n_rows; ++r, rows += stride) {
+        cbits_hs256 s = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                         _mm256_setzero_si256(), _mm256_setzero_si256(),
+                         _mm256_setzero_si256()};
+        for (size_t w = 0; w < head; w += 64) {
+            __m256i v[16];
+            for (int k = 0; k < 16; ++k) {
+                v[k] = _mm256_xor_si256(
+                    _mm256_loadu_si256(
+                        (const __m256i *) (query + w + 4 * k)),
+                    _mm256_loadu_si256((const __m256i *) (rows + w + 4 * k)));
+            }
+            cbits_hs256_step(&s, v);
+        }
+        out[r] = (uint32_t) ((head ? cbits_hs256_finish(&s) : 0) +
+                             cbits_hamming_row_popcnt(query + head,
+                                                      rows + head,
+                                                      n_words - head));
     }
-    __cpuidex(info, 1, 0);
-    if (info[2] & (1U << 5)) {
-        cbits_popcount_block_ptr = cbits_popcount_block_avx2;
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+    #endif
+void
+cbits_hamming_batch_avx512(const uint64_t *query, const uint64_t *rows,
+                           size_t stride, size_t n_words, size_t n_rows,
+                           uint32_t *out)
+{
+    if (n_words < 8) {
+        for (size_t r = 0; r < n_rows; ++r, rows += stride) {
+            out[r] = (uint32_t) cbits_hamming_row_popcnt(query, rows, n_words);
+        }
         return;
     }
+    const size_t full = n_words & ~(size_t) 7;
+    const __mmask8 tail = (__mmask8) ((1u << (n_words & 7)) - 1);
+    for (size_t r = 0; r < n_rows; ++r, rows += stride) {
+        __m512i acc = _mm512_setzero_si512();
+        for (size_t w = 0; w < full; w += 8) {
+            __m512i x = _mm512_xor_si512(_mm512_loadu_si512(query + w),
+                                         _mm512_loadu_si512(rows + w));
+            acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+        }
+        if (tail) {
+            __m512i x =
+                _mm512_xor_si512(_mm512_maskz_loadu_epi64(tail, query + full),
+                                 _mm512_maskz_loadu_epi64(tail, rows + full));
+            acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+        }
+        out[r] = (uint32_t) _mm512_reduce_add_epi64(acc);
+    }
+}
+
+/**
+ * @brief One vector of the AVX2 bitwise kernel.
+ * @param x First operand.
+ * @param y Second operand.
+ * @param op Operator.
+ * @return Combined vector.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline __m256i
+cbits_bitwise256(__m256i x, __m256i y, cbits_bitwise_op op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            return _mm256_and_si256(x, y);
+        case CBITS_BITWISE_OR:
+            return _mm256_or_si256(x, y);
+        case CBITS_BITWISE_XOR:
+            return _mm256_xor_si256(x, y);
+        default:
+            return _mm256_xor_si256(x, _mm256_set1_epi64x(-1));
+    }
+}
+
+/**
+ * @brief Loop of the AVX2 bitwise kernel for one operator.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+static inline void
+cbits_bitwise_loop256(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                      size_t n_words, cbits_bitwise_op op)
+{
+    size_t i = 0;
+    for (; i + 8 <= n_words; i += 8) {
+        __m256i x0 = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i x1 = _mm256_loadu_si256((const __m256i *) (a + i + 4));
+        __m256i y0 = _mm256_loadu_si256((const __m256i *) (b + i));
+        __m256i y1 = _mm256_loadu_si256((const __m256i *) (b + i + 4));
+        _mm256_storeu_si256((__m256i *) (dst + i),
+                            cbits_bitwise256(x0, y0, op));
+        _mm256_storeu_si256((__m256i *) (dst + i + 4),
+                            cbits_bitwise256(x1, y1, op));
+    }
+    for (; i < n_words; ++i) {
+        dst[i] = cbits_bitwise_word(a[i], b[i], op);
+    }
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+void
+cbits_bitwise_words_avx2(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                         size_t n_words, cbits_bitwise_op op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            cbits_bitwise_loop256(dst, a, b, n_words, CBITS_BITWISE_AND);
+            break;
+        case CBITS_BITWISE_OR:
+            cbits_bitwise_loop256(dst, a, b, n_words, CBITS_BITWISE_OR);
+            break;
+        case CBITS_BITWISE_XOR:
+            cbits_bitwise_loop256(dst, a, b, n_words, CBITS_BITWISE_XOR);
+            break;
+        default:
+            cbits_bitwise_loop256(dst, a, a, n_words, CBITS_BITWISE_NOT);
+            break;
+    }
+}
+
+/**
+ * @brief One vector of the AVX-512 bitwise kernel.
+ * @param x First operand.
+ * @param y Second operand.
+ * @param op Operator.
+ * @return Combined vector.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx512f")))
+    #endif
+static inline __m512i
+cbits_bitwise512(__m512i x, __m512i y, cbits_bitwise_op op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            return _mm512_and_si512(x, y);
+        case CBITS_BITWISE_OR:
+            return _mm512_or_si512(x, y);
+        case CBITS_BITWISE_XOR:
+            return _mm512_xor_si512(x, y);
+        default:
+            return _mm512_ternarylogic_epi64(x, x, x, 0x55);
+    }
+}
+
+/**
+ * @brief Loop of the AVX-512 bitwise kernel for one operator.
+ */
+    #if defined(__GNUC__)
+__attribute__((target("avx512f")))
+    #endif
+static inline void
+cbits_bitwise_loop512(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                      size_t n_words, cbits_bitwise_op op)
+{
+    size_t i = 0;
+    for (; i + 8 <= n_words; i += 8) {
+        _mm512_storeu_si512(dst + i,
+                            cbits_bitwise512(_mm512_loadu_si512(a + i),
+                                             _mm512_loadu_si512(b + i), op));
+    }
+    if (i < n_words) {
+        const __mmask8 mask = (__mmask8) ((1u << (n_words - i)) - 1);
+        __m512i x = _mm512_maskz_loadu_epi64(mask, a + i);
+        __m512i y = _mm512_maskz_loadu_epi64(mask, b + i);
+        _mm512_mask_storeu_epi64(dst + i, mask, cbits_bitwise512(x, y, op));
+    }
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx512f")))
+    #endif
+void
+cbits_bitwise_words_avx512(uint64_t *dst, const uint64_t *a,
+                           const uint64_t *b, size_t n_words,
+                           cbits_bitwise_op op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            cbits_bitwise_loop512(dst, a, b, n_words, CBITS_BITWISE_AND);
+            break;
+        case CBITS_BITWISE_OR:
+            cbits_bitwise_loop512(dst, a, b, n_words, CBITS_BITWISE_OR);
+            break;
+        case CBITS_BITWISE_XOR:
+            cbits_bitwise_loop512(dst, a, b, n_words, CBITS_BITWISE_XOR);
+            break;
+        default:
+            cbits_bitwise_loop512(dst, a, a, n_words, CBITS_BITWISE_NOT);
+            break;
+    }
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+void
+cbits_pack_bools_avx2(uint64_t *dst, const uint8_t *src, size_t n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const size_t full = n >> 6;
+    for (size_t w = 0; w < full; ++w, src += 64) {
+        const __m256i lo = _mm256_loadu_si256((const __m256i *) src);
+        const __m256i hi = _mm256_loadu_si256((const __m256i *) (src + 32));
+        /* vpmovmskb takes the top bit of each byte, so compare with zero
+         * first to count every non-zero byte, not just those >= 0x80. */
+        const uint32_t zlo =
+            (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, zero));
+        const uint32_t zhi =
+            (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, zero));
+        dst[w] = ~(((uint64_t) zhi << 32) | zlo);
+    }
+    cbits_pack_bools_fallback(dst + full, src, n & 63);
 }
+
+    #if defined(__GNUC__)
+__attribute__((target("avx2")))
+    #endif
+void
+cbits_unpack_bools_avx2(uint8_t *dst, const uint64_t *src, size_t n)
+{
+    /* Every lane holds the four source bytes; byte i of the output takes
+     * source byte i / 8 and keeps bit i % 8 of it. */
+    const __m256i spread = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2,
+        2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit = _mm256_set1_epi64x((long long) 0x8040201008040201ULL);
+    const __m256i one = _mm256_set1_epi8(1);
+    const size_t full = n >> 6;
+    for (size_t w = 0; w < full; ++w, dst += 64) {
+        for (unsigned h = 0; h < 2; ++h) {
+            const uint32_t bits = (uint32_t) (src[w] >> (32 * h));
+            __m256i v = _mm256_set1_epi32((int) bits);
+            v = _mm256_shuffle_epi8(v, spread);
+            v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+            _mm256_storeu_si256((__m256i *) (dst + 32 * h),
+                                _mm256_and_si256(v, one));
+        }
+    }
+    cbits_unpack_bools_fallback(dst, src + full, n & 63);
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx512f,avx512bw")))
+    #endif
+void
+cbits_pack_bools_avx512(uint64_t *dst, const uint8_t *src, size_t n)
+{
+    const size_t full = n >> 6;
+    for (size_t w = 0; w < full; ++w) {
+        const __m512i v = _mm512_loadu_si512(src + 64 * w);
+        dst[w] = (uint64_t) _mm512_test_epi8_mask(v, v);
+    }
+    const size_t rem = n & 63;
+    if (rem) {
+        const __mmask64 mask = (__mmask64) ((1ULL << rem) - 1);
+        const __m512i v = _mm512_maskz_loadu_epi8(mask, src + 64 * full);
+        dst[full] = (uint64_t) _mm512_test_epi8_mask(v, v);
+    }
+}
+
+    #if defined(__GNUC__)
+__attribute__((target("avx512f,avx512bw")))
     #endif
+void
+cbits_unpack_bools_avx512(uint8_t *dst, const uint64_t *src, size_t n)
+{
+    const __m512i one = _mm512_set1_epi8(1);
+    const size_t full = n >> 6;
+    for (size_t w = 0; w < full; ++w) {
+        _mm512_storeu_si512(dst + 64 * w,
+                            _mm512_maskz_mov_epi8((__mmask64) src[w], one));
+    }
+    const size_t rem = n & 63;
+    if (rem) {
+        const __mmask64 mask = (__mmask64) ((1ULL << rem) - 1);
+        _mm512_mask_storeu_epi8(
+            dst + 64 * full, mask,
+            _mm512_maskz_mov_epi8((__mmask64) src[full], one));
+    }
+}
+
+#endif
+
+/**
+ * @brief The kernels of one family, one per dispatched operation.
+ */
+typedef struct {
+    cbits_popcount_block_fn block;  /**< Block popcount. */
+    cbits_popcount_words_fn words;  /**< Bulk popcount. */
+    cbits_hamming_fn hamming;       /**< Batched Hamming. */
+    cbits_bitwise_fn bitwise;       /**< Bitwise operators. */
+    cbits_pack_bools_fn pack;       /**< Bool packing. */
+    cbits_unpack_bools_fn unpack;   /**< Bool unpacking. */
+} cbits_kernel_set;
+
+/**
+ * @brief Kernel families indexed by @ref cbits_kernel.
+ *
+ * Without x86-64 the vector entries repeat the fallback; they are never
+ * selected because @ref cbits_kernel_supported rejects them.
+ */
+static const cbits_kernel_set cbits_kernel_sets[CBITS_KERNEL_COUNT] = {
+    {cbits_popcount_block_fallback, cbits_popcount_words_fallback,
+     cbits_hamming_batch_fallback, cbits_bitwise_words_fallback,
+     cbits_pack_bools_fallback, cbits_unpack_bools_fallback},
+#if defined(__x86_64__) || defined(_M_X64)
+    {cbits_popcount_block_avx2, cbits_popcount_words_avx2,
+     cbits_hamming_batch_avx2, cbits_bitwise_words_avx2,
+     cbits_pack_bools_avx2, cbits_unpack_bools_avx2},
+    {cbits_popcount_block_avx512, cbits_popcount_words_avx512,
+     cbits_hamming_batch_avx512, cbits_bitwise_words_avx512,
+     cbits_pack_bools_avx512, cbits_unpack_bools_avx512},
+#else
+    {cbits_popcount_block_fallback, cbits_popcount_words_fallback,
+     cbits_hamming_batch_fallback, cbits_bitwise_words_fallback,
+     cbits_pack_bools_fallback, cbits_unpack_bools_fallback},
+    {cbits_popcount_block_fallback, cbits_popcount_words_fallback,
+     cbits_hamming_batch_fallback, cbits_bitwise_words_fallback,
+     cbits_pack_bools_fallback, cbits_unpack_bools_fallback},
+#endif
+};
+
+/** @brief Names indexed by @ref cbits_kernel, including "auto". */
+static const char *const cbits_kernel_names[CBITS_KERNEL_COUNT + 1] = {
+    "fallback",
+    "avx2",
+    "avx512",
+    "auto",
+};
+
+/** @brief Names indexed by @ref cbits_dispatch_op. */
+static const char *const cbits_dispatch_op_names[CBITS_OP_COUNT] = {
+    "popcount_block",
+    "popcount_words",
+    "hamming_batch",
+    "bitwise_words",
+    "pack_bools",
+    "unpack_bools",
+};
+
+/** @brief Features found by @ref cbits_detect_cpu_features. */
+static unsigned cbits_cpu_feature_bits;
+/** @brief Result of applying @c CBITS_FORCE_KERNEL at start-up. */
+static int cbits_force_kernel_env_rc;
+
+/**
+ * @brief Query the CPU for the features the kernels need.
+ * @return Bitwise OR of the @ref cbits_cpu bits.
+ */
+static unsigned
+cbits_detect_cpu_features(void)
+{
+    unsigned features = 0;
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+    /* libgcc also checks that the OS saves the AVX and AVX-512 state. */
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt")) {
+        features |= CBITS_CPU_POPCNT;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        features |= CBITS_CPU_AVX2;
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        features |= CBITS_CPU_AVX512F;
+    }
+    if (__builtin_cpu_supports("avx512vpopcntdq")) {
+        features |= CBITS_CPU_AVX512VPOPCNTDQ;
+    }
+    if (__builtin_cpu_supports("avx512bw")) {
+        features |= CBITS_CPU_AVX512BW;
+    }
+#elif defined(_M_X64) && defined(_MSC_VER)
+    int info[4] = {0};
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    if (info[2] & (1 << 23)) {
+        features |= CBITS_CPU_POPCNT;
+    }
+    /* XCR0 must enable the YMM (and for AVX-512 the ZMM) state. */
+    const unsigned long long xcr0 =
+        (info[2] & (1 << 27)) ? _xgetbv(0) : 0;
+    if (max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        if ((xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5))) {
+            features |= CBITS_CPU_AVX2;
+        }
+        if ((xcr0 & 0xE6) == 0xE6) {
+            if (info[1] & (1 << 16)) {
+                features |= CBITS_CPU_AVX512F;
+            }
+            if (info[1] & (1 << 30)) {
+                features |= CBITS_CPU_AVX512BW;
+            }
+            if (info[2] & (1 << 14)) {
+                features |= CBITS_CPU_AVX512VPOPCNTDQ;
+            }
+        }
+    }
+#endif
+    return features;
+}
+
+/**
+ * @brief Index of a name of @p len characters in a table of names.
+ * @param names Table of names.
+ * @param n Number of names.
+ * @param str Name to look up, not necessarily NUL-terminated.
+ * @param len Length of @p str.
+ * @return Index into @p names, or -1 if absent.
+ */
+static int
+cbits_name_index(const char *const *names, size_t n, const char *str,
+                 size_t len)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (strlen(names[i]) == len && memcmp(names[i], str, len) == 0) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief CPU features the kernel of one family needs for one operation.
+ *
+ * The AVX-512 kernels differ: only the popcounts use VPOPCNTDQ and only
+ * the bool conversions use BW, so a CPU with AVX-512F and BW but without
+ * VPOPCNTDQ (Skylake-X) still runs the bitwise and bool kernels.
+ * @param op Operation, not @c CBITS_OP_COUNT.
+ * @param kernel Kernel family, not @c CBITS_KERNEL_AUTO.
+ * @return Bitwise OR of the @ref cbits_cpu bits required.
+ */
+static unsigned
+cbits_kernel_requirements(cbits_dispatch_op op, cbits_kernel kernel)
+{
+    switch (kernel) {
+        case CBITS_KERNEL_AVX2:
+            return CBITS_CPU_AVX2 | CBITS_CPU_POPCNT;
+        case CBITS_KERNEL_AVX512:
+            switch (op) {
+                case CBITS_OP_BITWISE_WORDS:
+                    return CBITS_CPU_AVX512F;
+                case CBITS_OP_PACK_BOOLS:
+                case CBITS_OP_UNPACK_BOOLS:
+                    return CBITS_CPU_AVX512F | CBITS_CPU_AVX512BW;
+                default:
+                    return CBITS_CPU_AVX512F | CBITS_CPU_AVX512VPOPCNTDQ |
+                           CBITS_CPU_POPCNT;
+            }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Fastest kernel family the CPU supports for one operation.
+ * @param op Operation, not @c CBITS_OP_COUNT.
+ * @return Kernel family, never @c CBITS_KERNEL_AUTO.
+ */
+static cbits_kernel
+cbits_best_kernel(cbits_dispatch_op op)
+{
+    if (cbits_op_kernel_supported(op, CBITS_KERNEL_AVX512)) {
+        return CBITS_KERNEL_AVX512;
+    }
+    if (cbits_op_kernel_supported(op, CBITS_KERNEL_AVX2)) {
+        return CBITS_KERNEL_AVX2;
+    }
+    return CBITS_KERNEL_FALLBACK;
+}
+
+/**
+ * @brief Point the dispatch pointer of one operation at a kernel.
+ * @param op Operation.
+ * @param kernel Supported kernel family, not @c CBITS_KERNEL_AUTO.
+ */
+static void
+cbits_install_kernel(cbits_dispatch_op op, cbits_kernel kernel)
+{
+    const cbits_kernel_set *set = &cbits_kernel_sets[kernel];
+    switch (op) {
+        case CBITS_OP_POPCOUNT_BLOCK:
+            CBITS_DISPATCH_STORE(cbits_popcount_block_fn,
+                                 cbits_popcount_block_ptr, set->block);
+            break;
+        case CBITS_OP_POPCOUNT_WORDS:
+            CBITS_DISPATCH_STORE(cbits_popcount_words_fn,
+                                 cbits_popcount_words_ptr, set->words);
+            break;
+        case CBITS_OP_HAMMING_BATCH:
+            CBITS_DISPATCH_STORE(cbits_hamming_fn,
+                                 cbits_hamming_batch_ptr, set->hamming);
+            break;
+        case CBITS_OP_BITWISE_WORDS:
+            CBITS_DISPATCH_STORE(cbits_bitwise_fn,
+                                 cbits_bitwise_words_ptr, set->bitwise);
+            break;
+        case CBITS_OP_PACK_BOOLS:
+            CBITS_DISPATCH_STORE(cbits_pack_bools_fn,
+                                 cbits_pack_bools_ptr, set->pack);
+            break;
+        case CBITS_OP_UNPACK_BOOLS:
+            CBITS_DISPATCH_STORE(cbits_unpack_bools_fn,
+                                 cbits_unpack_bools_ptr, set->unpack);
+            break;
+        default:
+            break;
+    }
+}
+
+unsigned
+cbits_cpu_features(void)
+{
+    return cbits_cpu_feature_bits;
+}
+
+const char *
+cbits_dispatch_op_name(cbits_dispatch_op op)
+{
+    if ((int) op < 0 || op >= CBITS_OP_COUNT) {
+        return NULL;
+    }
+    return cbits_dispatch_op_names[op];
+}
+
+const char *
+cbits_kernel_name(cbits_kernel kernel)
+{
+    if ((int) kernel < 0 || kernel > CBITS_KERNEL_AUTO) {
+        return NULL;
+    }
+    return cbits_kernel_names[kernel];
+}
+
+cbits_dispatch_op
+cbits_dispatch_op_from_name(const char *name)
+{
+    const int i = cbits_name_index(cbits_dispatch_op_names, CBITS_OP_COUNT,
+                                   name, strlen(name));
+    return i < 0 ? CBITS_OP_COUNT : (cbits_dispatch_op) i;
+}
+
+int
+cbits_kernel_from_name(const char *name)
+{
+    return cbits_name_index(cbits_kernel_names, CBITS_KERNEL_COUNT + 1, name,
+                            strlen(name));
+}
+
+int
+cbits_op_kernel_supported(cbits_dispatch_op op, cbits_kernel kernel)
+{
+    if ((int) op < 0 || op > CBITS_OP_COUNT || (int) kernel < 0 ||
+        kernel > CBITS_KERNEL_AUTO) {
+        return 0;
+    }
+    if (kernel == CBITS_KERNEL_AUTO) {
+        return 1;
+    }
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        if (op != CBITS_OP_COUNT && op != (cbits_dispatch_op) o) {
+            continue;
+        }
+        const unsigned need =
+            cbits_kernel_requirements((cbits_dispatch_op) o, kernel);
+        if ((cbits_cpu_feature_bits & need) != need) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int
+cbits_kernel_supported(cbits_kernel kernel)
+{
+    return cbits_op_kernel_supported(CBITS_OP_COUNT, kernel);
+}
+
+cbits_kernel
+cbits_active_kernel(cbits_dispatch_op op)
+{
+    for (int k = 0; k < CBITS_KERNEL_COUNT; ++k) {
+        const cbits_kernel_set *set = &cbits_kernel_sets[k];
+        int active = 0;
+        switch (op) {
+            case CBITS_OP_POPCOUNT_BLOCK:
+                active = CBITS_DISPATCH_LOAD(cbits_popcount_block_fn,
+                                             cbits_popcount_block_ptr) ==
+                         set->block;
+                break;
+            case CBITS_OP_POPCOUNT_WORDS:
+                active = CBITS_DISPATCH_LOAD(cbits_popcount_words_fn,
+                                             cbits_popcount_words_ptr) ==
+                         set->words;
+                break;
+            case CBITS_OP_HAMMING_BATCH:
+                active = CBITS_DISPATCH_LOAD(cbits_hamming_fn,
+                                             cbits_hamming_batch_ptr) ==
+                         set->hamming;
+                break;
+            case CBITS_OP_BITWISE_WORDS:
+                active = CBITS_DISPATCH_LOAD(cbits_bitwise_fn,
+                                             cbits_bitwise_words_ptr) ==
+                         set->bitwise;
+                break;
+            case CBITS_OP_PACK_BOOLS:
+                active = CBITS_DISPATCH_LOAD(cbits_pack_bools_fn,
+                                             cbits_pack_bools_ptr) ==
+                         set->pack;
+                break;
+            case CBITS_OP_UNPACK_BOOLS:
+                active = CBITS_DISPATCH_LOAD(cbits_unpack_bools_fn,
+                                             cbits_unpack_bools_ptr) ==
+                         set->unpack;
+                break;
+            default:
+                break;
+        }
+        if (active) {
+            return (cbits_kernel) k;
+        }
+    }
+    return CBITS_KERNEL_FALLBACK;
+}
+
+int
+cbits_set_kernel(cbits_dispatch_op op, cbits_kernel kernel)
+{
+    if (!cbits_op_kernel_supported(op, kernel)) {
+        return -1;
+    }
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        if (op == CBITS_OP_COUNT || op == (cbits_dispatch_op) o) {
+            cbits_install_kernel((cbits_dispatch_op) o,
+                                 kernel == CBITS_KERNEL_AUTO
+                                     ? cbits_best_kernel((cbits_dispatch_op) o)
+                                     : kernel);
+        }
+    }
+    return 0;
+}
+
+int
+cbits_force_kernel(const char *spec)
+{
+    if (!strchr(spec, '=')) {
+        const int kernel = cbits_kernel_from_name(spec);
+        return kernel < 0 ? -1
+                          : cbits_set_kernel(CBITS_OP_COUNT,
+                                             (cbits_kernel) kernel);
+    }
+    /* Validate every pair before installing any of them. */
+    int chosen[CBITS_OP_COUNT];
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        chosen[o] = -1;
+    }
+    for (const char *p = spec;;) {
+        const char *comma = strchr(p, ',');
+        const size_t len = comma ? (size_t) (comma - p) : strlen(p);
+        const char *eq = memchr(p, '=', len);
+        if (!eq) {
+            return -1;
+        }
+        const int op = cbits_name_index(cbits_dispatch_op_names,
+                                        CBITS_OP_COUNT, p, (size_t) (eq - p));
+        const int kernel =
+            cbits_name_index(cbits_kernel_names, CBITS_KERNEL_COUNT + 1,
+                             eq + 1, len - (size_t) (eq - p) - 1);
+        if (op < 0 || kernel < 0 ||
+            !cbits_op_kernel_supported((cbits_dispatch_op) op,
+                                       (cbits_kernel) kernel)) {
+            return -1;
+        }
+        chosen[op] = kernel;
+        if (!comma) {
+            break;
+        }
+        p = comma + 1;
+    }
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        if (chosen[o] >= 0) {
+            cbits_set_kernel((cbits_dispatch_op) o, (cbits_kernel) chosen[o]);
+        }
+    }
+    return 0;
+}
+
+int
+cbits_force_kernel_env_status(void)
+{
+    return cbits_force_kernel_env_rc;
+}
+
+#if defined(_MSC_VER)
+void __cdecl init_cpu_dispatch(void);
+    #pragma section(".CRT$XCU", read)
+__declspec(allocate(".CRT$XCU")) void(__cdecl *_ict_ptr)(void) =
+    init_cpu_dispatch;
+#endif
+
+#if defined(__GNUC__)
+__attribute__((constructor))
 #endif
-#if !defined(__x86_64__) && !defined(_M_X64)
 void
 init_cpu_dispatch(void)
 {
+    cbits_cpu_feature_bits = cbits_detect_cpu_features();
+    cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+    const char *spec = getenv("CBITS_FORCE_KERNEL");
+    if (spec && *spec) {
+        cbits_force_kernel_env_rc = cbits_force_kernel(spec);
+    }
 }
-#endif
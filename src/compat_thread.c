@@ -0,0 +1,143 @@
+/**
+ * @file src/compat_thread.c
+ * @brief POSIX and Win32 backends for the fork/join helper.
+ *
+ * @see include/compat_thread.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "compat_thread.h"
+
+#include <stdbool.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Work description of one thread: every task with
+ *        <tt>index % stride == first</tt>.
+ */
+typedef struct {
+    cbits_task_fn fn; /**< Task callback. */
+    void *ctx;        /**< Shared caller context. */
+    size_t first;     /**< First task index. */
+    size_t stride;    /**< Distance between two task indices. */
+    size_t n_tasks;   /**< Total number of tasks. */
+} cbits_worker;
+
+/**
+ * @brief Run the share of tasks assigned to one worker.
+ * @param w Worker description.
+ */
+static void
+cbits_worker_run(const cbits_worker *w)
+{
+    for (size_t i = w->first; i < w->n_tasks; i += w->stride) {
+        w->fn(w->ctx, i);
+    }
+}
+
+#if defined(_WIN32)
+/**
+ * @brief Win32 thread entry point.
+ * @param arg Pointer to a ::cbits_worker.
+ * @return Always @c 0.
+ */
+static DWORD WINAPI
+cbits_worker_main(LPVOID arg)
+{
+    cbits_worker_run((const cbits_worker *) arg);
+    return 0;
+}
+#else
+/**
+ * @brief POSIX thread entry point.
+ * @param arg Pointer to a ::cbits_worker.
+ * @return Always @c NULL.
+ */
+static void *
+cbits_worker_main(void *arg)
+{
+    cbits_worker_run((const cbits_worker *) arg);
+    return NULL;
+}
+#endif
+
+unsigned
+cbits_cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (unsigned) info.dwNumberOfProcessors
+                                     : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned) n : 1;
+#endif
+}
+
+void
+cbits_parallel_for(size_t n_tasks, cbits_task_fn fn, void *ctx,
+                   unsigned n_threads)
+{
+    if (n_threads == 0) {
+        n_threads = cbits_cpu_count();
+    }
+    if (n_threads > CBITS_MAX_THREADS) {
+        n_threads = CBITS_MAX_THREADS;
+    }
+    if ((size_t) n_threads > n_tasks) {
+        n_threads = (unsigned) n_tasks;
+    }
+    if (n_threads <= 1) {
+        for (size_t i = 0; i < n_tasks; ++i) {
+            fn(ctx, i);
+        }
+        return;
+    }
+
+    cbits_worker workers[CBITS_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE handles[CBITS_MAX_THREADS];
+#else
+    pthread_t handles[CBITS_MAX_THREADS];
+#endif
+    bool started[CBITS_MAX_THREADS];
+
+    for (unsigned t = 0; t < n_threads; ++t) {
+        workers[t] = (cbits_worker) {fn, ctx, t, n_threads, n_tasks};
+        started[t] = false;
+    }
+    /* Worker 0 runs on the calling thread. */
+    for (unsigned t = 1; t < n_threads; ++t) {
+#if defined(_WIN32)
+        handles[t] =
+            CreateThread(NULL, 0, cbits_worker_main, &workers[t], 0, NULL);
+        started[t] = handles[t] != NULL;
+#else
+        started[t] = pthread_create(&handles[t], NULL, cbits_worker_main,
+                                    &workers[t]) == 0;
+#endif
+        if (!started[t]) {
+            cbits_worker_run(&workers[t]);
+        }
+    }
+    cbits_worker_run(&workers[0]);
+    for (unsigned t = 1; t < n_threads; ++t) {
+        if (!started[t]) {
+            continue;
+        }
+#if defined(_WIN32)
+        WaitForSingleObject(handles[t], INFINITE);
+        CloseHandle(handles[t]);
+#else
+        pthread_join(handles[t], NULL);
+#endif
+    }
+}
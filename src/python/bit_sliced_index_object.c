@@ -0,0 +1,677 @@
+/**
+ * @file bit_sliced_index_object.c
+ * @brief Implementation of the ``BitSlicedIndex`` Python type.
+ *
+ * Exposes an immutable bit-sliced index over a column of signed 64-bit
+ * integers with missing values. Comparisons, ``between``, ``sum`` and
+ * ``top_k`` run natively without the GIL and return BitVectors, so query
+ * results combine with the BitVector operators.
+ *
+ * @see bit_sliced_index_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bit_sliced_index_object.h"
+
+/** @brief Shorthand for the native index of a Python object. */
+#define BSI(o) (((PyBitSlicedIndexObject *) (o))->bsi)
+/** @brief Shorthand for the running query count of a Python object. */
+#define BSI_QUERIES(o) (((PyBitSlicedIndexObject *) (o))->queries)
+
+/**
+ * @brief ``__new__`` for ``BitSlicedIndex``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_bsi_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+           PyObject *Py_UNUSED(kwds))
+{
+    PyBitSlicedIndexObject *self =
+        (PyBitSlicedIndexObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->bsi = NULL;
+    self->queries = 0;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief ``__init__`` for ``BitSlicedIndex(values)``.
+ *
+ * ``None`` entries become missing rows. Re-init raises ``BufferError``
+ * while a query is running on the old index without the GIL.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bsi_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *iterable;
+    static char *kwlist[] = {"values", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &iterable)) {
+        return -1;
+    }
+    PyObject *seq = PySequence_Fast(
+        iterable, "values must be an iterable of integers or None");
+    if (!seq) {
+        return -1;
+    }
+    const size_t n = (size_t) PySequence_Fast_GET_SIZE(seq);
+    int64_t *values = PyMem_Malloc((n ? n : 1) * sizeof(int64_t));
+    BitVector *exists = bv_new(n);
+    if (!values || !exists) {
+        PyMem_Free(values);
+        bv_free(exists);
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    for (size_t i = 0; i < n; ++i) {
+        if (items[i] == Py_None) {
+            values[i] = 0;
+            continue;
+        }
+        long long v = PyLong_AsLongLong(items[i]);
+        if (v == -1 && PyErr_Occurred()) {
+            PyMem_Free(values);
+            bv_free(exists);
+            Py_DECREF(seq);
+            return -1;
+        }
+        values[i] = (int64_t) v;
+        bv_set(exists, i);
+    }
+    Py_DECREF(seq);
+
+    BitSlicedIndex *bsi;
+    Py_BEGIN_ALLOW_THREADS
+    bsi = bsi_new(values, exists, n);
+    Py_END_ALLOW_THREADS
+    PyMem_Free(values);
+    bv_free(exists);
+    if (!bsi) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate BitSlicedIndex");
+        return -1;
+    }
+    if (BSI_QUERIES(self) > 0) {
+        bsi_free(bsi);
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot re-initialize a BitSlicedIndex during a "
+                        "query");
+        return -1;
+    }
+    bsi_free(BSI(self));
+    BSI(self) = bsi;
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_bsi_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyBitSlicedIndexObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bsi_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    bsi_free(BSI(object));
+    BSI(object) = NULL;
+    type->tp_free(object);
+    Py_DECREF(type);
+}
+
+/**
+ * @brief Parse a comparison constant.
+ *
+ * @param arg Python integer.
+ * @param out Receives the value, clamped to the signed 64-bit range.
+ * @retval 0 Success.
+ * @retval 1 Value is above the signed 64-bit range.
+ * @retval 2 Value is below the signed 64-bit range.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bsi_parse_value(PyObject *arg, int64_t *out)
+{
+    if (!PyLong_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "value must be an integer");
+        return -1;
+    }
+    int overflow = 0;
+    long long v = PyLong_AsLongLongAndOverflow(arg, &overflow);
+    if (v == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (overflow > 0) {
+        *out = INT64_MAX;
+        return 1;
+    }
+    if (overflow < 0) {
+        *out = INT64_MIN;
+        return 2;
+    }
+    *out = (int64_t) v;
+    return 0;
+}
+
+/**
+ * @brief Copy an optional row filter after checking its width.
+ *
+ * The copy keeps the query safe if the caller's vector is modified by
+ * another thread while the GIL is released.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param arg ``None`` or a ``BitVector`` with one bit per row.
+ * @param out Receives the copy, or NULL for ``None``.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bsi_copy_filter(PyObject *self, PyObject *arg, BitVector **out)
+{
+    *out = NULL;
+    if (!arg || arg == Py_None) {
+        return 0;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(arg, state)) {
+        PyErr_SetString(PyExc_TypeError, "filter must be a BitVector");
+        return -1;
+    }
+    const BitVector *bv = ((PyBitVectorObject *) arg)->bv;
+    if (bv->n_bits != BSI(self)->n_rows) {
+        PyErr_Format(PyExc_ValueError,
+                     "expected a BitVector of %zu bits, got %zu",
+                     BSI(self)->n_rows, bv->n_bits);
+        return -1;
+    }
+    *out = bv_copy(bv);
+    if (!*out) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Wrap a native query result in a Python ``BitVector``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param bv Result vector or NULL after an allocation failure.
+ * @retval BitVector New Python object owning @p bv.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_wrap(PyObject *self, BitVector *bv)
+{
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Shared implementation of the comparison methods.
+ *
+ * Constants outside the signed 64-bit range match every row or none, which
+ * is expressed as a comparison against the nearest end of the range.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param arg Comparison constant.
+ * @param op Comparison.
+ * @retval BitVector Matching rows.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_compare(PyObject *self, PyObject *arg, BSIOp op)
+{
+    int64_t value;
+    int rc = py_bsi_parse_value(arg, &value);
+    if (rc < 0) {
+        return NULL;
+    }
+    if (rc) {
+        const bool above = rc == 1;
+        const bool all = op == BSI_NE ||
+                         (above ? op == BSI_LT || op == BSI_LE
+                                : op == BSI_GT || op == BSI_GE);
+        op = all ? (above ? BSI_LE : BSI_GE) : (above ? BSI_GT : BSI_LT);
+    }
+    BitVector *out;
+    BSI_QUERIES(self)++;
+    Py_BEGIN_ALLOW_THREADS
+    out = bsi_compare(BSI(self), op, value);
+    Py_END_ALLOW_THREADS
+    BSI_QUERIES(self)--;
+    return py_bsi_wrap(self, out);
+}
+
+/** @brief Python binding for ``eq(value)``. */
+static PyObject *
+py_bsi_eq(PyObject *self, PyObject *arg)
+{
+    return py_bsi_compare(self, arg, BSI_EQ);
+}
+
+/** @brief Python binding for ``ne(value)``. */
+static PyObject *
+py_bsi_ne(PyObject *self, PyObject *arg)
+{
+    return py_bsi_compare(self, arg, BSI_NE);
+}
+
+/** @brief Python binding for ``lt(value)``. */
+static PyObject *
+py_bsi_lt(PyObject *self, PyObject *arg)
+{
+    return py_bsi_compare(self, arg, BSI_LT);
+}
+
+/** @brief Python binding for ``le(value)``. */
+static PyObject *
+py_bsi_le(PyObject *self, PyObject *arg)
+{
+    return py_bsi_compare(self, arg, BSI_LE);
+}
+
+/** @brief Python binding for ``gt(value)``. */
+static PyObject *
+py_bsi_gt(PyObject *self, PyObject *arg)
+{
+    return py_bsi_compare(self, arg, BSI_GT);
+}
+
+/** @brief Python binding for ``ge(value)``. */
+static PyObject *
+py_bsi_ge(PyObject *self, PyObject *arg)
+{
+    return py_bsi_compare(self, arg, BSI_GE);
+}
+
+/**
+ * @brief Python binding for ``between(lo, hi)``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param args Positional arguments (lo, hi).
+ * @retval BitVector Rows whose value lies in ``[lo, hi]``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_between(PyObject *self, PyObject *args)
+{
+    PyObject *lo_obj, *hi_obj;
+    if (!PyArg_ParseTuple(args, "OO", &lo_obj, &hi_obj)) {
+        return NULL;
+    }
+    int64_t lo, hi;
+    int rc_lo = py_bsi_parse_value(lo_obj, &lo);
+    if (rc_lo < 0) {
+        return NULL;
+    }
+    int rc_hi = py_bsi_parse_value(hi_obj, &hi);
+    if (rc_hi < 0) {
+        return NULL;
+    }
+    if (rc_lo == 1 || rc_hi == 2) {
+        /* An empty range once clamped to 64 bits. */
+        lo = INT64_MAX;
+        hi = INT64_MIN;
+    }
+    BitVector *out;
+    BSI_QUERIES(self)++;
+    Py_BEGIN_ALLOW_THREADS
+    out = bsi_between(BSI(self), lo, hi);
+    Py_END_ALLOW_THREADS
+    BSI_QUERIES(self)--;
+    return py_bsi_wrap(self, out);
+}
+
+/**
+ * @brief Python binding for ``sum(filter=None)``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval int Exact sum of the selected values.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_sum(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *filter_obj = NULL;
+    static char *kwlist[] = {"filter", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist,
+                                     &filter_obj)) {
+        return NULL;
+    }
+    BitVector *filter;
+    if (py_bsi_copy_filter(self, filter_obj, &filter) < 0) {
+        return NULL;
+    }
+    const BitSlicedIndex *bsi = BSI(self);
+    size_t counts[BSI_MAX_SLICES];
+    size_t found;
+    BSI_QUERIES(self)++;
+    Py_BEGIN_ALLOW_THREADS
+    found = bsi_slice_counts(bsi, filter, counts);
+    Py_END_ALLOW_THREADS
+    BSI_QUERIES(self)--;
+    bv_free(filter);
+    /* The index may be replaced once Python code can run again. */
+    const unsigned n_slices = bsi->n_slices;
+
+    /* base * found + sum(counts[b] << b), in arbitrary precision. */
+    PyObject *total = NULL;
+    PyObject *base = PyLong_FromLongLong(bsi->base);
+    PyObject *n_found = PyLong_FromSize_t(found);
+    if (base && n_found) {
+        total = PyNumber_Multiply(base, n_found);
+    }
+    Py_XDECREF(base);
+    Py_XDECREF(n_found);
+    for (unsigned b = 0; total && b < n_slices; ++b) {
+        PyObject *count = PyLong_FromSize_t(counts[b]);
+        PyObject *shift = PyLong_FromUnsignedLong(b);
+        PyObject *term = count && shift ? PyNumber_Lshift(count, shift) : NULL;
+        Py_XDECREF(count);
+        Py_XDECREF(shift);
+        PyObject *next = term ? PyNumber_Add(total, term) : NULL;
+        Py_XDECREF(term);
+        Py_SETREF(total, next);
+    }
+    return total;
+}
+
+/**
+ * @brief Python binding for ``top_k(k, filter=None, *, largest=True)``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval BitVector The selected rows.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_top_k(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t k;
+    PyObject *filter_obj = NULL;
+    int largest = 1;
+    static char *kwlist[] = {"k", "filter", "largest", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|O$p", kwlist, &k,
+                                     &filter_obj, &largest)) {
+        return NULL;
+    }
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "k must be >= 0");
+        return NULL;
+    }
+    BitVector *filter;
+    if (py_bsi_copy_filter(self, filter_obj, &filter) < 0) {
+        return NULL;
+    }
+    BitVector *out;
+    BSI_QUERIES(self)++;
+    Py_BEGIN_ALLOW_THREADS
+    out = bsi_top_k(BSI(self), (size_t) k, filter, largest != 0);
+    Py_END_ALLOW_THREADS
+    BSI_QUERIES(self)--;
+    bv_free(filter);
+    return py_bsi_wrap(self, out);
+}
+
+/**
+ * @brief Python binding for ``slice(bit)``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param arg Bit position.
+ * @retval BitVector Copy of the slice.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_slice(PyObject *self, PyObject *arg)
+{
+    Py_ssize_t bit = PyNumber_AsSsize_t(arg, PyExc_IndexError);
+    if (bit == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (bit < 0 || (size_t) bit >= BSI(self)->n_slices) {
+        PyErr_SetString(PyExc_IndexError, "slice index out of range");
+        return NULL;
+    }
+    return py_bsi_wrap(self, bv_copy(BSI(self)->slices[bit]));
+}
+
+/**
+ * @brief Implement ``len(BitSlicedIndex)``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @return Number of rows.
+ */
+static Py_ssize_t
+py_bsi_len(PyObject *self)
+{
+    return (Py_ssize_t) BSI(self)->n_rows;
+}
+
+/**
+ * @brief Implement ``BitSlicedIndex[row]``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param i Row (already adjusted for negative values).
+ * @retval int Stored value, or ``None`` for a missing row.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bsi_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= BSI(self)->n_rows) {
+        PyErr_SetString(PyExc_IndexError,
+                        "BitSlicedIndex index out of range");
+        return NULL;
+    }
+    int64_t value;
+    if (!bsi_get(BSI(self), (size_t) i, &value)) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromLongLong(value);
+}
+
+/**
+ * @brief Implement ``BitSlicedIndex.__sizeof__``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_bsi_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total = (size_t) Py_TYPE(self)->tp_basicsize +
+                   bsi_memory_usage(BSI(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``repr(BitSlicedIndex)``.
+ *
+ * @param self A ``PyBitSlicedIndexObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_bsi_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat("<%s object at %p rows=%zu bits=%u>",
+                                Py_TYPE(self)->tp_name, self,
+                                BSI(self)->n_rows, BSI(self)->n_slices);
+}
+
+/** @brief Getter for the read-only ``bits`` property. */
+static PyObject *
+py_bsi_get_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(BSI(self)->n_slices);
+}
+
+/** @brief Getter for the read-only ``base`` property. */
+static PyObject *
+py_bsi_get_base(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromLongLong(BSI(self)->base);
+}
+
+/** @brief Getter for the read-only ``exists`` property. */
+static PyObject *
+py_bsi_get_exists(PyObject *self, void *Py_UNUSED(closure))
+{
+    return py_bsi_wrap(self, bv_copy(BSI(self)->exists));
+}
+
+#undef BSI
+
+/** @brief Docstring for ``between``. */
+PyDoc_STRVAR(py_bsi_between__doc__,
+             "between(lo: int, hi: int) -> BitVector\n"
+             "\n"
+             "Rows whose value lies in [lo, hi], both ends included. Both "
+             "bounds are evaluated in one pass over the slices.");
+/** @brief Docstring for ``sum``. */
+PyDoc_STRVAR(py_bsi_sum__doc__,
+             "sum(filter: BitVector | None = None) -> int\n"
+             "\n"
+             "Exact sum of the values of the rows set in filter, or of all "
+             "rows. Missing rows count as nothing.");
+/** @brief Docstring for ``top_k``. */
+PyDoc_STRVAR(py_bsi_top_k__doc__,
+             "top_k(k: int, filter: BitVector | None = None, *, "
+             "largest: bool = True) -> BitVector\n"
+             "\n"
+             "Rows holding the k largest (or smallest) values among the "
+             "rows set in filter, or among all rows with a value. Ties are "
+             "broken in favour of lower rows, so exactly min(k, candidates) "
+             "rows are set.");
+
+/**
+ * @brief Method table for the ``BitSlicedIndex`` type.
+ */
+static PyMethodDef PyBitSlicedIndex_methods[] = {
+    {"eq", (PyCFunction) py_bsi_eq, METH_O,
+     PyDoc_STR("eq(value: int) -> BitVector\n\nRows equal to value.")},
+    {"ne", (PyCFunction) py_bsi_ne, METH_O,
+     PyDoc_STR("ne(value: int) -> BitVector\n\n"
+               "Rows with a value other than value.")},
+    {"lt", (PyCFunction) py_bsi_lt, METH_O,
+     PyDoc_STR("lt(value: int) -> BitVector\n\nRows below value.")},
+    {"le", (PyCFunction) py_bsi_le, METH_O,
+     PyDoc_STR("le(value: int) -> BitVector\n\nRows at most value.")},
+    {"gt", (PyCFunction) py_bsi_gt, METH_O,
+     PyDoc_STR("gt(value: int) -> BitVector\n\nRows above value.")},
+    {"ge", (PyCFunction) py_bsi_ge, METH_O,
+     PyDoc_STR("ge(value: int) -> BitVector\n\nRows at least value.")},
+    {"between", (PyCFunction) py_bsi_between, METH_VARARGS,
+     py_bsi_between__doc__},
+    {"sum", (PyCFunction) (void (*)(void)) py_bsi_sum,
+     METH_VARARGS | METH_KEYWORDS, py_bsi_sum__doc__},
+    {"top_k", (PyCFunction) (void (*)(void)) py_bsi_top_k,
+     METH_VARARGS | METH_KEYWORDS, py_bsi_top_k__doc__},
+    {"slice", (PyCFunction) py_bsi_slice, METH_O,
+     PyDoc_STR("slice(bit: int) -> BitVector\n\n"
+               "Copy of the slice holding bit `bit` of value - base.")},
+    {"__sizeof__", (PyCFunction) py_bsi_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the ``BitSlicedIndex`` type.
+ */
+static PyGetSetDef PyBitSlicedIndex_getset[] = {
+    {"bits", py_bsi_get_bits, NULL,
+     PyDoc_STR("Number of slices (bits of max - min).")},
+    {"base", py_bsi_get_base, NULL,
+     PyDoc_STR("Smallest value; the slices store value - base.")},
+    {"exists", py_bsi_get_exists, NULL,
+     PyDoc_STR("Copy of the existence vector: rows that have a value.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``BitSlicedIndex`` type. */
+PyDoc_STRVAR(
+    PyBitSlicedIndex__doc__,
+    "BitSlicedIndex(values: Iterable[int | None])\n"
+    "\n"
+    "An immutable bit-sliced index over a column of signed 64-bit "
+    "integers.\n\n"
+    "Stores one BitVector per bit of the value plus an existence vector "
+    "and answers comparisons, ranges, sums and top-k queries with "
+    "O'Neil's bit-sliced algorithms. Query results are BitVectors with "
+    "one bit per row; missing rows never match.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "values : Iterable[int | None]\n"
+    "   The column; None marks a row without a value.\n");
+
+/**
+ * @brief Slot table for the ``BitSlicedIndex`` type.
+ */
+static PyType_Slot PyBitSlicedIndex_slots[] = {
+    {Py_tp_doc, (void *) PyBitSlicedIndex__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bsi_new},
+    {Py_tp_init, py_bsi_init},
+    {Py_tp_traverse, py_bsi_traverse},
+    {Py_tp_dealloc, py_bsi_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBitSlicedIndex_methods},
+    {Py_tp_getset, PyBitSlicedIndex_getset},
+    {Py_tp_repr, py_bsi_repr},
+
+    {Py_sq_length, py_bsi_len},
+    {Py_sq_item, py_bsi_item},
+    {Py_mp_length, py_bsi_len},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``BitSlicedIndex``.
+ */
+PyType_Spec PyBitSlicedIndex_spec = {
+    .name = "cbits.BitSlicedIndex",
+    .basicsize = sizeof(PyBitSlicedIndexObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBitSlicedIndex_slots,
+};
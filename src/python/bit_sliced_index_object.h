@@ -0,0 +1,33 @@
+/**
+ * @file bit_sliced_index_object.h
+ * @brief Definition of the ``BitSlicedIndex`` Python type.
+ *
+ * Declares the Python wrapper around the native bit-sliced index:
+ * - \ref PyBitSlicedIndexObject - the Python object structure
+ * - \ref PyBitSlicedIndex_spec - the type specification
+ *
+ * @see bit_sliced_index.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BIT_SLICED_INDEX_OBJECT_H
+#define CBITS_PY_BIT_SLICED_INDEX_OBJECT_H
+
+#include "bit_sliced_index.h"
+#include "bitvector_object.h"
+
+/**
+ * @brief Python object wrapping a native ``BitSlicedIndex``.
+ *
+ * Queries run without the GIL; while one is running the index must not be
+ * freed, so @c queries blocks re-init.
+ */
+typedef struct {
+    PyObject_HEAD BitSlicedIndex *bsi; /**< Underlying index */
+    Py_ssize_t queries; /**< Number of queries running without the GIL */
+} PyBitSlicedIndexObject;
+
+extern PyType_Spec PyBitSlicedIndex_spec;
+
+#endif /* CBITS_PY_BIT_SLICED_INDEX_OBJECT_H */
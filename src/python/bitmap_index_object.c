@@ -0,0 +1,709 @@
+/**
+ * @file bitmap_index_object.c
+ * @brief Implementation of the ``BitmapIndex`` Python type.
+ *
+ * Exposes the bitmap index as a mapping from hashable keys to BitVectors of
+ * one length. ``query`` and ``count`` take a query tree of nested tuples
+ * such as ``("and", "red", ("not", "small"))``: a tuple whose first item
+ * is ``"and"``, ``"or"``, ``"not"`` or ``"andnot"`` is an operator, any
+ * other object is a key. The tree is translated into a @ref BMIQuery and
+ * planned and evaluated natively.
+ *
+ * @see bitmap_index_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitmap_index_object.h"
+
+/** @brief Shorthand for the Python object layout. */
+#define BMI_OBJ(o) ((PyBitmapIndexObject *) (o))
+/** @brief Shorthand for the native index of a Python object. */
+#define BMI(o) (BMI_OBJ(o)->bmi)
+
+/**
+ * @brief ``__new__`` for ``BitmapIndex``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_bmi_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+           PyObject *Py_UNUSED(kwds))
+{
+    PyBitmapIndexObject *self =
+        (PyBitmapIndexObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->bmi = NULL;
+    self->slots = NULL;
+    self->keys = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief Look up the vector index of a key.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @param index Receives the vector index.
+ * @retval 1 Key found.
+ * @retval 0 Key absent (no exception set).
+ * @retval -1 Failure, e.g. an unhashable key (exception set).
+ */
+static int
+py_bmi_lookup(PyObject *self, PyObject *key, size_t *index)
+{
+    PyObject *value = PyDict_GetItemWithError(BMI_OBJ(self)->slots, key);
+    if (!value) {
+        return PyErr_Occurred() ? -1 : 0;
+    }
+    *index = PyLong_AsSize_t(value);
+    return 1;
+}
+
+/**
+ * @brief Raise ``KeyError(key)``.
+ *
+ * @param key Missing key; wrapped in a tuple so tuple keys survive.
+ */
+static void
+py_bmi_set_key_error(PyObject *key)
+{
+    PyObject *args = PyTuple_Pack(1, key);
+    if (args) {
+        PyErr_SetObject(PyExc_KeyError, args);
+        Py_DECREF(args);
+    }
+}
+
+/**
+ * @brief Store a copy of a vector under a key, replacing any old one.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @param value Candidate ``BitVector``.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bmi_assign(PyObject *self, PyObject *key, PyObject *value)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(value, state)) {
+        PyErr_SetString(PyExc_TypeError, "value must be a BitVector");
+        return -1;
+    }
+    const BitVector *bv = ((PyBitVectorObject *) value)->bv;
+    if (bv->n_bits != BMI(self)->n_bits) {
+        PyErr_Format(PyExc_ValueError,
+                     "expected a BitVector of %zu bits, got %zu",
+                     BMI(self)->n_bits, bv->n_bits);
+        return -1;
+    }
+    size_t index;
+    int found = py_bmi_lookup(self, key, &index);
+    if (found < 0) {
+        return -1;
+    }
+    if (found) {
+        if (bmi_set(BMI(self), index, bv) < 0) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        return 0;
+    }
+    index = bmi_add(BMI(self), bv);
+    if (index == SIZE_MAX) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyObject *index_obj = PyLong_FromSize_t(index);
+    if (!index_obj ||
+        PyDict_SetItem(BMI_OBJ(self)->slots, key, index_obj) < 0) {
+        Py_XDECREF(index_obj);
+        bmi_remove(BMI(self), index);
+        return -1;
+    }
+    Py_DECREF(index_obj);
+    if (PyList_Append(BMI_OBJ(self)->keys, key) < 0) {
+        PyDict_DelItem(BMI_OBJ(self)->slots, key);
+        bmi_remove(BMI(self), index);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Remove the vector stored under a key.
+ *
+ * The last vector moves into the freed index, and its key is re-pointed.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bmi_delete(PyObject *self, PyObject *key)
+{
+    size_t index;
+    int found = py_bmi_lookup(self, key, &index);
+    if (found <= 0) {
+        if (found == 0) {
+            py_bmi_set_key_error(key);
+        }
+        return -1;
+    }
+    PyObject *keys = BMI_OBJ(self)->keys;
+    const size_t last = BMI(self)->size - 1;
+    if (index != last) {
+        PyObject *moved = PyList_GET_ITEM(keys, (Py_ssize_t) last);
+        PyObject *index_obj = PyLong_FromSize_t(index);
+        if (!index_obj ||
+            PyDict_SetItem(BMI_OBJ(self)->slots, moved, index_obj) < 0) {
+            Py_XDECREF(index_obj);
+            return -1;
+        }
+        Py_DECREF(index_obj);
+        Py_INCREF(moved);
+        PyList_SetItem(keys, (Py_ssize_t) index, moved);
+    }
+    if (PyDict_DelItem(BMI_OBJ(self)->slots, key) < 0 ||
+        PyList_SetSlice(keys, (Py_ssize_t) last, (Py_ssize_t) last + 1,
+                        NULL) < 0) {
+        return -1;
+    }
+    bmi_remove(BMI(self), index);
+    return 0;
+}
+
+/**
+ * @brief ``__init__(size, vectors=None)``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bmi_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t size;
+    PyObject *vectors = NULL;
+    static char *kwlist[] = {"size", "vectors", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|O", kwlist, &size,
+                                     &vectors)) {
+        return -1;
+    }
+    if (size < 0) {
+        PyErr_SetString(PyExc_ValueError, "size must be >= 0");
+        return -1;
+    }
+    BitmapIndex *bmi = bmi_new((size_t) size);
+    PyObject *slots = PyDict_New();
+    PyObject *keys = PyList_New(0);
+    if (!bmi || !slots || !keys) {
+        bmi_free(bmi);
+        Py_XDECREF(slots);
+        Py_XDECREF(keys);
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_MemoryError,
+                            "Failed to allocate BitmapIndex");
+        }
+        return -1;
+    }
+    bmi_free(BMI(self));
+    BMI(self) = bmi;
+    Py_XSETREF(BMI_OBJ(self)->slots, slots);
+    Py_XSETREF(BMI_OBJ(self)->keys, keys);
+
+    if (!vectors || vectors == Py_None) {
+        return 0;
+    }
+    PyObject *items = PyMapping_Items(vectors);
+    if (!items) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(items); ++i) {
+        PyObject *item = PyList_GET_ITEM(items, i);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            PyErr_SetString(PyExc_TypeError,
+                            "vectors must map keys to BitVectors");
+            Py_DECREF(items);
+            return -1;
+        }
+        if (py_bmi_assign(self, PyTuple_GET_ITEM(item, 0),
+                          PyTuple_GET_ITEM(item, 1)) < 0) {
+            Py_DECREF(items);
+            return -1;
+        }
+    }
+    Py_DECREF(items);
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Success.
+ */
+static int
+py_bmi_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(BMI_OBJ(self)->slots);
+    Py_VISIT(BMI_OBJ(self)->keys);
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief GC clear callback; drops the key containers.
+ *
+ * @param self Object being cleared.
+ * @retval 0 Always.
+ */
+static int
+py_bmi_clear(PyObject *self)
+{
+    Py_CLEAR(BMI_OBJ(self)->slots);
+    Py_CLEAR(BMI_OBJ(self)->keys);
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyBitmapIndexObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bmi_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    py_bmi_clear(object);
+    bmi_free(BMI(object));
+    BMI(object) = NULL;
+    type->tp_free(object);
+    Py_DECREF(type);
+}
+
+/* Query trees */
+
+/**
+ * @brief Free the children arrays of a query tree.
+ *
+ * @param q Root node; the node itself is owned by the caller.
+ */
+static void
+py_bmi_query_free(BMIQuery *q)
+{
+    BMIQuery *children = (BMIQuery *) q->children;
+    for (size_t i = 0; i < q->n_children; ++i) {
+        py_bmi_query_free(&children[i]);
+    }
+    PyMem_Free(children);
+    q->children = NULL;
+    q->n_children = 0;
+}
+
+/**
+ * @brief Translate a Python query tree into a @ref BMIQuery.
+ *
+ * On failure @p q may hold partially built children, which
+ * @ref py_bmi_query_free releases.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param expr Key or operator tuple.
+ * @param q Zeroed node to fill.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bmi_query_build(PyObject *self, PyObject *expr, BMIQuery *q)
+{
+    static const struct {
+        const char *name;
+        BMIOp op;
+    } ops[] = {
+        {"and", BMI_AND},
+        {"or", BMI_OR},
+        {"not", BMI_NOT},
+        {"andnot", BMI_ANDNOT},
+    };
+    if (PyTuple_Check(expr) && PyTuple_GET_SIZE(expr) > 0 &&
+        PyUnicode_Check(PyTuple_GET_ITEM(expr, 0))) {
+        PyObject *name = PyTuple_GET_ITEM(expr, 0);
+        for (size_t o = 0; o < sizeof(ops) / sizeof(ops[0]); ++o) {
+            if (PyUnicode_CompareWithASCIIString(name, ops[o].name) != 0) {
+                continue;
+            }
+            const size_t n = (size_t) PyTuple_GET_SIZE(expr) - 1;
+            if (n == 0 || (ops[o].op == BMI_NOT && n != 1)) {
+                PyErr_Format(PyExc_ValueError,
+                             "'%s' takes %s operand%s", ops[o].name,
+                             ops[o].op == BMI_NOT ? "exactly one"
+                                                  : "at least one",
+                             ops[o].op == BMI_NOT ? "" : "s");
+                return -1;
+            }
+            BMIQuery *children = PyMem_Calloc(n, sizeof(BMIQuery));
+            if (!children) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            q->op = ops[o].op;
+            q->n_children = n;
+            q->children = children;
+            if (Py_EnterRecursiveCall(" while building a BitmapIndex "
+                                      "query")) {
+                return -1;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                PyObject *child = PyTuple_GET_ITEM(expr, (Py_ssize_t) i + 1);
+                if (py_bmi_query_build(self, child, &children[i]) < 0) {
+                    Py_LeaveRecursiveCall();
+                    return -1;
+                }
+            }
+            Py_LeaveRecursiveCall();
+            return 0;
+        }
+    }
+    size_t index;
+    int found = py_bmi_lookup(self, expr, &index);
+    if (found <= 0) {
+        if (found == 0) {
+            py_bmi_set_key_error(expr);
+        }
+        return -1;
+    }
+    q->op = BMI_KEY;
+    q->vector = index;
+    return 0;
+}
+
+/**
+ * @brief Shared implementation of ``query`` and ``count``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param expr Query tree.
+ * @param count Whether to count the matches instead of returning them.
+ * @retval BitVector Matching bits, or ``int`` if @p count is set.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bmi_run(PyObject *self, PyObject *expr, bool count)
+{
+    BMIQuery q = {BMI_KEY, 0, 0, NULL};
+    if (py_bmi_query_build(self, expr, &q) < 0) {
+        py_bmi_query_free(&q);
+        return NULL;
+    }
+    PyObject *result = NULL;
+    if (count) {
+        size_t n;
+        if (bmi_query_count(BMI(self), &q, &n) < 0) {
+            PyErr_NoMemory();
+        }
+        else {
+            result = PyLong_FromSize_t(n);
+        }
+    }
+    else {
+        BitVector *bv = bmi_query(BMI(self), &q);
+        if (!bv) {
+            PyErr_SetString(PyExc_MemoryError,
+                            "Failed to allocate BitVector");
+        }
+        else {
+            cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+            result = bitvector_wrap_new(state->PyBitVectorType, bv);
+        }
+    }
+    py_bmi_query_free(&q);
+    return result;
+}
+
+/** @brief Python binding for ``query(expr)``. */
+static PyObject *
+py_bmi_query(PyObject *self, PyObject *expr)
+{
+    return py_bmi_run(self, expr, false);
+}
+
+/** @brief Python binding for ``count(expr)``. */
+static PyObject *
+py_bmi_count(PyObject *self, PyObject *expr)
+{
+    return py_bmi_run(self, expr, true);
+}
+
+/* Mapping protocol */
+
+/**
+ * @brief Implement ``len(BitmapIndex)``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @return Number of stored vectors.
+ */
+static Py_ssize_t
+py_bmi_len(PyObject *self)
+{
+    return (Py_ssize_t) BMI(self)->size;
+}
+
+/**
+ * @brief Implement ``BitmapIndex[key]``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @retval BitVector Copy of the stored vector.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bmi_subscript(PyObject *self, PyObject *key)
+{
+    size_t index;
+    int found = py_bmi_lookup(self, key, &index);
+    if (found <= 0) {
+        if (found == 0) {
+            py_bmi_set_key_error(key);
+        }
+        return NULL;
+    }
+    BitVector *copy = bv_copy(BMI(self)->entries[index].bv);
+    if (!copy) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, copy);
+}
+
+/**
+ * @brief Implement ``BitmapIndex[key] = value`` and ``del BitmapIndex[key]``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @param value ``BitVector`` to store, or NULL to delete.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bmi_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
+{
+    return value ? py_bmi_assign(self, key, value)
+                 : py_bmi_delete(self, key);
+}
+
+/**
+ * @brief Implement ``key in BitmapIndex``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @retval 1 Key present.
+ * @retval 0 Key absent.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bmi_contains(PyObject *self, PyObject *key)
+{
+    return PyDict_Contains(BMI_OBJ(self)->slots, key);
+}
+
+/**
+ * @brief Implement ``iter(BitmapIndex)`` over a snapshot of the keys.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @return Key iterator.
+ */
+static PyObject *
+py_bmi_iter(PyObject *self)
+{
+    PyObject *keys = PyList_GetSlice(BMI_OBJ(self)->keys, 0, PY_SSIZE_T_MAX);
+    if (!keys) {
+        return NULL;
+    }
+    PyObject *it = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return it;
+}
+
+/**
+ * @brief Python binding for ``keys()``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param ignored Unused.
+ * @return New list of the keys in storage order.
+ */
+static PyObject *
+py_bmi_keys(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyList_GetSlice(BMI_OBJ(self)->keys, 0, PY_SSIZE_T_MAX);
+}
+
+/**
+ * @brief Python binding for ``cardinality(key)``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param key Python key.
+ * @retval int Cached popcount of the vector.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bmi_cardinality(PyObject *self, PyObject *key)
+{
+    size_t index;
+    int found = py_bmi_lookup(self, key, &index);
+    if (found <= 0) {
+        if (found == 0) {
+            py_bmi_set_key_error(key);
+        }
+        return NULL;
+    }
+    return PyLong_FromSize_t(BMI(self)->entries[index].count);
+}
+
+/**
+ * @brief Python binding for ``__sizeof__()``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @param ignored Unused.
+ * @return Object size plus the native footprint, in bytes.
+ */
+static PyObject *
+py_bmi_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total = (size_t) Py_TYPE(self)->tp_basicsize +
+                   bmi_memory_usage(BMI(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``repr()``.
+ *
+ * @param self A ``PyBitmapIndexObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_bmi_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat("<%s object at %p vectors=%zu size=%zu>",
+                                Py_TYPE(self)->tp_name, self,
+                                BMI(self)->size, BMI(self)->n_bits);
+}
+
+/** @brief Getter for the read-only ``size`` property. */
+static PyObject *
+py_bmi_get_size(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(BMI(self)->n_bits);
+}
+
+#undef BMI
+#undef BMI_OBJ
+
+/** @brief Docstring for ``query``. */
+PyDoc_STRVAR(py_bmi_query__doc__,
+             "query(expr) -> BitVector\n"
+             "\n"
+             "Evaluate a query tree. expr is a key or a tuple "
+             "(op, operand, ...) with op one of 'and', 'or', 'not' (one "
+             "operand) and 'andnot' (first operand minus the others). "
+             "Raises KeyError for unknown keys.");
+/** @brief Docstring for ``count``. */
+PyDoc_STRVAR(py_bmi_count__doc__,
+             "count(expr) -> int\n"
+             "\n"
+             "Number of set bits in query(expr), without building the "
+             "result vector.");
+
+/**
+ * @brief Method table for the ``BitmapIndex`` type.
+ */
+static PyMethodDef PyBitmapIndex_methods[] = {
+    {"query", (PyCFunction) py_bmi_query, METH_O, py_bmi_query__doc__},
+    {"count", (PyCFunction) py_bmi_count, METH_O, py_bmi_count__doc__},
+    {"cardinality", (PyCFunction) py_bmi_cardinality, METH_O,
+     PyDoc_STR("cardinality(key) -> int\n\n"
+               "Cached number of set bits of the vector stored under key.")},
+    {"keys", (PyCFunction) py_bmi_keys, METH_NOARGS,
+     PyDoc_STR("keys() -> list\n\nThe keys in storage order.")},
+    {"__sizeof__", (PyCFunction) py_bmi_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the ``BitmapIndex`` type.
+ */
+static PyGetSetDef PyBitmapIndex_getset[] = {
+    {"size", py_bmi_get_size, NULL,
+     PyDoc_STR("Length in bits of every stored vector.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``BitmapIndex`` type. */
+PyDoc_STRVAR(
+    PyBitmapIndex__doc__,
+    "BitmapIndex(size: int, vectors: Mapping[Hashable, BitVector] | None "
+    "= None)\n"
+    "\n"
+    "A mapping from keys to BitVectors of one length with a boolean query "
+    "planner.\n\n"
+    "Stores a copy of every vector with its popcount and a per-chunk "
+    "emptiness summary. query() flattens the tree, orders AND operands "
+    "by cardinality, and evaluates it chunk by chunk so operands stay in "
+    "cache, skipping chunks that are empty.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "size : int\n"
+    "   Length in bits of every vector.\n"
+    "vectors : Mapping, optional\n"
+    "   Initial key to BitVector mapping.\n");
+
+/**
+ * @brief Slot table for the ``BitmapIndex`` type.
+ */
+static PyType_Slot PyBitmapIndex_slots[] = {
+    {Py_tp_doc, (void *) PyBitmapIndex__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bmi_new},
+    {Py_tp_init, py_bmi_init},
+    {Py_tp_traverse, py_bmi_traverse},
+    {Py_tp_clear, py_bmi_clear},
+    {Py_tp_dealloc, py_bmi_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBitmapIndex_methods},
+    {Py_tp_getset, PyBitmapIndex_getset},
+    {Py_tp_repr, py_bmi_repr},
+    {Py_tp_iter, py_bmi_iter},
+
+    {Py_mp_length, py_bmi_len},
+    {Py_mp_subscript, py_bmi_subscript},
+    {Py_mp_ass_subscript, py_bmi_ass_subscript},
+    {Py_sq_contains, py_bmi_contains},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``BitmapIndex``.
+ */
+PyType_Spec PyBitmapIndex_spec = {
+    .name = "cbits.BitmapIndex",
+    .basicsize = sizeof(PyBitmapIndexObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBitmapIndex_slots,
+};
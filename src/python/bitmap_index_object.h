@@ -0,0 +1,35 @@
+/**
+ * @file bitmap_index_object.h
+ * @brief Definition of the ``BitmapIndex`` Python type.
+ *
+ * Declares the Python wrapper around the native bitmap index:
+ * - \ref PyBitmapIndexObject - the Python object structure
+ * - \ref PyBitmapIndex_spec - the type specification
+ *
+ * @see bitmap_index.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BITMAP_INDEX_OBJECT_H
+#define CBITS_PY_BITMAP_INDEX_OBJECT_H
+
+#include "bitmap_index.h"
+#include "bitvector_object.h"
+
+/**
+ * @brief Python object wrapping a native ``BitmapIndex``.
+ *
+ * Python keys map to native vector indexes through @c slots; @c keys is
+ * the inverse mapping, so removing a vector can re-point the key of the
+ * vector that moves into its place.
+ */
+typedef struct {
+    PyObject_HEAD BitmapIndex *bmi; /**< Underlying index */
+    PyObject *slots;                /**< dict: key -> vector index */
+    PyObject *keys;                 /**< list: vector index -> key */
+} PyBitmapIndexObject;
+
+extern PyType_Spec PyBitmapIndex_spec;
+
+#endif /* CBITS_PY_BITMAP_INDEX_OBJECT_H */
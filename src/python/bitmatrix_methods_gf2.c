@@ -0,0 +1,79 @@
+/**
+ * @file bitmatrix_methods_gf2.c
+ * @brief Implementation of GF(2) linear algebra methods for ``BitMatrix``.
+ *
+ * Thin wrappers around \ref gf2_echelon, \ref gf2_rank, \ref gf2_nullspace
+ * and \ref gf2_mul that map allocation failures and shape mismatches to
+ * Python exceptions.
+ *
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitmatrix_methods_gf2.h"
+#include "gf2.h"
+
+/** @brief Shorthand for the native matrix of a Python object. */
+#define BM(o) (((PyBitMatrixObject *) (o))->m)
+
+PyObject *
+py_bitmatrix_echelon(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    int reduced = 0;
+    static char *kwlist[] = {"reduced", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &reduced)) {
+        return NULL;
+    }
+    size_t rank = gf2_echelon(BM(self), reduced != 0, NULL);
+    if (rank == SIZE_MAX) {
+        return PyErr_NoMemory();
+    }
+    return PyLong_FromSize_t(rank);
+}
+
+PyObject *
+py_bitmatrix_rank(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t rank = gf2_rank(BM(self));
+    if (rank == SIZE_MAX) {
+        return PyErr_NoMemory();
+    }
+    return PyLong_FromSize_t(rank);
+}
+
+PyObject *
+py_bitmatrix_nullspace(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    BitMatrix *basis = gf2_nullspace(BM(self));
+    if (!basis) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitMatrix");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitmatrix_wrap_new(state->PyBitMatrixType, basis);
+}
+
+PyObject *
+py_bitmatrix_matmul(PyObject *oA, PyObject *oB)
+{
+    cbits_state *state = find_cbits_state_by_operands(oA, oB);
+    if (!state || !py_bitmatrix_check(oA, state) ||
+        !py_bitmatrix_check(oB, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (BM(oA)->n_cols != BM(oB)->n_rows) {
+        PyErr_Format(PyExc_ValueError,
+                     "shape mismatch: (%zu, %zu) @ (%zu, %zu)",
+                     BM(oA)->n_rows, BM(oA)->n_cols, BM(oB)->n_rows,
+                     BM(oB)->n_cols);
+        return NULL;
+    }
+    BitMatrix *res = gf2_mul(BM(oA), BM(oB));
+    if (!res) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitMatrix");
+        return NULL;
+    }
+    return bitmatrix_wrap_new(state->PyBitMatrixType, res);
+}
+
+#undef BM
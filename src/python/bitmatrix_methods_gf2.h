@@ -0,0 +1,71 @@
+/**
+ * @file bitmatrix_methods_gf2.h
+ * @brief GF(2) linear algebra Python methods for ``BitMatrix``.
+ *
+ * Declares the Python bindings for the native Method of Four Russians
+ * routines in \ref gf2.h: in-place elimination, rank, nullspace and the
+ * ``@`` matrix product.
+ *
+ * @see gf2.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BITMATRIX_METHODS_GF2_H
+#define CBITS_PY_BITMATRIX_METHODS_GF2_H
+
+#include "bitmatrix_object.h"
+
+/**
+ * @brief Python binding for ``BitMatrix.echelon(reduced=False)``.
+ *
+ * Transforms the matrix in place into (reduced) row echelon form.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval int Rank of the matrix.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitmatrix_echelon(PyObject *self, PyObject *args, PyObject *kwds);
+
+/**
+ * @brief Python binding for ``BitMatrix.rank()``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @retval int Rank over GF(2).
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitmatrix_rank(PyObject *self, PyObject *ignored);
+
+/**
+ * @brief Python binding for ``BitMatrix.nullspace()``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @retval object New ``BitMatrix`` whose rows span the nullspace.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitmatrix_nullspace(PyObject *self, PyObject *ignored);
+
+/**
+ * @brief Implement ``A @ B`` over GF(2).
+ *
+ * @param oA Left operand.
+ * @param oB Right operand.
+ * @retval object New ``BitMatrix`` product.
+ * @retval Py_NotImplemented if either operand is not a ``BitMatrix``.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitmatrix_matmul(PyObject *oA, PyObject *oB);
+
+#endif /* CBITS_PY_BITMATRIX_METHODS_GF2_H */
@@ -0,0 +1,959 @@
+/**
+ * @file bitmatrix_object.c
+ * @brief Implementation of the ``BitMatrix`` Python type and its row views.
+ *
+ * Exposes the row-major ``BitMatrix``: element access through ``m[r, c]``,
+ * rows through ``m[r]`` as ``BitVector`` views sharing the matrix memory,
+ * column gathers, transpose, and row/column counts and reductions. The
+ * GF(2) methods live in \ref bitmatrix_methods_gf2.c.
+ *
+ * A row view holds a strong reference to its matrix and bumps an export
+ * counter, so the matrix cannot be re-initialized while views exist.
+ *
+ * @see bitmatrix_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitmatrix_object.h"
+#include "bitmatrix_methods_gf2.h"
+#include "bitvector_parse.h"
+#include "bitvector_methods_memory.h"
+
+/**
+ * @brief ``__new__`` for ``BitMatrix``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_bm_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+          PyObject *Py_UNUSED(kwds))
+{
+    PyBitMatrixObject *self = (PyBitMatrixObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->m = NULL;
+    self->exports = 0;
+    return (PyObject *) self;
+}
+
+PyObject *
+bitmatrix_wrap_new(PyTypeObject *type, BitMatrix *m)
+{
+    assert(type != NULL);
+    assert(m != NULL);
+
+    PyObject *object = py_bm_new(type, NULL, NULL);
+    if (object == NULL) {
+        bm_free(m);
+        return NULL;
+    }
+    ((PyBitMatrixObject *) object)->m = m;
+    return object;
+}
+
+/**
+ * @brief ``__init__`` for ``BitMatrix(rows, cols)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bm_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t rows, cols;
+    static char *kwlist[] = {"rows", "cols", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "nn", kwlist, &rows,
+                                     &cols)) {
+        return -1;
+    }
+    if (rows < 0 || cols < 0) {
+        PyErr_SetString(PyExc_ValueError, "rows and cols must be >= 0");
+        return -1;
+    }
+    PyBitMatrixObject *obj = (PyBitMatrixObject *) self;
+    if (obj->exports > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot re-initialize a BitMatrix with row views");
+        return -1;
+    }
+    bm_free(obj->m);
+    obj->m = bm_new((size_t) rows, (size_t) cols);
+    if (!obj->m) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitMatrix");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_bm_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyBitMatrixObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bm_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyBitMatrixObject *self = (PyBitMatrixObject *) object;
+    bm_free(self->m);
+    self->m = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native matrix of a Python object. */
+#define BM(o) (((PyBitMatrixObject *) (o))->m)
+
+/**
+ * @brief Create a ``BitVector`` view of one row.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param r Row index (already validated).
+ * @retval object New row view.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_row_view(PyObject *self, size_t r)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    BitVector *row = bm_row_view(BM(self), r);
+    if (!row) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate row view");
+        return NULL;
+    }
+    PyTypeObject *type = state->PyBitMatrixRowType;
+    PyBitMatrixRowObject *view =
+        (PyBitMatrixRowObject *) type->tp_alloc(type, 0);
+    if (!view) {
+        return NULL;
+    }
+    view->base.bv = row;
+    view->base.hash_cache = -1;
+    view->matrix = Py_NewRef(self);
+    ((PyBitMatrixObject *) self)->exports++;
+    return (PyObject *) view;
+}
+
+/**
+ * @brief Parse a bitwise operator name.
+ *
+ * @param arg Python string ``"and"``, ``"or"`` or ``"xor"``.
+ * @param out Receives the operator.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bm_parse_op(PyObject *arg, BMOp *out)
+{
+    if (!PyUnicode_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "op must be a string");
+        return -1;
+    }
+    if (PyUnicode_CompareWithASCIIString(arg, "and") == 0) {
+        *out = BM_AND;
+    }
+    else if (PyUnicode_CompareWithASCIIString(arg, "or") == 0) {
+        *out = BM_OR;
+    }
+    else if (PyUnicode_CompareWithASCIIString(arg, "xor") == 0) {
+        *out = BM_XOR;
+    }
+    else {
+        PyErr_SetString(PyExc_ValueError,
+                        "op must be 'and', 'or' or 'xor'");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Parse an ``(r, c)`` key.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param key Tuple of two integers.
+ * @param r Receives the row.
+ * @param c Receives the column.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bm_parse_cell(PyObject *self, PyObject *key, size_t *r, size_t *c)
+{
+    if (PyTuple_GET_SIZE(key) != 2) {
+        PyErr_SetString(PyExc_TypeError,
+                        "BitMatrix indices must be m[row] or m[row, col]");
+        return -1;
+    }
+    const BitMatrix *m = BM(self);
+    if (cbits_parse_index(PyTuple_GET_ITEM(key, 0), m->n_rows, r) < 0 ||
+        cbits_parse_index(PyTuple_GET_ITEM(key, 1), m->n_cols, c) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Implement ``m[r]`` and ``m[r, c]``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param key Row index or ``(row, col)`` tuple.
+ * @retval object Row view or ``bool``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_subscript(PyObject *self, PyObject *key)
+{
+    size_t r, c;
+    if (PyTuple_Check(key)) {
+        if (py_bm_parse_cell(self, key, &r, &c) < 0) {
+            return NULL;
+        }
+        return PyBool_FromLong(bm_get(BM(self), r, c));
+    }
+    if (cbits_parse_index(key, BM(self)->n_rows, &r) < 0) {
+        return NULL;
+    }
+    return py_bm_row_view(self, r);
+}
+
+/**
+ * @brief Overwrite one row from a ``BitVector``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param r Row index (already validated).
+ * @param value Source ``BitVector``.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bm_assign_row(PyObject *self, size_t r, PyObject *value)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(value, state)) {
+        PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+        return -1;
+    }
+    if (bm_set_row(BM(self), r, ((PyBitVectorObject *) value)->bv) < 0) {
+        PyErr_SetString(PyExc_ValueError, "row length mismatch");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Implement ``m[r] = bv`` and ``m[r, c] = bit``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param key Row index or ``(row, col)`` tuple.
+ * @param value ``BitVector`` for a row, truth value for a cell.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bm_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
+{
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete BitMatrix items");
+        return -1;
+    }
+    size_t r, c;
+    if (PyTuple_Check(key)) {
+        if (py_bm_parse_cell(self, key, &r, &c) < 0) {
+            return -1;
+        }
+        int bit = PyObject_IsTrue(value);
+        if (bit < 0) {
+            return -1;
+        }
+        if (bit) {
+            bm_set(BM(self), r, c);
+        }
+        else {
+            bm_clear(BM(self), r, c);
+        }
+        return 0;
+    }
+    if (cbits_parse_index(key, BM(self)->n_rows, &r) < 0) {
+        return -1;
+    }
+    return py_bm_assign_row(self, r, value);
+}
+
+/**
+ * @brief Sequence item slot used for iteration over rows.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param i Row index.
+ * @retval object Row view.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= BM(self)->n_rows) {
+        PyErr_SetString(PyExc_IndexError, "BitMatrix index out of range");
+        return NULL;
+    }
+    return py_bm_row_view(self, (size_t) i);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.row(r)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param arg Row index.
+ * @retval object Row view.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_row(PyObject *self, PyObject *arg)
+{
+    size_t r;
+    if (cbits_parse_index(arg, BM(self)->n_rows, &r) < 0) {
+        return NULL;
+    }
+    return py_bm_row_view(self, r);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.set_row(r, bv)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param args Vector of arguments.
+ * @param nargs Number of arguments.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_set_row(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 2) {
+        PyErr_SetString(PyExc_TypeError, "set_row expects (row, bv)");
+        return NULL;
+    }
+    size_t r;
+    if (cbits_parse_index(args[0], BM(self)->n_rows, &r) < 0 ||
+        py_bm_assign_row(self, r, args[1]) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.row_op(dst, src, op)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param args Vector of arguments.
+ * @param nargs Number of arguments.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_row_op(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 3) {
+        PyErr_SetString(PyExc_TypeError, "row_op expects (dst, src, op)");
+        return NULL;
+    }
+    size_t dst, src;
+    BMOp op;
+    if (cbits_parse_index(args[0], BM(self)->n_rows, &dst) < 0 ||
+        cbits_parse_index(args[1], BM(self)->n_rows, &src) < 0 ||
+        py_bm_parse_op(args[2], &op) < 0) {
+        return NULL;
+    }
+    bm_row_op(BM(self), dst, src, op);
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.column(c)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param arg Column index.
+ * @retval object New ``BitVector`` with one bit per row.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_column(PyObject *self, PyObject *arg)
+{
+    size_t c;
+    if (cbits_parse_index(arg, BM(self)->n_cols, &c) < 0) {
+        return NULL;
+    }
+    BitVector *col = bm_column(BM(self), c);
+    if (!col) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, col);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.transpose()``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @retval object New ``BitMatrix``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_transpose(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    BitMatrix *t = bm_transpose(BM(self));
+    if (!t) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitMatrix");
+        return NULL;
+    }
+    return bitmatrix_wrap_new(Py_TYPE(self), t);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.copy()``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @retval object New ``BitMatrix``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_copy(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    BitMatrix *copy = bm_copy(BM(self));
+    if (!copy) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitMatrix");
+        return NULL;
+    }
+    return bitmatrix_wrap_new(Py_TYPE(self), copy);
+}
+
+/**
+ * @brief Convert an array of counts into a Python list.
+ *
+ * @param counts Counts (freed by this function).
+ * @param n Number of counts.
+ * @retval list New list of integers.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_counts_to_list(size_t *counts, size_t n)
+{
+    PyObject *list = PyList_New((Py_ssize_t) n);
+    for (size_t i = 0; list && i < n; ++i) {
+        PyObject *item = PyLong_FromSize_t(counts[i]);
+        if (!item) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, (Py_ssize_t) i, item);
+    }
+    PyMem_Free(counts);
+    return list;
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.row_counts()``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @retval list Set bits per row.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_row_counts(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    const size_t n = BM(self)->n_rows;
+    size_t *counts = PyMem_Malloc((n ? n : 1) * sizeof(size_t));
+    if (!counts) {
+        return PyErr_NoMemory();
+    }
+    bm_row_popcount(BM(self), counts);
+    return py_bm_counts_to_list(counts, n);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.column_counts()``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @retval list Set bits per column.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_column_counts(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    const size_t n = BM(self)->n_cols;
+    size_t *counts = PyMem_Malloc((n ? n : 1) * sizeof(size_t));
+    if (!counts) {
+        return PyErr_NoMemory();
+    }
+    bm_col_popcount(BM(self), counts);
+    return py_bm_counts_to_list(counts, n);
+}
+
+/**
+ * @brief Shared body of ``reduce_rows`` and ``reduce_columns``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param arg Operator name.
+ * @param reduce Native reduction.
+ * @retval object New ``BitVector``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_reduce(PyObject *self, PyObject *arg,
+             BitVector *(*reduce)(const BitMatrix *, BMOp))
+{
+    BMOp op;
+    if (py_bm_parse_op(arg, &op) < 0) {
+        return NULL;
+    }
+    BitVector *res = reduce(BM(self), op);
+    if (!res) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, res);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.reduce_rows(op)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param arg Operator name.
+ * @return New ``BitVector`` of ``cols`` bits, ``NULL`` on error.
+ */
+static PyObject *
+py_bm_reduce_rows(PyObject *self, PyObject *arg)
+{
+    return py_bm_reduce(self, arg, bm_reduce_rows);
+}
+
+/**
+ * @brief Python binding for ``BitMatrix.reduce_columns(op)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param arg Operator name.
+ * @return New ``BitVector`` of ``rows`` bits, ``NULL`` on error.
+ */
+static PyObject *
+py_bm_reduce_columns(PyObject *self, PyObject *arg)
+{
+    return py_bm_reduce(self, arg, bm_reduce_cols);
+}
+
+/**
+ * @brief Python binding for the ``BitMatrix.from_rows(rows)`` classmethod.
+ *
+ * @param type The class the method was called on.
+ * @param arg Iterable of equally long ``BitVector`` objects.
+ * @retval object New ``BitMatrix`` on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bm_from_rows(PyObject *type, PyObject *arg)
+{
+    cbits_state *state = find_cbits_state_by_type((PyTypeObject *) type);
+    PyObject *seq = PySequence_Fast(arg, "expected an iterable of BitVector");
+    if (!seq) {
+        return NULL;
+    }
+    const Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    size_t cols = 0;
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        if (!py_bitvector_check(items[i], state)) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+            return NULL;
+        }
+        size_t len = ((PyBitVectorObject *) items[i])->bv->n_bits;
+        if (i == 0) {
+            cols = len;
+        }
+        else if (len != cols) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_ValueError, "row length mismatch");
+            return NULL;
+        }
+    }
+    BitMatrix *m = bm_new((size_t) n, cols);
+    if (!m) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitMatrix");
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        bm_set_row(m, (size_t) i, ((PyBitVectorObject *) items[i])->bv);
+    }
+    Py_DECREF(seq);
+    return bitmatrix_wrap_new((PyTypeObject *) type, m);
+}
+
+/**
+ * @brief Implement ``BitMatrix.__sizeof__``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_bm_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total =
+        (size_t) Py_TYPE(self)->tp_basicsize + bm_memory_usage(BM(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Rich comparison (``==`` and ``!=`` only).
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @param op Comparison operator.
+ * @return ``True``/``False`` or ``NotImplemented``.
+ */
+static PyObject *
+py_bm_richcompare(PyObject *a, PyObject *b, int op)
+{
+    if (op != Py_EQ && op != Py_NE) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(a));
+    if (!py_bitmatrix_check(b, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    bool eq = bm_equal(BM(a), BM(b));
+    return PyBool_FromLong((op == Py_EQ) == eq);
+}
+
+/**
+ * @brief Implement ``len(BitMatrix)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @return Number of rows.
+ */
+static Py_ssize_t
+py_bm_len(PyObject *self)
+{
+    return (Py_ssize_t) BM(self)->n_rows;
+}
+
+/**
+ * @brief Implement ``repr(BitMatrix)``.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_bm_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat("<cbits.BitMatrix object at %p shape=(%zu, "
+                                "%zu)>",
+                                self, BM(self)->n_rows, BM(self)->n_cols);
+}
+
+/**
+ * @brief Getter for the read-only ``shape`` property.
+ *
+ * @param self A ``PyBitMatrixObject`` instance.
+ * @param closure Unused.
+ * @return Tuple ``(rows, cols)``.
+ */
+static PyObject *
+py_bm_get_shape(PyObject *self, void *Py_UNUSED(closure))
+{
+    return Py_BuildValue("(nn)", (Py_ssize_t) BM(self)->n_rows,
+                         (Py_ssize_t) BM(self)->n_cols);
+}
+
+#undef BM
+
+/** @brief Docstring for ``BitMatrix.row``. */
+PyDoc_STRVAR(py_bm_row__doc__,
+             "row(r: int) -> BitVector\n"
+             "\n"
+             "Return row r as a BitVector view; writes to it change the "
+             "matrix. Same as m[r].");
+/** @brief Docstring for ``BitMatrix.set_row``. */
+PyDoc_STRVAR(py_bm_set_row__doc__,
+             "set_row(r: int, bv: BitVector) -> None\n"
+             "\n"
+             "Overwrite row r with the bits of bv. Same as m[r] = bv.");
+/** @brief Docstring for ``BitMatrix.row_op``. */
+PyDoc_STRVAR(py_bm_row_op__doc__,
+             "row_op(dst: int, src: int, op: str) -> None\n"
+             "\n"
+             "Combine row src into row dst in place with op ('and', 'or' or "
+             "'xor').");
+/** @brief Docstring for ``BitMatrix.column``. */
+PyDoc_STRVAR(py_bm_column__doc__,
+             "column(c: int) -> BitVector\n"
+             "\n"
+             "Return a copy of column c with one bit per row.");
+/** @brief Docstring for ``BitMatrix.transpose``. */
+PyDoc_STRVAR(py_bm_transpose__doc__,
+             "transpose() -> BitMatrix\n"
+             "\n"
+             "Return the transposed matrix, built from 64x64 tiles.");
+/** @brief Docstring for ``BitMatrix.reduce_rows``. */
+PyDoc_STRVAR(py_bm_reduce_rows__doc__,
+             "reduce_rows(op: str) -> BitVector\n"
+             "\n"
+             "Fold all rows into one row of cols bits with op ('and', 'or' "
+             "or 'xor').");
+/** @brief Docstring for ``BitMatrix.reduce_columns``. */
+PyDoc_STRVAR(py_bm_reduce_columns__doc__,
+             "reduce_columns(op: str) -> BitVector\n"
+             "\n"
+             "Fold every row into a single bit with op ('and', 'or' or "
+             "'xor'), giving one bit per row.");
+/** @brief Docstring for ``BitMatrix.echelon``. */
+PyDoc_STRVAR(py_bm_echelon__doc__,
+             "echelon(reduced: bool = False) -> int\n"
+             "\n"
+             "Bring the matrix into row echelon form over GF(2) in place and "
+             "return its rank. With reduced=True the result is the reduced "
+             "row echelon form.");
+/** @brief Docstring for ``BitMatrix.nullspace``. */
+PyDoc_STRVAR(py_bm_nullspace__doc__,
+             "nullspace() -> BitMatrix\n"
+             "\n"
+             "Return a matrix whose rows form a basis of {x : m @ x = 0} "
+             "over GF(2).");
+/** @brief Docstring for ``BitMatrix.from_rows``. */
+PyDoc_STRVAR(py_bm_from_rows__doc__,
+             "from_rows(rows: Iterable[BitVector]) -> BitMatrix\n"
+             "\n"
+             "Build a matrix from equally long BitVectors.");
+
+/**
+ * @brief Method table for the BitMatrix type.
+ */
+static PyMethodDef PyBitMatrix_methods[] = {
+    {"row", (PyCFunction) py_bm_row, METH_O, py_bm_row__doc__},
+    {"set_row", (PyCFunction) (void (*)(void)) py_bm_set_row, METH_FASTCALL,
+     py_bm_set_row__doc__},
+    {"row_op", (PyCFunction) (void (*)(void)) py_bm_row_op, METH_FASTCALL,
+     py_bm_row_op__doc__},
+    {"column", (PyCFunction) py_bm_column, METH_O, py_bm_column__doc__},
+    {"transpose", (PyCFunction) py_bm_transpose, METH_NOARGS,
+     py_bm_transpose__doc__},
+    {"row_counts", (PyCFunction) py_bm_row_counts, METH_NOARGS,
+     PyDoc_STR("row_counts() -> list[int]\n\n"
+               "Return the number of set bits in every row.")},
+    {"column_counts", (PyCFunction) py_bm_column_counts, METH_NOARGS,
+     PyDoc_STR("column_counts() -> list[int]\n\n"
+               "Return the number of set bits in every column.")},
+    {"reduce_rows", (PyCFunction) py_bm_reduce_rows, METH_O,
+     py_bm_reduce_rows__doc__},
+    {"reduce_columns", (PyCFunction) py_bm_reduce_columns, METH_O,
+     py_bm_reduce_columns__doc__},
+    {"echelon", (PyCFunction) (void (*)(void)) py_bitmatrix_echelon,
+     METH_VARARGS | METH_KEYWORDS, py_bm_echelon__doc__},
+    {"rank", (PyCFunction) py_bitmatrix_rank, METH_NOARGS,
+     PyDoc_STR("rank() -> int\n\nReturn the rank over GF(2).")},
+    {"nullspace", (PyCFunction) py_bitmatrix_nullspace, METH_NOARGS,
+     py_bm_nullspace__doc__},
+    {"copy", (PyCFunction) py_bm_copy, METH_NOARGS,
+     PyDoc_STR("copy() -> BitMatrix\n\nReturn a deep copy.")},
+    {"from_rows", (PyCFunction) py_bm_from_rows, METH_O | METH_CLASS,
+     py_bm_from_rows__doc__},
+    {"__sizeof__", (PyCFunction) py_bm_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the BitMatrix type.
+ */
+static PyGetSetDef PyBitMatrix_getset[] = {
+    {"shape", py_bm_get_shape, NULL,
+     PyDoc_STR("Tuple (rows, cols) of the matrix dimensions.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``BitMatrix`` type. */
+PyDoc_STRVAR(
+    PyBitMatrix__doc__,
+    "BitMatrix(rows: int, cols: int)\n"
+    "\n"
+    "A fixed-size, row-major 2D bit array.\n\n"
+    "Every row is stored cache-line aligned in one contiguous block. m[r, c] "
+    "reads or writes one bit; m[r] returns the row as a BitVector view that "
+    "shares the matrix memory, and iterating yields the row views.\n\n"
+    "echelon, rank, nullspace and the @ operator work over GF(2).\n\n"
+    "Parameters\n"
+    "----------\n"
+    "rows : int\n"
+    "   Number of rows.\n"
+    "cols : int\n"
+    "   Number of bits per row.\n");
+
+/**
+ * @brief Slot table for the ``BitMatrix`` type.
+ */
+static PyType_Slot PyBitMatrix_slots[] = {
+    {Py_tp_doc, (void *) PyBitMatrix__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bm_new},
+    {Py_tp_init, py_bm_init},
+    {Py_tp_traverse, py_bm_traverse},
+    {Py_tp_dealloc, py_bm_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBitMatrix_methods},
+    {Py_tp_getset, PyBitMatrix_getset},
+    {Py_tp_repr, py_bm_repr},
+    {Py_tp_richcompare, py_bm_richcompare},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+
+    {Py_sq_length, py_bm_len},
+    {Py_sq_item, py_bm_item},
+    {Py_mp_length, py_bm_len},
+    {Py_mp_subscript, py_bm_subscript},
+    {Py_mp_ass_subscript, py_bm_ass_subscript},
+
+    {Py_nb_matrix_multiply, py_bitmatrix_matmul},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``BitMatrix``.
+ */
+PyType_Spec PyBitMatrix_spec = {
+    .name = "cbits.BitMatrix",
+    .basicsize = sizeof(PyBitMatrixObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBitMatrix_slots,
+};
+
+/**
+ * @brief GC traverse callback for row views.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_bm_row_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(((PyBitMatrixRowObject *) self)->matrix);
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a row view.
+ *
+ * Detaches the borrowed row header so the ``BitVector`` deallocator does
+ * not free matrix memory, then releases the matrix.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bm_row_dealloc(PyObject *object)
+{
+    PyObject_GC_UnTrack(object);
+    PyBitMatrixRowObject *self = (PyBitMatrixRowObject *) object;
+    self->base.bv = NULL;
+    if (self->matrix) {
+        ((PyBitMatrixObject *) self->matrix)->exports--;
+        Py_CLEAR(self->matrix);
+    }
+    Py_TYPE(object)->tp_base->tp_dealloc(object);
+}
+
+/**
+ * @brief Implement ``__sizeof__`` for a row view.
+ *
+ * The row words, header and rank tables belong to the matrix and are
+ * counted by ``BitMatrix.__sizeof__``.
+ *
+ * @param self Row view.
+ * @param ignored Unused.
+ * @return Size of the view object in bytes.
+ */
+static PyObject *
+py_bm_row_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyLong_FromSize_t(bitvector_owned_bytes(self, 1));
+}
+
+/**
+ * @brief Implement ``memory_usage`` for a row view.
+ *
+ * @param self Row view.
+ * @param ignored Unused.
+ * @return Breakdown with ``shared`` set.
+ */
+static PyObject *
+py_bm_row_memory_usage(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return bitvector_memory_report(self, 1);
+}
+
+/**
+ * @brief Method table for the row view type.
+ */
+static PyMethodDef PyBitMatrixRow_methods[] = {
+    {"__sizeof__", (PyCFunction) py_bm_row_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize of the view, in bytes.")},
+    {"memory_usage", (PyCFunction) py_bm_row_memory_usage, METH_NOARGS,
+     PyDoc_STR("memory_usage() -> dict[str, int | bool]\n\n"
+               "Breakdown of the row; shared, since the matrix owns it.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Slot table for the row view type.
+ */
+static PyType_Slot PyBitMatrixRow_slots[] = {
+    {Py_tp_doc, PyDoc_STR("BitVector view of one BitMatrix row.")},
+    {Py_tp_traverse, py_bm_row_traverse},
+    {Py_tp_dealloc, py_bm_row_dealloc},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+    {Py_tp_methods, PyBitMatrixRow_methods},
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for the row view (a ``BitVector`` subclass).
+ */
+PyType_Spec PyBitMatrixRow_spec = {
+    .name = "cbits._BitMatrixRow",
+    .basicsize = sizeof(PyBitMatrixRowObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE |
+             Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots = PyBitMatrixRow_slots,
+};
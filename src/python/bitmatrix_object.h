@@ -0,0 +1,58 @@
+/**
+ * @file bitmatrix_object.h
+ * @brief Definition of the ``BitMatrix`` Python type.
+ *
+ * Declares the Python wrapper for the native row-major ``BitMatrix``:
+ * - \ref PyBitMatrixObject - the Python object structure
+ * - \ref PyBitMatrixRowObject - a ``BitVector`` view of one matrix row
+ * - the type specifications used to create both Python types
+ * - ``bitmatrix_wrap_new`` - helper for constructing wrappers
+ *
+ * @see bitmatrix.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BITMATRIX_OBJECT_H
+#define CBITS_PY_BITMATRIX_OBJECT_H
+
+#include "bitmatrix.h"
+#include "bitvector_object.h"
+
+/**
+ * @brief Python object wrapping a native ``BitMatrix`` instance.
+ */
+typedef struct {
+    PyObject_HEAD BitMatrix *m; /**< Underlying matrix */
+    Py_ssize_t exports;         /**< Number of live row views */
+} PyBitMatrixObject;
+
+/**
+ * @brief ``BitVector`` subclass that borrows one row of a ``BitMatrix``.
+ *
+ * @c base.bv points at the row header owned by the matrix, so reads and
+ * writes go straight to the matrix memory. The view keeps the matrix alive
+ * and is unhashable because the bits can change under it.
+ */
+typedef struct {
+    PyBitVectorObject base; /**< BitVector part; @c bv is borrowed */
+    PyObject *matrix;       /**< Owning ``BitMatrix`` */
+} PyBitMatrixRowObject;
+
+extern PyType_Spec PyBitMatrix_spec;
+extern PyType_Spec PyBitMatrixRow_spec;
+
+/**
+ * @brief Wrap a native BitMatrix in a new Python object.
+ *
+ * @param type The ``PyTypeObject`` representing the BitMatrix type.
+ * @param m Pointer to an already-allocated native matrix.
+ * @retval new_object A new reference on success.
+ * @retval NULL on allocation failure (``m`` is freed).
+ *
+ * @note The caller transfers ownership of ``m`` to the returned object.
+ */
+PyObject *
+bitmatrix_wrap_new(PyTypeObject *type, BitMatrix *m);
+
+#endif /* CBITS_PY_BITMATRIX_OBJECT_H */
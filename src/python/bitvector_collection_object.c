@@ -0,0 +1,699 @@
+/**
+ * @file bitvector_collection_object.c
+ * @brief Implementation of the ``BitVectorCollection`` Python type.
+ *
+ * Exposes a growable, packed collection of equally long bit vectors with
+ * Hamming distance searches: ``distances``, ``knn``, ``within_radius`` and
+ * the all-pairs ``pairwise`` matrix. Searches copy the query, release the
+ * GIL and optionally spread the scan over several threads.
+ *
+ * @see bitvector_collection_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitvector_collection_object.h"
+
+/**
+ * @brief ``__new__`` for ``BitVectorCollection``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_bvc_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+           PyObject *Py_UNUSED(kwds))
+{
+    PyBitVectorCollectionObject *self =
+        (PyBitVectorCollectionObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->c = NULL;
+    self->searches = 0;
+    return (PyObject *) self;
+}
+
+/** @brief Shorthand for the native collection of a Python object. */
+#define BVC(o) (((PyBitVectorCollectionObject *) (o))->c)
+
+/**
+ * @brief Raise ``BufferError`` if a search is running on the collection.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @retval 0 The collection may be modified.
+ * @retval -1 A search is running (exception set).
+ */
+static int
+py_bvc_check_idle(PyObject *self)
+{
+    if (((PyBitVectorCollectionObject *) self)->searches > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot modify a BitVectorCollection during a "
+                        "search");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Append every ``BitVector`` of an iterable to a native collection.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance (for the state).
+ * @param c Target collection.
+ * @param iterable Iterable of ``BitVector`` objects.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set); earlier items stay appended.
+ */
+static int
+py_bvc_extend_native(PyObject *self, BitVectorCollection *c,
+                     PyObject *iterable)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    PyObject *seq =
+        PySequence_Fast(iterable, "expected an iterable of BitVector");
+    if (!seq) {
+        return -1;
+    }
+    const Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    int rc = -1;
+    if (bvc_reserve(c, c->size + (size_t) n) < 0) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate BitVectorCollection");
+        goto done;
+    }
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        if (!py_bitvector_check(items[i], state)) {
+            PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+            goto done;
+        }
+        const BitVector *bv = ((PyBitVectorObject *) items[i])->bv;
+        if (bv->n_bits != c->n_bits) {
+            PyErr_Format(PyExc_ValueError,
+                         "expected a BitVector of %zu bits, got %zu",
+                         c->n_bits, bv->n_bits);
+            goto done;
+        }
+        bvc_append(c, bv);
+    }
+    rc = 0;
+done:
+    Py_DECREF(seq);
+    return rc;
+}
+
+/**
+ * @brief ``__init__`` for ``BitVectorCollection(width, vectors=())``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bvc_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t width;
+    PyObject *vectors = NULL;
+    static char *kwlist[] = {"width", "vectors", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|O", kwlist, &width,
+                                     &vectors)) {
+        return -1;
+    }
+    if (width < 0) {
+        PyErr_SetString(PyExc_ValueError, "width must be >= 0");
+        return -1;
+    }
+    if (py_bvc_check_idle(self) < 0) {
+        return -1;
+    }
+    BitVectorCollection *c = bvc_new((size_t) width);
+    if (!c) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate BitVectorCollection");
+        return -1;
+    }
+    if (vectors && py_bvc_extend_native(self, c, vectors) < 0) {
+        bvc_free(c);
+        return -1;
+    }
+    bvc_free(BVC(self));
+    BVC(self) = c;
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_bvc_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyBitVectorCollectionObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bvc_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    bvc_free(BVC(object));
+    BVC(object) = NULL;
+    type->tp_free(object);
+    Py_DECREF(type);
+}
+
+/**
+ * @brief Python binding for ``BitVectorCollection.append(bv)``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param arg ``BitVector`` of ``width`` bits.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_append(PyObject *self, PyObject *arg)
+{
+    if (py_bvc_check_idle(self) < 0) {
+        return NULL;
+    }
+    PyObject *one = PyTuple_Pack(1, arg);
+    if (!one) {
+        return NULL;
+    }
+    int rc = py_bvc_extend_native(self, BVC(self), one);
+    Py_DECREF(one);
+    if (rc < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Python binding for ``BitVectorCollection.extend(iterable)``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param arg Iterable of ``BitVector`` objects.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_extend(PyObject *self, PyObject *arg)
+{
+    if (py_bvc_check_idle(self) < 0 ||
+        py_bvc_extend_native(self, BVC(self), arg) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Copy a query ``BitVector`` after checking its width.
+ *
+ * The copy keeps the search safe if the caller's vector is modified or
+ * re-initialized by another thread while the GIL is released.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param arg Candidate query.
+ * @retval BitVector* Private copy of the query.
+ * @retval NULL on failure (exception set).
+ */
+static BitVector *
+py_bvc_copy_query(PyObject *self, PyObject *arg)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(arg, state)) {
+        PyErr_SetString(PyExc_TypeError, "query must be a BitVector");
+        return NULL;
+    }
+    const BitVector *bv = ((PyBitVectorObject *) arg)->bv;
+    if (bv->n_bits != BVC(self)->n_bits) {
+        PyErr_Format(PyExc_ValueError,
+                     "expected a BitVector of %zu bits, got %zu",
+                     BVC(self)->n_bits, bv->n_bits);
+        return NULL;
+    }
+    BitVector *copy = bv_copy(bv);
+    if (!copy) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+    }
+    return copy;
+}
+
+/**
+ * @brief Convert search hits into a list of ``(index, distance)`` tuples.
+ *
+ * @param hits Matches.
+ * @param n Number of matches.
+ * @retval list New list.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_matches_to_list(const BVCMatch *hits, size_t n)
+{
+    PyObject *list = PyList_New((Py_ssize_t) n);
+    for (size_t i = 0; list && i < n; ++i) {
+        PyObject *item = Py_BuildValue("(nn)", (Py_ssize_t) hits[i].index,
+                                       (Py_ssize_t) hits[i].distance);
+        if (!item) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, (Py_ssize_t) i, item);
+    }
+    return list;
+}
+
+/**
+ * @brief Convert distances into a list of integers.
+ *
+ * @param dist Distances.
+ * @param n Number of distances.
+ * @retval list New list.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_distances_to_list(const uint32_t *dist, size_t n)
+{
+    PyObject *list = PyList_New((Py_ssize_t) n);
+    for (size_t i = 0; list && i < n; ++i) {
+        PyObject *item = PyLong_FromUnsignedLong(dist[i]);
+        if (!item) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, (Py_ssize_t) i, item);
+    }
+    return list;
+}
+
+/**
+ * @brief Python binding for ``BitVectorCollection.distances``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval list Distance to every stored vector.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_distances(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *arg;
+    unsigned int threads = 1;
+    static char *kwlist[] = {"query", "threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|I", kwlist, &arg,
+                                     &threads)) {
+        return NULL;
+    }
+    BitVector *query = py_bvc_copy_query(self, arg);
+    if (!query) {
+        return NULL;
+    }
+    const BitVectorCollection *c = BVC(self);
+    uint32_t *dist = PyMem_Malloc((c->size ? c->size : 1) * sizeof(uint32_t));
+    if (!dist) {
+        bv_free(query);
+        return PyErr_NoMemory();
+    }
+    ((PyBitVectorCollectionObject *) self)->searches++;
+    Py_BEGIN_ALLOW_THREADS
+    bvc_distances(c, query, dist, threads);
+    Py_END_ALLOW_THREADS
+    ((PyBitVectorCollectionObject *) self)->searches--;
+    bv_free(query);
+    PyObject *list = py_bvc_distances_to_list(dist, c->size);
+    PyMem_Free(dist);
+    return list;
+}
+
+/**
+ * @brief Python binding for ``BitVectorCollection.knn``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval list ``(index, distance)`` tuples, nearest first.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_knn(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *arg;
+    Py_ssize_t k;
+    unsigned int threads = 1;
+    static char *kwlist[] = {"query", "k", "threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On|I", kwlist, &arg, &k,
+                                     &threads)) {
+        return NULL;
+    }
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "k must be >= 0");
+        return NULL;
+    }
+    BitVector *query = py_bvc_copy_query(self, arg);
+    if (!query) {
+        return NULL;
+    }
+    const BitVectorCollection *c = BVC(self);
+    const size_t want = (size_t) k < c->size ? (size_t) k : c->size;
+    BVCMatch *hits = PyMem_Malloc((want ? want : 1) * sizeof(BVCMatch));
+    if (!hits) {
+        bv_free(query);
+        return PyErr_NoMemory();
+    }
+    size_t n;
+    ((PyBitVectorCollectionObject *) self)->searches++;
+    Py_BEGIN_ALLOW_THREADS
+    n = bvc_knn(c, query, want, hits, threads);
+    Py_END_ALLOW_THREADS
+    ((PyBitVectorCollectionObject *) self)->searches--;
+    bv_free(query);
+    PyObject *list = NULL;
+    if (n == SIZE_MAX) {
+        PyErr_NoMemory();
+    }
+    else {
+        list = py_bvc_matches_to_list(hits, n);
+    }
+    PyMem_Free(hits);
+    return list;
+}
+
+/**
+ * @brief Python binding for ``BitVectorCollection.within_radius``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval list ``(index, distance)`` tuples in index order.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_within_radius(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *arg;
+    Py_ssize_t radius;
+    unsigned int threads = 1;
+    static char *kwlist[] = {"query", "radius", "threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On|I", kwlist, &arg,
+                                     &radius, &threads)) {
+        return NULL;
+    }
+    if (radius < 0) {
+        PyErr_SetString(PyExc_ValueError, "radius must be >= 0");
+        return NULL;
+    }
+    BitVector *query = py_bvc_copy_query(self, arg);
+    if (!query) {
+        return NULL;
+    }
+    BVCMatch *hits;
+    size_t n;
+    ((PyBitVectorCollectionObject *) self)->searches++;
+    Py_BEGIN_ALLOW_THREADS
+    hits = bvc_within_radius(BVC(self), query, (size_t) radius, &n, threads);
+    Py_END_ALLOW_THREADS
+    ((PyBitVectorCollectionObject *) self)->searches--;
+    bv_free(query);
+    if (!hits) {
+        return PyErr_NoMemory();
+    }
+    PyObject *list = py_bvc_matches_to_list(hits, n);
+    free(hits);
+    return list;
+}
+
+/**
+ * @brief Python binding for ``BitVectorCollection.pairwise``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval list One list of distances per stored vector.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_pairwise(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *other = Py_None;
+    unsigned int threads = 1;
+    static char *kwlist[] = {"other", "threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OI", kwlist, &other,
+                                     &threads)) {
+        return NULL;
+    }
+    if (other == Py_None) {
+        other = self;
+    }
+    else if (!PyObject_TypeCheck(other, Py_TYPE(self))) {
+        PyErr_SetString(PyExc_TypeError,
+                        "other must be a BitVectorCollection");
+        return NULL;
+    }
+    const BitVectorCollection *a = BVC(self), *b = BVC(other);
+    if (a->n_bits != b->n_bits) {
+        PyErr_Format(PyExc_ValueError, "width mismatch: %zu vs %zu",
+                     a->n_bits, b->n_bits);
+        return NULL;
+    }
+    if (b->size && a->size > PY_SSIZE_T_MAX / sizeof(uint32_t) / b->size) {
+        return PyErr_NoMemory();
+    }
+    const size_t total = a->size * b->size;
+    uint32_t *dist = PyMem_Malloc((total ? total : 1) * sizeof(uint32_t));
+    if (!dist) {
+        return PyErr_NoMemory();
+    }
+    ((PyBitVectorCollectionObject *) self)->searches++;
+    ((PyBitVectorCollectionObject *) other)->searches++;
+    Py_BEGIN_ALLOW_THREADS
+    bvc_pairwise(a, b, dist, threads);
+    Py_END_ALLOW_THREADS
+    ((PyBitVectorCollectionObject *) other)->searches--;
+    ((PyBitVectorCollectionObject *) self)->searches--;
+
+    PyObject *rows = PyList_New((Py_ssize_t) a->size);
+    for (size_t i = 0; rows && i < a->size; ++i) {
+        PyObject *row = py_bvc_distances_to_list(dist + i * b->size, b->size);
+        if (!row) {
+            Py_CLEAR(rows);
+            break;
+        }
+        PyList_SET_ITEM(rows, (Py_ssize_t) i, row);
+    }
+    PyMem_Free(dist);
+    return rows;
+}
+
+/**
+ * @brief Implement ``BitVectorCollection.__sizeof__``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_bvc_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total =
+        (size_t) Py_TYPE(self)->tp_basicsize + bvc_memory_usage(BVC(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``len(BitVectorCollection)``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @return Number of stored vectors.
+ */
+static Py_ssize_t
+py_bvc_len(PyObject *self)
+{
+    return (Py_ssize_t) BVC(self)->size;
+}
+
+/**
+ * @brief Sequence item access; returns a copy of one stored vector.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @retval object New ``BitVector``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bvc_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= BVC(self)->size) {
+        PyErr_SetString(PyExc_IndexError,
+                        "BitVectorCollection index out of range");
+        return NULL;
+    }
+    BitVector *bv = bvc_get(BVC(self), (size_t) i);
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Implement ``repr(BitVectorCollection)``.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_bvc_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat(
+        "<cbits.BitVectorCollection object at %p width=%zu size=%zu>", self,
+        BVC(self)->n_bits, BVC(self)->size);
+}
+
+/**
+ * @brief Getter for the read-only ``width`` property.
+ *
+ * @param self A ``PyBitVectorCollectionObject`` instance.
+ * @param closure Unused.
+ * @return Bits per stored vector.
+ */
+static PyObject *
+py_bvc_get_width(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(BVC(self)->n_bits);
+}
+
+#undef BVC
+
+/** @brief Docstring for ``BitVectorCollection.distances``. */
+PyDoc_STRVAR(py_bvc_distances__doc__,
+             "distances(query: BitVector, threads: int = 1) -> list[int]\n"
+             "\n"
+             "Return the Hamming distance from query to every stored "
+             "vector.");
+/** @brief Docstring for ``BitVectorCollection.knn``. */
+PyDoc_STRVAR(py_bvc_knn__doc__,
+             "knn(query: BitVector, k: int, threads: int = 1) "
+             "-> list[tuple[int, int]]\n"
+             "\n"
+             "Return the k stored vectors closest to query as (index, "
+             "distance) pairs, nearest first; ties go to the smaller "
+             "index.");
+/** @brief Docstring for ``BitVectorCollection.within_radius``. */
+PyDoc_STRVAR(py_bvc_within_radius__doc__,
+             "within_radius(query: BitVector, radius: int, threads: int = 1) "
+             "-> list[tuple[int, int]]\n"
+             "\n"
+             "Return every stored vector at Hamming distance <= radius as "
+             "(index, distance) pairs in index order.");
+/** @brief Docstring for ``BitVectorCollection.pairwise``. */
+PyDoc_STRVAR(py_bvc_pairwise__doc__,
+             "pairwise(other: BitVectorCollection | None = None, "
+             "threads: int = 1) -> list[list[int]]\n"
+             "\n"
+             "Return the matrix of Hamming distances between every vector of "
+             "this collection (rows) and every vector of other (columns); "
+             "other defaults to this collection.");
+
+/**
+ * @brief Method table for the BitVectorCollection type.
+ */
+static PyMethodDef PyBitVectorCollection_methods[] = {
+    {"append", (PyCFunction) py_bvc_append, METH_O,
+     PyDoc_STR("append(bv: BitVector) -> None\n\n"
+               "Append a copy of a BitVector of width bits.")},
+    {"extend", (PyCFunction) py_bvc_extend, METH_O,
+     PyDoc_STR("extend(vectors: Iterable[BitVector]) -> None\n\n"
+               "Append copies of several BitVectors.")},
+    {"distances", (PyCFunction) (void (*)(void)) py_bvc_distances,
+     METH_VARARGS | METH_KEYWORDS, py_bvc_distances__doc__},
+    {"knn", (PyCFunction) (void (*)(void)) py_bvc_knn,
+     METH_VARARGS | METH_KEYWORDS, py_bvc_knn__doc__},
+    {"within_radius", (PyCFunction) (void (*)(void)) py_bvc_within_radius,
+     METH_VARARGS | METH_KEYWORDS, py_bvc_within_radius__doc__},
+    {"pairwise", (PyCFunction) (void (*)(void)) py_bvc_pairwise,
+     METH_VARARGS | METH_KEYWORDS, py_bvc_pairwise__doc__},
+    {"__sizeof__", (PyCFunction) py_bvc_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the BitVectorCollection type.
+ */
+static PyGetSetDef PyBitVectorCollection_getset[] = {
+    {"width", py_bvc_get_width, NULL,
+     PyDoc_STR("Number of bits of every stored vector.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``BitVectorCollection`` type. */
+PyDoc_STRVAR(
+    PyBitVectorCollection__doc__,
+    "BitVectorCollection(width: int, vectors: Iterable[BitVector] = ())\n"
+    "\n"
+    "A growable collection of equally long bit vectors for similarity "
+    "search.\n\n"
+    "The vectors are packed back to back in one aligned block, and every "
+    "search XORs the query into each stored vector and counts the result "
+    "with the fastest popcount kernel of the CPU, without creating "
+    "intermediate objects. Searches release the GIL; threads=0 uses one "
+    "thread per processor for large collections. c[i] returns a copy of "
+    "the i-th vector.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "width : int\n"
+    "   Number of bits of every vector.\n"
+    "vectors : Iterable[BitVector], optional\n"
+    "   Initial contents.\n");
+
+/**
+ * @brief Slot table for the ``BitVectorCollection`` type.
+ */
+static PyType_Slot PyBitVectorCollection_slots[] = {
+    {Py_tp_doc, (void *) PyBitVectorCollection__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bvc_new},
+    {Py_tp_init, py_bvc_init},
+    {Py_tp_traverse, py_bvc_traverse},
+    {Py_tp_dealloc, py_bvc_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBitVectorCollection_methods},
+    {Py_tp_getset, PyBitVectorCollection_getset},
+    {Py_tp_repr, py_bvc_repr},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+
+    {Py_sq_length, py_bvc_len},
+    {Py_sq_item, py_bvc_item},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``BitVectorCollection``.
+ */
+PyType_Spec PyBitVectorCollection_spec = {
+    .name = "cbits.BitVectorCollection",
+    .basicsize = sizeof(PyBitVectorCollectionObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBitVectorCollection_slots,
+};
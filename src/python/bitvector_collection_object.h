@@ -0,0 +1,34 @@
+/**
+ * @file bitvector_collection_object.h
+ * @brief Definition of the ``BitVectorCollection`` Python type.
+ *
+ * Declares the Python wrapper for the packed collection of equally long
+ * bit vectors:
+ * - \ref PyBitVectorCollectionObject - the Python object structure
+ * - the type specification used to create the Python type
+ *
+ * @see bitvector_collection.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BITVECTOR_COLLECTION_OBJECT_H
+#define CBITS_PY_BITVECTOR_COLLECTION_OBJECT_H
+
+#include "bitvector_collection.h"
+#include "bitvector_object.h"
+
+/**
+ * @brief Python object wrapping a native ``BitVectorCollection``.
+ *
+ * Searches run without the GIL; while one is running the collection must
+ * not grow, so @c searches blocks ``append``, ``extend`` and re-init.
+ */
+typedef struct {
+    PyObject_HEAD BitVectorCollection *c; /**< Underlying collection */
+    Py_ssize_t searches; /**< Number of searches running without the GIL */
+} PyBitVectorCollectionObject;
+
+extern PyType_Spec PyBitVectorCollection_spec;
+
+#endif /* CBITS_PY_BITVECTOR_COLLECTION_OBJECT_H */
@@ -16,7 +16,10 @@
  */
 #include "bitvector_methods.h"
 #include "bitvector_methods_basic.h"
+#include "bitvector_methods_compare.h"
+#include "bitvector_methods_convert.h"
 #include "bitvector_methods_copy.h"
+#include "bitvector_methods_memory.h"
 #include "bitvector_methods_rank.h"
 
 /* Docstrings */
@@ -89,6 +92,120 @@ PyDoc_STRVAR(
     "\n"
     "Count the number of bits set to True in the half-open range [0..index].\n"
     "Supports negative indexing. Raises IndexError if out of range.");
+/** @brief Docstring for ``BitVector.count``. */
+PyDoc_STRVAR(
+    py_bv_count__doc__,
+    "count() -> int\n"
+    "count(start: int, length: int) -> int\n"
+    "\n"
+    "Return the number of bits set to True, in the whole vector or in the\n"
+    "half-open range [start..start+length). start and length go together;\n"
+    "passing only one raises TypeError. Unlike rank, this never builds\n"
+    "the rank tables. Raises IndexError if the range is out of bounds.");
+/** @brief Docstring for ``BitVector.compare``. */
+PyDoc_STRVAR(
+    py_bv_compare__doc__,
+    "compare(other: BitVector, order: str = 'lex') -> int\n"
+    "\n"
+    "Return -1, 0 or 1 as this vector is below, equal to or above *other*.\n"
+    "'lex' compares bit by bit from index 0 like tuples of bools, with a\n"
+    "prefix below the longer vector; this is the order of <, <=, > and >=.\n"
+    "'numeric' compares the vectors as unsigned integers with bit i worth\n"
+    "2**i, and orders equal values by length.");
+/** @brief Docstring for ``BitVector.issubset``. */
+PyDoc_STRVAR(py_bv_issubset__doc__,
+             "issubset(other: BitVector) -> bool\n"
+             "\n"
+             "Return True if every bit set here is also set in *other*.\n"
+             "Raises ValueError if the lengths differ.");
+/** @brief Docstring for ``BitVector.issuperset``. */
+PyDoc_STRVAR(py_bv_issuperset__doc__,
+             "issuperset(other: BitVector) -> bool\n"
+             "\n"
+             "Return True if every bit set in *other* is also set here.\n"
+             "Raises ValueError if the lengths differ.");
+/** @brief Docstring for ``BitVector.isdisjoint``. */
+PyDoc_STRVAR(py_bv_isdisjoint__doc__,
+             "isdisjoint(other: BitVector) -> bool\n"
+             "\n"
+             "Return True if no bit is set in both vectors.\n"
+             "Raises ValueError if the lengths differ.");
+/** @brief Docstring for ``BitVector.fingerprint``. */
+PyDoc_STRVAR(
+    py_bv_fingerprint__doc__,
+    "fingerprint(seed: int = 0) -> int\n"
+    "\n"
+    "Unsigned 64-bit XXH64-based hash of the length and bits, computed\n"
+    "over the words in place. Equal vectors give equal fingerprints for the\n"
+    "same seed, in every process. hash(bv) uses the same function with a\n"
+    "per-process random seed, like hash(bytes).\n"
+    "Raises OverflowError unless 0 <= seed < 2**64.");
+/** @brief Docstring for ``BitVector.from_int``. */
+PyDoc_STRVAR(
+    py_bv_from_int__doc__,
+    "from_int(value: int, n_bits: int | None = None) -> BitVector\n"
+    "\n"
+    "Create a BitVector of *n_bits* bits whose bit i is bit i of *value*,\n"
+    "by default just long enough to hold it (value.bit_length()).\n"
+    "Raises OverflowError if *value* is negative or does not fit.");
+/** @brief Docstring for ``BitVector.to_int``. */
+PyDoc_STRVAR(py_bv_to_int__doc__,
+             "to_int() -> int\n"
+             "\n"
+             "Return the non-negative int whose bit i is bit i of the\n"
+             "vector; the inverse of from_int().");
+/** @brief Docstring for ``BitVector.from_bytes``. */
+PyDoc_STRVAR(
+    py_bv_from_bytes__doc__,
+    "from_bytes(data: bytes-like, bitorder: str = 'little',\n"
+    "           n_bits: int | None = None) -> BitVector\n"
+    "\n"
+    "Create a BitVector from packed bytes, by default 8 bits per byte.\n"
+    "With bitorder='little' bit i is bit i % 8 of byte i // 8; with 'big'\n"
+    "it is bit 7 - i % 8, as in numpy.packbits. *n_bits* keeps only the\n"
+    "first bits, e.g. to round-trip to_bytes() of a length that is not a\n"
+    "multiple of 8.");
+/** @brief Docstring for ``BitVector.to_bytes``. */
+PyDoc_STRVAR(
+    py_bv_to_bytes__doc__,
+    "to_bytes(bitorder: str = 'little') -> bytes\n"
+    "\n"
+    "Pack the bits into (len(self) + 7) // 8 bytes in the given bit order;\n"
+    "padding bits of the last byte are zero. See from_bytes().");
+/** @brief Docstring for ``BitVector.from_bools``. */
+PyDoc_STRVAR(
+    py_bv_from_bools__doc__,
+    "from_bools(data: bytes-like) -> BitVector\n"
+    "\n"
+    "Create a BitVector with one bit per byte of *data*, set where the\n"
+    "byte is non-zero, e.g. from a NumPy bool or uint8 array. Any\n"
+    "contiguous buffer of 1-byte items is read in place.");
+/** @brief Docstring for ``BitVector.to_bools``. */
+PyDoc_STRVAR(
+    py_bv_to_bools__doc__,
+    "to_bools(out: writable bytes-like | None = None) -> bytearray\n"
+    "\n"
+    "Write bit i as byte i, 0 or 1, into a new bytearray or into *out*,\n"
+    "a writable buffer of len(self) 1-byte items such as a NumPy bool\n"
+    "array, which is returned. numpy.frombuffer(bv.to_bools(), bool)\n"
+    "views the result as a bool array.");
+/** @brief Docstring for ``BitVector.__sizeof__``. */
+PyDoc_STRVAR(py_bv_sizeof__doc__,
+             "__sizeof__() -> int\n"
+             "\n"
+             "Size of the object in bytes, including the native bit and\n"
+             "rank table allocations it owns.");
+/** @brief Docstring for ``BitVector.memory_usage``. */
+PyDoc_STRVAR(
+    py_bv_memory_usage__doc__,
+    "memory_usage() -> dict[str, int | bool]\n"
+    "\n"
+    "Bytes behind this BitVector: 'object' (the Python object), 'header'\n"
+    "(the native struct), 'data' (the bit words), 'padding' (the guard\n"
+    "word after them), 'rank_tables', 'shared' (True for BitMatrix row\n"
+    "views, whose memory belongs to the matrix) and 'total', the bytes\n"
+    "owned by this object as reported by sys.getsizeof without the GC\n"
+    "header.");
 /**
  * @brief Unified method table for the BitVector type.
  *
@@ -109,11 +226,41 @@ PyMethodDef BitVector_methods[] = {
      py_bv_flip_range__doc__},
 
     {"rank", (PyCFunction) py_bitvector_rank, METH_O, py_bv_rank__doc__},
+    {"count", (PyCFunction) py_bitvector_count, METH_VARARGS,
+     py_bv_count__doc__},
+    {"compare", (PyCFunction) (void (*)(void)) py_bitvector_compare,
+     METH_VARARGS | METH_KEYWORDS, py_bv_compare__doc__},
+    {"issubset", (PyCFunction) py_bitvector_issubset, METH_O,
+     py_bv_issubset__doc__},
+    {"issuperset", (PyCFunction) py_bitvector_issuperset, METH_O,
+     py_bv_issuperset__doc__},
+    {"isdisjoint", (PyCFunction) py_bitvector_isdisjoint, METH_O,
+     py_bv_isdisjoint__doc__},
+    {"fingerprint", (PyCFunction) (void (*)(void)) py_bitvector_fingerprint,
+     METH_VARARGS | METH_KEYWORDS, py_bv_fingerprint__doc__},
+
+    {"from_int", (PyCFunction) (void (*)(void)) py_bitvector_from_int,
+     METH_VARARGS | METH_KEYWORDS | METH_CLASS, py_bv_from_int__doc__},
+    {"to_int", (PyCFunction) py_bitvector_to_int, METH_NOARGS,
+     py_bv_to_int__doc__},
+    {"from_bytes", (PyCFunction) (void (*)(void)) py_bitvector_from_bytes,
+     METH_VARARGS | METH_KEYWORDS | METH_CLASS, py_bv_from_bytes__doc__},
+    {"to_bytes", (PyCFunction) (void (*)(void)) py_bitvector_to_bytes,
+     METH_VARARGS | METH_KEYWORDS, py_bv_to_bytes__doc__},
+    {"from_bools", (PyCFunction) py_bitvector_from_bools, METH_O | METH_CLASS,
+     py_bv_from_bools__doc__},
+    {"to_bools", (PyCFunction) (void (*)(void)) py_bitvector_to_bools,
+     METH_VARARGS | METH_KEYWORDS, py_bv_to_bools__doc__},
 
     {"copy", (PyCFunction) py_bitvector_copy, METH_NOARGS, py_bv_copy__doc__},
     {"__copy__", (PyCFunction) py_bitvector_copy, METH_NOARGS,
      py_bv_copy_inline__doc__},
     {"__deepcopy__", (PyCFunction) py_bitvector_deepcopy, METH_O,
      py_bv_deepcopy__doc__},
+
+    {"__sizeof__", (PyCFunction) py_bitvector_sizeof, METH_NOARGS,
+     py_bv_sizeof__doc__},
+    {"memory_usage", (PyCFunction) py_bitvector_memory_usage, METH_NOARGS,
+     py_bv_memory_usage__doc__},
     {NULL, NULL, 0, NULL},
 };
@@ -1,9 +1,12 @@
 /**
  * @file bitvector_methods_compare.c
- * @brief Equality and hashing for ``PyBitVectorObject``.
+ * @brief Comparison, set tests and hashing for ``PyBitVectorObject``.
  *
- * Implements ``__eq__``, ``__ne__``, and ``__hash__`` using the C backend’s
- * comparison routines and Python’s hashing utilities. Hash values are cached
+ * Implements rich comparison, ``compare``, ``issubset``, ``issuperset``,
+ * ``isdisjoint``, ``__hash__`` and ``fingerprint`` using the C backend’s
+ * comparison and hashing routines. ``__hash__`` is seeded with the
+ * per-process secret in ::cbits_state, ``fingerprint`` with an explicit,
+ * stable seed. Hash values are cached
  * inside the BitVector object and invalidated whenever the underlying data
  * mutates.
  *
@@ -13,13 +16,11 @@
  */
 #include "bitvector_methods_compare.h"
 
+#include <string.h>
+
 PyObject *
 py_bitvector_richcompare(PyObject *a, PyObject *b, int op)
 {
-    if (op != Py_EQ && op != Py_NE) {
-        Py_RETURN_NOTIMPLEMENTED;
-    }
-
     cbits_state *state = find_cbits_state_by_type(Py_TYPE(a));
 
     if (!py_bitvector_check(a, state) || !py_bitvector_check(b, state)) {
@@ -28,12 +29,106 @@ py_bitvector_richcompare(PyObject *a, PyObject *b, int op)
 
     BitVector *A = ((PyBitVectorObject *) a)->bv;
     BitVector *B = ((PyBitVectorObject *) b)->bv;
-    bool eq =
-        bv_equal(((PyBitVectorObject *) a)->bv, ((PyBitVectorObject *) b)->bv);
-    if ((op == Py_EQ) == eq) {
-        return Py_NewRef(Py_True);
+    if (op == Py_EQ || op == Py_NE) {
+        bool eq = bv_equal(A, B);
+        if ((op == Py_EQ) == eq) {
+            return Py_NewRef(Py_True);
+        }
+        return Py_NewRef(Py_False);
+    }
+    Py_RETURN_RICHCOMPARE(bv_compare(A, B, BV_ORDER_LEX), 0, op);
+}
+
+/**
+ * @brief Fetch the native vectors of @p self and @p other for a set test.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param other The argument, which must be a BitVector of the same length.
+ * @param a Receives the native vector of @p self.
+ * @param b Receives the native vector of @p other.
+ * @retval 0 on success.
+ * @retval -1 on failure (TypeError or ValueError set).
+ */
+static int
+bv_parse_set_operand(PyObject *self, PyObject *other, BitVector **a,
+                     BitVector **b)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(other, state)) {
+        PyErr_SetString(PyExc_TypeError, "Expected BitVector");
+        return -1;
+    }
+    *a = ((PyBitVectorObject *) self)->bv;
+    *b = ((PyBitVectorObject *) other)->bv;
+    if ((*a)->n_bits != (*b)->n_bits) {
+        PyErr_Format(PyExc_ValueError, "length mismatch: A=%zu, B=%zu",
+                     (*a)->n_bits, (*b)->n_bits);
+        return -1;
+    }
+    return 0;
+}
+
+PyObject *
+py_bitvector_compare(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *other;
+    const char *order_name = "lex";
+    static char *kwlist[] = {"other", "order", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|s", kwlist, &other,
+                                     &order_name)) {
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(other, state)) {
+        PyErr_SetString(PyExc_TypeError, "Expected BitVector");
+        return NULL;
+    }
+    BVOrder order;
+    if (strcmp(order_name, "lex") == 0) {
+        order = BV_ORDER_LEX;
+    }
+    else if (strcmp(order_name, "numeric") == 0) {
+        order = BV_ORDER_NUMERIC;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                     "order must be 'lex' or 'numeric', not '%s'",
+                     order_name);
+        return NULL;
+    }
+    int c = bv_compare(((PyBitVectorObject *) self)->bv,
+                       ((PyBitVectorObject *) other)->bv, order);
+    return PyLong_FromLong((c > 0) - (c < 0));
+}
+
+PyObject *
+py_bitvector_issubset(PyObject *self, PyObject *other)
+{
+    BitVector *a, *b;
+    if (bv_parse_set_operand(self, other, &a, &b) < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(bv_is_subset(a, b));
+}
+
+PyObject *
+py_bitvector_issuperset(PyObject *self, PyObject *other)
+{
+    BitVector *a, *b;
+    if (bv_parse_set_operand(self, other, &a, &b) < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(bv_is_subset(b, a));
+}
+
+PyObject *
+py_bitvector_isdisjoint(PyObject *self, PyObject *other)
+{
+    BitVector *a, *b;
+    if (bv_parse_set_operand(self, other, &a, &b) < 0) {
+        return NULL;
     }
-    return Py_NewRef(Py_False);
+    return PyBool_FromLong(bv_is_disjoint(a, b));
 }
 
 Py_hash_t
@@ -43,22 +138,31 @@ py_bitvector_hash(PyObject *self)
     if (pbv->hash_cache != -1) {
         return pbv->hash_cache;
     }
-    BitVector *bv = pbv->bv;
-    size_t n_bytes = (bv->n_bits + 7) >> 3;
-    if (n_bytes == 0) {
-        return 0;
-    }
-    PyObject *b = PyBytes_FromStringAndSize((const char *) bv->data,
-                                            (Py_ssize_t) n_bytes);
-    if (b == NULL) {
-        return -1;
-    }
-    Py_hash_t hash = PyObject_Hash(b);
-    Py_DECREF(b);
-
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    Py_hash_t hash = (Py_hash_t) bv_hash(pbv->bv, state->hash_seed);
     if (hash == -1) {
         hash = -2;
     }
     pbv->hash_cache = hash;
     return hash;
 }
+
+PyObject *
+py_bitvector_fingerprint(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *seed_obj = NULL;
+    static char *kwlist[] = {"seed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &seed_obj)) {
+        return NULL;
+    }
+    unsigned long long seed = 0;
+    if (seed_obj) {
+        /* Unlike "K", this rejects negative and oversized seeds. */
+        seed = PyLong_AsUnsignedLongLong(seed_obj);
+        if (seed == (unsigned long long) -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+    return PyLong_FromUnsignedLongLong(
+        bv_hash(((PyBitVectorObject *) self)->bv, (uint64_t) seed));
+}
@@ -1,10 +1,13 @@
 /**
  * @file bitvector_methods_compare.h
- * @brief Equality and hashing methods for ``BitVector``.
+ * @brief Comparison, set test and hashing methods for ``BitVector``.
  *
  * Declares the Python bindings for:
- * - rich comparison (``__eq__`` and ``__ne__``)
+ * - rich comparison (``==``, ``!=`` and the lexicographic ``<``, ``<=``,
+ *   ``>``, ``>=``) and ``compare`` with a selectable order
+ * - ``issubset``, ``issuperset`` and ``isdisjoint``
  * - ``__hash__`` implementation with caching
+ * - ``fingerprint``, the seeded 64-bit hash behind it
  *
  * These functions wrap the C backend’s equality logic and compute a stable,
  * cached hash suitable for use in Python dictionaries and sets.
@@ -21,23 +24,24 @@
 /**
  * @brief Implement rich comparison for BitVector.
  *
- * Supports ``==`` and ``!=``. For unsupported operations, returns
- * ``Py_NotImplemented``.
+ * ``==`` and ``!=`` test equality; ``<``, ``<=``, ``>`` and ``>=`` use
+ * ``bv_compare`` in lexicographic bit order, so vectors sort like tuples of
+ * bools. Returns ``Py_NotImplemented`` if an operand is not a BitVector.
  *
  * @param a First operant.
  * @param b Second operant.
- * @param op Comparison operation (``Py_EQ`` or ``Py_NE``).
+ * @param op Comparison operation.
  * @retval bool ``Py_True`` or ``Py_False`` on success.
- * @retval Py_RETURN_NOTIMPLEMENTED for unsupported comparisons.
+ * @retval Py_RETURN_NOTIMPLEMENTED for foreign operands.
  */
 PyObject *
 py_bitvector_richcompare(PyObject *a, PyObject *b, int op);
 /**
  * @brief Implement ``hash(BitVector)``.
  *
- * Computes a hash over the packed bit data using Python’s internal
- * ``_Py_HashBytes``. The result is cached in the BitVector object until the
- * underlying data is mutated.
+ * Hashes the words in place with ``bv_hash`` and seed 0, without copying
+ * them into a bytes object. The result is cached in the BitVector object
+ * until the underlying data is mutated.
  *
  * @param self A ``PyBitVectorObject`` instance.
  * @return A ``Py_hash_t`` value derived from the bit‐pattern.
@@ -45,4 +49,62 @@ py_bitvector_richcompare(PyObject *a, PyObject *b, int op);
 Py_hash_t
 py_bitvector_hash(PyObject *self);
 
+/**
+ * @brief Python binding for ``BitVector.compare(other, order="lex")``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval int -1, 0 or 1.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_compare(PyObject *self, PyObject *args, PyObject *kwds);
+/**
+ * @brief Python binding for ``BitVector.issubset(other)``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param other BitVector of the same length.
+ * @retval bool Whether every bit of @p self is set in @p other.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_issubset(PyObject *self, PyObject *other);
+/**
+ * @brief Python binding for ``BitVector.issuperset(other)``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param other BitVector of the same length.
+ * @retval bool Whether every bit of @p other is set in @p self.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_issuperset(PyObject *self, PyObject *other);
+/**
+ * @brief Python binding for ``BitVector.isdisjoint(other)``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param other BitVector of the same length.
+ * @retval bool Whether no bit is set in both.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_isdisjoint(PyObject *self, PyObject *other);
+/**
+ * @brief Python binding for ``BitVector.fingerprint(seed=0)``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval int Unsigned 64-bit ``bv_hash`` of the vector.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_fingerprint(PyObject *self, PyObject *args, PyObject *kwds);
+
 #endif /* CBITS_PY_BITVECTOR_METHODS_COMPARE_H */
@@ -0,0 +1,351 @@
+/**
+ * @file bitvector_methods_convert.c
+ * @brief Implementation of the ``int``, ``bytes`` and bool array
+ *        conversions of ``BitVector``.
+ *
+ * Integers are exchanged with CPython as little-endian byte arrays, which on
+ * a little-endian host is exactly the layout of the data words, so
+ * ``from_int`` and ``to_int`` read and write the words in place. Other hosts
+ * and the big bit order of ``bytes`` go through @ref bv_to_bytes and
+ * @ref bv_from_bytes. ``from_bools`` and ``to_bools`` read and write any
+ * buffer of one-byte items in place; ``from_bools`` releases the GIL while
+ * it packs the exported buffer, ``to_bools`` keeps it because it reads
+ * ``self``, which ``__init__`` may replace.
+ *
+ * @see bitvector_methods_convert.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitvector_methods_convert.h"
+
+#include <string.h>
+
+/**
+ * @brief Parse a ``bitorder`` argument.
+ *
+ * @param name ``'little'`` or ``'big'``.
+ * @param order Receives the parsed order.
+ * @retval 0 on success.
+ * @retval -1 on failure (ValueError set).
+ */
+static int
+bv_parse_bitorder(const char *name, BVBitOrder *order)
+{
+    if (strcmp(name, "little") == 0) {
+        *order = BV_BITORDER_LITTLE;
+    }
+    else if (strcmp(name, "big") == 0) {
+        *order = BV_BITORDER_BIG;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                     "bitorder must be 'little' or 'big', not '%s'", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Write a non-negative integer as @p n_bits little-endian bits.
+ *
+ * @param value A non-negative ``int``.
+ * @param buf Destination of ``(n_bits + 7) / 8`` bytes.
+ * @param n_bits Number of bits available.
+ * @retval 0 on success.
+ * @retval -1 on failure (OverflowError set if @p value does not fit).
+ */
+static int
+bv_int_to_bytes(PyObject *value, uint8_t *buf, size_t n_bits)
+{
+    const size_t n_bytes = (n_bits + 7) >> 3;
+    int fits;
+    if (n_bytes == 0) {
+        fits = !PyObject_IsTrue(value);
+    }
+    else {
+#if PY_VERSION_HEX >= 0x030D0000
+        Py_ssize_t need = PyLong_AsNativeBytes(
+            value, buf, (Py_ssize_t) n_bytes,
+            Py_ASNATIVEBYTES_LITTLE_ENDIAN | Py_ASNATIVEBYTES_UNSIGNED_BUFFER);
+        if (need < 0) {
+            return -1;
+        }
+        fits = (size_t) need <= n_bytes;
+#else
+        if (_PyLong_AsByteArray((PyLongObject *) value, buf, n_bytes, 1, 0) <
+            0) {
+            if (!PyErr_ExceptionMatches(PyExc_OverflowError)) {
+                return -1;
+            }
+            PyErr_Clear();
+            fits = 0;
+        }
+        else {
+            fits = 1;
+        }
+#endif
+        const unsigned tail = (unsigned) (n_bits & 7);
+        if (fits && tail && (buf[n_bytes - 1] >> tail)) {
+            fits = 0;
+        }
+    }
+    if (!fits) {
+        PyErr_Format(PyExc_OverflowError, "int too big for %zu bits", n_bits);
+        return -1;
+    }
+    return 0;
+}
+
+PyObject *
+py_bitvector_from_int(PyObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *value_obj;
+    PyObject *n_bits_obj = Py_None;
+    static char *kwlist[] = {"value", "n_bits", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &value_obj,
+                                     &n_bits_obj)) {
+        return NULL;
+    }
+    PyObject *value = PyNumber_Index(value_obj);
+    if (!value) {
+        return NULL;
+    }
+    PyObject *zero = PyLong_FromLong(0);
+    int negative = zero ? PyObject_RichCompareBool(value, zero, Py_LT) : -1;
+    Py_XDECREF(zero);
+    if (negative != 0) {
+        if (negative > 0) {
+            PyErr_SetString(PyExc_OverflowError,
+                            "can't convert negative int to BitVector");
+        }
+        Py_DECREF(value);
+        return NULL;
+    }
+
+    Py_ssize_t n_bits;
+    if (n_bits_obj == Py_None) {
+        PyObject *bl = PyObject_CallMethod(value, "bit_length", NULL);
+        n_bits = bl ? PyLong_AsSsize_t(bl) : -1;
+        Py_XDECREF(bl);
+    }
+    else {
+        n_bits = PyNumber_AsSsize_t(n_bits_obj, PyExc_OverflowError);
+        if (n_bits < 0 && !PyErr_Occurred()) {
+            PyErr_SetString(PyExc_ValueError, "n_bits must be >= 0");
+        }
+    }
+    if (n_bits < 0) {
+        Py_DECREF(value);
+        return NULL;
+    }
+
+    BitVector *bv;
+#if CBITS_LITTLE_ENDIAN
+    bv = bv_new((size_t) n_bits);
+    if (!bv) {
+        Py_DECREF(value);
+        return PyErr_NoMemory();
+    }
+    if (bv_int_to_bytes(value, (uint8_t *) bv->data, (size_t) n_bits) < 0) {
+        bv_free(bv);
+        Py_DECREF(value);
+        return NULL;
+    }
+#else
+    const size_t n_bytes = ((size_t) n_bits + 7) >> 3;
+    uint8_t *buf = PyMem_Malloc(n_bytes ? n_bytes : 1);
+    if (!buf) {
+        Py_DECREF(value);
+        return PyErr_NoMemory();
+    }
+    if (bv_int_to_bytes(value, buf, (size_t) n_bits) < 0) {
+        PyMem_Free(buf);
+        Py_DECREF(value);
+        return NULL;
+    }
+    bv = bv_from_bytes(buf, (size_t) n_bits, BV_BITORDER_LITTLE);
+    PyMem_Free(buf);
+    if (!bv) {
+        Py_DECREF(value);
+        return PyErr_NoMemory();
+    }
+#endif
+    Py_DECREF(value);
+    return bitvector_wrap_new((PyTypeObject *) type, bv);
+}
+
+PyObject *
+py_bitvector_to_int(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    const BitVector *bv = ((PyBitVectorObject *) self)->bv;
+    const size_t n_bytes = (bv->n_bits + 7) >> 3;
+    if (n_bytes == 0) {
+        return PyLong_FromLong(0);
+    }
+#if CBITS_LITTLE_ENDIAN
+    const uint8_t *src = (const uint8_t *) bv->data;
+#else
+    uint8_t *src = PyMem_Malloc(n_bytes);
+    if (!src) {
+        return PyErr_NoMemory();
+    }
+    bv_to_bytes(bv, src, BV_BITORDER_LITTLE);
+#endif
+#if PY_VERSION_HEX >= 0x030D0000
+    PyObject *result = PyLong_FromUnsignedNativeBytes(
+        src, n_bytes, Py_ASNATIVEBYTES_LITTLE_ENDIAN);
+#else
+    PyObject *result = _PyLong_FromByteArray(src, n_bytes, 1, 0);
+#endif
+#if !CBITS_LITTLE_ENDIAN
+    PyMem_Free(src);
+#endif
+    return result;
+}
+
+PyObject *
+py_bitvector_from_bytes(PyObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *data;
+    const char *order_name = "little";
+    PyObject *n_bits_obj = Py_None;
+    static char *kwlist[] = {"data", "bitorder", "n_bits", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sO", kwlist, &data,
+                                     &order_name, &n_bits_obj)) {
+        return NULL;
+    }
+    BVBitOrder order;
+    if (bv_parse_bitorder(order_name, &order) < 0) {
+        return NULL;
+    }
+    Py_buffer view;
+    if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    const size_t avail = (size_t) view.len * 8;
+    size_t n_bits = avail;
+    if (n_bits_obj != Py_None) {
+        Py_ssize_t n = PyNumber_AsSsize_t(n_bits_obj, PyExc_OverflowError);
+        if (n < 0 || (size_t) n > avail) {
+            if (!PyErr_Occurred()) {
+                PyErr_Format(PyExc_ValueError,
+                             "n_bits must be between 0 and %zu", avail);
+            }
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        n_bits = (size_t) n;
+    }
+    BitVector *bv;
+    Py_BEGIN_ALLOW_THREADS
+    bv = bv_from_bytes((const uint8_t *) view.buf, n_bits, order);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&view);
+    if (!bv) {
+        return PyErr_NoMemory();
+    }
+    return bitvector_wrap_new((PyTypeObject *) type, bv);
+}
+
+PyObject *
+py_bitvector_to_bytes(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    const char *order_name = "little";
+    static char *kwlist[] = {"bitorder", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|s", kwlist, &order_name)) {
+        return NULL;
+    }
+    BVBitOrder order;
+    if (bv_parse_bitorder(order_name, &order) < 0) {
+        return NULL;
+    }
+    const BitVector *bv = ((PyBitVectorObject *) self)->bv;
+    PyObject *result =
+        PyBytes_FromStringAndSize(NULL, (Py_ssize_t) ((bv->n_bits + 7) >> 3));
+    if (!result) {
+        return NULL;
+    }
+    bv_to_bytes(bv, (uint8_t *) PyBytes_AS_STRING(result), order);
+    return result;
+}
+
+/**
+ * @brief Reject buffers whose items are not single bytes.
+ *
+ * @param view Buffer to check.
+ * @retval 0 if every item is one byte.
+ * @retval -1 otherwise (ValueError set).
+ */
+static int
+bv_check_byte_items(const Py_buffer *view)
+{
+    if (view->itemsize != 1) {
+        PyErr_Format(PyExc_ValueError,
+                     "expected a buffer of 1-byte items, not %zd-byte items",
+                     view->itemsize);
+        return -1;
+    }
+    return 0;
+}
+
+PyObject *
+py_bitvector_from_bools(PyObject *type, PyObject *arg)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(arg, &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    if (bv_check_byte_items(&view) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    BitVector *bv;
+    Py_BEGIN_ALLOW_THREADS
+    bv = bv_from_bools((const uint8_t *) view.buf, (size_t) view.len);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&view);
+    if (!bv) {
+        return PyErr_NoMemory();
+    }
+    return bitvector_wrap_new((PyTypeObject *) type, bv);
+}
+
+PyObject *
+py_bitvector_to_bools(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *out = Py_None;
+    static char *kwlist[] = {"out", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &out)) {
+        return NULL;
+    }
+    const BitVector *bv = ((PyBitVectorObject *) self)->bv;
+    if (out == Py_None) {
+        PyObject *result =
+            PyByteArray_FromStringAndSize(NULL, (Py_ssize_t) bv->n_bits);
+        if (!result) {
+            return NULL;
+        }
+        bv_to_bools(bv, (uint8_t *) PyByteArray_AS_STRING(result));
+        return result;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(out, &view, PyBUF_WRITABLE) < 0) {
+        return NULL;
+    }
+    if (bv_check_byte_items(&view) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    if ((size_t) view.len != bv->n_bits) {
+        PyErr_Format(PyExc_ValueError, "length mismatch: out=%zd, self=%zu",
+                     view.len, bv->n_bits);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    /* Keep the GIL: another thread could re-initialize self and free bv. */
+    bv_to_bools(bv, (uint8_t *) view.buf);
+    PyBuffer_Release(&view);
+    return Py_NewRef(out);
+}
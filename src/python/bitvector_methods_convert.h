@@ -0,0 +1,103 @@
+/**
+ * @file bitvector_methods_convert.h
+ * @brief Conversion methods between ``BitVector`` and ``int``, ``bytes``
+ *        or bool arrays.
+ *
+ * Declares the Python bindings for:
+ * - ``BitVector.from_int`` and ``BitVector.to_int``
+ * - ``BitVector.from_bytes`` and ``BitVector.to_bytes``
+ * - ``BitVector.from_bools`` and ``BitVector.to_bools``
+ *
+ * All of them move whole byte arrays through the CPython bulk integer
+ * conversion or the core conversion kernels instead of touching the bits
+ * one by one.
+ *
+ * @see bitvector_methods_convert.c
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BITVECTOR_METHODS_CONVERT_H
+#define CBITS_PY_BITVECTOR_METHODS_CONVERT_H
+
+#include "bitvector_object.h"
+
+/**
+ * @brief Python binding for ``BitVector.from_int(value, n_bits=None)``.
+ *
+ * @param type The class the method was called on.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval object New ``BitVector`` with bit i equal to bit i of @p value.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_from_int(PyObject *type, PyObject *args, PyObject *kwds);
+
+/**
+ * @brief Python binding for ``BitVector.to_int()``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param ignored Always NULL.
+ * @retval int Non-negative integer with bit i equal to bit i of @p self.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_to_int(PyObject *self, PyObject *ignored);
+
+/**
+ * @brief Python binding for
+ *        ``BitVector.from_bytes(data, bitorder='little', n_bits=None)``.
+ *
+ * @param type The class the method was called on.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval object New ``BitVector`` on success.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_from_bytes(PyObject *type, PyObject *args, PyObject *kwds);
+
+/**
+ * @brief Python binding for ``BitVector.to_bytes(bitorder='little')``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval bytes ``(len(self) + 7) // 8`` packed bytes.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_to_bytes(PyObject *self, PyObject *args, PyObject *kwds);
+
+/**
+ * @brief Python binding for ``BitVector.from_bools(data)``.
+ *
+ * @param type The class the method was called on.
+ * @param arg Buffer of one byte per bit.
+ * @retval object New ``BitVector`` on success.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_from_bools(PyObject *type, PyObject *arg);
+
+/**
+ * @brief Python binding for ``BitVector.to_bools(out=None)``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval bytearray ``len(self)`` bytes of 0 and 1 if @c out is omitted.
+ * @retval object @c out after filling it.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_to_bools(PyObject *self, PyObject *args, PyObject *kwds);
+
+#endif /* CBITS_PY_BITVECTOR_METHODS_CONVERT_H */
@@ -0,0 +1,50 @@
+/**
+ * @file bitvector_methods_memory.c
+ * @brief Implementation of the memory accounting methods for ``BitVector``.
+ *
+ * Reports the ``BitVector`` struct, the data words, the guard word and the
+ * rank tables allocated by ``bv_new`` next to the Python object itself.
+ * Row views of a ``BitMatrix`` pass @c shared so that memory owned by the
+ * matrix is not counted twice.
+ *
+ * @see bitvector_methods_memory.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bitvector_methods_memory.h"
+
+size_t
+bitvector_owned_bytes(PyObject *self, int shared)
+{
+    size_t bytes = (size_t) Py_TYPE(self)->tp_basicsize;
+    if (!shared) {
+        bytes += bv_memory_usage(((PyBitVectorObject *) self)->bv, NULL);
+    }
+    return bytes;
+}
+
+PyObject *
+bitvector_memory_report(PyObject *self, int shared)
+{
+    bv_memory m;
+    bv_memory_usage(((PyBitVectorObject *) self)->bv, &m);
+    return Py_BuildValue(
+        "{sn sn sn sn sn sO sn}", "object", Py_TYPE(self)->tp_basicsize,
+        "header", (Py_ssize_t) m.header, "data", (Py_ssize_t) m.data,
+        "padding", (Py_ssize_t) m.padding, "rank_tables",
+        (Py_ssize_t) m.rank_tables, "shared", shared ? Py_True : Py_False,
+        "total", (Py_ssize_t) bitvector_owned_bytes(self, shared));
+}
+
+PyObject *
+py_bitvector_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyLong_FromSize_t(bitvector_owned_bytes(self, 0));
+}
+
+PyObject *
+py_bitvector_memory_usage(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return bitvector_memory_report(self, 0);
+}
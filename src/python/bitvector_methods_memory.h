@@ -0,0 +1,67 @@
+/**
+ * @file bitvector_methods_memory.h
+ * @brief Memory accounting methods for ``BitVector``.
+ *
+ * Declares the Python bindings for ``BitVector.__sizeof__``, which adds the
+ * native allocations to the object size so ``sys.getsizeof`` sees them, and
+ * ``BitVector.memory_usage``, which breaks them down.
+ *
+ * @see bv_memory_usage
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BITVECTOR_METHODS_MEMORY_H
+#define CBITS_PY_BITVECTOR_METHODS_MEMORY_H
+
+#include "bitvector_object.h"
+
+/**
+ * @brief Bytes owned by a ``BitVector`` object.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param shared Non-zero if the native vector is borrowed from another
+ *        object, which then accounts for it.
+ * @return Object size plus, unless @p shared, its native allocations.
+ * @since 0.4.0
+ */
+size_t
+bitvector_owned_bytes(PyObject *self, int shared);
+
+/**
+ * @brief Build the ``memory_usage()`` dict of a ``BitVector`` object.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param shared Non-zero if the native vector is borrowed.
+ * @retval dict New dict on success.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+bitvector_memory_report(PyObject *self, int shared);
+
+/**
+ * @brief Python binding for ``BitVector.__sizeof__()``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param ignored Always NULL.
+ * @retval int Owned bytes.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_sizeof(PyObject *self, PyObject *ignored);
+
+/**
+ * @brief Python binding for ``BitVector.memory_usage()``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param ignored Always NULL.
+ * @retval dict Breakdown of the owned bytes.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_memory_usage(PyObject *self, PyObject *ignored);
+
+#endif /* CBITS_PY_BITVECTOR_METHODS_MEMORY_H */
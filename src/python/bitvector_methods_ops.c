@@ -4,8 +4,9 @@
  *
  * Implements Python bindings for all bitwise operators supported by the
  * BitVector type: AND, OR, XOR, their in‑place variants, bitwise NOT, and
- * truth‑value testing. All operations are executed word-wise using the native
- * C backend for high throughput on large vectors.
+ * truth‑value testing. All operations are executed word-wise by the
+ * runtime-dispatched @ref cbits_bitwise_words kernel, which picks AVX2 or
+ * AVX-512 on CPUs that support them.
  *
  * @author lambdaphoenix
  * @version 0.3.0
@@ -14,6 +15,26 @@
 #include "bitvector_methods_ops.h"
 #include "bitvector_object.h"
 
+/**
+ * @brief Run the bitwise kernel for one operator and count its operand
+ *        bytes in @c CBITS_STAT_BITWISE_BYTES.
+ *
+ * @param dst Destination words; may be @p a.
+ * @param a First operand.
+ * @param b Second operand; NULL for @c CBITS_BITWISE_NOT.
+ * @param n_words Word count.
+ * @param op Operation.
+ */
+static inline void
+py_bitvector_bitwise(uint64_t *dst, const uint64_t *a, const uint64_t *b,
+                     size_t n_words, cbits_bitwise_op op)
+{
+    const size_t operands = op == CBITS_BITWISE_NOT ? 1 : 2;
+    cbits_stat_add(CBITS_STAT_BITWISE_BYTES,
+                   (uint64_t) (operands * n_words * sizeof(uint64_t)));
+    cbits_bitwise_words(dst, a, b, n_words, op);
+}
+
 PyObject *
 py_bitvector_and(PyObject *oA, PyObject *oB)
 {
@@ -38,23 +59,8 @@ py_bitvector_and(PyObject *oA, PyObject *oB)
         return NULL;
     }
 
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict b = B->bv->data;
-    uint64_t *restrict c = C->data;
-
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-        cbits_prefetch(&b[i + 16]);
-
-        c[i] = a[i] & b[i];
-        c[i + 1] = a[i + 1] & b[i + 1];
-        c[i + 2] = a[i + 2] & b[i + 2];
-        c[i + 3] = a[i + 3] & b[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        c[i] = a[i] & b[i];
-    }
+    py_bitvector_bitwise(C->data, A->bv->data, B->bv->data, A->bv->n_words,
+                         CBITS_BITWISE_AND);
     bv_apply_tail_mask(C);
     return bitvector_wrap_new(state->PyBitVectorType, C);
 }
@@ -78,22 +84,8 @@ py_bitvector_iand(PyObject *self, PyObject *arg)
         return NULL;
     }
 
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict b = B->bv->data;
-
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-        cbits_prefetch(&b[i + 16]);
-
-        a[i] &= b[i];
-        a[i + 1] &= b[i + 1];
-        a[i + 2] &= b[i + 2];
-        a[i + 3] &= b[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        a[i] &= b[i];
-    }
+    py_bitvector_bitwise(A->bv->data, A->bv->data, B->bv->data,
+                         A->bv->n_words, CBITS_BITWISE_AND);
     bv_apply_tail_mask(A->bv);
     A->bv->rank_dirty = true;
     A->hash_cache = -1;
@@ -125,23 +117,8 @@ py_bitvector_or(PyObject *oA, PyObject *oB)
         return NULL;
     }
 
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict b = B->bv->data;
-    uint64_t *restrict c = C->data;
-
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-        cbits_prefetch(&b[i + 16]);
-
-        c[i] = a[i] | b[i];
-        c[i + 1] = a[i + 1] | b[i + 1];
-        c[i + 2] = a[i + 2] | b[i + 2];
-        c[i + 3] = a[i + 3] | b[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        c[i] = a[i] | b[i];
-    }
+    py_bitvector_bitwise(C->data, A->bv->data, B->bv->data, A->bv->n_words,
+                         CBITS_BITWISE_OR);
     bv_apply_tail_mask(C);
     return bitvector_wrap_new(state->PyBitVectorType, C);
 }
@@ -165,21 +142,8 @@ py_bitvector_ior(PyObject *self, PyObject *arg)
         return NULL;
     }
 
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict b = B->bv->data;
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-        cbits_prefetch(&b[i + 16]);
-
-        a[i] |= b[i];
-        a[i + 1] |= b[i + 1];
-        a[i + 2] |= b[i + 2];
-        a[i + 3] |= b[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        a[i] |= b[i];
-    }
+    py_bitvector_bitwise(A->bv->data, A->bv->data, B->bv->data,
+                         A->bv->n_words, CBITS_BITWISE_OR);
     bv_apply_tail_mask(A->bv);
     A->bv->rank_dirty = true;
     A->hash_cache = -1;
@@ -211,23 +175,8 @@ py_bitvector_xor(PyObject *oA, PyObject *oB)
         return NULL;
     }
 
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict b = B->bv->data;
-    uint64_t *restrict c = C->data;
-
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-        cbits_prefetch(&b[i + 16]);
-
-        c[i] = a[i] ^ b[i];
-        c[i + 1] = a[i + 1] ^ b[i + 1];
-        c[i + 2] = a[i + 2] ^ b[i + 2];
-        c[i + 3] = a[i + 3] ^ b[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        c[i] = a[i] ^ b[i];
-    }
+    py_bitvector_bitwise(C->data, A->bv->data, B->bv->data, A->bv->n_words,
+                         CBITS_BITWISE_XOR);
     bv_apply_tail_mask(C);
     return bitvector_wrap_new(state->PyBitVectorType, C);
 }
@@ -251,21 +200,8 @@ py_bitvector_ixor(PyObject *self, PyObject *arg)
         return NULL;
     }
 
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict b = B->bv->data;
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-        cbits_prefetch(&b[i + 16]);
-
-        a[i] ^= b[i];
-        a[i + 1] ^= b[i + 1];
-        a[i + 2] ^= b[i + 2];
-        a[i + 3] ^= b[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        a[i] ^= b[i];
-    }
+    py_bitvector_bitwise(A->bv->data, A->bv->data, B->bv->data,
+                         A->bv->n_words, CBITS_BITWISE_XOR);
     bv_apply_tail_mask(A->bv);
     A->bv->rank_dirty = true;
     A->hash_cache = -1;
@@ -285,21 +221,8 @@ py_bitvector_invert(PyObject *self)
                         "BitVector allocation failed in __invert__");
         return NULL;
     }
-    uint64_t *restrict a = A->bv->data;
-    uint64_t *restrict c = C->data;
-
-    size_t i = 0;
-    for (; i + 3 < A->bv->n_words; i += 4) {
-        cbits_prefetch(&a[i + 16]);
-
-        c[i] = ~a[i];
-        c[i + 1] = ~a[i + 1];
-        c[i + 2] = ~a[i + 2];
-        c[i + 3] = ~a[i + 3];
-    }
-    for (; i < A->bv->n_words; ++i) {
-        c[i] = ~a[i];
-    }
+    py_bitvector_bitwise(C->data, A->bv->data, NULL, A->bv->n_words,
+                         CBITS_BITWISE_NOT);
     bv_apply_tail_mask(C);
     return bitvector_wrap_new(state->PyBitVectorType, C);
 }
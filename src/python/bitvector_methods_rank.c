@@ -2,8 +2,9 @@
  * @file bitvector_methods_rank.c
  * @brief Implementation of rank-related Python methods for ``BitVector``.
  *
- * Provides the Python binding for the native ``bv_rank`` function, including
- * argument parsing, negative‑index normalization, and error handling.
+ * Provides the Python bindings for the native ``bv_rank``, ``bv_count`` and
+ * ``bv_count_range`` functions, including argument parsing, negative‑index
+ * normalization, and error handling.
  *
  * @author lambdaphoenix
  * @version 0.3.0
@@ -23,3 +24,17 @@ py_bitvector_rank(PyObject *self, PyObject *arg)
     size_t rank = bv_rank(((PyBitVectorObject *) self)->bv, index);
     return PyLong_FromSize_t(rank);
 }
+
+PyObject *
+py_bitvector_count(PyObject *self, PyObject *args)
+{
+    BitVector *bv = ((PyBitVectorObject *) self)->bv;
+    if (PyTuple_GET_SIZE(args) == 0) {
+        return PyLong_FromSize_t(bv_count(bv));
+    }
+    size_t start, len;
+    if (bv_parse_tuple(self, args, &start, &len) < 0) {
+        return NULL;
+    }
+    return PyLong_FromSize_t(bv_count_range(bv, start, len));
+}
@@ -2,8 +2,10 @@
  * @file bitvector_methods_rank.h
  * @brief Rank-related Python methods for ``BitVector``.
  *
- * Declares the Python binding for the ``BitVector.rank`` method, which counts
- * the number of bits set to True in the prefix range ``[0..index[``.
+ * Declares the Python bindings for the ``BitVector.rank`` method, which counts
+ * the number of bits set to True in the prefix range ``[0..index[``, and for
+ * ``BitVector.count``, which counts a whole vector or an arbitrary range
+ * without building the rank tables.
  *
  * @author lambdaphoenix
  * @version 0.3.0
@@ -29,4 +31,19 @@
 PyObject *
 py_bitvector_rank(PyObject *self, PyObject *arg);
 
+/**
+ * @brief Python binding for ``BitVector.count([start, length])``.
+ *
+ * Without arguments counts all set bits; with ``(start, length)`` counts the
+ * set bits of that range, validated like ``set_range``.
+ *
+ * @param self A ``PyBitVectorObject`` instance.
+ * @param args Empty tuple or ``(start, length)``.
+ * @retval int New Python integer on success.
+ * @retval NULL on failure (exception set).
+ * @since 0.4.0
+ */
+PyObject *
+py_bitvector_count(PyObject *self, PyObject *args);
+
 #endif /* CBITS_PY_BITVECTOR_METHODS_RANK_H */
@@ -37,7 +37,7 @@ py_bitvector_concat(PyObject *oA, PyObject *oB)
         return NULL;
     }
 
-    PyObject *result = bitvector_wrap_new(Py_TYPE(oA), res);
+    PyObject *result = bitvector_wrap_new(state->PyBitVectorType, res);
     if (result == NULL) {
         bv_free(res);
         return NULL;
@@ -48,6 +48,7 @@ PyObject *
 py_bitvector_repeat(PyObject *self, Py_ssize_t count)
 {
     PyBitVectorObject *bv_obj = (PyBitVectorObject *) self;
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
     if (bv_obj->bv == NULL) {
         PyErr_BadInternalCall();
         return NULL;
@@ -66,7 +67,7 @@ py_bitvector_repeat(PyObject *self, Py_ssize_t count)
         return NULL;
     }
 
-    PyObject *result = bitvector_wrap_new(Py_TYPE(self), res);
+    PyObject *result = bitvector_wrap_new(state->PyBitVectorType, res);
     if (result == NULL) {
         bv_free(res);
         return NULL;
@@ -98,6 +98,8 @@ py_bitvector_slice(PyObject *object, size_t start, size_t stop, size_t step,
     if (!out) {
         return NULL;
     }
+    cbits_stat_add(CBITS_STAT_SLICE_COPIES, 1);
+    cbits_stat_add(CBITS_STAT_SLICE_BITS, slicelength);
     if (step == 1 && slicelength > 0) {
         size_t s_word = start >> 6;
         unsigned s_off = (unsigned) (start & 63);
@@ -109,7 +111,8 @@ py_bitvector_slice(PyObject *object, size_t start, size_t stop, size_t step,
             uint64_t lo = (aw < src->n_words) ? src->data[aw] : 0ULL;
             uint64_t hi = (aw + 1 < src->n_words) ? src->data[aw + 1] : 0ULL;
 
-            uint64_t word = (lo >> s_off) | (hi << (64 - s_off));
+            uint64_t word =
+                s_off ? (lo >> s_off) | (hi << (64 - s_off)) : lo;
             out->data[j] = word;
         }
         bv_apply_tail_mask(out);
@@ -98,6 +98,12 @@ py_bitvector_init(PyObject *self, PyObject *args, PyObject *kwds)
         PyErr_SetString(PyExc_ValueError, "size must be >= 0");
         return -1;
     }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (Py_IS_TYPE(self, state->PyBitMatrixRowType)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "cannot re-initialize a BitMatrix row view");
+        return -1;
+    }
     PyBitVectorObject *bvself = (PyBitVectorObject *) self;
 
     if (bvself->bv != NULL) {
@@ -279,7 +285,8 @@ PyType_Spec PyBitVector_spec = {
              Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC |
              Py_TPFLAGS_SEQUENCE
 #if PY_VERSION_HEX >= 0x030C0000
-             | Py_TPFLAGS_MANAGED_WEAKREF,
+             | Py_TPFLAGS_MANAGED_WEAKREF
 #endif
+    ,
     .slots = BitVector_slots,
 };
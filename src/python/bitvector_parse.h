@@ -4,6 +4,7 @@
  *
  * Provides small, centralized utilities for validating and normalizing
  * BitVector method arguments:
+ * - \ref cbits_parse_index — validate an index against any length
  * - \ref bv_parse_index — validate and normalize a single index
  * - \ref bv_parse_tuple — parse ``(start, length)`` tuples
  *
@@ -20,6 +21,42 @@
 
 #include "bitvector_object.h"
 
+/**
+ * @brief Parse and validate an index against an arbitrary length.
+ *
+ * Shared by all cbits types that expose bit positions. Accepts a Python
+ * integer, normalizes negative indices relative to @p n_bits, and checks
+ * bounds.
+ *
+ * @param arg Python argument expected to be an integer.
+ * @param n_bits Length of the indexed object.
+ * @param p_index Output pointer receiving the validated index.
+ * @retval 0 Success; ``*p_index`` is set.
+ * @retval -1 Failure; a Python exception is set.
+ * @since 0.4.0
+ */
+static inline int
+cbits_parse_index(PyObject *arg, size_t n_bits, size_t *p_index)
+{
+    if (!PyLong_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "index must be an integer");
+        return -1;
+    }
+    Py_ssize_t index = PyLong_AsSsize_t(arg);
+    if (index == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (index < 0) {
+        index += (Py_ssize_t) n_bits;
+    }
+    if (index < 0 || (size_t) index >= n_bits) {
+        PyErr_SetString(PyExc_IndexError, "index out of range");
+        return -1;
+    }
+    *p_index = (size_t) index;
+    return 0;
+}
+
 /**
  * @brief Parse and validate a single index argument.
  *
@@ -0,0 +1,762 @@
+/**
+ * @file bloom_filter_object.c
+ * @brief Implementation of the ``BloomFilter`` and ``BlockedBloomFilter``
+ *        Python types.
+ *
+ * Both types share this implementation and differ only in the layout of
+ * the native filter. Keys are integers, strings (hashed as UTF-8) or
+ * bytes-like objects. ``add_many`` and ``contains_many`` take a whole batch
+ * at once - an iterable of keys, an integer buffer such as ``array('q')``,
+ * or packed fixed-width byte keys - and hash, insert or look up
+ * @ref PY_KEY_BATCH keys per native call, so no Python code runs per key.
+ *
+ * @see bloom_filter_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bloom_filter_object.h"
+
+/** @brief Shorthand for the native filter of a Python object. */
+#define BLOOM(o) (((PyBloomFilterObject *) (o))->f)
+
+/**
+ * @brief ``__new__`` for both Bloom filter types.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_bloom_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+             PyObject *Py_UNUSED(kwds))
+{
+    PyBloomFilterObject *self =
+        (PyBloomFilterObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->f = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief Layout that instances of a type use.
+ *
+ * @param type ``BloomFilter``, ``BlockedBloomFilter`` or a subclass.
+ * @return The native layout.
+ */
+static BloomLayout
+py_bloom_type_layout(PyTypeObject *type)
+{
+    cbits_state *state = find_cbits_state_by_type(type);
+    return PyType_IsSubtype(type, state->PyBlockedBloomFilterType)
+               ? BLOOM_BLOCKED
+               : BLOOM_CLASSIC;
+}
+
+/**
+ * @brief Wrap a native filter in a new object of the matching type.
+ *
+ * @param state Module state.
+ * @param f Filter; ownership is transferred, it is freed on failure.
+ * @retval object New ``BloomFilter`` or ``BlockedBloomFilter``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_wrap(cbits_state *state, BloomFilter *f)
+{
+    PyTypeObject *type = f->layout == BLOOM_BLOCKED
+                             ? state->PyBlockedBloomFilterType
+                             : state->PyBloomFilterType;
+    PyBloomFilterObject *obj =
+        (PyBloomFilterObject *) type->tp_alloc(type, 0);
+    if (!obj) {
+        bloom_free(f);
+        return NULL;
+    }
+    obj->f = f;
+    return (PyObject *) obj;
+}
+
+/**
+ * @brief ``__init__(capacity, error_rate=0.01, *, hash="xxh64", seed=0)``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bloom_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t capacity;
+    double error_rate = 0.01;
+    const char *hash_name = "xxh64";
+    PyObject *seed_obj = NULL;
+    static char *kwlist[] = {"capacity", "error_rate", "hash", "seed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|d$sO", kwlist, &capacity,
+                                     &error_rate, &hash_name, &seed_obj)) {
+        return -1;
+    }
+    if (capacity < 0) {
+        PyErr_SetString(PyExc_ValueError, "capacity must be >= 0");
+        return -1;
+    }
+    KeyHash hash;
+    uint64_t seed;
+    if (py_key_hash_parse(hash_name, seed_obj, &hash, &seed) < 0) {
+        return -1;
+    }
+    const BloomLayout layout = py_bloom_type_layout(Py_TYPE(self));
+    size_t n_bits;
+    unsigned n_hashes;
+    if (bloom_params(layout, (size_t) capacity, error_rate, &n_bits,
+                     &n_hashes) < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "error_rate must be between 0 and 1 (exclusive)");
+        return -1;
+    }
+    BloomFilter *f = bloom_new(layout, n_bits, n_hashes, hash, seed);
+    if (!f) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BloomFilter");
+        return -1;
+    }
+    bloom_free(BLOOM(self));
+    BLOOM(self) = f;
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_bloom_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyBloomFilterObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bloom_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    bloom_free(BLOOM(object));
+    BLOOM(object) = NULL;
+    type->tp_free(object);
+    Py_DECREF(type);
+}
+
+/**
+ * @brief Python binding for ``add(key)``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param key Key to insert.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_add(PyObject *self, PyObject *key)
+{
+    uint64_t h;
+    if (py_key_hash(BLOOM(self)->hash, BLOOM(self)->seed, key, &h) < 0) {
+        return NULL;
+    }
+    bloom_add_hash(BLOOM(self), h);
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Implement ``key in filter``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param key Key to look up.
+ * @retval 1 The key may be present.
+ * @retval 0 The key is absent.
+ * @retval -1 Unsupported key (exception set).
+ */
+static int
+py_bloom_contains(PyObject *self, PyObject *key)
+{
+    uint64_t h;
+    if (py_key_hash(BLOOM(self)->hash, BLOOM(self)->seed, key, &h) < 0) {
+        return -1;
+    }
+    return bloom_contains_hash(BLOOM(self), h);
+}
+
+/**
+ * @brief Python binding for ``add_many(keys, width=None)``.
+ *
+ * Keys hashed before an unsupported key stay inserted.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_add_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *keys, *width = NULL;
+    static char *kwlist[] = {"keys", "width", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &keys,
+                                     &width)) {
+        return NULL;
+    }
+    PyKeyBatch k;
+    if (py_key_batch_open(keys, width, &k) < 0) {
+        py_key_batch_close(&k);
+        return NULL;
+    }
+    uint64_t hashes[PY_KEY_BATCH];
+    for (size_t start = 0; start < k.n; start += PY_KEY_BATCH) {
+        size_t count = k.n - start < PY_KEY_BATCH ? k.n - start : PY_KEY_BATCH;
+        if (py_key_batch_hash(BLOOM(self)->hash, BLOOM(self)->seed, &k,
+                              start, count, hashes) < 0) {
+            py_key_batch_close(&k);
+            return NULL;
+        }
+        bloom_add_hashes(BLOOM(self), hashes, count);
+    }
+    py_key_batch_close(&k);
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Python binding for ``contains_many(keys, width=None)``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval BitVector Bit @c i is set if key @c i may be present.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_contains_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *keys, *width = NULL;
+    static char *kwlist[] = {"keys", "width", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &keys,
+                                     &width)) {
+        return NULL;
+    }
+    PyKeyBatch k;
+    if (py_key_batch_open(keys, width, &k) < 0) {
+        py_key_batch_close(&k);
+        return NULL;
+    }
+    BitVector *found = bv_new(k.n);
+    if (!found) {
+        py_key_batch_close(&k);
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    uint64_t hashes[PY_KEY_BATCH];
+    for (size_t start = 0; start < k.n; start += PY_KEY_BATCH) {
+        size_t count = k.n - start < PY_KEY_BATCH ? k.n - start : PY_KEY_BATCH;
+        if (py_key_batch_hash(BLOOM(self)->hash, BLOOM(self)->seed, &k,
+                              start, count, hashes) < 0) {
+            py_key_batch_close(&k);
+            bv_free(found);
+            return NULL;
+        }
+        /* PY_KEY_BATCH is a multiple of 64, so batches start on a word. */
+        bloom_contains_hashes(BLOOM(self), hashes, count,
+                              found->data + (start >> 6));
+    }
+    py_key_batch_close(&k);
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, found);
+}
+
+/**
+ * @brief Python binding for ``estimate_count()``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param ignored Unused.
+ * @return Estimated number of distinct keys as a float.
+ */
+static PyObject *
+py_bloom_estimate_count(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyFloat_FromDouble(bloom_estimate_count(BLOOM(self)));
+}
+
+/**
+ * @brief Python binding for ``copy()``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param ignored Unused.
+ * @retval object Independent copy.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_copy(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    BloomFilter *f = bloom_copy(BLOOM(self));
+    if (!f) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BloomFilter");
+        return NULL;
+    }
+    return py_bloom_wrap(find_cbits_state_by_type(Py_TYPE(self)), f);
+}
+
+/**
+ * @brief Python binding for ``to_bitvector()``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param ignored Unused.
+ * @retval BitVector Copy of the filter bits.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_to_bitvector(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    BitVector *bv = bv_copy(BLOOM(self)->bits);
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Python binding for ``to_bytes()``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param ignored Unused.
+ * @retval bytes Serialized filter.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_to_bytes(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t n;
+    uint8_t *data = bloom_serialize(BLOOM(self), &n);
+    if (!data) {
+        return PyErr_NoMemory();
+    }
+    PyObject *bytes = PyBytes_FromStringAndSize((const char *) data,
+                                                (Py_ssize_t) n);
+    free(data);
+    return bytes;
+}
+
+/**
+ * @brief Python binding for the class method ``from_bytes(data)``.
+ *
+ * @param type ``BloomFilter``, ``BlockedBloomFilter`` or a subclass.
+ * @param arg Bytes-like object produced by ``to_bytes``.
+ * @retval object New filter.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_from_bytes(PyObject *type, PyObject *arg)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(arg, &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    BloomFilter *f = bloom_deserialize(view.buf, (size_t) view.len);
+    PyBuffer_Release(&view);
+    if (!f) {
+        PyErr_SetString(PyExc_ValueError, "invalid serialized Bloom filter");
+        return NULL;
+    }
+    if (f->layout != py_bloom_type_layout((PyTypeObject *) type)) {
+        PyErr_Format(PyExc_ValueError,
+                     "data holds a %s Bloom filter, not a %s",
+                     f->layout == BLOOM_BLOCKED ? "blocked" : "classic",
+                     ((PyTypeObject *) type)->tp_name);
+        bloom_free(f);
+        return NULL;
+    }
+    PyBloomFilterObject *obj = (PyBloomFilterObject *) ((PyTypeObject *) type)
+                                   ->tp_alloc((PyTypeObject *) type, 0);
+    if (!obj) {
+        bloom_free(f);
+        return NULL;
+    }
+    obj->f = f;
+    return (PyObject *) obj;
+}
+
+/**
+ * @brief Implement ``__reduce__`` for pickling through ``to_bytes``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param ignored Unused.
+ * @retval tuple ``(type(self).from_bytes, (data,))``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bloom_reduce(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *ctor =
+        PyObject_GetAttrString((PyObject *) Py_TYPE(self), "from_bytes");
+    if (!ctor) {
+        return NULL;
+    }
+    PyObject *data = py_bloom_to_bytes(self, NULL);
+    if (!data) {
+        Py_DECREF(ctor);
+        return NULL;
+    }
+    return Py_BuildValue("(N(N))", ctor, data);
+}
+
+/**
+ * @brief Implement ``__sizeof__``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_bloom_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total = (size_t) Py_TYPE(self)->tp_basicsize +
+                   bloom_memory_usage(BLOOM(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Shared body of the binary and in-place set operators.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @param op @ref bloom_union or @ref bloom_intersect.
+ * @param inplace Modify @p a instead of returning a new filter.
+ * @retval object Result filter.
+ * @retval Py_NotImplemented Operands are not both Bloom filters.
+ * @retval NULL Incompatible filters or allocation failure (exception set).
+ */
+static PyObject *
+py_bloom_binary(PyObject *a, PyObject *b,
+                int (*op)(BloomFilter *, const BloomFilter *), int inplace)
+{
+    cbits_state *state = find_cbits_state_by_operands(a, b);
+    if (!state || !py_bloom_filter_check(a, state) ||
+        !py_bloom_filter_check(b, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (!bloom_compatible(BLOOM(a), BLOOM(b))) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Bloom filters differ in type, size, hash or seed");
+        return NULL;
+    }
+    if (inplace) {
+        op(BLOOM(a), BLOOM(b));
+        Py_INCREF(a);
+        return a;
+    }
+    BloomFilter *f = bloom_copy(BLOOM(a));
+    if (!f) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BloomFilter");
+        return NULL;
+    }
+    op(f, BLOOM(b));
+    return py_bloom_wrap(state, f);
+}
+
+/** @brief Implement ``a | b``. */
+static PyObject *
+py_bloom_or(PyObject *a, PyObject *b)
+{
+    return py_bloom_binary(a, b, bloom_union, 0);
+}
+
+/** @brief Implement ``a & b``. */
+static PyObject *
+py_bloom_and(PyObject *a, PyObject *b)
+{
+    return py_bloom_binary(a, b, bloom_intersect, 0);
+}
+
+/** @brief Implement ``a |= b``. */
+static PyObject *
+py_bloom_ior(PyObject *a, PyObject *b)
+{
+    return py_bloom_binary(a, b, bloom_union, 1);
+}
+
+/** @brief Implement ``a &= b``. */
+static PyObject *
+py_bloom_iand(PyObject *a, PyObject *b)
+{
+    return py_bloom_binary(a, b, bloom_intersect, 1);
+}
+
+/**
+ * @brief Rich comparison; only ``==`` and ``!=`` are supported.
+ *
+ * Filters are equal if they are compatible and have the same bits.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @param op Comparison operator.
+ * @return ``True``, ``False`` or ``NotImplemented``.
+ */
+static PyObject *
+py_bloom_richcompare(PyObject *a, PyObject *b, int op)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(a));
+    if ((op != Py_EQ && op != Py_NE) || !py_bloom_filter_check(b, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    bool equal = bloom_compatible(BLOOM(a), BLOOM(b)) &&
+                 bv_equal(BLOOM(a)->bits, BLOOM(b)->bits);
+    return PyBool_FromLong(op == Py_EQ ? equal : !equal);
+}
+
+/**
+ * @brief Implement ``repr()``.
+ *
+ * @param self A ``PyBloomFilterObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_bloom_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat("<%s object at %p bits=%zu hashes=%u>",
+                                Py_TYPE(self)->tp_name, self,
+                                BLOOM(self)->bits->n_bits,
+                                BLOOM(self)->n_hashes);
+}
+
+/** @brief Getter for the read-only ``bits`` property. */
+static PyObject *
+py_bloom_get_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(BLOOM(self)->bits->n_bits);
+}
+
+/** @brief Getter for the read-only ``hashes`` property. */
+static PyObject *
+py_bloom_get_hashes(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(BLOOM(self)->n_hashes);
+}
+
+/** @brief Getter for the read-only ``hash`` property. */
+static PyObject *
+py_bloom_get_hash(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyUnicode_FromString(py_key_hash_name(BLOOM(self)->hash));
+}
+
+/** @brief Getter for the read-only ``seed`` property. */
+static PyObject *
+py_bloom_get_seed(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLongLong(BLOOM(self)->seed);
+}
+
+#undef BLOOM
+
+/** @brief Docstring for ``add_many``. */
+PyDoc_STRVAR(py_bloom_add_many__doc__,
+             "add_many(keys, width: int | None = None) -> None\n"
+             "\n"
+             "Insert a batch of keys: an iterable of int, str or bytes-like "
+             "keys, an integer buffer such as array('q') (one key per item, "
+             "native byte order), or with width a bytes-like object of "
+             "packed width-byte keys.");
+/** @brief Docstring for ``contains_many``. */
+PyDoc_STRVAR(py_bloom_contains_many__doc__,
+             "contains_many(keys, width: int | None = None) -> BitVector\n"
+             "\n"
+             "Look up a batch of keys given like in add_many. Bit i of the "
+             "result is set if key i may be present and clear if it is "
+             "definitely absent.");
+/** @brief Docstring for ``estimate_count``. */
+PyDoc_STRVAR(py_bloom_estimate_count__doc__,
+             "estimate_count() -> float\n"
+             "\n"
+             "Estimate the number of distinct keys inserted from the number "
+             "of set bits; inf once every bit is set.");
+/** @brief Docstring for ``to_bytes``. */
+PyDoc_STRVAR(py_bloom_to_bytes__doc__,
+             "to_bytes() -> bytes\n"
+             "\n"
+             "Serialize the filter, including its size, hash and seed, into "
+             "a portable byte string.");
+/** @brief Docstring for ``from_bytes``. */
+PyDoc_STRVAR(py_bloom_from_bytes__doc__,
+             "from_bytes(data: bytes) -> filter\n"
+             "\n"
+             "Rebuild a filter serialized by to_bytes. Raises ValueError for "
+             "malformed data or a filter of the other layout.");
+
+/**
+ * @brief Method table shared by both Bloom filter types.
+ */
+static PyMethodDef PyBloomFilter_methods[] = {
+    {"add", (PyCFunction) py_bloom_add, METH_O,
+     PyDoc_STR("add(key: int | str | bytes) -> None\n\nInsert one key.")},
+    {"add_many", (PyCFunction) (void (*)(void)) py_bloom_add_many,
+     METH_VARARGS | METH_KEYWORDS, py_bloom_add_many__doc__},
+    {"contains_many", (PyCFunction) (void (*)(void)) py_bloom_contains_many,
+     METH_VARARGS | METH_KEYWORDS, py_bloom_contains_many__doc__},
+    {"estimate_count", (PyCFunction) py_bloom_estimate_count, METH_NOARGS,
+     py_bloom_estimate_count__doc__},
+    {"copy", (PyCFunction) py_bloom_copy, METH_NOARGS,
+     PyDoc_STR("copy() -> filter\n\nReturn an independent copy.")},
+    {"to_bitvector", (PyCFunction) py_bloom_to_bitvector, METH_NOARGS,
+     PyDoc_STR("to_bitvector() -> BitVector\n\n"
+               "Return a copy of the filter bits.")},
+    {"to_bytes", (PyCFunction) py_bloom_to_bytes, METH_NOARGS,
+     py_bloom_to_bytes__doc__},
+    {"from_bytes", (PyCFunction) py_bloom_from_bytes, METH_O | METH_CLASS,
+     py_bloom_from_bytes__doc__},
+    {"__reduce__", (PyCFunction) py_bloom_reduce, METH_NOARGS,
+     PyDoc_STR("__reduce__() -> tuple\n\nSupport for pickle.")},
+    {"__sizeof__", (PyCFunction) py_bloom_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table shared by both Bloom filter types.
+ */
+static PyGetSetDef PyBloomFilter_getset[] = {
+    {"bits", py_bloom_get_bits, NULL,
+     PyDoc_STR("Number of bits of the filter.")},
+    {"hashes", py_bloom_get_hashes, NULL,
+     PyDoc_STR("Number of bits set per key.")},
+    {"hash", py_bloom_get_hash, NULL,
+     PyDoc_STR("Name of the key hash function.")},
+    {"seed", py_bloom_get_seed, NULL, PyDoc_STR("Seed of the key hash.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``BloomFilter`` type. */
+PyDoc_STRVAR(
+    PyBloomFilter__doc__,
+    "BloomFilter(capacity: int, error_rate: float = 0.01, *, "
+    "hash: str = 'xxh64', seed: int = 0)\n"
+    "\n"
+    "A Bloom filter: a set that answers membership queries with a bounded "
+    "rate of false positives and no false negatives.\n\n"
+    "The bits live in a BitVector sized for capacity keys at error_rate. "
+    "Keys are ints (taken as 64-bit two's complement), str (UTF-8) or "
+    "bytes-like objects. Filters with the same size, hash and seed can be "
+    "combined with | (union) and & (intersection), and round-trip through "
+    "to_bytes/from_bytes and pickle.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "capacity : int\n"
+    "   Expected number of keys.\n"
+    "error_rate : float, optional\n"
+    "   Target false positive rate at capacity.\n"
+    "hash : str, optional\n"
+    "   'xxh64' (default) or 'fnv1a'.\n"
+    "seed : int, optional\n"
+    "   Seed of the key hash.\n");
+
+/** @brief Docstring for the ``BlockedBloomFilter`` type. */
+PyDoc_STRVAR(
+    PyBlockedBloomFilter__doc__,
+    "BlockedBloomFilter(capacity: int, error_rate: float = 0.01, *, "
+    "hash: str = 'xxh64', seed: int = 0)\n"
+    "\n"
+    "A cache-line blocked Bloom filter.\n\n"
+    "Every key sets all of its bits inside one 512-bit block, so inserts "
+    "and lookups touch a single cache line. This makes it faster than "
+    "BloomFilter on large filters, at a slightly higher false positive "
+    "rate for the same size. The interface is that of BloomFilter.\n");
+
+/**
+ * @brief Slot table for the ``BloomFilter`` type.
+ */
+static PyType_Slot PyBloomFilter_slots[] = {
+    {Py_tp_doc, (void *) PyBloomFilter__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bloom_new},
+    {Py_tp_init, py_bloom_init},
+    {Py_tp_traverse, py_bloom_traverse},
+    {Py_tp_dealloc, py_bloom_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBloomFilter_methods},
+    {Py_tp_getset, PyBloomFilter_getset},
+    {Py_tp_repr, py_bloom_repr},
+    {Py_tp_richcompare, py_bloom_richcompare},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+
+    {Py_sq_contains, py_bloom_contains},
+
+    {Py_nb_or, py_bloom_or},
+    {Py_nb_and, py_bloom_and},
+    {Py_nb_inplace_or, py_bloom_ior},
+    {Py_nb_inplace_and, py_bloom_iand},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Slot table for the ``BlockedBloomFilter`` type.
+ */
+static PyType_Slot PyBlockedBloomFilter_slots[] = {
+    {Py_tp_doc, (void *) PyBlockedBloomFilter__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bloom_new},
+    {Py_tp_init, py_bloom_init},
+    {Py_tp_traverse, py_bloom_traverse},
+    {Py_tp_dealloc, py_bloom_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBloomFilter_methods},
+    {Py_tp_getset, PyBloomFilter_getset},
+    {Py_tp_repr, py_bloom_repr},
+    {Py_tp_richcompare, py_bloom_richcompare},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+
+    {Py_sq_contains, py_bloom_contains},
+
+    {Py_nb_or, py_bloom_or},
+    {Py_nb_and, py_bloom_and},
+    {Py_nb_inplace_or, py_bloom_ior},
+    {Py_nb_inplace_and, py_bloom_iand},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``BloomFilter``.
+ */
+PyType_Spec PyBloomFilter_spec = {
+    .name = "cbits.BloomFilter",
+    .basicsize = sizeof(PyBloomFilterObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBloomFilter_slots,
+};
+
+/**
+ * @brief Type specification for ``BlockedBloomFilter``.
+ */
+PyType_Spec PyBlockedBloomFilter_spec = {
+    .name = "cbits.BlockedBloomFilter",
+    .basicsize = sizeof(PyBloomFilterObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBlockedBloomFilter_slots,
+};
@@ -0,0 +1,35 @@
+/**
+ * @file bloom_filter_object.h
+ * @brief Definition of the ``BloomFilter`` and ``BlockedBloomFilter`` Python
+ *        types.
+ *
+ * Declares the Python wrapper shared by both Bloom filter layouts:
+ * - \ref PyBloomFilterObject - the Python object structure
+ * - the type specifications used to create the two Python types
+ *
+ * @see bloom_filter.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BLOOM_FILTER_OBJECT_H
+#define CBITS_PY_BLOOM_FILTER_OBJECT_H
+
+#include "bloom_filter.h"
+#include "bitvector_object.h"
+#include "key_batch.h"
+
+/**
+ * @brief Python object wrapping a native ``BloomFilter``.
+ *
+ * The layout of @c f matches the Python type: classic for ``BloomFilter``,
+ * blocked for ``BlockedBloomFilter``.
+ */
+typedef struct {
+    PyObject_HEAD BloomFilter *f; /**< Underlying filter */
+} PyBloomFilterObject;
+
+extern PyType_Spec PyBloomFilter_spec;
+extern PyType_Spec PyBlockedBloomFilter_spec;
+
+#endif /* CBITS_PY_BLOOM_FILTER_OBJECT_H */
@@ -0,0 +1,423 @@
+/**
+ * @file bp_tree_object.c
+ * @brief Implementation of the ``BPTree`` Python type.
+ *
+ * Exposes the range min-max tree over a balanced-parentheses ``BitVector``:
+ * the parentheses primitives and the derived tree navigation. Positions
+ * that have no answer (a root's parent, a leaf's first child, ...) yield
+ * ``None``.
+ *
+ * @see bp_tree_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "bp_tree_object.h"
+#include "bitvector_object.h"
+#include "bitvector_parse.h"
+
+/**
+ * @brief ``__new__`` for ``BPTree``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_bp_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+          PyObject *Py_UNUSED(kwds))
+{
+    PyBPTreeObject *self = (PyBPTreeObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->bp = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief ``__init__`` for ``BPTree(bv)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bp_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *source;
+    static char *kwlist[] = {"bv", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &source)) {
+        return -1;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(source, state)) {
+        PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+        return -1;
+    }
+    PyBPTreeObject *obj = (PyBPTreeObject *) self;
+    bp_free(obj->bp);
+    obj->bp = bp_new(((PyBitVectorObject *) source)->bv);
+    if (!obj->bp) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BPTree");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_bp_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyBPTreeObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_bp_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyBPTreeObject *self = (PyBPTreeObject *) object;
+    bp_free(self->bp);
+    self->bp = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native index of a Python object. */
+#define BP(o) (((PyBPTreeObject *) (o))->bp)
+
+/**
+ * @brief Parse a position and check which parenthesis it holds.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Python index (negative values count from the end).
+ * @param want_open ``1`` if the position must hold '(', ``0`` for ')'.
+ * @param out Receives the position.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_bp_parse_pos(PyObject *self, PyObject *arg, int want_open, size_t *out)
+{
+    if (cbits_parse_index(arg, BP(self)->bv->n_bits, out) < 0) {
+        return -1;
+    }
+    if (bv_get(BP(self)->bv, *out) != want_open) {
+        PyErr_Format(PyExc_ValueError,
+                     "position %zu is not an %s parenthesis", *out,
+                     want_open ? "opening" : "closing");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Run a position query and map ``SIZE_MAX`` to ``None``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Python index.
+ * @param want_open Parenthesis the position must hold.
+ * @param query Native query.
+ * @retval int Resulting position.
+ * @retval Py_None if the query has no answer.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bp_query(PyObject *self, PyObject *arg, int want_open,
+            size_t (*query)(const BPTree *, size_t))
+{
+    size_t pos;
+    if (py_bp_parse_pos(self, arg, want_open, &pos) < 0) {
+        return NULL;
+    }
+    size_t result = query(BP(self), pos);
+    if (result == SIZE_MAX) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromSize_t(result);
+}
+
+/**
+ * @brief Python binding for ``BPTree.find_close(i)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Position of an opening parenthesis.
+ * @return Matching position, ``None`` if unmatched, ``NULL`` on error.
+ */
+static PyObject *
+py_bp_find_close(PyObject *self, PyObject *arg)
+{
+    return py_bp_query(self, arg, 1, bp_find_close);
+}
+
+/**
+ * @brief Python binding for ``BPTree.find_open(i)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Position of a closing parenthesis.
+ * @return Matching position, ``None`` if unmatched, ``NULL`` on error.
+ */
+static PyObject *
+py_bp_find_open(PyObject *self, PyObject *arg)
+{
+    return py_bp_query(self, arg, 0, bp_find_open);
+}
+
+/**
+ * @brief Python binding for ``BPTree.enclose(i)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Position of an opening parenthesis.
+ * @return Enclosing opening position, ``None`` at top level, ``NULL`` on
+ *         error.
+ */
+static PyObject *
+py_bp_enclose(PyObject *self, PyObject *arg)
+{
+    return py_bp_query(self, arg, 1, bp_enclose);
+}
+
+/**
+ * @brief Python binding for ``BPTree.parent(v)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Node.
+ * @return Parent node, ``None`` for a root, ``NULL`` on error.
+ */
+static PyObject *
+py_bp_parent(PyObject *self, PyObject *arg)
+{
+    return py_bp_query(self, arg, 1, bp_parent);
+}
+
+/**
+ * @brief Python binding for ``BPTree.first_child(v)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Node.
+ * @return First child, ``None`` for a leaf, ``NULL`` on error.
+ */
+static PyObject *
+py_bp_first_child(PyObject *self, PyObject *arg)
+{
+    return py_bp_query(self, arg, 1, bp_first_child);
+}
+
+/**
+ * @brief Python binding for ``BPTree.next_sibling(v)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Node.
+ * @return Next sibling, ``None`` for a last child, ``NULL`` on error.
+ */
+static PyObject *
+py_bp_next_sibling(PyObject *self, PyObject *arg)
+{
+    return py_bp_query(self, arg, 1, bp_next_sibling);
+}
+
+/**
+ * @brief Python binding for ``BPTree.subtree_size(v)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Node.
+ * @retval int Number of nodes in the subtree of ``v``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bp_subtree_size(PyObject *self, PyObject *arg)
+{
+    size_t pos;
+    if (py_bp_parse_pos(self, arg, 1, &pos) < 0) {
+        return NULL;
+    }
+    size_t size = bp_subtree_size(BP(self), pos);
+    if (size == 0) {
+        PyErr_Format(PyExc_ValueError, "parenthesis at %zu is unmatched",
+                     pos);
+        return NULL;
+    }
+    return PyLong_FromSize_t(size);
+}
+
+/**
+ * @brief Python binding for ``BPTree.excess(i)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param arg Position.
+ * @retval int Opening minus closing parentheses in ``[0..i]``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_bp_excess(PyObject *self, PyObject *arg)
+{
+    size_t pos;
+    if (cbits_parse_index(arg, BP(self)->bv->n_bits, &pos) < 0) {
+        return NULL;
+    }
+    return PyLong_FromLongLong((long long) bp_excess(BP(self), pos));
+}
+
+/**
+ * @brief Implement ``BPTree.__sizeof__``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_bp_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total =
+        (size_t) Py_TYPE(self)->tp_basicsize + bp_memory_usage(BP(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``len(BPTree)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @return Number of parentheses.
+ */
+static Py_ssize_t
+py_bp_len(PyObject *self)
+{
+    return (Py_ssize_t) BP(self)->bv->n_bits;
+}
+
+/**
+ * @brief Implement ``repr(BPTree)``.
+ *
+ * @param self A ``PyBPTreeObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_bp_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat("<cbits.BPTree object at %p len=%zu>", self,
+                                BP(self)->bv->n_bits);
+}
+
+#undef BP
+
+/** @brief Docstring for ``BPTree.excess``. */
+PyDoc_STRVAR(py_bp_excess__doc__,
+             "excess(i: int) -> int\n"
+             "\n"
+             "Return the number of opening minus closing parentheses in "
+             "[0..i].");
+/** @brief Docstring for ``BPTree.find_close``. */
+PyDoc_STRVAR(py_bp_find_close__doc__,
+             "find_close(i: int) -> int | None\n"
+             "\n"
+             "Return the position of the ')' matching the '(' at i, or None "
+             "if it is unmatched. Raises ValueError if i holds ')'.");
+/** @brief Docstring for ``BPTree.find_open``. */
+PyDoc_STRVAR(py_bp_find_open__doc__,
+             "find_open(i: int) -> int | None\n"
+             "\n"
+             "Return the position of the '(' matching the ')' at i, or None "
+             "if it is unmatched. Raises ValueError if i holds '('.");
+/** @brief Docstring for ``BPTree.enclose``. */
+PyDoc_STRVAR(py_bp_enclose__doc__,
+             "enclose(i: int) -> int | None\n"
+             "\n"
+             "Return the opening position of the tightest pair strictly "
+             "enclosing the '(' at i, or None at the top level.");
+/** @brief Docstring for ``BPTree.subtree_size``. */
+PyDoc_STRVAR(py_bp_subtree_size__doc__,
+             "subtree_size(v: int) -> int\n"
+             "\n"
+             "Return the number of nodes in the subtree rooted at v, "
+             "including v.");
+
+/**
+ * @brief Method table for the BPTree type.
+ */
+static PyMethodDef PyBPTree_methods[] = {
+    {"excess", (PyCFunction) py_bp_excess, METH_O, py_bp_excess__doc__},
+    {"find_close", (PyCFunction) py_bp_find_close, METH_O,
+     py_bp_find_close__doc__},
+    {"find_open", (PyCFunction) py_bp_find_open, METH_O,
+     py_bp_find_open__doc__},
+    {"enclose", (PyCFunction) py_bp_enclose, METH_O, py_bp_enclose__doc__},
+    {"parent", (PyCFunction) py_bp_parent, METH_O,
+     PyDoc_STR("parent(v: int) -> int | None\n\n"
+               "Return the parent of node v, or None for a root.")},
+    {"first_child", (PyCFunction) py_bp_first_child, METH_O,
+     PyDoc_STR("first_child(v: int) -> int | None\n\n"
+               "Return the first child of node v, or None for a leaf.")},
+    {"next_sibling", (PyCFunction) py_bp_next_sibling, METH_O,
+     PyDoc_STR("next_sibling(v: int) -> int | None\n\n"
+               "Return the next sibling of node v, or None.")},
+    {"subtree_size", (PyCFunction) py_bp_subtree_size, METH_O,
+     py_bp_subtree_size__doc__},
+    {"__sizeof__", (PyCFunction) py_bp_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/** @brief Docstring for the ``BPTree`` type. */
+PyDoc_STRVAR(
+    PyBPTree__doc__,
+    "BPTree(bv: BitVector)\n"
+    "\n"
+    "Navigation index over an ordinal tree in balanced-parentheses form.\n\n"
+    "A set bit is '(' and a clear bit is ')'; every node is identified by "
+    "the position of its '('. A range min-max tree over the excess makes "
+    "find_close, find_open, enclose and the derived tree operations "
+    "logarithmic.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "bv : BitVector\n"
+    "   The parentheses; copied, so later changes are not reflected.\n");
+
+/**
+ * @brief Slot table for the ``BPTree`` type.
+ */
+static PyType_Slot PyBPTree_slots[] = {
+    {Py_tp_doc, (void *) PyBPTree__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_bp_new},
+    {Py_tp_init, py_bp_init},
+    {Py_tp_traverse, py_bp_traverse},
+    {Py_tp_dealloc, py_bp_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyBPTree_methods},
+    {Py_tp_repr, py_bp_repr},
+
+    {Py_sq_length, py_bp_len},
+    {Py_mp_length, py_bp_len},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``BPTree``.
+ */
+PyType_Spec PyBPTree_spec = {
+    .name = "cbits.BPTree",
+    .basicsize = sizeof(PyBPTreeObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyBPTree_slots,
+};
@@ -0,0 +1,29 @@
+/**
+ * @file bp_tree_object.h
+ * @brief Definition of the ``BPTree`` Python type.
+ *
+ * Declares the Python wrapper for the balanced-parentheses tree index:
+ * - \ref PyBPTreeObject - the Python object structure
+ * - the type specification used to create the Python type
+ *
+ * @see bp_tree.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_BP_TREE_OBJECT_H
+#define CBITS_PY_BP_TREE_OBJECT_H
+
+#include "bp_tree.h"
+#include "cbits_state.h"
+
+/**
+ * @brief Python object wrapping a native ``BPTree`` instance.
+ */
+typedef struct {
+    PyObject_HEAD BPTree *bp; /**< Underlying index */
+} PyBPTreeObject;
+
+extern PyType_Spec PyBPTree_spec;
+
+#endif /* CBITS_PY_BP_TREE_OBJECT_H */
@@ -0,0 +1,56 @@
+/**
+ * @file cbits_counters.c
+ * @brief Implementation of the counter bindings.
+ *
+ * Turns the process-wide counters of the core library into a dict, so a
+ * service can tell whether its time goes into rank rebuilds, allocations,
+ * bitwise passes, subvector searches, hashing or slice copies, and
+ * reports the bytes held by all native allocations for memory dashboards.
+ *
+ * @see cbits_counters.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "cbits_counters.h"
+#include "bitvector.h"
+
+PyObject *
+py_cbits_stats(PyObject *module, PyObject *args, PyObject *kwds)
+{
+    (void) module;
+    int reset = 0;
+    static char *kwlist[] = {"reset", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &reset)) {
+        return NULL;
+    }
+    if (!cbits_stats_enabled()) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "cbits was built with CBITS_STATS=OFF");
+        return NULL;
+    }
+    PyObject *dict = PyDict_New();
+    if (!dict) {
+        return NULL;
+    }
+    for (int s = 0; s < CBITS_STAT_COUNT; ++s) {
+        const cbits_stat stat = (cbits_stat) s;
+        PyObject *value =
+            PyLong_FromUnsignedLongLong(cbits_stats_read(stat, reset));
+        if (!value ||
+            PyDict_SetItemString(dict, cbits_stat_name(stat), value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    return dict;
+}
+
+PyObject *
+py_cbits_live_bytes(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    (void) module;
+    return PyLong_FromSize_t(cbits_live_bytes());
+}
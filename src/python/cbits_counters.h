@@ -0,0 +1,47 @@
+/**
+ * @file cbits_counters.h
+ * @brief Module-level readout of the hot-path counters and live memory.
+ *
+ * Declares the Python bindings of the counter API in cbits_stats.h and of
+ * the live byte total in bitvector.h:
+ * - ``stats``
+ * - ``live_bytes``
+ *
+ * The functions are registered in the module method table of
+ * ``cbits_module.c``.
+ *
+ * @see cbits_stats.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_COUNTERS_H
+#define CBITS_PY_COUNTERS_H
+
+#define PY_SSIZE_T_CLEAN
+#include "Python.h"
+
+/**
+ * @brief Python binding for ``stats(reset=False)``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval dict Counter name to value.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_stats(PyObject *module, PyObject *args, PyObject *kwds);
+
+/**
+ * @brief Python binding for ``live_bytes()``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param ignored Always NULL.
+ * @retval int Bytes held by all live native allocations.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_live_bytes(PyObject *module, PyObject *ignored);
+
+#endif /* CBITS_PY_COUNTERS_H */
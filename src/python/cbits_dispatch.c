@@ -0,0 +1,125 @@
+/**
+ * @file cbits_dispatch.c
+ * @brief Implementation of the kernel dispatch bindings.
+ *
+ * Reports the CPU features and the kernel each dispatched operation runs,
+ * and lets tests and benchmarks switch kernels at run time, e.g. to
+ * compare the AVX2 and AVX-512 popcounts on the same machine.
+ *
+ * @see cbits_dispatch.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "cbits_dispatch.h"
+#include "compat.h"
+
+/**
+ * @brief Feature bits reported by ``cpu_features``, with their names.
+ */
+static const struct {
+    const char *name; /**< Key in the returned dict. */
+    unsigned bit;     /**< Bit of cbits_cpu_features(). */
+} py_cbits_features[] = {
+    {"popcnt", CBITS_CPU_POPCNT},
+    {"avx2", CBITS_CPU_AVX2},
+    {"avx512f", CBITS_CPU_AVX512F},
+    {"avx512vpopcntdq", CBITS_CPU_AVX512VPOPCNTDQ},
+    {"avx512bw", CBITS_CPU_AVX512BW},
+};
+
+PyObject *
+py_cbits_cpu_features(PyObject *module, PyObject *unused)
+{
+    (void) module;
+    (void) unused;
+    PyObject *dict = PyDict_New();
+    if (!dict) {
+        return NULL;
+    }
+    const unsigned features = cbits_cpu_features();
+    for (size_t i = 0; i < sizeof(py_cbits_features) /
+                               sizeof(py_cbits_features[0]);
+         ++i) {
+        PyObject *flag =
+            (features & py_cbits_features[i].bit) ? Py_True : Py_False;
+        if (PyDict_SetItemString(dict, py_cbits_features[i].name, flag) <
+            0) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+    }
+    return dict;
+}
+
+PyObject *
+py_cbits_active_kernels(PyObject *module, PyObject *unused)
+{
+    (void) module;
+    (void) unused;
+    PyObject *dict = PyDict_New();
+    if (!dict) {
+        return NULL;
+    }
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        const cbits_dispatch_op op = (cbits_dispatch_op) o;
+        PyObject *name =
+            PyUnicode_FromString(cbits_kernel_name(cbits_active_kernel(op)));
+        if (!name ||
+            PyDict_SetItemString(dict, cbits_dispatch_op_name(op), name) <
+                0) {
+            Py_XDECREF(name);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(name);
+    }
+    return dict;
+}
+
+PyObject *
+py_cbits_set_kernel(PyObject *module, PyObject *args, PyObject *kwds)
+{
+    (void) module;
+    const char *op_name;
+    const char *kernel_name;
+    static char *kwlist[] = {"op", "kernel", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "zs", kwlist, &op_name,
+                                     &kernel_name)) {
+        return NULL;
+    }
+    cbits_dispatch_op op = CBITS_OP_COUNT;
+    if (op_name) {
+        op = cbits_dispatch_op_from_name(op_name);
+        if (op == CBITS_OP_COUNT) {
+            PyErr_Format(PyExc_ValueError, "unknown operation '%s'",
+                         op_name);
+            return NULL;
+        }
+    }
+    const int kernel = cbits_kernel_from_name(kernel_name);
+    if (kernel < 0) {
+        PyErr_Format(PyExc_ValueError, "unknown kernel '%s'", kernel_name);
+        return NULL;
+    }
+    if (cbits_set_kernel(op, (cbits_kernel) kernel) < 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "kernel '%s' is not supported on this CPU%s%s",
+                     kernel_name, op_name ? " for " : "",
+                     op_name ? op_name : "");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+int
+cbits_dispatch_check_env(void)
+{
+    if (cbits_force_kernel_env_status() == 0) {
+        return 0;
+    }
+    const char *spec = getenv("CBITS_FORCE_KERNEL");
+    return PyErr_WarnFormat(PyExc_RuntimeWarning, 1,
+                            "ignoring invalid CBITS_FORCE_KERNEL=%s",
+                            spec ? spec : "");
+}
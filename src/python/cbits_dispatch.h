@@ -0,0 +1,67 @@
+/**
+ * @file cbits_dispatch.h
+ * @brief Module-level introspection and override of the kernel dispatch.
+ *
+ * Declares the Python bindings of the dispatch API in compat.h:
+ * - ``cpu_features``
+ * - ``active_kernels``
+ * - ``set_kernel``
+ *
+ * The functions are registered in the module method table of
+ * ``cbits_module.c``.
+ *
+ * @see compat.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_DISPATCH_H
+#define CBITS_PY_DISPATCH_H
+
+#define PY_SSIZE_T_CLEAN
+#include "Python.h"
+
+/**
+ * @brief Python binding for ``cpu_features()``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param unused Always NULL.
+ * @retval dict Feature name to bool.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_cpu_features(PyObject *module, PyObject *unused);
+/**
+ * @brief Python binding for ``active_kernels()``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param unused Always NULL.
+ * @retval dict Operation name to kernel name.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_active_kernels(PyObject *module, PyObject *unused);
+/**
+ * @brief Python binding for ``set_kernel(op, kernel)``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval None on success.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_set_kernel(PyObject *module, PyObject *args, PyObject *kwds);
+/**
+ * @brief Warn if ``CBITS_FORCE_KERNEL`` was set but could not be applied.
+ *
+ * Called from the module exec slot, since the C constructor that reads
+ * the variable has no way to report the error.
+ *
+ * @retval 0 On success or after a warning.
+ * @retval -1 If the warning was turned into an exception.
+ */
+int
+cbits_dispatch_check_env(void);
+
+#endif /* CBITS_PY_DISPATCH_H */
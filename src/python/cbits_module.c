@@ -17,14 +17,30 @@
 #include "cbits_module.h"
 
 #include "bitvector_iter.h"
+#include "compressed_bitvector_object.h"
+#include "ewah_bitvector_object.h"
+#include "elias_fano_object.h"
+#include "rrr_bitvector_object.h"
+#include "wavelet_matrix_object.h"
+#include "bp_tree_object.h"
+#include "bitmatrix_object.h"
+#include "bitvector_collection_object.h"
+#include "bloom_filter_object.h"
+#include "quotient_filter_object.h"
+#include "bit_sliced_index_object.h"
+#include "bitmap_index_object.h"
+#include "cbits_reduce.h"
+#include "cbits_dispatch.h"
+#include "cbits_counters.h"
 
 /**
  * @brief Module exec callback: create and register types and metadata.
  *
- * Executed during module initialization. Allocates the BitVector and iterator
- * types, registers them with the module, integrates BitVector with
- * ``collections.abc.Sequence``, and sets module‑level metadata such as author,
- * version, and license.
+ * Executed during module initialization. Allocates the BitVector and
+ * iterator types together with the compressed and succinct structures built
+ * on top of them, registers them with the module, integrates BitVector with
+ * ``collections.abc.Sequence``, and sets module‑level metadata such as
+ * author, version, and license.
  *
  * @param module Newly created module instance.
  * @retval 0 Initialization succeeded
@@ -75,6 +91,147 @@ cbits_module_exec(PyObject *module)
         return -1;
     }
 
+    state->PyCompressedBitVectorType = (PyTypeObject *)
+        PyType_FromModuleAndSpec(module, &PyCompressedBitVector_spec, NULL);
+    if (state->PyCompressedBitVectorType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyCompressedBitVectorType) < 0) {
+        return -1;
+    }
+
+    state->PyEWAHBitVectorType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyEWAHBitVector_spec, NULL);
+    if (state->PyEWAHBitVectorType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyEWAHBitVectorType) < 0) {
+        return -1;
+    }
+
+    state->PyEliasFanoType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyEliasFano_spec, NULL);
+    if (state->PyEliasFanoType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyEliasFanoType) < 0) {
+        return -1;
+    }
+    state->PyEliasFanoIterType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyEliasFanoIter_spec, NULL);
+    if (state->PyEliasFanoIterType == NULL) {
+        return -1;
+    }
+
+    state->PyRRRBitVectorType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyRRRBitVector_spec, NULL);
+    if (state->PyRRRBitVectorType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyRRRBitVectorType) < 0) {
+        return -1;
+    }
+
+    state->PyWaveletMatrixType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyWaveletMatrix_spec, NULL);
+    if (state->PyWaveletMatrixType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyWaveletMatrixType) < 0) {
+        return -1;
+    }
+
+    state->PyBPTreeType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyBPTree_spec, NULL);
+    if (state->PyBPTreeType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBPTreeType) < 0) {
+        return -1;
+    }
+
+    state->PyBitMatrixType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyBitMatrix_spec, NULL);
+    if (state->PyBitMatrixType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBitMatrixType) < 0) {
+        return -1;
+    }
+    state->PyBitMatrixRowType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyBitMatrixRow_spec, (PyObject *) state->PyBitVectorType);
+    if (state->PyBitMatrixRowType == NULL) {
+        return -1;
+    }
+
+    state->PyBitVectorCollectionType = (PyTypeObject *)
+        PyType_FromModuleAndSpec(module, &PyBitVectorCollection_spec, NULL);
+    if (state->PyBitVectorCollectionType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBitVectorCollectionType) < 0) {
+        return -1;
+    }
+
+    state->PyBloomFilterType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyBloomFilter_spec, NULL);
+    if (state->PyBloomFilterType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBloomFilterType) < 0) {
+        return -1;
+    }
+
+    state->PyBlockedBloomFilterType = (PyTypeObject *)
+        PyType_FromModuleAndSpec(module, &PyBlockedBloomFilter_spec, NULL);
+    if (state->PyBlockedBloomFilterType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBlockedBloomFilterType) < 0) {
+        return -1;
+    }
+
+    state->PyQuotientFilterType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyQuotientFilter_spec, NULL);
+    if (state->PyQuotientFilterType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyQuotientFilterType) < 0) {
+        return -1;
+    }
+
+    state->PyBitSlicedIndexType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyBitSlicedIndex_spec, NULL);
+    if (state->PyBitSlicedIndexType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBitSlicedIndexType) < 0) {
+        return -1;
+    }
+
+    state->PyBitmapIndexType = (PyTypeObject *) PyType_FromModuleAndSpec(
+        module, &PyBitmapIndex_spec, NULL);
+    if (state->PyBitmapIndexType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->PyBitmapIndexType) < 0) {
+        return -1;
+    }
+
+    /* Derive the hash(BitVector) seed from the interpreter's hash secret, so
+     * that it is randomized per process like hash(bytes) and reproducible
+     * under PYTHONHASHSEED. */
+    PyObject *salt = PyBytes_FromString("cbits.BitVector");
+    if (salt == NULL) {
+        return -1;
+    }
+    Py_hash_t seed = PyObject_Hash(salt);
+    Py_DECREF(salt);
+    if (seed == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    state->hash_seed = (uint64_t) seed;
+
     /* Metadata */
     if (PyModule_AddStringConstant(module, "__author__", "lambdaphoenix") <
         0) {
@@ -91,7 +248,7 @@ cbits_module_exec(PyObject *module)
             "https://github.com/lambdaphoenix/cbits/blob/main/LICENSE") < 0) {
         return -1;
     }
-    return 0;
+    return cbits_dispatch_check_env();
 }
 /**
  * @brief Module‑level docstring for ``_cbits``.
@@ -105,17 +262,121 @@ PyDoc_STRVAR(
     "\n"
     "This module implements the high-performance BitVector backend used by "
     "the cbits package. It exposes the BitVector type, its iterator, and all "
-    "native operations such as slicing, bitwise ops, and rank-support.\n"
+    "native operations such as slicing, bitwise ops, and rank-support, as "
+    "well as the compressed CompressedBitVector, EWAHBitVector, EliasFano "
+    "and RRRBitVector types, the WaveletMatrix and BPTree succinct "
+    "indexes, the two-dimensional BitMatrix, the BitVectorCollection "
+    "for Hamming similarity search, the BloomFilter, BlockedBloomFilter "
+    "and QuotientFilter probabilistic sets, the BitSlicedIndex over "
+    "integer columns, and the BitmapIndex with its boolean query "
+    "planner, together with the and_all, or_all, xor_all and threshold "
+    "reductions over many BitVectors, the cpu_features, "
+    "active_kernels and set_kernel controls of the popcount kernel "
+    "dispatch, and the stats counters of the hot paths with the "
+    "live_bytes memory total.\n"
     "\n"
     "The module is internal and not intended for direct use.");
+/** @brief Docstring for ``and_all``. */
+PyDoc_STRVAR(py_cbits_and_all__doc__,
+             "and_all(vectors: Iterable[BitVector]) -> BitVector\n"
+             "\n"
+             "Intersection of one or more BitVectors of equal length, "
+             "computed in one pass without intermediate vectors.");
+/** @brief Docstring for ``or_all``. */
+PyDoc_STRVAR(py_cbits_or_all__doc__,
+             "or_all(vectors: Iterable[BitVector]) -> BitVector\n"
+             "\n"
+             "Union of one or more BitVectors of equal length, computed in "
+             "one pass without intermediate vectors.");
+/** @brief Docstring for ``xor_all``. */
+PyDoc_STRVAR(py_cbits_xor_all__doc__,
+             "xor_all(vectors: Iterable[BitVector]) -> BitVector\n"
+             "\n"
+             "Bits set in an odd number of one or more BitVectors of equal "
+             "length.");
+/** @brief Docstring for ``threshold``. */
+PyDoc_STRVAR(py_cbits_threshold__doc__,
+             "threshold(vectors: Iterable[BitVector], k: int) -> BitVector\n"
+             "\n"
+             "Bits set in at least k of one or more BitVectors of equal "
+             "length, counted with bit-sliced vertical counters. "
+             "threshold(vs, len(vs) // 2 + 1) is the majority.");
+/** @brief Docstring for ``cpu_features``. */
+PyDoc_STRVAR(py_cbits_cpu_features__doc__,
+             "cpu_features() -> dict[str, bool]\n"
+             "\n"
+             "Instruction set extensions the kernel dispatch detected: "
+             "popcnt, avx2, avx512f, avx512vpopcntdq and avx512bw.");
+/** @brief Docstring for ``active_kernels``. */
+PyDoc_STRVAR(py_cbits_active_kernels__doc__,
+             "active_kernels() -> dict[str, str]\n"
+             "\n"
+             "Kernel ('fallback', 'avx2' or 'avx512') each dispatched "
+             "operation currently runs: popcount_block, popcount_words, "
+             "hamming_batch, bitwise_words, pack_bools and unpack_bools.");
+/** @brief Docstring for ``set_kernel``. */
+PyDoc_STRVAR(py_cbits_set_kernel__doc__,
+             "set_kernel(op: str | None, kernel: str) -> None\n"
+             "\n"
+             "Run one dispatched operation, or all of them if op is None, "
+             "on the given kernel; 'auto' restores the fastest supported "
+             "one of each. Raises ValueError for unknown names and kernels "
+             "this CPU cannot run for the operation: avx512 needs "
+             "VPOPCNTDQ for the popcounts and BW for the bool conversions. "
+             "All kernels compute identical results. The "
+             "CBITS_FORCE_KERNEL environment variable ('avx2' or "
+             "'popcount_words=fallback,hamming_batch=avx2') applies the same "
+             "override at load time.");
+/** @brief Docstring for ``stats``. */
+PyDoc_STRVAR(py_cbits_stats__doc__,
+             "stats(reset: bool = False) -> dict[str, int]\n"
+             "\n"
+             "Process-wide counters of the hot paths: rank_builds and "
+             "rank_words scanned by them, allocs, alloc_bytes, frees and "
+             "free_bytes of all native storage, bitwise_bytes read by the "
+             "BitVector operators &, |, ^, ~ and and_all, or_all and "
+             "xor_all, search_calls, search_windows and "
+             "search_verify of subvector searches, hash_bytes, and "
+             "slice_copies with their slice_bits. With reset=True every "
+             "counter is set to zero as it is read. Raises RuntimeError if "
+             "cbits was built with CBITS_STATS=OFF.");
+/** @brief Docstring for ``live_bytes``. */
+PyDoc_STRVAR(py_cbits_live_bytes__doc__,
+             "live_bytes() -> int\n"
+             "\n"
+             "Bytes currently held by native cbits storage in this "
+             "process: every BitVector, BitMatrix, BitVectorCollection, "
+             "compressed or succinct vector, filter and index, plus the "
+             "temporary buffers of running operations. BitVectors count as "
+             "BitVector.memory_usage() counts them.");
 /**
  * @brief Method table for the module.
  *
- * The module does not expose any top-level Python functions, so the table
- * contains only the NULL terminator.
+ * Holds the n-ary reductions over many BitVectors, the kernel dispatch
+ * controls, the counter readout and the live memory total.
  * @since 0.3.0
  */
-static PyMethodDef cbits_methods[] = {{NULL, NULL, 0, NULL}};
+static PyMethodDef cbits_methods[] = {
+    {"and_all", (PyCFunction) py_cbits_and_all, METH_O,
+     py_cbits_and_all__doc__},
+    {"or_all", (PyCFunction) py_cbits_or_all, METH_O,
+     py_cbits_or_all__doc__},
+    {"xor_all", (PyCFunction) py_cbits_xor_all, METH_O,
+     py_cbits_xor_all__doc__},
+    {"threshold", (PyCFunction) (void (*)(void)) py_cbits_threshold,
+     METH_VARARGS | METH_KEYWORDS, py_cbits_threshold__doc__},
+    {"cpu_features", (PyCFunction) py_cbits_cpu_features, METH_NOARGS,
+     py_cbits_cpu_features__doc__},
+    {"active_kernels", (PyCFunction) py_cbits_active_kernels, METH_NOARGS,
+     py_cbits_active_kernels__doc__},
+    {"set_kernel", (PyCFunction) (void (*)(void)) py_cbits_set_kernel,
+     METH_VARARGS | METH_KEYWORDS, py_cbits_set_kernel__doc__},
+    {"stats", (PyCFunction) (void (*)(void)) py_cbits_stats,
+     METH_VARARGS | METH_KEYWORDS, py_cbits_stats__doc__},
+    {"live_bytes", (PyCFunction) py_cbits_live_bytes, METH_NOARGS,
+     py_cbits_live_bytes__doc__},
+    {NULL, NULL, 0, NULL},
+};
 
 /**
  * @brief Initialization slot table for the module.
@@ -154,6 +415,21 @@ cbits_traverse(PyObject *module, visitproc visit, void *arg)
     cbits_state *state = get_cbits_state(module);
     Py_VISIT(state->PyBitVectorType);
     Py_VISIT(state->PyBitVectorIterType);
+    Py_VISIT(state->PyCompressedBitVectorType);
+    Py_VISIT(state->PyEWAHBitVectorType);
+    Py_VISIT(state->PyEliasFanoType);
+    Py_VISIT(state->PyEliasFanoIterType);
+    Py_VISIT(state->PyRRRBitVectorType);
+    Py_VISIT(state->PyWaveletMatrixType);
+    Py_VISIT(state->PyBPTreeType);
+    Py_VISIT(state->PyBitMatrixType);
+    Py_VISIT(state->PyBitMatrixRowType);
+    Py_VISIT(state->PyBitVectorCollectionType);
+    Py_VISIT(state->PyBloomFilterType);
+    Py_VISIT(state->PyBlockedBloomFilterType);
+    Py_VISIT(state->PyQuotientFilterType);
+    Py_VISIT(state->PyBitSlicedIndexType);
+    Py_VISIT(state->PyBitmapIndexType);
     return 0;
 }
 /**
@@ -172,6 +448,21 @@ cbits_clear(PyObject *module)
     cbits_state *state = get_cbits_state(module);
     Py_CLEAR(state->PyBitVectorType);
     Py_CLEAR(state->PyBitVectorIterType);
+    Py_CLEAR(state->PyCompressedBitVectorType);
+    Py_CLEAR(state->PyEWAHBitVectorType);
+    Py_CLEAR(state->PyEliasFanoType);
+    Py_CLEAR(state->PyEliasFanoIterType);
+    Py_CLEAR(state->PyRRRBitVectorType);
+    Py_CLEAR(state->PyWaveletMatrixType);
+    Py_CLEAR(state->PyBPTreeType);
+    Py_CLEAR(state->PyBitMatrixType);
+    Py_CLEAR(state->PyBitMatrixRowType);
+    Py_CLEAR(state->PyBitVectorCollectionType);
+    Py_CLEAR(state->PyBloomFilterType);
+    Py_CLEAR(state->PyBlockedBloomFilterType);
+    Py_CLEAR(state->PyQuotientFilterType);
+    Py_CLEAR(state->PyBitSlicedIndexType);
+    Py_CLEAR(state->PyBitmapIndexType);
     return 0;
 }
 /**
@@ -184,7 +475,7 @@ cbits_clear(PyObject *module)
  * @since 0.3.0
  */
 static void
-cbits_free(void *module)
+cbits_module_free(void *module)
 {
     (void) cbits_clear((PyObject *) module);
 }
@@ -204,7 +495,7 @@ struct PyModuleDef cbits_module = {
     .m_slots = cbits_slots,
     .m_traverse = cbits_traverse,
     .m_clear = cbits_clear,
-    .m_free = cbits_free,
+    .m_free = cbits_module_free,
 };
 
 /**
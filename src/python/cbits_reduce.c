@@ -0,0 +1,159 @@
+/**
+ * @file cbits_reduce.c
+ * @brief Implementation of the module-level n-ary reductions.
+ *
+ * Each function gathers the native vectors of its argument once and hands
+ * them to the core, which fills a single result vector block by block
+ * instead of creating one intermediate ``BitVector`` per input as
+ * ``functools.reduce`` would.
+ *
+ * @see cbits_reduce.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "cbits_reduce.h"
+
+/**
+ * @brief Signature shared by the core reductions.
+ */
+typedef BitVector *(*py_cbits_reducer)(const BitVector *const *, size_t);
+
+/**
+ * @brief Collect the native vectors of an iterable of BitVectors.
+ *
+ * @param module The ``_cbits`` module.
+ * @param vectors Iterable of equally long BitVectors.
+ * @param seq Receives the sequence that keeps the inputs alive.
+ * @param n Receives the number of inputs.
+ * @return PyMem array of @p n vectors, or NULL on failure (exception set).
+ */
+static const BitVector **
+py_cbits_gather(PyObject *module, PyObject *vectors, PyObject **seq,
+                size_t *n)
+{
+    *seq = PySequence_Fast(vectors, "expected an iterable of BitVector");
+    if (!*seq) {
+        return NULL;
+    }
+    const Py_ssize_t size = PySequence_Fast_GET_SIZE(*seq);
+    PyObject **items = PySequence_Fast_ITEMS(*seq);
+    if (size == 0) {
+        PyErr_SetString(PyExc_ValueError, "vectors must not be empty");
+        Py_CLEAR(*seq);
+        return NULL;
+    }
+    const BitVector **vs = PyMem_Malloc((size_t) size * sizeof(*vs));
+    if (!vs) {
+        Py_CLEAR(*seq);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    cbits_state *state = get_cbits_state(module);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        if (!py_bitvector_check(items[i], state)) {
+            PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+            goto fail;
+        }
+        vs[i] = ((PyBitVectorObject *) items[i])->bv;
+        if (vs[i]->n_bits != vs[0]->n_bits) {
+            PyErr_SetString(PyExc_ValueError,
+                            "all BitVectors must have the same length");
+            goto fail;
+        }
+    }
+    *n = (size_t) size;
+    return vs;
+
+fail:
+    PyMem_Free(vs);
+    Py_CLEAR(*seq);
+    return NULL;
+}
+
+/**
+ * @brief Wrap the result of a core reduction.
+ *
+ * @param module The ``_cbits`` module.
+ * @param bv Result vector, or NULL after an allocation failure.
+ * @retval BitVector New BitVector on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbits_wrap_result(PyObject *module, BitVector *bv)
+{
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    return bitvector_wrap_new(get_cbits_state(module)->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Shared implementation of ``and_all``, ``or_all`` and ``xor_all``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param vectors Iterable of equally long BitVectors.
+ * @param reduce Core reduction to run.
+ * @retval BitVector New BitVector on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbits_reduce(PyObject *module, PyObject *vectors,
+                py_cbits_reducer reduce)
+{
+    PyObject *seq;
+    size_t n;
+    const BitVector **vs = py_cbits_gather(module, vectors, &seq, &n);
+    if (!vs) {
+        return NULL;
+    }
+    BitVector *bv = reduce(vs, n);
+    PyMem_Free(vs);
+    Py_DECREF(seq);
+    return py_cbits_wrap_result(module, bv);
+}
+
+PyObject *
+py_cbits_and_all(PyObject *module, PyObject *vectors)
+{
+    return py_cbits_reduce(module, vectors, bv_and_all);
+}
+
+PyObject *
+py_cbits_or_all(PyObject *module, PyObject *vectors)
+{
+    return py_cbits_reduce(module, vectors, bv_or_all);
+}
+
+PyObject *
+py_cbits_xor_all(PyObject *module, PyObject *vectors)
+{
+    return py_cbits_reduce(module, vectors, bv_xor_all);
+}
+
+PyObject *
+py_cbits_threshold(PyObject *module, PyObject *args, PyObject *kwds)
+{
+    PyObject *vectors;
+    Py_ssize_t k;
+    static char *kwlist[] = {"vectors", "k", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On", kwlist, &vectors,
+                                     &k)) {
+        return NULL;
+    }
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "k must be >= 0");
+        return NULL;
+    }
+    PyObject *seq;
+    size_t n;
+    const BitVector **vs = py_cbits_gather(module, vectors, &seq, &n);
+    if (!vs) {
+        return NULL;
+    }
+    BitVector *bv = bv_threshold(vs, n, (size_t) k);
+    PyMem_Free(vs);
+    Py_DECREF(seq);
+    return py_cbits_wrap_result(module, bv);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file cbits_reduce.h
+ * @brief Module-level n-ary reductions over many ``BitVector`` objects.
+ *
+ * Declares the Python bindings of the core reductions:
+ * - ``and_all``, ``or_all`` and ``xor_all``
+ * - ``threshold``
+ *
+ * The functions are registered in the module method table of
+ * ``cbits_module.c``.
+ *
+ * @see bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_REDUCE_H
+#define CBITS_PY_REDUCE_H
+
+#include "bitvector_object.h"
+
+/**
+ * @brief Python binding for ``and_all(vectors)``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param vectors Iterable of equally long BitVectors.
+ * @retval BitVector New BitVector on success.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_and_all(PyObject *module, PyObject *vectors);
+/**
+ * @brief Python binding for ``or_all(vectors)``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param vectors Iterable of equally long BitVectors.
+ * @retval BitVector New BitVector on success.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_or_all(PyObject *module, PyObject *vectors);
+/**
+ * @brief Python binding for ``xor_all(vectors)``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param vectors Iterable of equally long BitVectors.
+ * @retval BitVector New BitVector on success.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_xor_all(PyObject *module, PyObject *vectors);
+/**
+ * @brief Python binding for ``threshold(vectors, k)``.
+ *
+ * @param module The ``_cbits`` module.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval BitVector New BitVector on success.
+ * @retval NULL on failure (exception set).
+ */
+PyObject *
+py_cbits_threshold(PyObject *module, PyObject *args, PyObject *kwds);
+
+#endif /* CBITS_PY_REDUCE_H */
@@ -27,12 +27,32 @@
  *
  * Each module instance maintains its own state, allocated through CPython’s
  * module state mechanism. The structure stores the Python type objects
- * required by the BitVector implementation.
+ * required by the BitVector implementation and the secret seed of
+ * ``hash(BitVector)``.
  * @since 0.3.0
  */
 typedef struct {
     PyTypeObject *PyBitVectorType;     /**< BitVector type object */
     PyTypeObject *PyBitVectorIterType; /**< BitVector iterator type object */
+    PyTypeObject
+        *PyCompressedBitVectorType;    /**< CompressedBitVector type object */
+    PyTypeObject *PyEWAHBitVectorType; /**< EWAHBitVector type object */
+    PyTypeObject *PyEliasFanoType;     /**< EliasFano type object */
+    PyTypeObject *PyEliasFanoIterType; /**< EliasFano iterator type object */
+    PyTypeObject *PyRRRBitVectorType;  /**< RRRBitVector type object */
+    PyTypeObject *PyWaveletMatrixType; /**< WaveletMatrix type object */
+    PyTypeObject *PyBPTreeType;        /**< BPTree type object */
+    PyTypeObject *PyBitMatrixType;     /**< BitMatrix type object */
+    PyTypeObject *PyBitMatrixRowType;  /**< BitMatrix row view type object */
+    PyTypeObject
+        *PyBitVectorCollectionType; /**< BitVectorCollection type object */
+    PyTypeObject *PyBloomFilterType;   /**< BloomFilter type object */
+    PyTypeObject
+        *PyBlockedBloomFilterType; /**< BlockedBloomFilter type object */
+    PyTypeObject *PyQuotientFilterType; /**< QuotientFilter type object */
+    PyTypeObject *PyBitSlicedIndexType; /**< BitSlicedIndex type object */
+    PyTypeObject *PyBitmapIndexType; /**< BitmapIndex type object */
+    uint64_t hash_seed; /**< Per-process seed of ``hash(BitVector)`` */
 } cbits_state;
 
 /**
@@ -80,6 +100,37 @@ get_cbits_state(PyObject *module)
         (get_cbits_state(PyType_GetModule((type))))
 #endif
 
+/**
+ * @brief Retrieve the cbits module state from either operand of a binary op.
+ *
+ * Number-protocol slots may be invoked with a foreign object on the left, so
+ * the state is looked up on @p a first and on @p b as a fallback.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @retval state Pointer to the module's ::cbits_state.
+ * @retval NULL Neither operand belongs to the module (no exception set).
+ * @since 0.4.0
+ */
+static inline cbits_state *
+find_cbits_state_by_operands(PyObject *a, PyObject *b)
+{
+    PyObject *operands[2] = {a, b};
+    for (int i = 0; i < 2; ++i) {
+#if PY_VERSION_HEX >= 0x030B0000
+        PyObject *module =
+            PyType_GetModuleByDef(Py_TYPE(operands[i]), &cbits_module);
+#else
+        PyObject *module = PyType_GetModule(Py_TYPE(operands[i]));
+#endif
+        if (module) {
+            return get_cbits_state(module);
+        }
+        PyErr_Clear();
+    }
+    return NULL;
+}
+
 /**
  * @brief Check whether an object is an instance of the BitVector type.
  *
@@ -91,6 +142,52 @@ get_cbits_state(PyObject *module)
 #define py_bitvector_check(object, state) \
     PyObject_TypeCheck(object, state->PyBitVectorType)
 
+/**
+ * @brief Check whether an object is an instance of the CompressedBitVector
+ * type.
+ *
+ * @param object Python object to test.
+ * @param state Module state containing the type reference.
+ * @return Non-zero if @p object is a CompressedBitVector instance.
+ * @since 0.4.0
+ */
+#define py_compressed_bitvector_check(object, state) \
+    PyObject_TypeCheck(object, state->PyCompressedBitVectorType)
+
+/**
+ * @brief Check whether an object is an instance of the EWAHBitVector type.
+ *
+ * @param object Python object to test.
+ * @param state Module state containing the type reference.
+ * @return Non-zero if @p object is an EWAHBitVector instance.
+ * @since 0.4.0
+ */
+#define py_ewah_bitvector_check(object, state) \
+    PyObject_TypeCheck(object, state->PyEWAHBitVectorType)
+
+/**
+ * @brief Check whether an object is an instance of the BitMatrix type.
+ *
+ * @param object Python object to test.
+ * @param state Module state containing the type reference.
+ * @return Non-zero if @p object is a BitMatrix instance.
+ * @since 0.4.0
+ */
+#define py_bitmatrix_check(object, state) \
+    PyObject_TypeCheck(object, state->PyBitMatrixType)
+
+/**
+ * @brief Check whether an object is a BloomFilter or BlockedBloomFilter.
+ *
+ * @param object Python object to test.
+ * @param state Module state containing the type references.
+ * @return Non-zero if @p object is an instance of either filter type.
+ * @since 0.4.0
+ */
+#define py_bloom_filter_check(object, state)                    \
+    (PyObject_TypeCheck(object, state->PyBloomFilterType) ||    \
+     PyObject_TypeCheck(object, state->PyBlockedBloomFilterType))
+
 /** @} */ /* end of cbits_state_module */
 
 #endif /* CBITS_STATE_H */
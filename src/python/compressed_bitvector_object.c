@@ -0,0 +1,689 @@
+/**
+ * @file compressed_bitvector_object.c
+ * @brief Implementation of the ``CompressedBitVector`` Python type.
+ *
+ * Exposes the Roaring-style compressed container through an API that mirrors
+ * ``BitVector``: single-bit access, ``rank``, ``select``, bitwise operators
+ * and conversion from and to ``BitVector``.
+ *
+ * @see compressed_bitvector_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "compressed_bitvector_object.h"
+#include "bitvector_object.h"
+#include "bitvector_parse.h"
+
+/**
+ * @brief ``__new__`` for ``CompressedBitVector``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_cbv_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+           PyObject *Py_UNUSED(kwds))
+{
+    PyCompressedBitVectorObject *self =
+        (PyCompressedBitVectorObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->cbv = NULL;
+    return (PyObject *) self;
+}
+
+PyObject *
+compressed_bitvector_wrap_new(PyTypeObject *type, CompressedBitVector *cbv)
+{
+    assert(type != NULL);
+    assert(cbv != NULL);
+
+    PyObject *object = py_cbv_new(type, NULL, NULL);
+    if (object == NULL) {
+        cbv_free(cbv);
+        return NULL;
+    }
+    ((PyCompressedBitVectorObject *) object)->cbv = cbv;
+    return object;
+}
+
+/**
+ * @brief ``__init__`` for ``CompressedBitVector(size)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_cbv_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t n_bits;
+    static char *kwlist[] = {"size", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n", kwlist, &n_bits)) {
+        return -1;
+    }
+    if (n_bits < 0) {
+        PyErr_SetString(PyExc_ValueError, "size must be >= 0");
+        return -1;
+    }
+    PyCompressedBitVectorObject *obj = (PyCompressedBitVectorObject *) self;
+    cbv_free(obj->cbv);
+    obj->cbv = cbv_new((size_t) n_bits);
+    if (!obj->cbv) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate CompressedBitVector");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_cbv_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyCompressedBitVectorObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_cbv_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyCompressedBitVectorObject *self = (PyCompressedBitVectorObject *) object;
+    cbv_free(self->cbv);
+    self->cbv = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native vector of a Python object. */
+#define CBV(o) (((PyCompressedBitVectorObject *) (o))->cbv)
+
+/**
+ * @brief Report a failed mutation as ``MemoryError``.
+ *
+ * @param rc Return code of the native call.
+ * @retval Py_None if @p rc is ``0``.
+ * @retval NULL otherwise (exception set).
+ */
+static PyObject *
+py_cbv_mutation_result(int rc)
+{
+    if (rc < 0) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "CompressedBitVector container allocation failed");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.get(index)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval bool Bit value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_get(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, CBV(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(cbv_get(CBV(self), index));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.set(index)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval Py_None on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_set(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, CBV(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return py_cbv_mutation_result(cbv_set(CBV(self), index));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.clear(index)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval Py_None on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_clear(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, CBV(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return py_cbv_mutation_result(cbv_clear(CBV(self), index));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.flip(index)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval Py_None on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_flip(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, CBV(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return py_cbv_mutation_result(cbv_flip(CBV(self), index));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.rank(index)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval int Number of set bits in ``[0..index]``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_rank(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, CBV(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return PyLong_FromSize_t(cbv_rank(CBV(self), index));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.select(k)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param arg Zero-based index of the set bit.
+ * @retval int Position of the k-th set bit.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_select(PyObject *self, PyObject *arg)
+{
+    Py_ssize_t k = PyLong_AsSsize_t(arg);
+    if (k == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    size_t pos = k < 0 ? SIZE_MAX : cbv_select(CBV(self), (size_t) k);
+    if (pos == SIZE_MAX) {
+        PyErr_SetString(PyExc_IndexError, "select index out of range");
+        return NULL;
+    }
+    return PyLong_FromSize_t(pos);
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.count()``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @return Number of set bits.
+ */
+static PyObject *
+py_cbv_count(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyLong_FromSize_t(cbv_count(CBV(self)));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.optimize()``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @retval Py_None on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_optimize(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return py_cbv_mutation_result(cbv_optimize(CBV(self)));
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.copy()``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @retval copy New object on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_copy(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    CompressedBitVector *copy = cbv_copy(CBV(self));
+    if (!copy) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate CompressedBitVector in copy()");
+        return NULL;
+    }
+    return compressed_bitvector_wrap_new(Py_TYPE(self), copy);
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.from_bitvector(bv)``.
+ *
+ * @param type The class the method was called on.
+ * @param arg Source ``BitVector``.
+ * @retval object New ``CompressedBitVector`` on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_from_bitvector(PyObject *type, PyObject *arg)
+{
+    cbits_state *state = find_cbits_state_by_type((PyTypeObject *) type);
+    if (!py_bitvector_check(arg, state)) {
+        PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+        return NULL;
+    }
+    CompressedBitVector *cbv =
+        cbv_from_bitvector(((PyBitVectorObject *) arg)->bv);
+    if (!cbv) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate CompressedBitVector");
+        return NULL;
+    }
+    return compressed_bitvector_wrap_new((PyTypeObject *) type, cbv);
+}
+
+/**
+ * @brief Python binding for ``CompressedBitVector.to_bitvector()``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @retval object New ``BitVector`` on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_to_bitvector(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    BitVector *bv = cbv_to_bitvector(CBV(self));
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    return bitvector_wrap_new(state->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Implement ``CompressedBitVector.__sizeof__``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native container memory in bytes.
+ */
+static PyObject *
+py_cbv_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total = (size_t) Py_TYPE(self)->tp_basicsize +
+                   cbv_memory_usage(CBV(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Shared implementation of the binary operators.
+ *
+ * @param oA Left operand.
+ * @param oB Right operand.
+ * @param fn Native operation.
+ * @retval object New ``CompressedBitVector`` on success.
+ * @retval Py_NotImplemented if an operand has the wrong type.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_binary(PyObject *oA, PyObject *oB,
+              CompressedBitVector *(*fn)(const CompressedBitVector *,
+                                         const CompressedBitVector *) )
+{
+    cbits_state *state = find_cbits_state_by_operands(oA, oB);
+    if (!state || !py_compressed_bitvector_check(oA, state) ||
+        !py_compressed_bitvector_check(oB, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (CBV(oA)->n_bits != CBV(oB)->n_bits) {
+        PyErr_Format(PyExc_ValueError, "length mismatch: A=%zu, B=%zu",
+                     CBV(oA)->n_bits, CBV(oB)->n_bits);
+        return NULL;
+    }
+    CompressedBitVector *res = fn(CBV(oA), CBV(oB));
+    if (!res) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "CompressedBitVector allocation failed");
+        return NULL;
+    }
+    return compressed_bitvector_wrap_new(state->PyCompressedBitVectorType,
+                                         res);
+}
+
+/** @brief Implement ``A & B``. */
+static PyObject *
+py_cbv_and(PyObject *oA, PyObject *oB)
+{
+    return py_cbv_binary(oA, oB, cbv_and);
+}
+/** @brief Implement ``A | B``. */
+static PyObject *
+py_cbv_or(PyObject *oA, PyObject *oB)
+{
+    return py_cbv_binary(oA, oB, cbv_or);
+}
+/** @brief Implement ``A ^ B``. */
+static PyObject *
+py_cbv_xor(PyObject *oA, PyObject *oB)
+{
+    return py_cbv_binary(oA, oB, cbv_xor);
+}
+/** @brief Implement ``A - B`` (AND-NOT). */
+static PyObject *
+py_cbv_sub(PyObject *oA, PyObject *oB)
+{
+    return py_cbv_binary(oA, oB, cbv_andnot);
+}
+
+/**
+ * @brief Implement ``bool(CompressedBitVector)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @retval 1 At least one bit is set.
+ * @retval 0 All bits are zero.
+ */
+static int
+py_cbv_bool(PyObject *self)
+{
+    return CBV(self)->n_containers > 0;
+}
+
+/**
+ * @brief Implement ``len(CompressedBitVector)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @return Number of bits.
+ */
+static Py_ssize_t
+py_cbv_len(PyObject *self)
+{
+    return (Py_ssize_t) CBV(self)->n_bits;
+}
+
+/**
+ * @brief Implement ``CompressedBitVector[index]``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @retval bool Bit value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_cbv_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= CBV(self)->n_bits) {
+        PyErr_SetString(PyExc_IndexError,
+                        "CompressedBitVector index out of range");
+        return NULL;
+    }
+    return PyBool_FromLong(cbv_get(CBV(self), (size_t) i));
+}
+
+/**
+ * @brief Implement ``CompressedBitVector[index] = value``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @param value Truthy object, or NULL for deletion (clears the bit).
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_cbv_ass_item(PyObject *self, Py_ssize_t i, PyObject *value)
+{
+    if (i < 0 || (size_t) i >= CBV(self)->n_bits) {
+        PyErr_SetString(PyExc_IndexError,
+                        "CompressedBitVector assignment out of range");
+        return -1;
+    }
+    int bit = value ? PyObject_IsTrue(value) : 0;
+    if (bit < 0) {
+        return -1;
+    }
+    int rc = bit ? cbv_set(CBV(self), (size_t) i)
+                 : cbv_clear(CBV(self), (size_t) i);
+    if (rc < 0) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "CompressedBitVector container allocation failed");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Implement ``==`` and ``!=``.
+ *
+ * @param a First operand.
+ * @param b Second operand.
+ * @param op Comparison operation.
+ * @retval bool Comparison result.
+ * @retval Py_NotImplemented for unsupported comparisons.
+ */
+static PyObject *
+py_cbv_richcompare(PyObject *a, PyObject *b, int op)
+{
+    if (op != Py_EQ && op != Py_NE) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(a));
+    if (!py_compressed_bitvector_check(b, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    bool eq = cbv_equal(CBV(a), CBV(b));
+    return PyBool_FromLong((op == Py_EQ) == eq);
+}
+
+/**
+ * @brief Implement ``repr(CompressedBitVector)``.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_cbv_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat(
+        "<cbits.CompressedBitVector object at %p bits=%zu containers=%zu>",
+        self, CBV(self)->n_bits, CBV(self)->n_containers);
+}
+
+/**
+ * @brief Getter for the read-only ``bits`` property.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param closure Unused.
+ * @return Python integer of the bit-length.
+ */
+static PyObject *
+py_cbv_get_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(CBV(self)->n_bits);
+}
+
+/**
+ * @brief Getter for the read-only ``containers`` property.
+ *
+ * @param self A ``PyCompressedBitVectorObject`` instance.
+ * @param closure Unused.
+ * @return Tuple ``(arrays, bitmaps, runs)`` with container counts.
+ */
+static PyObject *
+py_cbv_get_containers(PyObject *self, void *Py_UNUSED(closure))
+{
+    size_t counts[3] = {0, 0, 0};
+    const CompressedBitVector *cbv = CBV(self);
+    for (size_t i = 0; i < cbv->n_containers; ++i) {
+        counts[cbv->containers[i].type]++;
+    }
+    return Py_BuildValue("(nnn)", (Py_ssize_t) counts[CBV_CONTAINER_ARRAY],
+                         (Py_ssize_t) counts[CBV_CONTAINER_BITMAP],
+                         (Py_ssize_t) counts[CBV_CONTAINER_RUN]);
+}
+
+#undef CBV
+
+/** @brief Docstring for ``CompressedBitVector.rank``. */
+PyDoc_STRVAR(py_cbv_rank__doc__,
+             "rank(index: int) -> int\n"
+             "\n"
+             "Count the number of bits set to True in the range [0..index].\n"
+             "Supports negative indexing. Raises IndexError if out of range.");
+/** @brief Docstring for ``CompressedBitVector.select``. */
+PyDoc_STRVAR(py_cbv_select__doc__,
+             "select(k: int) -> int\n"
+             "\n"
+             "Return the position of the k-th set bit (zero-based), so that\n"
+             "rank(select(k)) == k + 1. Raises IndexError if fewer than k+1\n"
+             "bits are set.");
+/** @brief Docstring for ``CompressedBitVector.optimize``. */
+PyDoc_STRVAR(py_cbv_optimize__doc__,
+             "optimize() -> None\n"
+             "\n"
+             "Convert every container to its smallest representation, "
+             "including run containers for long stretches of set bits.");
+/** @brief Docstring for ``CompressedBitVector.from_bitvector``. */
+PyDoc_STRVAR(py_cbv_from_bitvector__doc__,
+             "from_bitvector(bv: BitVector) -> CompressedBitVector\n"
+             "\n"
+             "Build a compressed vector with the same length and bits as bv.");
+
+/**
+ * @brief Method table for the CompressedBitVector type.
+ */
+static PyMethodDef PyCompressedBitVector_methods[] = {
+    {"get", (PyCFunction) py_cbv_get, METH_O,
+     PyDoc_STR("get(index: int) -> bool\n\nReturn the bit at index.")},
+    {"set", (PyCFunction) py_cbv_set, METH_O,
+     PyDoc_STR("set(index: int) -> None\n\nSet the bit at index to True.")},
+    {"clear", (PyCFunction) py_cbv_clear, METH_O,
+     PyDoc_STR("clear(index: int) -> None\n\nSet the bit at index to False.")},
+    {"flip", (PyCFunction) py_cbv_flip, METH_O,
+     PyDoc_STR("flip(index: int) -> None\n\nToggle the bit at index.")},
+    {"rank", (PyCFunction) py_cbv_rank, METH_O, py_cbv_rank__doc__},
+    {"select", (PyCFunction) py_cbv_select, METH_O, py_cbv_select__doc__},
+    {"count", (PyCFunction) py_cbv_count, METH_NOARGS,
+     PyDoc_STR("count() -> int\n\nReturn the number of set bits.")},
+    {"optimize", (PyCFunction) py_cbv_optimize, METH_NOARGS,
+     py_cbv_optimize__doc__},
+    {"copy", (PyCFunction) py_cbv_copy, METH_NOARGS,
+     PyDoc_STR("copy() -> CompressedBitVector\n\nReturn a copy.")},
+    {"__copy__", (PyCFunction) py_cbv_copy, METH_NOARGS,
+     PyDoc_STR("__copy__() -> CompressedBitVector\n\nReturn a copy.")},
+    {"from_bitvector", (PyCFunction) py_cbv_from_bitvector,
+     METH_O | METH_CLASS, py_cbv_from_bitvector__doc__},
+    {"to_bitvector", (PyCFunction) py_cbv_to_bitvector, METH_NOARGS,
+     PyDoc_STR("to_bitvector() -> BitVector\n\nExpand into a BitVector.")},
+    {"__sizeof__", (PyCFunction) py_cbv_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the CompressedBitVector type.
+ */
+static PyGetSetDef PyCompressedBitVector_getset[] = {
+    {"bits", py_cbv_get_bits, NULL, PyDoc_STR("The number of bits.")},
+    {"containers", py_cbv_get_containers, NULL,
+     PyDoc_STR("Tuple (arrays, bitmaps, runs) of container counts.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``CompressedBitVector`` type. */
+PyDoc_STRVAR(
+    PyCompressedBitVector__doc__,
+    "CompressedBitVector(size: int)\n"
+    "\n"
+    "A compressed, fixed-size bit array (Roaring-style).\n\n"
+    "The index space is split into chunks of 65536 bits. Each non-empty chunk "
+    "is stored as a sorted array, a bitmap or a list of runs, whichever is "
+    "smallest. Empty chunks use no memory.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "size : int\n"
+    "   Number of bits in the vector.\n");
+
+/**
+ * @brief Slot table for the ``CompressedBitVector`` type.
+ */
+static PyType_Slot PyCompressedBitVector_slots[] = {
+    {Py_tp_doc, (void *) PyCompressedBitVector__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_cbv_new},
+    {Py_tp_init, py_cbv_init},
+    {Py_tp_traverse, py_cbv_traverse},
+    {Py_tp_dealloc, py_cbv_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyCompressedBitVector_methods},
+    {Py_tp_getset, PyCompressedBitVector_getset},
+    {Py_tp_repr, py_cbv_repr},
+    {Py_tp_richcompare, py_cbv_richcompare},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+
+    {Py_sq_length, py_cbv_len},
+    {Py_sq_item, py_cbv_item},
+    {Py_sq_ass_item, py_cbv_ass_item},
+    {Py_mp_length, py_cbv_len},
+
+    {Py_nb_and, py_cbv_and},
+    {Py_nb_or, py_cbv_or},
+    {Py_nb_xor, py_cbv_xor},
+    {Py_nb_subtract, py_cbv_sub},
+    {Py_nb_bool, py_cbv_bool},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``CompressedBitVector``.
+ */
+PyType_Spec PyCompressedBitVector_spec = {
+    .name = "cbits.CompressedBitVector",
+    .basicsize = sizeof(PyCompressedBitVectorObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyCompressedBitVector_slots,
+};
@@ -0,0 +1,44 @@
+/**
+ * @file compressed_bitvector_object.h
+ * @brief Definition of the ``CompressedBitVector`` Python type.
+ *
+ * Declares the Python wrapper for the native Roaring-style
+ * ``CompressedBitVector``:
+ * - \ref PyCompressedBitVectorObject - the Python object structure
+ * - the type specification used to create the Python type
+ * - ``compressed_bitvector_wrap_new`` - helper for constructing wrappers
+ *
+ * @see compressed_bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_COMPRESSED_BITVECTOR_OBJECT_H
+#define CBITS_PY_COMPRESSED_BITVECTOR_OBJECT_H
+
+#include "compressed_bitvector.h"
+#include "cbits_state.h"
+
+/**
+ * @brief Python object wrapping a native ``CompressedBitVector`` instance.
+ */
+typedef struct {
+    PyObject_HEAD CompressedBitVector *cbv; /**< Underlying vector */
+} PyCompressedBitVectorObject;
+
+extern PyType_Spec PyCompressedBitVector_spec;
+
+/**
+ * @brief Wrap a native CompressedBitVector in a new Python object.
+ *
+ * @param type The ``PyTypeObject`` representing the CompressedBitVector type.
+ * @param cbv Pointer to an already-allocated native vector.
+ * @retval new_object A new reference on success.
+ * @retval NULL on allocation failure (``cbv`` is freed).
+ *
+ * @note The caller transfers ownership of ``cbv`` to the returned object.
+ */
+PyObject *
+compressed_bitvector_wrap_new(PyTypeObject *type, CompressedBitVector *cbv);
+
+#endif /* CBITS_PY_COMPRESSED_BITVECTOR_OBJECT_H */
@@ -0,0 +1,481 @@
+/**
+ * @file elias_fano_object.c
+ * @brief Implementation of the ``EliasFano`` Python type.
+ *
+ * Exposes an immutable Elias–Fano encoded sorted sequence with indexing,
+ * ``next_geq`` successor queries, membership tests and iteration.
+ *
+ * @see elias_fano_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "elias_fano_object.h"
+
+/**
+ * @brief Iterator object returned by ``EliasFano.__iter__``.
+ */
+typedef struct {
+    PyObject_HEAD PyEliasFanoObject *owner; /**< Referenced sequence */
+    EFIterator it;                          /**< Native iteration state */
+} PyEliasFanoIterObject;
+
+/**
+ * @brief ``__new__`` for ``EliasFano``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_ef_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+          PyObject *Py_UNUSED(kwds))
+{
+    PyEliasFanoObject *self = (PyEliasFanoObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->ef = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief ``__init__`` for ``EliasFano(values)``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_ef_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *iterable;
+    static char *kwlist[] = {"values", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &iterable)) {
+        return -1;
+    }
+    PyObject *seq =
+        PySequence_Fast(iterable, "values must be an iterable of integers");
+    if (!seq) {
+        return -1;
+    }
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    uint64_t *values = PyMem_Malloc((n ? (size_t) n : 1) * sizeof(uint64_t));
+    if (!values) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        unsigned long long v = PyLong_AsUnsignedLongLong(items[i]);
+        if (v == (unsigned long long) -1 && PyErr_Occurred()) {
+            goto fail;
+        }
+        values[i] = (uint64_t) v;
+        if (i && values[i] < values[i - 1]) {
+            PyErr_SetString(PyExc_ValueError,
+                            "values must be sorted in non-decreasing order");
+            goto fail;
+        }
+    }
+    Py_DECREF(seq);
+
+    PyEliasFanoObject *obj = (PyEliasFanoObject *) self;
+    ef_free(obj->ef);
+    obj->ef = ef_from_sorted(values, (size_t) n);
+    PyMem_Free(values);
+    if (!obj->ef) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate EliasFano");
+        return -1;
+    }
+    return 0;
+
+fail:
+    PyMem_Free(values);
+    Py_DECREF(seq);
+    return -1;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_ef_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyEliasFanoObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_ef_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyEliasFanoObject *self = (PyEliasFanoObject *) object;
+    ef_free(self->ef);
+    self->ef = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native sequence of a Python object. */
+#define EF(o) (((PyEliasFanoObject *) (o))->ef)
+
+/**
+ * @brief Implement ``len(EliasFano)``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @return Number of stored values.
+ */
+static Py_ssize_t
+py_ef_len(PyObject *self)
+{
+    return (Py_ssize_t) EF(self)->n;
+}
+
+/**
+ * @brief Implement ``EliasFano[index]``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @retval int Stored value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ef_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= EF(self)->n) {
+        PyErr_SetString(PyExc_IndexError, "EliasFano index out of range");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(ef_access(EF(self), (size_t) i));
+}
+
+/**
+ * @brief Parse a non-negative integer query bound.
+ *
+ * @param arg Python integer.
+ * @param out Receives the bound (``0`` for negative integers).
+ * @retval 0 Success.
+ * @retval 1 Bound exceeds 64 bits; no value can match.
+ * @retval 2 Bound is negative; every value matches a lower bound.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_ef_parse_bound(PyObject *arg, uint64_t *out)
+{
+    if (!PyLong_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "value must be an integer");
+        return -1;
+    }
+    int overflow = 0;
+    long long v = PyLong_AsLongLongAndOverflow(arg, &overflow);
+    if (v == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (overflow < 0 || (!overflow && v < 0)) {
+        *out = 0;
+        return 2;
+    }
+    if (!overflow) {
+        *out = (uint64_t) v;
+        return 0;
+    }
+    unsigned long long u = PyLong_AsUnsignedLongLong(arg);
+    if (u == (unsigned long long) -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        return 1;
+    }
+    *out = (uint64_t) u;
+    return 0;
+}
+
+/**
+ * @brief Python binding for ``EliasFano.next_geq(x)``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @param arg Lower bound.
+ * @retval int Smallest stored value ``>= x``.
+ * @retval Py_None if every value is below ``x``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ef_next_geq(PyObject *self, PyObject *arg)
+{
+    uint64_t x, found;
+    int rc = py_ef_parse_bound(arg, &x);
+    if (rc < 0) {
+        return NULL;
+    }
+    if (rc == 1 || ef_next_geq(EF(self), x, &found) == EF(self)->n) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromUnsignedLongLong(found);
+}
+
+/**
+ * @brief Implement ``x in EliasFano``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @param arg Candidate value.
+ * @retval 1 Value is stored.
+ * @retval 0 Value is not stored (or not an integer).
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_ef_contains(PyObject *self, PyObject *arg)
+{
+    if (!PyLong_Check(arg)) {
+        return 0;
+    }
+    uint64_t x, found;
+    int rc = py_ef_parse_bound(arg, &x);
+    if (rc != 0) {
+        return rc < 0 ? -1 : 0;
+    }
+    return ef_next_geq(EF(self), x, &found) < EF(self)->n && found == x;
+}
+
+/**
+ * @brief Implement ``EliasFano.__sizeof__``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_ef_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total =
+        (size_t) Py_TYPE(self)->tp_basicsize + ef_memory_usage(EF(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``iter(EliasFano)``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @retval iter New iterator on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_ef_iter(PyObject *self)
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    PyEliasFanoIterObject *iter =
+        PyObject_GC_New(PyEliasFanoIterObject, state->PyEliasFanoIterType);
+    if (!iter) {
+        return NULL;
+    }
+    iter->owner = (PyEliasFanoObject *) Py_NewRef(self);
+    ef_iter_init(EF(self), &iter->it, 0);
+    PyObject_GC_Track(iter);
+    return (PyObject *) iter;
+}
+
+/**
+ * @brief Implement ``repr(EliasFano)``.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_ef_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat(
+        "<cbits.EliasFano object at %p len=%zu low_bits=%u>", self,
+        EF(self)->n, EF(self)->low_bits);
+}
+
+/**
+ * @brief Getter for the read-only ``low_bits`` property.
+ *
+ * @param self A ``PyEliasFanoObject`` instance.
+ * @param closure Unused.
+ * @return Number of low bits stored verbatim per value.
+ */
+static PyObject *
+py_ef_get_low_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(EF(self)->low_bits);
+}
+
+#undef EF
+
+/** @brief Docstring for ``EliasFano.next_geq``. */
+PyDoc_STRVAR(py_ef_next_geq__doc__,
+             "next_geq(x: int) -> int | None\n"
+             "\n"
+             "Return the smallest stored value that is >= x, or None if "
+             "every value is smaller.");
+
+/**
+ * @brief Method table for the EliasFano type.
+ */
+static PyMethodDef PyEliasFano_methods[] = {
+    {"next_geq", (PyCFunction) py_ef_next_geq, METH_O, py_ef_next_geq__doc__},
+    {"__sizeof__", (PyCFunction) py_ef_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the EliasFano type.
+ */
+static PyGetSetDef PyEliasFano_getset[] = {
+    {"low_bits", py_ef_get_low_bits, NULL,
+     PyDoc_STR("Number of low bits stored verbatim per value.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``EliasFano`` type. */
+PyDoc_STRVAR(
+    PyEliasFano__doc__,
+    "EliasFano(values: Iterable[int])\n"
+    "\n"
+    "An immutable, Elias-Fano encoded sequence of non-decreasing "
+    "non-negative 64-bit integers.\n\n"
+    "Each value uses about 2 + log2(max / len) bits. Supports indexing, "
+    "next_geq() successor queries, membership tests and iteration.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "values : Iterable[int]\n"
+    "   Values in non-decreasing order.\n");
+
+/**
+ * @brief Slot table for the ``EliasFano`` type.
+ */
+static PyType_Slot PyEliasFano_slots[] = {
+    {Py_tp_doc, (void *) PyEliasFano__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_ef_new},
+    {Py_tp_init, py_ef_init},
+    {Py_tp_traverse, py_ef_traverse},
+    {Py_tp_dealloc, py_ef_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyEliasFano_methods},
+    {Py_tp_getset, PyEliasFano_getset},
+    {Py_tp_repr, py_ef_repr},
+    {Py_tp_iter, py_ef_iter},
+
+    {Py_sq_length, py_ef_len},
+    {Py_sq_item, py_ef_item},
+    {Py_sq_contains, py_ef_contains},
+    {Py_mp_length, py_ef_len},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``EliasFano``.
+ */
+PyType_Spec PyEliasFano_spec = {
+    .name = "cbits.EliasFano",
+    .basicsize = sizeof(PyEliasFanoObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyEliasFano_slots,
+};
+
+/**
+ * @brief Deallocate an EliasFano iterator.
+ *
+ * @param self A ``PyEliasFanoIterObject`` instance.
+ */
+static void
+py_efiter_dealloc(PyObject *self)
+{
+    PyEliasFanoIterObject *iter = (PyEliasFanoIterObject *) self;
+    PyTypeObject *type = Py_TYPE(iter);
+    PyObject_GC_UnTrack(iter);
+    Py_XDECREF(iter->owner);
+    PyObject_GC_Del(iter);
+    Py_DECREF(type);
+}
+
+/**
+ * @brief GC traverse callback for the EliasFano iterator.
+ *
+ * @param self Iterator object.
+ * @param visit GC visitor callback.
+ * @param arg Extra argument passed by the GC.
+ * @retval 0 Always ``0``.
+ */
+static int
+py_efiter_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    PyEliasFanoIterObject *iter = (PyEliasFanoIterObject *) self;
+    Py_VISIT(Py_TYPE(iter));
+    Py_VISIT(iter->owner);
+    return 0;
+}
+
+/**
+ * @brief Return the next stored value.
+ *
+ * @param self A ``PyEliasFanoIterObject`` instance.
+ * @retval int Next value.
+ * @retval NULL when iteration is complete (no exception set).
+ */
+static PyObject *
+py_efiter_next(PyObject *self)
+{
+    PyEliasFanoIterObject *iter = (PyEliasFanoIterObject *) self;
+    uint64_t value;
+    if (!iter->owner) {
+        return NULL;
+    }
+    if (!ef_iter_next(&iter->it, &value)) {
+        Py_CLEAR(iter->owner);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(value);
+}
+
+/** @brief Docstring for the ``EliasFano`` iterator. */
+PyDoc_STRVAR(PyEliasFanoIter__doc__,
+             "Internal iterator for EliasFano objects.\n"
+             "\n"
+             "Yields the stored values in order. Users should not "
+             "instantiate this type directly.");
+
+/**
+ * @brief Type slots for the EliasFano iterator.
+ */
+static PyType_Slot PyEliasFanoIter_slots[] = {
+    {Py_tp_doc, (void *) PyEliasFanoIter__doc__},
+
+    {Py_tp_dealloc, py_efiter_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_traverse, py_efiter_traverse},
+    {Py_tp_iter, PyObject_SelfIter},
+    {Py_tp_iternext, py_efiter_next},
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``cbits._EliasFanoIterator``.
+ */
+PyType_Spec PyEliasFanoIter_spec = {
+    .name = "cbits._EliasFanoIterator",
+    .basicsize = sizeof(PyEliasFanoIterObject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_DISALLOW_INSTANTIATION | Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = PyEliasFanoIter_slots,
+};
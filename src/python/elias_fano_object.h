@@ -0,0 +1,30 @@
+/**
+ * @file elias_fano_object.h
+ * @brief Definition of the ``EliasFano`` Python type.
+ *
+ * Declares the Python wrapper for the native Elias–Fano sequence:
+ * - \ref PyEliasFanoObject - the Python object structure
+ * - the type specifications of ``EliasFano`` and its iterator
+ *
+ * @see elias_fano.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_ELIAS_FANO_OBJECT_H
+#define CBITS_PY_ELIAS_FANO_OBJECT_H
+
+#include "elias_fano.h"
+#include "cbits_state.h"
+
+/**
+ * @brief Python object wrapping a native ``EliasFano`` instance.
+ */
+typedef struct {
+    PyObject_HEAD EliasFano *ef; /**< Underlying sequence */
+} PyEliasFanoObject;
+
+extern PyType_Spec PyEliasFano_spec;
+extern PyType_Spec PyEliasFanoIter_spec;
+
+#endif /* CBITS_PY_ELIAS_FANO_OBJECT_H */
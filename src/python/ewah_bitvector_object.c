@@ -0,0 +1,497 @@
+/**
+ * @file ewah_bitvector_object.c
+ * @brief Implementation of the ``EWAHBitVector`` Python type.
+ *
+ * Exposes the immutable EWAH run-length compressed vector: element access,
+ * ``count``, bitwise operators evaluated on the compressed streams, and
+ * conversion from and to ``BitVector``.
+ *
+ * @see ewah_bitvector_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "ewah_bitvector_object.h"
+#include "bitvector_object.h"
+#include "bitvector_parse.h"
+
+/**
+ * @brief ``__new__`` for ``EWAHBitVector``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_ewah_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+            PyObject *Py_UNUSED(kwds))
+{
+    PyEWAHBitVectorObject *self =
+        (PyEWAHBitVectorObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->ewah = NULL;
+    return (PyObject *) self;
+}
+
+PyObject *
+ewah_bitvector_wrap_new(PyTypeObject *type, EWAHBitVector *ewah)
+{
+    assert(type != NULL);
+    assert(ewah != NULL);
+
+    PyObject *object = py_ewah_new(type, NULL, NULL);
+    if (object == NULL) {
+        ewah_free(ewah);
+        return NULL;
+    }
+    ((PyEWAHBitVectorObject *) object)->ewah = ewah;
+    return object;
+}
+
+/**
+ * @brief ``__init__`` for ``EWAHBitVector(size)``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_ewah_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t n_bits;
+    static char *kwlist[] = {"size", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n", kwlist, &n_bits)) {
+        return -1;
+    }
+    if (n_bits < 0) {
+        PyErr_SetString(PyExc_ValueError, "size must be >= 0");
+        return -1;
+    }
+    PyEWAHBitVectorObject *obj = (PyEWAHBitVectorObject *) self;
+    ewah_free(obj->ewah);
+    obj->ewah = ewah_new((size_t) n_bits);
+    if (!obj->ewah) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate EWAHBitVector");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_ewah_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyEWAHBitVectorObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_ewah_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyEWAHBitVectorObject *self = (PyEWAHBitVectorObject *) object;
+    ewah_free(self->ewah);
+    self->ewah = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native vector of a Python object. */
+#define EWAH(o) (((PyEWAHBitVectorObject *) (o))->ewah)
+
+/**
+ * @brief Python binding for ``EWAHBitVector.get(index)``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval bool Bit value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ewah_get(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, EWAH(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(ewah_get(EWAH(self), index));
+}
+
+/**
+ * @brief Python binding for ``EWAHBitVector.count()``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @return Number of set bits.
+ */
+static PyObject *
+py_ewah_count(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyLong_FromSize_t(ewah_count(EWAH(self)));
+}
+
+/**
+ * @brief Python binding for ``EWAHBitVector.copy()``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @retval copy New object on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ewah_copy(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    EWAHBitVector *copy = ewah_copy(EWAH(self));
+    if (!copy) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate EWAHBitVector in copy()");
+        return NULL;
+    }
+    return ewah_bitvector_wrap_new(Py_TYPE(self), copy);
+}
+
+/**
+ * @brief Python binding for ``EWAHBitVector.from_bitvector(bv)``.
+ *
+ * @param type The class the method was called on.
+ * @param arg Source ``BitVector``.
+ * @retval object New ``EWAHBitVector`` on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ewah_from_bitvector(PyObject *type, PyObject *arg)
+{
+    cbits_state *state = find_cbits_state_by_type((PyTypeObject *) type);
+    if (!py_bitvector_check(arg, state)) {
+        PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+        return NULL;
+    }
+    EWAHBitVector *ewah = bv_compress_ewah(((PyBitVectorObject *) arg)->bv);
+    if (!ewah) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate EWAHBitVector");
+        return NULL;
+    }
+    return ewah_bitvector_wrap_new((PyTypeObject *) type, ewah);
+}
+
+/**
+ * @brief Python binding for ``EWAHBitVector.to_bitvector()``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @retval object New ``BitVector`` on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ewah_to_bitvector(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    BitVector *bv = ewah_decompress(EWAH(self));
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    return bitvector_wrap_new(state->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Implement ``EWAHBitVector.__sizeof__``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus the compressed buffer in bytes.
+ */
+static PyObject *
+py_ewah_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total = (size_t) Py_TYPE(self)->tp_basicsize +
+                   ewah_memory_usage(EWAH(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Shared implementation of the binary operators.
+ *
+ * @param oA Left operand.
+ * @param oB Right operand.
+ * @param fn Native operation.
+ * @retval object New ``EWAHBitVector`` on success.
+ * @retval Py_NotImplemented if an operand has the wrong type.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ewah_binary(PyObject *oA, PyObject *oB,
+               EWAHBitVector *(*fn)(const EWAHBitVector *,
+                                    const EWAHBitVector *) )
+{
+    cbits_state *state = find_cbits_state_by_operands(oA, oB);
+    if (!state || !py_ewah_bitvector_check(oA, state) ||
+        !py_ewah_bitvector_check(oB, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (EWAH(oA)->n_bits != EWAH(oB)->n_bits) {
+        PyErr_Format(PyExc_ValueError, "length mismatch: A=%zu, B=%zu",
+                     EWAH(oA)->n_bits, EWAH(oB)->n_bits);
+        return NULL;
+    }
+    EWAHBitVector *res = fn(EWAH(oA), EWAH(oB));
+    if (!res) {
+        PyErr_SetString(PyExc_MemoryError, "EWAHBitVector allocation failed");
+        return NULL;
+    }
+    return ewah_bitvector_wrap_new(state->PyEWAHBitVectorType, res);
+}
+
+/** @brief Implement ``A & B``. */
+static PyObject *
+py_ewah_and(PyObject *oA, PyObject *oB)
+{
+    return py_ewah_binary(oA, oB, ewah_and);
+}
+/** @brief Implement ``A | B``. */
+static PyObject *
+py_ewah_or(PyObject *oA, PyObject *oB)
+{
+    return py_ewah_binary(oA, oB, ewah_or);
+}
+/** @brief Implement ``A ^ B``. */
+static PyObject *
+py_ewah_xor(PyObject *oA, PyObject *oB)
+{
+    return py_ewah_binary(oA, oB, ewah_xor);
+}
+/** @brief Implement ``A - B`` (AND-NOT). */
+static PyObject *
+py_ewah_sub(PyObject *oA, PyObject *oB)
+{
+    return py_ewah_binary(oA, oB, ewah_andnot);
+}
+
+/**
+ * @brief Implement ``bool(EWAHBitVector)``.
+ *
+ * A canonical all-zero stream is a single marker holding a zero run.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @retval 1 At least one bit is set.
+ * @retval 0 All bits are zero.
+ */
+static int
+py_ewah_bool(PyObject *self)
+{
+    const EWAHBitVector *ewah = EWAH(self);
+    return ewah->size > 1 || (ewah->buffer[0] & 1);
+}
+
+/**
+ * @brief Implement ``len(EWAHBitVector)``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @return Number of bits.
+ */
+static Py_ssize_t
+py_ewah_len(PyObject *self)
+{
+    return (Py_ssize_t) EWAH(self)->n_bits;
+}
+
+/**
+ * @brief Implement ``EWAHBitVector[index]``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @retval bool Bit value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_ewah_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= EWAH(self)->n_bits) {
+        PyErr_SetString(PyExc_IndexError, "EWAHBitVector index out of range");
+        return NULL;
+    }
+    return PyBool_FromLong(ewah_get(EWAH(self), (size_t) i));
+}
+
+/**
+ * @brief Implement ``==`` and ``!=``.
+ *
+ * @param a First operand.
+ * @param b Second operand.
+ * @param op Comparison operation.
+ * @retval bool Comparison result.
+ * @retval Py_NotImplemented for unsupported comparisons.
+ */
+static PyObject *
+py_ewah_richcompare(PyObject *a, PyObject *b, int op)
+{
+    if (op != Py_EQ && op != Py_NE) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(a));
+    if (!py_ewah_bitvector_check(b, state)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    bool eq = ewah_equal(EWAH(a), EWAH(b));
+    return PyBool_FromLong((op == Py_EQ) == eq);
+}
+
+/**
+ * @brief Implement ``repr(EWAHBitVector)``.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_ewah_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat(
+        "<cbits.EWAHBitVector object at %p bits=%zu words=%zu>", self,
+        EWAH(self)->n_bits, EWAH(self)->size);
+}
+
+/**
+ * @brief Getter for the read-only ``bits`` property.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param closure Unused.
+ * @return Python integer of the bit-length.
+ */
+static PyObject *
+py_ewah_get_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(EWAH(self)->n_bits);
+}
+
+/**
+ * @brief Getter for the read-only ``compressed_words`` property.
+ *
+ * @param self A ``PyEWAHBitVectorObject`` instance.
+ * @param closure Unused.
+ * @return Number of 64-bit words in the compressed stream.
+ */
+static PyObject *
+py_ewah_get_compressed_words(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(EWAH(self)->size);
+}
+
+#undef EWAH
+
+/** @brief Docstring for ``EWAHBitVector.from_bitvector``. */
+PyDoc_STRVAR(py_ewah_from_bitvector__doc__,
+             "from_bitvector(bv: BitVector) -> EWAHBitVector\n"
+             "\n"
+             "Encode bv in EWAH format.");
+/** @brief Docstring for ``EWAHBitVector.count``. */
+PyDoc_STRVAR(py_ewah_count__doc__,
+             "count() -> int\n"
+             "\n"
+             "Return the number of set bits, computed on the compressed "
+             "stream.");
+
+/**
+ * @brief Method table for the EWAHBitVector type.
+ */
+static PyMethodDef PyEWAHBitVector_methods[] = {
+    {"get", (PyCFunction) py_ewah_get, METH_O,
+     PyDoc_STR("get(index: int) -> bool\n\nReturn the bit at index.")},
+    {"count", (PyCFunction) py_ewah_count, METH_NOARGS, py_ewah_count__doc__},
+    {"copy", (PyCFunction) py_ewah_copy, METH_NOARGS,
+     PyDoc_STR("copy() -> EWAHBitVector\n\nReturn a copy.")},
+    {"__copy__", (PyCFunction) py_ewah_copy, METH_NOARGS,
+     PyDoc_STR("__copy__() -> EWAHBitVector\n\nReturn a copy.")},
+    {"from_bitvector", (PyCFunction) py_ewah_from_bitvector,
+     METH_O | METH_CLASS, py_ewah_from_bitvector__doc__},
+    {"to_bitvector", (PyCFunction) py_ewah_to_bitvector, METH_NOARGS,
+     PyDoc_STR("to_bitvector() -> BitVector\n\nDecode into a BitVector.")},
+    {"__sizeof__", (PyCFunction) py_ewah_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the EWAHBitVector type.
+ */
+static PyGetSetDef PyEWAHBitVector_getset[] = {
+    {"bits", py_ewah_get_bits, NULL, PyDoc_STR("The number of bits.")},
+    {"compressed_words", py_ewah_get_compressed_words, NULL,
+     PyDoc_STR("Number of 64-bit words in the compressed stream.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``EWAHBitVector`` type. */
+PyDoc_STRVAR(
+    PyEWAHBitVector__doc__,
+    "EWAHBitVector(size: int)\n"
+    "\n"
+    "An immutable, run-length compressed bit array (EWAH encoding).\n\n"
+    "Runs of all-zero or all-one words are stored as a single marker word. "
+    "Bitwise operators and count() work on the compressed form directly. "
+    "Build instances with from_bitvector(); the constructor creates an "
+    "all-zero vector.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "size : int\n"
+    "   Number of bits in the vector.\n");
+
+/**
+ * @brief Slot table for the ``EWAHBitVector`` type.
+ */
+static PyType_Slot PyEWAHBitVector_slots[] = {
+    {Py_tp_doc, (void *) PyEWAHBitVector__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_ewah_new},
+    {Py_tp_init, py_ewah_init},
+    {Py_tp_traverse, py_ewah_traverse},
+    {Py_tp_dealloc, py_ewah_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyEWAHBitVector_methods},
+    {Py_tp_getset, PyEWAHBitVector_getset},
+    {Py_tp_repr, py_ewah_repr},
+    {Py_tp_richcompare, py_ewah_richcompare},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+
+    {Py_sq_length, py_ewah_len},
+    {Py_sq_item, py_ewah_item},
+    {Py_mp_length, py_ewah_len},
+
+    {Py_nb_and, py_ewah_and},
+    {Py_nb_or, py_ewah_or},
+    {Py_nb_xor, py_ewah_xor},
+    {Py_nb_subtract, py_ewah_sub},
+    {Py_nb_bool, py_ewah_bool},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``EWAHBitVector``.
+ */
+PyType_Spec PyEWAHBitVector_spec = {
+    .name = "cbits.EWAHBitVector",
+    .basicsize = sizeof(PyEWAHBitVectorObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyEWAHBitVector_slots,
+};
@@ -0,0 +1,44 @@
+/**
+ * @file ewah_bitvector_object.h
+ * @brief Definition of the ``EWAHBitVector`` Python type.
+ *
+ * Declares the Python wrapper for the native run-length compressed
+ * ``EWAHBitVector``:
+ * - \ref PyEWAHBitVectorObject - the Python object structure
+ * - the type specification used to create the Python type
+ * - ``ewah_bitvector_wrap_new`` - helper for constructing wrappers
+ *
+ * @see ewah_bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_EWAH_BITVECTOR_OBJECT_H
+#define CBITS_PY_EWAH_BITVECTOR_OBJECT_H
+
+#include "ewah_bitvector.h"
+#include "cbits_state.h"
+
+/**
+ * @brief Python object wrapping a native ``EWAHBitVector`` instance.
+ */
+typedef struct {
+    PyObject_HEAD EWAHBitVector *ewah; /**< Underlying vector */
+} PyEWAHBitVectorObject;
+
+extern PyType_Spec PyEWAHBitVector_spec;
+
+/**
+ * @brief Wrap a native EWAHBitVector in a new Python object.
+ *
+ * @param type The ``PyTypeObject`` representing the EWAHBitVector type.
+ * @param ewah Pointer to an already-allocated native vector.
+ * @retval new_object A new reference on success.
+ * @retval NULL on allocation failure (``ewah`` is freed).
+ *
+ * @note The caller transfers ownership of ``ewah`` to the returned object.
+ */
+PyObject *
+ewah_bitvector_wrap_new(PyTypeObject *type, EWAHBitVector *ewah);
+
+#endif /* CBITS_PY_EWAH_BITVECTOR_OBJECT_H */
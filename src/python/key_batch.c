@@ -0,0 +1,248 @@
+/**
+ * @file key_batch.c
+ * @brief Conversion and hashing of Python keys for the filter types.
+ *
+ * Batches avoid per-key Python work where the representation allows it:
+ * integer buffers and packed byte keys are hashed straight from the
+ * exported memory, only sequences of key objects are visited one by one.
+ *
+ * @see key_batch.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "key_batch.h"
+#include <string.h>
+
+/** @brief Names of the built-in hashes, indexed by ::KeyHash. */
+static const char *const key_hash_names[KEY_HASH_COUNT] = {"xxh64",
+                                                           "fnv1a"};
+
+int
+py_key_hash_parse(const char *name, PyObject *seed_obj, KeyHash *hash,
+                  uint64_t *seed)
+{
+    *hash = KEY_HASH_COUNT;
+    for (int h = 0; h < KEY_HASH_COUNT; ++h) {
+        if (strcmp(name, key_hash_names[h]) == 0) {
+            *hash = (KeyHash) h;
+        }
+    }
+    if (*hash == KEY_HASH_COUNT) {
+        PyErr_Format(PyExc_ValueError,
+                     "unknown hash '%s', expected 'xxh64' or 'fnv1a'", name);
+        return -1;
+    }
+    *seed = 0;
+    if (seed_obj) {
+        *seed = PyLong_AsUnsignedLongLong(seed_obj);
+        if (PyErr_Occurred()) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+const char *
+py_key_hash_name(KeyHash hash)
+{
+    return key_hash_names[hash];
+}
+
+/**
+ * @brief Convert a Python integer key to 64 bits.
+ *
+ * Negative values use their two's complement, so ``-1`` and ``2**64 - 1``
+ * are the same key.
+ *
+ * @param key Python integer.
+ * @param out Receives the key.
+ * @retval 0 Success.
+ * @retval -1 Key does not fit in 64 bits (exception set).
+ */
+static int
+py_key_from_int(PyObject *key, uint64_t *out)
+{
+    int overflow;
+    long long v = PyLong_AsLongLongAndOverflow(key, &overflow);
+    if (overflow > 0) {
+        unsigned long long u = PyLong_AsUnsignedLongLong(key);
+        if (u == (unsigned long long) -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        *out = (uint64_t) u;
+        return 0;
+    }
+    if (overflow < 0) {
+        PyErr_SetString(PyExc_OverflowError,
+                        "integer keys must fit in 64 bits");
+        return -1;
+    }
+    if (v == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    *out = (uint64_t) v;
+    return 0;
+}
+
+int
+py_key_hash(KeyHash hash, uint64_t seed, PyObject *key, uint64_t *out)
+{
+    if (PyLong_Check(key)) {
+        uint64_t v;
+        if (py_key_from_int(key, &v) < 0) {
+            return -1;
+        }
+        *out = key_hash_u64(hash, seed, v);
+        return 0;
+    }
+    if (PyUnicode_Check(key)) {
+        Py_ssize_t len;
+        const char *s = PyUnicode_AsUTF8AndSize(key, &len);
+        if (!s) {
+            return -1;
+        }
+        *out = key_hash(hash, seed, s, (size_t) len);
+        return 0;
+    }
+    if (PyObject_CheckBuffer(key)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(key, &view, PyBUF_SIMPLE) < 0) {
+            return -1;
+        }
+        *out = key_hash(hash, seed, view.buf, (size_t) view.len);
+        PyBuffer_Release(&view);
+        return 0;
+    }
+    PyErr_Format(PyExc_TypeError,
+                 "keys must be int, str or bytes-like, not '%.200s'",
+                 Py_TYPE(key)->tp_name);
+    return -1;
+}
+
+int
+py_key_batch_open(PyObject *keys, PyObject *width_obj, PyKeyBatch *k)
+{
+    memset(k, 0, sizeof(*k));
+    if (width_obj && width_obj != Py_None) {
+        Py_ssize_t width = PyLong_AsSsize_t(width_obj);
+        if (width == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (width <= 0) {
+            PyErr_SetString(PyExc_ValueError, "width must be > 0");
+            return -1;
+        }
+        if (PyObject_GetBuffer(keys, &k->view, PyBUF_SIMPLE) < 0) {
+            return -1;
+        }
+        k->has_view = 1;
+        if (k->view.len % width) {
+            PyErr_Format(PyExc_ValueError,
+                         "buffer length %zd is not a multiple of width %zd",
+                         k->view.len, width);
+            return -1;
+        }
+        k->width = (size_t) width;
+        k->n = (size_t) (k->view.len / width);
+        return 0;
+    }
+    if (PyObject_CheckBuffer(keys)) {
+        if (PyObject_GetBuffer(keys, &k->view,
+                               PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+            return -1;
+        }
+        k->has_view = 1;
+        const char *fmt = k->view.format ? k->view.format : "B";
+        if (*fmt == '@' || *fmt == '=' || *fmt == '<') {
+            fmt++;
+        }
+        const Py_ssize_t size = k->view.itemsize;
+        if (!fmt[0] || fmt[1] || !strchr("bBhHiIlLqQnN", fmt[0]) ||
+            (size != 1 && size != 2 && size != 4 && size != 8)) {
+            PyErr_Format(PyExc_ValueError,
+                         "unsupported buffer format '%s', expected native "
+                         "integers",
+                         k->view.format ? k->view.format : "B");
+            return -1;
+        }
+        k->is_signed = fmt[0] >= 'a';
+        k->n = (size_t) (k->view.len / size);
+        return 0;
+    }
+    k->seq = PySequence_Fast(keys, "keys must be iterable");
+    if (!k->seq) {
+        return -1;
+    }
+    k->n = (size_t) PySequence_Fast_GET_SIZE(k->seq);
+    return 0;
+}
+
+void
+py_key_batch_close(PyKeyBatch *k)
+{
+    if (k->has_view) {
+        PyBuffer_Release(&k->view);
+    }
+    Py_XDECREF(k->seq);
+}
+
+/**
+ * @brief Load integer item @p i of a buffer batch.
+ *
+ * @param k Batch with an integer buffer.
+ * @param i Item index.
+ * @return The item, sign-extended for signed formats.
+ */
+static inline uint64_t
+py_key_batch_int(const PyKeyBatch *k, size_t i)
+{
+    const char *p = (const char *) k->view.buf + i * k->view.itemsize;
+    switch (k->view.itemsize) {
+    case 1:
+        return k->is_signed ? (uint64_t) (int64_t) *(const int8_t *) p
+                            : *(const uint8_t *) p;
+    case 2: {
+        uint16_t v;
+        memcpy(&v, p, sizeof(v));
+        return k->is_signed ? (uint64_t) (int64_t) (int16_t) v : v;
+    }
+    case 4: {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return k->is_signed ? (uint64_t) (int64_t) (int32_t) v : v;
+    }
+    default: {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    }
+}
+
+int
+py_key_batch_hash(KeyHash hash, uint64_t seed, const PyKeyBatch *k,
+                  size_t start, size_t count, uint64_t *out)
+{
+    if (k->seq) {
+        PyObject **items = PySequence_Fast_ITEMS(k->seq);
+        for (size_t i = 0; i < count; ++i) {
+            if (py_key_hash(hash, seed, items[start + i], &out[i]) < 0) {
+                return -1;
+            }
+        }
+    }
+    else if (k->width) {
+        key_hash_fixed_many(hash, seed,
+                            (const char *) k->view.buf + start * k->width,
+                            k->width, count, out);
+    }
+    else {
+        uint64_t keys[PY_KEY_BATCH];
+        for (size_t i = 0; i < count; ++i) {
+            keys[i] = py_key_batch_int(k, start + i);
+        }
+        key_hash_u64_many(hash, seed, keys, count, out);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file key_batch.h
+ * @brief Python key conversion shared by the probabilistic filter types.
+ *
+ * Declares:
+ * - hash name lookup (@ref py_key_hash_parse, @ref py_key_hash_name)
+ * - hashing of a single key object (@ref py_key_hash)
+ * - \ref PyKeyBatch, a batch of keys given as a sequence, an integer buffer
+ *   or packed fixed-width bytes, hashed @ref PY_KEY_BATCH keys at a time
+ *
+ * Keys are integers (two's complement, 64 bits), strings (hashed as UTF-8)
+ * or bytes-like objects.
+ *
+ * @see key_hash.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_KEY_BATCH_H
+#define CBITS_PY_KEY_BATCH_H
+
+#include "cbits_module.h"
+#include "key_hash.h"
+
+/**
+ * @def PY_KEY_BATCH
+ * @brief Keys hashed per call of @ref py_key_batch_hash; a multiple of 64
+ *        so that per-key result bits of a batch start on a word.
+ */
+#define PY_KEY_BATCH 256
+
+/**
+ * @brief Parse the ``hash`` and ``seed`` constructor arguments.
+ * @param name Hash name, ``"xxh64"`` or ``"fnv1a"``.
+ * @param seed_obj Python integer seed, or NULL for 0.
+ * @param hash Receives the hash function.
+ * @param seed Receives the seed.
+ * @retval 0 Success.
+ * @retval -1 Unknown name or invalid seed (exception set).
+ * @since 0.4.0
+ */
+int
+py_key_hash_parse(const char *name, PyObject *seed_obj, KeyHash *hash,
+                  uint64_t *seed);
+/**
+ * @brief Python name of a hash function.
+ * @param hash Hash function.
+ * @return Static name string.
+ * @since 0.4.0
+ */
+const char *
+py_key_hash_name(KeyHash hash);
+/**
+ * @brief Hash one Python key.
+ * @param hash Hash function.
+ * @param seed Hash seed.
+ * @param key Integer, string or bytes-like object.
+ * @param out Receives the key hash.
+ * @retval 0 Success.
+ * @retval -1 Unsupported key (exception set).
+ * @since 0.4.0
+ */
+int
+py_key_hash(KeyHash hash, uint64_t seed, PyObject *key, uint64_t *out);
+
+/**
+ * @brief A batch of keys in one of the accepted representations.
+ */
+typedef struct {
+    PyObject *seq;  /**< Fast sequence of key objects, or NULL. */
+    Py_buffer view; /**< Integer or packed byte buffer. */
+    int has_view;   /**< Whether @c view must be released. */
+    size_t width;   /**< Bytes per packed key; 0 for integer items. */
+    int is_signed;  /**< Integer items are signed. */
+    size_t n;       /**< Number of keys. */
+} PyKeyBatch;
+
+/**
+ * @brief Classify a ``keys`` argument.
+ *
+ * - with ``width``: a bytes-like object of packed ``width``-byte keys
+ * - an object exporting an integer buffer (``array``, ``memoryview``,
+ *   ``bytes``): one integer key per item, in native byte order
+ * - any other iterable: one key object per item
+ *
+ * @param keys Python argument.
+ * @param width_obj ``width`` argument, or NULL / ``None``.
+ * @param k Receives the classified batch.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ * @note Release @p k with @ref py_key_batch_close in both cases.
+ * @since 0.4.0
+ */
+int
+py_key_batch_open(PyObject *keys, PyObject *width_obj, PyKeyBatch *k);
+/**
+ * @brief Release a batch opened by @ref py_key_batch_open.
+ * @param k Batch.
+ * @since 0.4.0
+ */
+void
+py_key_batch_close(PyKeyBatch *k);
+/**
+ * @brief Hash keys ``[start, start + count)`` of a batch.
+ * @param hash Hash function.
+ * @param seed Hash seed.
+ * @param k Batch.
+ * @param start First key.
+ * @param count Number of keys, at most @ref PY_KEY_BATCH.
+ * @param out Output of @p count hashes.
+ * @retval 0 Success.
+ * @retval -1 Unsupported key (exception set).
+ * @since 0.4.0
+ */
+int
+py_key_batch_hash(KeyHash hash, uint64_t seed, const PyKeyBatch *k,
+                  size_t start, size_t count, uint64_t *out);
+
+#endif /* CBITS_PY_KEY_BATCH_H */
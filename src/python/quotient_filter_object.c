@@ -0,0 +1,590 @@
+/**
+ * @file quotient_filter_object.c
+ * @brief Implementation of the ``QuotientFilter`` Python type.
+ *
+ * Exposes the rank-and-select quotient filter as an approximate multiset
+ * with deletion. Keys are integers, strings (hashed as UTF-8) or bytes-like
+ * objects; ``add_many``, ``contains_many`` and ``remove_many`` accept the
+ * same batches as the Bloom filters and hand @ref PY_KEY_BATCH hashes at a
+ * time to the prefetching native loops.
+ *
+ * @see quotient_filter_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "quotient_filter_object.h"
+
+/** @brief Shorthand for the native filter of a Python object. */
+#define QF(o) (((PyQuotientFilterObject *) (o))->qf)
+
+/**
+ * @brief ``__new__`` for ``QuotientFilter``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_qf_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+          PyObject *Py_UNUSED(kwds))
+{
+    PyQuotientFilterObject *self =
+        (PyQuotientFilterObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->qf = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief ``__init__(capacity, error_rate=0.01, *, hash="xxh64", seed=0)``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_qf_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t capacity;
+    double error_rate = 0.01;
+    const char *hash_name = "xxh64";
+    PyObject *seed_obj = NULL;
+    static char *kwlist[] = {"capacity", "error_rate", "hash", "seed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|d$sO", kwlist, &capacity,
+                                     &error_rate, &hash_name, &seed_obj)) {
+        return -1;
+    }
+    if (capacity < 0) {
+        PyErr_SetString(PyExc_ValueError, "capacity must be >= 0");
+        return -1;
+    }
+    KeyHash hash;
+    uint64_t seed;
+    if (py_key_hash_parse(hash_name, seed_obj, &hash, &seed) < 0) {
+        return -1;
+    }
+    unsigned q_bits, r_bits;
+    if (qf_params((size_t) capacity, error_rate, &q_bits, &r_bits) < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "error_rate must be between 0 and 1 (exclusive) "
+                        "and capacity not too large");
+        return -1;
+    }
+    QuotientFilter *qf = qf_new(q_bits, r_bits, hash, seed);
+    if (!qf) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate QuotientFilter");
+        return -1;
+    }
+    qf_free(QF(self));
+    QF(self) = qf;
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_qf_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyQuotientFilterObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_qf_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    qf_free(QF(object));
+    QF(object) = NULL;
+    type->tp_free(object);
+    Py_DECREF(type);
+}
+
+/**
+ * @brief Hash one key with the filter's hash function.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param key Key object.
+ * @param out Receives the hash.
+ * @retval 0 Success.
+ * @retval -1 Unsupported key (exception set).
+ */
+static inline int
+py_qf_hash_key(PyObject *self, PyObject *key, uint64_t *out)
+{
+    return py_key_hash(QF(self)->hash, QF(self)->seed, key, out);
+}
+
+/** @brief Raise the error for a filter without free slots. */
+static void
+py_qf_set_full(void)
+{
+    PyErr_SetString(PyExc_OverflowError, "QuotientFilter is full");
+}
+
+/**
+ * @brief Python binding for ``add(key)``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param key Key to insert.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_qf_add(PyObject *self, PyObject *key)
+{
+    uint64_t h;
+    if (py_qf_hash_key(self, key, &h) < 0) {
+        return NULL;
+    }
+    if (qf_insert_hash(QF(self), h) < 0) {
+        py_qf_set_full();
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Shared body of ``remove(key)`` and ``discard(key)``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param key Key to remove.
+ * @param strict Raise ``KeyError`` if the key is absent.
+ * @retval Py_None Success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_qf_remove_impl(PyObject *self, PyObject *key, int strict)
+{
+    uint64_t h;
+    if (py_qf_hash_key(self, key, &h) < 0) {
+        return NULL;
+    }
+    if (!qf_remove_hash(QF(self), h) && strict) {
+        PyErr_SetObject(PyExc_KeyError, key);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/** @brief Python binding for ``remove(key)``. */
+static PyObject *
+py_qf_remove(PyObject *self, PyObject *key)
+{
+    return py_qf_remove_impl(self, key, 1);
+}
+
+/** @brief Python binding for ``discard(key)``. */
+static PyObject *
+py_qf_discard(PyObject *self, PyObject *key)
+{
+    return py_qf_remove_impl(self, key, 0);
+}
+
+/**
+ * @brief Python binding for ``count(key)``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param key Key to count.
+ * @retval int Number of stored copies of the key's fingerprint.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_qf_count(PyObject *self, PyObject *key)
+{
+    uint64_t h;
+    if (py_qf_hash_key(self, key, &h) < 0) {
+        return NULL;
+    }
+    return PyLong_FromSize_t(qf_count_hash(QF(self), h));
+}
+
+/**
+ * @brief Implement ``key in filter``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param key Key to look up.
+ * @retval 1 The key may be present.
+ * @retval 0 The key is absent.
+ * @retval -1 Unsupported key (exception set).
+ */
+static int
+py_qf_contains(PyObject *self, PyObject *key)
+{
+    uint64_t h;
+    if (py_qf_hash_key(self, key, &h) < 0) {
+        return -1;
+    }
+    return qf_contains_hash(QF(self), h);
+}
+
+/** @brief Batched operation applied by @ref py_qf_batch. */
+typedef enum {
+    PY_QF_ADD,      /**< Insert every key. */
+    PY_QF_CONTAINS, /**< Look up every key. */
+    PY_QF_REMOVE,   /**< Remove one copy of every key. */
+} PyQfBatchOp;
+
+/**
+ * @brief Shared body of ``add_many``, ``contains_many`` and
+ *        ``remove_many``.
+ *
+ * Keys processed before an unsupported key, or before the filter ran out
+ * of slots, stay inserted or removed.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @param op Operation to apply.
+ * @retval Py_None for ``add_many``.
+ * @retval BitVector One bit per key for the other operations.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_qf_batch(PyObject *self, PyObject *args, PyObject *kwds, PyQfBatchOp op)
+{
+    PyObject *keys, *width = NULL;
+    static char *kwlist[] = {"keys", "width", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &keys,
+                                     &width)) {
+        return NULL;
+    }
+    PyKeyBatch k;
+    if (py_key_batch_open(keys, width, &k) < 0) {
+        py_key_batch_close(&k);
+        return NULL;
+    }
+    BitVector *result = NULL;
+    if (op != PY_QF_ADD) {
+        result = bv_new(k.n);
+        if (!result) {
+            py_key_batch_close(&k);
+            PyErr_SetString(PyExc_MemoryError,
+                            "Failed to allocate BitVector");
+            return NULL;
+        }
+    }
+    QuotientFilter *qf = QF(self);
+    uint64_t hashes[PY_KEY_BATCH];
+    for (size_t start = 0; start < k.n; start += PY_KEY_BATCH) {
+        size_t count = k.n - start < PY_KEY_BATCH ? k.n - start
+                                                  : PY_KEY_BATCH;
+        if (py_key_batch_hash(qf->hash, qf->seed, &k, start, count,
+                              hashes) < 0) {
+            goto error;
+        }
+        /* PY_KEY_BATCH is a multiple of 64, so batches start on a word. */
+        if (op == PY_QF_ADD) {
+            if (qf_insert_hashes(qf, hashes, count) < count) {
+                py_qf_set_full();
+                goto error;
+            }
+        }
+        else if (op == PY_QF_CONTAINS) {
+            qf_contains_hashes(qf, hashes, count,
+                               result->data + (start >> 6));
+        }
+        else {
+            qf_remove_hashes(qf, hashes, count, result->data + (start >> 6));
+        }
+    }
+    py_key_batch_close(&k);
+    if (op == PY_QF_ADD) {
+        Py_RETURN_NONE;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    return bitvector_wrap_new(state->PyBitVectorType, result);
+
+error:
+    py_key_batch_close(&k);
+    bv_free(result);
+    return NULL;
+}
+
+/** @brief Python binding for ``add_many(keys, width=None)``. */
+static PyObject *
+py_qf_add_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    return py_qf_batch(self, args, kwds, PY_QF_ADD);
+}
+
+/** @brief Python binding for ``contains_many(keys, width=None)``. */
+static PyObject *
+py_qf_contains_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    return py_qf_batch(self, args, kwds, PY_QF_CONTAINS);
+}
+
+/** @brief Python binding for ``remove_many(keys, width=None)``. */
+static PyObject *
+py_qf_remove_many(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    return py_qf_batch(self, args, kwds, PY_QF_REMOVE);
+}
+
+/**
+ * @brief Python binding for ``copy()``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param ignored Unused.
+ * @retval QuotientFilter Independent copy.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_qf_copy(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    QuotientFilter *qf = qf_copy(QF(self));
+    if (!qf) {
+        PyErr_SetString(PyExc_MemoryError,
+                        "Failed to allocate QuotientFilter");
+        return NULL;
+    }
+    PyTypeObject *type = Py_TYPE(self);
+    PyQuotientFilterObject *obj =
+        (PyQuotientFilterObject *) type->tp_alloc(type, 0);
+    if (!obj) {
+        qf_free(qf);
+        return NULL;
+    }
+    obj->qf = qf;
+    return (PyObject *) obj;
+}
+
+/**
+ * @brief Python binding for ``__sizeof__()``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @param ignored Unused.
+ * @return Object size plus the native footprint, in bytes.
+ */
+static PyObject *
+py_qf_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total = (size_t) Py_TYPE(self)->tp_basicsize +
+                   qf_memory_usage(QF(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Return the number of stored keys.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @return Number of keys, counting duplicates.
+ */
+static Py_ssize_t
+py_qf_len(PyObject *self)
+{
+    return (Py_ssize_t) QF(self)->n_items;
+}
+
+/**
+ * @brief Implement ``repr()``.
+ *
+ * @param self A ``PyQuotientFilterObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_qf_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat("<%s object at %p items=%zu slots=%zu>",
+                                Py_TYPE(self)->tp_name, self,
+                                QF(self)->n_items, QF(self)->n_slots);
+}
+
+/** @brief Getter for the read-only ``quotient_bits`` property. */
+static PyObject *
+py_qf_get_quotient_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(QF(self)->q_bits);
+}
+
+/** @brief Getter for the read-only ``remainder_bits`` property. */
+static PyObject *
+py_qf_get_remainder_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(QF(self)->r_bits);
+}
+
+/** @brief Getter for the read-only ``slots`` property. */
+static PyObject *
+py_qf_get_slots(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(QF(self)->n_slots);
+}
+
+/** @brief Getter for the read-only ``load_factor`` property. */
+static PyObject *
+py_qf_get_load_factor(PyObject *self, void *Py_UNUSED(closure))
+{
+    const QuotientFilter *qf = QF(self);
+    return PyFloat_FromDouble((double) qf->n_items /
+                              (double) ((size_t) 1 << qf->q_bits));
+}
+
+/** @brief Getter for the read-only ``hash`` property. */
+static PyObject *
+py_qf_get_hash(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyUnicode_FromString(py_key_hash_name(QF(self)->hash));
+}
+
+/** @brief Getter for the read-only ``seed`` property. */
+static PyObject *
+py_qf_get_seed(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLongLong(QF(self)->seed);
+}
+
+#undef QF
+
+/** @brief Docstring for ``add_many``. */
+PyDoc_STRVAR(py_qf_add_many__doc__,
+             "add_many(keys, width: int | None = None) -> None\n"
+             "\n"
+             "Insert a batch of keys: an iterable of int, str or bytes-like "
+             "keys, an integer buffer such as array('q') (one key per item, "
+             "native byte order), or with width a bytes-like object of "
+             "packed width-byte keys. Raises OverflowError when the filter "
+             "runs out of slots; earlier keys stay inserted.");
+/** @brief Docstring for ``contains_many``. */
+PyDoc_STRVAR(py_qf_contains_many__doc__,
+             "contains_many(keys, width: int | None = None) -> BitVector\n"
+             "\n"
+             "Look up a batch of keys given like in add_many. Bit i of the "
+             "result is set if key i may be present and clear if it is "
+             "definitely absent.");
+/** @brief Docstring for ``remove_many``. */
+PyDoc_STRVAR(py_qf_remove_many__doc__,
+             "remove_many(keys, width: int | None = None) -> BitVector\n"
+             "\n"
+             "Remove one copy of each key of a batch given like in add_many. "
+             "Bit i of the result is set if key i was found and removed.");
+
+/**
+ * @brief Method table for the ``QuotientFilter`` type.
+ */
+static PyMethodDef PyQuotientFilter_methods[] = {
+    {"add", (PyCFunction) py_qf_add, METH_O,
+     PyDoc_STR("add(key: int | str | bytes) -> None\n\n"
+               "Insert one key; inserting a key twice stores it twice.")},
+    {"remove", (PyCFunction) py_qf_remove, METH_O,
+     PyDoc_STR("remove(key: int | str | bytes) -> None\n\n"
+               "Remove one copy of a key; raises KeyError if absent.")},
+    {"discard", (PyCFunction) py_qf_discard, METH_O,
+     PyDoc_STR("discard(key: int | str | bytes) -> None\n\n"
+               "Remove one copy of a key if present.")},
+    {"count", (PyCFunction) py_qf_count, METH_O,
+     PyDoc_STR("count(key: int | str | bytes) -> int\n\n"
+               "Number of stored copies of the key's fingerprint, an upper "
+               "bound on how often the key was inserted.")},
+    {"add_many", (PyCFunction) (void (*)(void)) py_qf_add_many,
+     METH_VARARGS | METH_KEYWORDS, py_qf_add_many__doc__},
+    {"contains_many", (PyCFunction) (void (*)(void)) py_qf_contains_many,
+     METH_VARARGS | METH_KEYWORDS, py_qf_contains_many__doc__},
+    {"remove_many", (PyCFunction) (void (*)(void)) py_qf_remove_many,
+     METH_VARARGS | METH_KEYWORDS, py_qf_remove_many__doc__},
+    {"copy", (PyCFunction) py_qf_copy, METH_NOARGS,
+     PyDoc_STR("copy() -> QuotientFilter\n\nReturn an independent copy.")},
+    {"__sizeof__", (PyCFunction) py_qf_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the ``QuotientFilter`` type.
+ */
+static PyGetSetDef PyQuotientFilter_getset[] = {
+    {"quotient_bits", py_qf_get_quotient_bits, NULL,
+     PyDoc_STR("Quotient bits; the filter has 2**quotient_bits home "
+               "slots.")},
+    {"remainder_bits", py_qf_get_remainder_bits, NULL,
+     PyDoc_STR("Remainder bits stored per key.")},
+    {"slots", py_qf_get_slots, NULL,
+     PyDoc_STR("Total number of slots including the overflow area.")},
+    {"load_factor", py_qf_get_load_factor, NULL,
+     PyDoc_STR("Stored keys per home slot.")},
+    {"hash", py_qf_get_hash, NULL,
+     PyDoc_STR("Name of the key hash function.")},
+    {"seed", py_qf_get_seed, NULL, PyDoc_STR("Seed of the key hash.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``QuotientFilter`` type. */
+PyDoc_STRVAR(
+    PyQuotientFilter__doc__,
+    "QuotientFilter(capacity: int, error_rate: float = 0.01, *, "
+    "hash: str = 'xxh64', seed: int = 0)\n"
+    "\n"
+    "A rank-and-select quotient filter: an approximate multiset with "
+    "deletion.\n\n"
+    "Each key is reduced to a fingerprint whose high bits select a home "
+    "slot and whose low bits are stored there; occupied and run-end "
+    "BitVectors locate the run of a slot with one popcount and one "
+    "select. Lookups have no false negatives and a false positive rate "
+    "of about error_rate. Keys can be removed again; removing a key that "
+    "was never added may remove a colliding one.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "capacity : int\n"
+    "   Expected number of keys. The filter holds one key per home slot, "
+    "at least 10% more than capacity, so that load_factor stays at most "
+    "1.0 and the false positive rate at most error_rate; add raises "
+    "OverflowError beyond that.\n"
+    "error_rate : float, optional\n"
+    "   Target false positive rate.\n"
+    "hash : str, optional\n"
+    "   'xxh64' (default) or 'fnv1a'.\n"
+    "seed : int, optional\n"
+    "   Seed of the key hash.\n");
+
+/**
+ * @brief Slot table for the ``QuotientFilter`` type.
+ */
+static PyType_Slot PyQuotientFilter_slots[] = {
+    {Py_tp_doc, (void *) PyQuotientFilter__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_qf_new},
+    {Py_tp_init, py_qf_init},
+    {Py_tp_traverse, py_qf_traverse},
+    {Py_tp_dealloc, py_qf_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyQuotientFilter_methods},
+    {Py_tp_getset, PyQuotientFilter_getset},
+    {Py_tp_repr, py_qf_repr},
+
+    {Py_sq_contains, py_qf_contains},
+    {Py_sq_length, py_qf_len},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``QuotientFilter``.
+ */
+PyType_Spec PyQuotientFilter_spec = {
+    .name = "cbits.QuotientFilter",
+    .basicsize = sizeof(PyQuotientFilterObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyQuotientFilter_slots,
+};
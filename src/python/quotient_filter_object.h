@@ -0,0 +1,30 @@
+/**
+ * @file quotient_filter_object.h
+ * @brief Definition of the ``QuotientFilter`` Python type.
+ *
+ * Declares the Python wrapper around the native quotient filter:
+ * - \ref PyQuotientFilterObject - the Python object structure
+ * - \ref PyQuotientFilter_spec - the type specification
+ *
+ * @see quotient_filter.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_QUOTIENT_FILTER_OBJECT_H
+#define CBITS_PY_QUOTIENT_FILTER_OBJECT_H
+
+#include "quotient_filter.h"
+#include "bitvector_object.h"
+#include "key_batch.h"
+
+/**
+ * @brief Python object wrapping a native ``QuotientFilter``.
+ */
+typedef struct {
+    PyObject_HEAD QuotientFilter *qf; /**< Underlying filter */
+} PyQuotientFilterObject;
+
+extern PyType_Spec PyQuotientFilter_spec;
+
+#endif /* CBITS_PY_QUOTIENT_FILTER_OBJECT_H */
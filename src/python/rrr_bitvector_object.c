@@ -0,0 +1,373 @@
+/**
+ * @file rrr_bitvector_object.c
+ * @brief Implementation of the ``RRRBitVector`` Python type.
+ *
+ * Exposes the read-only RRR vector built from a ``BitVector``: element
+ * access, ``rank``, ``select`` and ``count`` with the same semantics as the
+ * corresponding ``BitVector`` methods.
+ *
+ * @see rrr_bitvector_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "rrr_bitvector_object.h"
+#include "bitvector_object.h"
+#include "bitvector_parse.h"
+
+/**
+ * @brief ``__new__`` for ``RRRBitVector``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_rrr_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+           PyObject *Py_UNUSED(kwds))
+{
+    PyRRRBitVectorObject *self =
+        (PyRRRBitVectorObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->rrr = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief ``__init__`` for ``RRRBitVector(bv)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_rrr_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *source;
+    static char *kwlist[] = {"bv", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &source)) {
+        return -1;
+    }
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    if (!py_bitvector_check(source, state)) {
+        PyErr_SetString(PyExc_TypeError, "expected a BitVector");
+        return -1;
+    }
+    PyRRRBitVectorObject *obj = (PyRRRBitVectorObject *) self;
+    rrr_free(obj->rrr);
+    obj->rrr = bv_build_rrr(((PyBitVectorObject *) source)->bv);
+    if (!obj->rrr) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate RRRBitVector");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_rrr_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyRRRBitVectorObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_rrr_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyRRRBitVectorObject *self = (PyRRRBitVectorObject *) object;
+    rrr_free(self->rrr);
+    self->rrr = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native vector of a Python object. */
+#define RRR(o) (((PyRRRBitVectorObject *) (o))->rrr)
+
+/**
+ * @brief Python binding for ``RRRBitVector.get(index)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval bool Bit value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_rrr_get(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, RRR(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(rrr_get(RRR(self), index));
+}
+
+/**
+ * @brief Python binding for ``RRRBitVector.rank(index)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param arg Index.
+ * @retval int Number of set bits in ``[0..index]``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_rrr_rank(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, RRR(self)->n_bits, &index) < 0) {
+        return NULL;
+    }
+    return PyLong_FromSize_t(rrr_rank(RRR(self), index));
+}
+
+/**
+ * @brief Python binding for ``RRRBitVector.select(k)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param arg Zero-based index of the set bit.
+ * @retval int Position of the k-th set bit.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_rrr_select(PyObject *self, PyObject *arg)
+{
+    Py_ssize_t k = PyLong_AsSsize_t(arg);
+    if (k == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    size_t pos = k < 0 ? SIZE_MAX : rrr_select(RRR(self), (size_t) k);
+    if (pos == SIZE_MAX) {
+        PyErr_SetString(PyExc_IndexError, "select index out of range");
+        return NULL;
+    }
+    return PyLong_FromSize_t(pos);
+}
+
+/**
+ * @brief Python binding for ``RRRBitVector.count()``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @return Number of set bits.
+ */
+static PyObject *
+py_rrr_count(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyLong_FromSize_t(rrr_count(RRR(self)));
+}
+
+/**
+ * @brief Python binding for ``RRRBitVector.to_bitvector()``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @retval object New ``BitVector`` on success.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_rrr_to_bitvector(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    cbits_state *state = find_cbits_state_by_type(Py_TYPE(self));
+    BitVector *bv = rrr_to_bitvector(RRR(self));
+    if (!bv) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate BitVector");
+        return NULL;
+    }
+    return bitvector_wrap_new(state->PyBitVectorType, bv);
+}
+
+/**
+ * @brief Implement ``RRRBitVector.__sizeof__``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_rrr_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total =
+        (size_t) Py_TYPE(self)->tp_basicsize + rrr_memory_usage(RRR(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``len(RRRBitVector)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @return Number of bits.
+ */
+static Py_ssize_t
+py_rrr_len(PyObject *self)
+{
+    return (Py_ssize_t) RRR(self)->n_bits;
+}
+
+/**
+ * @brief Implement ``RRRBitVector[index]``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @retval bool Bit value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_rrr_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= RRR(self)->n_bits) {
+        PyErr_SetString(PyExc_IndexError, "RRRBitVector index out of range");
+        return NULL;
+    }
+    return PyBool_FromLong(rrr_get(RRR(self), (size_t) i));
+}
+
+/**
+ * @brief Implement ``bool(RRRBitVector)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @retval 1 At least one bit is set.
+ * @retval 0 All bits are zero.
+ */
+static int
+py_rrr_bool(PyObject *self)
+{
+    return rrr_count(RRR(self)) > 0;
+}
+
+/**
+ * @brief Implement ``repr(RRRBitVector)``.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_rrr_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat(
+        "<cbits.RRRBitVector object at %p bits=%zu ones=%zu>", self,
+        RRR(self)->n_bits, RRR(self)->n_ones);
+}
+
+/**
+ * @brief Getter for the read-only ``bits`` property.
+ *
+ * @param self A ``PyRRRBitVectorObject`` instance.
+ * @param closure Unused.
+ * @return Python integer of the bit-length.
+ */
+static PyObject *
+py_rrr_get_bits(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(RRR(self)->n_bits);
+}
+
+#undef RRR
+
+/** @brief Docstring for ``RRRBitVector.rank``. */
+PyDoc_STRVAR(py_rrr_rank__doc__,
+             "rank(index: int) -> int\n"
+             "\n"
+             "Count the number of bits set to True in the range [0..index].\n"
+             "Supports negative indexing. Raises IndexError if out of range.");
+/** @brief Docstring for ``RRRBitVector.select``. */
+PyDoc_STRVAR(py_rrr_select__doc__,
+             "select(k: int) -> int\n"
+             "\n"
+             "Return the position of the k-th set bit (zero-based), so that\n"
+             "rank(select(k)) == k + 1. Raises IndexError if fewer than k+1\n"
+             "bits are set.");
+
+/**
+ * @brief Method table for the RRRBitVector type.
+ */
+static PyMethodDef PyRRRBitVector_methods[] = {
+    {"get", (PyCFunction) py_rrr_get, METH_O,
+     PyDoc_STR("get(index: int) -> bool\n\nReturn the bit at index.")},
+    {"rank", (PyCFunction) py_rrr_rank, METH_O, py_rrr_rank__doc__},
+    {"select", (PyCFunction) py_rrr_select, METH_O, py_rrr_select__doc__},
+    {"count", (PyCFunction) py_rrr_count, METH_NOARGS,
+     PyDoc_STR("count() -> int\n\nReturn the number of set bits.")},
+    {"to_bitvector", (PyCFunction) py_rrr_to_bitvector, METH_NOARGS,
+     PyDoc_STR("to_bitvector() -> BitVector\n\nDecode into a BitVector.")},
+    {"__sizeof__", (PyCFunction) py_rrr_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the RRRBitVector type.
+ */
+static PyGetSetDef PyRRRBitVector_getset[] = {
+    {"bits", py_rrr_get_bits, NULL, PyDoc_STR("The number of bits.")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``RRRBitVector`` type. */
+PyDoc_STRVAR(
+    PyRRRBitVector__doc__,
+    "RRRBitVector(bv: BitVector)\n"
+    "\n"
+    "A read-only, entropy-compressed copy of a BitVector (RRR encoding).\n\n"
+    "Every 64-bit block is stored as its popcount plus its index among all "
+    "blocks with that popcount. Sampled ranks keep get(), rank() and "
+    "select() constant time.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "bv : BitVector\n"
+    "   Source vector; later changes to it are not reflected.\n");
+
+/**
+ * @brief Slot table for the ``RRRBitVector`` type.
+ */
+static PyType_Slot PyRRRBitVector_slots[] = {
+    {Py_tp_doc, (void *) PyRRRBitVector__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_rrr_new},
+    {Py_tp_init, py_rrr_init},
+    {Py_tp_traverse, py_rrr_traverse},
+    {Py_tp_dealloc, py_rrr_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyRRRBitVector_methods},
+    {Py_tp_getset, PyRRRBitVector_getset},
+    {Py_tp_repr, py_rrr_repr},
+
+    {Py_sq_length, py_rrr_len},
+    {Py_sq_item, py_rrr_item},
+    {Py_mp_length, py_rrr_len},
+
+    {Py_nb_bool, py_rrr_bool},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``RRRBitVector``.
+ */
+PyType_Spec PyRRRBitVector_spec = {
+    .name = "cbits.RRRBitVector",
+    .basicsize = sizeof(PyRRRBitVectorObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyRRRBitVector_slots,
+};
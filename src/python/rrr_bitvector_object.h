@@ -0,0 +1,29 @@
+/**
+ * @file rrr_bitvector_object.h
+ * @brief Definition of the ``RRRBitVector`` Python type.
+ *
+ * Declares the Python wrapper for the native read-only RRR vector:
+ * - \ref PyRRRBitVectorObject - the Python object structure
+ * - the type specification used to create the Python type
+ *
+ * @see rrr_bitvector.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_RRR_BITVECTOR_OBJECT_H
+#define CBITS_PY_RRR_BITVECTOR_OBJECT_H
+
+#include "rrr_bitvector.h"
+#include "cbits_state.h"
+
+/**
+ * @brief Python object wrapping a native ``RRRBitVector`` instance.
+ */
+typedef struct {
+    PyObject_HEAD RRRBitVector *rrr; /**< Underlying vector */
+} PyRRRBitVectorObject;
+
+extern PyType_Spec PyRRRBitVector_spec;
+
+#endif /* CBITS_PY_RRR_BITVECTOR_OBJECT_H */
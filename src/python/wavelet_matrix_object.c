@@ -0,0 +1,529 @@
+/**
+ * @file wavelet_matrix_object.c
+ * @brief Implementation of the ``WaveletMatrix`` Python type.
+ *
+ * Exposes an immutable wavelet matrix over a sequence of non-negative
+ * integers with ``access``, ``rank``, ``select``, ``quantile`` and
+ * ``range_freq`` queries. Construction runs without the GIL.
+ *
+ * @see wavelet_matrix_object.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#include "wavelet_matrix_object.h"
+#include "bitvector_parse.h"
+
+/**
+ * @brief ``__new__`` for ``WaveletMatrix``.
+ *
+ * @param type The Python type object.
+ * @param args Unused positional arguments.
+ * @param kwds Unused keyword arguments.
+ * @retval new_object New object on success.
+ * @retval NULL on allocation failure (exception set).
+ */
+static PyObject *
+py_wm_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+          PyObject *Py_UNUSED(kwds))
+{
+    PyWaveletMatrixObject *self =
+        (PyWaveletMatrixObject *) type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->wm = NULL;
+    return (PyObject *) self;
+}
+
+/**
+ * @brief ``__init__`` for ``WaveletMatrix(values, threads=0)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param args Positional arguments.
+ * @param kwds Keyword arguments.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_wm_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *iterable;
+    unsigned int threads = 0;
+    static char *kwlist[] = {"values", "threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|I", kwlist, &iterable,
+                                     &threads)) {
+        return -1;
+    }
+    PyObject *seq =
+        PySequence_Fast(iterable, "values must be an iterable of integers");
+    if (!seq) {
+        return -1;
+    }
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    uint64_t *values = PyMem_Malloc((n ? (size_t) n : 1) * sizeof(uint64_t));
+    if (!values) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        unsigned long long v = PyLong_AsUnsignedLongLong(items[i]);
+        if (v == (unsigned long long) -1 && PyErr_Occurred()) {
+            PyMem_Free(values);
+            Py_DECREF(seq);
+            return -1;
+        }
+        values[i] = (uint64_t) v;
+    }
+    Py_DECREF(seq);
+
+    WaveletMatrix *wm;
+    Py_BEGIN_ALLOW_THREADS
+    wm = wm_new(values, (size_t) n, threads);
+    Py_END_ALLOW_THREADS
+    PyMem_Free(values);
+    if (!wm) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate WaveletMatrix");
+        return -1;
+    }
+    PyWaveletMatrixObject *obj = (PyWaveletMatrixObject *) self;
+    wm_free(obj->wm);
+    obj->wm = wm;
+    return 0;
+}
+
+/**
+ * @brief GC traverse callback; only the type object is referenced.
+ *
+ * @param self Object being traversed.
+ * @param visit GC visit function.
+ * @param arg Extra argument passed through by the GC.
+ * @retval 0 Always.
+ */
+static int
+py_wm_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/**
+ * @brief Deallocate a ``PyWaveletMatrixObject``.
+ *
+ * @param object Object to free.
+ */
+static void
+py_wm_dealloc(PyObject *object)
+{
+    PyTypeObject *type = Py_TYPE(object);
+    PyObject_GC_UnTrack(object);
+    PyWaveletMatrixObject *self = (PyWaveletMatrixObject *) object;
+    wm_free(self->wm);
+    self->wm = NULL;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+/** @brief Shorthand for the native matrix of a Python object. */
+#define WM(o) (((PyWaveletMatrixObject *) (o))->wm)
+
+/**
+ * @brief Parse a symbol or value bound.
+ *
+ * @param arg Python integer.
+ * @param out Receives the value (``0`` for negative integers,
+ *            ``UINT64_MAX`` for integers wider than 64 bits).
+ * @retval 0 Success.
+ * @retval 1 Value exceeds 64 bits.
+ * @retval 2 Value is negative.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_wm_parse_value(PyObject *arg, uint64_t *out)
+{
+    if (!PyLong_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "value must be an integer");
+        return -1;
+    }
+    int overflow = 0;
+    long long v = PyLong_AsLongLongAndOverflow(arg, &overflow);
+    if (v == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (overflow < 0 || (!overflow && v < 0)) {
+        *out = 0;
+        return 2;
+    }
+    if (!overflow) {
+        *out = (uint64_t) v;
+        return 0;
+    }
+    unsigned long long u = PyLong_AsUnsignedLongLong(arg);
+    if (u == (unsigned long long) -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        *out = UINT64_MAX;
+        return 1;
+    }
+    *out = (uint64_t) u;
+    return 0;
+}
+
+/**
+ * @brief Parse a ``start, stop`` pair with slice semantics.
+ *
+ * Negative values count from the end and both ends are clamped to the
+ * sequence, exactly like ``seq[start:stop]``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param start_obj Start position.
+ * @param stop_obj Stop position.
+ * @param start Receives the clamped start.
+ * @param stop Receives the clamped stop.
+ * @retval 0 Success.
+ * @retval -1 Failure (exception set).
+ */
+static int
+py_wm_parse_range(PyObject *self, PyObject *start_obj, PyObject *stop_obj,
+                  size_t *start, size_t *stop)
+{
+    Py_ssize_t s = PyNumber_AsSsize_t(start_obj, PyExc_IndexError);
+    if (s == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    Py_ssize_t e = PyNumber_AsSsize_t(stop_obj, PyExc_IndexError);
+    if (e == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    PySlice_AdjustIndices((Py_ssize_t) WM(self)->n, &s, &e, 1);
+    *start = (size_t) s;
+    *stop = (size_t) (e > s ? e : s);
+    return 0;
+}
+
+/**
+ * @brief Implement ``len(WaveletMatrix)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @return Sequence length.
+ */
+static Py_ssize_t
+py_wm_len(PyObject *self)
+{
+    return (Py_ssize_t) WM(self)->n;
+}
+
+/**
+ * @brief Implement ``WaveletMatrix[index]``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param i Index (already adjusted for negative values).
+ * @retval int Stored value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_wm_item(PyObject *self, Py_ssize_t i)
+{
+    if (i < 0 || (size_t) i >= WM(self)->n) {
+        PyErr_SetString(PyExc_IndexError, "WaveletMatrix index out of range");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(wm_access(WM(self), (size_t) i));
+}
+
+/**
+ * @brief Python binding for ``WaveletMatrix.access(index)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param arg Index.
+ * @retval int Stored value.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_wm_access(PyObject *self, PyObject *arg)
+{
+    size_t index;
+    if (cbits_parse_index(arg, WM(self)->n, &index) < 0) {
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(wm_access(WM(self), index));
+}
+
+/**
+ * @brief Python binding for ``WaveletMatrix.rank(symbol, index)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param args Positional arguments (symbol, prefix length).
+ * @retval int Occurrences of ``symbol`` in ``[0, index)``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_wm_rank(PyObject *self, PyObject *args)
+{
+    PyObject *symbol_obj;
+    Py_ssize_t index;
+    if (!PyArg_ParseTuple(args, "On", &symbol_obj, &index)) {
+        return NULL;
+    }
+    if (index < 0 || (size_t) index > WM(self)->n) {
+        PyErr_SetString(PyExc_IndexError, "rank index out of range");
+        return NULL;
+    }
+    uint64_t symbol;
+    int rc = py_wm_parse_value(symbol_obj, &symbol);
+    if (rc < 0) {
+        return NULL;
+    }
+    if (rc > 0) {
+        return PyLong_FromLong(0);
+    }
+    return PyLong_FromSize_t(wm_rank(WM(self), symbol, (size_t) index));
+}
+
+/**
+ * @brief Python binding for ``WaveletMatrix.select(symbol, k)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param args Positional arguments (symbol, zero-based occurrence).
+ * @retval int Position of the k-th occurrence of ``symbol``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_wm_select(PyObject *self, PyObject *args)
+{
+    PyObject *symbol_obj;
+    Py_ssize_t k;
+    if (!PyArg_ParseTuple(args, "On", &symbol_obj, &k)) {
+        return NULL;
+    }
+    uint64_t symbol;
+    int rc = py_wm_parse_value(symbol_obj, &symbol);
+    if (rc < 0) {
+        return NULL;
+    }
+    size_t pos = rc > 0 || k < 0 ? SIZE_MAX
+                                 : wm_select(WM(self), symbol, (size_t) k);
+    if (pos == SIZE_MAX) {
+        PyErr_SetString(PyExc_IndexError, "select index out of range");
+        return NULL;
+    }
+    return PyLong_FromSize_t(pos);
+}
+
+/**
+ * @brief Python binding for ``WaveletMatrix.quantile(start, stop, k)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param args Positional arguments (start, stop, k).
+ * @retval int k-th smallest value in ``[start, stop)``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_wm_quantile(PyObject *self, PyObject *args)
+{
+    PyObject *start_obj, *stop_obj;
+    Py_ssize_t k;
+    if (!PyArg_ParseTuple(args, "OOn", &start_obj, &stop_obj, &k)) {
+        return NULL;
+    }
+    size_t start, stop;
+    if (py_wm_parse_range(self, start_obj, stop_obj, &start, &stop) < 0) {
+        return NULL;
+    }
+    if (k < 0 || (size_t) k >= stop - start) {
+        PyErr_SetString(PyExc_IndexError, "quantile index out of range");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(
+        wm_quantile(WM(self), start, stop, (size_t) k));
+}
+
+/**
+ * @brief Python binding for ``WaveletMatrix.range_freq(start, stop, lo,
+ * hi)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param args Positional arguments (start, stop, lo, hi).
+ * @retval int Number of values in ``[lo, hi)`` within ``[start, stop)``.
+ * @retval NULL on failure (exception set).
+ */
+static PyObject *
+py_wm_range_freq(PyObject *self, PyObject *args)
+{
+    PyObject *start_obj, *stop_obj, *lo_obj, *hi_obj;
+    if (!PyArg_ParseTuple(args, "OOOO", &start_obj, &stop_obj, &lo_obj,
+                          &hi_obj)) {
+        return NULL;
+    }
+    size_t start, stop;
+    if (py_wm_parse_range(self, start_obj, stop_obj, &start, &stop) < 0) {
+        return NULL;
+    }
+    uint64_t lo, hi;
+    int rc_lo = py_wm_parse_value(lo_obj, &lo);
+    if (rc_lo < 0) {
+        return NULL;
+    }
+    int rc_hi = py_wm_parse_value(hi_obj, &hi);
+    if (rc_hi < 0) {
+        return NULL;
+    }
+    if (rc_lo == 1 || rc_hi == 2) {
+        return PyLong_FromLong(0);
+    }
+    if (rc_hi == 1) {
+        /* Every 64-bit value lies below hi. */
+        size_t below = wm_range_freq(WM(self), start, stop, 0, lo);
+        return PyLong_FromSize_t(stop - start - below);
+    }
+    size_t count = wm_range_freq(WM(self), start, stop, lo, hi);
+    return PyLong_FromSize_t(count);
+}
+
+/**
+ * @brief Implement ``WaveletMatrix.__sizeof__``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param ignored Unused.
+ * @return Object header plus all native memory in bytes.
+ */
+static PyObject *
+py_wm_sizeof(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    size_t total =
+        (size_t) Py_TYPE(self)->tp_basicsize + wm_memory_usage(WM(self));
+    return PyLong_FromSize_t(total);
+}
+
+/**
+ * @brief Implement ``repr(WaveletMatrix)``.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @return New Python string.
+ */
+static PyObject *
+py_wm_repr(PyObject *self)
+{
+    return PyUnicode_FromFormat(
+        "<cbits.WaveletMatrix object at %p len=%zu levels=%u>", self,
+        WM(self)->n, WM(self)->n_levels);
+}
+
+/**
+ * @brief Getter for the read-only ``levels`` property.
+ *
+ * @param self A ``PyWaveletMatrixObject`` instance.
+ * @param closure Unused.
+ * @return Number of bit levels (bits per symbol).
+ */
+static PyObject *
+py_wm_get_levels(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLong(WM(self)->n_levels);
+}
+
+#undef WM
+
+/** @brief Docstring for ``WaveletMatrix.rank``. */
+PyDoc_STRVAR(py_wm_rank__doc__,
+             "rank(symbol: int, index: int) -> int\n"
+             "\n"
+             "Count the occurrences of symbol in the first index positions, "
+             "[0, index). Raises IndexError unless 0 <= index <= len.");
+/** @brief Docstring for ``WaveletMatrix.select``. */
+PyDoc_STRVAR(py_wm_select__doc__,
+             "select(symbol: int, k: int) -> int\n"
+             "\n"
+             "Return the position of the k-th occurrence of symbol "
+             "(zero-based). Raises IndexError if symbol occurs at most k "
+             "times.");
+/** @brief Docstring for ``WaveletMatrix.quantile``. */
+PyDoc_STRVAR(py_wm_quantile__doc__,
+             "quantile(start: int, stop: int, k: int) -> int\n"
+             "\n"
+             "Return the k-th smallest value (zero-based) among positions "
+             "[start, stop). start and stop follow slice semantics.");
+/** @brief Docstring for ``WaveletMatrix.range_freq``. */
+PyDoc_STRVAR(py_wm_range_freq__doc__,
+             "range_freq(start: int, stop: int, lo: int, hi: int) -> int\n"
+             "\n"
+             "Count the positions in [start, stop) whose value lies in "
+             "[lo, hi). start and stop follow slice semantics.");
+
+/**
+ * @brief Method table for the WaveletMatrix type.
+ */
+static PyMethodDef PyWaveletMatrix_methods[] = {
+    {"access", (PyCFunction) py_wm_access, METH_O,
+     PyDoc_STR("access(index: int) -> int\n\nReturn the value at index.")},
+    {"rank", (PyCFunction) py_wm_rank, METH_VARARGS, py_wm_rank__doc__},
+    {"select", (PyCFunction) py_wm_select, METH_VARARGS, py_wm_select__doc__},
+    {"quantile", (PyCFunction) py_wm_quantile, METH_VARARGS,
+     py_wm_quantile__doc__},
+    {"range_freq", (PyCFunction) py_wm_range_freq, METH_VARARGS,
+     py_wm_range_freq__doc__},
+    {"__sizeof__", (PyCFunction) py_wm_sizeof, METH_NOARGS,
+     PyDoc_STR("__sizeof__() -> int\n\nSize in memory, in bytes.")},
+    {NULL, NULL, 0, NULL},
+};
+
+/**
+ * @brief Property table for the WaveletMatrix type.
+ */
+static PyGetSetDef PyWaveletMatrix_getset[] = {
+    {"levels", py_wm_get_levels, NULL,
+     PyDoc_STR("Number of bit levels (bits per symbol).")},
+    {NULL},
+};
+
+/** @brief Docstring for the ``WaveletMatrix`` type. */
+PyDoc_STRVAR(
+    PyWaveletMatrix__doc__,
+    "WaveletMatrix(values: Iterable[int], threads: int = 0)\n"
+    "\n"
+    "An immutable wavelet matrix over a sequence of non-negative 64-bit "
+    "integers.\n\n"
+    "Stores one BitVector per bit of the largest value and answers access, "
+    "rank, select, quantile and range-frequency queries with one rank "
+    "query per level.\n\n"
+    "Parameters\n"
+    "----------\n"
+    "values : Iterable[int]\n"
+    "   The sequence.\n"
+    "threads : int, default 0\n"
+    "   Threads used to build the levels; 0 uses one per processor.\n");
+
+/**
+ * @brief Slot table for the ``WaveletMatrix`` type.
+ */
+static PyType_Slot PyWaveletMatrix_slots[] = {
+    {Py_tp_doc, (void *) PyWaveletMatrix__doc__},
+
+    {Py_tp_alloc, PyType_GenericAlloc},
+    {Py_tp_new, py_wm_new},
+    {Py_tp_init, py_wm_init},
+    {Py_tp_traverse, py_wm_traverse},
+    {Py_tp_dealloc, py_wm_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_methods, PyWaveletMatrix_methods},
+    {Py_tp_getset, PyWaveletMatrix_getset},
+    {Py_tp_repr, py_wm_repr},
+
+    {Py_sq_length, py_wm_len},
+    {Py_sq_item, py_wm_item},
+    {Py_mp_length, py_wm_len},
+
+    {0, NULL},
+};
+
+/**
+ * @brief Type specification for ``WaveletMatrix``.
+ */
+PyType_Spec PyWaveletMatrix_spec = {
+    .name = "cbits.WaveletMatrix",
+    .basicsize = sizeof(PyWaveletMatrixObject),
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+             Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_HAVE_GC,
+    .slots = PyWaveletMatrix_slots,
+};
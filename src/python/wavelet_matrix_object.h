@@ -0,0 +1,29 @@
+/**
+ * @file wavelet_matrix_object.h
+ * @brief Definition of the ``WaveletMatrix`` Python type.
+ *
+ * Declares the Python wrapper for the native wavelet matrix:
+ * - \ref PyWaveletMatrixObject - the Python object structure
+ * - the type specification used to create the Python type
+ *
+ * @see wavelet_matrix.h
+ * @author lambdaphoenix
+ * @version 0.4.0
+ * @copyright Copyright (c) 2026 lambdaphoenix
+ */
+#ifndef CBITS_PY_WAVELET_MATRIX_OBJECT_H
+#define CBITS_PY_WAVELET_MATRIX_OBJECT_H
+
+#include "wavelet_matrix.h"
+#include "cbits_state.h"
+
+/**
+ * @brief Python object wrapping a native ``WaveletMatrix`` instance.
+ */
+typedef struct {
+    PyObject_HEAD WaveletMatrix *wm; /**< Underlying matrix */
+} PyWaveletMatrixObject;
+
+extern PyType_Spec PyWaveletMatrix_spec;
+
+#endif /* CBITS_PY_WAVELET_MATRIX_OBJECT_H */
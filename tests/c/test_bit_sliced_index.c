@@ -0,0 +1,220 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bit_sliced_index.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static int64_t
+wrap_add(int64_t a, int64_t b)
+{
+    return (int64_t) ((uint64_t) a + (uint64_t) b);
+}
+
+static int
+naive_match(BSIOp op, int64_t v, int64_t c)
+{
+    switch (op) {
+        case BSI_EQ:
+            return v == c;
+        case BSI_NE:
+            return v != c;
+        case BSI_LT:
+            return v < c;
+        case BSI_LE:
+            return v <= c;
+        case BSI_GT:
+            return v > c;
+        case BSI_GE:
+            return v >= c;
+    }
+    return 0;
+}
+
+static void
+check_compare(const BitSlicedIndex *bsi, const int64_t *v,
+              const BitVector *exists, size_t n, int64_t c)
+{
+    for (int op = BSI_EQ; op <= BSI_GE; ++op) {
+        BitVector *r = bsi_compare(bsi, (BSIOp) op, c);
+        assert(r && r->n_bits == n);
+        for (size_t i = 0; i < n; ++i) {
+            int expected =
+                bv_get(exists, i) && naive_match((BSIOp) op, v[i], c);
+            int got = bv_get(r, i);
+            assert(got == expected);
+            (void) expected;
+            (void) got;
+        }
+        bv_free(r);
+    }
+}
+
+static void
+check_between(const BitSlicedIndex *bsi, const int64_t *v,
+              const BitVector *exists, size_t n, int64_t lo, int64_t hi)
+{
+    BitVector *r = bsi_between(bsi, lo, hi);
+    assert(r && r->n_bits == n);
+    for (size_t i = 0; i < n; ++i) {
+        int expected = bv_get(exists, i) && v[i] >= lo && v[i] <= hi;
+        int got = bv_get(r, i);
+        assert(got == expected);
+        (void) expected;
+        (void) got;
+    }
+    bv_free(r);
+}
+
+static void
+check_top_k(const BitSlicedIndex *bsi, const int64_t *v,
+            const BitVector *found, size_t n, size_t k, bool largest)
+{
+    BitVector *r = bsi_top_k(bsi, k, found, largest);
+    assert(r);
+    assert(bv_count(r) == (k < bv_count(found) ? k : bv_count(found)));
+    /* Every picked row beats every skipped one, ties go to lower rows. */
+    for (size_t i = 0; i < n; ++i) {
+        if (!bv_get(r, i)) {
+            continue;
+        }
+        assert(bv_get(found, i));
+        for (size_t j = 0; j < n; ++j) {
+            if (!bv_get(found, j) || bv_get(r, j)) {
+                continue;
+            }
+            int better = largest ? v[i] > v[j] : v[i] < v[j];
+            assert(better || (v[i] == v[j] && i < j));
+            (void) better;
+        }
+    }
+    bv_free(r);
+}
+
+static void
+run_case(size_t n, int64_t lo, uint64_t span, unsigned null_every,
+         uint64_t seed)
+{
+    uint64_t state = seed;
+    int64_t *v = malloc((n ? n : 1) * sizeof(int64_t));
+    BitVector *exists = bv_new(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t x = next_random(&state);
+        v[i] = (int64_t) ((uint64_t) lo + (span ? x % span : x));
+        if (!null_every || i % null_every) {
+            bv_set(exists, i);
+        }
+    }
+    BitSlicedIndex *bsi = bsi_new(v, null_every ? exists : NULL, n);
+    assert(bsi && bsi->n_rows == n);
+
+    int64_t value;
+    for (size_t i = 0; i < n; ++i) {
+        bool has = bsi_get(bsi, i, &value);
+        assert(has == bv_get(exists, i));
+        assert(!has || value == v[i]);
+        (void) has;
+    }
+
+    const int64_t probes[] = {INT64_MIN, INT64_MAX, lo, wrap_add(lo, -1),
+                              wrap_add(lo, 1), n ? v[n / 2] : 0,
+                              n ? wrap_add(v[n / 3], 1) : 0};
+    for (size_t p = 0; p < sizeof(probes) / sizeof(probes[0]); ++p) {
+        check_compare(bsi, v, exists, n, probes[p]);
+        for (size_t q = 0; q < sizeof(probes) / sizeof(probes[0]); ++q) {
+            check_between(bsi, v, exists, n, probes[p], probes[q]);
+        }
+    }
+
+    /* Slice counts against the stored values of the filtered rows. */
+    BitVector *filter = bv_new(n);
+    for (size_t i = 0; i < n; i += 3) {
+        bv_set(filter, i);
+    }
+    size_t counts[BSI_MAX_SLICES];
+    size_t found = bsi_slice_counts(bsi, filter, counts);
+    size_t expected_found = 0;
+    size_t expected[BSI_MAX_SLICES] = {0};
+    for (size_t i = 0; i < n; i += 3) {
+        if (!bv_get(exists, i)) {
+            continue;
+        }
+        ++expected_found;
+        uint64_t stored = (uint64_t) v[i] - (uint64_t) bsi->base;
+        for (unsigned b = 0; b < bsi->n_slices; ++b) {
+            expected[b] += (stored >> b) & 1;
+        }
+    }
+    assert(found == expected_found);
+    for (unsigned b = 0; b < bsi->n_slices; ++b) {
+        assert(counts[b] == expected[b]);
+    }
+    (void) found;
+
+    BitVector *all = bv_copy(exists);
+    const size_t ks[] = {0, 1, 7, n / 2, n};
+    for (size_t i = 0; i < sizeof(ks) / sizeof(ks[0]); ++i) {
+        check_top_k(bsi, v, all, n, ks[i], true);
+        check_top_k(bsi, v, all, n, ks[i], false);
+    }
+    BitVector *filtered = bsi_top_k(bsi, n, filter, true);
+    size_t n_filtered = bv_count(filtered);
+    assert(n_filtered == expected_found);
+    (void) n_filtered;
+    bv_free(filtered);
+
+    assert(bsi_memory_usage(bsi) > sizeof(BitSlicedIndex));
+    bv_free(all);
+    bv_free(filter);
+    bsi_free(bsi);
+    bv_free(exists);
+    free(v);
+}
+
+/* Predicates over two row blocks, the last one partial. */
+static void
+test_blocks(void)
+{
+    const size_t n = 17000;
+    uint64_t state = 8;
+    int64_t *v = malloc(n * sizeof(int64_t));
+    BitVector *exists = bv_new(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = (int64_t) (next_random(&state) % 4096) - 7;
+        if (i % 11) {
+            bv_set(exists, i);
+        }
+    }
+    BitSlicedIndex *bsi = bsi_new(v, exists, n);
+    assert(bsi);
+    const int64_t probes[] = {-7, 0, v[n / 2], v[n - 1], 4088};
+    for (size_t p = 0; p < sizeof(probes) / sizeof(probes[0]); ++p) {
+        check_compare(bsi, v, exists, n, probes[p]);
+        check_between(bsi, v, exists, n, probes[p], probes[p] + 1000);
+    }
+    bsi_free(bsi);
+    bv_free(exists);
+    free(v);
+}
+
+int
+main(void)
+{
+    run_case(0, 0, 10, 0, 1);
+    run_case(1, 5, 1, 0, 2);
+    run_case(130, -50, 100, 0, 3);
+    run_case(200, 0, 4, 5, 4);
+    run_case(257, 1000, 1u << 20, 7, 5);
+    run_case(300, INT64_MIN, 0, 3, 6);
+    run_case(100, 42, 1, 2, 7);
+    test_blocks();
+    puts("test_bit_sliced_index: OK");
+    return 0;
+}
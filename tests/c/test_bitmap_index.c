@@ -0,0 +1,194 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bitmap_index.h"
+
+#define N_VECTORS 6
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* Vector v has density 1 / (v + 1); vector 5 is empty. */
+static BitVector *
+make_vector(size_t n_bits, unsigned v, uint64_t *state)
+{
+    BitVector *bv = bv_new(n_bits);
+    for (size_t i = 0; i < n_bits && v < 5; ++i) {
+        if (next_random(state) % (v + 1) == 0) {
+            bv_set(bv, i);
+        }
+    }
+    return bv;
+}
+
+static BMIQuery
+key(size_t v)
+{
+    BMIQuery q = {BMI_KEY, v, 0, NULL};
+    return q;
+}
+
+static BMIQuery
+node(BMIOp op, const BMIQuery *children, size_t n)
+{
+    BMIQuery q = {op, 0, n, children};
+    return q;
+}
+
+static int
+naive(const BMIQuery *q, BitVector *const *vs, size_t i)
+{
+    switch (q->op) {
+        case BMI_KEY:
+            return bv_get(vs[q->vector], i);
+        case BMI_NOT:
+            return !naive(&q->children[0], vs, i);
+        case BMI_AND:
+            for (size_t c = 0; c < q->n_children; ++c) {
+                if (!naive(&q->children[c], vs, i)) {
+                    return 0;
+                }
+            }
+            return 1;
+        case BMI_OR:
+            for (size_t c = 0; c < q->n_children; ++c) {
+                if (naive(&q->children[c], vs, i)) {
+                    return 1;
+                }
+            }
+            return 0;
+        case BMI_ANDNOT:
+            if (!naive(&q->children[0], vs, i)) {
+                return 0;
+            }
+            for (size_t c = 1; c < q->n_children; ++c) {
+                if (naive(&q->children[c], vs, i)) {
+                    return 0;
+                }
+            }
+            return 1;
+    }
+    return 0;
+}
+
+static void
+check_query(const BitmapIndex *bmi, BitVector *const *vs, const BMIQuery *q)
+{
+    BitVector *r = bmi_query(bmi, q);
+    assert(r && r->n_bits == bmi->n_bits);
+    size_t expected_count = 0;
+    for (size_t i = 0; i < bmi->n_bits; ++i) {
+        int expected = naive(q, vs, i);
+        int got = bv_get(r, i);
+        assert(got == expected);
+        expected_count += (size_t) expected;
+        (void) got;
+    }
+    size_t count = 0;
+    int rc = bmi_query_count(bmi, q, &count);
+    assert(rc == 0 && count == expected_count);
+    (void) rc;
+    bv_free(r);
+}
+
+static void
+run_case(size_t n_bits, uint64_t seed)
+{
+    uint64_t state = seed;
+    BitVector *vs[N_VECTORS];
+    BitmapIndex *bmi = bmi_new(n_bits);
+    assert(bmi);
+    for (unsigned v = 0; v < N_VECTORS; ++v) {
+        vs[v] = make_vector(n_bits, v, &state);
+        size_t index = bmi_add(bmi, vs[v]);
+        assert(index == v);
+        (void) index;
+    }
+    assert(bmi->size == N_VECTORS);
+    size_t count = bv_count(vs[1]);
+    assert(bmi->entries[1].count == count);
+    (void) count;
+
+    BMIQuery k[N_VECTORS];
+    for (size_t v = 0; v < N_VECTORS; ++v) {
+        k[v] = key(v);
+    }
+    BMIQuery not2 = node(BMI_NOT, &k[2], 1);
+    BMIQuery not_not2 = node(BMI_NOT, &not2, 1);
+    BMIQuery and01[] = {k[0], k[1]};
+    BMIQuery a01 = node(BMI_AND, and01, 2);
+    BMIQuery or_parts[] = {a01, not2, k[5]};
+    BMIQuery or_q = node(BMI_OR, or_parts, 3);
+    BMIQuery nested[] = {or_q, a01, not_not2};
+    BMIQuery and_nested = node(BMI_AND, nested, 3);
+    BMIQuery diff_parts[] = {k[0], k[3], not2, k[5]};
+    BMIQuery diff = node(BMI_ANDNOT, diff_parts, 4);
+    BMIQuery with_empty[] = {k[0], k[5], k[1]};
+    BMIQuery and_empty = node(BMI_AND, with_empty, 3);
+    BMIQuery only_not[] = {not2, node(BMI_NOT, &k[3], 1)};
+    BMIQuery nor = node(BMI_AND, only_not, 2);
+    BMIQuery or_nested[] = {or_q, k[4], diff};
+    BMIQuery or2 = node(BMI_OR, or_nested, 3);
+
+    const BMIQuery *queries[] = {&k[0], &k[5],      &not2,       &not_not2,
+                                 &a01,  &or_q,      &and_nested, &diff,
+                                 &nor,  &and_empty, &or2};
+    for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); ++i) {
+        check_query(bmi, vs, queries[i]);
+    }
+
+    /* Malformed queries. */
+    BMIQuery missing = key(N_VECTORS);
+    BMIQuery empty_and = node(BMI_AND, NULL, 0);
+    BMIQuery bad_not = node(BMI_NOT, and01, 2);
+    BitVector *bad = bmi_query(bmi, &missing);
+    assert(!bad);
+    bad = bmi_query(bmi, &empty_and);
+    assert(!bad);
+    bad = bmi_query(bmi, &bad_not);
+    assert(!bad);
+    (void) bad;
+
+    /* Replacing and removing keep the statistics in sync. */
+    int rc = bmi_set(bmi, 5, vs[0]);
+    assert(rc == 0 && bmi->entries[5].count == bmi->entries[0].count);
+    bv_free(vs[5]);
+    vs[5] = bv_copy(vs[0]);
+    check_query(bmi, vs, &and_empty);
+    bmi_remove(bmi, 2);
+    assert(bmi->size == N_VECTORS - 1);
+    bv_free(vs[2]);
+    vs[2] = vs[5];
+    check_query(bmi, vs, &nor);
+    BitVector *wrong = bv_new(n_bits + 1);
+    size_t index = bmi_add(bmi, wrong);
+    assert(index == SIZE_MAX);
+    rc = bmi_set(bmi, 0, wrong);
+    assert(rc == -1);
+    (void) index;
+    (void) rc;
+    bv_free(wrong);
+
+    assert(bmi_memory_usage(bmi) > sizeof(BitmapIndex));
+    bmi_free(bmi);
+    for (unsigned v = 0; v < N_VECTORS - 1; ++v) {
+        bv_free(vs[v]);
+    }
+}
+
+int
+main(void)
+{
+    run_case(1, 1);
+    run_case(100, 2);
+    run_case(64 * BMI_CHUNK_WORDS, 3);
+    run_case(64 * BMI_CHUNK_WORDS * 3 + 77, 4);
+    puts("test_bitmap_index: OK");
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bitmatrix.h"
+
+static BitMatrix *
+make_random(size_t rows, size_t cols, unsigned seed)
+{
+    BitMatrix *m = bm_new(rows, cols);
+    assert(m != NULL);
+    srand(seed);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            if (rand() % 3 == 0) {
+                bm_set(m, r, c);
+            }
+        }
+    }
+    return m;
+}
+
+static void
+test_layout_and_access(void)
+{
+    BitMatrix *m = bm_new(5, 70);
+    assert(m != NULL);
+    assert(m->row_words == 2);
+    assert(m->stride == BM_STRIDE_WORDS);
+    for (size_t r = 0; r < 5; ++r) {
+        assert(((uintptr_t) bm_row(m, r) % BV_ALIGN) == 0);
+    }
+    bm_set(m, 2, 69);
+    bm_set(m, 4, 0);
+    assert(bm_get(m, 2, 69) == 1);
+    assert(bm_get(m, 4, 0) == 1);
+    assert(bm_get(m, 2, 68) == 0);
+    assert(bm_get(m, 5, 0) == -1);
+    assert(bm_get(m, 0, 70) == -1);
+    bm_clear(m, 2, 69);
+    assert(bm_get(m, 2, 69) == 0);
+    bm_free(m);
+}
+
+static void
+test_row_views(void)
+{
+    BitMatrix *m = make_random(10, 300, 1);
+    BitVector *row = bm_row_view(m, 3);
+    assert(row != NULL);
+    assert(row->n_bits == 300);
+    size_t expected = 0;
+    for (size_t c = 0; c < 300; ++c) {
+        assert(bv_get(row, c) == bm_get(m, 3, c));
+        expected += (size_t) bm_get(m, 3, c);
+    }
+    assert(bv_rank(row, 299) == expected);
+
+    /* Writes through the view land in the matrix and vice versa. */
+    bv_set_range(row, 0, 300);
+    assert(bm_get(m, 3, 150) == 1);
+    bm_clear(m, 3, 10);
+    assert(bv_rank(row, 299) == 299);
+    assert(bm_row_view(m, 10) == NULL);
+
+    BitVector *src = bv_new(300);
+    bv_set(src, 7);
+    assert(bm_set_row(m, 0, src) == 0);
+    assert(bm_get(m, 0, 7) == 1 && bm_get(m, 0, 8) == 0);
+    BitVector *bad = bv_new(299);
+    assert(bm_set_row(m, 0, bad) == -1);
+    bv_free(bad);
+    bv_free(src);
+
+    BitMatrix *copy = bm_copy(m);
+    assert(bm_equal(m, copy));
+    assert(bm_row_op(copy, 1, 3, BM_OR) == 0);
+    for (size_t c = 0; c < 300; ++c) {
+        assert(bm_get(copy, 1, c) == (bm_get(m, 1, c) | bm_get(m, 3, c)));
+    }
+    assert(bm_row_op(copy, 1, 1, BM_XOR) == 0);
+    for (size_t c = 0; c < 300; ++c) {
+        assert(bm_get(copy, 1, c) == 0);
+    }
+    assert(!bm_equal(m, copy));
+    assert(bm_row_op(copy, 1, 10, BM_AND) == -1);
+    assert(bm_memory_usage(m) > 10 * m->stride * sizeof(uint64_t));
+    bm_free(copy);
+    bm_free(m);
+}
+
+static void
+test_transpose64(void)
+{
+    uint64_t tile[64], orig[64];
+    srand(2);
+    for (int i = 0; i < 64; ++i) {
+        orig[i] = ((uint64_t) rand() << 40) ^ ((uint64_t) rand() << 20) ^
+                  (uint64_t) rand();
+        tile[i] = orig[i];
+    }
+    bm_transpose64(tile);
+    for (int i = 0; i < 64; ++i) {
+        for (int j = 0; j < 64; ++j) {
+            assert(((tile[j] >> i) & 1) == ((orig[i] >> j) & 1));
+        }
+    }
+}
+
+static void
+check_shape(size_t rows, size_t cols, unsigned seed)
+{
+    BitMatrix *m = make_random(rows, cols, seed);
+
+    BitMatrix *t = bm_transpose(m);
+    assert(t != NULL);
+    assert(t->n_rows == cols && t->n_cols == rows);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            assert(bm_get(t, c, r) == bm_get(m, r, c));
+        }
+    }
+    BitMatrix *tt = bm_transpose(t);
+    assert(bm_equal(m, tt));
+    bm_free(tt);
+    bm_free(t);
+
+    size_t *row_counts = malloc((rows ? rows : 1) * sizeof(size_t));
+    size_t *col_counts = malloc((cols ? cols : 1) * sizeof(size_t));
+    bm_row_popcount(m, row_counts);
+    bm_col_popcount(m, col_counts);
+    BitVector *any = bm_reduce_rows(m, BM_OR);
+    BitVector *all = bm_reduce_rows(m, BM_AND);
+    BitVector *par = bm_reduce_rows(m, BM_XOR);
+    BitVector *row_any = bm_reduce_cols(m, BM_OR);
+    BitVector *row_par = bm_reduce_cols(m, BM_XOR);
+    for (size_t c = 0; c < cols; ++c) {
+        size_t n = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            n += (size_t) bm_get(m, r, c);
+        }
+        assert(col_counts[c] == n);
+        assert(bv_get(any, c) == (n > 0));
+        assert(bv_get(all, c) == (n == rows));
+        assert(bv_get(par, c) == (int) (n & 1));
+
+        BitVector *col = bm_column(m, c);
+        for (size_t r = 0; r < rows; ++r) {
+            assert(bv_get(col, r) == bm_get(m, r, c));
+        }
+        bv_free(col);
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        size_t n = 0;
+        for (size_t c = 0; c < cols; ++c) {
+            n += (size_t) bm_get(m, r, c);
+        }
+        assert(row_counts[r] == n);
+        assert(bv_get(row_any, r) == (n > 0));
+        assert(bv_get(row_par, r) == (int) (n & 1));
+    }
+    assert(bm_column(m, cols) == NULL);
+    bv_free(any);
+    bv_free(all);
+    bv_free(par);
+    bv_free(row_any);
+    bv_free(row_par);
+    free(row_counts);
+    free(col_counts);
+    bm_free(m);
+}
+
+static void
+test_shapes(void)
+{
+    check_shape(1, 1, 3);
+    check_shape(64, 64, 4);
+    check_shape(65, 130, 5);
+    check_shape(200, 33, 6);
+    check_shape(7, 513, 7);
+    check_shape(0, 10, 8);
+    check_shape(10, 0, 9);
+
+    BitMatrix *full = bm_new(3, 100);
+    for (size_t r = 0; r < 3; ++r) {
+        bv_set_range(bm_row_view(full, r), 0, 100);
+    }
+    BitVector *all = bm_reduce_cols(full, BM_AND);
+    assert(bv_rank(all, 2) == 3);
+    bv_free(all);
+    bm_free(full);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_layout_and_access();
+    test_row_views();
+    test_transpose64();
+    test_shapes();
+    printf("test_bitmatrix: OK\n");
+    return 0;
+}
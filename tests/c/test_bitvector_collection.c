@@ -0,0 +1,263 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitvector_collection.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static BitVector *
+random_bv(size_t n_bits, uint64_t *state)
+{
+    BitVector *bv = bv_new(n_bits);
+    assert(bv != NULL);
+    for (size_t i = 0; i < n_bits; ++i) {
+        if (next_random(state) & 1) {
+            bv_set(bv, i);
+        }
+    }
+    return bv;
+}
+
+static void
+push(BitVectorCollection *c, const BitVector *bv)
+{
+    if (bvc_append(c, bv) != 0) {
+        abort();
+    }
+}
+
+static size_t
+naive_distance(const BitVector *a, const uint64_t *b)
+{
+    size_t d = 0;
+    for (size_t i = 0; i < a->n_bits; ++i) {
+        d += (size_t) bv_get(a, i) != ((b[i >> 6] >> (i & 63)) & 1);
+    }
+    return d;
+}
+
+static void
+check_kernel(cbits_hamming_fn fn, size_t n_words, uint64_t *state)
+{
+    const size_t stride = n_words + 3, n_rows = 9;
+    uint64_t *query = malloc(n_words * sizeof(uint64_t) + 1);
+    uint64_t *rows = malloc(stride * n_rows * sizeof(uint64_t));
+    uint32_t out[9], ref[9];
+    for (size_t w = 0; w < n_words; ++w) {
+        query[w] = next_random(state);
+    }
+    for (size_t w = 0; w < stride * n_rows; ++w) {
+        rows[w] = next_random(state);
+    }
+    memcpy(rows, query, n_words * sizeof(uint64_t));
+    cbits_hamming_batch_fallback(query, rows, stride, n_words, n_rows, ref);
+    fn(query, rows, stride, n_words, n_rows, out);
+    assert(ref[0] == 0);
+    assert(memcmp(out, ref, sizeof(ref)) == 0);
+    free(rows);
+    free(query);
+}
+
+static void
+test_kernels(void)
+{
+    static const size_t widths[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 63, 64, 65,
+                                    100, 128, 130, 200};
+    uint64_t state = 1;
+    for (size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i) {
+        check_kernel(cbits_hamming_batch_ptr, widths[i], &state);
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+        if (__builtin_cpu_supports("avx2")) {
+            check_kernel(cbits_hamming_batch_avx2, widths[i], &state);
+        }
+        if (__builtin_cpu_supports("avx512vpopcntdq")) {
+            check_kernel(cbits_hamming_batch_avx512, widths[i], &state);
+        }
+#endif
+    }
+}
+
+static void
+test_append_and_get(void)
+{
+    uint64_t state = 2;
+    BitVectorCollection *c = bvc_new(70);
+    assert(c != NULL);
+    assert(c->n_words == 2 && c->stride == 2);
+    BitVector *bvs[40];
+    for (size_t i = 0; i < 40; ++i) {
+        bvs[i] = random_bv(70, &state);
+        push(c, bvs[i]);
+    }
+    assert(c->size == 40 && c->capacity >= 40);
+    assert(((uintptr_t) c->data % BV_ALIGN) == 0);
+    for (size_t i = 0; i < 40; ++i) {
+        BitVector *copy = bvc_get(c, i);
+        assert(bv_equal(copy, bvs[i]));
+        bv_free(copy);
+        bv_free(bvs[i]);
+    }
+    BitVector *wrong = bv_new(71);
+    int rc = bvc_append(c, wrong);
+    assert(rc == -1 && c->size == 40);
+    assert(bvc_memory_usage(c) >= 40 * 2 * sizeof(uint64_t));
+    bv_free(wrong);
+    bvc_free(c);
+
+    BitVectorCollection *empty = bvc_new(0);
+    BitVector *zero = bv_new(0);
+    push(empty, zero);
+    BVCMatch m = {1, 1};
+    size_t found = bvc_knn(empty, zero, 3, &m, 1);
+    assert(found == 1 && m.index == 0 && m.distance == 0);
+    (void) rc;
+    (void) found;
+    bv_free(zero);
+    bvc_free(empty);
+}
+
+static void
+check_search(size_t n_bits, size_t n, unsigned threads)
+{
+    uint64_t state = 3 + n_bits;
+    BitVectorCollection *c = bvc_new(n_bits);
+    BitVector *query = random_bv(n_bits, &state);
+    for (size_t i = 0; i < n; ++i) {
+        BitVector *bv = random_bv(n_bits, &state);
+        /* Plant near duplicates and exact ties. */
+        if (i % 997 == 5) {
+            bv_free(bv);
+            bv = bv_copy(query);
+            bv_flip(bv, i % n_bits);
+        }
+        push(c, bv);
+        bv_free(bv);
+    }
+    /* Brute-force distances, the oracle of every search below. */
+    uint32_t *dist = malloc(n * sizeof(uint32_t));
+    uint32_t *got = malloc(n * sizeof(uint32_t));
+    for (size_t i = 0; i < n; ++i) {
+        dist[i] = (uint32_t) naive_distance(query, bvc_row(c, i));
+    }
+    bvc_distances(c, query, got, threads);
+    assert(memcmp(got, dist, n * sizeof(uint32_t)) == 0);
+    free(got);
+
+    const size_t k = 25;
+    BVCMatch knn[25];
+    size_t found = bvc_knn(c, query, k, knn, threads);
+    assert(found == k);
+    for (size_t j = 0; j < k; ++j) {
+        assert(knn[j].distance == dist[knn[j].index]);
+        if (j > 0) {
+            assert(knn[j - 1].distance < knn[j].distance ||
+                   (knn[j - 1].distance == knn[j].distance &&
+                    knn[j - 1].index < knn[j].index));
+        }
+    }
+    /* Nothing outside the result beats the last neighbour. */
+    const BVCMatch last = knn[k - 1];
+    size_t better = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (dist[i] < last.distance ||
+            (dist[i] == last.distance && i <= last.index)) {
+            better++;
+        }
+    }
+    assert(better == k);
+    (void) found;
+    (void) better;
+
+    const size_t radius = n_bits / 2 - 4;
+    size_t n_hits, expected = 0;
+    BVCMatch *hits = bvc_within_radius(c, query, radius, &n_hits, threads);
+    assert(hits != NULL);
+    for (size_t i = 0; i < n; ++i) {
+        if (dist[i] <= radius) {
+            assert(expected < n_hits && hits[expected].index == i);
+            assert(hits[expected].distance == dist[i]);
+            expected++;
+        }
+    }
+    assert(n_hits == expected);
+    (void) expected;
+
+    free(hits);
+    free(dist);
+    bv_free(query);
+    bvc_free(c);
+}
+
+static void
+test_search(void)
+{
+    check_search(256, 1000, 1);
+    check_search(1000, 3000, 4);
+    check_search(4096, 600, 0);
+    check_search(256, 2 * BVC_PARALLEL_MIN_ROWS + 17, 1);
+    check_search(256, 2 * BVC_PARALLEL_MIN_ROWS + 17, 3);
+}
+
+static void
+test_pairwise(void)
+{
+    uint64_t state = 4;
+    int rc;
+    BitVectorCollection *a = bvc_new(300), *b = bvc_new(300);
+    for (size_t i = 0; i < 150; ++i) {
+        BitVector *bv = random_bv(300, &state);
+        push(a, bv);
+        bv_free(bv);
+    }
+    for (size_t i = 0; i < 290; ++i) {
+        BitVector *bv = random_bv(300, &state);
+        push(b, bv);
+        bv_free(bv);
+    }
+    uint32_t *out = malloc(150 * 290 * sizeof(uint32_t));
+    rc = bvc_pairwise(a, b, out, 2);
+    assert(rc == 0);
+    for (size_t i = 0; i < 150; ++i) {
+        BitVector *row = bvc_get(a, i);
+        for (size_t j = 0; j < 290; ++j) {
+            assert(out[i * 290 + j] == naive_distance(row, bvc_row(b, j)));
+        }
+        bv_free(row);
+    }
+    rc = bvc_pairwise(a, a, out, 1);
+    assert(rc == 0);
+    for (size_t i = 0; i < 150; ++i) {
+        assert(out[i * 150 + i] == 0);
+        for (size_t j = 0; j < i; ++j) {
+            assert(out[i * 150 + j] == out[j * 150 + i]);
+        }
+    }
+    BitVectorCollection *other = bvc_new(301);
+    rc = bvc_pairwise(a, other, out, 1);
+    assert(rc == -1);
+    (void) rc;
+    bvc_free(other);
+    free(out);
+    bvc_free(b);
+    bvc_free(a);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_kernels();
+    test_append_and_get();
+    test_search();
+    test_pairwise();
+    printf("test_bitvector_collection: OK\n");
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bloom_filter.h"
+
+static BloomFilter *
+make_filter(BloomLayout layout, size_t capacity, double error_rate,
+            KeyHash hash)
+{
+    size_t n_bits;
+    unsigned n_hashes;
+    if (bloom_params(layout, capacity, error_rate, &n_bits, &n_hashes) < 0) {
+        abort();
+    }
+    BloomFilter *f = bloom_new(layout, n_bits, n_hashes, hash, 7);
+    if (!f) {
+        abort();
+    }
+    return f;
+}
+
+static void
+test_hashes(void)
+{
+    BloomFilter *f = bloom_new(BLOOM_CLASSIC, 64, 1, KEY_HASH_XXH64, 0);
+    const char *text = "Nobody inspects the spammish repetition";
+    uint64_t h_empty = bloom_hash(f, "", 0);
+    uint64_t h_a = bloom_hash(f, "a", 1);
+    uint64_t h_abc = bloom_hash(f, "abc", 3);
+    uint64_t h_long = bloom_hash(f, text, strlen(text));
+    /* Reference XXH64 values. */
+    assert(h_empty == 0xEF46DB3751D8E999ULL);
+    assert(h_a == 0xD24EC4F1A98C6E5BULL);
+    assert(h_abc == 0x44BC2CF5AD770999ULL);
+    assert(h_long == 0xFBCEA83C8A378BF1ULL);
+
+    const uint8_t le[8] = {0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11};
+    assert(bloom_hash(f, le, 8) ==
+           bloom_hash_u64(f, 0x1122334455667788ULL));
+    f->hash = KEY_HASH_FNV1A;
+    assert(bloom_hash(f, le, 8) ==
+           bloom_hash_u64(f, 0x1122334455667788ULL));
+    (void) h_empty;
+    (void) h_a;
+    (void) h_abc;
+    (void) h_long;
+    bloom_free(f);
+}
+
+static void
+check_layout(BloomLayout layout, KeyHash hash)
+{
+    const size_t n = 20000;
+    BloomFilter *f = make_filter(layout, n, 0.01, hash);
+    if (layout == BLOOM_BLOCKED) {
+        assert(f->bits->n_bits % BLOOM_BLOCK_BITS == 0);
+        assert(((uintptr_t) f->bits->data % BV_ALIGN) == 0);
+    }
+    uint64_t *keys = malloc(2 * n * sizeof(uint64_t));
+    uint64_t *hashes = malloc(2 * n * sizeof(uint64_t));
+    for (size_t i = 0; i < 2 * n; ++i) {
+        keys[i] = i * 0x9E3779B97F4A7C15ULL;
+    }
+    bloom_hash_u64_many(f, keys, 2 * n, hashes);
+    bloom_add_hashes(f, hashes, n);
+
+    /* No false negatives, and the batched lookup matches single lookups. */
+    uint64_t *found = calloc((2 * n + 63) / 64, sizeof(uint64_t));
+    bloom_contains_hashes(f, hashes, 2 * n, found);
+    size_t false_positives = 0;
+    for (size_t i = 0; i < 2 * n; ++i) {
+        bool hit = (found[i >> 6] >> (i & 63)) & 1;
+        assert(hit == bloom_contains_hash(f, hashes[i]));
+        if (i < n) {
+            assert(hit);
+        }
+        else {
+            false_positives += hit;
+        }
+    }
+    assert(false_positives < n / 50);
+    double estimate = bloom_estimate_count(f);
+    assert(estimate > 0.9 * n && estimate < 1.1 * n);
+    (void) estimate;
+    (void) false_positives;
+
+    /* Round trip through the serialized form. */
+    size_t n_bytes;
+    uint8_t *data = bloom_serialize(f, &n_bytes);
+    assert(data != NULL);
+    assert(n_bytes == BLOOM_HEADER_BYTES + f->bits->n_words * 8);
+    BloomFilter *g = bloom_deserialize(data, n_bytes);
+    assert(g != NULL && bloom_compatible(f, g));
+    assert(bv_equal(f->bits, g->bits));
+    BloomFilter *bad = bloom_deserialize(data, n_bytes - 1);
+    assert(bad == NULL);
+    data[0] = 'X';
+    bad = bloom_deserialize(data, n_bytes);
+    assert(bad == NULL);
+    (void) bad;
+    free(data);
+
+    /* Union and intersection of disjoint key sets. */
+    BloomFilter *h = make_filter(layout, n, 0.01, hash);
+    bloom_add_hashes(h, hashes + n, n / 2);
+    BloomFilter *u = bloom_copy(g);
+    int rc = bloom_union(u, h);
+    assert(rc == 0);
+    assert(bloom_contains_hash(u, hashes[0]));
+    assert(bloom_contains_hash(u, hashes[n]));
+    rc = bloom_intersect(g, h);
+    assert(rc == 0);
+    assert(bv_count(g->bits) <= bv_count(h->bits));
+    BloomFilter *other = make_filter(layout, 2 * n, 0.01, hash);
+    rc = bloom_union(u, other);
+    assert(rc == -1);
+    (void) rc;
+
+    bloom_free(other);
+    bloom_free(u);
+    bloom_free(h);
+    bloom_free(g);
+    free(found);
+    free(hashes);
+    free(keys);
+    bloom_free(f);
+}
+
+static void
+test_params(void)
+{
+    size_t n_bits;
+    unsigned n_hashes;
+    int rc = bloom_params(BLOOM_CLASSIC, 1000, 0.01, &n_bits, &n_hashes);
+    assert(rc == 0 && n_bits == 9586 && n_hashes == 7);
+    rc = bloom_params(BLOOM_BLOCKED, 1000, 0.01, &n_bits, &n_hashes);
+    assert(rc == 0 && n_bits == 9728);
+    rc = bloom_params(BLOOM_CLASSIC, 10, 1.0, &n_bits, &n_hashes);
+    assert(rc == -1);
+    rc = bloom_params(BLOOM_CLASSIC, 10, 0.0, &n_bits, &n_hashes);
+    assert(rc == -1);
+    (void) rc;
+    BloomFilter *f = bloom_new(BLOOM_CLASSIC, 0, 3, KEY_HASH_XXH64, 0);
+    assert(f == NULL);
+    f = bloom_new(BLOOM_CLASSIC, 10, BLOOM_MAX_HASHES + 1, KEY_HASH_XXH64,
+                  0);
+    assert(f == NULL);
+    f = bloom_new(BLOOM_BLOCKED, 1, 3, KEY_HASH_XXH64, 0);
+    assert(f != NULL && f->bits->n_bits == BLOOM_BLOCK_BITS);
+    bloom_free(f);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_hashes();
+    test_params();
+    check_layout(BLOOM_CLASSIC, KEY_HASH_XXH64);
+    check_layout(BLOOM_CLASSIC, KEY_HASH_FNV1A);
+    check_layout(BLOOM_BLOCKED, KEY_HASH_XXH64);
+    check_layout(BLOOM_BLOCKED, KEY_HASH_FNV1A);
+    printf("test_bloom_filter: OK\n");
+    return 0;
+}
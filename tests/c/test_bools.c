@@ -0,0 +1,98 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitvector.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void
+check_kernels(cbits_pack_bools_fn pack, cbits_unpack_bools_fn unpack)
+{
+    const size_t sizes[] = {1, 7, 63, 64, 65, 127, 128, 200, 1000, 4099};
+    uint64_t state = 11;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        const size_t n = sizes[s];
+        const size_t n_words = (n + 63) / 64;
+        uint8_t *in = malloc(n);
+        uint8_t *out = malloc(n + 1);
+        uint64_t *words = malloc((n_words + 1) * sizeof(uint64_t));
+        for (size_t i = 0; i < n; ++i) {
+            /* Any non-zero byte counts as true, including 0x80 and 0x01. */
+            const uint64_t r = next_random(&state);
+            in[i] = (r & 3) ? 0 : (uint8_t) (r >> 8 | 1);
+        }
+        words[n_words] = 0xDEADBEEF;
+        pack(words, in, n);
+        for (size_t i = 0; i < n_words * 64; ++i) {
+            const int bit = (int) ((words[i >> 6] >> (i & 63)) & 1);
+            assert(bit == (i < n && in[i] != 0));
+            (void) bit;
+        }
+        assert(words[n_words] == 0xDEADBEEF);
+
+        out[n] = 0xAA;
+        unpack(out, words, n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(out[i] == (in[i] != 0));
+        }
+        assert(out[n] == 0xAA);
+        free(in);
+        free(out);
+        free(words);
+    }
+}
+
+static void
+test_kernels(void)
+{
+    check_kernels(cbits_pack_bools_fallback, cbits_unpack_bools_fallback);
+    check_kernels(cbits_pack_bools_ptr, cbits_unpack_bools_ptr);
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2")) {
+        check_kernels(cbits_pack_bools_avx2, cbits_unpack_bools_avx2);
+    }
+    if (__builtin_cpu_supports("avx512bw")) {
+        check_kernels(cbits_pack_bools_avx512, cbits_unpack_bools_avx512);
+    }
+#endif
+}
+
+static void
+test_round_trip(void)
+{
+    const uint8_t in[5] = {0, 1, 255, 0, 2};
+    BitVector *bv = bv_from_bools(in, 5);
+    assert(bv->n_bits == 5);
+    assert(!bv_get(bv, 0) && bv_get(bv, 1) && bv_get(bv, 2));
+    assert(!bv_get(bv, 3) && bv_get(bv, 4));
+    assert(bv->data[0] == 0x16);
+
+    uint8_t out[5];
+    bv_to_bools(bv, out);
+    assert(out[0] == 0 && out[1] == 1 && out[2] == 1 && out[3] == 0 &&
+           out[4] == 1);
+    (void) out;
+    bv_free(bv);
+
+    BitVector *empty = bv_from_bools(NULL, 0);
+    assert(empty && empty->n_bits == 0);
+    bv_to_bools(empty, NULL);
+    bv_free(empty);
+}
+
+int
+main(void)
+{
+    test_kernels();
+    test_round_trip();
+    puts("test_bools: OK");
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bp_tree.h"
+
+/* Random balanced sequence: each step opens with probability p_open. */
+static BitVector *
+make_balanced(size_t pairs, int p_open, unsigned seed)
+{
+    BitVector *bv = bv_new(2 * pairs);
+    size_t opened = 0, depth = 0, pos = 0;
+    srand(seed);
+    while (pos < 2 * pairs) {
+        int open = opened < pairs &&
+                   (depth == 0 || rand() % 100 < p_open);
+        if (open) {
+            bv_set(bv, pos);
+            opened++;
+            depth++;
+        }
+        else {
+            depth--;
+        }
+        pos++;
+    }
+    return bv;
+}
+
+static void
+check_against_stack(const BitVector *bv)
+{
+    const size_t n = bv->n_bits;
+    size_t *match = malloc((n ? n : 1) * sizeof(size_t));
+    size_t *parent = malloc((n ? n : 1) * sizeof(size_t));
+    size_t *stack = malloc((n ? n : 1) * sizeof(size_t));
+    size_t top = 0;
+    for (size_t i = 0; i < n; ++i) {
+        match[i] = SIZE_MAX;
+        if (bv_get(bv, i)) {
+            parent[i] = top ? stack[top - 1] : SIZE_MAX;
+            stack[top++] = i;
+        }
+        else if (top) {
+            size_t j = stack[--top];
+            match[i] = j;
+            match[j] = i;
+        }
+    }
+
+    BPTree *bp = bp_new(bv);
+    assert(bp != NULL);
+    int64_t excess = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int open = bv_get(bv, i);
+        excess += open ? 1 : -1;
+        assert(bp_excess(bp, i) == excess);
+        if (open) {
+            assert(bp_find_close(bp, i) == match[i]);
+            assert(bp_find_open(bp, i) == SIZE_MAX);
+            assert(bp_enclose(bp, i) == parent[i]);
+            assert(bp_parent(bp, i) == parent[i]);
+            assert(bp_first_child(bp, i) ==
+                   (i + 1 < n && bv_get(bv, i + 1) ? i + 1 : SIZE_MAX));
+            if (match[i] != SIZE_MAX) {
+                size_t c = match[i];
+                assert(bp_next_sibling(bp, i) ==
+                       (c + 1 < n && bv_get(bv, c + 1) ? c + 1 : SIZE_MAX));
+                assert(bp_subtree_size(bp, i) == (c - i + 1) / 2);
+            }
+            else {
+                assert(bp_subtree_size(bp, i) == 0);
+            }
+        }
+        else {
+            assert(bp_find_open(bp, i) == match[i]);
+            assert(bp_find_close(bp, i) == SIZE_MAX);
+            assert(bp_enclose(bp, i) == SIZE_MAX);
+        }
+    }
+    assert(bp_find_close(bp, n) == SIZE_MAX);
+    assert(bp_find_open(bp, n) == SIZE_MAX);
+    bp_free(bp);
+    free(match);
+    free(parent);
+    free(stack);
+}
+
+static void
+test_random_trees(void)
+{
+    const size_t sizes[] = {1, 3, 255, 256, 257, 5000, 40000};
+    const int probs[] = {30, 50, 70, 95};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (size_t p = 0; p < sizeof(probs) / sizeof(probs[0]); ++p) {
+            BitVector *bv =
+                make_balanced(sizes[s], probs[p], (unsigned) (s * 4 + p));
+            check_against_stack(bv);
+            bv_free(bv);
+        }
+    }
+}
+
+static void
+test_deep_chain(void)
+{
+    /* One path of 3000 nodes: matches lie far away, several blocks off. */
+    const size_t depth = 3000;
+    BitVector *bv = bv_new(2 * depth);
+    bv_set_range(bv, 0, depth);
+    check_against_stack(bv);
+    bv_free(bv);
+}
+
+static void
+test_unbalanced_and_empty(void)
+{
+    BitVector *bv = bv_new(2000);
+    srand(11);
+    for (size_t i = 0; i < 2000; ++i) {
+        if (rand() % 2) {
+            bv_set(bv, i);
+        }
+    }
+    check_against_stack(bv);
+    bv_free(bv);
+
+    BitVector *empty = bv_new(0);
+    BPTree *bp = bp_new(empty);
+    assert(bp != NULL);
+    assert(bp_find_close(bp, 0) == SIZE_MAX);
+    assert(bp_excess(bp, 0) == 0);
+    bp_free(bp);
+    bv_free(empty);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_random_trees();
+    test_deep_chain();
+    test_unbalanced_and_empty();
+    printf("test_bp_tree: OK\n");
+    return 0;
+}
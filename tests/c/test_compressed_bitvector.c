@@ -0,0 +1,189 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+#include "compressed_bitvector.h"
+
+static void
+test_get_set_clear(void)
+{
+    CompressedBitVector *cbv = cbv_new(300000);
+    assert(cbv != NULL);
+    assert(cbv_count(cbv) == 0);
+
+    assert(cbv_set(cbv, 5) == 0);
+    assert(cbv_set(cbv, 70000) == 0);
+    assert(cbv_set(cbv, 299999) == 0);
+    assert(cbv_set(cbv, 300000) == -1);
+    assert(cbv->n_containers == 3);
+
+    assert(cbv_get(cbv, 5) == 1);
+    assert(cbv_get(cbv, 6) == 0);
+    assert(cbv_get(cbv, 70000) == 1);
+    assert(cbv_get(cbv, 300000) == -1);
+    assert(cbv_count(cbv) == 3);
+
+    assert(cbv_clear(cbv, 70000) == 0);
+    assert(cbv_get(cbv, 70000) == 0);
+    assert(cbv->n_containers == 2);
+
+    assert(cbv_flip(cbv, 5) == 0);
+    assert(cbv_get(cbv, 5) == 0);
+    assert(cbv_count(cbv) == 1);
+
+    cbv_free(cbv);
+}
+
+static void
+test_array_bitmap_transition(void)
+{
+    CompressedBitVector *cbv = cbv_new(1u << 16);
+    for (size_t i = 0; i < CBV_ARRAY_MAX; ++i) {
+        cbv_set(cbv, i * 2);
+    }
+    assert(cbv->containers[0].type == CBV_CONTAINER_ARRAY);
+    cbv_set(cbv, 1);
+    assert(cbv->containers[0].type == CBV_CONTAINER_BITMAP);
+    assert(cbv_count(cbv) == CBV_ARRAY_MAX + 1);
+
+    cbv_clear(cbv, 0);
+    assert(cbv->containers[0].type == CBV_CONTAINER_ARRAY);
+    assert(cbv_count(cbv) == CBV_ARRAY_MAX);
+    assert(cbv_get(cbv, 1) == 1);
+    assert(cbv_get(cbv, 2) == 1);
+    cbv_free(cbv);
+}
+
+static void
+test_rank_select_matches_bitvector(void)
+{
+    const size_t n = 400000;
+    BitVector *bv = bv_new(n);
+    for (size_t i = 0; i < n; i += 97) {
+        bv_set(bv, i);
+    }
+    bv_set_range(bv, 131072, 70000);
+
+    CompressedBitVector *cbv = cbv_from_bitvector(bv);
+    assert(cbv != NULL);
+    assert(cbv_count(cbv) == bv_rank(bv, n - 1));
+
+    for (size_t i = 0; i < n; i += 1013) {
+        assert(cbv_rank(cbv, i) == bv_rank(bv, i));
+        assert(cbv_get(cbv, i) == bv_get(bv, i));
+    }
+    size_t total = cbv_count(cbv);
+    for (size_t k = 0; k < total; k += 577) {
+        assert(cbv_select(cbv, k) < n);
+        assert(bv_get(bv, cbv_select(cbv, k)) == 1);
+        assert(bv_rank(bv, cbv_select(cbv, k)) == k + 1);
+    }
+    assert(cbv_select(cbv, total) == SIZE_MAX);
+
+    BitVector *back = cbv_to_bitvector(cbv);
+    assert(bv_equal(bv, back));
+
+    bv_free(back);
+    cbv_free(cbv);
+    bv_free(bv);
+}
+
+static void
+test_run_containers(void)
+{
+    BitVector *bv = bv_new(1u << 17);
+    bv_set_range(bv, 100, 60000);
+    bv_set_range(bv, 65536, 65536);
+
+    CompressedBitVector *cbv = cbv_from_bitvector(bv);
+    assert(cbv->n_containers == 2);
+    assert(cbv->containers[0].type == CBV_CONTAINER_RUN);
+    assert(cbv->containers[1].type == CBV_CONTAINER_RUN);
+    assert(cbv_count(cbv) == 60000 + 65536);
+    assert(cbv_rank(cbv, 99) == 0);
+    assert(cbv_rank(cbv, 100) == 1);
+    assert(cbv_select(cbv, 60000) == 65536);
+
+    cbv_set(cbv, 99);
+    assert(cbv->containers[0].type == CBV_CONTAINER_BITMAP);
+    assert(cbv_rank(cbv, 100) == 2);
+    assert(cbv_optimize(cbv) == 0);
+    assert(cbv->containers[0].type == CBV_CONTAINER_RUN);
+    assert(cbv->containers[0].size == 1);
+
+    cbv_free(cbv);
+    bv_free(bv);
+}
+
+static void
+test_bitwise_ops(void)
+{
+    const size_t n = 200000;
+    BitVector *a = bv_new(n);
+    BitVector *b = bv_new(n);
+    for (size_t i = 0; i < n; i += 3) {
+        bv_set(a, i);
+    }
+    for (size_t i = 0; i < n; i += 5) {
+        bv_set(b, i);
+    }
+    bv_set_range(b, 70000, 20000);
+
+    CompressedBitVector *ca = cbv_from_bitvector(a);
+    CompressedBitVector *cb = cbv_from_bitvector(b);
+    CompressedBitVector *r_and = cbv_and(ca, cb);
+    CompressedBitVector *r_or = cbv_or(ca, cb);
+    CompressedBitVector *r_xor = cbv_xor(ca, cb);
+    CompressedBitVector *r_andnot = cbv_andnot(ca, cb);
+
+    for (size_t i = 0; i < n; i += 7) {
+        assert(cbv_get(r_and, i) == (bv_get(a, i) & bv_get(b, i)));
+        assert(cbv_get(r_or, i) == (bv_get(a, i) | bv_get(b, i)));
+        assert(cbv_get(r_xor, i) == (bv_get(a, i) ^ bv_get(b, i)));
+        assert(cbv_get(r_andnot, i) == (bv_get(a, i) & !bv_get(b, i)));
+    }
+    CompressedBitVector *again = cbv_or(r_xor, r_and);
+    assert(cbv_equal(again, r_or));
+
+    CompressedBitVector *short_cbv = cbv_new(10);
+    assert(cbv_and(ca, short_cbv) == NULL);
+
+    cbv_free(short_cbv);
+    cbv_free(again);
+    cbv_free(r_andnot);
+    cbv_free(r_xor);
+    cbv_free(r_or);
+    cbv_free(r_and);
+    cbv_free(cb);
+    cbv_free(ca);
+    bv_free(b);
+    bv_free(a);
+}
+
+static void
+test_copy_equal(void)
+{
+    CompressedBitVector *a = cbv_new(1000);
+    cbv_set(a, 1);
+    cbv_set(a, 999);
+    CompressedBitVector *b = cbv_copy(a);
+    assert(cbv_equal(a, b));
+    cbv_clear(b, 1);
+    assert(!cbv_equal(a, b));
+    assert(cbv_memory_usage(a) > sizeof(CompressedBitVector));
+    cbv_free(a);
+    cbv_free(b);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_get_set_clear();
+    test_array_bitmap_transition();
+    test_rank_select_matches_bitvector();
+    test_run_containers();
+    test_bitwise_ops();
+    test_copy_equal();
+    printf("test_compressed_bitvector: OK\n");
+    return 0;
+}
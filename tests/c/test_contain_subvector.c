@@ -24,11 +24,37 @@ test_contains(void)
     bv_free(c);
 }
 
+static void
+test_word_aligned_offsets(void)
+{
+    /* Ones in bits 0-31 and 96-127: no window of 64 ones, but OR-ing the
+     * two words at offset 0 would make one. */
+    BitVector *a = bv_new(128);
+    BitVector *word = bv_new(64);
+    BitVector *longer = bv_new(100);
+
+    bv_set_range(a, 0, 32);
+    bv_set_range(a, 96, 32);
+    bv_set_range(word, 0, 64);
+    bv_set_range(longer, 0, 100);
+
+    assert(!bv_contains_subvector(a, word));
+    assert(!bv_contains_subvector(a, longer));
+
+    bv_set_range(a, 32, 32);
+    assert(bv_contains_subvector(a, word));
+
+    bv_free(a);
+    bv_free(word);
+    bv_free(longer);
+}
+
 int
 main(void)
 {
     setvbuf(stdout, NULL, _IONBF, 0);
     test_contains();
+    test_word_aligned_offsets();
     printf("test_contains_subvector: OK\n");
     return 0;
 }
@@ -0,0 +1,88 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "bitvector.h"
+
+static void
+test_little_order(void)
+{
+    const uint8_t in[3] = {0x01, 0x80, 0xFF};
+    BitVector *bv = bv_from_bytes(in, 20, BV_BITORDER_LITTLE);
+    assert(bv->n_bits == 20);
+    assert(bv_get(bv, 0) && !bv_get(bv, 1));
+    assert(bv_get(bv, 15) && !bv_get(bv, 14));
+    assert(bv_get(bv, 19));
+    /* Bits 20..23 of the input are dropped. */
+    assert(bv_count(bv) == 6);
+
+    uint8_t out[3];
+    bv_to_bytes(bv, out, BV_BITORDER_LITTLE);
+    assert(out[0] == 0x01 && out[1] == 0x80 && out[2] == 0x0F);
+    (void) out;
+    bv_free(bv);
+}
+
+static void
+test_big_order(void)
+{
+    const uint8_t in[2] = {0x80, 0x01};
+    BitVector *bv = bv_from_bytes(in, 16, BV_BITORDER_BIG);
+    assert(bv_get(bv, 0) && bv_get(bv, 15));
+    assert(bv_count(bv) == 2);
+
+    uint8_t out[2];
+    bv_to_bytes(bv, out, BV_BITORDER_LITTLE);
+    assert(out[0] == 0x01 && out[1] == 0x80);
+    bv_to_bytes(bv, out, BV_BITORDER_BIG);
+    assert(out[0] == 0x80 && out[1] == 0x01);
+    (void) out;
+    bv_free(bv);
+}
+
+static void
+test_round_trip(void)
+{
+    const size_t lengths[] = {0, 1, 7, 8, 63, 64, 65, 200, 1001};
+    uint8_t in[130], out[130];
+    for (size_t i = 0; i < sizeof in; ++i) {
+        in[i] = (uint8_t) (i * 37 + 11);
+    }
+    for (size_t k = 0; k < sizeof lengths / sizeof *lengths; ++k) {
+        const size_t n = lengths[k];
+        const size_t n_bytes = (n + 7) / 8;
+        for (int o = 0; o < 2; ++o) {
+            const BVBitOrder order = o ? BV_BITORDER_BIG : BV_BITORDER_LITTLE;
+            BitVector *bv = bv_from_bytes(in, n, order);
+            for (size_t i = 0; i < n; ++i) {
+                assert(bv_get(bv, i) ==
+                       ((in[i >> 3] >> (o ? 7 - (i & 7) : (i & 7))) & 1));
+            }
+            memset(out, 0xAA, sizeof out);
+            bv_to_bytes(bv, out, order);
+            for (size_t i = 0; i + 1 < n_bytes; ++i) {
+                assert(out[i] == in[i]);
+            }
+            if (n_bytes) {
+                const unsigned tail = (unsigned) (n & 7);
+                uint8_t keep = tail ? (uint8_t) ((1u << tail) - 1) : 0xFF;
+                if (o && tail) {
+                    keep = (uint8_t) (keep << (8 - tail));
+                }
+                assert(out[n_bytes - 1] == (in[n_bytes - 1] & keep));
+                (void) keep;
+            }
+            assert(out[n_bytes] == 0xAA);
+            bv_free(bv);
+        }
+    }
+}
+
+int
+main(void)
+{
+    test_little_order();
+    test_big_order();
+    test_round_trip();
+    puts("test_convert: OK");
+    return 0;
+}
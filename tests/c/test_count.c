@@ -0,0 +1,143 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bitvector.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t
+naive_words(const uint64_t *ptr, size_t n_words)
+{
+    uint64_t sum = 0;
+    for (size_t w = 0; w < n_words; ++w) {
+        for (unsigned b = 0; b < 64; ++b) {
+            sum += (ptr[w] >> b) & 1;
+        }
+    }
+    return sum;
+}
+
+static size_t
+naive_range(const BitVector *bv, size_t start, size_t len)
+{
+    size_t sum = 0;
+    for (size_t i = start; i < bv->n_bits && i - start < len; ++i) {
+        sum += bv_get(bv, i);
+    }
+    return sum;
+}
+
+static void
+check_kernel(cbits_popcount_words_fn fn, const uint64_t *words,
+             size_t n_words)
+{
+    /* Odd offsets exercise the unaligned loads. */
+    for (size_t off = 0; off < 3; ++off) {
+        uint64_t got = fn(words + off, n_words);
+        assert(got == naive_words(words + off, n_words));
+        (void) got;
+    }
+}
+
+static void
+test_kernels(void)
+{
+    static const size_t sizes[] = {0,  1,  3,   7,   8,   15,  16,  17, 63,
+                                   64, 65, 127, 128, 129, 200, 1000};
+    uint64_t state = 1;
+    uint64_t *words = malloc(1100 * sizeof(uint64_t));
+    for (size_t w = 0; w < 1100; ++w) {
+        words[w] = next_random(&state);
+    }
+    /* All-ones blocks overflow every carry-save level. */
+    for (size_t w = 100; w < 400; ++w) {
+        words[w] = ~0ULL;
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        check_kernel(cbits_popcount_words_fallback, words, sizes[i]);
+        check_kernel(cbits_popcount_words_ptr, words, sizes[i]);
+        check_kernel(cbits_popcount_words_ptr, words + 97, sizes[i]);
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+        if (__builtin_cpu_supports("avx2")) {
+            check_kernel(cbits_popcount_words_avx2, words, sizes[i]);
+            check_kernel(cbits_popcount_words_avx2, words + 97, sizes[i]);
+        }
+        if (__builtin_cpu_supports("avx512vpopcntdq")) {
+            check_kernel(cbits_popcount_words_avx512, words, sizes[i]);
+            check_kernel(cbits_popcount_words_avx512, words + 97, sizes[i]);
+        }
+#endif
+    }
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2")) {
+        uint64_t got = cbits_popcount_block_avx2(words + 1);
+        assert(got == naive_words(words + 1, 8));
+        (void) got;
+    }
+#endif
+    free(words);
+}
+
+static void
+test_count(void)
+{
+    uint64_t state = 2;
+    BitVector *bv = bv_new(5000);
+    for (size_t i = 0; i < 5000; ++i) {
+        if (next_random(&state) % 3 == 0) {
+            bv_set(bv, i);
+        }
+    }
+    size_t expected = 0;
+    for (size_t i = 0; i < 5000; ++i) {
+        expected += bv_get(bv, i);
+    }
+    size_t total = bv_count(bv);
+    assert(total == expected);
+    assert(bv->rank_dirty);
+
+    static const size_t starts[] = {0, 1, 63, 64, 65, 130, 4000, 4999};
+    static const size_t lens[] = {0, 1, 2, 63, 64, 65, 128, 700, 4096, 9000};
+    for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); ++s) {
+        for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+            assert(bv_count_range(bv, starts[s], lens[l]) ==
+                   naive_range(bv, starts[s], lens[l]));
+        }
+    }
+    /* Random ranges across word boundaries, some running past the end. */
+    for (int round = 0; round < 2000; ++round) {
+        const size_t start = (size_t) (next_random(&state) % 5100);
+        const size_t len = (size_t) (next_random(&state) % 700);
+        assert(bv_count_range(bv, start, len) ==
+               naive_range(bv, start, len));
+    }
+    size_t outside = bv_count_range(bv, 5000, 10);
+    assert(outside == 0);
+    assert(bv->rank_dirty);
+    (void) total;
+    (void) outside;
+    bv_free(bv);
+
+    BitVector *empty = bv_new(0);
+    size_t zero = bv_count(empty) + bv_count_range(empty, 0, 5);
+    assert(zero == 0);
+    (void) zero;
+    bv_free(empty);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_kernels();
+    test_count();
+    printf("test_count: OK\n");
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitvector.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void
+test_names(void)
+{
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        const char *name = cbits_dispatch_op_name((cbits_dispatch_op) o);
+        assert(name && cbits_dispatch_op_from_name(name) ==
+                           (cbits_dispatch_op) o);
+        (void) name;
+    }
+    for (int k = 0; k <= CBITS_KERNEL_AUTO; ++k) {
+        const char *name = cbits_kernel_name((cbits_kernel) k);
+        assert(name && cbits_kernel_from_name(name) == k);
+        (void) name;
+    }
+    assert(cbits_dispatch_op_name(CBITS_OP_COUNT) == NULL);
+    assert(cbits_kernel_name((cbits_kernel) (CBITS_KERNEL_AUTO + 1)) ==
+           NULL);
+    assert(cbits_dispatch_op_from_name("popcount") == CBITS_OP_COUNT);
+    assert(cbits_kernel_from_name("sse") == -1);
+    assert(cbits_kernel_supported(CBITS_KERNEL_FALLBACK));
+    assert(cbits_kernel_supported(CBITS_KERNEL_AUTO));
+    if (cbits_kernel_supported(CBITS_KERNEL_AVX512)) {
+        assert(cbits_cpu_features() & CBITS_CPU_AVX512VPOPCNTDQ);
+    }
+    if (cbits_kernel_supported(CBITS_KERNEL_AVX2)) {
+        assert(cbits_cpu_features() & CBITS_CPU_AVX2);
+    }
+}
+
+static void
+test_support(void)
+{
+    for (int k = 0; k <= CBITS_KERNEL_AUTO; ++k) {
+        int all = 1;
+        for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+            const int ok = cbits_op_kernel_supported((cbits_dispatch_op) o,
+                                                     (cbits_kernel) k);
+            all &= ok;
+            assert((cbits_set_kernel((cbits_dispatch_op) o,
+                                     (cbits_kernel) k) == 0) == ok);
+        }
+        assert(cbits_kernel_supported((cbits_kernel) k) == all);
+        (void) all;
+    }
+    /* The AVX-512 bitwise kernel needs nothing beyond AVX-512F. */
+    if (cbits_cpu_features() & CBITS_CPU_AVX512F) {
+        assert(cbits_op_kernel_supported(CBITS_OP_BITWISE_WORDS,
+                                         CBITS_KERNEL_AVX512));
+    }
+    assert(!cbits_op_kernel_supported(CBITS_OP_COUNT + 1,
+                                      CBITS_KERNEL_FALLBACK));
+
+    /* "auto" picks the best supported kernel of each operation. */
+    cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+    for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+        const cbits_kernel k = cbits_active_kernel((cbits_dispatch_op) o);
+        assert(cbits_op_kernel_supported((cbits_dispatch_op) o, k));
+        for (int j = k + 1; j < CBITS_KERNEL_COUNT; ++j) {
+            assert(!cbits_op_kernel_supported((cbits_dispatch_op) o,
+                                              (cbits_kernel) j));
+        }
+        (void) k;
+    }
+}
+
+static void
+test_switch(void)
+{
+    uint64_t state = 3;
+    BitVector *bv = bv_new(70000);
+    for (size_t w = 0; w < bv->n_words; ++w) {
+        bv->data[w] = next_random(&state);
+    }
+    bv->data[bv->n_words - 1] &= (1ULL << (70000 % 64)) - 1;
+    const cbits_kernel best = cbits_active_kernel(CBITS_OP_POPCOUNT_WORDS);
+
+    for (int k = 0; k < CBITS_KERNEL_COUNT; ++k) {
+        const int rc = cbits_set_kernel(CBITS_OP_COUNT, (cbits_kernel) k);
+        if (!cbits_kernel_supported((cbits_kernel) k)) {
+            assert(rc == -1);
+            assert(cbits_active_kernel(CBITS_OP_POPCOUNT_WORDS) !=
+                   (cbits_kernel) k);
+            continue;
+        }
+        assert(rc == 0);
+        for (int o = 0; o < CBITS_OP_COUNT; ++o) {
+            assert(cbits_active_kernel((cbits_dispatch_op) o) ==
+                   (cbits_kernel) k);
+        }
+        bv->rank_dirty = true;
+        bv_build_rank(bv);
+        assert(bv_count(bv) ==
+               cbits_popcount_words_fallback(bv->data, bv->n_words));
+        assert(bv_rank(bv, 69999) == bv_count(bv));
+        (void) rc;
+    }
+
+    /* One operation at a time leaves the others alone. */
+    int rc = cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+    assert(rc == 0);
+    assert(cbits_active_kernel(CBITS_OP_POPCOUNT_WORDS) == best);
+    rc = cbits_set_kernel(CBITS_OP_HAMMING_BATCH, CBITS_KERNEL_FALLBACK);
+    assert(rc == 0);
+    assert(cbits_active_kernel(CBITS_OP_HAMMING_BATCH) ==
+           CBITS_KERNEL_FALLBACK);
+    assert(cbits_active_kernel(CBITS_OP_POPCOUNT_BLOCK) == best);
+    rc = cbits_set_kernel(CBITS_OP_COUNT + 1, CBITS_KERNEL_FALLBACK);
+    assert(rc == -1);
+    (void) rc;
+    (void) best;
+    cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+    bv_free(bv);
+}
+
+static uint64_t
+naive_bitwise(uint64_t x, uint64_t y, int op)
+{
+    switch (op) {
+        case CBITS_BITWISE_AND:
+            return x & y;
+        case CBITS_BITWISE_OR:
+            return x | y;
+        case CBITS_BITWISE_XOR:
+            return x ^ y;
+        default:
+            return ~x;
+    }
+}
+
+static void
+test_bitwise(void)
+{
+    static const size_t sizes[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 100};
+    uint64_t state = 4;
+    uint64_t a[100], b[100], dst[101], in_place[100];
+    for (size_t w = 0; w < 100; ++w) {
+        a[w] = next_random(&state);
+        b[w] = next_random(&state);
+    }
+    for (int k = 0; k < CBITS_KERNEL_COUNT; ++k) {
+        if (cbits_set_kernel(CBITS_OP_BITWISE_WORDS, (cbits_kernel) k) < 0) {
+            continue;
+        }
+        for (int op = CBITS_BITWISE_AND; op <= CBITS_BITWISE_NOT; ++op) {
+            for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+                const size_t n = sizes[i];
+                dst[n] = 42;
+                const uint64_t *rhs = op == CBITS_BITWISE_NOT ? NULL : b;
+                cbits_bitwise_words(dst, a, rhs, n, (cbits_bitwise_op) op);
+                memcpy(in_place, a, sizeof(a));
+                cbits_bitwise_words(in_place, in_place, b, n,
+                                    (cbits_bitwise_op) op);
+                for (size_t w = 0; w < n; ++w) {
+                    const uint64_t expected = naive_bitwise(a[w], b[w], op);
+                    assert(dst[w] == expected);
+                    assert(in_place[w] == expected);
+                    (void) expected;
+                }
+                /* Nothing past the last word is written. */
+                assert(dst[n] == 42);
+                assert(n == 100 || in_place[n] == a[n]);
+            }
+        }
+    }
+    cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+}
+
+static void
+test_force(void)
+{
+    const cbits_kernel best = cbits_active_kernel(CBITS_OP_POPCOUNT_BLOCK);
+    int rc = cbits_force_kernel("fallback");
+    assert(rc == 0);
+    assert(cbits_active_kernel(CBITS_OP_POPCOUNT_BLOCK) ==
+           CBITS_KERNEL_FALLBACK);
+    rc = cbits_force_kernel("popcount_block=auto,hamming_batch=fallback");
+    assert(rc == 0);
+    assert(cbits_active_kernel(CBITS_OP_POPCOUNT_BLOCK) == best);
+    assert(cbits_active_kernel(CBITS_OP_POPCOUNT_WORDS) ==
+           CBITS_KERNEL_FALLBACK);
+
+    /* A bad entry rejects the whole specification. */
+    static const char *const bad[] = {
+        "",
+        "avx3",
+        "popcount_block=auto,bogus=fallback",
+        "popcount_block=auto,hamming_batch",
+        "popcount_block=auto,",
+        "=fallback",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+        rc = cbits_force_kernel(bad[i]);
+        assert(rc == -1);
+        assert(cbits_active_kernel(CBITS_OP_POPCOUNT_BLOCK) == best);
+    }
+    if (!cbits_op_kernel_supported(CBITS_OP_HAMMING_BATCH,
+                                   CBITS_KERNEL_AVX512)) {
+        rc = cbits_force_kernel("popcount_block=fallback,"
+                                "hamming_batch=avx512");
+        assert(rc == -1);
+        assert(cbits_active_kernel(CBITS_OP_POPCOUNT_BLOCK) == best);
+    }
+    (void) rc;
+    (void) best;
+    if (!getenv("CBITS_FORCE_KERNEL")) {
+        assert(cbits_force_kernel_env_status() == 0);
+    }
+    cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+}
+
+int
+main(void)
+{
+    /* Start from the automatic choice even if CBITS_FORCE_KERNEL is set. */
+    cbits_set_kernel(CBITS_OP_COUNT, CBITS_KERNEL_AUTO);
+    test_names();
+    test_support();
+    test_switch();
+    test_bitwise();
+    test_force();
+    puts("test_dispatch: OK");
+    return 0;
+}
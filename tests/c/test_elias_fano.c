@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "elias_fano.h"
+
+static uint64_t *
+make_sorted(size_t n, uint64_t max_gap, unsigned seed)
+{
+    uint64_t *v = malloc((n ? n : 1) * sizeof(uint64_t));
+    uint64_t x = 0;
+    srand(seed);
+    for (size_t i = 0; i < n; ++i) {
+        x += (uint64_t) rand() % (max_gap + 1);
+        v[i] = x;
+    }
+    return v;
+}
+
+static void
+test_access_and_iteration(void)
+{
+    const size_t sizes[] = {1, 2, 255, 256, 257, 5000};
+    const uint64_t gaps[] = {0, 1, 3, 1000, 1u << 20};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (size_t g = 0; g < sizeof(gaps) / sizeof(gaps[0]); ++g) {
+            size_t n = sizes[s];
+            uint64_t *v = make_sorted(n, gaps[g], (unsigned) (s * 7 + g));
+            EliasFano *ef = ef_from_sorted(v, n);
+            assert(ef != NULL);
+            assert(ef->n == n);
+            for (size_t i = 0; i < n; ++i) {
+                assert(ef_access(ef, i) == v[i]);
+            }
+            assert(ef_access(ef, n) == UINT64_MAX);
+
+            EFIterator it;
+            ef_iter_init(ef, &it, 0);
+            uint64_t x;
+            size_t i = 0;
+            while (ef_iter_next(&it, &x)) {
+                assert(x == v[i]);
+                ++i;
+            }
+            assert(i == n);
+
+            ef_iter_init(ef, &it, n / 2);
+            assert(ef_iter_next(&it, &x));
+            assert(x == v[n / 2]);
+
+            ef_free(ef);
+            free(v);
+        }
+    }
+}
+
+static void
+test_next_geq(void)
+{
+    const size_t n = 3000;
+    uint64_t *v = make_sorted(n, 50, 42);
+    EliasFano *ef = ef_from_sorted(v, n);
+
+    size_t j = 0;
+    for (uint64_t x = 0; x <= v[n - 1] + 1; ++x) {
+        while (j < n && v[j] < x) {
+            ++j;
+        }
+        uint64_t found = 0;
+        assert(ef_next_geq(ef, x, &found) == j);
+        if (j < n) {
+            assert(found == v[j]);
+        }
+    }
+    assert(ef_next_geq(ef, UINT64_MAX, NULL) == n);
+
+    ef_free(ef);
+    free(v);
+}
+
+static void
+test_edge_cases(void)
+{
+    EliasFano *empty = ef_from_sorted(NULL, 0);
+    assert(empty != NULL);
+    assert(ef_next_geq(empty, 0, NULL) == 0);
+    EFIterator it;
+    uint64_t x;
+    ef_iter_init(empty, &it, 0);
+    assert(!ef_iter_next(&it, &x));
+    ef_free(empty);
+
+    uint64_t big[] = {0, 1, UINT64_MAX - 1, UINT64_MAX};
+    EliasFano *ef = ef_from_sorted(big, 4);
+    for (size_t i = 0; i < 4; ++i) {
+        assert(ef_access(ef, i) == big[i]);
+    }
+    assert(ef_next_geq(ef, 2, &x) == 2 && x == UINT64_MAX - 1);
+    ef_free(ef);
+
+    big[3] = 5; /* no longer sorted */
+    assert(ef_from_sorted(big, 4) == NULL);
+}
+
+static void
+test_space(void)
+{
+    const size_t n = 100000;
+    uint64_t *v = make_sorted(n, 2000, 7);
+    EliasFano *ef = ef_from_sorted(v, n);
+    /* About 2 + log2(1000) bits per value, far below a dense bitmap. */
+    assert(ef_memory_usage(ef) * 8 < n * 16);
+    assert(ef_memory_usage(ef) * 8 < v[n - 1] / 32);
+    ef_free(ef);
+    free(v);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_access_and_iteration();
+    test_next_geq();
+    test_edge_cases();
+    test_space();
+    printf("test_elias_fano: OK\n");
+    return 0;
+}
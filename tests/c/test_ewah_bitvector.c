@@ -0,0 +1,155 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+#include "ewah_bitvector.h"
+
+static BitVector *
+make_sample(size_t n, size_t stride, size_t run_start, size_t run_len)
+{
+    BitVector *bv = bv_new(n);
+    for (size_t i = 0; i < n; i += stride) {
+        bv_set(bv, i);
+    }
+    bv_set_range(bv, run_start, run_len);
+    return bv;
+}
+
+static void
+test_roundtrip(void)
+{
+    const size_t sizes[] = {0, 1, 63, 64, 65, 1000, 100000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        size_t n = sizes[s];
+        BitVector *bv = bv_new(n);
+        if (n > 10) {
+            bv_set_range(bv, n / 4, n / 2);
+            bv_set(bv, 3);
+        }
+        EWAHBitVector *ewah = bv_compress_ewah(bv);
+        assert(ewah != NULL);
+        assert(ewah->n_bits == n);
+        assert(ewah_count(ewah) == (n ? bv_rank(bv, n - 1) : 0));
+        for (size_t i = 0; i < n; i += 7) {
+            assert(ewah_get(ewah, i) == bv_get(bv, i));
+        }
+        assert(ewah_get(ewah, n) == -1);
+
+        BitVector *back = ewah_decompress(ewah);
+        assert(bv_equal(bv, back));
+
+        bv_free(back);
+        ewah_free(ewah);
+        bv_free(bv);
+    }
+}
+
+static void
+test_compression(void)
+{
+    const size_t n = 1u << 20;
+    BitVector *bv = bv_new(n);
+    bv_set_range(bv, 4096, 200000);
+    bv_set(bv, 700001);
+
+    EWAHBitVector *ewah = bv_compress_ewah(bv);
+    /* zeros, ones, a partial word, zeros, one literal, zeros */
+    assert(ewah->size < 8);
+    assert(ewah_memory_usage(ewah) < n / 64);
+    assert(ewah_count(ewah) == 200001);
+
+    EWAHBitVector *empty = ewah_new(n);
+    assert(empty->size == 1);
+    assert(ewah_count(empty) == 0);
+
+    ewah_free(empty);
+    ewah_free(ewah);
+    bv_free(bv);
+}
+
+static void
+test_bitwise_ops(void)
+{
+    const size_t n = 300007;
+    BitVector *a = make_sample(n, 3, 10000, 90000);
+    BitVector *b = make_sample(n, 5, 60000, 150000);
+    bv_clear_range(b, 200000, 64);
+
+    EWAHBitVector *ea = bv_compress_ewah(a);
+    EWAHBitVector *eb = bv_compress_ewah(b);
+    EWAHBitVector *r_and = ewah_and(ea, eb);
+    EWAHBitVector *r_or = ewah_or(ea, eb);
+    EWAHBitVector *r_xor = ewah_xor(ea, eb);
+    EWAHBitVector *r_andnot = ewah_andnot(ea, eb);
+
+    size_t c_and = 0, c_or = 0, c_xor = 0, c_andnot = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int x = bv_get(a, i), y = bv_get(b, i);
+        c_and += x & y;
+        c_or += x | y;
+        c_xor += x ^ y;
+        c_andnot += x & !y;
+        if (i % 11 == 0) {
+            assert(ewah_get(r_and, i) == (x & y));
+            assert(ewah_get(r_or, i) == (x | y));
+            assert(ewah_get(r_xor, i) == (x ^ y));
+            assert(ewah_get(r_andnot, i) == (x & !y));
+        }
+    }
+    assert(ewah_count(r_and) == c_and);
+    assert(ewah_count(r_or) == c_or);
+    assert(ewah_count(r_xor) == c_xor);
+    assert(ewah_count(r_andnot) == c_andnot);
+
+    /* Results are canonical, so they match a fresh encoding. */
+    EWAHBitVector *again = ewah_or(r_xor, r_and);
+    assert(ewah_equal(again, r_or));
+    EWAHBitVector *self_xor = ewah_xor(ea, ea);
+    EWAHBitVector *zeros = ewah_new(n);
+    assert(ewah_equal(self_xor, zeros));
+
+    EWAHBitVector *short_ewah = ewah_new(10);
+    assert(ewah_and(ea, short_ewah) == NULL);
+
+    ewah_free(short_ewah);
+    ewah_free(zeros);
+    ewah_free(self_xor);
+    ewah_free(again);
+    ewah_free(r_andnot);
+    ewah_free(r_xor);
+    ewah_free(r_or);
+    ewah_free(r_and);
+    ewah_free(eb);
+    ewah_free(ea);
+    bv_free(b);
+    bv_free(a);
+}
+
+static void
+test_copy_equal(void)
+{
+    BitVector *bv = make_sample(5000, 17, 100, 1000);
+    EWAHBitVector *a = bv_compress_ewah(bv);
+    EWAHBitVector *b = ewah_copy(a);
+    assert(ewah_equal(a, b));
+
+    bv_clear(bv, 17);
+    EWAHBitVector *c = bv_compress_ewah(bv);
+    assert(!ewah_equal(a, c));
+
+    ewah_free(c);
+    ewah_free(b);
+    ewah_free(a);
+    bv_free(bv);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_roundtrip();
+    test_compression();
+    test_bitwise_ops();
+    test_copy_equal();
+    printf("test_ewah_bitvector: OK\n");
+    return 0;
+}
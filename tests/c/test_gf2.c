@@ -0,0 +1,208 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "gf2.h"
+
+static BitMatrix *
+make_random(size_t rows, size_t cols, int percent, unsigned seed)
+{
+    BitMatrix *m = bm_new(rows, cols);
+    assert(m != NULL);
+    srand(seed);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            if (rand() % 100 < percent) {
+                bm_set(m, r, c);
+            }
+        }
+    }
+    return m;
+}
+
+/* Textbook elimination on a bit-per-byte copy. */
+static size_t
+naive_rank(const BitMatrix *m)
+{
+    const size_t rows = m->n_rows, cols = m->n_cols;
+    unsigned char *a = malloc(rows * cols + 1);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            a[r * cols + c] = (unsigned char) bm_get(m, r, c);
+        }
+    }
+    size_t rank = 0;
+    for (size_t c = 0; c < cols && rank < rows; ++c) {
+        size_t p = rank;
+        while (p < rows && !a[p * cols + c]) {
+            p++;
+        }
+        if (p == rows) {
+            continue;
+        }
+        for (size_t k = 0; k < cols; ++k) {
+            unsigned char t = a[p * cols + k];
+            a[p * cols + k] = a[rank * cols + k];
+            a[rank * cols + k] = t;
+        }
+        for (size_t r = 0; r < rows; ++r) {
+            if (r != rank && a[r * cols + c]) {
+                for (size_t k = 0; k < cols; ++k) {
+                    a[r * cols + k] ^= a[rank * cols + k];
+                }
+            }
+        }
+        rank++;
+    }
+    free(a);
+    return rank;
+}
+
+static BitMatrix *
+naive_mul(const BitMatrix *a, const BitMatrix *b)
+{
+    BitMatrix *out = bm_new(a->n_rows, b->n_cols);
+    for (size_t i = 0; i < a->n_rows; ++i) {
+        for (size_t j = 0; j < b->n_cols; ++j) {
+            int bit = 0;
+            for (size_t k = 0; k < a->n_cols; ++k) {
+                bit ^= bm_get(a, i, k) & bm_get(b, k, j);
+            }
+            if (bit) {
+                bm_set(out, i, j);
+            }
+        }
+    }
+    return out;
+}
+
+static void
+check_echelon(size_t rows, size_t cols, int percent, unsigned seed)
+{
+    BitMatrix *m = make_random(rows, cols, percent, seed);
+    const size_t expected = naive_rank(m);
+    assert(gf2_rank(m) == expected);
+
+    BitMatrix *e = bm_copy(m);
+    size_t *pivots = malloc((rows + cols + 1) * sizeof(size_t));
+    assert(gf2_echelon(e, false, pivots) == expected);
+    for (size_t i = 0; i < expected; ++i) {
+        assert(bm_get(e, i, pivots[i]) == 1);
+        for (size_t c = 0; c < pivots[i]; ++c) {
+            assert(bm_get(e, i, c) == 0);
+        }
+        if (i > 0) {
+            assert(pivots[i] > pivots[i - 1]);
+        }
+        for (size_t r = i + 1; r < rows; ++r) {
+            assert(bm_get(e, r, pivots[i]) == 0);
+        }
+    }
+    for (size_t r = expected; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            assert(bm_get(e, r, c) == 0);
+        }
+    }
+    assert(naive_rank(e) == expected);
+
+    BitMatrix *rref = bm_copy(m);
+    assert(gf2_echelon(rref, true, pivots) == expected);
+    for (size_t i = 0; i < expected; ++i) {
+        for (size_t r = 0; r < rows; ++r) {
+            assert(bm_get(rref, r, pivots[i]) == (r == i));
+        }
+    }
+
+    BitMatrix *null = gf2_nullspace(m);
+    assert(null != NULL);
+    assert(null->n_rows == cols - expected && null->n_cols == cols);
+    assert(gf2_rank(null) == null->n_rows);
+    BitMatrix *nt = bm_transpose(null);
+    BitMatrix *zero = gf2_mul(m, nt);
+    for (size_t r = 0; r < zero->n_rows; ++r) {
+        for (size_t c = 0; c < zero->n_cols; ++c) {
+            assert(bm_get(zero, r, c) == 0);
+        }
+    }
+
+    bm_free(zero);
+    bm_free(nt);
+    bm_free(null);
+    bm_free(rref);
+    free(pivots);
+    bm_free(e);
+    bm_free(m);
+}
+
+static void
+test_echelon(void)
+{
+    check_echelon(1, 1, 50, 1);
+    check_echelon(10, 10, 50, 2);
+    check_echelon(100, 100, 50, 3);
+    check_echelon(150, 90, 50, 4);
+    check_echelon(90, 150, 50, 5);
+    check_echelon(200, 200, 2, 6);
+    check_echelon(130, 257, 10, 7);
+    check_echelon(0, 5, 50, 8);
+    check_echelon(5, 0, 50, 9);
+
+    /* Duplicate rows: rank deficiency inside one strip. */
+    BitMatrix *m = make_random(80, 80, 50, 10);
+    for (size_t r = 1; r < 80; r += 2) {
+        bm_set_row(m, r, bm_row_view(m, r - 1));
+    }
+    assert(gf2_rank(m) == naive_rank(m));
+    assert(gf2_rank(m) <= 40);
+    bm_free(m);
+
+    BitMatrix *id = bm_new(100, 100);
+    for (size_t i = 0; i < 100; ++i) {
+        bm_set(id, i, i);
+    }
+    assert(gf2_rank(id) == 100);
+    BitMatrix *null = gf2_nullspace(id);
+    assert(null->n_rows == 0);
+    bm_free(null);
+    bm_free(id);
+}
+
+static void
+check_mul(size_t n, size_t k, size_t p, unsigned seed)
+{
+    BitMatrix *a = make_random(n, k, 50, seed);
+    BitMatrix *b = make_random(k, p, 50, seed + 1);
+    BitMatrix *c = gf2_mul(a, b);
+    BitMatrix *ref = naive_mul(a, b);
+    assert(c != NULL);
+    assert(bm_equal(c, ref));
+    bm_free(ref);
+    bm_free(c);
+    bm_free(b);
+    bm_free(a);
+}
+
+static void
+test_mul(void)
+{
+    check_mul(1, 1, 1, 20);
+    check_mul(10, 70, 30, 21);
+    check_mul(100, 65, 130, 22);
+    check_mul(300, 40, 20, 23);
+    check_mul(64, 0, 10, 24);
+
+    BitMatrix *a = bm_new(3, 4);
+    BitMatrix *b = bm_new(5, 2);
+    assert(gf2_mul(a, b) == NULL);
+    bm_free(a);
+    bm_free(b);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_echelon();
+    test_mul();
+    printf("test_gf2: OK\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+#include "key_hash.h"
+
+static void
+test_equal_vectors(void)
+{
+    BitVector *a = bv_new(1000);
+    BitVector *b = bv_new(1000);
+    bv_set(a, 3);
+    bv_set(a, 999);
+    bv_set(b, 3);
+    bv_set(b, 999);
+    assert(bv_hash(a, 0) == bv_hash(b, 0));
+    assert(bv_hash(a, 7) == bv_hash(b, 7));
+    assert(bv_hash(a, 0) != bv_hash(a, 7));
+    bv_clear(b, 999);
+    assert(bv_hash(a, 0) != bv_hash(b, 0));
+    bv_free(a);
+    bv_free(b);
+}
+
+static void
+test_length_mixed(void)
+{
+    /* Same (zero) words, different lengths. */
+    BitVector *a = bv_new(60);
+    BitVector *b = bv_new(64);
+    BitVector *e0 = bv_new(0);
+    assert(bv_hash(a, 0) != bv_hash(b, 0));
+    assert(bv_hash(e0, 0) == bv_hash(e0, 0));
+    assert(bv_hash(e0, 0) != bv_hash(a, 0));
+    assert(bv_hash(NULL, 0) == 0);
+    bv_free(a);
+    bv_free(b);
+    bv_free(e0);
+}
+
+static void
+test_matches_xxh64(void)
+{
+    BitVector *bv = bv_new(300);
+    for (size_t i = 0; i < 300; i += 7) {
+        bv_set(bv, i);
+    }
+    const uint64_t seed = 42 ^ (uint64_t) 300 * 0x9E3779B97F4A7C15ULL;
+    assert(bv_hash(bv, 42) == key_hash(KEY_HASH_XXH64, seed, bv->data,
+                                       bv->n_words * sizeof(uint64_t)));
+    (void) seed;
+    bv_free(bv);
+}
+
+int
+main(void)
+{
+    test_equal_vectors();
+    test_length_mixed();
+    test_matches_xxh64();
+    puts("test_hash: OK");
+    return 0;
+}
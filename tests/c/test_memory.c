@@ -0,0 +1,143 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+#include "bit_sliced_index.h"
+#include "bitmap_index.h"
+#include "bitmatrix.h"
+#include "bitvector_collection.h"
+#include "bloom_filter.h"
+#include "bp_tree.h"
+#include "compressed_bitvector.h"
+#include "elias_fano.h"
+#include "ewah_bitvector.h"
+#include "gf2.h"
+#include "quotient_filter.h"
+#include "rrr_bitvector.h"
+#include "wavelet_matrix.h"
+
+static void
+test_breakdown(void)
+{
+    bv_memory m;
+    assert(bv_memory_usage(NULL, &m) == 0);
+    assert(m.header == 0 && m.data == 0);
+
+    BitVector *empty = bv_new(0);
+    assert(bv_memory_usage(empty, &m) == sizeof(BitVector));
+    assert(m.data == 0 && m.padding == 0 && m.rank_tables == 0);
+
+    BitVector *bv = bv_new(100000);
+    size_t total = bv_memory_usage(bv, &m);
+    assert(m.header == sizeof(BitVector));
+    assert(m.data == bv->n_words * sizeof(uint64_t));
+    assert(m.padding == sizeof(uint64_t));
+    assert(m.rank_tables >= bv->n_words * sizeof(uint16_t));
+    assert(total == m.header + m.data + m.padding + m.rank_tables);
+    assert(bv_memory_usage(bv, NULL) == total);
+    (void) total;
+
+    bv_free(bv);
+    bv_free(empty);
+}
+
+static void
+test_live(void)
+{
+    const size_t before = cbits_live_bytes();
+    BitVector *a = bv_new(1 << 20);
+    BitVector *b = bv_copy(a);
+    assert(cbits_live_bytes() ==
+           before + bv_memory_usage(a, NULL) + bv_memory_usage(b, NULL));
+    bv_free(a);
+    assert(cbits_live_bytes() == before + bv_memory_usage(b, NULL));
+    bv_free(b);
+    assert(cbits_live_bytes() == before);
+    (void) before;
+}
+
+static void
+test_live_structures(void)
+{
+    const size_t before = cbits_live_bytes();
+    uint64_t values[1000];
+    uint64_t sorted[1000];
+    int64_t signed_values[1000];
+    for (size_t i = 0; i < 1000; ++i) {
+        values[i] = i * 7 % 251;
+        sorted[i] = i * 3;
+        signed_values[i] = (int64_t) i - 500;
+    }
+    BitVector *bv = bv_new(100000);
+    bv_set_range(bv, 1000, 3000);
+    for (size_t i = 50000; i < 100000; i += 3) {
+        bv_set(bv, i);
+    }
+    BitVector *parens = bv_new(64);
+    bv_set_range(parens, 0, 32);
+    const size_t with_bv = cbits_live_bytes();
+    assert(with_bv > before);
+
+    BitMatrix *m = bm_new(64, 200);
+    assert(bm_row_view(m, 3));
+    bm_set(m, 5, 7);
+    BitMatrix *null = gf2_nullspace(m);
+    BitVectorCollection *c = bvc_new(1000);
+    for (int i = 0; i < 100; ++i) {
+        bvc_append(c, bv);
+    }
+    CompressedBitVector *cbv = cbv_from_bitvector(bv);
+    EWAHBitVector *ewah = bv_compress_ewah(bv);
+    RRRBitVector *rrr = bv_build_rrr(bv);
+    EliasFano *ef = ef_from_sorted(sorted, 1000);
+    WaveletMatrix *wm = wm_new(values, 1000, 1);
+    BPTree *bp = bp_new(parens);
+    BloomFilter *bloom = bloom_new(BLOOM_BLOCKED, 1 << 16, 3,
+                                   KEY_HASH_XXH64, 0);
+    QuotientFilter *qf = qf_new(10, 8, KEY_HASH_XXH64, 0);
+    qf_insert_hashes(qf, values, 1000);
+    BitSlicedIndex *bsi = bsi_new(signed_values, NULL, 1000);
+    BitmapIndex *bmi = bmi_new(100000);
+    bmi_add(bmi, bv);
+    assert(m && null && c && cbv && ewah && rrr && ef && wm && bp && bloom &&
+           qf && bsi && bmi);
+
+    size_t live = cbits_live_bytes();
+#define CHECK_FREED(call)                  \
+    do {                                   \
+        call;                              \
+        assert(cbits_live_bytes() < live); \
+        live = cbits_live_bytes();         \
+    } while (0)
+    CHECK_FREED(bm_free(m));
+    CHECK_FREED(bm_free(null));
+    CHECK_FREED(bvc_free(c));
+    CHECK_FREED(cbv_free(cbv));
+    CHECK_FREED(ewah_free(ewah));
+    CHECK_FREED(rrr_free(rrr));
+    CHECK_FREED(ef_free(ef));
+    CHECK_FREED(wm_free(wm));
+    CHECK_FREED(bp_free(bp));
+    CHECK_FREED(bloom_free(bloom));
+    CHECK_FREED(qf_free(qf));
+    CHECK_FREED(bsi_free(bsi));
+    CHECK_FREED(bmi_free(bmi));
+#undef CHECK_FREED
+    assert(cbits_live_bytes() == with_bv);
+
+    bv_free(parens);
+    bv_free(bv);
+    assert(cbits_live_bytes() == before);
+    (void) before;
+    (void) with_bv;
+    (void) live;
+}
+
+int
+main(void)
+{
+    test_breakdown();
+    test_live();
+    test_live_structures();
+    puts("test_memory: OK");
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static int
+sign(int c)
+{
+    return (c > 0) - (c < 0);
+}
+
+static int
+naive_lex(const BitVector *a, const BitVector *b)
+{
+    size_t n = a->n_bits < b->n_bits ? a->n_bits : b->n_bits;
+    for (size_t i = 0; i < n; ++i) {
+        int x = bv_get(a, i), y = bv_get(b, i);
+        if (x != y) {
+            return x - y;
+        }
+    }
+    return (a->n_bits > b->n_bits) - (a->n_bits < b->n_bits);
+}
+
+static int
+naive_numeric(const BitVector *a, const BitVector *b)
+{
+    size_t n = a->n_bits > b->n_bits ? a->n_bits : b->n_bits;
+    for (size_t i = n; i-- > 0;) {
+        int x = i < a->n_bits && bv_get(a, i);
+        int y = i < b->n_bits && bv_get(b, i);
+        if (x != y) {
+            return x - y;
+        }
+    }
+    return (a->n_bits > b->n_bits) - (a->n_bits < b->n_bits);
+}
+
+/* Random vector of n bits whose bits from @p from on are random and whose
+ * first bits copy @p base, so that long equal prefixes are common. */
+static BitVector *
+make(size_t n, const BitVector *base, size_t from, uint64_t *rng)
+{
+    BitVector *bv = bv_new(n);
+    for (size_t i = 0; i < n; ++i) {
+        int bit = (base && i < from && i < base->n_bits)
+                      ? bv_get(base, i)
+                      : (int) (next_random(rng) & 1);
+        if (bit) {
+            bv_set(bv, i);
+        }
+    }
+    return bv;
+}
+
+static void
+test_orders(void)
+{
+    uint64_t rng = 0x1234567;
+    const size_t sizes[] = {0, 1, 63, 64, 65, 130, 600, 1100};
+    const size_t n_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    for (size_t i = 0; i < n_sizes; ++i) {
+        for (size_t j = 0; j < n_sizes; ++j) {
+            for (int round = 0; round < 20; ++round) {
+                BitVector *a = make(sizes[i], NULL, 0, &rng);
+                size_t from = (size_t) (next_random(&rng) % (sizes[j] + 1));
+                BitVector *b = make(sizes[j], a, from, &rng);
+                if (round & 1) {
+                    /* Zero the high part so numeric ties occur. */
+                    for (size_t k = from; k < sizes[j]; ++k) {
+                        bv_clear(b, k);
+                    }
+                    for (size_t k = from; k < sizes[i]; ++k) {
+                        bv_clear(a, k);
+                    }
+                }
+                assert(sign(bv_compare(a, b, BV_ORDER_LEX)) ==
+                       sign(naive_lex(a, b)));
+                assert(sign(bv_compare(a, b, BV_ORDER_NUMERIC)) ==
+                       sign(naive_numeric(a, b)));
+                assert((bv_compare(a, b, BV_ORDER_LEX) == 0) ==
+                       bv_equal(a, b));
+                assert((bv_compare(a, b, BV_ORDER_NUMERIC) == 0) ==
+                       bv_equal(a, b));
+                bv_free(a);
+                bv_free(b);
+            }
+        }
+    }
+}
+
+static void
+test_sets(void)
+{
+    uint64_t rng = 0xfeed;
+    const size_t sizes[] = {0, 5, 64, 700, 2000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        const size_t n = sizes[s];
+        BitVector *a = bv_new(n);
+        BitVector *b = bv_new(n);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t r = next_random(&rng) & 3;
+            if (r == 1) {
+                bv_set(a, i);
+                bv_set(b, i);
+            }
+            else if (r == 2) {
+                bv_set(b, i);
+            }
+        }
+        assert(bv_is_subset(a, b));
+        assert(bv_is_subset(a, a));
+        assert(!bv_is_disjoint(a, b) == (bv_count(a) > 0));
+        if (n) {
+            /* A single extra bit at the very end breaks containment. */
+            bv_set(a, n - 1);
+            bv_clear(b, n - 1);
+            assert(!bv_is_subset(a, b));
+            assert(!bv_is_disjoint(a, a));
+        }
+        BitVector *c = bv_new(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (!bv_get(a, i) && (next_random(&rng) & 1)) {
+                bv_set(c, i);
+            }
+        }
+        assert(bv_is_disjoint(a, c));
+        BitVector *d = bv_new(n + 1);
+        assert(!bv_is_subset(a, d));
+        assert(!bv_is_disjoint(a, d));
+        bv_free(a);
+        bv_free(b);
+        bv_free(c);
+        bv_free(d);
+    }
+}
+
+int
+main(void)
+{
+    test_orders();
+    test_sets();
+    puts("test_order: OK");
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "quotient_filter.h"
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Multiset of fingerprints (top q + r bits) as the reference model. */
+static size_t
+model_count(const uint64_t *model, size_t n, uint64_t hash, unsigned bits)
+{
+    size_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        c += (model[i] >> (64 - bits)) == (hash >> (64 - bits));
+    }
+    return c;
+}
+
+static void
+check_model(const QuotientFilter *qf, const uint64_t *model, size_t n)
+{
+    assert(qf->n_items == n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t got = qf_count_hash(qf, model[i]);
+        assert(got == model_count(model, n, model[i],
+                                  qf->q_bits + qf->r_bits));
+        assert(qf_contains_hash(qf, model[i]));
+        (void) got;
+    }
+}
+
+static void
+test_random_ops(unsigned q_bits, unsigned r_bits, uint64_t seed)
+{
+    QuotientFilter *qf = qf_new(q_bits, r_bits, KEY_HASH_XXH64, 0);
+    assert(qf != NULL);
+    const size_t cap = ((size_t) 1 << q_bits) * 9 / 10;
+    uint64_t *model = malloc(cap * sizeof(uint64_t));
+    size_t n = 0;
+    uint64_t state = seed;
+    /* Few distinct quotients make long runs and clusters. */
+    const uint64_t narrow = ~UINT64_C(0) >> 3;
+    for (int step = 0; step < 6000; ++step) {
+        uint64_t roll = next_random(&state) % 10;
+        if (roll < 6 && n < cap) {
+            uint64_t h = next_random(&state);
+            if (step & 1) {
+                h &= narrow;
+            }
+            if (n && roll == 0) {
+                h = model[next_random(&state) % n];
+            }
+            int rc = qf_insert_hash(qf, h);
+            assert(rc == 0);
+            (void) rc;
+            model[n++] = h;
+        }
+        else if (n) {
+            size_t i = next_random(&state) % n;
+            bool removed = qf_remove_hash(qf, model[i]);
+            assert(removed);
+            (void) removed;
+            model[i] = model[--n];
+        }
+        if (step % 500 == 0) {
+            check_model(qf, model, n);
+        }
+    }
+    check_model(qf, model, n);
+
+    /* Absent fingerprints are reported absent and cannot be removed. */
+    const unsigned bits = q_bits + r_bits;
+    for (int i = 0; i < 2000; ++i) {
+        uint64_t h = next_random(&state);
+        bool expect = model_count(model, n, h, bits) > 0;
+        bool got = qf_contains_hash(qf, h);
+        assert(got == expect);
+        (void) got;
+        (void) expect;
+    }
+    QuotientFilter *copy = qf_copy(qf);
+    assert(copy != NULL);
+    check_model(copy, model, n);
+    while (n) {
+        bool removed = qf_remove_hash(qf, model[--n]);
+        assert(removed);
+        (void) removed;
+    }
+    assert(qf->n_items == 0);
+    assert(bv_count(qf->occupieds) == 0 && bv_count(qf->runends) == 0);
+    bool removed = qf_remove_hash(qf, copy->n_items ? model[0] : 0);
+    assert(!removed);
+    (void) removed;
+    qf_free(copy);
+    free(model);
+    qf_free(qf);
+}
+
+static void
+test_batches(void)
+{
+    unsigned q_bits, r_bits;
+    int rc = qf_params(10000, 0.01, &q_bits, &r_bits);
+    assert(rc == 0 && q_bits == 14 && r_bits == 7);
+    rc = qf_params(10, 0.5, &q_bits, &r_bits);
+    assert(rc == 0 && q_bits == 6 && r_bits == 1);
+    rc = qf_params(10, 0.0, &q_bits, &r_bits);
+    assert(rc == -1);
+    (void) rc;
+    QuotientFilter *bad = qf_new(0, 8, KEY_HASH_XXH64, 0);
+    assert(bad == NULL);
+    bad = qf_new(20, 45, KEY_HASH_XXH64, 0);
+    assert(bad == NULL);
+    (void) bad;
+
+    QuotientFilter *qf = qf_new(10, 12, KEY_HASH_FNV1A, 5);
+    const size_t n = 2000;
+    uint64_t *keys = malloc(n * sizeof(uint64_t));
+    uint64_t *hashes = malloc(n * sizeof(uint64_t));
+    uint64_t found[(2000 + 63) / 64] = {0};
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = i;
+    }
+    key_hash_u64_many(qf->hash, qf->seed, keys, n, hashes);
+
+    /* The filter stops at one key per home slot. */
+    size_t inserted = qf_insert_hashes(qf, hashes, n);
+    assert(inserted == 1024);
+    assert(qf->n_items == inserted);
+    qf_contains_hashes(qf, hashes, inserted, found);
+    for (size_t i = 0; i < inserted; ++i) {
+        assert((found[i >> 6] >> (i & 63)) & 1);
+    }
+
+    /* Remove every other key, then the rest. */
+    uint64_t removed_bits[(2000 + 63) / 64] = {0};
+    uint64_t *odd = malloc(n * sizeof(uint64_t));
+    size_t n_odd = 0;
+    for (size_t i = 1; i < inserted; i += 2) {
+        odd[n_odd++] = hashes[i];
+    }
+    size_t removed = qf_remove_hashes(qf, odd, n_odd, removed_bits);
+    assert(removed == n_odd);
+    for (size_t i = 0; i < n_odd; ++i) {
+        assert((removed_bits[i >> 6] >> (i & 63)) & 1);
+    }
+    for (size_t i = 0; i < inserted; i += 2) {
+        assert(qf_contains_hash(qf, hashes[i]));
+    }
+    removed = qf_remove_hashes(qf, hashes, inserted, NULL);
+    assert(removed == inserted - n_odd);
+    assert(qf->n_items == 0);
+    (void) removed;
+    (void) inserted;
+    free(odd);
+    free(hashes);
+    free(keys);
+    qf_free(qf);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_random_ops(8, 8, 1);
+    test_random_ops(10, 5, 2);
+    test_random_ops(7, 57, 3);
+    test_batches();
+    printf("test_quotient_filter: OK\n");
+    return 0;
+}
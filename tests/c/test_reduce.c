@@ -0,0 +1,116 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+
+#define MAX_VECTORS 70
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void
+check(const BitVector *r, const BitVector *const *vs, size_t n, size_t k,
+      int mode)
+{
+    assert(r && r->n_bits == vs[0]->n_bits);
+    for (size_t i = 0; i < r->n_bits; ++i) {
+        size_t ones = 0;
+        for (size_t v = 0; v < n; ++v) {
+            ones += (size_t) bv_get(vs[v], i);
+        }
+        int expected;
+        switch (mode) {
+            case 0:
+                expected = ones == n;
+                break;
+            case 1:
+                expected = ones > 0;
+                break;
+            case 2:
+                expected = (int) (ones & 1);
+                break;
+            default:
+                expected = ones >= k;
+                break;
+        }
+        int got = bv_get(r, i);
+        assert(got == expected);
+        (void) got;
+        (void) expected;
+    }
+    /* Tail bits stay clear. */
+    size_t count = bv_count(r);
+    size_t count_range = bv_count_range(r, 0, r->n_bits);
+    assert(count == count_range);
+    (void) count;
+    (void) count_range;
+}
+
+static void
+run_case(size_t n_bits, size_t n, uint64_t seed)
+{
+    uint64_t state = seed;
+    BitVector *vs[MAX_VECTORS];
+    for (size_t v = 0; v < n; ++v) {
+        vs[v] = bv_new(n_bits);
+        /* Dense inputs so AND and high thresholds have hits. */
+        for (size_t i = 0; i < n_bits; ++i) {
+            if (next_random(&state) % 8 != 0) {
+                bv_set(vs[v], i);
+            }
+        }
+    }
+    const BitVector *const *in = (const BitVector *const *) vs;
+
+    BitVector *r = bv_and_all(in, n);
+    check(r, in, n, 0, 0);
+    bv_free(r);
+    r = bv_or_all(in, n);
+    check(r, in, n, 0, 1);
+    bv_free(r);
+    r = bv_xor_all(in, n);
+    check(r, in, n, 0, 2);
+    bv_free(r);
+    for (size_t k = 0; k <= n + 1; ++k) {
+        r = bv_threshold(in, n, k);
+        check(r, in, n, k, 3);
+        bv_free(r);
+    }
+    for (size_t v = 0; v < n; ++v) {
+        bv_free(vs[v]);
+    }
+}
+
+int
+main(void)
+{
+    run_case(1, 1, 1);
+    run_case(100, 3, 2);
+    run_case(64 * 512 + 65, 5, 3);
+    run_case(64 * 64 * 2 + 1, MAX_VECTORS, 4);
+
+    /* Invalid input. */
+    BitVector *a = bv_new(10);
+    BitVector *b = bv_new(11);
+    const BitVector *mixed[] = {a, b};
+    BitVector *r = bv_or_all(mixed, 2);
+    assert(!r);
+    r = bv_threshold(mixed, 2, 1);
+    assert(!r);
+    r = bv_threshold(mixed, 2, 0);
+    assert(!r);
+    r = bv_and_all(mixed, 0);
+    assert(!r);
+    r = bv_threshold(mixed, 0, 0);
+    assert(!r);
+    (void) r;
+    bv_free(a);
+    bv_free(b);
+    puts("test_reduce: OK");
+    return 0;
+}
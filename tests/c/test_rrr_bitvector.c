@@ -0,0 +1,103 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bitvector.h"
+#include "rrr_bitvector.h"
+
+static BitVector *
+make_random(size_t n, unsigned percent, unsigned seed)
+{
+    BitVector *bv = bv_new(n);
+    srand(seed);
+    for (size_t i = 0; i < n; ++i) {
+        if ((unsigned) (rand() % 100) < percent) {
+            bv_set(bv, i);
+        }
+    }
+    return bv;
+}
+
+static void
+check_against(BitVector *bv)
+{
+    RRRBitVector *rrr = bv_build_rrr(bv);
+    assert(rrr != NULL);
+    const size_t n = bv->n_bits;
+    size_t total = n ? bv_rank(bv, n - 1) : 0;
+    assert(rrr_count(rrr) == total);
+
+    for (size_t i = 0; i < n; ++i) {
+        assert(rrr_get(rrr, i) == bv_get(bv, i));
+        assert(rrr_rank(rrr, i) == bv_rank(bv, i));
+    }
+    assert(rrr_get(rrr, n) == -1);
+    if (n) {
+        assert(rrr_rank(rrr, n + 100) == total);
+    }
+    for (size_t k = 0; k < total; ++k) {
+        size_t pos = rrr_select(rrr, k);
+        assert(bv_get(bv, pos) == 1);
+        assert(rrr_rank(rrr, pos) == k + 1);
+    }
+    assert(rrr_select(rrr, total) == SIZE_MAX);
+
+    BitVector *back = rrr_to_bitvector(rrr);
+    assert(bv_equal(bv, back));
+    bv_free(back);
+    rrr_free(rrr);
+}
+
+static void
+test_densities(void)
+{
+    const unsigned percents[] = {0, 1, 10, 50, 90, 100};
+    for (size_t p = 0; p < sizeof(percents) / sizeof(percents[0]); ++p) {
+        BitVector *bv = make_random(10007, percents[p], (unsigned) p + 1);
+        check_against(bv);
+        bv_free(bv);
+    }
+}
+
+static void
+test_edge_cases(void)
+{
+    BitVector *empty = bv_new(0);
+    check_against(empty);
+    bv_free(empty);
+
+    BitVector *one = bv_new(1);
+    bv_set(one, 0);
+    check_against(one);
+    bv_free(one);
+
+    /* Every class of a single block, including the extremes. */
+    BitVector *bv = bv_new(64 * 65);
+    for (size_t c = 0; c <= 64; ++c) {
+        bv_set_range(bv, c * 64 + (64 - c), c);
+    }
+    check_against(bv);
+    bv_free(bv);
+}
+
+static void
+test_compression(void)
+{
+    const size_t n = 1u << 20;
+    BitVector *sparse = make_random(n, 2, 99);
+    RRRBitVector *rrr = bv_build_rrr(sparse);
+    /* H0(0.02) is about 0.14 bits per bit. */
+    assert(rrr_memory_usage(rrr) * 8 < n / 3);
+    rrr_free(rrr);
+    bv_free(sparse);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_densities();
+    test_edge_cases();
+    test_compression();
+    printf("test_rrr_bitvector: OK\n");
+    return 0;
+}
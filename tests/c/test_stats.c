@@ -0,0 +1,140 @@
+#include <assert.h>
+#include <stdio.h>
+#include "bitvector.h"
+#include "bloom_filter.h"
+
+static uint64_t
+stat(cbits_stat s)
+{
+    return cbits_stats_read(s, 0);
+}
+
+static void
+test_names(void)
+{
+    for (int s = 0; s < CBITS_STAT_COUNT; ++s) {
+        assert(cbits_stat_name((cbits_stat) s) != NULL);
+    }
+    assert(cbits_stat_name(CBITS_STAT_COUNT) == NULL);
+    assert(cbits_stats_read(CBITS_STAT_COUNT, 0) == 0);
+}
+
+static void
+test_alloc(void)
+{
+    cbits_stats_reset();
+    BitVector *a = bv_new(1000);
+    BitVector *b = bv_new(0);
+    assert(stat(CBITS_STAT_ALLOCS) == 2);
+    assert(stat(CBITS_STAT_ALLOC_BYTES) > 1000 / 8);
+    bv_free(a);
+    bv_free(b);
+    bv_free(NULL);
+    assert(stat(CBITS_STAT_FREES) == 2);
+    assert(stat(CBITS_STAT_FREE_BYTES) == stat(CBITS_STAT_ALLOC_BYTES));
+}
+
+static void
+test_alloc_structures(void)
+{
+    cbits_stats_reset();
+    const size_t live = cbits_live_bytes();
+    BloomFilter *bloom = bloom_new(BLOOM_BLOCKED, 1 << 16, 3,
+                                   KEY_HASH_XXH64, 0);
+    assert(bloom);
+    assert(stat(CBITS_STAT_ALLOCS) >= 1);
+    assert(stat(CBITS_STAT_ALLOC_BYTES) == cbits_live_bytes() - live);
+    bloom_free(bloom);
+    assert(stat(CBITS_STAT_FREES) == stat(CBITS_STAT_ALLOCS));
+    assert(stat(CBITS_STAT_FREE_BYTES) == stat(CBITS_STAT_ALLOC_BYTES));
+    assert(cbits_live_bytes() == live);
+}
+
+static void
+test_rank_and_bitwise(void)
+{
+    BitVector *a = bv_new(640);
+    BitVector *b = bv_new(640);
+    cbits_stats_reset();
+    bv_set(a, 3);
+    bv_build_rank(a);
+    assert(stat(CBITS_STAT_RANK_BUILDS) == 1);
+    assert(stat(CBITS_STAT_RANK_WORDS) == 10);
+
+    cbits_bitwise_words(a->data, a->data, b->data, a->n_words,
+                        CBITS_BITWISE_XOR);
+    cbits_bitwise_words(a->data, a->data, NULL, a->n_words,
+                        CBITS_BITWISE_NOT);
+    /* Internal kernel calls are left to the operators that own them. */
+    assert(stat(CBITS_STAT_BITWISE_BYTES) == 0);
+
+    const BitVector *vs[] = {a, b};
+    BitVector *r = bv_or_all(vs, 2);
+    assert(stat(CBITS_STAT_BITWISE_BYTES) == 2 * 10 * 8);
+    bv_free(r);
+    bv_free(a);
+    bv_free(b);
+}
+
+static void
+test_search(void)
+{
+    BitVector *hay = bv_new(256);
+    BitVector *short_needle = bv_new(8);
+    BitVector *long_needle = bv_new(100);
+    bv_set(hay, 64);
+    bv_set(hay, 200);
+    bv_set(short_needle, 0);
+    bv_set(long_needle, 0);
+    bv_set(long_needle, 99);
+
+    cbits_stats_reset();
+    /* Offset 64 starts a word; the upper word must not leak in. */
+    assert(bv_contains_subvector(hay, short_needle));
+    assert(stat(CBITS_STAT_SEARCH_CALLS) == 1);
+    assert(stat(CBITS_STAT_SEARCH_WINDOWS) == 65);
+
+    cbits_stats_reset();
+    assert(!bv_contains_subvector(hay, long_needle));
+    assert(stat(CBITS_STAT_SEARCH_WINDOWS) == 157);
+    assert(stat(CBITS_STAT_SEARCH_VERIFY) == 1);
+
+    bv_set(hay, 163);
+    cbits_stats_reset();
+    assert(bv_contains_subvector(hay, long_needle));
+    assert(stat(CBITS_STAT_SEARCH_WINDOWS) == 65);
+    assert(stat(CBITS_STAT_SEARCH_VERIFY) == 1);
+
+    bv_free(hay);
+    bv_free(short_needle);
+    bv_free(long_needle);
+}
+
+static void
+test_reset(void)
+{
+    bv_free(bv_new(64));
+    assert(cbits_stats_read(CBITS_STAT_ALLOCS, 1) == 1);
+    assert(stat(CBITS_STAT_ALLOCS) == 0);
+    cbits_stats_reset();
+    for (int s = 0; s < CBITS_STAT_COUNT; ++s) {
+        assert(stat((cbits_stat) s) == 0);
+    }
+}
+
+int
+main(void)
+{
+    if (!cbits_stats_enabled()) {
+        puts("test_stats: SKIPPED");
+        return 0;
+    }
+    test_names();
+    test_alloc();
+    test_alloc_structures();
+    test_rank_and_bitwise();
+    test_search();
+    test_reset();
+    puts("test_stats: OK");
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "wavelet_matrix.h"
+
+static uint64_t *
+make_values(size_t n, uint64_t sigma, unsigned seed)
+{
+    uint64_t *v = malloc((n ? n : 1) * sizeof(uint64_t));
+    srand(seed);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t x = ((uint64_t) rand() << 31) ^ (uint64_t) rand();
+        v[i] = sigma ? x % sigma : x;
+    }
+    return v;
+}
+
+static void
+check_against_naive(const WaveletMatrix *wm, const uint64_t *v, size_t n,
+                    uint64_t sigma)
+{
+    for (size_t i = 0; i < n; ++i) {
+        assert(wm_access(wm, i) == v[i]);
+    }
+    assert(wm_access(wm, n) == UINT64_MAX);
+
+    /* rank and select for a few symbols, including absent ones */
+    for (uint64_t c = 0; c < 8; ++c) {
+        uint64_t symbol = c < 4 ? c : v[(size_t) c * 7 % n];
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            assert(wm_rank(wm, symbol, i) == count);
+            if (v[i] == symbol) {
+                assert(wm_select(wm, symbol, count) == i);
+                ++count;
+            }
+        }
+        assert(wm_rank(wm, symbol, n + 10) == count);
+        assert(wm_select(wm, symbol, count) == SIZE_MAX);
+    }
+    if (sigma && sigma < 64) {
+        assert(wm_rank(wm, UINT64_MAX, n) == 0);
+        assert(wm_select(wm, UINT64_MAX, 0) == SIZE_MAX);
+    }
+
+    /* quantile and range frequency on a few windows */
+    const size_t windows[][2] = {{0, n}, {n / 3, n / 2}, {5, 6}, {7, 7}};
+    for (size_t w = 0; w < 4; ++w) {
+        size_t start = windows[w][0], stop = windows[w][1];
+        size_t len = stop > start ? stop - start : 0;
+        uint64_t *sorted = malloc((len ? len : 1) * sizeof(uint64_t));
+        for (size_t i = 0; i < len; ++i) {
+            sorted[i] = v[start + i];
+        }
+        for (size_t i = 1; i < len; ++i) {
+            for (size_t j = i; j > 0 && sorted[j - 1] > sorted[j]; --j) {
+                uint64_t t = sorted[j];
+                sorted[j] = sorted[j - 1];
+                sorted[j - 1] = t;
+            }
+        }
+        for (size_t k = 0; k < len; k += 1 + len / 50) {
+            assert(wm_quantile(wm, start, stop, k) == sorted[k]);
+        }
+        assert(wm_quantile(wm, start, stop, len) == UINT64_MAX);
+
+        uint64_t lo = len ? sorted[len / 4] : 0;
+        uint64_t hi = len ? sorted[len * 3 / 4] + 1 : 1;
+        size_t expected = 0;
+        for (size_t i = 0; i < len; ++i) {
+            expected += sorted[i] >= lo && sorted[i] < hi;
+        }
+        assert(wm_range_freq(wm, start, stop, lo, hi) == expected);
+        assert(wm_range_freq(wm, start, stop, 0, UINT64_MAX) ==
+               len - (len && sorted[len - 1] == UINT64_MAX));
+        assert(wm_range_freq(wm, start, stop, hi, lo) == 0);
+        free(sorted);
+    }
+}
+
+static void
+test_small_alphabets(void)
+{
+    const uint64_t sigmas[] = {1, 2, 5, 256, 60000};
+    for (size_t s = 0; s < sizeof(sigmas) / sizeof(sigmas[0]); ++s) {
+        const size_t n = 3000;
+        uint64_t *v = make_values(n, sigmas[s], (unsigned) s + 1);
+        WaveletMatrix *wm = wm_new(v, n, 0);
+        assert(wm != NULL);
+        assert(wm->n_levels <= WM_PARALLEL_MAX_LEVELS);
+        check_against_naive(wm, v, n, sigmas[s]);
+        wm_free(wm);
+        free(v);
+    }
+}
+
+static void
+test_wide_values(void)
+{
+    const size_t n = 2000;
+    uint64_t *v = make_values(n, 0, 99);
+    v[0] = UINT64_MAX;
+    v[1] = 0;
+    WaveletMatrix *wm = wm_new(v, n, 0);
+    assert(wm->n_levels == 64);
+    check_against_naive(wm, v, n, 0);
+    wm_free(wm);
+    free(v);
+}
+
+static void
+test_parallel_matches_sequential(void)
+{
+    const size_t n = WM_PARALLEL_MIN_SIZE + 1234;
+    uint64_t *v = make_values(n, 1000, 5);
+    WaveletMatrix *par = wm_new(v, n, 4);
+    WaveletMatrix *seq = wm_new(v, n, 1);
+    assert(par->n_levels == seq->n_levels);
+    for (unsigned l = 0; l < par->n_levels; ++l) {
+        assert(par->zeros[l] == seq->zeros[l]);
+        assert(bv_equal(par->levels[l], seq->levels[l]));
+    }
+    for (size_t i = 0; i < n; i += 97) {
+        assert(wm_access(par, i) == v[i]);
+    }
+    wm_free(par);
+    wm_free(seq);
+    free(v);
+}
+
+static void
+test_edge_cases(void)
+{
+    WaveletMatrix *empty = wm_new(NULL, 0, 0);
+    assert(empty != NULL);
+    assert(wm_access(empty, 0) == UINT64_MAX);
+    assert(wm_rank(empty, 0, 0) == 0);
+    assert(wm_select(empty, 0, 0) == SIZE_MAX);
+    assert(wm_quantile(empty, 0, 0, 0) == UINT64_MAX);
+    assert(wm_range_freq(empty, 0, 0, 0, 10) == 0);
+    wm_free(empty);
+
+    uint64_t one[] = {42};
+    WaveletMatrix *wm = wm_new(one, 1, 0);
+    assert(wm_access(wm, 0) == 42);
+    assert(wm_rank(wm, 42, 1) == 1);
+    assert(wm_select(wm, 42, 0) == 0);
+    assert(wm_quantile(wm, 0, 1, 0) == 42);
+    assert(wm_range_freq(wm, 0, 1, 42, 43) == 1);
+    assert(wm_memory_usage(wm) > sizeof(WaveletMatrix));
+    wm_free(wm);
+}
+
+int
+main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    test_small_alphabets();
+    test_wide_values();
+    test_parallel_matches_sequential();
+    test_edge_cases();
+    printf("test_wavelet_matrix: OK\n");
+    return 0;
+}
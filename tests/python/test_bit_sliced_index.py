@@ -0,0 +1,161 @@
+import operator
+import random
+import sys
+import threading
+import unittest
+from cbits import BitSlicedIndex, BitVector
+
+
+def rows(bv):
+    return [i for i in range(len(bv)) if bv[i]]
+
+
+class TestBitSlicedIndex(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(38)
+        self.values = [
+            None if rng.random() < 0.1 else rng.randrange(-500, 1500)
+            for _ in range(1000)
+        ]
+        self.bsi = BitSlicedIndex(self.values)
+
+    def expected(self, pred):
+        return [i for i, v in enumerate(self.values)
+                if v is not None and pred(v)]
+
+    def test_len_and_access(self):
+        self.assertEqual(len(self.values), len(self.bsi))
+        present = [v for v in self.values if v is not None]
+        self.assertEqual(min(present), self.bsi.base)
+        self.assertEqual((max(present) - min(present)).bit_length(),
+                         self.bsi.bits)
+        for i in range(0, len(self.values), 7):
+            self.assertEqual(self.values[i], self.bsi[i])
+        self.assertEqual(self.values[-1], self.bsi[-1])
+        with self.assertRaises(IndexError):
+            _ = self.bsi[len(self.values)]
+        self.assertEqual(self.expected(lambda v: True),
+                         rows(self.bsi.exists))
+
+    def test_slices(self):
+        base = self.bsi.base
+        for bit in range(self.bsi.bits):
+            self.assertEqual(
+                self.expected(lambda v: (v - base) >> bit & 1),
+                rows(self.bsi.slice(bit)))
+        with self.assertRaises(IndexError):
+            self.bsi.slice(self.bsi.bits)
+
+    def test_comparisons(self):
+        ops = {"eq": operator.eq, "ne": operator.ne, "lt": operator.lt,
+               "le": operator.le, "gt": operator.gt, "ge": operator.ge}
+        for c in (-501, -500, 0, 17, 1499, 1500, 2**63, 2**70, -2**70):
+            for name, op in ops.items():
+                result = getattr(self.bsi, name)(c)
+                self.assertIsInstance(result, BitVector)
+                self.assertEqual(len(self.values), len(result))
+                self.assertEqual(self.expected(lambda v: op(v, c)),
+                                 rows(result), (name, c))
+        with self.assertRaises(TypeError):
+            self.bsi.eq(1.5)
+
+    def test_between(self):
+        bounds = (-2**70, -600, -500, 0, 250, 1499, 2**64)
+        for lo in bounds:
+            for hi in bounds:
+                self.assertEqual(self.expected(lambda v: lo <= v <= hi),
+                                 rows(self.bsi.between(lo, hi)))
+
+    def test_sum(self):
+        self.assertEqual(sum(v for v in self.values if v is not None),
+                         self.bsi.sum())
+        mask = self.bsi.between(0, 999)
+        self.assertEqual(sum(v for v in self.values
+                             if v is not None and 0 <= v <= 999),
+                         self.bsi.sum(mask))
+        big = BitSlicedIndex([2**63 - 1] * 4 + [None, -2**63])
+        self.assertEqual(4 * (2**63 - 1) - 2**63, big.sum())
+        with self.assertRaises(ValueError):
+            self.bsi.sum(BitVector(3))
+        with self.assertRaises(TypeError):
+            self.bsi.sum([1, 2])
+
+    def test_top_k(self):
+        indexed = [(v, i) for i, v in enumerate(self.values)
+                   if v is not None]
+        for k in (0, 1, 10, 500, 5000):
+            top = sorted(indexed, key=lambda t: (-t[0], t[1]))[:k]
+            self.assertEqual(sorted(i for _, i in top),
+                             rows(self.bsi.top_k(k)))
+            bottom = sorted(indexed)[:k]
+            self.assertEqual(sorted(i for _, i in bottom),
+                             rows(self.bsi.top_k(k, largest=False)))
+        mask = self.bsi.lt(0)
+        top = sorted(((v, i) for v, i in indexed if v < 0),
+                     key=lambda t: (-t[0], t[1]))[:5]
+        self.assertEqual(sorted(i for _, i in top),
+                         rows(self.bsi.top_k(5, mask)))
+        with self.assertRaises(ValueError):
+            self.bsi.top_k(-1)
+
+    def test_ties(self):
+        bsi = BitSlicedIndex([3, 7, 7, None, 7, 1])
+        self.assertEqual([1, 2], rows(bsi.top_k(2)))
+        self.assertEqual([0, 5], rows(bsi.top_k(2, largest=False)))
+        self.assertEqual([1, 2, 4], rows(bsi.eq(7)))
+
+    def test_edge_columns(self):
+        empty = BitSlicedIndex([])
+        self.assertEqual(0, len(empty))
+        self.assertEqual(0, empty.sum())
+        self.assertEqual(0, len(empty.ge(0)))
+        nulls = BitSlicedIndex([None, None])
+        self.assertEqual([], rows(nulls.ne(0)))
+        self.assertIsNone(nulls[0])
+        constant = BitSlicedIndex([5, 5, 5])
+        self.assertEqual(0, constant.bits)
+        self.assertEqual([0, 1, 2], rows(constant.eq(5)))
+        self.assertEqual([], rows(constant.gt(5)))
+        extremes = BitSlicedIndex([-2**63, 2**63 - 1, 0])
+        self.assertEqual(64, extremes.bits)
+        self.assertEqual([0, 2], rows(extremes.le(0)))
+        self.assertEqual([1], rows(extremes.top_k(1)))
+        with self.assertRaises(OverflowError):
+            BitSlicedIndex([2**63])
+        with self.assertRaises(TypeError):
+            BitSlicedIndex([1, "x"])
+
+    def test_repr_and_sizeof(self):
+        self.assertIn("rows=1000", repr(self.bsi))
+        self.assertGreater(sys.getsizeof(self.bsi),
+                           (self.bsi.bits + 1) * len(self.values) // 8)
+
+    def test_reinit_during_query(self):
+        n = 1 << 18
+        columns = [list(range(n)), list(range(0, 2 * n, 2))]
+        bsi = BitSlicedIndex(columns[0])
+        done = threading.Event()
+
+        def reinit():
+            while not done.is_set():
+                for values in columns:
+                    try:
+                        bsi.__init__(values)
+                    except BufferError:
+                        pass
+
+        worker = threading.Thread(target=reinit)
+        worker.start()
+        try:
+            for _ in range(100):
+                self.assertIn(bsi.ge(n).count(), (0, n // 2))
+                self.assertIn(bsi.between(0, n - 1).count(), (n, n // 2))
+                self.assertIn(bsi.sum(), (n * (n - 1) // 2, n * (n - 1)))
+                self.assertEqual(5, bsi.top_k(5).count())
+        finally:
+            done.set()
+            worker.join()
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,139 @@
+import random
+import sys
+import unittest
+from cbits import BitmapIndex, BitVector
+
+
+def make(n, bits):
+    bv = BitVector(n)
+    for i in bits:
+        bv[i] = True
+    return bv
+
+
+def rows(bv):
+    return [i for i in range(len(bv)) if bv[i]]
+
+
+class TestBitmapIndex(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(39)
+        self.n = 5000
+        self.sets = {
+            "red": {i for i in range(self.n) if rng.random() < 0.3},
+            "small": {i for i in range(self.n) if rng.random() < 0.05},
+            ("size", 2): {i for i in range(self.n) if rng.random() < 0.6},
+            7: set(range(100, 4000)),
+            "empty": set(),
+        }
+        self.index = BitmapIndex(
+            self.n, {k: make(self.n, v) for k, v in self.sets.items()})
+
+    def evaluate(self, expr):
+        universe = set(range(self.n))
+        if isinstance(expr, tuple) and expr and expr[0] in (
+                "and", "or", "not", "andnot"):
+            parts = [self.evaluate(e) for e in expr[1:]]
+            if expr[0] == "and":
+                return set.intersection(*parts)
+            if expr[0] == "or":
+                return set.union(*parts)
+            if expr[0] == "not":
+                return universe - parts[0]
+            return parts[0].difference(*parts[1:])
+        return self.sets[expr]
+
+    def test_mapping(self):
+        self.assertEqual(len(self.sets), len(self.index))
+        self.assertEqual(self.n, self.index.size)
+        self.assertEqual(list(self.sets), self.index.keys())
+        self.assertEqual(list(self.sets), list(self.index))
+        for key, bits in self.sets.items():
+            self.assertIn(key, self.index)
+            self.assertEqual(sorted(bits), rows(self.index[key]))
+            self.assertEqual(len(bits), self.index.cardinality(key))
+        self.assertNotIn("blue", self.index)
+        with self.assertRaises(KeyError):
+            _ = self.index["blue"]
+
+    def test_queries(self):
+        queries = [
+            "red",
+            ("not", "red"),
+            ("not", ("not", "small")),
+            ("and", "red", "small"),
+            ("or", "red", ("and", 7, ("size", 2)), "empty"),
+            ("andnot", 7, "red", ("not", "small")),
+            ("and", ("not", "red"), ("not", 7)),
+            ("andnot", 7, ("or", "red", ("size", 2))),
+            ("and", "red", "empty", 7),
+            ("or", ("and", "red", ("or", "small", ("size", 2))),
+             ("andnot", 7, "red")),
+        ]
+        for expr in queries:
+            with self.subTest(expr=expr):
+                expected = sorted(self.evaluate(expr))
+                result = self.index.query(expr)
+                self.assertEqual(self.n, len(result))
+                self.assertEqual(expected, rows(result))
+                self.assertEqual(len(expected), self.index.count(expr))
+
+    def test_query_errors(self):
+        with self.assertRaises(KeyError):
+            self.index.query(("and", "red", "blue"))
+        with self.assertRaises(ValueError):
+            self.index.query(("not", "red", "small"))
+        with self.assertRaises(ValueError):
+            self.index.count(("or",))
+        with self.assertRaises(TypeError):
+            self.index.query(["red"])
+        deep = "red"
+        for _ in range(100000):
+            deep = ("not", deep)
+        with self.assertRaises(RecursionError):
+            self.index.query(deep)
+
+    def test_set_and_delete(self):
+        self.index["red"] = make(self.n, [1, 2, 3])
+        self.sets["red"] = {1, 2, 3}
+        self.assertEqual(3, self.index.cardinality("red"))
+        del self.index["red"]
+        del self.sets["red"]
+        with self.assertRaises(KeyError):
+            del self.index["red"]
+        self.assertEqual(list(self.sets), sorted(self.index, key=list(
+            self.sets).index))
+        for key, bits in self.sets.items():
+            self.assertEqual(sorted(bits), rows(self.index[key]))
+        expr = ("or", "small", ("not", 7))
+        self.assertEqual(sorted(self.evaluate(expr)),
+                         rows(self.index.query(expr)))
+        self.index["new"] = make(self.n, [0])
+        self.assertEqual([0], rows(self.index.query("new")))
+
+    def test_invalid_values(self):
+        with self.assertRaises(ValueError):
+            BitmapIndex(-1)
+        with self.assertRaises(ValueError):
+            self.index["bad"] = BitVector(self.n + 1)
+        with self.assertRaises(TypeError):
+            self.index["bad"] = [True] * self.n
+        with self.assertRaises(TypeError):
+            self.index[[1]] = BitVector(self.n)
+        self.assertNotIn("bad", self.index)
+
+    def test_stored_copy(self):
+        bv = make(self.n, [5])
+        self.index["copy"] = bv
+        bv[6] = True
+        self.index["copy"][7] = True
+        self.assertEqual([5], rows(self.index["copy"]))
+
+    def test_sizeof_and_repr(self):
+        self.assertGreater(sys.getsizeof(self.index),
+                           len(self.sets) * self.n // 8)
+        self.assertIn("vectors=5", repr(self.index))
+
+
+if __name__ == "__main__":
+    unittest.main()
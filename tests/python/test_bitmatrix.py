@@ -0,0 +1,146 @@
+import gc
+import random
+import unittest
+from cbits import BitVector, BitMatrix
+
+
+def random_matrix(rows, cols, rng):
+    cells = [[rng.random() < 0.3 for _ in range(cols)] for _ in range(rows)]
+    m = BitMatrix(rows, cols)
+    for r in range(rows):
+        for c in range(cols):
+            if cells[r][c]:
+                m[r, c] = True
+    return m, cells
+
+
+class TestBitMatrix(unittest.TestCase):
+    def setUp(self):
+        self.m, self.cells = random_matrix(70, 131, random.Random(5))
+
+    def test_shape_and_access(self):
+        self.assertEqual(self.m.shape, (70, 131))
+        self.assertEqual(len(self.m), 70)
+        for r in range(70):
+            for c in range(0, 131, 7):
+                self.assertEqual(self.m[r, c], self.cells[r][c])
+        self.assertEqual(self.m[-1, -1], self.cells[-1][-1])
+        with self.assertRaises(IndexError):
+            self.m[70, 0]
+        with self.assertRaises(IndexError):
+            self.m[0, 131]
+        self.m[3, 4] = 0
+        self.assertFalse(self.m[3, 4])
+
+    def test_invalid_init(self):
+        with self.assertRaises(ValueError):
+            BitMatrix(-1, 3)
+
+    def test_row_view_shares_memory(self):
+        row = self.m[5]
+        self.assertIsInstance(row, BitVector)
+        self.assertEqual(list(row), self.cells[5])
+        row.set_range(0, 131)
+        self.assertTrue(self.m[5, 100])
+        self.m[5, 0] = False
+        self.assertEqual(row.rank(130), 130)
+        with self.assertRaises(TypeError):
+            hash(row)
+        self.assertEqual(type(row.copy()), BitVector)
+        self.assertEqual(type(row + row), BitVector)
+
+    def test_row_view_keeps_matrix_alive(self):
+        m = BitMatrix(2, 10)
+        m[1, 3] = True
+        row = m.row(1)
+        del m
+        gc.collect()
+        self.assertTrue(row[3])
+
+    def test_reinit_with_views(self):
+        row = self.m[0]
+        with self.assertRaises(BufferError):
+            self.m.__init__(2, 2)
+        with self.assertRaises(TypeError):
+            BitVector.__init__(row, 5)
+        del row
+        self.m.__init__(2, 2)
+        self.assertEqual(self.m.shape, (2, 2))
+
+    def test_iteration(self):
+        rows = [list(r) for r in self.m]
+        self.assertEqual(rows, self.cells)
+
+    def test_set_row(self):
+        bv = BitVector(131)
+        bv.set(9)
+        self.m[2] = bv
+        self.assertEqual(list(self.m[2]), [i == 9 for i in range(131)])
+        self.m.set_row(3, self.m[2])
+        self.assertTrue(self.m[3, 9])
+        with self.assertRaises(ValueError):
+            self.m[0] = BitVector(5)
+        with self.assertRaises(TypeError):
+            self.m[0] = 1
+
+    def test_row_op(self):
+        expected = [a ^ b for a, b in zip(self.cells[1], self.cells[2])]
+        self.m.row_op(1, 2, "xor")
+        self.assertEqual(list(self.m[1]), expected)
+        with self.assertRaises(ValueError):
+            self.m.row_op(1, 2, "nand")
+
+    def test_column_and_transpose(self):
+        for c in (0, 63, 64, 130):
+            self.assertEqual(
+                list(self.m.column(c)), [row[c] for row in self.cells]
+            )
+        t = self.m.transpose()
+        self.assertEqual(t.shape, (131, 70))
+        for c in range(131):
+            self.assertEqual(list(t[c]), [row[c] for row in self.cells])
+        self.assertEqual(t.transpose(), self.m)
+
+    def test_counts(self):
+        self.assertEqual(self.m.row_counts(), [sum(r) for r in self.cells])
+        self.assertEqual(
+            self.m.column_counts(),
+            [sum(r[c] for r in self.cells) for c in range(131)],
+        )
+
+    def test_reductions(self):
+        cols = list(zip(*self.cells))
+        self.assertEqual(list(self.m.reduce_rows("or")), [any(c) for c in cols])
+        self.assertEqual(
+            list(self.m.reduce_rows("and")), [all(c) for c in cols]
+        )
+        self.assertEqual(
+            list(self.m.reduce_rows("xor")), [sum(c) % 2 == 1 for c in cols]
+        )
+        self.assertEqual(
+            list(self.m.reduce_columns("or")), [any(r) for r in self.cells]
+        )
+        self.assertEqual(
+            list(self.m.reduce_columns("xor")),
+            [sum(r) % 2 == 1 for r in self.cells],
+        )
+
+    def test_from_rows_copy_eq(self):
+        rows = [self.m[r].copy() for r in range(70)]
+        m2 = BitMatrix.from_rows(rows)
+        self.assertEqual(m2, self.m)
+        c = self.m.copy()
+        c[0, 0] = not c[0, 0]
+        self.assertNotEqual(c, self.m)
+        with self.assertRaises(ValueError):
+            BitMatrix.from_rows([BitVector(3), BitVector(4)])
+        self.assertEqual(BitMatrix.from_rows([]).shape, (0, 0))
+        with self.assertRaises(TypeError):
+            hash(self.m)
+
+    def test_sizeof(self):
+        self.assertGreaterEqual(self.m.__sizeof__(), 70 * 3 * 8)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,109 @@
+import random
+import unittest
+from cbits import BitVector, BitVectorCollection
+
+
+def make_bv(value, width):
+    bv = BitVector(width)
+    for i in range(width):
+        if value >> i & 1:
+            bv[i] = True
+    return bv
+
+
+class TestBitVectorCollection(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(11)
+        self.width = 300
+        self.values = [rng.getrandbits(self.width) for _ in range(400)]
+        self.query_value = rng.getrandbits(self.width)
+        # Near duplicates of the query, including a tie.
+        self.values[17] = self.query_value ^ 0b101
+        self.values[250] = self.query_value ^ 0b11
+        self.values[390] = self.query_value ^ (1 << 299)
+        self.coll = BitVectorCollection(
+            self.width, [make_bv(v, self.width) for v in self.values]
+        )
+        self.query = make_bv(self.query_value, self.width)
+        self.expected = [
+            bin(v ^ self.query_value).count("1") for v in self.values
+        ]
+
+    def test_basics(self):
+        self.assertEqual(len(self.coll), 400)
+        self.assertEqual(self.coll.width, 300)
+        self.assertEqual(self.coll[17], make_bv(self.values[17], 300))
+        self.assertEqual(self.coll[-1], make_bv(self.values[-1], 300))
+        with self.assertRaises(IndexError):
+            self.coll[400]
+        self.assertEqual(len(list(self.coll)), 400)
+        self.assertGreater(self.coll.__sizeof__(), 400 * 300 // 8)
+        with self.assertRaises(TypeError):
+            hash(self.coll)
+
+    def test_append_and_extend(self):
+        coll = BitVectorCollection(10)
+        coll.append(make_bv(5, 10))
+        coll.extend([make_bv(1, 10), make_bv(2, 10)])
+        self.assertEqual(len(coll), 3)
+        with self.assertRaises(ValueError):
+            coll.append(BitVector(11))
+        with self.assertRaises(TypeError):
+            coll.append(5)
+        with self.assertRaises(ValueError):
+            BitVectorCollection(-1)
+        self.assertEqual(coll.distances(make_bv(0, 10)), [2, 1, 1])
+
+    def test_distances(self):
+        self.assertEqual(self.coll.distances(self.query), self.expected)
+        self.assertEqual(
+            self.coll.distances(self.query, threads=4), self.expected
+        )
+        with self.assertRaises(ValueError):
+            self.coll.distances(BitVector(10))
+
+    def test_knn(self):
+        ranked = sorted(range(400), key=lambda i: (self.expected[i], i))
+        want = [(i, self.expected[i]) for i in ranked[:10]]
+        self.assertEqual(self.coll.knn(self.query, 10), want)
+        self.assertEqual(self.coll.knn(self.query, 10, threads=0), want)
+        self.assertEqual(
+            self.coll.knn(self.query, 3), [(390, 1), (17, 2), (250, 2)]
+        )
+        self.assertEqual(len(self.coll.knn(self.query, 1000)), 400)
+        self.assertEqual(self.coll.knn(self.query, 0), [])
+        with self.assertRaises(ValueError):
+            self.coll.knn(self.query, -1)
+
+    def test_within_radius(self):
+        radius = 140
+        want = [
+            (i, d) for i, d in enumerate(self.expected) if d <= radius
+        ]
+        self.assertEqual(self.coll.within_radius(self.query, radius), want)
+        self.assertEqual(
+            self.coll.within_radius(self.query, 2),
+            [(17, 2), (250, 2), (390, 1)],
+        )
+
+    def test_pairwise(self):
+        small = BitVectorCollection(
+            self.width, [make_bv(v, self.width) for v in self.values[:30]]
+        )
+        matrix = small.pairwise(self.coll, threads=2)
+        self.assertEqual(len(matrix), 30)
+        for i in range(30):
+            self.assertEqual(
+                matrix[i],
+                [bin(self.values[i] ^ v).count("1") for v in self.values],
+            )
+        square = small.pairwise()
+        self.assertEqual([square[i][i] for i in range(30)], [0] * 30)
+        with self.assertRaises(ValueError):
+            small.pairwise(BitVectorCollection(3))
+        with self.assertRaises(TypeError):
+            small.pairwise(self.query)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,132 @@
+import array
+import pickle
+import unittest
+from cbits import BitVector, BloomFilter, BlockedBloomFilter
+
+
+class BloomFilterMixin:
+    cls = None
+
+    def test_add_and_contains(self):
+        f = self.cls(1000)
+        keys = [1, -5, 2**64 - 1, "text", b"bytes", bytearray(b"mutable")]
+        for key in keys:
+            f.add(key)
+        for key in keys:
+            self.assertIn(key, f)
+        self.assertNotIn("missing", f)
+        self.assertGreater(f.bits, 0)
+        self.assertGreater(f.hashes, 0)
+        self.assertEqual(f.hash, "xxh64")
+        self.assertEqual(f.seed, 0)
+        with self.assertRaises(TypeError):
+            f.add(1.5)
+        with self.assertRaises(OverflowError):
+            f.add(2**64)
+        with self.assertRaises(TypeError):
+            1.5 in f
+
+    def test_false_positive_rate(self):
+        f = self.cls(5000, 0.01)
+        f.add_many(range(5000))
+        found = f.contains_many(range(5000, 25000))
+        self.assertIsInstance(found, BitVector)
+        self.assertEqual(len(found), 20000)
+        self.assertLess(found.count(), 20000 * 0.03)
+        self.assertEqual(f.contains_many(range(5000)).count(), 5000)
+        self.assertAlmostEqual(f.estimate_count(), 5000, delta=500)
+
+    def test_buffers(self):
+        f = self.cls(1000, hash="fnv1a", seed=3)
+        self.assertEqual(f.hash, "fnv1a")
+        self.assertEqual(f.seed, 3)
+        f.add_many(array.array("q", [10, 20, 30]))
+        f.add_many(array.array("H", [40, 50]))
+        for key in (10, 20, 30, 40, 50):
+            self.assertIn(key, f)
+        packed = b"abcdefgh" + b"ijklmnop"
+        f.add_many(packed, width=8)
+        self.assertIn(b"abcdefgh", f)
+        self.assertIn(b"ijklmnop", f)
+        found = f.contains_many(packed + b"zzzzzzzz", width=8)
+        self.assertTrue(found[0] and found[1])
+        with self.assertRaises(ValueError):
+            f.add_many(b"abc", width=2)
+        with self.assertRaises(ValueError):
+            f.add_many(b"abcd", width=0)
+        mixed = f.contains_many([10, b"abcdefgh", "nope"])
+        self.assertTrue(mixed[0] and mixed[1])
+        with self.assertRaises(TypeError):
+            f.add_many([1, 2.0])
+
+    def test_set_operations(self):
+        a = self.cls(1000)
+        b = self.cls(1000)
+        a.add_many(range(100))
+        b.add_many(range(100, 200))
+        union = a | b
+        self.assertIsInstance(union, self.cls)
+        self.assertEqual(union.contains_many(range(200)).count(), 200)
+        both = a & b
+        self.assertLessEqual(both.to_bitvector().count(),
+                             a.to_bitvector().count())
+        c = a.copy()
+        c |= b
+        self.assertEqual(c, union)
+        c &= a
+        self.assertEqual(c, a)
+        with self.assertRaises(ValueError):
+            a | self.cls(2000)
+        with self.assertRaises(ValueError):
+            a | self.cls(1000, seed=1)
+        with self.assertRaises(TypeError):
+            a | 1
+
+    def test_serialization(self):
+        f = self.cls(500, 0.001, hash="fnv1a", seed=42)
+        f.add_many(["a", "b", "c"])
+        data = f.to_bytes()
+        g = self.cls.from_bytes(data)
+        self.assertEqual(g, f)
+        self.assertEqual(g.seed, 42)
+        self.assertIn("b", g)
+        self.assertEqual(pickle.loads(pickle.dumps(f)), f)
+        with self.assertRaises(ValueError):
+            self.cls.from_bytes(data[:-1])
+        self.assertGreater(f.__sizeof__(), f.bits // 8)
+        self.assertEqual(len(f.to_bitvector()), f.bits)
+
+    def test_invalid_arguments(self):
+        with self.assertRaises(ValueError):
+            self.cls(100, 0.0)
+        with self.assertRaises(ValueError):
+            self.cls(100, 1.5)
+        with self.assertRaises(ValueError):
+            self.cls(100, hash="md5")
+        with self.assertRaises(ValueError):
+            self.cls(-1)
+        with self.assertRaises(TypeError):
+            hash(self.cls(10))
+
+
+class TestBloomFilter(BloomFilterMixin, unittest.TestCase):
+    cls = BloomFilter
+
+    def test_wrong_layout(self):
+        data = BlockedBloomFilter(100).to_bytes()
+        with self.assertRaises(ValueError):
+            BloomFilter.from_bytes(data)
+
+
+class TestBlockedBloomFilter(BloomFilterMixin, unittest.TestCase):
+    cls = BlockedBloomFilter
+
+    def test_block_size(self):
+        self.assertEqual(BlockedBloomFilter(1000).bits % 512, 0)
+        data = BloomFilter(100).to_bytes()
+        with self.assertRaises(ValueError):
+            BlockedBloomFilter.from_bytes(data)
+
+
+if __name__ == "__main__":
+    unittest.main()
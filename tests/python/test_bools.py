@@ -0,0 +1,82 @@
+import array
+import random
+import threading
+import unittest
+from cbits import BitVector
+
+
+class TestBools(unittest.TestCase):
+    def test_from_bools(self):
+        rng = random.Random(5)
+        for n in (0, 1, 63, 64, 65, 1000, 4099):
+            data = bytes(rng.choice((0, 0, 1, 2, 0x80, 255))
+                         for _ in range(n))
+            bv = BitVector.from_bools(data)
+            self.assertEqual(len(bv), n)
+            self.assertEqual([bv[i] for i in range(n)],
+                             [b != 0 for b in data])
+
+    def test_to_bools(self):
+        bv = BitVector(130)
+        for i in (0, 5, 64, 129):
+            bv.set(i)
+        out = bv.to_bools()
+        self.assertIsInstance(out, bytearray)
+        self.assertEqual(len(out), 130)
+        self.assertEqual([i for i, b in enumerate(out) if b], [0, 5, 64, 129])
+        self.assertEqual(set(out), {0, 1})
+        self.assertEqual(BitVector.from_bools(out), bv)
+        self.assertEqual(BitVector(0).to_bools(), bytearray())
+
+    def test_out_buffer(self):
+        bv = BitVector.from_bools(b"\x01\x00\x01")
+        out = bytearray(b"\xff\xff\xff")
+        self.assertIs(bv.to_bools(out=out), out)
+        self.assertEqual(out, bytearray(b"\x01\x00\x01"))
+        view = memoryview(bytearray(3))
+        bv.to_bools(view)
+        self.assertEqual(view.tobytes(), b"\x01\x00\x01")
+        with self.assertRaises(ValueError):
+            bv.to_bools(bytearray(4))
+        with self.assertRaises(BufferError):
+            bv.to_bools(b"\x00\x00\x00")
+
+    def test_buffer_types(self):
+        self.assertEqual(
+            BitVector.from_bools(array.array("B", [0, 3, 0])).to_bools(),
+            bytearray(b"\x00\x01\x00"))
+        self.assertEqual(
+            BitVector.from_bools(memoryview(b"\x00\x01")).to_bools(),
+            bytearray(b"\x00\x01"))
+        with self.assertRaises(ValueError):
+            BitVector.from_bools(array.array("i", [1, 0]))
+        with self.assertRaises(ValueError):
+            BitVector(2).to_bools(array.array("i", [0, 0]))
+        with self.assertRaises(TypeError):
+            BitVector.from_bools([True, False])
+
+    def test_reinit_during_export(self):
+        n = 1 << 20
+        bv = BitVector(n)
+        bv.set_range(0, n)
+        done = threading.Event()
+
+        def reinit():
+            while not done.is_set():
+                bv.__init__(n)
+                bv.set_range(0, n)
+
+        worker = threading.Thread(target=reinit)
+        worker.start()
+        try:
+            out = bytearray(n)
+            for _ in range(200):
+                bv.to_bools(out=out)
+                self.assertIn(out.count(1), (0, n))
+        finally:
+            done.set()
+            worker.join()
+
+
+if __name__ == "__main__":
+    unittest.main()
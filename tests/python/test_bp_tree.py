@@ -0,0 +1,100 @@
+import random
+import sys
+import unittest
+from cbits import BitVector, BPTree
+
+
+def random_tree(n_nodes, rng):
+    """Return the parentheses string and parent list of a random tree."""
+    parens = []
+    parents = {}
+    stack = []
+    opened = 0
+    while opened < n_nodes or stack:
+        if opened < n_nodes and (not stack or rng.random() < 0.55):
+            parents[len(parens)] = stack[-1] if stack else None
+            stack.append(len(parens))
+            parens.append("(")
+            opened += 1
+        else:
+            stack.pop()
+            parens.append(")")
+    return "".join(parens), parents
+
+
+class TestBPTree(unittest.TestCase):
+    def setUp(self):
+        self.parens, self.parents = random_tree(3000, random.Random(99))
+        self.bv = BitVector(len(self.parens))
+        for i, c in enumerate(self.parens):
+            if c == "(":
+                self.bv.set(i)
+        self.tree = BPTree(self.bv)
+        self.match = {}
+        stack = []
+        for i, c in enumerate(self.parens):
+            if c == "(":
+                stack.append(i)
+            else:
+                j = stack.pop()
+                self.match[i] = j
+                self.match[j] = i
+
+    def test_primitives(self):
+        self.assertEqual(len(self.parens), len(self.tree))
+        excess = 0
+        for i, c in enumerate(self.parens):
+            excess += 1 if c == "(" else -1
+            if i % 17 == 0:
+                self.assertEqual(excess, self.tree.excess(i))
+            if c == "(":
+                self.assertEqual(self.match[i], self.tree.find_close(i))
+                self.assertEqual(self.parents[i], self.tree.enclose(i))
+            else:
+                self.assertEqual(self.match[i], self.tree.find_open(i))
+        self.assertEqual(0, self.tree.excess(-1))
+
+    def test_navigation(self):
+        children = {}
+        for v, p in self.parents.items():
+            children.setdefault(p, []).append(v)
+        for v in list(self.parents)[::7]:
+            self.assertEqual(self.parents[v], self.tree.parent(v))
+            kids = children.get(v, [])
+            self.assertEqual(kids[0] if kids else None,
+                             self.tree.first_child(v))
+            siblings = children[self.parents[v]]
+            idx = siblings.index(v)
+            nxt = siblings[idx + 1] if idx + 1 < len(siblings) else None
+            self.assertEqual(nxt, self.tree.next_sibling(v))
+            self.assertEqual((self.match[v] - v + 1) // 2,
+                             self.tree.subtree_size(v))
+
+    def test_errors_and_unbalanced(self):
+        close = self.parens.index(")")
+        with self.assertRaises(ValueError):
+            self.tree.find_close(close)
+        with self.assertRaises(ValueError):
+            self.tree.find_open(0)
+        with self.assertRaises(IndexError):
+            self.tree.parent(len(self.parens))
+        with self.assertRaises(TypeError):
+            BPTree("(()")
+        bv = BitVector(3)
+        bv.set(0)
+        bv.set(1)
+        tree = BPTree(bv)  # "(()"
+        self.assertIsNone(tree.find_close(0))
+        self.assertEqual(2, tree.find_close(1))
+        with self.assertRaises(ValueError):
+            tree.subtree_size(0)
+
+    def test_snapshot_and_sizeof(self):
+        self.bv.clear(0)
+        self.assertEqual(self.match[0], self.tree.find_close(0))
+        self.assertGreater(sys.getsizeof(self.tree), len(self.parens) // 8)
+        self.assertIn("BPTree", repr(self.tree))
+
+
+if __name__ == "__main__":
+    unittest.main()
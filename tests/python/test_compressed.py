@@ -0,0 +1,86 @@
+import sys
+import unittest
+from cbits import BitVector, CompressedBitVector
+
+
+class TestCompressedBitVector(unittest.TestCase):
+    def setUp(self):
+        self.n = 300000
+        self.cbv = CompressedBitVector(self.n)
+
+    def test_init_and_len(self):
+        self.assertEqual(self.n, len(self.cbv))
+        self.assertEqual(self.n, self.cbv.bits)
+        self.assertEqual(0, self.cbv.count())
+        self.assertFalse(self.cbv)
+        with self.assertRaises(ValueError):
+            CompressedBitVector(-1)
+
+    def test_get_set_clear_flip(self):
+        self.cbv.set(5)
+        self.cbv.set(-1)
+        self.assertTrue(self.cbv.get(5))
+        self.assertTrue(self.cbv[self.n - 1])
+        self.cbv.clear(5)
+        self.assertFalse(self.cbv.get(5))
+        self.cbv.flip(70000)
+        self.assertTrue(self.cbv[70000])
+        self.cbv[70000] = False
+        self.assertFalse(self.cbv[70000])
+        with self.assertRaises(IndexError):
+            self.cbv.set(self.n)
+
+    def test_rank_select(self):
+        positions = [3, 100, 65535, 65536, 200000]
+        for p in positions:
+            self.cbv.set(p)
+        for k, p in enumerate(positions):
+            self.assertEqual(p, self.cbv.select(k))
+            self.assertEqual(k + 1, self.cbv.rank(p))
+        self.assertEqual(0, self.cbv.rank(2))
+        with self.assertRaises(IndexError):
+            self.cbv.select(len(positions))
+
+    def test_roundtrip_bitvector(self):
+        bv = BitVector(self.n)
+        bv.set_range(1000, 70000)
+        for i in range(0, self.n, 101):
+            bv.set(i)
+        cbv = CompressedBitVector.from_bitvector(bv)
+        self.assertEqual(bv.rank(self.n - 1), cbv.count())
+        self.assertEqual(bv, cbv.to_bitvector())
+        arrays, bitmaps, runs = cbv.containers
+        self.assertEqual(5, arrays + bitmaps + runs)
+
+    def test_bitwise_ops(self):
+        a = CompressedBitVector(self.n)
+        b = CompressedBitVector(self.n)
+        for i in range(0, self.n, 3):
+            a.set(i)
+        for i in range(0, self.n, 5):
+            b.set(i)
+        ba, bb = a.to_bitvector(), b.to_bitvector()
+        self.assertEqual(ba & bb, (a & b).to_bitvector())
+        self.assertEqual(ba | bb, (a | b).to_bitvector())
+        self.assertEqual(ba ^ bb, (a ^ b).to_bitvector())
+        self.assertEqual(ba ^ (ba & bb), (a - b).to_bitvector())
+        with self.assertRaises(ValueError):
+            _ = a & CompressedBitVector(10)
+        with self.assertRaises(TypeError):
+            _ = a & 1
+
+    def test_copy_equality_and_sizeof(self):
+        self.cbv.set(42)
+        c = self.cbv.copy()
+        self.assertEqual(self.cbv, c)
+        c.clear(42)
+        self.assertNotEqual(self.cbv, c)
+        dense = BitVector(self.n)
+        dense.set_range(0, self.n)
+        compressed = CompressedBitVector.from_bitvector(dense)
+        compressed.optimize()
+        self.assertLess(sys.getsizeof(compressed), self.n // 8)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -52,6 +52,20 @@ class TestContain(unittest.TestCase):
             b in a,
             msg="Sub-vector across 64-bit boundary not found"
         )
+    def test_word_aligned_offsets(self):
+        # Ones in bits 0-31 and 96-127: never 64 in a row, but OR-ing the
+        # words at offset 0 would give a full word.
+        a = BitVector(128)
+        a.set_range(0, 32)
+        a.set_range(96, 32)
+        for n in (64, 100):
+            b = BitVector(n)
+            b.set_range(0, n)
+            with self.subTest(n=n):
+                self.assertFalse(b in a)
+        b = BitVector(32)
+        b.set_range(0, 32)
+        self.assertTrue(b in a)
 
 if __name__ == '__main__':
     unittest.main()
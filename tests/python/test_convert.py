@@ -0,0 +1,97 @@
+import random
+import unittest
+from cbits import BitVector
+
+
+class TestIntConversion(unittest.TestCase):
+    def test_round_trip(self):
+        rng = random.Random(3)
+        for n in (1, 7, 8, 63, 64, 65, 127, 1000):
+            value = rng.getrandbits(n)
+            bv = BitVector.from_int(value, n)
+            self.assertEqual(len(bv), n)
+            self.assertEqual(bv.to_int(), value)
+            self.assertEqual([bv[i] for i in range(n)],
+                             [bool(value >> i & 1) for i in range(n)])
+
+    def test_default_length(self):
+        self.assertEqual(len(BitVector.from_int(0b1011)), 4)
+        self.assertEqual(len(BitVector.from_int(0)), 0)
+        self.assertEqual(BitVector.from_int(1 << 200).to_int(), 1 << 200)
+        self.assertEqual(BitVector.from_int(True).to_int(), 1)
+
+    def test_zero_and_padding(self):
+        self.assertEqual(BitVector(0).to_int(), 0)
+        self.assertEqual(BitVector.from_int(0, 100).to_int(), 0)
+        self.assertEqual(BitVector.from_int(5, 3).to_int(), 5)
+
+    def test_overflow(self):
+        with self.assertRaises(OverflowError):
+            BitVector.from_int(8, 3)
+        with self.assertRaises(OverflowError):
+            BitVector.from_int(1 << 64, 64)
+        with self.assertRaises(OverflowError):
+            BitVector.from_int(1, 0)
+        with self.assertRaises(OverflowError):
+            BitVector.from_int(-1, 8)
+        with self.assertRaises(ValueError):
+            BitVector.from_int(1, -1)
+        with self.assertRaises(TypeError):
+            BitVector.from_int(1.0, 8)
+
+
+class TestBytesConversion(unittest.TestCase):
+    def test_little_matches_int(self):
+        data = bytes(range(1, 40))
+        bv = BitVector.from_bytes(data)
+        self.assertEqual(len(bv), 8 * len(data))
+        self.assertEqual(bv.to_int(), int.from_bytes(data, "little"))
+        self.assertEqual(bv.to_bytes(), data)
+
+    def test_big_bitorder(self):
+        bv = BitVector.from_bytes(b"\x80\x01", bitorder="big")
+        self.assertTrue(bv[0])
+        self.assertTrue(bv[15])
+        self.assertEqual(bv.to_bytes(), b"\x01\x80")
+        self.assertEqual(bv.to_bytes(bitorder="big"), b"\x80\x01")
+
+    def test_big_matches_msb_first_packing(self):
+        bits = [bool(i * 7 % 5 == 1) for i in range(83)]
+        bv = BitVector(83)
+        for i, b in enumerate(bits):
+            if b:
+                bv.set(i)
+        padded = bits + [False] * 5
+        expected = bytes(
+            sum(padded[8 * k + j] << (7 - j) for j in range(8))
+            for k in range(11))
+        self.assertEqual(bv.to_bytes("big"), expected)
+        back = BitVector.from_bytes(expected, "big", n_bits=83)
+        self.assertEqual(back, bv)
+
+    def test_n_bits_round_trip(self):
+        bv = BitVector.from_int(0b1011001, 7)
+        raw = bv.to_bytes()
+        self.assertEqual(raw, b"\x59")
+        self.assertEqual(BitVector.from_bytes(raw, n_bits=7), bv)
+        with self.assertRaises(ValueError):
+            BitVector.from_bytes(raw, n_bits=9)
+
+    def test_buffer_protocol(self):
+        data = bytearray(b"\xff\x00\x0f")
+        self.assertEqual(BitVector.from_bytes(memoryview(data)).to_bytes(),
+                         bytes(data))
+        self.assertEqual(len(BitVector.from_bytes(b"")), 0)
+        self.assertEqual(BitVector(0).to_bytes(), b"")
+
+    def test_bad_bitorder(self):
+        with self.assertRaises(ValueError):
+            BitVector.from_bytes(b"\x00", bitorder="middle")
+        with self.assertRaises(ValueError):
+            BitVector(8).to_bytes("middle")
+        with self.assertRaises(TypeError):
+            BitVector.from_bytes("text")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,45 @@
+import random
+import unittest
+from cbits import BitVector
+
+
+class TestCount(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(5)
+        self.bits = [rng.random() < 0.4 for _ in range(3000)]
+        self.bv = BitVector(3000)
+        for i, bit in enumerate(self.bits):
+            if bit:
+                self.bv.set(i)
+
+    def test_count_all(self):
+        self.assertEqual(self.bv.count(), sum(self.bits))
+        self.assertEqual(BitVector(0).count(), 0)
+        self.bv.set_range(0, 3000)
+        self.assertEqual(self.bv.count(), 3000)
+
+    def test_count_range(self):
+        for start, length in [(0, 0), (3, 1), (5, 60), (63, 2), (64, 64),
+                              (100, 2900), (0, 3000), (2999, 1)]:
+            self.assertEqual(
+                self.bv.count(start, length),
+                sum(self.bits[start:start + length]),
+            )
+
+    def test_count_matches_rank(self):
+        self.assertEqual(self.bv.count(), self.bv.rank(2999))
+        self.assertEqual(self.bv.count(0, 1234), self.bv.rank(1233))
+
+    def test_count_errors(self):
+        with self.assertRaises(IndexError):
+            self.bv.count(2990, 20)
+        with self.assertRaises(ValueError):
+            self.bv.count(-1, 5)
+        with self.assertRaises(TypeError):
+            self.bv.count(1)
+        with self.assertRaises(TypeError):
+            self.bv.count(1, 2, 3)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,176 @@
+import os
+import random
+import subprocess
+import sys
+import threading
+import unittest
+import cbits
+from cbits import (
+    BitVector,
+    BitVectorCollection,
+    active_kernels,
+    cpu_features,
+    set_kernel,
+)
+
+OPS = (
+    "popcount_block",
+    "popcount_words",
+    "hamming_batch",
+    "bitwise_words",
+    "pack_bools",
+    "unpack_bools",
+)
+KERNELS = ("fallback", "avx2", "avx512")
+
+
+class TestDispatch(unittest.TestCase):
+    def setUp(self):
+        self.initial = active_kernels()
+
+    def tearDown(self):
+        for op, kernel in self.initial.items():
+            set_kernel(op, kernel)
+
+    def supported(self):
+        kernels = []
+        for kernel in KERNELS:
+            try:
+                set_kernel(None, kernel)
+            except ValueError:
+                continue
+            kernels.append(kernel)
+        set_kernel(None, "auto")
+        return kernels
+
+    def test_cpu_features(self):
+        features = cpu_features()
+        self.assertEqual(
+            set(features),
+            {"popcnt", "avx2", "avx512f", "avx512vpopcntdq", "avx512bw"},
+        )
+        self.assertTrue(all(isinstance(v, bool) for v in features.values()))
+
+    def test_active_kernels(self):
+        kernels = active_kernels()
+        self.assertEqual(set(kernels), set(OPS))
+        self.assertTrue(set(kernels.values()) <= set(KERNELS))
+
+    def test_set_kernel(self):
+        set_kernel(None, "fallback")
+        self.assertEqual(active_kernels(), dict.fromkeys(OPS, "fallback"))
+        set_kernel(None, "auto")
+        auto = active_kernels()
+        set_kernel("hamming_batch", "fallback")
+        self.assertEqual(active_kernels()["hamming_batch"], "fallback")
+        self.assertEqual(
+            active_kernels()["popcount_words"], auto["popcount_words"]
+        )
+        set_kernel(op="hamming_batch", kernel="auto")
+        self.assertEqual(active_kernels(), auto)
+
+    def test_invalid(self):
+        with self.assertRaises(ValueError):
+            set_kernel("popcount", "fallback")
+        with self.assertRaises(ValueError):
+            set_kernel(None, "sse")
+        features = cpu_features()
+        if not (features["avx512vpopcntdq"] and features["avx512bw"]):
+            with self.assertRaises(ValueError):
+                set_kernel(None, "avx512")
+        if features["avx512f"] and not features["avx512vpopcntdq"]:
+            # The bitwise kernel needs AVX-512F only, the popcounts more.
+            set_kernel("bitwise_words", "avx512")
+            with self.assertRaises(ValueError):
+                set_kernel("popcount_words", "avx512")
+            set_kernel(None, "auto")
+        with self.assertRaises(TypeError):
+            set_kernel(None, None)
+
+    def test_results_match(self):
+        rng = random.Random(43)
+        n = 9000
+        vectors = []
+        for _ in range(4):
+            bv = BitVector(n)
+            for i in range(n):
+                if rng.random() < 0.4:
+                    bv[i] = True
+            vectors.append(bv)
+        query = vectors.pop()
+        coll = BitVectorCollection(n, vectors)
+        expected = None
+        for kernel in self.supported():
+            set_kernel(None, kernel)
+            got = (
+                query.count(),
+                query.rank(n - 1),
+                coll.distances(query),
+                [list(query & v) for v in vectors],
+                list(~(query ^ vectors[0])),
+                query.to_bools(),
+                BitVector.from_bools(query.to_bools()) == query,
+            )
+            if expected is None:
+                expected = got
+            self.assertEqual(got, expected, kernel)
+
+    def test_switch_while_running(self):
+        kernels = self.supported()
+        rng = random.Random(44)
+        n = 4096
+        vectors = [
+            BitVector.from_int(rng.getrandbits(n), n) for _ in range(64)
+        ]
+        query = vectors.pop()
+        coll = BitVectorCollection(n, vectors)
+        expected = coll.distances(query)
+        done = threading.Event()
+        results = []
+
+        def search():
+            while not done.is_set():
+                results.append(coll.distances(query))
+
+        worker = threading.Thread(target=search)
+        worker.start()
+        try:
+            for i in range(2000):
+                set_kernel(None, kernels[i % len(kernels)])
+        finally:
+            done.set()
+            worker.join()
+        self.assertTrue(results)
+        self.assertTrue(all(r == expected for r in results))
+
+    def test_force_kernel_env(self):
+        path = os.path.dirname(os.path.dirname(cbits.__file__))
+        code = (
+            "import cbits; "
+            "print(sorted(set(cbits.active_kernels().values())))"
+        )
+        env = dict(os.environ, CBITS_FORCE_KERNEL="fallback")
+        env["PYTHONPATH"] = os.pathsep.join(
+            [path, env.get("PYTHONPATH", "")]
+        )
+        out = subprocess.run(
+            [sys.executable, "-c", code],
+            env=env,
+            capture_output=True,
+            text=True,
+            check=True,
+        )
+        self.assertEqual(out.stdout.strip(), "['fallback']")
+        env["CBITS_FORCE_KERNEL"] = "bogus"
+        out = subprocess.run(
+            [sys.executable, "-W", "always", "-c", code],
+            env=env,
+            capture_output=True,
+            text=True,
+            check=True,
+        )
+        self.assertIn("CBITS_FORCE_KERNEL", out.stderr)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,58 @@
+import random
+import sys
+import unittest
+from cbits import EliasFano
+
+
+class TestEliasFano(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(1234)
+        x = 0
+        self.values = []
+        for _ in range(5000):
+            x += rng.randrange(0, 200)
+            self.values.append(x)
+        self.ef = EliasFano(self.values)
+
+    def test_len_and_access(self):
+        self.assertEqual(len(self.values), len(self.ef))
+        for i in range(0, len(self.values), 37):
+            self.assertEqual(self.values[i], self.ef[i])
+        self.assertEqual(self.values[-1], self.ef[-1])
+        with self.assertRaises(IndexError):
+            _ = self.ef[len(self.values)]
+
+    def test_iteration(self):
+        self.assertEqual(self.values, list(self.ef))
+        self.assertEqual([], list(EliasFano([])))
+
+    def test_next_geq_and_contains(self):
+        for x in (0, 1, 57, 1000, self.values[2500], self.values[-1]):
+            expected = next((v for v in self.values if v >= x), None)
+            self.assertEqual(expected, self.ef.next_geq(x))
+        self.assertIsNone(self.ef.next_geq(self.values[-1] + 1))
+        self.assertIsNone(self.ef.next_geq(1 << 70))
+        self.assertEqual(self.values[0], self.ef.next_geq(-5))
+        present = set(self.values)
+        for x in range(0, 3000):
+            self.assertEqual(x in present, x in self.ef)
+        self.assertNotIn(-1, self.ef)
+        self.assertNotIn("a", self.ef)
+
+    def test_validation(self):
+        with self.assertRaises(ValueError):
+            EliasFano([3, 2])
+        with self.assertRaises(OverflowError):
+            EliasFano([-1])
+        with self.assertRaises(TypeError):
+            EliasFano(5)
+        big = EliasFano([0, (1 << 64) - 1])
+        self.assertEqual([0, (1 << 64) - 1], list(big))
+
+    def test_size(self):
+        self.assertLess(sys.getsizeof(self.ef), self.values[-1] // 8)
+        self.assertGreater(self.ef.low_bits, 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,75 @@
+import sys
+import unittest
+from cbits import BitVector, EWAHBitVector
+
+
+class TestEWAHBitVector(unittest.TestCase):
+    def setUp(self):
+        self.n = 200003
+        self.bv = BitVector(self.n)
+        self.bv.set_range(1000, 50000)
+        for i in range(100000, self.n, 7):
+            self.bv.set(i)
+
+    def test_init_and_len(self):
+        e = EWAHBitVector(self.n)
+        self.assertEqual(self.n, len(e))
+        self.assertEqual(self.n, e.bits)
+        self.assertEqual(0, e.count())
+        self.assertFalse(e)
+        self.assertEqual(1, e.compressed_words)
+        with self.assertRaises(ValueError):
+            EWAHBitVector(-1)
+
+    def test_roundtrip(self):
+        e = EWAHBitVector.from_bitvector(self.bv)
+        self.assertTrue(e)
+        self.assertEqual(self.bv.rank(self.n - 1), e.count())
+        self.assertEqual(self.bv, e.to_bitvector())
+        for i in (0, 999, 1000, 50999, 51000, 100000, 100001, self.n - 1):
+            self.assertEqual(self.bv[i], e[i])
+            self.assertEqual(self.bv[i], e.get(i))
+        self.assertEqual(self.bv[-1], e[-1])
+        with self.assertRaises(IndexError):
+            e.get(self.n)
+        with self.assertRaises(TypeError):
+            EWAHBitVector.from_bitvector(e)
+
+    def test_compression(self):
+        bv = BitVector(1 << 20)
+        bv.set_range(4096, 300000)
+        e = EWAHBitVector.from_bitvector(bv)
+        self.assertLess(e.compressed_words, 8)
+        self.assertLess(sys.getsizeof(e), (1 << 20) // 64)
+
+    def test_bitwise_ops(self):
+        other = BitVector(self.n)
+        other.set_range(30000, 120000)
+        for i in range(0, self.n, 3):
+            other.set(i)
+        a = EWAHBitVector.from_bitvector(self.bv)
+        b = EWAHBitVector.from_bitvector(other)
+        self.assertEqual(self.bv & other, (a & b).to_bitvector())
+        self.assertEqual(self.bv | other, (a | b).to_bitvector())
+        self.assertEqual(self.bv ^ other, (a ^ b).to_bitvector())
+        self.assertEqual(
+            self.bv ^ (self.bv & other), (a - b).to_bitvector()
+        )
+        self.assertEqual(EWAHBitVector.from_bitvector(self.bv & other), a & b)
+        with self.assertRaises(ValueError):
+            _ = a & EWAHBitVector(10)
+        with self.assertRaises(TypeError):
+            _ = a | self.bv
+
+    def test_copy_and_equality(self):
+        a = EWAHBitVector.from_bitvector(self.bv)
+        c = a.copy()
+        self.assertEqual(a, c)
+        self.assertIsNot(a, c)
+        self.assertNotEqual(a, EWAHBitVector(self.n))
+        with self.assertRaises(TypeError):
+            hash(a)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,104 @@
+import random
+import unittest
+from cbits import BitMatrix
+
+
+def random_rows(rows, cols, rng):
+    return [rng.getrandbits(cols) if cols else 0 for _ in range(rows)]
+
+
+def to_matrix(ints, cols):
+    m = BitMatrix(len(ints), cols)
+    for r, value in enumerate(ints):
+        for c in range(cols):
+            if value >> c & 1:
+                m[r, c] = True
+    return m
+
+
+def to_ints(m):
+    return [sum(1 << c for c, bit in enumerate(row) if bit) for row in m]
+
+
+def int_rank(ints):
+    """Rank over GF(2) of rows given as Python integers."""
+    basis = {}
+    for value in ints:
+        while value:
+            top = value.bit_length() - 1
+            if top not in basis:
+                basis[top] = value
+                break
+            value ^= basis[top]
+    return len(basis)
+
+
+class TestGF2(unittest.TestCase):
+    def setUp(self):
+        self.rng = random.Random(17)
+
+    def test_rank(self):
+        for rows, cols in ((1, 1), (40, 40), (100, 70), (70, 100), (0, 5)):
+            ints = random_rows(rows, cols, self.rng)
+            m = to_matrix(ints, cols)
+            self.assertEqual(m.rank(), int_rank(ints))
+            self.assertEqual(to_ints(m), ints)
+
+    def test_rank_deficient(self):
+        ints = random_rows(30, 90, self.rng)
+        ints += [a ^ b for a, b in zip(ints, ints[1:])]
+        m = to_matrix(ints, 90)
+        self.assertEqual(m.rank(), 30)
+
+    def test_echelon_in_place(self):
+        ints = random_rows(60, 80, self.rng)
+        m = to_matrix(ints, 80)
+        rank = m.echelon()
+        self.assertEqual(rank, int_rank(ints))
+        rows = to_ints(m)
+        self.assertTrue(all(v == 0 for v in rows[rank:]))
+        leads = [(v & -v).bit_length() for v in rows[:rank]]
+        self.assertEqual(leads, sorted(set(leads)))
+        self.assertEqual(int_rank(rows + ints), rank)
+
+    def test_reduced_echelon(self):
+        m = to_matrix(random_rows(50, 50, self.rng), 50)
+        row = m[0]
+        rank = m.echelon(reduced=True)
+        rows = to_ints(m)
+        for i in range(rank):
+            lead = (rows[i] & -rows[i]).bit_length() - 1
+            column = [r >> lead & 1 for r in rows]
+            self.assertEqual(sum(column), 1)
+        self.assertEqual(list(row), list(m[0]))
+
+    def test_nullspace(self):
+        ints = random_rows(30, 70, self.rng)
+        m = to_matrix(ints, 70)
+        null = m.nullspace()
+        self.assertEqual(null.shape, (70 - m.rank(), 70))
+        self.assertEqual(null.rank(), null.shape[0])
+        product = m @ null.transpose()
+        self.assertEqual(product.row_counts(), [0] * 30)
+
+    def test_matmul(self):
+        a_ints = random_rows(90, 50, self.rng)
+        b_ints = random_rows(50, 40, self.rng)
+        a = to_matrix(a_ints, 50)
+        b = to_matrix(b_ints, 40)
+        expected = []
+        for value in a_ints:
+            acc = 0
+            for k in range(50):
+                if value >> k & 1:
+                    acc ^= b_ints[k]
+            expected.append(acc)
+        self.assertEqual(to_ints(a @ b), expected)
+        with self.assertRaises(ValueError):
+            b @ a.transpose().transpose()
+        with self.assertRaises(TypeError):
+            a @ 3
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,81 @@
+import os
+import subprocess
+import sys
+import unittest
+from cbits import BitVector
+
+
+def make(bits, n):
+    bv = BitVector(n)
+    for i in bits:
+        bv.set(i)
+    return bv
+
+
+class TestHash(unittest.TestCase):
+    def test_equal_vectors_hash_equal(self):
+        a = make([1, 64, 999], 1000)
+        b = make([1, 64, 999], 1000)
+        self.assertEqual(hash(a), hash(b))
+        self.assertEqual(a.fingerprint(), b.fingerprint())
+        self.assertEqual(a.fingerprint(seed=5), b.fingerprint(5))
+
+    def test_dict_key(self):
+        cache = {make([3], 100): "x"}
+        self.assertEqual(cache[make([3], 100)], "x")
+        self.assertNotIn(make([4], 100), cache)
+
+    def test_length_and_seed(self):
+        self.assertNotEqual(BitVector(60).fingerprint(),
+                            BitVector(64).fingerprint())
+        bv = make([7], 200)
+        self.assertNotEqual(bv.fingerprint(), bv.fingerprint(1))
+        self.assertGreaterEqual(bv.fingerprint(), 0)
+        self.assertLess(bv.fingerprint(), 1 << 64)
+
+    def test_mutation_changes_fingerprint(self):
+        bv = make([7], 200)
+        h, f = hash(bv), bv.fingerprint()
+        bv.set(8)
+        self.assertNotEqual(bv.fingerprint(), f)
+        self.assertNotEqual(hash(bv), h)
+
+    def test_stable_across_processes(self):
+        code = ("from cbits import BitVector\n"
+                "bv = BitVector(130)\n"
+                "bv.set(129)\n"
+                "print(bv.fingerprint(3))\n")
+        out = subprocess.run([sys.executable, "-c", code],
+                             capture_output=True, text=True, check=True)
+        self.assertEqual(int(out.stdout), make([129], 130).fingerprint(3))
+
+    def test_seed_range(self):
+        bv = make([7], 200)
+        self.assertEqual(bv.fingerprint(2**64 - 1),
+                         bv.fingerprint(seed=2**64 - 1))
+        for seed in (-1, 2**64, 2**64 + 5):
+            with self.assertRaises(OverflowError):
+                bv.fingerprint(seed)
+        with self.assertRaises(TypeError):
+            bv.fingerprint("1")
+
+    def test_hash_randomized_per_process(self):
+        code = ("from cbits import BitVector\n"
+                "bv = BitVector(130)\n"
+                "bv.set(129)\n"
+                "print(hash(bv), bv.fingerprint())\n")
+
+        def run(hashseed):
+            env = dict(os.environ, PYTHONHASHSEED=hashseed)
+            out = subprocess.run([sys.executable, "-c", code], env=env,
+                                 capture_output=True, text=True, check=True)
+            return tuple(map(int, out.stdout.split()))
+
+        first, again, other = run("1"), run("1"), run("2")
+        self.assertEqual(first, again)
+        self.assertNotEqual(first[0], other[0])
+        self.assertEqual(first[1], other[1])
+
+
+if __name__ == "__main__":
+    unittest.main()
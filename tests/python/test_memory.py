@@ -0,0 +1,79 @@
+import sys
+import unittest
+import cbits
+from cbits import BitMatrix, BitVector, live_bytes
+
+PARTS = ("object", "header", "data", "padding", "rank_tables")
+
+
+class TestMemory(unittest.TestCase):
+    def test_sizeof_counts_native_storage(self):
+        small = sys.getsizeof(BitVector(64))
+        big = sys.getsizeof(BitVector(8 * 10**6))
+        self.assertGreater(big - small, 10**6)
+
+    def test_breakdown(self):
+        bv = BitVector(6400)
+        usage = bv.memory_usage()
+        self.assertFalse(usage["shared"])
+        self.assertEqual(usage["data"], 800)
+        self.assertEqual(usage["padding"], 8)
+        self.assertGreater(usage["rank_tables"], 0)
+        self.assertEqual(usage["total"], sum(usage[p] for p in PARTS))
+        self.assertEqual(usage["total"], bv.__sizeof__())
+
+    def test_empty(self):
+        usage = BitVector(0).memory_usage()
+        self.assertEqual(usage["data"], 0)
+        self.assertEqual(usage["rank_tables"], 0)
+
+    def test_row_view_is_shared(self):
+        m = BitMatrix(4, 6400)
+        row = m[1]
+        usage = row.memory_usage()
+        self.assertTrue(usage["shared"])
+        self.assertEqual(usage["data"], 800)
+        self.assertEqual(usage["total"], usage["object"])
+        self.assertEqual(row.__sizeof__(), usage["object"])
+
+    def test_live_bytes(self):
+        before = live_bytes()
+        bv = BitVector(8 * 10**6)
+        self.assertEqual(live_bytes() - before,
+                         bv.memory_usage()["total"]
+                         - bv.memory_usage()["object"])
+        del bv
+        self.assertEqual(live_bytes(), before)
+
+    def test_live_bytes_covers_every_structure(self):
+        bv = BitVector(100000)
+        bv.set_range(1000, 3000)
+        parens = BitVector(64)
+        parens.set_range(0, 32)
+        factories = {
+            "BitMatrix": lambda: BitMatrix(64, 4096),
+            "BitVectorCollection":
+                lambda: cbits.BitVectorCollection(100000, [bv] * 10),
+            "CompressedBitVector":
+                lambda: cbits.CompressedBitVector.from_bitvector(bv),
+            "EWAHBitVector": lambda: cbits.EWAHBitVector.from_bitvector(bv),
+            "RRRBitVector": lambda: cbits.RRRBitVector(bv),
+            "EliasFano": lambda: cbits.EliasFano(range(0, 30000, 3)),
+            "WaveletMatrix": lambda: cbits.WaveletMatrix(range(10000)),
+            "BPTree": lambda: cbits.BPTree(parens),
+            "BloomFilter": lambda: cbits.BloomFilter(10000),
+            "QuotientFilter": lambda: cbits.QuotientFilter(10000),
+            "BitSlicedIndex": lambda: cbits.BitSlicedIndex(range(10000)),
+            "BitmapIndex": lambda: cbits.BitmapIndex(100000, {"a": bv}),
+        }
+        for name, make in factories.items():
+            with self.subTest(name):
+                before = live_bytes()
+                obj = make()
+                self.assertGreater(live_bytes(), before)
+                del obj
+                self.assertEqual(live_bytes(), before)
+
+
+if __name__ == "__main__":
+    unittest.main()
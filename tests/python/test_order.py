@@ -0,0 +1,92 @@
+import bisect
+import functools
+import random
+import unittest
+from cbits import BitVector
+
+
+def make(bits):
+    bv = BitVector(len(bits))
+    for i, bit in enumerate(bits):
+        if bit:
+            bv.set(i)
+    return bv
+
+
+def value(bits):
+    return sum(1 << i for i, bit in enumerate(bits) if bit)
+
+
+class TestOrder(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(7)
+        base = [rng.random() < 0.5 for _ in range(300)]
+        self.samples = []
+        for n in (0, 1, 63, 64, 65, 130, 300):
+            for _ in range(6):
+                k = rng.randrange(n + 1)
+                bits = base[:k] + [rng.random() < 0.5 for _ in range(n - k)]
+                self.samples.append(bits)
+
+    def test_sort_matches_tuples(self):
+        vectors = [make(b) for b in self.samples]
+        order = sorted(range(len(vectors)), key=lambda i: vectors[i])
+        expected = sorted(range(len(vectors)),
+                          key=lambda i: tuple(self.samples[i]))
+        self.assertEqual([tuple(self.samples[i]) for i in order],
+                         [tuple(self.samples[i]) for i in expected])
+
+    def test_operators(self):
+        for x in self.samples[::3]:
+            for y in self.samples[::5]:
+                a, b = make(x), make(y)
+                tx, ty = tuple(x), tuple(y)
+                self.assertEqual(a < b, tx < ty)
+                self.assertEqual(a <= b, tx <= ty)
+                self.assertEqual(a > b, tx > ty)
+                self.assertEqual(a >= b, tx >= ty)
+                self.assertEqual(a.compare(b), (tx > ty) - (tx < ty))
+
+    def test_numeric(self):
+        for x in self.samples[::3]:
+            for y in self.samples[::4]:
+                key_x, key_y = (value(x), len(x)), (value(y), len(y))
+                self.assertEqual(make(x).compare(make(y), "numeric"),
+                                 (key_x > key_y) - (key_x < key_y))
+
+    def test_bisect(self):
+        vectors = sorted(make(b) for b in self.samples)
+        probe = make(self.samples[10])
+        i = bisect.bisect_left(vectors, probe)
+        self.assertEqual(vectors[i], probe)
+        numeric = sorted(vectors, key=functools.cmp_to_key(
+            lambda a, b: a.compare(b, order="numeric")))
+        self.assertEqual(len(numeric), len(vectors))
+
+    def test_compare_errors(self):
+        a = BitVector(8)
+        with self.assertRaises(ValueError):
+            a.compare(a, "msb")
+        with self.assertRaises(TypeError):
+            a.compare(3)
+        with self.assertRaises(TypeError):
+            a < 3
+
+    def test_set_relations(self):
+        a = make([1, 0, 1, 0] * 40)
+        b = make([1, 1, 1, 0] * 40)
+        c = make([0, 0, 0, 1] * 40)
+        self.assertTrue(a.issubset(b))
+        self.assertFalse(b.issubset(a))
+        self.assertTrue(b.issuperset(a))
+        self.assertTrue(a.isdisjoint(c))
+        self.assertFalse(a.isdisjoint(b))
+        self.assertTrue(BitVector(0).issubset(BitVector(0)))
+        with self.assertRaises(ValueError):
+            a.issubset(BitVector(3))
+        with self.assertRaises(TypeError):
+            a.isdisjoint({1})
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,110 @@
+import array
+import random
+import unittest
+from collections import Counter
+from cbits import BitVector, QuotientFilter
+
+
+class TestQuotientFilter(unittest.TestCase):
+    def test_add_contains_remove(self):
+        f = QuotientFilter(1000)
+        keys = [1, -5, 2**64 - 1, "text", b"bytes", bytearray(b"mutable")]
+        for key in keys:
+            f.add(key)
+        self.assertEqual(len(f), len(keys))
+        for key in keys:
+            self.assertIn(key, f)
+        f.add("text")
+        self.assertEqual(f.count("text"), 2)
+        f.remove("text")
+        self.assertIn("text", f)
+        f.remove("text")
+        self.assertNotIn("text", f)
+        with self.assertRaises(KeyError):
+            f.remove("text")
+        f.discard("text")
+        self.assertEqual(len(f), len(keys) - 1)
+        with self.assertRaises(TypeError):
+            f.add(1.5)
+        with self.assertRaises(OverflowError):
+            f.add(2**64)
+
+    def test_model(self):
+        rng = random.Random(5)
+        f = QuotientFilter(3000, 0.001)
+        model = Counter()
+        for _ in range(20000):
+            key = rng.randrange(4000)
+            if rng.random() < 0.6 and len(f) < 3000:
+                f.add(key)
+                model[key] += 1
+            elif model[key]:
+                f.remove(key)
+                model[key] -= 1
+        self.assertEqual(len(f), sum(model.values()))
+        for key, n in model.items():
+            self.assertGreaterEqual(f.count(key), n)
+            if n:
+                self.assertIn(key, f)
+
+    def test_batches(self):
+        f = QuotientFilter(20000, 0.01, hash="fnv1a", seed=9)
+        self.assertEqual(f.hash, "fnv1a")
+        self.assertEqual(f.seed, 9)
+        f.add_many(array.array("q", range(10000)))
+        self.assertEqual(len(f), 10000)
+        found = f.contains_many(range(10000))
+        self.assertIsInstance(found, BitVector)
+        self.assertEqual(found.count(), 10000)
+        absent = f.contains_many(range(10000, 30000))
+        self.assertLess(absent.count(), 20000 * 0.03)
+        removed = f.remove_many(range(0, 10000, 2))
+        self.assertEqual(removed.count(), 5000)
+        self.assertEqual(len(f), 5000)
+        self.assertEqual(f.contains_many(range(1, 10000, 2)).count(), 5000)
+        packed = b"abcdefgh" + b"ijklmnop"
+        f.add_many(packed, width=8)
+        self.assertIn(b"ijklmnop", f)
+        self.assertEqual(f.remove_many(packed, width=8).count(), 2)
+        with self.assertRaises(ValueError):
+            f.add_many(b"abc", width=2)
+
+    def test_full(self):
+        f = QuotientFilter(100)
+        slots = f.slots
+        self.assertEqual(slots % 64, 0)
+        self.assertGreater(slots, 2**f.quotient_bits)
+        with self.assertRaises(OverflowError):
+            f.add_many(range(slots + 1))
+        self.assertEqual(len(f), 2**f.quotient_bits)
+        self.assertEqual(f.load_factor, 1.0)
+        with self.assertRaises(OverflowError):
+            f.add("one more")
+        f.remove(0)
+        f.add("one more")
+
+    def test_copy_and_properties(self):
+        f = QuotientFilter(1000, 0.001)
+        self.assertEqual(f.remainder_bits, 10)
+        self.assertEqual(f.quotient_bits, 11)
+        f.add_many(["a", "b"])
+        g = f.copy()
+        g.remove("a")
+        self.assertIn("a", f)
+        self.assertNotIn("a", g)
+        self.assertGreater(f.__sizeof__(), f.slots * f.remainder_bits // 8)
+        self.assertIn("items=2", repr(f))
+
+    def test_invalid_arguments(self):
+        with self.assertRaises(ValueError):
+            QuotientFilter(100, 0.0)
+        with self.assertRaises(ValueError):
+            QuotientFilter(100, 1.0)
+        with self.assertRaises(ValueError):
+            QuotientFilter(100, hash="md5")
+        with self.assertRaises(ValueError):
+            QuotientFilter(-1)
+
+
+if __name__ == "__main__":
+    unittest.main()
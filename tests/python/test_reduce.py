@@ -0,0 +1,74 @@
+import functools
+import operator
+import random
+import unittest
+from cbits import BitVector, and_all, or_all, xor_all, threshold
+
+
+def make(n, bits):
+    bv = BitVector(n)
+    for i in bits:
+        bv[i] = True
+    return bv
+
+
+def rows(bv):
+    return [i for i in range(len(bv)) if bv[i]]
+
+
+class TestReduce(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(40)
+        self.n = 3000
+        self.vectors = [
+            make(self.n, [i for i in range(self.n) if rng.random() < 0.8])
+            for _ in range(9)
+        ]
+
+    def counts(self):
+        return [sum(v[i] for v in self.vectors) for i in range(self.n)]
+
+    def test_matches_reduce(self):
+        for func, op in ((and_all, operator.and_), (or_all, operator.or_),
+                         (xor_all, operator.xor)):
+            with self.subTest(func=func.__name__):
+                self.assertEqual(rows(functools.reduce(op, self.vectors)),
+                                 rows(func(self.vectors)))
+
+    def test_threshold(self):
+        counts = self.counts()
+        for k in range(len(self.vectors) + 2):
+            with self.subTest(k=k):
+                self.assertEqual(
+                    [i for i, c in enumerate(counts) if c >= k],
+                    rows(threshold(self.vectors, k)))
+        majority = threshold(self.vectors, k=len(self.vectors) // 2 + 1)
+        self.assertEqual([i for i, c in enumerate(counts) if c >= 5],
+                         rows(majority))
+
+    def test_iterables(self):
+        single = or_all(iter(self.vectors[:1]))
+        self.assertEqual(rows(self.vectors[0]), rows(single))
+        single[0] = not single[0]
+        self.assertNotEqual(rows(self.vectors[0]), rows(single))
+        self.assertEqual(rows(and_all(self.vectors)),
+                         rows(and_all(tuple(self.vectors))))
+
+    def test_errors(self):
+        for func in (and_all, or_all, xor_all):
+            with self.assertRaises(ValueError):
+                func([])
+            with self.assertRaises(ValueError):
+                func([BitVector(3), BitVector(4)])
+            with self.assertRaises(TypeError):
+                func([BitVector(3), 1])
+            with self.assertRaises(TypeError):
+                func(5)
+        with self.assertRaises(ValueError):
+            threshold(self.vectors, -1)
+        with self.assertRaises(ValueError):
+            threshold([], 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
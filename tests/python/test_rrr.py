@@ -0,0 +1,68 @@
+import random
+import sys
+import unittest
+from cbits import BitVector, RRRBitVector
+
+
+class TestRRRBitVector(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(4321)
+        self.size = 5000
+        self.bv = BitVector(self.size)
+        self.positions = sorted(rng.sample(range(self.size), 300))
+        for i in self.positions:
+            self.bv.set(i)
+        self.rrr = RRRBitVector(self.bv)
+
+    def test_len_and_access(self):
+        self.assertEqual(self.size, len(self.rrr))
+        self.assertEqual(self.size, self.rrr.bits)
+        for i in range(0, self.size, 7):
+            self.assertEqual(self.bv[i], self.rrr[i])
+            self.assertEqual(self.bv.get(i), self.rrr.get(i))
+        self.assertEqual(self.bv[-1], self.rrr[-1])
+        with self.assertRaises(IndexError):
+            _ = self.rrr[self.size]
+        with self.assertRaises(IndexError):
+            self.rrr.get(self.size)
+
+    def test_rank_and_select(self):
+        for i in range(0, self.size, 13):
+            self.assertEqual(self.bv.rank(i), self.rrr.rank(i))
+        self.assertEqual(len(self.positions), self.rrr.count())
+        for k, pos in enumerate(self.positions):
+            self.assertEqual(pos, self.rrr.select(k))
+            self.assertEqual(k + 1, self.rrr.rank(self.rrr.select(k)))
+        with self.assertRaises(IndexError):
+            self.rrr.select(len(self.positions))
+        with self.assertRaises(IndexError):
+            self.rrr.select(-1)
+
+    def test_roundtrip_and_snapshot(self):
+        self.assertEqual(self.bv, self.rrr.to_bitvector())
+        self.bv.set(self.size - 1)
+        self.bv.clear(self.positions[0])
+        self.assertNotEqual(self.bv, self.rrr.to_bitvector())
+        self.assertEqual(len(self.positions), self.rrr.count())
+
+    def test_edge_cases(self):
+        empty = RRRBitVector(BitVector(0))
+        self.assertEqual(0, len(empty))
+        self.assertFalse(empty)
+        self.assertTrue(self.rrr)
+        full = BitVector(130)
+        full.set_range(0, 130)
+        rrr = RRRBitVector(full)
+        self.assertEqual(130, rrr.count())
+        self.assertEqual(129, rrr.select(129))
+        with self.assertRaises(TypeError):
+            RRRBitVector([1, 0, 1])
+
+    def test_sizeof(self):
+        # Six percent density: well below one bit per position.
+        self.assertLess(sys.getsizeof(self.rrr), self.size // 8)
+        self.assertIn("RRRBitVector", repr(self.rrr))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -163,6 +163,14 @@ class TestSlicing(unittest.TestCase):
         self.assertTrue(self.bv.get(1))
         self.assertFalse(self.bv.get(2))
         self.assertTrue(self.bv.get(3))
+    def test_slice_word_aligned_start(self):
+        bv = BitVector(192)
+        bv.set(70)
+        bv.set(130)
+        self.assertFalse(any(bv[0:64]))
+        self.assertEqual([i for i, b in enumerate(bv[64:128]) if b], [6])
+        self.assertEqual([i for i, b in enumerate(bv[64:192]) if b],
+                         [6, 66])
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,124 @@
+import unittest
+from cbits import (
+    BitSlicedIndex,
+    BitVector,
+    BlockedBloomFilter,
+    live_bytes,
+    or_all,
+    stats,
+)
+
+NAMES = (
+    "rank_builds",
+    "rank_words",
+    "allocs",
+    "alloc_bytes",
+    "frees",
+    "free_bytes",
+    "bitwise_bytes",
+    "search_calls",
+    "search_windows",
+    "search_verify",
+    "hash_bytes",
+    "slice_copies",
+    "slice_bits",
+)
+
+
+class TestStats(unittest.TestCase):
+    def setUp(self):
+        try:
+            stats(reset=True)
+        except RuntimeError:
+            self.skipTest("built with CBITS_STATS=OFF")
+
+    def test_names(self):
+        s = stats()
+        self.assertEqual(tuple(s), NAMES)
+        self.assertTrue(all(isinstance(v, int) for v in s.values()))
+
+    def test_reset(self):
+        BitVector(64)
+        self.assertGreaterEqual(stats(reset=True)["allocs"], 1)
+        self.assertEqual(stats()["allocs"], 0)
+
+    def test_rank(self):
+        bv = BitVector(6400)
+        bv.set(5)
+        stats(reset=True)
+        bv.rank(100)
+        bv.rank(200)
+        s = stats()
+        self.assertEqual(s["rank_builds"], 1)
+        self.assertEqual(s["rank_words"], 100)
+        bv.set(6)
+        bv.rank(100)
+        self.assertEqual(stats()["rank_builds"], 2)
+
+    def test_bitwise(self):
+        a = BitVector(640)
+        b = BitVector(640)
+        stats(reset=True)
+        a & b
+        ~a
+        or_all([a, b, a])
+        self.assertEqual(stats()["bitwise_bytes"], (2 + 1 + 3) * 80)
+        # Kernel calls inside other structures are not counted.
+        bsi = BitSlicedIndex(range(640))
+        stats(reset=True)
+        bsi.lt(320)
+        self.assertEqual(stats()["bitwise_bytes"], 0)
+
+    def test_alloc_free(self):
+        stats(reset=True)
+        bv = BitVector(1000)
+        del bv
+        s = stats()
+        self.assertEqual(s["allocs"], 1)
+        self.assertEqual(s["frees"], 1)
+        self.assertEqual(s["alloc_bytes"], s["free_bytes"])
+
+    def test_alloc_matches_live_bytes(self):
+        before = live_bytes()
+        stats(reset=True)
+        bloom = BlockedBloomFilter(10000)
+        s = stats()
+        self.assertGreaterEqual(s["allocs"], 1)
+        self.assertEqual(s["alloc_bytes"] - s["free_bytes"],
+                         live_bytes() - before)
+        del bloom
+        s = stats()
+        self.assertEqual(s["allocs"], s["frees"])
+        self.assertEqual(s["alloc_bytes"], s["free_bytes"])
+
+    def test_search(self):
+        hay = BitVector(256)
+        hay.set(64)
+        needle = BitVector(8)
+        needle.set(0)
+        stats(reset=True)
+        self.assertIn(needle, hay)
+        s = stats()
+        self.assertEqual(s["search_calls"], 1)
+        self.assertEqual(s["search_windows"], 65)
+
+    def test_hash(self):
+        bv = BitVector(100)
+        stats(reset=True)
+        hash(bv)
+        hash(bv)
+        self.assertEqual(stats()["hash_bytes"], 16)
+
+    def test_slice(self):
+        bv = BitVector(128)
+        bv.set(64)
+        stats(reset=True)
+        self.assertEqual(bv[0:64].count(), 0)
+        self.assertEqual(bv[64:128].count(), 1)
+        s = stats()
+        self.assertEqual(s["slice_copies"], 2)
+        self.assertEqual(s["slice_bits"], 128)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,80 @@
+import random
+import sys
+import unittest
+from cbits import WaveletMatrix
+
+
+class TestWaveletMatrix(unittest.TestCase):
+    def setUp(self):
+        rng = random.Random(2024)
+        self.values = [rng.randrange(0, 50) for _ in range(3000)]
+        self.wm = WaveletMatrix(self.values)
+
+    def test_len_and_access(self):
+        self.assertEqual(len(self.values), len(self.wm))
+        self.assertEqual(6, self.wm.levels)
+        for i in range(0, len(self.values), 11):
+            self.assertEqual(self.values[i], self.wm[i])
+            self.assertEqual(self.values[i], self.wm.access(i))
+        self.assertEqual(self.values[-1], self.wm.access(-1))
+        with self.assertRaises(IndexError):
+            _ = self.wm[len(self.values)]
+
+    def test_rank_and_select(self):
+        for symbol in (0, 7, 49, 50, 1 << 70, -1):
+            positions = [i for i, v in enumerate(self.values) if v == symbol]
+            for i in (0, 1, 1500, len(self.values)):
+                expected = sum(1 for p in positions if p < i)
+                self.assertEqual(expected, self.wm.rank(symbol, i))
+            for k, pos in enumerate(positions):
+                self.assertEqual(pos, self.wm.select(symbol, k))
+            with self.assertRaises(IndexError):
+                self.wm.select(symbol, len(positions))
+        with self.assertRaises(IndexError):
+            self.wm.rank(0, len(self.values) + 1)
+
+    def test_quantile(self):
+        for start, stop in ((0, 3000), (100, 200), (-50, None), (5, 6)):
+            window = sorted(self.values[start:stop])
+            stop = len(self.values) if stop is None else stop
+            for k in range(0, len(window), 7):
+                self.assertEqual(window[k], self.wm.quantile(start, stop, k))
+            with self.assertRaises(IndexError):
+                self.wm.quantile(start, stop, len(window))
+
+    def test_range_freq(self):
+        for start, stop, lo, hi in (
+            (0, 3000, 10, 20),
+            (500, 2500, 0, 1),
+            (10, 5, 0, 50),
+            (0, 3000, -5, 1 << 80),
+            (0, 3000, 30, 10),
+        ):
+            expected = sum(1 for v in self.values[start:stop] if lo <= v < hi)
+            self.assertEqual(expected, self.wm.range_freq(start, stop, lo, hi))
+
+    def test_wide_values_and_threads(self):
+        rng = random.Random(7)
+        values = [rng.getrandbits(64) for _ in range(500)] + [2**64 - 1]
+        wm = WaveletMatrix(values, threads=2)
+        self.assertEqual(64, wm.levels)
+        self.assertEqual(values, [wm[i] for i in range(len(wm))])
+        self.assertEqual(1, wm.range_freq(0, len(wm), 2**64 - 1, 1 << 65))
+        self.assertEqual(max(values), wm.quantile(0, len(wm), len(wm) - 1))
+
+    def test_invalid_input(self):
+        with self.assertRaises(OverflowError):
+            WaveletMatrix([1, -2])
+        with self.assertRaises(TypeError):
+            WaveletMatrix(5)
+        empty = WaveletMatrix([])
+        self.assertEqual(0, len(empty))
+        self.assertEqual(0, empty.rank(0, 0))
+
+    def test_sizeof(self):
+        self.assertGreater(sys.getsizeof(self.wm), 6 * 3000 // 8)
+        self.assertIn("WaveletMatrix", repr(self.wm))
+
+
+if __name__ == "__main__":
+    unittest.main()